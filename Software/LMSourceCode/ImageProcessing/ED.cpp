@@ -1,11 +1,34 @@
 #include "ED.h"
 #include "EDColor.h"
 #include <fstream>
+#include <algorithm>
+#include <thread>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+
+// Loads 8 consecutive pixels and widens them to signed 16-bit so that the
+// gradient arithmetic below cannot overflow (Prewitt/Sobel sums stay well
+// inside the int16 range for 8-bit input).
+static inline int16x8_t LoadPixelsS16(const uchar* p)
+{
+	return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p)));
+}
+#endif
 
 using namespace cv;
 using namespace std;
-//��ED�Ĺ��캯��ED
+//��ED�Ĺ��캯��ED
 ED::ED(Mat _srcImage, GradientOperator _op, int _gradThresh, int _anchorThresh, int _scanInterval, int _minPathLen, double _sigma, bool _sumFlag)
+{
+	ProcessImage(_srcImage, _op, _gradThresh, _anchorThresh, _scanInterval, _minPathLen, _sigma, _sumFlag);
+}
+
+// The body of the original ED(Mat, ...) constructor, callable repeatedly on a
+// retained instance.  cv::Mat::create and std::vector::resize only re-allocate
+// when the image dimensions change, so per-frame construction cost disappears
+// once the first frame has sized the buffers.
+void ED::ProcessImage(Mat _srcImage, GradientOperator _op, int _gradThresh, int _anchorThresh, int _scanInterval, int _minPathLen, double _sigma, bool _sumFlag)
 {
 	// Check parameters for sanity
 	if (_gradThresh < 1) _gradThresh = 1;
@@ -26,11 +49,15 @@ ED::ED(Mat _srcImage, GradientOperator _op, int _gradThresh, int _anchorThresh,
 	sumFlag = _sumFlag;
 
 	segmentNos = 0;
+	segmentPoints.clear();
 	segmentPoints.push_back(vector<Point>()); // create empty vector of points for segments
+	anchorPoints.clear();
+	edgePoints.clear();
 
-	edgeImage = Mat(height, width, CV_8UC1, Scalar(0)); // initialize edge Image//CV_8UC1:8bites Unsign C1:�Ҷ�ͼ��Scalar(0):��ʼ��ֵ
-	smoothImage = Mat(height, width, CV_8UC1);
-	gradImage = Mat(height, width, CV_16SC1); // gradImage contains short values 
+	edgeImage.create(height, width, CV_8UC1);//CV_8UC1:8bites Unsign C1:�Ҷ�ͼ��Scalar(0):��ʼ��ֵ
+	edgeImage.setTo(Scalar(0)); // initialize edge Image
+	smoothImage.create(height, width, CV_8UC1);
+	gradImage.create(height, width, CV_16SC1); // gradImage contains short values
 
 	srcImg = srcImage.data;
 
@@ -47,7 +74,8 @@ ED::ED(Mat _srcImage, GradientOperator _op, int _gradThresh, int _anchorThresh,
 	gradImg = (short*)gradImage.data;
 	edgeImg = edgeImage.data;
 
-	dirImg = new unsigned char[width * height];
+	dirImgBuffer.resize((size_t)width * height);
+	dirImg = dirImgBuffer.data();
 
 	/*------------ COMPUTE GRADIENT & EDGE DIRECTION MAPS -------------------*/
 	ComputeGradient();
@@ -57,8 +85,6 @@ ED::ED(Mat _srcImage, GradientOperator _op, int _gradThresh, int _anchorThresh,
 
 	/*------------ JOIN ANCHORS -------------------*/
 	JoinAnchorPointsUsingSortedAnchors();
-
-	delete[] dirImg;
 }
 
 // This constructor for use of EDLines and EDCircle with ED given as constructor argument
@@ -277,12 +303,80 @@ Mat ED::drawParticularSegments(std::vector<int> list)
 
 void ED::ComputeGradient()
 {
-	// Initialize gradient image for row = 0, row = height-1, column=0, column=width-1 
+	// Initialize gradient image for row = 0, row = height-1, column=0, column=width-1
 	for (int j = 0; j < width; j++) { gradImg[j] = gradImg[(height - 1) * width + j] = gradThresh - 1; }
 	for (int i = 1; i < height - 1; i++) { gradImg[i * width] = gradImg[(i + 1) * width - 1] = gradThresh - 1; }
 
-	for (int i = 1; i < height - 1; i++) {
-		for (int j = 1; j < width - 1; j++) {
+	// Each interior row only reads the smoothed image and writes its own row of
+	// the gradient/direction maps, so the rows can be computed in parallel stripes
+	cv::parallel_for_(cv::Range(1, height - 1), [&](const cv::Range& stripe) {
+	for (int i = stripe.start; i < stripe.end; i++) {
+		int j = 1;
+
+#if defined(__aarch64__)
+		// NEON kernel for the Prewitt/Sobel operators: 8 pixels per iteration
+		// with the same integer arithmetic as the scalar loop below, so the
+		// results are bit-identical.  The direction map is blended so that
+		// pixels below the gradient threshold are left untouched, exactly as
+		// in the scalar code.  Scharr/LSD (note the scalar Scharr case falls
+		// through into the LSD code) and the sqrt-magnitude mode go through
+		// the scalar loop, which also handles the row tail.
+		if ((op == PREWITT_OPERATOR || op == SOBEL_OPERATOR) && sumFlag) {
+			const uchar* rowUp = smoothImg + (i - 1) * width;
+			const uchar* rowMid = smoothImg + i * width;
+			const uchar* rowDown = smoothImg + (i + 1) * width;
+
+			const int16x8_t vGradThresh = vdupq_n_s16((short)gradThresh);
+			const int16x8_t vVertical = vdupq_n_s16(EDGE_VERTICAL);
+			const int16x8_t vHorizontal = vdupq_n_s16(EDGE_HORIZONTAL);
+
+			for (; j + 8 <= width - 1; j += 8) {
+				int16x8_t A = LoadPixelsS16(rowUp + j - 1);
+				int16x8_t B = LoadPixelsS16(rowUp + j);
+				int16x8_t C = LoadPixelsS16(rowUp + j + 1);
+				int16x8_t D = LoadPixelsS16(rowMid + j - 1);
+				int16x8_t E = LoadPixelsS16(rowMid + j + 1);
+				int16x8_t F = LoadPixelsS16(rowDown + j - 1);
+				int16x8_t G = LoadPixelsS16(rowDown + j);
+				int16x8_t H = LoadPixelsS16(rowDown + j + 1);
+
+				int16x8_t com1 = vsubq_s16(H, A);
+				int16x8_t com2 = vsubq_s16(C, F);
+				int16x8_t ed = vsubq_s16(E, D);
+				int16x8_t gb = vsubq_s16(G, B);
+
+				int16x8_t gx;
+				int16x8_t gy;
+
+				if (op == PREWITT_OPERATOR) {
+					gx = vaddq_s16(vaddq_s16(com1, com2), ed);
+					gy = vaddq_s16(vsubq_s16(com1, com2), gb);
+				}
+				else { // SOBEL_OPERATOR
+					gx = vaddq_s16(vaddq_s16(com1, com2), vshlq_n_s16(ed, 1));
+					gy = vaddq_s16(vsubq_s16(com1, com2), vshlq_n_s16(gb, 1));
+				}
+
+				gx = vabsq_s16(gx);
+				gy = vabsq_s16(gy);
+
+				int16x8_t sum = vaddq_s16(gx, gy);
+
+				int index = i * width + j;
+				vst1q_s16(gradImg + index, sum);
+
+				// dir = (gx >= gy) ? EDGE_VERTICAL : EDGE_HORIZONTAL, written
+				// only where sum >= gradThresh
+				int16x8_t dir = vbslq_s16(vcgeq_s16(gx, gy), vVertical, vHorizontal);
+				uint8x8_t dirBytes = vmovn_u16(vreinterpretq_u16_s16(dir));
+				uint8x8_t strongBytes = vmovn_u16(vcgeq_s16(sum, vGradThresh));
+				uint8x8_t existing = vld1_u8(dirImg + index);
+				vst1_u8(dirImg + index, vbsl_u8(strongBytes, dirBytes, existing));
+			}
+		}
+#endif
+
+		for (; j < width - 1; j++) {
 			// Prewitt Operator in horizontal and vertical direction
 			// A B C
 			// D x E
@@ -372,12 +466,32 @@ void ED::ComputeGradient()
 			} //end-if
 		} // end-for
 	} // end-for
+	});
 }
 
 void ED::ComputeAnchorPoints()
 {
 	//memset(edgeImg, 0, width*height);
-	for (int i = 2; i < height - 2; i++) {
+
+	// Anchor testing only reads the gradient/direction maps and writes its own
+	// row of the edge image, so the rows are processed in parallel stripes.
+	// Each stripe collects its anchors locally and the stripe lists are merged
+	// in row order afterwards, so the anchor ordering (and therefore the
+	// segment routing downstream) is identical to the serial scan.
+	const int numStripes = std::max(1, std::min((int)std::thread::hardware_concurrency(), 8));
+	const int firstRow = 2;
+	const int lastRow = height - 2;  // exclusive
+	const int rowsPerStripe = std::max(1, (lastRow - firstRow + numStripes - 1) / numStripes);
+
+	std::vector<std::vector<Point>> stripeAnchors(numStripes);
+
+	cv::parallel_for_(cv::Range(0, numStripes), [&](const cv::Range& stripeRange) {
+	for (int stripe = stripeRange.start; stripe < stripeRange.end; stripe++) {
+		int stripeFirstRow = firstRow + stripe * rowsPerStripe;
+		int stripeLastRow = std::min(lastRow, stripeFirstRow + rowsPerStripe);
+		std::vector<Point>& localAnchors = stripeAnchors[stripe];
+
+	for (int i = stripeFirstRow; i < stripeLastRow; i++) {
 		int start = 2;
 		int inc = 1;
 		if (i % scanInterval != 0) { start = scanInterval; inc = scanInterval; }
@@ -391,7 +505,7 @@ void ED::ComputeAnchorPoints()
 				int diff2 = gradImg[i * width + j] - gradImg[i * width + j + 1];
 				if (diff1 >= anchorThresh && diff2 >= anchorThresh) {
 					edgeImg[i * width + j] = ANCHOR_PIXEL;
-					anchorPoints.push_back(Point(j, i));
+					localAnchors.push_back(Point(j, i));
 				}
 
 			}
@@ -401,22 +515,40 @@ void ED::ComputeAnchorPoints()
 				int diff2 = gradImg[i * width + j] - gradImg[(i + 1) * width + j];
 				if (diff1 >= anchorThresh && diff2 >= anchorThresh) {
 					edgeImg[i * width + j] = ANCHOR_PIXEL;
-					anchorPoints.push_back(Point(j, i));
+					localAnchors.push_back(Point(j, i));
 				}
 			} // end-else
 		} //end-for-inner
 	} //end-for-outer
+	} // end-for-stripe
+	});
+
+	for (int stripe = 0; stripe < numStripes; stripe++) {
+		anchorPoints.insert(anchorPoints.end(), stripeAnchors[stripe].begin(), stripeAnchors[stripe].end());
+	}
 
 	anchorNos = (int)anchorPoints.size(); // get the total number of anchor points
 }
 
+// NOTE - Unlike the gradient/anchor phases above, the smart-routing walks here
+// claim pixels in the shared edge image as they go (a walk stops when it runs
+// into a pixel another segment already claimed), so routing anchors
+// concurrently would race on the edge map and change which segments get which
+// pixels.  Routing therefore stays serial.
 void ED::JoinAnchorPointsUsingSortedAnchors()
 {
-	int* chainNos = new int[(width + height) * 8];
+	// Scratch space is retained on the instance so that repeated
+	// ProcessImage() runs on same-sized frames do not re-allocate it.
+	chainNosBuffer.resize((size_t)(width + height) * 8);
+	pixelsBuffer.resize((size_t)width * height);
+	stackBuffer.resize((size_t)width * height);
+	chainsBuffer.resize((size_t)width * height);
+
+	int* chainNos = chainNosBuffer.data();
 
-	Point* pixels = new Point[width * height];
-	StackNode* stack = new StackNode[width * height];
-	Chain* chains = new Chain[width * height];
+	Point* pixels = pixelsBuffer.data();
+	StackNode* stack = stackBuffer.data();
+	Chain* chains = chainsBuffer.data();
 
 	// sort the anchor points by their gradient value in decreasing order
 	int* A = sortAnchorsByGradValue1();
@@ -967,12 +1099,9 @@ void ED::JoinAnchorPointsUsingSortedAnchors()
 	// because of one preallocation in the beginning, it will always empty
 	segmentPoints.pop_back();
 
-	// Clean up
+	// Clean up (the chain/stack/pixel scratch buffers are members and are
+	// kept for the next run)
 	delete[] A;
-	delete[] chains;
-	delete[] stack;
-	delete[] chainNos;
-	delete[] pixels;
 }
 
 void ED::sortAnchorsByGradValue()
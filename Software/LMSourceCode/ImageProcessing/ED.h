@@ -20,9 +20,9 @@
 * By using this library you are implicitly assumed to have accepted all of the above statements,
 * and accept to cite the following papers:
 *
-* [1] C. Topal and C. Akinlar, �Edge Drawing: A Combined Real-Time Edge and Segment Detector,?*     Journal of Visual Communication and Image Representation, 23(6), 862-872, DOI: 10.1016/j.jvcir.2012.05.004 (2012).
+* [1] C. Topal and C. Akinlar, �Edge Drawing: A Combined Real-Time Edge and Segment Detector,?*     Journal of Visual Communication and Image Representation, 23(6), 862-872, DOI: 10.1016/j.jvcir.2012.05.004 (2012).
 *
-* [2] C. Akinlar and C. Topal, �EDPF: A Real-time Parameter-free Edge Segment Detector with a False Detection Control,?*     International Journal of Pattern Recognition and Artificial Intelligence, 26(1), DOI: 10.1142/S0218001412550026 (2012).
+* [2] C. Akinlar and C. Topal, �EDPF: A Real-time Parameter-free Edge Segment Detector with a False Detection Control,?*     International Journal of Pattern Recognition and Artificial Intelligence, 26(1), DOI: 10.1142/S0218001412550026 (2012).
 **************************************************************************************************************/
 
 #ifndef _ED_
@@ -63,14 +63,22 @@ struct Chain {
 
 class ED {
 
-public://ED �������أ�����������Ͳ�ͬ
+public://ED �������أ�����������Ͳ�ͬ
 	ED(cv::Mat _srcImage, GradientOperator _op = PREWITT_OPERATOR, int _gradThresh = 20, int _anchorThresh = 0, int _scanInterval = 1, int _minPathLen = 10, double _sigma = 1.0, bool _sumFlag = true);
 	ED(const ED& cpyObj);
 	ED(short* gradImg, uchar* dirImg, int _width, int _height, int _gradThresh, int _anchorThresh, int _scanInterval = 1, int _minPathLen = 10, bool selectStableAnchors = true);
 	ED(EDColor& cpyObj);
-	ED();//���涼�ǹ��캯��
+	ED();//���涼�ǹ��캯��
 
-	cv::Mat getEdgeImage();//��Ա����
+	// Re-runs the full edge drawing pipeline on a new image, reusing the
+	// internal buffers from the previous run.  The buffers are only
+	// re-allocated when the input dimensions change, so a retained ED (or
+	// EDPF) instance avoids the per-frame heap churn of constructing a new
+	// detector for every image.  Produces the same results as the
+	// equivalent constructor.
+	void ProcessImage(cv::Mat _srcImage, GradientOperator _op = PREWITT_OPERATOR, int _gradThresh = 20, int _anchorThresh = 0, int _scanInterval = 1, int _minPathLen = 10, double _sigma = 1.0, bool _sumFlag = true);
+
+	cv::Mat getEdgeImage();//��Ա����
 	cv::Mat getAnchorImage();
 	cv::Mat getSmoothImage();
 	cv::Mat getGradImage();
@@ -88,7 +96,7 @@ protected:
 	int width; // width of source image
 	int height; // height of source image
 	uchar* srcImg;
-	std::vector<std::vector< cv::Point> > segmentPoints;//2ά����
+	std::vector<std::vector< cv::Point> > segmentPoints;//2ά����
 	double sigma; // Gaussian sigma
 	cv::Mat smoothImage;
 	uchar* edgeImg; // pointer to edge image data
@@ -117,6 +125,14 @@ private:
 	uchar* dirImg; // pointer to direction image data
 	short* gradImg; // pointer to gradient image data
 
+	// Retained scratch buffers for ProcessImage().  std::vector::resize is a
+	// no-op when the image dimensions have not changed between runs.
+	std::vector<uchar> dirImgBuffer;
+	std::vector<cv::Point> pixelsBuffer;
+	std::vector<StackNode> stackBuffer;
+	std::vector<Chain> chainsBuffer;
+	std::vector<int> chainNosBuffer;
+
 	GradientOperator op; // operation used in gradient calculation
 	int gradThresh; // gradient threshold
 	int anchorThresh; // anchor point threshold
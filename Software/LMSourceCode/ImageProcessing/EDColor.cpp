@@ -1,6 +1,73 @@
 #include "EDColor.h"
 #include "ED.h"
 
+#include <future>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+
+// Loads 8 consecutive pixels widened to signed 16-bit for the Prewitt sums
+static inline int16x8_t LoadChannelPixelsS16(const uchar* p)
+{
+	return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p)));
+}
+
+// Per-channel Prewitt gx/gy for 8 pixels starting at column j of row i
+static inline void PrewittRowS16(const uchar* smooth, int width, int i, int j, int16x8_t& gx, int16x8_t& gy)
+{
+	const uchar* rowUp = smooth + (i - 1) * width;
+	const uchar* rowMid = smooth + i * width;
+	const uchar* rowDown = smooth + (i + 1) * width;
+
+	int16x8_t A = LoadChannelPixelsS16(rowUp + j - 1);
+	int16x8_t B = LoadChannelPixelsS16(rowUp + j);
+	int16x8_t C = LoadChannelPixelsS16(rowUp + j + 1);
+	int16x8_t D = LoadChannelPixelsS16(rowMid + j - 1);
+	int16x8_t E = LoadChannelPixelsS16(rowMid + j + 1);
+	int16x8_t F = LoadChannelPixelsS16(rowDown + j - 1);
+	int16x8_t G = LoadChannelPixelsS16(rowDown + j);
+	int16x8_t H = LoadChannelPixelsS16(rowDown + j + 1);
+
+	int16x8_t com1 = vsubq_s16(H, A);
+	int16x8_t com2 = vsubq_s16(C, F);
+
+	gx = vaddq_s16(vaddq_s16(com1, com2), vsubq_s16(E, D));
+	gy = vaddq_s16(vsubq_s16(com1, com2), vsubq_s16(G, B));
+}
+
+// Three-channel dot product a1*b1 + a2*b2 + a3*b3, widened to 32 bits
+static inline int32x4_t DotThreeChannelS16(int16x4_t a1, int16x4_t b1, int16x4_t a2, int16x4_t b2, int16x4_t a3, int16x4_t b3)
+{
+	int32x4_t acc = vmull_s16(a1, b1);
+	acc = vmlal_s16(acc, a2, b2);
+	acc = vmlal_s16(acc, a3, b3);
+	return acc;
+}
+
+// Di Zenzo gradient magnitude and quantized direction for 4 pixels.
+// The trigonometric form in the scalar code reduces algebraically to
+//     grad = sqrt((gxx + gyy + sqrt((gxx - gyy)^2 + 4*gxy^2)) / 2)
+// and theta in [-pi/4, pi/4] (a vertical edge) is equivalent to gxx >= gyy
+// (with the gxx == gyy tie going to vertical only when gxy == 0).
+static inline void DiZenzoMagnitudeAndDirection(int32x4_t gxx, int32x4_t gyy, int32x4_t gxy, int16x4_t& mag, uint16x4_t& verticalMask)
+{
+	float32x4_t fxx = vcvtq_f32_s32(gxx);
+	float32x4_t fyy = vcvtq_f32_s32(gyy);
+	float32x4_t fxy = vcvtq_f32_s32(gxy);
+
+	float32x4_t diff = vsubq_f32(fxx, fyy);
+	float32x4_t r = vsqrtq_f32(vmlaq_f32(vmulq_f32(diff, diff), vmulq_f32(fxy, fxy), vdupq_n_f32(4.0f)));
+	float32x4_t g = vsqrtq_f32(vmulq_f32(vaddq_f32(vaddq_f32(fxx, fyy), r), vdupq_n_f32(0.5f)));
+
+	// Truncating convert of (g + 0.5) matches the scalar (int)(... + 0.5)
+	mag = vmovn_s32(vcvtq_s32_f32(vaddq_f32(g, vdupq_n_f32(0.5f))));
+
+	uint32x4_t vertical = vorrq_u32(vcgtq_s32(gxx, gyy),
+		vandq_u32(vceqq_s32(gxx, gyy), vceqq_s32(gxy, vdupq_n_s32(0))));
+	verticalMask = vmovn_u32(vertical);
+}
+#endif
+
 using namespace cv;
 using namespace std;
 
@@ -41,10 +108,15 @@ EDColor::EDColor(Mat srcImage, int gradThresh, int anchor_thresh, double sigma,
 	smooth_a = new uchar[width * height];
 	smooth_b = new uchar[width * height];
 
-	// Smooth Channels
-	smoothChannel(L_Img, smooth_L, sigma);
-	smoothChannel(a_Img, smooth_a, sigma);
-	smoothChannel(b_Img, smooth_b, sigma);
+	// Smooth Channels.  The three channels are independent until the
+	// gradient combination, so run two on worker threads and one here
+	{
+		auto smooth_a_future = std::async(std::launch::async, [&]() { smoothChannel(a_Img, smooth_a, sigma); });
+		auto smooth_b_future = std::async(std::launch::async, [&]() { smoothChannel(b_Img, smooth_b, sigma); });
+		smoothChannel(L_Img, smooth_L, sigma);
+		smooth_a_future.wait();
+		smooth_b_future.wait();
+	}
 
 	// Allocate space for direction and gradient images
 	dirImg = new uchar[width * height];
@@ -62,9 +134,15 @@ EDColor::EDColor(Mat srcImage, int gradThresh, int anchor_thresh, double sigma,
 		edgeImage = edgeObj.getEdgeImage();
 
 		sigma /= 2.5;
-		smoothChannel(L_Img, smooth_L, sigma);
-		smoothChannel(a_Img, smooth_a, sigma);
-		smoothChannel(b_Img, smooth_b, sigma);
+
+		// Channel-parallel, as in the initial smoothing above
+		{
+			auto smooth_a_future = std::async(std::launch::async, [&]() { smoothChannel(a_Img, smooth_a, sigma); });
+			auto smooth_b_future = std::async(std::launch::async, [&]() { smoothChannel(b_Img, smooth_b, sigma); });
+			smoothChannel(L_Img, smooth_L, sigma);
+			smooth_a_future.wait();
+			smooth_b_future.wait();
+		}
 
 		edgeImg = edgeImage.data; // validation steps uses pointer to edgeImage
 
@@ -174,38 +252,25 @@ void EDColor::MyRGB2LabFast()
 		b[i] = 200 * (y - z);
 	} //end-for
 
-	// Scale L to [0-255]
-	double min = 1e10;
-	double max = -1e10;
-	for (int i = 0; i < width * height; i++) {
-		if (L[i] < min) min = L[i];
-		else if (L[i] > max) max = L[i];
-	} //end-for
-
-	double scale = 255.0 / (max - min);
-	for (int i = 0; i < width * height; i++) { L_Img[i] = (unsigned char)((L[i] - min) * scale); }
-
-	// Scale a to [0-255]
-	min = 1e10;
-	max = -1e10;
-	for (int i = 0; i < width * height; i++) {
-		if (a[i] < min) min = a[i];
-		else if (a[i] > max) max = a[i];
-	} //end-for
-
-	scale = 255.0 / (max - min);
-	for (int i = 0; i < width * height; i++) { a_Img[i] = (unsigned char)((a[i] - min) * scale); }
+	// Scale each channel to [0-255].  The three scans are independent, so
+	// two run on worker threads while the L channel is scaled here
+	auto scaleChannel = [this](const double* src, uchar* dst) {
+		double min = 1e10;
+		double max = -1e10;
+		for (int i = 0; i < width * height; i++) {
+			if (src[i] < min) min = src[i];
+			else if (src[i] > max) max = src[i];
+		} //end-for
 
-	// Scale b to [0-255]
-	min = 1e10;
-	max = -1e10;
-	for (int i = 0; i < width * height; i++) {
-		if (b[i] < min) min = b[i];
-		else if (b[i] > max) max = b[i];
-	} //end-for
+		double scale = 255.0 / (max - min);
+		for (int i = 0; i < width * height; i++) { dst[i] = (unsigned char)((src[i] - min) * scale); }
+	};
 
-	scale = 255.0 / (max - min);
-	for (int i = 0; i < width * height; i++) { b_Img[i] = (unsigned char)((b[i] - min) * scale); }
+	auto scale_a_future = std::async(std::launch::async, [&]() { scaleChannel(a, a_Img); });
+	auto scale_b_future = std::async(std::launch::async, [&]() { scaleChannel(b, b_Img); });
+	scaleChannel(L, L_Img);
+	scale_a_future.wait();
+	scale_b_future.wait();
 
 
 	// clean space
@@ -221,7 +286,52 @@ void EDColor::ComputeGradientMapByDiZenzo()
 	int max = 0;
 
 	for (int i = 1; i < height - 1; i++) {
-		for (int j = 1; j < width - 1; j++) {
+		int j = 1;
+
+#if defined(__aarch64__)
+		// NEON kernel processing 8 pixels per iteration via the algebraic
+		// form of Di Zenzo's formulas (see DiZenzoMagnitudeAndDirection),
+		// avoiding the per-pixel atan2/cos/sin calls entirely.  The row tail
+		// and non-aarch64 builds run the original scalar loop below.
+		{
+			const int16x8_t vVertical = vdupq_n_s16(EDGE_VERTICAL);
+			const int16x8_t vHorizontal = vdupq_n_s16(EDGE_HORIZONTAL);
+			int16x8_t vMax = vdupq_n_s16(0);
+
+			for (; j + 8 <= width - 1; j += 8) {
+				int16x8_t gxCh1, gyCh1, gxCh2, gyCh2, gxCh3, gyCh3;
+				PrewittRowS16(smooth_L, width, i, j, gxCh1, gyCh1);
+				PrewittRowS16(smooth_a, width, i, j, gxCh2, gyCh2);
+				PrewittRowS16(smooth_b, width, i, j, gxCh3, gyCh3);
+
+				int32x4_t gxxLo = DotThreeChannelS16(vget_low_s16(gxCh1), vget_low_s16(gxCh1), vget_low_s16(gxCh2), vget_low_s16(gxCh2), vget_low_s16(gxCh3), vget_low_s16(gxCh3));
+				int32x4_t gyyLo = DotThreeChannelS16(vget_low_s16(gyCh1), vget_low_s16(gyCh1), vget_low_s16(gyCh2), vget_low_s16(gyCh2), vget_low_s16(gyCh3), vget_low_s16(gyCh3));
+				int32x4_t gxyLo = DotThreeChannelS16(vget_low_s16(gxCh1), vget_low_s16(gyCh1), vget_low_s16(gxCh2), vget_low_s16(gyCh2), vget_low_s16(gxCh3), vget_low_s16(gyCh3));
+
+				int32x4_t gxxHi = DotThreeChannelS16(vget_high_s16(gxCh1), vget_high_s16(gxCh1), vget_high_s16(gxCh2), vget_high_s16(gxCh2), vget_high_s16(gxCh3), vget_high_s16(gxCh3));
+				int32x4_t gyyHi = DotThreeChannelS16(vget_high_s16(gyCh1), vget_high_s16(gyCh1), vget_high_s16(gyCh2), vget_high_s16(gyCh2), vget_high_s16(gyCh3), vget_high_s16(gyCh3));
+				int32x4_t gxyHi = DotThreeChannelS16(vget_high_s16(gxCh1), vget_high_s16(gyCh1), vget_high_s16(gxCh2), vget_high_s16(gyCh2), vget_high_s16(gxCh3), vget_high_s16(gyCh3));
+
+				int16x4_t magLo, magHi;
+				uint16x4_t vertLo, vertHi;
+				DiZenzoMagnitudeAndDirection(gxxLo, gyyLo, gxyLo, magLo, vertLo);
+				DiZenzoMagnitudeAndDirection(gxxHi, gyyHi, gxyHi, magHi, vertHi);
+
+				int16x8_t grad = vcombine_s16(magLo, magHi);
+				int index = i * width + j;
+				vst1q_s16(gradImg + index, grad);
+				vMax = vmaxq_s16(vMax, grad);
+
+				int16x8_t dir = vbslq_s16(vcombine_u16(vertLo, vertHi), vVertical, vHorizontal);
+				vst1_u8(dirImg + index, vmovn_u16(vreinterpretq_u16_s16(dir)));
+			}
+
+			int rowMax = vmaxvq_s16(vMax);
+			if (rowMax > max) max = rowMax;
+		}
+#endif
+
+		for (; j < width - 1; j++) {
 #if 1
 			// Prewitt for channel1
 			int com1 = smooth_L[(i + 1) * width + j + 1] - smooth_L[(i - 1) * width + j - 1];
@@ -296,8 +406,25 @@ void EDColor::ComputeGradientMapByDiZenzo()
 
 	// Scale the gradient values to 0-255
 	double scale = 255.0 / max;
-	for (int i = 0; i < width * height; i++)
-		gradImg[i] = (short)(gradImg[i] * scale);
+	int k = 0;
+
+#if defined(__aarch64__)
+	// 8 gradients per iteration.  The truncating float-to-int convert
+	// matches the scalar (short)(gradImg[k] * scale) below
+	{
+		const float32x4_t vScale = vdupq_n_f32((float)scale);
+
+		for (; k + 8 <= width * height; k += 8) {
+			int16x8_t g = vld1q_s16(gradImg + k);
+			int32x4_t lo = vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(g))), vScale));
+			int32x4_t hi = vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(g))), vScale));
+			vst1q_s16(gradImg + k, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)));
+		}
+	}
+#endif
+
+	for (; k < width * height; k++)
+		gradImg[k] = (short)(gradImg[k] * scale);
 }
 
 void EDColor::smoothChannel(uchar* src, uchar* smooth, double sigma)
@@ -28,13 +28,31 @@ EDPF::EDPF(EDColor obj)
 {
 }
 
+EDPF::EDPF()
+	:ED()
+{
+	// A detector constructed this way does nothing until Process() is called
+}
+
+void EDPF::Process(Mat srcImage)
+{
+	// Same parameters as the EDPF(Mat) constructor above
+	ProcessImage(srcImage, PREWITT_OPERATOR, 11, 3);
+
+	// Validate Edge Segments
+	sigma /= 2.5;
+	GaussianBlur(srcImage, smoothImage, Size(), sigma); // calculate kernel from sigma
+
+	validateEdgeSegments();
+}
+
 void EDPF::validateEdgeSegments()
 {
 	divForTestSegment = 2.25; // Some magic number :-)
 	memset(edgeImg, 0, width * height); // clear edge image
 
-	H = new double[MAX_GRAD_VALUE];
-	memset(H, 0, sizeof(double) * MAX_GRAD_VALUE);
+	HBuffer.assign(MAX_GRAD_VALUE, 0.0);
+	H = HBuffer.data();
 
 	gradImg = ComputePrewitt3x3();
 
@@ -65,18 +83,17 @@ void EDPF::validateEdgeSegments()
 
 	ExtractNewSegments();
 
-	// clean space		  
-	delete[] H;
-	delete[] gradImg;
+	// H and gradImg point into member buffers now, so there is nothing to
+	// free; the storage is kept for the next run
 }
 
 short* EDPF::ComputePrewitt3x3()
 {
-	short* gradImg = new short[width * height];
-	memset(gradImg, 0, sizeof(short) * width * height);
+	gradImgBuffer.assign((size_t)width * height, 0);
+	short* gradImg = gradImgBuffer.data();
 
-	int* grads = new int[MAX_GRAD_VALUE];
-	memset(grads, 0, sizeof(int) * MAX_GRAD_VALUE);
+	gradsBuffer.assign(MAX_GRAD_VALUE, 0);
+	int* grads = gradsBuffer.data();
 
 	for (int i = 1; i < height - 1; i++) {
 		for (int j = 1; j < width - 1; j++) {
@@ -115,7 +132,6 @@ short* EDPF::ComputePrewitt3x3()
 	for (int i = 0; i < MAX_GRAD_VALUE; i++)
 		H[i] = (double)grads[i] / ((double)size);
 
-	delete[] grads;
 	return gradImg;
 }
 
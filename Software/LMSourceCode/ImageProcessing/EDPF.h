@@ -20,9 +20,9 @@
 * By using this library you are implicitly assumed to have accepted all of the above statements,
 * and accept to cite the following papers:
 *
-* [1] C. Topal and C. Akinlar, �Edge Drawing: A Combined Real-Time Edge and Segment Detector,?*     Journal of Visual Communication and Image Representation, 23(6), 862-872, DOI: 10.1016/j.jvcir.2012.05.004 (2012).
+* [1] C. Topal and C. Akinlar, �Edge Drawing: A Combined Real-Time Edge and Segment Detector,?*     Journal of Visual Communication and Image Representation, 23(6), 862-872, DOI: 10.1016/j.jvcir.2012.05.004 (2012).
 *
-* [2] C. Akinlar and C. Topal, �EDPF: A Real-time Parameter-free Edge Segment Detector with a False Detection Control,?*     International Journal of Pattern Recognition and Artificial Intelligence, 26(1), DOI: 10.1142/S0218001412550026 (2012).
+* [2] C. Akinlar and C. Topal, �EDPF: A Real-time Parameter-free Edge Segment Detector with a False Detection Control,?*     International Journal of Pattern Recognition and Artificial Intelligence, 26(1), DOI: 10.1142/S0218001412550026 (2012).
 **************************************************************************************************************/
 
 #ifndef  _EDPF_
@@ -38,12 +38,23 @@ public:
 	EDPF(cv::Mat srcImage);
 	EDPF(ED obj);
 	EDPF(EDColor obj);
+	EDPF();
+
+	// Runs the same pipeline as the EDPF(Mat) constructor on a retained
+	// instance, reusing the internal ED and validation buffers.  They are
+	// only re-allocated when the input dimensions change.
+	void Process(cv::Mat srcImage);
 private:
 	double divForTestSegment;
 	double* H;
 	int np;
 	short* gradImg;
 
+	// Retained backing storage for H and gradImg across Process() runs
+	std::vector<double> HBuffer;
+	std::vector<short> gradImgBuffer;
+	std::vector<int> gradsBuffer;
+
 	void validateEdgeSegments();
 	short* ComputePrewitt3x3(); // differs from base class's prewit function (calculates H)
 	void TestSegment(int i, int index1, int index2);
@@ -12,6 +12,8 @@ http://dx.doi.org/10.1016/j.patcog.2014.05.012.
 (http://www.sciencedirect.com/science/article/pii/S0031320314001976)
 */
 
+#include <cfloat>
+
 #include "EllipseDetectorYaed.h"
 #include "logging_tools.h"
 
@@ -32,6 +34,18 @@ CEllipseDetectorYaed::CEllipseDetectorYaed(void) : _times(6, 0.0), _timesHelper(
 	_fMinReliability = 0.4f;
 	_uNs = 16;
 
+	_fMinExpectedRadius = 0.f;
+	_fMaxExpectedRadius = 0.f;
+	_fMaxPairedArcDistance = 0.f;
+
+	ACC_N_SIZE = 0;
+	ACC_R_SIZE = 0;
+	ACC_A_SIZE = 0;
+
+	accN = nullptr;
+	accR = nullptr;
+	accA = nullptr;
+
 	srand(unsigned(time(nullptr)));
 }
 
@@ -67,6 +81,43 @@ void CEllipseDetectorYaed::SetParameters(Size	szPreProcessingGaussKernelSize,
 
 }
 
+void CEllipseDetectorYaed::SetExpectedRadiusBounds(float fMinRadiusPixels, float fMaxRadiusPixels)
+{
+	_fMinExpectedRadius = fMinRadiusPixels;
+	_fMaxExpectedRadius = fMaxRadiusPixels;
+
+	// Two arcs of the same ellipse (and so their chord midpoints) can be at
+	// most one major-axis length (2a) apart.  A 25% margin absorbs
+	// edge-drawing noise without re-admitting the far-away pairings this
+	// bound exists to skip.
+	_fMaxPairedArcDistance = (fMaxRadiusPixels > 0.f) ? 2.5f * fMaxRadiusPixels : 0.f;
+}
+
+void CEllipseDetectorYaed::ResetDetectionState()
+{
+	// Grow-only: after the first detection at a given image size the resize
+	// calls are no-ops and this is just a memset over the retained buffers
+	if ((int)accN_storage_.size() < ACC_N_SIZE) accN_storage_.resize(ACC_N_SIZE);
+	if ((int)accR_storage_.size() < ACC_R_SIZE) accR_storage_.resize(ACC_R_SIZE);
+	if ((int)accA_storage_.size() < ACC_A_SIZE) accA_storage_.resize(ACC_A_SIZE);
+
+	accN = accN_storage_.data();
+	accR = accR_storage_.data();
+	accA = accA_storage_.data();
+
+	memset(accN, 0, sizeof(int) * ACC_N_SIZE);
+	memset(accR, 0, sizeof(int) * ACC_R_SIZE);
+	memset(accA, 0, sizeof(int) * ACC_A_SIZE);
+
+	// clear() keeps the outer vectors' capacity; the individual arc vectors
+	// are rebuilt by the edge-detection pass
+	points_1_.clear();
+	points_2_.clear();
+	points_3_.clear();
+	points_4_.clear();
+	centers_.clear();
+}
+
 uint inline CEllipseDetectorYaed::GenerateKey(uchar pair, ushort u, ushort v)
 {
 	return (pair << 30) + (u << 15) + v;
@@ -1062,6 +1113,105 @@ Point2f CEllipseDetectorYaed::GetCenterCoordinates(EllipseData& data_ij, Ellipse
 
 
 // Verify triplets of arcs with convexity: i=1, j=2, k=4
+// Spatial index used by the Triplets* grouping functions below.  On noisy
+// strobed images the arc lists get large and the triple loops go quadratic
+// in the arc count; when the expected-radius bounds are set, each arc only
+// has to be tested against arcs whose chord midpoints fall in neighboring
+// grid cells, and arcs whose own chord is longer than the largest compatible
+// ellipse are skipped entirely.
+namespace {
+
+	inline Point2f ArcChordMidpoint(const VP& arc)
+	{
+		const Point& first = arc.front();
+		const Point& last = arc.back();
+		return Point2f((first.x + last.x) * 0.5f, (first.y + last.y) * 0.5f);
+	}
+
+	inline float ArcChordLength2(const VP& arc)
+	{
+		float dx = float(arc.back().x - arc.front().x);
+		float dy = float(arc.back().y - arc.front().y);
+		return dx * dx + dy * dy;
+	}
+
+	class ArcNeighborhoodGrid
+	{
+	public:
+		// Indexes the chord midpoints of the given arcs on a uniform grid
+		// with cells of pairing_distance on a side, leaving out arcs whose
+		// chord is already longer than pairing_distance (they cannot lie on
+		// an ellipse of the expected size)
+		void Build(const VVP& arcs, float pairing_distance)
+		{
+			cell_size_ = max(pairing_distance, 1.f);
+			cells_.clear();
+			cols_ = 0;
+			rows_ = 0;
+
+			if (arcs.empty()) return;
+
+			float min_x = FLT_MAX, min_y = FLT_MAX;
+			float max_x = -FLT_MAX, max_y = -FLT_MAX;
+
+			for (size_t idx = 0; idx < arcs.size(); ++idx) {
+				Point2f m = ArcChordMidpoint(arcs[idx]);
+				min_x = min(min_x, m.x); max_x = max(max_x, m.x);
+				min_y = min(min_y, m.y); max_y = max(max_y, m.y);
+			}
+
+			origin_x_ = min_x;
+			origin_y_ = min_y;
+			cols_ = int((max_x - min_x) / cell_size_) + 1;
+			rows_ = int((max_y - min_y) / cell_size_) + 1;
+			cells_.assign(size_t(cols_) * rows_, vector<ushort>());
+
+			float pairing_distance2 = pairing_distance * pairing_distance;
+
+			for (size_t idx = 0; idx < arcs.size(); ++idx) {
+				if (ArcChordLength2(arcs[idx]) > pairing_distance2) continue;
+
+				Point2f m = ArcChordMidpoint(arcs[idx]);
+				int cx = int((m.x - origin_x_) / cell_size_);
+				int cy = int((m.y - origin_y_) / cell_size_);
+				cells_[size_t(cy) * cols_ + cx].push_back(ushort(idx));
+			}
+		}
+
+		// Collects the arcs whose chord midpoint lies within one cell of p -
+		// a superset of every indexed arc within cell_size_ of p
+		void Query(const Point2f& p, vector<ushort>& neighbors) const
+		{
+			neighbors.clear();
+
+			if (cells_.empty()) return;
+
+			int cx = cvFloor((p.x - origin_x_) / cell_size_);
+			int cy = cvFloor((p.y - origin_y_) / cell_size_);
+
+			for (int yy = max(0, cy - 1); yy <= min(rows_ - 1, cy + 1); ++yy) {
+				for (int xx = max(0, cx - 1); xx <= min(cols_ - 1, cx + 1); ++xx) {
+					const vector<ushort>& cell = cells_[size_t(yy) * cols_ + xx];
+					neighbors.insert(neighbors.end(), cell.begin(), cell.end());
+				}
+			}
+
+			// Visit candidates in the same relative order as the exhaustive
+			// scans did, so the resulting ellipse list comes out in the same
+			// order for a given set of surviving pairings
+			sort(neighbors.begin(), neighbors.end());
+		}
+
+	private:
+		float cell_size_ = 1.f;
+		float origin_x_ = 0.f;
+		float origin_y_ = 0.f;
+		int cols_ = 0;
+		int rows_ = 0;
+		vector<vector<ushort>> cells_;
+	};
+}
+
 void CEllipseDetectorYaed::Triplets124(VVP& pi,
 	VVP& pj,
 	VVP& pk,
@@ -1074,6 +1224,19 @@ void CEllipseDetectorYaed::Triplets124(VVP& pi,
 	ushort sz_j = ushort(pj.size());
 	ushort sz_k = ushort(pk.size());
 
+	// When the expected-radius bounds are set, only pair arcs within the
+	// spatial neighborhood of arc i instead of scanning all of pj/pk
+	const bool use_grid = _fMaxPairedArcDistance > 0.f;
+	const float max_chord2 = _fMaxPairedArcDistance * _fMaxPairedArcDistance;
+
+	ArcNeighborhoodGrid grid_j, grid_k;
+	vector<ushort> near_j, near_k;
+
+	if (use_grid) {
+		grid_j.Build(pj, _fMaxPairedArcDistance);
+		grid_k.Build(pk, _fMaxPairedArcDistance);
+	}
+
 	// For each edge i
 	for (ushort i = 0; i < sz_i; ++i)
 	{
@@ -1083,13 +1246,26 @@ void CEllipseDetectorYaed::Triplets124(VVP& pi,
 		Point& pif = edge_i[0];
 		Point& pil = edge_i[sz_ei - 1];
 
+		if (use_grid) {
+			// Arc i itself is too long to lie on an ellipse of the expected size
+			if (ArcChordLength2(edge_i) > max_chord2) continue;
+
+			Point2f mid_i = ArcChordMidpoint(edge_i);
+			grid_j.Query(mid_i, near_j);
+			grid_k.Query(mid_i, near_k);
+		}
+
 		// 1,2 -> reverse 1, swap
 		VP rev_i(edge_i.size());
 		reverse_copy(edge_i.begin(), edge_i.end(), rev_i.begin());
 
 		// For each edge j
-		for (ushort j = 0; j < sz_j; ++j)
+		const ushort nn_j = use_grid ? ushort(near_j.size()) : sz_j;
+
+		for (ushort jn = 0; jn < nn_j; ++jn)
 		{
+			const ushort j = use_grid ? near_j[jn] : jn;
+
 			VP& edge_j = pj[j];
 			ushort sz_ej = ushort(edge_j.size());
 
@@ -1098,7 +1274,7 @@ void CEllipseDetectorYaed::Triplets124(VVP& pi,
 
 #ifndef DISCARD_CONSTRAINT_POSITION
 			// CONSTRAINTS on position
-			if (pjl.x > pif.x + _fThPosition) //is right	
+			if (pjl.x > pif.x + _fThPosition) //is right
 			{
 				//discard
 				continue;
@@ -1108,8 +1284,12 @@ void CEllipseDetectorYaed::Triplets124(VVP& pi,
 			uint key_ij = GenerateKey(PAIR_12, i, j);
 
 			//for each edge k
-			for (ushort k = 0; k < sz_k; ++k)
+			const ushort nn_k = use_grid ? ushort(near_k.size()) : sz_k;
+
+			for (ushort kn = 0; kn < nn_k; ++kn)
 			{
+				const ushort k = use_grid ? near_k[kn] : kn;
+
 				VP& edge_k = pk[k];
 				ushort sz_ek = ushort(edge_k.size());
 
@@ -1206,6 +1386,17 @@ void CEllipseDetectorYaed::Triplets231(VVP& pi,
 	ushort sz_j = ushort(pj.size());
 	ushort sz_k = ushort(pk.size());
 
+	const bool use_grid = _fMaxPairedArcDistance > 0.f;
+	const float max_chord2 = _fMaxPairedArcDistance * _fMaxPairedArcDistance;
+
+	ArcNeighborhoodGrid grid_j, grid_k;
+	vector<ushort> near_j, near_k;
+
+	if (use_grid) {
+		grid_j.Build(pj, _fMaxPairedArcDistance);
+		grid_k.Build(pk, _fMaxPairedArcDistance);
+	}
+
 	// For each edge i
 	for (ushort i = 0; i < sz_i; ++i)
 	{
@@ -1215,12 +1406,24 @@ void CEllipseDetectorYaed::Triplets231(VVP& pi,
 		Point& pif = edge_i[0];
 		Point& pil = edge_i[sz_ei - 1];
 
+		if (use_grid) {
+			if (ArcChordLength2(edge_i) > max_chord2) continue;
+
+			Point2f mid_i = ArcChordMidpoint(edge_i);
+			grid_j.Query(mid_i, near_j);
+			grid_k.Query(mid_i, near_k);
+		}
+
 		VP rev_i(edge_i.size());
 		reverse_copy(edge_i.begin(), edge_i.end(), rev_i.begin());
 
 		// For each edge j
-		for (ushort j = 0; j < sz_j; ++j)
+		const ushort nn_j = use_grid ? ushort(near_j.size()) : sz_j;
+
+		for (ushort jn = 0; jn < nn_j; ++jn)
 		{
+			const ushort j = use_grid ? near_j[jn] : jn;
+
 			VP& edge_j = pj[j];
 			ushort sz_ej = ushort(edge_j.size());
 
@@ -1242,8 +1445,12 @@ void CEllipseDetectorYaed::Triplets231(VVP& pi,
 			uint key_ij = GenerateKey(PAIR_23, i, j);
 
 			// For each edge k
-			for (ushort k = 0; k < sz_k; ++k)
+			const ushort nn_k = use_grid ? ushort(near_k.size()) : sz_k;
+
+			for (ushort kn = 0; kn < nn_k; ++kn)
 			{
+				const ushort k = use_grid ? near_k[kn] : kn;
+
 				VP& edge_k = pk[k];
 				ushort sz_ek = ushort(edge_k.size());
 
@@ -1326,6 +1533,17 @@ void CEllipseDetectorYaed::Triplets342(VVP& pi,
 	ushort sz_j = ushort(pj.size());
 	ushort sz_k = ushort(pk.size());
 
+	const bool use_grid = _fMaxPairedArcDistance > 0.f;
+	const float max_chord2 = _fMaxPairedArcDistance * _fMaxPairedArcDistance;
+
+	ArcNeighborhoodGrid grid_j, grid_k;
+	vector<ushort> near_j, near_k;
+
+	if (use_grid) {
+		grid_j.Build(pj, _fMaxPairedArcDistance);
+		grid_k.Build(pk, _fMaxPairedArcDistance);
+	}
+
 	// For each edge i
 	for (ushort i = 0; i < sz_i; ++i)
 	{
@@ -1335,12 +1553,24 @@ void CEllipseDetectorYaed::Triplets342(VVP& pi,
 		Point& pif = edge_i[0];
 		Point& pil = edge_i[sz_ei - 1];
 
+		if (use_grid) {
+			if (ArcChordLength2(edge_i) > max_chord2) continue;
+
+			Point2f mid_i = ArcChordMidpoint(edge_i);
+			grid_j.Query(mid_i, near_j);
+			grid_k.Query(mid_i, near_k);
+		}
+
 		VP rev_i(edge_i.size());
 		reverse_copy(edge_i.begin(), edge_i.end(), rev_i.begin());
 
 		// For each edge j
-		for (ushort j = 0; j < sz_j; ++j)
+		const ushort nn_j = use_grid ? ushort(near_j.size()) : sz_j;
+
+		for (ushort jn = 0; jn < nn_j; ++jn)
 		{
+			const ushort j = use_grid ? near_j[jn] : jn;
+
 			VP& edge_j = pj[j];
 			ushort sz_ej = ushort(edge_j.size());
 
@@ -1362,8 +1592,12 @@ void CEllipseDetectorYaed::Triplets342(VVP& pi,
 			uint key_ij = GenerateKey(PAIR_34, i, j);
 
 			// For each edge k
-			for (ushort k = 0; k < sz_k; ++k)
+			const ushort nn_k = use_grid ? ushort(near_k.size()) : sz_k;
+
+			for (ushort kn = 0; kn < nn_k; ++kn)
 			{
+				const ushort k = use_grid ? near_k[kn] : kn;
+
 				VP& edge_k = pk[k];
 				ushort sz_ek = ushort(edge_k.size());
 
@@ -1449,6 +1683,17 @@ void CEllipseDetectorYaed::Triplets413(VVP& pi,
 		ushort sz_j = ushort(pj.size());
 		ushort sz_k = ushort(pk.size());
 
+		const bool use_grid = _fMaxPairedArcDistance > 0.f;
+		const float max_chord2 = _fMaxPairedArcDistance * _fMaxPairedArcDistance;
+
+		ArcNeighborhoodGrid grid_j, grid_k;
+		vector<ushort> near_j, near_k;
+
+		if (use_grid) {
+			grid_j.Build(pj, _fMaxPairedArcDistance);
+			grid_k.Build(pk, _fMaxPairedArcDistance);
+		}
+
 		// For each edge i
 		for (ushort i = 0; i < sz_i; ++i)
 		{
@@ -1458,12 +1703,24 @@ void CEllipseDetectorYaed::Triplets413(VVP& pi,
 			Point& pif = edge_i[0];
 			Point& pil = edge_i[sz_ei - 1];
 
+			if (use_grid) {
+				if (ArcChordLength2(edge_i) > max_chord2) continue;
+
+				Point2f mid_i = ArcChordMidpoint(edge_i);
+				grid_j.Query(mid_i, near_j);
+				grid_k.Query(mid_i, near_k);
+			}
+
 			VP rev_i(edge_i.size());
 			reverse_copy(edge_i.begin(), edge_i.end(), rev_i.begin());
 
 			// For each edge j
-			for (ushort j = 0; j < sz_j; ++j)
+			const ushort nn_j = use_grid ? ushort(near_j.size()) : sz_j;
+
+			for (ushort jn = 0; jn < nn_j; ++jn)
 			{
+				const ushort j = use_grid ? near_j[jn] : jn;
+
 				VP& edge_j = pj[j];
 				ushort sz_ej = ushort(edge_j.size());
 
@@ -1482,8 +1739,12 @@ void CEllipseDetectorYaed::Triplets413(VVP& pi,
 				uint key_ij = GenerateKey(PAIR_14, j, i);
 
 				// For each edge k
-				for (ushort k = 0; k < sz_k; ++k)
+				const ushort nn_k = use_grid ? ushort(near_k.size()) : sz_k;
+
+				for (ushort kn = 0; kn < nn_k; ++kn)
 				{
+					const ushort k = use_grid ? near_k[kn] : kn;
+
 					VP& edge_k = pk[k];
 					ushort sz_ek = ushort(edge_k.size());
 
@@ -1665,14 +1926,14 @@ void CEllipseDetectorYaed::DetectAfterPreProcessing(vector<Ellipse>& ellipses, c
 	ACC_R_SIZE = 180;
 	ACC_A_SIZE = max(_szImg.height, _szImg.width);
 
-	// Allocate accumulators
-	accN = new int[ACC_N_SIZE];
-	accR = new int[ACC_R_SIZE];
-	accA = new int[ACC_A_SIZE];
+	// Re-arm the retained accumulators and arc lists
+	ResetDetectionState();
 
-	// Other temporary 
-	VVP points_1, points_2, points_3, points_4;		//vector of points, one for each convexity class
-	unordered_map<uint, EllipseData> centers;		//hash map for reusing already computed EllipseData
+	VVP& points_1 = points_1_;
+	VVP& points_2 = points_2_;
+	VVP& points_3 = points_3_;
+	VVP& points_4 = points_4_;
+	unordered_map<uint, EllipseData>& centers = centers_;
 
 	// Detect edges and find convexities
 	DetectEdges13(DP, points_1, points_3);
@@ -1687,11 +1948,6 @@ void CEllipseDetectorYaed::DetectAfterPreProcessing(vector<Ellipse>& ellipses, c
 	// Sort detected ellipses with respect to score
 	sort(ellipses.begin(), ellipses.end());
 
-	//free accumulator memory
-	delete[] accN;
-	delete[] accR;
-	delete[] accA;
-
 	//cluster detections
 	//ClusterEllipses(ellipses);
 };
@@ -1711,22 +1967,28 @@ void CEllipseDetectorYaed::Detect(cv::Mat& I, vector<Ellipse>& ellipses)
 	cv::Mat DP = cv::Mat::zeros(_szImg, CV_8S);		// arcs along positive diagonal
 	cv::Mat DN = cv::Mat::zeros(_szImg, CV_8S);		// arcs along negative diagonal
 	*/
-	Mat1b DP = Mat1b::zeros(_szImg);		// arcs along positive diagonal
-	Mat1b DN = Mat1b::zeros(_szImg);		// arcs along negative diagonal
+	// create() is a no-op when the size already matches, so at a fixed image
+	// size the diagonal masks keep their allocation across calls
+	reusable_DP_.create(_szImg);
+	reusable_DN_.create(_szImg);
+	reusable_DP_.setTo(0);
+	reusable_DN_.setTo(0);
+	Mat1b& DP = reusable_DP_;		// arcs along positive diagonal
+	Mat1b& DN = reusable_DN_;		// arcs along negative diagonal
 
 	// Initialize accumulator dimensions
 	ACC_N_SIZE = 101;
 	ACC_R_SIZE = 180;
 	ACC_A_SIZE = max(_szImg.height, _szImg.width);
 
-	// Allocate accumulators
-	accN = new int[ACC_N_SIZE];
-	accR = new int[ACC_R_SIZE];
-	accA = new int[ACC_A_SIZE];
+	// Re-arm the retained accumulators and arc lists
+	ResetDetectionState();
 
-	// Other temporary 
-	VVP points_1, points_2, points_3, points_4;		//vector of points, one for each convexity class
-	unordered_map<uint, EllipseData> centers;		//hash map for reusing already computed EllipseData
+	VVP& points_1 = points_1_;
+	VVP& points_2 = points_2_;
+	VVP& points_3 = points_3_;
+	VVP& points_4 = points_4_;
+	unordered_map<uint, EllipseData>& centers = centers_;
 
 	Toc(1); //prepare data structure
 
@@ -1796,11 +2058,6 @@ void CEllipseDetectorYaed::Detect(cv::Mat& I, vector<Ellipse>& ellipses)
 	sort(ellipses.begin(), ellipses.end());
 	Toc(4); //validation
 
-	// Free accumulator memory
-	delete[] accN;
-	delete[] accR;
-	delete[] accA;
-
 	Tic(5);
 	// Cluster detections
 	ClusterEllipses(ellipses);
@@ -91,6 +91,15 @@ class CEllipseDetectorYaed
 	float	_fMaxCenterDistance;				// maximum distance in pixel between 2 center points
 	float	_fMaxCenterDistance2;				// _fMaxCenterDistance * _fMaxCenterDistance
 
+	// Selection strategy - optional prior on the target size.  When set via
+	// SetExpectedRadiusBounds(), the grouping stage indexes the arc chord
+	// midpoints on a spatial grid and only pairs arcs within a neighborhood
+	// compatible with the largest expected ellipse, instead of comparing
+	// every pair of arcs.
+	float	_fMinExpectedRadius;				// minimum expected semi-axis, in pixels
+	float	_fMaxExpectedRadius;				// maximum expected semi-axis, in pixels
+	float	_fMaxPairedArcDistance;				// derived pairing distance; 0 = pair all arcs (default)
+
 	// Validation - Points within a this threshold are considered to lie on the ellipse contour. See Sect [] in the paper
 	float	_fDistanceToEllipseContour;			// maximum distance between a point and the contour. See equation [] in the paper
 
@@ -118,6 +127,21 @@ class CEllipseDetectorYaed
 	int* accR;				// pointer to accumulator R
 	int* accA;				// pointer to accumulator A
 
+	// Retained backing storage for the accumulators, the diagonal arc masks
+	// and the per-call arc lists.  A detector instance is meant to be reused
+	// across invocations; ResetDetectionState() clears these with memset() /
+	// clear() so the capacity acquired on the first call is kept instead of
+	// the same-sized structures being re-allocated per detection.
+	vector<int> accN_storage_;
+	vector<int> accR_storage_;
+	vector<int> accA_storage_;
+
+	Mat1b reusable_DP_;		// arcs along positive diagonal
+	Mat1b reusable_DN_;		// arcs along negative diagonal
+
+	VVP points_1_, points_2_, points_3_, points_4_;		// vector of points, one for each convexity class
+	unordered_map<uint, EllipseData> centers_;			// hash map for reusing already computed EllipseData
+
 public:
 
 	//Constructor and Destructor
@@ -145,6 +169,13 @@ public:
 							int     iNs
 						);
 
+	// Bounds the arc-pairing search using the known target size - for the LM,
+	// the expected ball radius scaled by GolfSimCamera::kMinRadiusRatio /
+	// kMaxRadiusRatio.  Arcs further apart than the largest compatible
+	// ellipse are then skipped during grouping.  Pass 0, 0 to disable (the
+	// default), which keeps the exhaustive pairing behavior.
+	void SetExpectedRadiusBounds(float fMinRadiusPixels, float fMaxRadiusPixels);
+
 	// Return the execution time
 	double GetExecTime() { return _times[0] + _times[1] + _times[2] + _times[3] + _times[4] + _times[5]; }
 	vector<double> GetTimes() { return _times; }
@@ -162,6 +193,11 @@ private:
 
 	void PreProcessing(cv::Mat& I, cv::Mat& DP, cv::Mat& DN);
 
+	// Re-arm the retained accumulators and arc lists for a new detection
+	// pass.  Must be called after ACC_N_SIZE/ACC_R_SIZE/ACC_A_SIZE have been
+	// set for the current image size.
+	void ResetDetectionState();
+
 	void RemoveShortEdges(cv::Mat& edges, cv::Mat& clean);
 
 	void ClusterEllipses(vector<Ellipse>& ellipses);
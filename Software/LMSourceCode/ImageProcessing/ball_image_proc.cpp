@@ -13,9 +13,15 @@
 
 #include <ranges>
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <vector>
 #include <chrono>
 #include <fstream>
+#include <thread>
 #include "gs_format_lib.h"
 
 #include <boost/timer/timer.hpp>
@@ -25,12 +31,25 @@
 #include <opencv2/calib3d.hpp>
 #include <opencv2/core/cvdef.h>
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #include "ball_image_proc.h"
 #include "logging_tools.h"
 #include "cv_utils.h"
 #include "gs_config.h"
+#include "gs_cpu_dispatch.h"
+#include "gs_tuned_kernels.h"
+#include "gs_flight_recorder.h"
+#include "gs_perf_counters.h"
+#include "gs_gpu_preprocess.h"
+#include "gs_fused_edge_detect.h"
+#include "gs_thread_budget.h"
+#include "gs_projection_cache.h"
 #include "gs_options.h"
 #include "gs_ui_system.h"
+#include "pulse_strobe.h"
 #include "EllipseDetectorCommon.h"
 #include "EllipseDetectorYaed.h"
 
@@ -69,6 +88,24 @@ namespace golf_sim {
     static const double kEllipseColorMaskWideningAmount = 35;
     static const bool kSerializeOpsForDebug = false;
 
+    bool BallImageProc::kUseNEONSpinKernel = true;
+
+    bool BallImageProc::kUseIterativeSpinSearch = false;
+    int BallImageProc::kSpinIterativeMaxEvaluations = 120;
+    int BallImageProc::kSpinIterativeInitialStepDegrees = 16;
+
+    bool BallImageProc::kUseSpinCandidatePruning = false;
+    double BallImageProc::kSpinPruningKeepFraction = 0.15;
+    int BallImageProc::kSpinPruningSubsampleStride = 4;
+
+    bool BallImageProc::kUseBitPackedSpinImages = false;
+
+    bool BallImageProc::kWriteSpinAnalysisCsvFiles = false;
+
+    bool BallImageProc::kUseFusedSpinPipeline = false;
+    int BallImageProc::kSpinPipelineThreads = 4;
+    bool BallImageProc::kUseCachedPointCloudProjection = false;
+
     int BallImageProc::kCoarseXRotationDegreesIncrement = 6;
     int BallImageProc::kCoarseXRotationDegreesStart = -42;
     int BallImageProc::kCoarseXRotationDegreesEnd = 42;
@@ -79,6 +116,9 @@ namespace golf_sim {
     int BallImageProc::kCoarseZRotationDegreesStart = -50;
     int BallImageProc::kCoarseZRotationDegreesEnd = 60;
 
+    bool BallImageProc::kUseAdaptiveSpinSearchResolution = false;
+    double BallImageProc::kSpinWeakSignalEdgeDensity = 0.25;
+
     double BallImageProc::kPlacedBallCannyLower;
     double BallImageProc::kPlacedBallCannyUpper;
     double BallImageProc::kPlacedBallStartingParam2 = 40;
@@ -121,6 +161,17 @@ namespace golf_sim {
     int BallImageProc::kCLAHEClipLimit;
     int BallImageProc::kCLAHETilesGridSize;
 
+    bool BallImageProc::kUseFastLocalContrast = false;
+    int BallImageProc::kFastLocalContrastWindowSize = 33;
+    double BallImageProc::kFastLocalContrastGain = 48.0;
+
+    bool BallImageProc::kReuseEdgeDetectorBuffers = false;
+
+    bool BallImageProc::kUseFornaciariAnnulusMask = false;
+    int BallImageProc::kFornaciariAnnulusPadPixels = 4;
+
+    bool BallImageProc::kUseEdgeMapCache = false;
+
     double BallImageProc::kPuttingBallStartingParam2 = 40;
     double BallImageProc::kPuttingBallMinParam2 = 30;
     double BallImageProc::kPuttingBallMaxParam2 = 60;
@@ -150,6 +201,14 @@ namespace golf_sim {
     int BallImageProc::kExternallyStrobedEnvMinimumSearchRadius = 60;
     int BallImageProc::kExternallyStrobedEnvMaximumSearchRadius = 80;
 
+    bool BallImageProc::kUseSinglePassHoughAdaptation = false;
+    bool BallImageProc::kUsePyramidCircleDetection = false;
+    int BallImageProc::kPyramidDetectionScaleFactor = 4;
+
+    // Edge-drawing circle engine - disabled (for all search modes) by default
+    std::string BallImageProc::kEdgeDrawingCircleDetectionModes = "";
+    double BallImageProc::kEdgeDrawingCircleFitErrorPixels = 1.5;
+    double BallImageProc::kEdgeDrawingMinArcCoverageDegrees = 120.0;
     bool BallImageProc::kUseDynamicRadiiAdjustment = true;
     int BallImageProc::kNumberRadiiToAverageForDynamicAdjustment = 3;
     double BallImageProc::kStrobedNarrowingRadiiMinRatio = 0.8;
@@ -175,6 +234,9 @@ namespace golf_sim {
     bool BallImageProc::kUseBestCircleRefinement = false;
     bool BallImageProc::kUseBestCircleLargestCircle = false;
 
+    // 0 disables the confidence gate - every candidate is refined
+    double BallImageProc::kBestCircleRefinementConfidenceThreshold = 0.0;
+
     double BallImageProc::kBestCircleCannyLower = 55;
     double BallImageProc::kBestCircleCannyUpper = 110;
     int BallImageProc::kBestCirclePreCannyBlurSize = 5;
@@ -194,6 +256,7 @@ namespace golf_sim {
     bool BallImageProc::kExternallyStrobedUseCLAHEProcessing = true;
     int BallImageProc::kExternallyStrobedCLAHEClipLimit = 6;
     int BallImageProc::kExternallyStrobedCLAHETilesGridSize = 6;
+    bool BallImageProc::kExternallyStrobedUseFastLocalContrast = false;
 
     double BallImageProc::kBestCircleIdentificationMinRadiusRatio = 0.85;
     double BallImageProc::kBestCircleIdentificationMaxRadiusRatio = 1.10;
@@ -224,11 +287,35 @@ namespace golf_sim {
     bool BallImageProc::kONNXRuntimeAutoFallback = true;     // Enable automatic fallback
     int BallImageProc::kONNXRuntimeThreads = 4;              // ARM64 optimized default
 
+    float BallImageProc::kONNXNMSRadiusPreFilterRatio = 0.0f;  // Disabled by default
+
+    // INT8 quantization - off by default until a quantized model has been produced
+    bool BallImageProc::kONNXUseInt8Quantization = false;
+    std::string BallImageProc::kONNXInt8ModelPath = "";
+    std::string BallImageProc::kONNXCalibrationImageDir = "";
+
+    // FP16 inference - off by default until a converted model has been produced
+    bool BallImageProc::kONNXUseFp16 = false;
+    std::string BallImageProc::kONNXFp16ModelPath = "";
+
+    // On-disk optimized-model cache - saves the seconds of graph optimization
+    // otherwise re-run at every startup
+    bool BallImageProc::kONNXUseOptimizedModelCache = true;
+
+    // Two-tier placed-ball cascade - disabled until a micro model has been trained
+    std::string BallImageProc::kONNXGateModelPath = "";
+    int BallImageProc::kONNXGateInputSize = 160;
+    float BallImageProc::kONNXGateConfidenceThreshold = 0.25f;
+
     // ONNX Runtime detector instance - replaces all static ONNX members
     std::unique_ptr<ONNXRuntimeDetector> BallImageProc::onnx_detector_;
     std::atomic<bool> BallImageProc::onnx_detector_initialized_{false};
     std::mutex BallImageProc::onnx_detector_mutex_;
 
+    std::unique_ptr<ONNXRuntimeDetector> BallImageProc::onnx_gate_detector_;
+    std::atomic<bool> BallImageProc::onnx_gate_detector_initialized_{false};
+    std::atomic<bool> BallImageProc::onnx_gate_detector_failed_{false};
+
     cv::dnn::Net BallImageProc::yolo_model_;
     bool BallImageProc::yolo_model_loaded_ = false;
     std::mutex BallImageProc::yolo_model_mutex_;
@@ -258,6 +345,26 @@ namespace golf_sim {
         GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kCoarseZRotationDegreesStart", kCoarseZRotationDegreesStart);
         GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kCoarseZRotationDegreesEnd", kCoarseZRotationDegreesEnd);
 
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kUseNEONSpinKernel", kUseNEONSpinKernel);
+
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kUseAdaptiveSpinSearchResolution", kUseAdaptiveSpinSearchResolution);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kSpinWeakSignalEdgeDensity", kSpinWeakSignalEdgeDensity);
+
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kUseIterativeSpinSearch", kUseIterativeSpinSearch);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kSpinIterativeMaxEvaluations", kSpinIterativeMaxEvaluations);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kSpinIterativeInitialStepDegrees", kSpinIterativeInitialStepDegrees);
+
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kUseSpinCandidatePruning", kUseSpinCandidatePruning);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kSpinPruningKeepFraction", kSpinPruningKeepFraction);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kSpinPruningSubsampleStride", kSpinPruningSubsampleStride);
+
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kUseBitPackedSpinImages", kUseBitPackedSpinImages);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kWriteSpinAnalysisCsvFiles", kWriteSpinAnalysisCsvFiles);
+
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kUseFusedSpinPipeline", kUseFusedSpinPipeline);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kSpinPipelineThreads", kSpinPipelineThreads);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kUseCachedPointCloudProjection", kUseCachedPointCloudProjection);
+
         GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kGaborMinWhitePercent", kGaborMinWhitePercent);
         GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kGaborMaxWhitePercent", kGaborMaxWhitePercent);
 
@@ -301,6 +408,13 @@ namespace golf_sim {
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseCLAHEProcessing", kUseCLAHEProcessing);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kCLAHEClipLimit", kCLAHEClipLimit);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kCLAHETilesGridSize", kCLAHETilesGridSize);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseFastLocalContrast", kUseFastLocalContrast);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kFastLocalContrastWindowSize", kFastLocalContrastWindowSize);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kFastLocalContrastGain", kFastLocalContrastGain);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kReuseEdgeDetectorBuffers", kReuseEdgeDetectorBuffers);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseFornaciariAnnulusMask", kUseFornaciariAnnulusMask);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kFornaciariAnnulusPadPixels", kFornaciariAnnulusPadPixels);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseEdgeMapCache", kUseEdgeMapCache);
 
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kPuttingBallStartingParam2", kPuttingBallStartingParam2);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kPuttingBallMinParam2", kPuttingBallMinParam2);
@@ -336,6 +450,7 @@ namespace golf_sim {
         GolfSimConfiguration::SetConstant("gs_config.testing.kExternallyStrobedUseCLAHEProcessing", kExternallyStrobedUseCLAHEProcessing);
         GolfSimConfiguration::SetConstant("gs_config.testing.kExternallyStrobedCLAHEClipLimit", kExternallyStrobedCLAHEClipLimit);
         GolfSimConfiguration::SetConstant("gs_config.testing.kExternallyStrobedCLAHETilesGridSize", kExternallyStrobedCLAHETilesGridSize);
+        GolfSimConfiguration::SetConstant("gs_config.testing.kExternallyStrobedUseFastLocalContrast", kExternallyStrobedUseFastLocalContrast);
 
         GolfSimConfiguration::SetConstant("gs_config.testing.kExternallyStrobedEnvHoughDpParam1", kExternallyStrobedEnvHoughDpParam1);
         GolfSimConfiguration::SetConstant("gs_config.testing.kExternallyStrobedEnvMaximumSearchRadius", kExternallyStrobedEnvMaximumSearchRadius);
@@ -352,6 +467,7 @@ namespace golf_sim {
 
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseBestCircleRefinement", kUseBestCircleRefinement);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseBestCircleLargestCircle", kUseBestCircleLargestCircle);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kBestCircleRefinementConfidenceThreshold", kBestCircleRefinementConfidenceThreshold);
 
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kBestCircleCannyLower", kBestCircleCannyLower);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kBestCircleCannyUpper", kBestCircleCannyUpper);
@@ -365,6 +481,14 @@ namespace golf_sim {
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kBestCircleIdentificationMaxRadiusRatio", kBestCircleIdentificationMaxRadiusRatio);
 
 
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseSinglePassHoughAdaptation", kUseSinglePassHoughAdaptation);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUsePyramidCircleDetection", kUsePyramidCircleDetection);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kPyramidDetectionScaleFactor", kPyramidDetectionScaleFactor);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kEdgeDrawingCircleDetectionModes", kEdgeDrawingCircleDetectionModes);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kEdgeDrawingCircleFitErrorPixels", kEdgeDrawingCircleFitErrorPixels);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kEdgeDrawingMinArcCoverageDegrees", kEdgeDrawingMinArcCoverageDegrees);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseGpuPreprocessing", GsGpuPreprocess::kUseGpuPreprocessing);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseFusedBlurCanny", GsFusedEdgeDetect::kUseFusedBlurCanny);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kUseDynamicRadiiAdjustment", kUseDynamicRadiiAdjustment);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kNumberRadiiToAverageForDynamicAdjustment", kNumberRadiiToAverageForDynamicAdjustment);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kStrobedNarrowingRadiiMinRatio", kStrobedNarrowingRadiiMinRatio);
@@ -418,11 +542,84 @@ namespace golf_sim {
         // Call CleanupONNXRuntime() only on program exit, not per-instance destruction
     }
 
+    /**
+     * The integral-image local contrast normalization used in place of CLAHE when
+     * kUseFastLocalContrast is set.  The local mean and mean-of-squares over the
+     * configured window come from box filters (sliding sums, so the cost does not
+     * grow with the window), and each pixel is then remapped to
+     * 128 + gain * (x - mean) / (sigma + 1).  The remap pass runs through the
+     * NEON builds in gs_tuned_kernels.cpp on the Pi, with a scalar fallback
+     * elsewhere.
+     *
+     * \param image  The 8-bit gray-scale input image.
+     * \param result  Receives the normalized 8-bit image (must not alias image).
+     * \return True on success.
+     */
+    bool BallImageProc::ApplyFastLocalContrast(const cv::Mat& image, cv::Mat& result) {
+
+        int window_size = kFastLocalContrastWindowSize;
+
+        if (window_size < 3) {
+            GS_LOG_MSG(warning, "kFastLocalContrastWindowSize was < 3 - Resetting to 3.");
+            window_size = 3;
+        }
+
+        // The window must be odd - force it up in value by 1 if necessary
+        if (window_size % 2 != 1) {
+            window_size++;
+        }
+
+        cv::Size window(window_size, window_size);
+
+        cv::boxFilter(image, local_contrast_mean_buffer_, CV_32F, window,
+                      cv::Point(-1, -1), true, cv::BORDER_REPLICATE);
+        cv::sqrBoxFilter(image, local_contrast_mean_sq_buffer_, CV_32F, window,
+                         cv::Point(-1, -1), true, cv::BORDER_REPLICATE);
+
+        result.create(image.size(), CV_8UC1);
+
+#if defined(__aarch64__)
+        if (image.isContinuous() && result.isContinuous()) {
+            if (GsCpuDispatch::GetTuningTarget() == GsCpuDispatch::kTuneCortexA72) {
+                tuned_a72::LocalContrastNormalizeNEON(image, local_contrast_mean_buffer_,
+                    local_contrast_mean_sq_buffer_, (float)kFastLocalContrastGain, result);
+            }
+            else {
+                tuned_a76::LocalContrastNormalizeNEON(image, local_contrast_mean_buffer_,
+                    local_contrast_mean_sq_buffer_, (float)kFastLocalContrastGain, result);
+            }
+
+            return true;
+        }
+#endif
+
+        // Scalar fallback - same arithmetic as the NEON kernel
+        float gain = (float)kFastLocalContrastGain;
+
+        for (int row = 0; row < image.rows; row++) {
+            const uchar* image_row = image.ptr<uchar>(row);
+            const float* mean_row = local_contrast_mean_buffer_.ptr<float>(row);
+            const float* mean_sq_row = local_contrast_mean_sq_buffer_.ptr<float>(row);
+            uchar* result_row = result.ptr<uchar>(row);
+
+            for (int col = 0; col < image.cols; col++) {
+                float mean = mean_row[col];
+                float variance = mean_sq_row[col] - mean * mean;
+                float sigma = std::sqrt(variance < 0.0f ? 0.0f : variance) + 1.0f;
+                float value = 128.0f + gain * ((float)image_row[col] - mean) / sigma;
+                result_row[col] = (uchar)(value < 0.0f ? 0 : (value > 255.0f ? 255 : (int)(value + 0.5f)));
+            }
+        }
+
+        return true;
+    }
+
+
     /**
      * Given a gray-scale image and a ball search mode (e.g., kStrobed), this function applies
      * CLAHE processing to improve the contrast and edge definition of the balls.  It then
      * applies a Guassian blur and edge detection to the image.
-     * 
+     *
      * \param search_image  The image to be processed.
      * \param search_mode  Currently can be only kStrobed or kExternallyStrobed
      * \return True on success.
@@ -432,6 +629,8 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "PreProcessStrobedImage");
 
+        GsPerfCounters::ScopedStage perf_stage("PreProcessStrobedImage");
+
         if (search_image.empty()) {
             GS_LOG_MSG(error, "PreProcessStrobedImage called with no image to work with (search_image)");
             return false;
@@ -440,16 +639,19 @@ namespace golf_sim {
         // setup CLAHE processing dependent on PiTrac-only strobing or externally-strobed
         
         bool use_clahe_processing = true;
+        bool use_fast_local_contrast = false;
         int clahe_tiles_grid_size = -1;
         int clahe_clip_limit = -1;
 
         if (search_mode == kStrobed) {
             use_clahe_processing = kUseCLAHEProcessing;
+            use_fast_local_contrast = kUseFastLocalContrast;
             clahe_tiles_grid_size = kCLAHETilesGridSize;
             clahe_clip_limit = kCLAHEClipLimit;
         }
         else if (search_mode == kExternallyStrobed) {
             use_clahe_processing = kExternallyStrobedUseCLAHEProcessing;
+            use_fast_local_contrast = kExternallyStrobedUseFastLocalContrast;
             clahe_tiles_grid_size = kExternallyStrobedCLAHETilesGridSize;
             clahe_clip_limit = kExternallyStrobedCLAHEClipLimit;
         }
@@ -458,34 +660,9 @@ namespace golf_sim {
             return false;
         }
 
-        // Create a CLAHE object
-
-        if (use_clahe_processing) {
-            cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE();
-
-            // Set CLAHE parameters
-
-            if (clahe_tiles_grid_size < 1) {
-                clahe_tiles_grid_size = 1;
-                GS_LOG_MSG(warning, "clahe_tiles_grid_size was < 1 - Resetting to 1.");
-            }
-            if (clahe_clip_limit < 1) {
-                clahe_clip_limit = 1;
-                GS_LOG_MSG(warning, "kCLAHEClipLimit was < 1 - Resetting to 1.");
-            }
-
-            GS_LOG_TRACE_MSG(trace, "Using CLAHE Pre-processing with GridSize = " + std::to_string(clahe_tiles_grid_size) +
-                ", ClipLimit = " + std::to_string(clahe_clip_limit));
-
-            clahe->setClipLimit(clahe_clip_limit);
-            clahe->setTilesGridSize(cv::Size(clahe_tiles_grid_size, clahe_tiles_grid_size));
-
-            // Apply CLAHE
-            cv::Mat equalizedImage;
-            clahe->apply(search_image, search_image);
-
-            LoggingTools::DebugShowImage(image_name_ + "  Strobed Ball Image - After CLAHE equalization", search_image);
-        }
+        // The Canny thresholds and blur sizes are selected up front (rather than
+        // just before the blur below) so the whole parameter set is in hand for
+        // the edge-map cache check.
 
         double canny_lower = 0.0;
         double canny_upper = 0.0;
@@ -526,6 +703,99 @@ namespace golf_sim {
             }
         }
 
+        // If this exact frame already went through this exact chain (same CLAHE
+        // settings, blur sizes and Canny thresholds), hand back the cached edge
+        // map instead of recomputing it.  The pixel sum is a cheap content check
+        // (a single pass over the image versus the several filter passes below)
+        // that keeps a pooled buffer reused for a new frame from producing a
+        // stale hit.
+        double input_signature = 0.0;
+
+        if (kUseEdgeMapCache) {
+            input_signature = cv::sum(search_image)[0];
+
+            if (!edge_map_cache_output_.empty() &&
+                edge_map_cache_signature_ == input_signature &&
+                edge_map_cache_rows_ == search_image.rows &&
+                edge_map_cache_cols_ == search_image.cols &&
+                edge_map_cache_mode_ == (int)search_mode &&
+                edge_map_cache_used_clahe_ == use_clahe_processing &&
+                edge_map_cache_clahe_grid_ == clahe_tiles_grid_size &&
+                edge_map_cache_clahe_clip_ == clahe_clip_limit &&
+                edge_map_cache_used_fast_contrast_ == use_fast_local_contrast &&
+                edge_map_cache_contrast_window_ == kFastLocalContrastWindowSize &&
+                edge_map_cache_contrast_gain_ == kFastLocalContrastGain &&
+                edge_map_cache_pre_canny_blur_ == pre_canny_blur_size &&
+                edge_map_cache_pre_hough_blur_ == pre_hough_blur_size &&
+                edge_map_cache_canny_lower_ == canny_lower &&
+                edge_map_cache_canny_upper_ == canny_upper) {
+
+                edge_map_cache_hits_++;
+                GS_LOG_TRACE_MSG(trace, "PreProcessStrobedImage - reusing the cached edge map (" +
+                    std::to_string(edge_map_cache_hits_) + " hits, " +
+                    std::to_string(edge_map_cache_misses_) + " misses so far).");
+
+                search_image = edge_map_cache_output_;
+                return true;
+            }
+
+            edge_map_cache_misses_++;
+
+            // Record the key now, before the CLAHE sanity clamps below can
+            // adjust the locals - the next lookup compares pre-clamp values.
+            edge_map_cache_signature_ = input_signature;
+            edge_map_cache_rows_ = search_image.rows;
+            edge_map_cache_cols_ = search_image.cols;
+            edge_map_cache_mode_ = (int)search_mode;
+            edge_map_cache_used_clahe_ = use_clahe_processing;
+            edge_map_cache_clahe_grid_ = clahe_tiles_grid_size;
+            edge_map_cache_clahe_clip_ = clahe_clip_limit;
+            edge_map_cache_used_fast_contrast_ = use_fast_local_contrast;
+            edge_map_cache_contrast_window_ = kFastLocalContrastWindowSize;
+            edge_map_cache_contrast_gain_ = kFastLocalContrastGain;
+            edge_map_cache_pre_canny_blur_ = pre_canny_blur_size;
+            edge_map_cache_pre_hough_blur_ = pre_hough_blur_size;
+            edge_map_cache_canny_lower_ = canny_lower;
+            edge_map_cache_canny_upper_ = canny_upper;
+        }
+
+        if (use_fast_local_contrast) {
+
+            // The fast path replaces CLAHE outright when both are enabled
+            if (!ApplyFastLocalContrast(search_image, preprocess_clahe_buffer_)) {
+                return false;
+            }
+            search_image = preprocess_clahe_buffer_;
+
+            LoggingTools::DebugShowImage(image_name_ + "  Strobed Ball Image - After fast local-contrast normalization", search_image);
+        }
+        else if (use_clahe_processing) {
+            cv::Ptr<cv::CLAHE> clahe = cv::createCLAHE();
+
+            // Set CLAHE parameters
+
+            if (clahe_tiles_grid_size < 1) {
+                clahe_tiles_grid_size = 1;
+                GS_LOG_MSG(warning, "clahe_tiles_grid_size was < 1 - Resetting to 1.");
+            }
+            if (clahe_clip_limit < 1) {
+                clahe_clip_limit = 1;
+                GS_LOG_MSG(warning, "kCLAHEClipLimit was < 1 - Resetting to 1.");
+            }
+
+            GS_LOG_TRACE_MSG(trace, "Using CLAHE Pre-processing with GridSize = " + std::to_string(clahe_tiles_grid_size) +
+                ", ClipLimit = " + std::to_string(clahe_clip_limit));
+
+            clahe->setClipLimit(clahe_clip_limit);
+            clahe->setTilesGridSize(cv::Size(clahe_tiles_grid_size, clahe_tiles_grid_size));
+
+            // Apply CLAHE into the pooled buffer - applying in place would force an
+            // internal temporary allocation on every shot
+            clahe->apply(search_image, preprocess_clahe_buffer_);
+            search_image = preprocess_clahe_buffer_;
+
+            LoggingTools::DebugShowImage(image_name_ + "  Strobed Ball Image - After CLAHE equalization", search_image);
+        }
 
         GS_LOG_MSG(trace, "Main HoughCircle Image Prep - Performing Pre-Hough Blur and Canny for kStrobed mode.");
         GS_LOG_MSG(trace, "  Blur Parameters are: pre_canny_blur_size = " + std::to_string(pre_canny_blur_size) +
@@ -534,34 +804,224 @@ namespace golf_sim {
             ", canny_upper " + std::to_string(canny_upper));
 
 
-        if (pre_canny_blur_size > 0) {
-            cv::GaussianBlur(search_image, search_image, cv::Size(pre_canny_blur_size, pre_canny_blur_size), 0);
-        }
-        else {
-            GS_LOG_TRACE_MSG(trace, "Skipping pre-Canny Blur");
+        // The fused kernel computes the pre-Canny blur and the Canny edge
+        // map in one rolling pass whose working set is a few cache-resident
+        // rows, so the full blurred frame never makes a round trip through
+        // memory (see GsFusedEdgeDetect).  These passes are bandwidth-bound
+        // on the Pi, which is what makes the fusion pay.
+        bool fused_edge_map_done = false;
+
+        if (GsFusedEdgeDetect::kUseFusedBlurCanny &&
+            !GsGpuPreprocess::kUseGpuPreprocessing &&
+            pre_canny_blur_size > 0) {
+
+            if (GsFusedEdgeDetect::BlurAndCanny(search_image, preprocess_canny_buffer_,
+                                                pre_canny_blur_size, canny_lower, canny_upper)) {
+                // Keep the post-Canny blur below writing into the pooled blur
+                // buffer (as the separate-pass path does), never the caller's image
+                search_image = preprocess_blur_buffer_;
+                fused_edge_map_done = true;
+            }
         }
 
-        // TBD - REMOVED THIS FOR NOW - IT DOESN'T SEEM TO HELP
-        for (int i = 0; i < 0; i++) {
-            cv::erode(search_image, search_image, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3)), cv::Point(-1, -1), 3);
-            cv::dilate(search_image, search_image, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3)), cv::Point(-1, -1), 3);
+        if (!fused_edge_map_done) {
+
+            if (pre_canny_blur_size > 0) {
+                // The blurs are the stages that map cleanly onto the GPU backend.
+                // The Canny below stays on the CPU - its hysteresis pass is the
+                // part that doesn't fit a per-pixel compute dispatch.
+                if (!GsGpuPreprocess::kUseGpuPreprocessing ||
+                    !GsGpuPreprocess::GaussianBlur(search_image, preprocess_blur_buffer_, pre_canny_blur_size)) {
+                    cv::GaussianBlur(search_image, preprocess_blur_buffer_, cv::Size(pre_canny_blur_size, pre_canny_blur_size), 0);
+                }
+                search_image = preprocess_blur_buffer_;
+            }
+            else {
+                GS_LOG_TRACE_MSG(trace, "Skipping pre-Canny Blur");
+            }
+
+            // TBD - REMOVED THIS FOR NOW - IT DOESN'T SEEM TO HELP
+            for (int i = 0; i < 0; i++) {
+                cv::erode(search_image, search_image, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3)), cv::Point(-1, -1), 3);
+                cv::dilate(search_image, search_image, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3)), cv::Point(-1, -1), 3);
+            }
+
+            LoggingTools::DebugShowImage(image_name_ + "  Strobed Ball Image - Ready for Edge Detection", search_image);
+
+            // The Canny output lives in (and is recycled with) the pooled buffer
+            if (search_mode == kExternallyStrobed && pre_canny_blur_size == 0) {
+                // Don't do the Canny at all if the blur size is zero and we're in comparison mode
+                search_image.copyTo(preprocess_canny_buffer_);
+            }
+            else {
+                cv::Canny(search_image, preprocess_canny_buffer_, canny_lower, canny_upper);
+            }
         }
 
-        LoggingTools::DebugShowImage(image_name_ + "  Strobed Ball Image - Ready for Edge Detection", search_image);
+        LoggingTools::DebugShowImage(image_name_ + "  cannyOutput_for_balls", preprocess_canny_buffer_);
 
-        cv::Mat cannyOutput_for_balls;
-        if (search_mode == kExternallyStrobed && pre_canny_blur_size == 0) {
-            // Don't do the Canny at all if the blur size is zero and we're in comparison mode
-            cannyOutput_for_balls = search_image.clone();
+        // Blur the lines-only image back to the search_image that the code below uses
+        if (!GsGpuPreprocess::kUseGpuPreprocessing ||
+            !GsGpuPreprocess::GaussianBlur(preprocess_canny_buffer_, search_image, pre_hough_blur_size)) {
+            cv::GaussianBlur(preprocess_canny_buffer_, search_image, cv::Size(pre_hough_blur_size, pre_hough_blur_size), 0);   // Nominal is 7x7
         }
-        else {
-            cv::Canny(search_image, cannyOutput_for_balls, canny_lower, canny_upper);
+
+        if (kUseEdgeMapCache) {
+            // The key was recorded at lookup time above - just retain the output.
+            // The copy costs one memcpy on a miss; a hit saves the whole chain.
+            search_image.copyTo(edge_map_cache_output_);
         }
 
-        LoggingTools::DebugShowImage(image_name_ + "  cannyOutput_for_balls", cannyOutput_for_balls);
+        return true;
+    }
 
-        // Blur the lines-only image back to the search_image that the code below uses
-        cv::GaussianBlur(cannyOutput_for_balls, search_image, cv::Size(pre_hough_blur_size, pre_hough_blur_size), 0);   // Nominal is 7x7
+    // With HOUGH_GRADIENT, param2 is simply the accumulator-vote threshold for circle
+    // centers.  Running the transform once at the loosest threshold (min_param2) with
+    // the per-circle vote counts requested therefore yields every circle that any
+    // tighter setting could have returned, and the param2 retry walk collapses into a
+    // cheap filter over the cached votes.  Note that center non-maximum suppression
+    // happens once at the loose threshold, so borderline results can differ slightly
+    // from a literal re-run at a tighter threshold.
+    bool BallImageProc::HoughCirclesSinglePassAdaptive(const cv::Mat& search_image,
+                                        double dp,
+                                        double minimum_distance,
+                                        double param1,
+                                        double starting_param2,
+                                        double min_param2,
+                                        double max_param2,
+                                        double param2_increment,
+                                        int minimum_search_radius,
+                                        int maximum_search_radius,
+                                        int min_circles_to_return,
+                                        int max_circles_to_return,
+                                        std::vector<GsCircle>& circles,
+                                        int& final_number_of_found_circles,
+                                        bool report_find_failures) {
+
+        GS_LOG_TRACE_MSG(trace, "Executing single-pass houghCircles with dp = " + std::to_string(dp) +
+            ", minDist = " + std::to_string(minimum_distance) + ", param1 = " + std::to_string(param1) +
+            ", param2 = " + std::to_string(min_param2) + " (loosest), minRadius = " + std::to_string(minimum_search_radius) +
+            ", maxRadius = " + std::to_string(maximum_search_radius));
+
+        // The 4-element output variant returns the accumulator votes for each circle
+        std::vector<cv::Vec4f> voted_circles;
+
+        cv::HoughCircles(search_image,
+            voted_circles,
+            cv::HOUGH_GRADIENT,
+            dp,
+            minimum_distance,
+            param1,
+            min_param2,
+            minimum_search_radius,
+            maximum_search_radius);
+
+        GS_LOG_TRACE_MSG(trace, "Single-pass Hough cached " + std::to_string(voted_circles.size()) + " voted circles.");
+
+        auto CirclesAtThreshold = [&voted_circles](double param2) -> std::vector<GsCircle> {
+            std::vector<GsCircle> result;
+            for (const cv::Vec4f& v : voted_circles) {
+                if (v[3] >= param2) {
+                    result.push_back(GsCircle(v[0], v[1], v[2]));
+                }
+            }
+            return result;
+        };
+
+        // From here, the widen/tighten walk is identical to the retry loop in GetBall -
+        // it just re-thresholds the cached votes instead of re-running the transform
+        double currentParam2 = starting_param2;
+        int priorNumCircles = 0;
+        bool currentlyLooseningSearch = false;
+        bool done = false;
+
+        final_number_of_found_circles = 0;
+
+        while (!done) {
+
+            GS_LOG_TRACE_MSG(trace, "Re-thresholding cached Hough votes at param2 = " + std::to_string(currentParam2));
+
+            std::vector<GsCircle> test_circles = CirclesAtThreshold(currentParam2);
+
+            priorNumCircles = circles.empty() ? 0 : (int)circles.size();
+
+            int numCircles = (int)test_circles.size();
+
+            if (!RemoveSmallestConcentricCircles(test_circles)) {
+                GS_LOG_TRACE_MSG(warning, "Failed to RemoveSmallestConcentricCircles.");
+                return false;
+            }
+
+            if (numCircles >= min_circles_to_return && numCircles <= max_circles_to_return) {
+                // We found what we consider to be a reasonable number of circles
+                circles.assign(test_circles.begin(), test_circles.end());
+                final_number_of_found_circles = numCircles;
+                done = true;
+                break;
+            }
+
+            if (numCircles > max_circles_to_return) {
+                GS_LOG_TRACE_MSG(trace, "Found more circles than desired (" + std::to_string(numCircles) + " circles).");
+
+                if ((priorNumCircles == 0) && (currentParam2 != starting_param2)) {
+                    GS_LOG_TRACE_MSG(trace, "Could not narrow number of balls to just 1");
+                    circles.assign(test_circles.begin(), test_circles.end());
+                    final_number_of_found_circles = numCircles;
+                    done = true;
+                }
+
+                if (currentParam2 >= max_param2) {
+                    GS_LOG_TRACE_MSG(trace, "Could not narrow number of balls to just 1.  Produced " + std::to_string(numCircles) + " balls.");
+                    circles.assign(test_circles.begin(), test_circles.end());
+                    final_number_of_found_circles = numCircles;
+                    done = true;
+                }
+                else {
+                    circles.assign(test_circles.begin(), test_circles.end());
+                    currentParam2 += param2_increment;
+                    currentlyLooseningSearch = false;
+                    done = false;
+                }
+            }
+            else {
+                if (numCircles == 0 && priorNumCircles == 0) {
+                    if (currentParam2 <= min_param2) {
+                        if (report_find_failures) {
+                            GS_LOG_MSG(error, "Could not find any balls");
+                        }
+                        done = true;
+                    }
+                    else {
+                        currentParam2 -= param2_increment;
+                        currentlyLooseningSearch = true;
+                        circles.assign(test_circles.begin(), test_circles.end());
+                        done = false;
+                    }
+                }
+                else if (((numCircles > 0 && numCircles < min_circles_to_return) && priorNumCircles == 0) ||
+                    (currentlyLooseningSearch == true)) {
+                    if (currentParam2 <= min_param2) {
+                        GS_LOG_TRACE_MSG(trace, "Could not find as many balls as hoped");
+                        circles.assign(test_circles.begin(), test_circles.end());
+                        final_number_of_found_circles = numCircles;
+                        done = true;
+                    }
+                    else {
+                        currentParam2 -= param2_increment;
+                        currentlyLooseningSearch = true;
+                        circles.assign(test_circles.begin(), test_circles.end());
+                        done = false;
+                    }
+                }
+                else if (numCircles == 0 && priorNumCircles > 0) {
+                    GS_LOG_TRACE_MSG(trace, "Could only narrow down to " + std::to_string(numCircles) + " balls");
+                    final_number_of_found_circles = numCircles;
+                    done = true;
+                }
+            }
+
+            GS_LOG_TRACE_MSG(trace, "Found " + std::to_string(numCircles) + " circles.");
+        }
 
         return true;
     }
@@ -569,15 +1029,20 @@ namespace golf_sim {
     // Given a picture, see if we can find the golf ball somewhere in that picture.
     // Should be much more successful if called with a calibrated golf ball so that the code has
     // some hints about where to look.
-    // Returns a new GolfBall object iff success. 
-    bool BallImageProc::GetBall(const cv::Mat& rgbImg,
+    // Returns a new GolfBall object iff success.
+    // The search mode arrives as a template parameter (see GetBallForMode in the
+    // header) - every "search_mode == ..." test below compares a constexpr value,
+    // so each instantiation keeps only its own mode's branches.
+    template <BallImageProc::BallSearchMode MODE>
+    bool BallImageProc::GetBallForMode(const cv::Mat& rgbImg,
                                 const GolfBall& baseBallWithSearchParams,
                                 std::vector<GolfBall> &return_balls,
                                 cv::Rect& expectedBallArea,
-                                BallSearchMode search_mode,
                                 bool chooseLargestFinalBall,
                                 bool report_find_failures) {
 
+        constexpr BallSearchMode search_mode = MODE;
+
         auto getball_start = std::chrono::high_resolution_clock::now();
         GS_LOG_TRACE_MSG(trace, "GetBall called with PREBLUR_IMAGE = " + std::to_string(PREBLUR_IMAGE) + " IS_COLOR_MASKING = " +
                     std::to_string(IS_COLOR_MASKING) + " FINAL_BLUR = " + std::to_string(FINAL_BLUR) + " search_mode = " + std::to_string(search_mode));
@@ -650,11 +1115,10 @@ namespace golf_sim {
         // We will not do anything with the areaMask(other than to apply it further below if it exists)
         if (color_mask_image_.empty()) {
 
-            cv::Mat hsvImage;
-            cv::cvtColor(blurImg, hsvImage, cv::COLOR_BGR2HSV);
-
-            // Save the colorMask for later debugging as well as for use below
-            color_mask_image_ = GetColorMaskImage(hsvImage, baseBallWithSearchParams);
+            // Save the colorMask for later debugging as well as for use below.
+            // The LUT-based masking avoids converting the whole image to HSV
+            // and range-testing it for every candidate search.
+            color_mask_image_ = GetColorMaskImageFromBgr(blurImg, baseBallWithSearchParams);
         }
 
         // LoggingTools::DebugShowImage(image_name_ + "  cv::GaussianBlur(...) hsvImage", hsvImage);
@@ -762,8 +1226,19 @@ namespace golf_sim {
 
                 LoggingTools::DebugShowImage(image_name_ + "  Putting Image - Ready for Edge Detection", search_image);
 
-                EDPF testEDPF = EDPF(search_image);
-                Mat edgePFImage = testEDPF.getEdgeImage();
+                Mat edgePFImage;
+
+                if (kReuseEdgeDetectorBuffers) {
+                    // Reuse the retained detector's internal buffers; they are only
+                    // re-allocated when the putt image dimensions change.
+                    reusable_edpf_.Process(search_image);
+                    edgePFImage = reusable_edpf_.getEdgeImage();
+                }
+                else {
+                    EDPF testEDPF = EDPF(search_image);
+                    edgePFImage = testEDPF.getEdgeImage();
+                }
+
                 edgePFImage = edgePFImage * -1 + 255;
                 search_image = edgePFImage;
 
@@ -967,6 +1442,62 @@ namespace golf_sim {
         else {
             // Do nothing if we don't have a sub-image.  Any later offsets will be 0, so will do nothing
             final_search_image = search_image;
+
+            // Pyramid coarse-to-fine pre-pass for full-frame placed-ball searches (see
+            // kUsePyramidCircleDetection).  The frame is scanned for the approximate
+            // ball at a fraction of the sensor resolution, and the full-precision
+            // adaptive search below then only runs over a small full-resolution window
+            // around the coarse hit.  This is the search that runs continuously while
+            // waiting for a ball to appear, so the steady-state load drops roughly
+            // with the square of the scale factor.
+            if (kUsePyramidCircleDetection && search_mode == kFindPlacedBall && kPyramidDetectionScaleFactor > 1) {
+
+                double inv_scale = 1.0 / (double)kPyramidDetectionScaleFactor;
+
+                cv::Mat coarse_image;
+                cv::resize(search_image, coarse_image, cv::Size(), inv_scale, inv_scale, cv::INTER_AREA);
+
+                // Only the approximate position matters here, so use the loosest
+                // param2.  The ALT algorithm's circle-perfectness measure is
+                // resolution-independent, so no threshold rescaling is needed.
+                std::vector<GsCircle> coarse_circles;
+
+                cv::HoughCircles(coarse_image,
+                    coarse_circles,
+                    cv::HOUGH_GRADIENT_ALT,
+                    kPlacedBallHoughDpParam1,
+                    std::max(1.0, minimum_distance * inv_scale),
+                    currentParam1,
+                    min_param2,
+                    std::max(1, (int)(minimum_search_radius * inv_scale)),
+                    std::max(2, (int)std::ceil(maximum_search_radius * inv_scale)));
+
+                if (!coarse_circles.empty()) {
+                    // Take the strongest coarse hit and refine around it at full
+                    // resolution.  The window is padded to absorb the coarse pass's
+                    // center and radius quantization error.
+                    double full_x = coarse_circles[0][0] * kPyramidDetectionScaleFactor;
+                    double full_y = coarse_circles[0][1] * kPyramidDetectionScaleFactor;
+                    double full_r = coarse_circles[0][2] * kPyramidDetectionScaleFactor;
+
+                    double window_half_size = 1.5 * full_r + 2.0 * kPyramidDetectionScaleFactor;
+
+                    cv::Rect refinement_window{ (int)std::round(full_x - window_half_size),
+                                                (int)std::round(full_y - window_half_size),
+                                                (int)std::round(2.0 * window_half_size),
+                                                (int)std::round(2.0 * window_half_size) };
+
+                    // Note - if the window runs off the image, it will be corrected.
+                    final_search_image = CvUtils::GetSubImage(search_image, refinement_window, offset_sub_to_full, offset_full_to_sub);
+
+                    GS_LOG_TRACE_MSG(trace, "Pyramid coarse pass found candidate at (" + std::to_string((int)full_x) + ", " +
+                        std::to_string((int)full_y) + "), radius " + std::to_string((int)full_r) +
+                        ".  Refining in a " + std::to_string(refinement_window.width) + "-pixel-wide full-resolution window.");
+                }
+                else {
+                    GS_LOG_TRACE_MSG(trace, "Pyramid coarse pass found no candidate ball.  Searching at full resolution.");
+                }
+            }
         }
 
         // LoggingTools::DebugShowImage(image_name_ + "  Final sub-image search_image for Hough Transform{ ", final_search_image);
@@ -1149,6 +1680,37 @@ namespace golf_sim {
             goto post_detection_processing;
         }
 
+        // Edge-drawing circle engine: the parameter-free EDPF edge detector plus
+        // arc grouping and least-squares circle fitting replaces the HoughCircles
+        // pass (and the whole param2 retry walk) for the search modes listed in
+        // kEdgeDrawingCircleDetectionModes.  Falls back to the Hough path below
+        // when it finds nothing, so enabling it can only add detections.
+        if (EdgeDrawingEnabledForMode(search_mode)) {
+            std::vector<GsCircle> ed_circles;
+            if (DetectBallsEdgeDrawing(final_search_image, minimum_search_radius, maximum_search_radius, ed_circles)) {
+                circles.assign(ed_circles.begin(), ed_circles.end());
+                finalNumberOfFoundCircles = (int)circles.size();
+                done = true;
+            }
+            else {
+                GS_LOG_TRACE_MSG(trace, "Edge-drawing circle engine found no circles - falling back to HoughCircles.");
+            }
+        }
+
+        // The single-pass engine computes the Hough accumulator once and replays the
+        // param2 walk below as an in-memory filter.  It needs the vote semantics of
+        // the non-ALT algorithm, so the ALT modes fall through to the retry loop.
+        if (!done && kUseSinglePassHoughAdaptation && hough_mode == cv::HOUGH_GRADIENT) {
+            if (!HoughCirclesSinglePassAdaptive(final_search_image, currentDp, minimum_distance, currentParam1,
+                starting_param2, min_param2, max_param2, param2_increment,
+                (int)minimum_search_radius, (int)maximum_search_radius,
+                min_circles_to_return_from_hough, max_circles_to_return_from_hough,
+                circles, finalNumberOfFoundCircles, report_find_failures)) {
+                return false;
+            }
+            done = true;
+        }
+
         // Adaptive algorithm to dynamically adjust the (very touchy) Hough circle parameters depending on how things are going
         while (!done) {
 
@@ -1458,6 +2020,11 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "Sorted circle list{     " + FormatCircleCandidateList(foundCircleList));
 
+        if (GsFlightRecorder::kEnableFlightRecorder) {
+            GsFlightRecorder::RecordImage("circle_detection_input", rgbImg);
+            GsFlightRecorder::RecordText("sorted_circle_candidates", FormatCircleCandidateList(foundCircleList));
+        }
+
         // Only proceed if at least one circle was found
         // The hough transfer will have returned the "best" circle first(TBD - Confirm)
         // we will still do some post - processing to get rid of anything that looks unreasonable,
@@ -1494,8 +2061,20 @@ namespace golf_sim {
 
             // Sort by radius, largest first, and copy the list to the finalCandidates
 
-            std::sort(candidates.begin(), candidates.end(), [](const CircleCandidateListElement& a, const CircleCandidateListElement& b)
-                { return (a.found_radius > b.found_radius); });
+            auto larger_radius_first = [](const CircleCandidateListElement& a, const CircleCandidateListElement& b)
+                { return (a.found_radius > b.found_radius); };
+
+            if (GolfSimCamera::kUseEarlyCandidateTruncation &&
+                (int)candidates.size() > GolfSimCamera::kMaxBallsToRetain) {
+                // Only the top candidates can survive the downstream
+                // selection, so a partial selection is all the ordering the
+                // caller can ever observe
+                std::partial_sort(candidates.begin(), candidates.begin() + GolfSimCamera::kMaxBallsToRetain,
+                    candidates.end(), larger_radius_first);
+            }
+            else {
+                std::sort(candidates.begin(), candidates.end(), larger_radius_first);
+            }
 
             std::copy(std::begin(candidates), std::end(candidates), std::back_inserter(finalCandidates));
         }
@@ -1519,6 +2098,16 @@ namespace golf_sim {
             return false;
         }
 
+        // With early truncation on, anything past the retain horizon can
+        // never survive the caller's selection, so don't even materialize
+        // (and draw) GolfBall objects for it
+        if (GolfSimCamera::kUseEarlyCandidateTruncation &&
+            (int)finalCandidates.size() > GolfSimCamera::kMaxBallsToRetain) {
+            GS_LOG_TRACE_MSG(trace, "GetBall truncating " + std::to_string(finalCandidates.size()) +
+                " final candidates to the top " + std::to_string(GolfSimCamera::kMaxBallsToRetain) + ".");
+            finalCandidates.resize(GolfSimCamera::kMaxBallsToRetain);
+        }
+
         cv::Mat initial_ball_candidates_image_ = rgbImg.clone(); 
         
         int index = 0;
@@ -1597,18 +2186,101 @@ namespace golf_sim {
         return true;
     }
 
+    // Runtime-mode entry point - resolves the mode once, out here, so that the
+    // pipeline above never has to test it again.
+    bool BallImageProc::GetBall(const cv::Mat& rgbImg,
+                                const GolfBall& baseBallWithSearchParams,
+                                std::vector<GolfBall>& return_balls,
+                                cv::Rect& expectedBallArea,
+                                BallSearchMode search_mode,
+                                bool chooseLargestFinalBall,
+                                bool report_find_failures) {
+
+        switch (search_mode) {
+            case kFindPlacedBall:
+                return GetBallForMode<kFindPlacedBall>(rgbImg, baseBallWithSearchParams, return_balls,
+                                                       expectedBallArea, chooseLargestFinalBall, report_find_failures);
+            case kStrobed:
+                return GetBallForMode<kStrobed>(rgbImg, baseBallWithSearchParams, return_balls,
+                                                expectedBallArea, chooseLargestFinalBall, report_find_failures);
+            case kExternallyStrobed:
+                return GetBallForMode<kExternallyStrobed>(rgbImg, baseBallWithSearchParams, return_balls,
+                                                          expectedBallArea, chooseLargestFinalBall, report_find_failures);
+            case kPutting:
+                return GetBallForMode<kPutting>(rgbImg, baseBallWithSearchParams, return_balls,
+                                                expectedBallArea, chooseLargestFinalBall, report_find_failures);
+            default:
+                GS_LOG_MSG(error, "GetBall called with an invalid search_mode = " + std::to_string(search_mode));
+                return false;
+        }
+    }
+
+
+    double BallImageProc::ComputeCircleEdgeSupport(const cv::Mat& gray_image, const GsCircle& circle) {
+
+        const double center_x = circle[0];
+        const double center_y = circle[1];
+        const double radius = circle[2];
+
+        if (radius < 3.0 || gray_image.empty() || gray_image.type() != CV_8UC1) {
+            return 0.0;
+        }
+
+        // Probe just inside and just outside the rim at evenly-spaced angles.
+        // A true ball edge shows a consistent radial contrast step; background
+        // clutter, overlaps and mis-fits do not.
+        constexpr int kNumRimSamples = 48;
+        constexpr double kRimProbeOffsetPixels = 2.0;
+        constexpr double kMinRadialContrast = 15.0;
+
+        int samples_in_bounds = 0;
+        int samples_supported = 0;
+
+        for (int i = 0; i < kNumRimSamples; i++) {
+            const double angle = (2.0 * CV_PI * i) / kNumRimSamples;
+            const double cos_a = std::cos(angle);
+            const double sin_a = std::sin(angle);
+
+            const int inner_x = (int)std::round(center_x + (radius - kRimProbeOffsetPixels) * cos_a);
+            const int inner_y = (int)std::round(center_y + (radius - kRimProbeOffsetPixels) * sin_a);
+            const int outer_x = (int)std::round(center_x + (radius + kRimProbeOffsetPixels) * cos_a);
+            const int outer_y = (int)std::round(center_y + (radius + kRimProbeOffsetPixels) * sin_a);
+
+            if (inner_x < 0 || inner_y < 0 || inner_x >= gray_image.cols || inner_y >= gray_image.rows ||
+                outer_x < 0 || outer_y < 0 || outer_x >= gray_image.cols || outer_y >= gray_image.rows) {
+                continue;
+            }
+
+            samples_in_bounds++;
+
+            const double contrast = std::abs((double)gray_image.at<uchar>(inner_y, inner_x) -
+                                             (double)gray_image.at<uchar>(outer_y, outer_x));
+            if (contrast >= kMinRadialContrast) {
+                samples_supported++;
+            }
+        }
 
-    bool BallImageProc::DetermineBestCircle(const cv::Mat& input_gray_image, 
-                                            const GolfBall& reference_ball, 
-                                            bool choose_largest_final_ball,
-                                            GsCircle& final_circle) {
-
+        // A mostly-off-image circle cannot be vouched for - force refinement
+        if (samples_in_bounds < kNumRimSamples / 2) {
+            return 0.0;
+        }
+
+        return (double)samples_supported / (double)samples_in_bounds;
+    }
+
+    bool BallImageProc::DetermineBestCircle(const cv::Mat& input_gray_image,
+                                            const GolfBall& reference_ball,
+                                            bool choose_largest_final_ball,
+                                            GsCircle& final_circle,
+                                            PreprocessedView* view) {
+
+        GsPerfCounters::ScopedStage perf_stage("DetermineBestCircle");
 
 #ifdef GS_USING_IMAGE_EQ
         //cv::equalizeHist(finalChoiceImg, finalChoiceImg);
 #endif
 
-        cv::Mat gray_image = input_gray_image.clone();
+        const cv::Mat& gray_image = input_gray_image;
 
         // We are pretty sure we got the correct ball, or at least something really close.
         // Now, try to find the best circle within the area around the candidate ball to see
@@ -1670,7 +2342,29 @@ namespace golf_sim {
         cv::Point offset_sub_to_full;
         cv::Point offset_full_to_sub;
 
-        cv::Mat finalChoiceSubImg = CvUtils::GetSubImage(gray_image, ball_ROI_rect, offset_sub_to_full, offset_full_to_sub);
+        // The filtering below operates in place, so the crop is cloned to keep it
+        // from writing through into the caller's image.  Cloning just the ROI
+        // (instead of the whole frame, as this function used to) is what makes
+        // the per-candidate cost proportional to the ball, not the sensor.
+        cv::Mat finalChoiceSubImg;
+
+        if (view != nullptr && view->GrayCropCovers(ball_ROI_rect)) {
+            cv::Rect roi_in_view = ball_ROI_rect - view->roi_in_full_image.tl();
+            finalChoiceSubImg = view->gray_sub_image(roi_in_view).clone();
+            offset_sub_to_full = ball_ROI_rect.tl();
+            offset_full_to_sub = cv::Point(-ball_ROI_rect.x, -ball_ROI_rect.y);
+        }
+        else {
+            finalChoiceSubImg = CvUtils::GetSubImage(gray_image, ball_ROI_rect, offset_sub_to_full, offset_full_to_sub).clone();
+        }
+
+        if (view != nullptr && view->gray_sub_image.empty()) {
+            // Publish the raw crop before the in-place filtering below consumes it
+            view->gray_sub_image = finalChoiceSubImg.clone();
+            view->roi_in_full_image = ball_ROI_rect;
+            view->offset_sub_to_full = offset_sub_to_full;
+            view->offset_full_to_sub = offset_full_to_sub;
+        }
 
         // LoggingTools::DebugShowImage("DetermineBestCircle - finalChoiceSubImg", finalChoiceSubImg);
 
@@ -1693,11 +2387,36 @@ namespace golf_sim {
 
         if (!is_externally_strobed) {
 
-            // We're using the same image preparation as for a single, placed ball for now - 
-            // TBD - Ensure that's the best approach - Current turned off (see 0 at end)
-            cv::GaussianBlur(finalChoiceSubImg, finalChoiceSubImg, cv::Size(kBestCirclePreCannyBlurSize, kBestCirclePreCannyBlurSize), 0);
-
-            cv::Canny(finalChoiceSubImg, cannyOutput_for_balls, kBestCircleCannyLower, kBestCircleCannyUpper);
+            // A previous stage may already have produced exactly the edge map this
+            // stage is about to compute - reuse it only when its recorded crop and
+            // parameters match ours.
+            if (view != nullptr && !view->edge_sub_image.empty() &&
+                view->roi_in_full_image == ball_ROI_rect &&
+                view->blur_kernel_size == kBestCirclePreCannyBlurSize &&
+                view->canny_lower == kBestCircleCannyLower &&
+                view->canny_upper == kBestCircleCannyUpper) {
+
+                GS_LOG_TRACE_MSG(trace, "DetermineBestCircle - reusing Canny edge map from PreprocessedView.");
+                cannyOutput_for_balls = view->edge_sub_image;
+            }
+            else {
+                // We're using the same image preparation as for a single, placed ball for now -
+                // TBD - Ensure that's the best approach - Current turned off (see 0 at end)
+                cv::Mat blurred_for_canny;
+                cv::GaussianBlur(finalChoiceSubImg, blurred_for_canny, cv::Size(kBestCirclePreCannyBlurSize, kBestCirclePreCannyBlurSize), 0);
+
+                cv::Canny(blurred_for_canny, cannyOutput_for_balls, kBestCircleCannyLower, kBestCircleCannyUpper);
+
+                if (view != nullptr && view->roi_in_full_image == ball_ROI_rect) {
+                    // Neither product is written to again below, so the view can
+                    // share the buffers rather than cloning them.
+                    view->blurred_sub_image = blurred_for_canny;
+                    view->blur_kernel_size = kBestCirclePreCannyBlurSize;
+                    view->edge_sub_image = cannyOutput_for_balls;
+                    view->canny_lower = kBestCircleCannyLower;
+                    view->canny_upper = kBestCircleCannyUpper;
+                }
+            }
 
             LoggingTools::DebugShowImage("Best Circle (Non-externally-strobed)" + std::to_string(expandedRadiusForHough) + "  cannyOutput for best ball", cannyOutput_for_balls);
 
@@ -1826,7 +2545,8 @@ namespace golf_sim {
 
     }
 
-    cv::RotatedRect BallImageProc::FindBestEllipseFornaciari(cv::Mat& img, const GsCircle& reference_ball_circle, int mask_radius) {
+    cv::RotatedRect BallImageProc::FindBestEllipseFornaciari(cv::Mat& img, const GsCircle& reference_ball_circle, int mask_radius,
+                                                             const PreprocessedView* view) {
 
         // Finding ellipses is expensive - use it only in the region of interest
         Size sz = img.size();
@@ -1843,7 +2563,33 @@ namespace golf_sim {
         cv::Point offset_sub_to_full;
         cv::Point offset_full_to_sub;
 
-        cv::Mat processedImg = CvUtils::GetSubImage(img, ball_ROI_rect, offset_sub_to_full, offset_full_to_sub);
+        // When a circle-refinement stage has already cropped around this same
+        // candidate, its (larger) sub-image contains ours - crop from the view
+        // instead of re-walking the full frame.  The clone keeps the in-place
+        // filtering below from corrupting the shared raw crop; the fallback
+        // path writes through into the caller's img, as this stage always has.
+        cv::Mat processedImg;
+        bool blur_already_applied = false;
+
+        if (view != nullptr && view->GrayCropCovers(ball_ROI_rect)) {
+            cv::Rect roi_in_view = ball_ROI_rect - view->roi_in_full_image.tl();
+
+            if (view->blur_kernel_size == 3 && !view->blurred_sub_image.empty()) {
+                // The producing stage happened to use this stage's 3x3 Gaussian,
+                // so its blurred product can stand in for ours as well.
+                processedImg = view->blurred_sub_image(roi_in_view).clone();
+                blur_already_applied = true;
+            }
+            else {
+                processedImg = view->gray_sub_image(roi_in_view).clone();
+            }
+
+            offset_sub_to_full = ball_ROI_rect.tl();
+            offset_full_to_sub = cv::Point(-ball_ROI_rect.x, -ball_ROI_rect.y);
+        }
+        else {
+            processedImg = CvUtils::GetSubImage(img, ball_ROI_rect, offset_sub_to_full, offset_full_to_sub);
+        }
 
         LoggingTools::DebugShowImage(" BallImageProc::FindLargestEllipse_fornaciari - Original (SUB) input image for final choices", processedImg);
 
@@ -1861,12 +2607,38 @@ namespace golf_sim {
         LoggingTools::DebugShowImage(" BallImageProc::FindLargestEllipse_fornaciari - sharpened image", processedImg);
         ***/
 
-        cv::GaussianBlur(processedImg, processedImg, cv::Size(3, 3), 0);  // nominal was 11x11
+        if (!blur_already_applied) {
+            cv::GaussianBlur(processedImg, processedImg, cv::Size(3, 3), 0);  // nominal was 11x11
+        }
         cv::erode(processedImg, processedImg, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3)), cv::Point(-1, -1), 2);
         cv::dilate(processedImg, processedImg, cv::getStructuringElement(cv::MORPH_RECT, cv::Size(3, 3)), cv::Point(-1, -1), 2);
 
         LoggingTools::DebugShowImage(" BallImageProc::FindLargestEllipse_fornaciari - blurred/eroded/dilated image", processedImg);
 
+        if (kUseFornaciariAnnulusMask) {
+            // The reference circle already localizes the ball, so restrict the
+            // (expensive) edge drawing to the ring where the rim can actually
+            // be.  Background clutter inside the sub-image then never turns
+            // into arcs that the detector has to pair.  The mask boundaries
+            // introduce two artificial circles, but those sit just outside the
+            // plausible radius band and are culled by the early rejection
+            // below.
+            cv::Point center_in_sub(circleX + offset_full_to_sub.x, circleY + offset_full_to_sub.y);
+
+            int inner_radius = std::max(0, (int)(GolfSimCamera::kMinRadiusRatio * ballRadius) - kFornaciariAnnulusPadPixels);
+            int outer_radius = (int)(GolfSimCamera::kMaxRadiusRatio * ballRadius) + kFornaciariAnnulusPadPixels;
+
+            cv::Mat annulus_mask = cv::Mat::zeros(processedImg.size(), CV_8UC1);
+            cv::circle(annulus_mask, center_in_sub, outer_radius, cv::Scalar(255), cv::FILLED);
+            cv::circle(annulus_mask, center_in_sub, inner_radius, cv::Scalar(0), cv::FILLED);
+
+            cv::Mat masked_image = cv::Mat::zeros(processedImg.size(), processedImg.type());
+            processedImg.copyTo(masked_image, annulus_mask);
+            processedImg = masked_image;
+
+            LoggingTools::DebugShowImage(" BallImageProc::FindLargestEllipse_fornaciari - annulus-masked image", processedImg);
+        }
+
 
         bool edgeDetectionFailed = false;
 
@@ -1895,8 +2667,19 @@ namespace golf_sim {
         float	fMinReliability = 0.4f;	// Const parameters to discard bad ellipses
 
 
+        // Retained across invocations when kReuseEdgeDetectorBuffers is
+        // enabled, following the reusable_edpf_ precedent - the detector then
+        // keeps its accumulator and arc-list capacity (see
+        // CEllipseDetectorYaed::ResetDetectionState()) instead of
+        // re-allocating the same-sized structures per call.  A function-local
+        // static rather than a class member because this entry point is
+        // static.
+        static CEllipseDetectorYaed reusable_ellipse_detector;
+        CEllipseDetectorYaed local_detector;
+
         // Initialize Detector with selected parameters
-        CEllipseDetectorYaed detector;
+        CEllipseDetectorYaed& detector =
+            kReuseEdgeDetectorBuffers ? reusable_ellipse_detector : local_detector;
         detector.SetParameters(szPreProcessingGaussKernelSize,
             dPreProcessingGaussSigma,
             fThPos,
@@ -1909,6 +2692,13 @@ namespace golf_sim {
             iNs
         );
 
+        // Bound the arc-pairing search to the sizes the ball could actually
+        // appear at in this sub-image.  On noisy strobed frames this keeps the
+        // detector's grouping stage from going quadratic over every stray edge
+        // arc; the caller below discards out-of-size ellipses anyway.
+        detector.SetExpectedRadiusBounds(
+            (float)(GolfSimCamera::kMinRadiusRatio * ballRadius),
+            (float)(GolfSimCamera::kMaxRadiusRatio * ballRadius));
 
         // Detect
         vector<Ellipse> ellipses;
@@ -1917,6 +2707,29 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "Found " + std::to_string(ellipses.size()) + " candidate ellipses");
 
+        if (kUseFornaciariAnnulusMask && !ellipses.empty()) {
+            // Early rejection on the radius prior - an ellipse whose semi-major
+            // axis falls outside the plausible ball-radius band cannot survive
+            // the size filter below, and this also discards any artifacts of
+            // the annulus-mask boundary circles.
+            double min_semi_axis = GolfSimCamera::kMinRadiusRatio * ballRadius;
+            double max_semi_axis = GolfSimCamera::kMaxRadiusRatio * ballRadius;
+
+            std::vector<Ellipse> plausible_ellipses;
+            plausible_ellipses.reserve(ellipses.size());
+
+            for (auto& es : ellipses) {
+                if (es._a >= min_semi_axis && es._a <= max_semi_axis) {
+                    plausible_ellipses.push_back(es);
+                }
+            }
+
+            GS_LOG_TRACE_MSG(trace, "Radius prior kept " + std::to_string(plausible_ellipses.size()) +
+                " of " + std::to_string(ellipses.size()) + " candidate ellipses");
+
+            ellipses = plausible_ellipses;
+        }
+
 
         // Find the best ellipse that seems reasonably sized
 
@@ -2181,7 +2994,9 @@ namespace golf_sim {
         return largestEllipse;
     }
 
-    // Not working very well yet.  May want to try instead some closing/opening or convex hull model
+    // Still an opt-in experiment (see the caller) because it can rip up an
+    // otherwise good circle, but the implementation is now cheap enough to
+    // run per frame if it is enabled.
     bool BallImageProc::RemoveLinearNoise(cv::Mat& img) {
         LoggingTools::DebugShowImage(" BallImageProc::FindLargestEllipse - before removing horizontal/vertical lines", img);
 
@@ -2191,20 +3006,56 @@ namespace golf_sim {
 
 
 #else
-        // Get rid of strongly horizontal and vertical lines, given that the ball should not be affected much
+        // Get rid of strongly horizontal and vertical lines, given that the ball should not
+        // be affected much - a circular edge cannot stay within one row or column for long.
+        // Any run of edge pixels at least minLineLength long is treated as a linear artifact
+        // and cleared whole.  This replaces the earlier large-structuring-element erode-and-
+        // XOR morphology (which also needed two full-image clones) with one run-length pass
+        // in each direction; the run clears compile to memset/memory stores, so there is
+        // nothing left here worth hand-vectorizing.
         int minLineLength = std::max(2, img.cols / 25);
-        cv::Mat horizontalKernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(minLineLength, 1));
-        cv::Mat verticalKernel = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(1, minLineLength));
-        // cv::morphologyEx(cannyOutput, cannyOutput, cv::MORPH_ERODE, horizontal_kernel, cv::Point(-1, -1), 2);
-        // TBD - shouldn't have to XOR the images, should be able to remove the lines in-place?
-        cv::Mat horizontalLinesImg = img.clone();
-        cv::erode(img, horizontalLinesImg, horizontalKernel, cv::Point(-1, -1), 1);
-        cv::Mat verticalLinesImg = img.clone();
-        cv::erode(img, verticalLinesImg, verticalKernel, cv::Point(-1, -1), 1);
-        LoggingTools::DebugShowImage(" BallImageProc::FindLargestEllipse - horizontal lines to filter", horizontalLinesImg);
-        LoggingTools::DebugShowImage(" BallImageProc::FindLargestEllipse - vertical lines to filter", verticalLinesImg);
-        cv::bitwise_xor(img, horizontalLinesImg, img);
-        cv::bitwise_xor(img, verticalLinesImg, img);
+
+        // Horizontal runs, row by row.
+        for (int y = 0; y < img.rows; y++) {
+            uchar* row = img.ptr<uchar>(y);
+            int x = 0;
+            while (x < img.cols) {
+                if (row[x] == 0) {
+                    x++;
+                    continue;
+                }
+                int run_start = x;
+                while (x < img.cols && row[x] != 0) {
+                    x++;
+                }
+                if (x - run_start >= minLineLength) {
+                    memset(row + run_start, 0, x - run_start);
+                }
+            }
+        }
+
+        // Vertical runs.  To stay cache-friendly this is a single top-to-bottom sweep that
+        // tracks the current run start for every column; columns are only walked back up
+        // (to clear) when a long run actually ends.
+        std::vector<int> run_start(img.cols, -1);
+        for (int y = 0; y <= img.rows; y++) {
+            const uchar* row = (y < img.rows) ? img.ptr<uchar>(y) : nullptr;
+            for (int x = 0; x < img.cols; x++) {
+                if (row != nullptr && row[x] != 0) {
+                    if (run_start[x] < 0) {
+                        run_start[x] = y;
+                    }
+                }
+                else if (run_start[x] >= 0) {
+                    if (y - run_start[x] >= minLineLength) {
+                        for (int yy = run_start[x]; yy < y; yy++) {
+                            img.ptr<uchar>(yy)[x] = 0;
+                        }
+                    }
+                    run_start[x] = -1;
+                }
+            }
+        }
 
         LoggingTools::DebugShowImage(" BallImageProc::FindLargestEllipse - after removing horizontal/vertical lines", img);
 #endif
@@ -2300,6 +3151,88 @@ namespace golf_sim {
 
     }
 
+    // Builds (or reuses) a 64x64x64 in-range lookup table for the given HSV bounds
+    // and applies it to a BGR image.  Each table entry is generated by running the
+    // bin-center color through the same cvtColor/GetColorMaskImage path used above,
+    // so the per-pixel in/out decisions (including the hue-wraparound handling and
+    // the widening) match the exact version to within the 6-bit quantization.
+    cv::Mat BallImageProc::GetColorMaskImageFromBgr(const cv::Mat& bgrImage,
+                                                    const GsColorTriplet input_lowerHsv,
+                                                    const GsColorTriplet input_upperHsv,
+                                                    double wideningAmount) {
+
+        static constexpr int kColorLutBinsPerChannel = 64;
+        static constexpr int kColorLutSize = kColorLutBinsPerChannel * kColorLutBinsPerChannel * kColorLutBinsPerChannel;
+
+        // The table (256KB) and the bounds it was built for.  The bounds only change
+        // when the ball color is re-calibrated, so in practice the table is built once.
+        static std::mutex lut_mutex;
+        static cv::Mat lut;
+        static GsColorTriplet cached_lowerHsv;
+        static GsColorTriplet cached_upperHsv;
+        static bool lut_valid = false;
+
+        cv::Mat local_lut;
+
+        {
+            std::lock_guard<std::mutex> lock(lut_mutex);
+
+            if (!lut_valid || cached_lowerHsv != input_lowerHsv || cached_upperHsv != input_upperHsv) {
+                // One BGR sample per bin, taken at the bin center
+                cv::Mat samples(1, kColorLutSize, CV_8UC3);
+                uchar* s = samples.ptr<uchar>(0);
+
+                for (int b = 0; b < kColorLutBinsPerChannel; b++) {
+                    for (int g = 0; g < kColorLutBinsPerChannel; g++) {
+                        for (int r = 0; r < kColorLutBinsPerChannel; r++) {
+                            *s++ = (uchar)((b << 2) | 2);
+                            *s++ = (uchar)((g << 2) | 2);
+                            *s++ = (uchar)((r << 2) | 2);
+                        }
+                    }
+                }
+
+                cv::Mat hsvSamples;
+                cv::cvtColor(samples, hsvSamples, cv::COLOR_BGR2HSV);
+
+                lut = GetColorMaskImage(hsvSamples, input_lowerHsv, input_upperHsv, wideningAmount);
+
+                cached_lowerHsv = input_lowerHsv;
+                cached_upperHsv = input_upperHsv;
+                lut_valid = true;
+            }
+
+            local_lut = lut;
+        }
+
+        cv::Mat color_mask_image(bgrImage.rows, bgrImage.cols, CV_8U);
+
+        const uchar* lut_data = local_lut.ptr<uchar>(0);
+
+        for (int y = 0; y < bgrImage.rows; y++) {
+            const uchar* src = bgrImage.ptr<uchar>(y);
+            uchar* dst = color_mask_image.ptr<uchar>(y);
+
+            for (int x = 0; x < bgrImage.cols; x++) {
+                int index = ((src[0] >> 2) << 12) | ((src[1] >> 2) << 6) | (src[2] >> 2);
+                dst[x] = lut_data[index];
+                src += 3;
+            }
+        }
+
+        return color_mask_image;
+    }
+
+
+    cv::Mat BallImageProc::GetColorMaskImageFromBgr(const cv::Mat& bgrImage, const GolfBall& ball, double widening_amount) {
+
+        GsColorTriplet lowerHsv = ball.GetBallLowerHSV(ball.ball_color_);
+        GsColorTriplet upperHsv = ball.GetBallUpperHSV(ball.ball_color_);
+
+        return BallImageProc::GetColorMaskImageFromBgr(bgrImage, lowerHsv, upperHsv, widening_amount);
+
+    }
+
     bool BallImageProc::BallIsPresent(const cv::Mat& img) {
         GS_LOG_TRACE_MSG(trace, "BallIsPresent: image=" + LoggingTools::SummarizeImage(img));
         return true;
@@ -2389,6 +3322,16 @@ namespace golf_sim {
 
         bool foundMotion = false;
 
+        // Adaptive polling - while the scene is static, the loop sleeps between
+        // polls instead of capturing and comparing flat-out; any changed pixels
+        // arm a fast-polling window on the theory that the hit is imminent.
+        // (The production pipeline detects motion in the motion_detect
+        // post-processing stage; this loop is the still-camera equivalent used
+        // by the test harness.)
+        const int kIdlePollIntervalMs = 50;
+        const double kArmedWindowMs = 2000.0;
+        auto last_activity_time = std::chrono::steady_clock::now();
+
         cv::Mat frame;
 
         while (!foundMotion) {
@@ -2464,6 +3407,27 @@ namespace golf_sim {
 
             // LoggingTools::DebugShowImage("Threshold image: ", thresh);
 
+            // A cheap pre-gate - the changed-pixel count bounds the total contour
+            // area, so the (expensive) contour pass below can only succeed once
+            // at least min_area pixels have changed.
+            int changed_pixel_count = cv::countNonZero(thresh);
+
+            auto now = std::chrono::steady_clock::now();
+
+            if (changed_pixel_count > 0) {
+                last_activity_time = now;
+            }
+
+            if (changed_pixel_count < min_area) {
+                // Not enough happening to possibly trigger.  Keep polling fast
+                // within the armed window after any activity, and otherwise idle
+                // at a slow cadence instead of burning a core on static frames.
+                if (std::chrono::duration<double, std::milli>(now - last_activity_time).count() > kArmedWindowMs) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(kIdlePollIntervalMs));
+                }
+                continue;
+            }
+
             cv::findContours(thresh, contours, hierarchy, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
 
 
@@ -2529,50 +3493,73 @@ namespace golf_sim {
                                                 const int brightness_percentage,
                                                 int& brightness_cutoff,
                                                 int& lowest_brightness,
-                                                int& highest_brightness) {
-        /******  I found out the images are not distributed as a normal distribution, so this doesn't work
-        cv::Scalar meanArray;
-        cv::Scalar stdDevArray;
-        cv::meanStdDev(img, meanArray, stdDevArray);
-
-        double mean = meanArray.val[0];
-        double stddev = stdDevArray.val[0];
-
-        double zScore = sqrt(2) * boost::math::erf_inv((double)brightness_percentage / 100.0);
-
-        brightness_cutoff = (int)std::round(mean + ((stddev) * zScore));
-        if (brightness_cutoff > 255) {
-            brightness_cutoff = 255;
-            LoggingTools::Warning("brightness_cutoff was > 255.  brightness_percentage (" + std::to_string(brightness_percentage) + ") may be set too high ? ");
-        }
-        */
+                                                int& highest_brightness,
+                                                bool force_recalculation) {
+
+        // The decisions that consult these statistics (exposure-quality gating
+        // and the like) only need approximate numbers, and in the waiting loop
+        // they can be consulted repeatedly on near-identical frames.  So the
+        // histogram is built from a subsampled grid of pixels rather than a
+        // full-image calcHist pass, and the result is cached.  A much sparser
+        // probe of the image decides when the scene has changed enough (or the
+        // image geometry has changed) to make the sampled pass again.
+
+        // Grid spacings for the scene-change probe and the sampled histogram,
+        // and how far the probe's mean brightness may drift before the cached
+        // statistics are considered stale.
+        const int kProbePixelStep = 32;
+        const int kHistogramPixelStep = 4;
+        const double kSceneChangeMeanTolerance = 2.0;
 
-        /// Establish the number of bins
         const int histSize = 256;
 
-        /// Set the ranges ( for B,G,R) )
-        float range[] = { 0, 256 };
-        const float* histRange = { range };
-
-        bool uniform = true; bool accumulate = false;
-
-        cv::Mat b_hist;
-
-        /// Compute the histograms:
-        calcHist(&img, 1, 0, cv::Mat(), b_hist, 1, &histSize, &histRange, uniform, accumulate);
-
-        // Draw the histograms for B, G and R
-        int hist_w = 512; int hist_h = 400;
-        int bin_w = cvRound((double)hist_w / histSize);
-
-        /*
-        cv::Mat histImage(hist_h, hist_w, CV_8UC3, cv::Scalar(0, 0, 0));
+        static std::mutex stats_mutex;
+        static bool cache_valid = false;
+        static int cached_rows = 0;
+        static int cached_cols = 0;
+        static int cached_percentage = 0;
+        static double cached_probe_mean = 0.;
+        static int cached_cutoff = 0;
+        static int cached_lowest = 0;
+        static int cached_highest = 0;
+
+        std::lock_guard<std::mutex> lock(stats_mutex);
+
+        // The statistics are of the first channel, as with the original
+        // calcHist-based implementation.
+        const int channel_step = img.channels();
+
+        // Sparse probe - roughly a thousandth of the pixels.
+        double probe_sum = 0.;
+        long probe_count = 0;
+        for (int y = 0; y < img.rows; y += kProbePixelStep) {
+            const uchar* row = img.ptr<uchar>(y);
+            for (int x = 0; x < img.cols; x += kProbePixelStep, probe_count++) {
+                probe_sum += row[x * channel_step];
+            }
+        }
+        double probe_mean = (probe_count > 0) ? probe_sum / probe_count : 0.;
+
+        if (cache_valid && !force_recalculation &&
+            img.rows == cached_rows && img.cols == cached_cols &&
+            brightness_percentage == cached_percentage &&
+            std::abs(probe_mean - cached_probe_mean) <= kSceneChangeMeanTolerance) {
+            brightness_cutoff = cached_cutoff;
+            lowest_brightness = cached_lowest;
+            highest_brightness = cached_highest;
+            return;
+        }
 
-        // Normalize the result to [ 0, histImage.rows ]
-        cv::normalize(b_hist, b_hist, 0, histImage.rows, cv::NORM_MINMAX, -1, cv::Mat());
-        */
+        // Sampled histogram pass.
+        long histogram[histSize] = { 0 };
+        long totalPoints = 0;
+        for (int y = 0; y < img.rows; y += kHistogramPixelStep) {
+            const uchar* row = img.ptr<uchar>(y);
+            for (int x = 0; x < img.cols; x += kHistogramPixelStep, totalPoints++) {
+                histogram[row[x * channel_step]]++;
+            }
+        }
 
-        long totalPoints = img.rows * img.cols;
         long accum = 0;
         int i = histSize - 1;
         bool foundPercentPoint = false;
@@ -2581,7 +3568,7 @@ namespace golf_sim {
 
         while (i >= 0 && !foundPercentPoint )
         {
-            int numPixelsInBin = cvRound(b_hist.at<float>(i));
+            long numPixelsInBin = histogram[i];
             accum += numPixelsInBin;
             foundPercentPoint = (accum >= targetPoints) ? true : false;
             if (highest_brightness < 0 && numPixelsInBin > 0) {
@@ -2591,6 +3578,24 @@ namespace golf_sim {
         }
 
         brightness_cutoff = i + 1;
+
+        // (The previous implementation never actually set lowest_brightness.)
+        lowest_brightness = 0;
+        for (int bin = 0; bin < histSize; bin++) {
+            if (histogram[bin] > 0) {
+                lowest_brightness = bin;
+                break;
+            }
+        }
+
+        cache_valid = true;
+        cached_rows = img.rows;
+        cached_cols = img.cols;
+        cached_percentage = brightness_percentage;
+        cached_probe_mean = probe_mean;
+        cached_cutoff = brightness_cutoff;
+        cached_lowest = lowest_brightness;
+        cached_highest = highest_brightness;
     }
 
     bool BallImageProc::RemoveSmallestConcentricCircles(std::vector<GsCircle> &circles) {
@@ -2637,38 +3642,25 @@ namespace golf_sim {
 
     void BallImageProc::RemoveReflections(const cv::Mat& original_image, cv::Mat& filtered_image, const cv::Mat& mask) {
 
-        int hh = original_image.rows;
-        int ww = original_image.cols;
-
-        static int imgNumber = 1;
-        // LoggingTools::DebugShowImage("RemoveReflections - input img# " + std::to_string(imgNumber) + " = ", original_image);
-        // LoggingTools::DebugShowImage("filtered_image - input img# " + std::to_string(imgNumber) + " = ", filtered_image);
-        imgNumber++;
-
+        // LoggingTools::DebugShowImage("RemoveReflections - input img = ", original_image);
         // LoggingTools::DebugShowImage("RemoveReflections - mask = ", mask);
 
-        // Define the idea of a "bright" relfection dynamically.  The reflection brightness will be in the
-        // xx% percentile (e.g., above 98%)
-        // Dynamically determine the reflection minimum based on the other values on the
-        // golf ball.  Basically figure out "bright" based on being on the high side of the histogram
-        const int brightness_percentage = 99;
-        int brightness_cutoff;
-        int lowestBrightess;
-        int highest_brightness;
-        GetImageCharacteristics(original_image, brightness_percentage, brightness_cutoff, lowestBrightess, highest_brightness);
-
-        GS_LOG_TRACE_MSG(trace, "Lower cutoff for brightness is " + std::to_string(brightness_percentage) + "%, grayscale value = " + std::to_string(brightness_cutoff));
-
-        brightness_cutoff--;  // Make sure we don't filter out EVERYTHING
-        // GsColorTriplet lower = ((uchar)brightness_cutoff, (uchar)brightness_cutoff, (uchar)brightness_cutoff);
-        GsColorTriplet lower = ((uchar)kReflectionMinimumRGBValue, (uchar)kReflectionMinimumRGBValue, (uchar)kReflectionMinimumRGBValue);
-        GsColorTriplet upper{ 255,255,255 };
-
-        cv::Mat thresh(original_image.rows, original_image.cols, original_image.type(), cv::Scalar(0));
-        cv::inRange(original_image, lower, upper, thresh);
+        // Classify the specular pixels in a single sweep.  An earlier version
+        // also derived a dynamic, histogram-based brightness cutoff here
+        // (GetImageCharacteristics at the 99th percentile), but its result was
+        // never applied - the fixed kReflectionMinimumRGBValue cutoff below
+        // always was - so the per-invocation histogram pass is gone.
+        cv::Mat thresh;
+        cv::threshold(original_image, thresh, kReflectionMinimumRGBValue - 1, 255, cv::THRESH_BINARY);
 
         // LoggingTools::DebugShowImage("RemoveReflections - Initial thresholded image = ", thresh);
 
+        // Most candidate balls in strobed mode have no specular pixels at all,
+        // in which case there is nothing to expand or mark.
+        if (cv::countNonZero(thresh) == 0) {
+            return;
+        }
+
         // Expand the bright reflection areas, because they are likely to be areas where
         // the Gabor filters will show a lot of edges that will otherwise pollute the statistics
 
@@ -2686,16 +3678,12 @@ namespace golf_sim {
 
         // LoggingTools::DebugShowImage("RemoveReflections - Expanded thresholded image = ", morph);
 
-        // Iterate through the morphed, expanded mask image and set the corresponding pixels to "ignore" in the filtered_image
-        for (int x = 0; x < original_image.cols; x++) {
-            for (int y = 0; y < original_image.rows; y++) {
-                uchar p1 = morph.at<uchar>(x, y);
-
-                if (p1 == 255) {
-                    filtered_image.at<uchar>(x, y) = kPixelIgnoreValue;
-                }
-             }
-        }
+        // Set every pixel of the expanded reflection mask to "ignore" in the
+        // filtered image with one masked store.  This replaces a per-pixel
+        // at<>() double loop that also indexed the images as (x, y) - i.e.,
+        // transposed - which read and wrote out of bounds whenever an
+        // edge-clipped ball ROI was not square.
+        filtered_image.setTo(kPixelIgnoreValue, morph);
 
         LoggingTools::DebugShowImage("RemoveReflections - final filtered image = ", filtered_image);
     }
@@ -2800,27 +3788,47 @@ namespace golf_sim {
 
         // LoggingTools::DebugShowImage("MaskAreaOutsideBall - ball_image", ball_image);
 
-        // A white circle on a black background will act as our first mask to preserve the ball portion of the image
+        // A white circle on a black background will act as our mask to preserve the ball portion of the image
 
         int mask_radius = (int)(ball.measured_radius_pixels_ * mask_reduction_factor);
 
-        cv::Mat maskImage = cv::Mat::zeros(ball_image.rows, ball_image.cols, ball_image.type());
-        cv::circle(maskImage, cv::Point(ball.x(), ball.y()), mask_radius, cv::Scalar(255, 255, 255), -1);
-        //LoggingTools::DebugShowImage("1st maskImage", maskImage);
+        // The mask depends only on the image size and the circle geometry, which
+        // are the same for both strobe exposures on the spin path, so cache it
+        // instead of re-drawing it on every call.
+        static std::mutex mask_mutex;
+        static cv::Mat cached_mask;
+        static int cached_rows = -1;
+        static int cached_cols = -1;
+        static int cached_radius = -1;
+        static int cached_x = -1;
+        static int cached_y = -1;
+
+        cv::Mat maskImage;
+
+        {
+            std::lock_guard<std::mutex> lock(mask_mutex);
+
+            if (ball_image.rows != cached_rows || ball_image.cols != cached_cols ||
+                mask_radius != cached_radius || (int)ball.x() != cached_x || (int)ball.y() != cached_y) {
 
-        // At this point, maskImage is an image with a white circle and a black outside
+                cached_mask = cv::Mat::zeros(ball_image.rows, ball_image.cols, CV_8U);
+                cv::circle(cached_mask, cv::Point((int)ball.x(), (int)ball.y()), mask_radius, cv::Scalar(255), -1);
 
-        cv::Mat result = ball_image.clone();
-        cv::bitwise_and(ball_image, maskImage, result);
-        //LoggingTools::DebugShowImage("Intermediate result", result);
+                cached_rows = ball_image.rows;
+                cached_cols = ball_image.cols;
+                cached_radius = mask_radius;
+                cached_x = (int)ball.x();
+                cached_y = (int)ball.y();
+            }
 
-        // Now XOR the image-on-black with a on a rectangle of desired color and a black circle in the middle
-        cv::Rect r(cv::Point(0, 0), cv::Point(ball_image.cols, ball_image.rows));
-        cv::rectangle(maskImage, r, maskValue, cv::FILLED);
-        cv::circle(maskImage, cv::Point(ball.x(), ball.y()), mask_radius, cv::Scalar(0, 0, 0), -1);
-        //LoggingTools::DebugShowImage("2nd maskImage", maskImage);
+            maskImage = cached_mask;
+        }
 
-        cv::bitwise_xor(result, maskImage, result);
+        // Fill the result with the outside-the-ball color and then copy just the
+        // ball circle over it.  A single masked copy replaces the previous
+        // clone / bitwise_and / mask re-draw / bitwise_xor sequence.
+        cv::Mat result(ball_image.rows, ball_image.cols, ball_image.type(), maskValue);
+        ball_image.copyTo(result, maskImage);
 
         // LoggingTools::DebugShowImage("MaskAreaOutsideBall: result", result);
 
@@ -2828,6 +3836,36 @@ namespace golf_sim {
     }
 
 
+    double BallImageProc::MeasureDimpleEdgeDensity(const cv::Mat& dimple_edge_image) {
+
+        if (dimple_edge_image.empty() || dimple_edge_image.type() != CV_8UC1) {
+            return 0.0;
+        }
+
+        long pixels_considered = 0;
+        long pixels_on = 0;
+
+        for (int row = 0; row < dimple_edge_image.rows; row++) {
+            const uchar* row_ptr = dimple_edge_image.ptr<uchar>(row);
+            for (int col = 0; col < dimple_edge_image.cols; col++) {
+                const uchar p = row_ptr[col];
+                if (p == kPixelIgnoreValue) {
+                    continue;
+                }
+                pixels_considered++;
+                if (p > 0) {
+                    pixels_on++;
+                }
+            }
+        }
+
+        if (pixels_considered == 0) {
+            return 0.0;
+        }
+
+        return (double)pixels_on / (double)pixels_considered;
+    }
+
     cv::Vec3d BallImageProc::GetBallRotation(const cv::Mat& full_gray_image1,
                                              const GolfBall& ball1,
                                              const cv::Mat& full_gray_image2,
@@ -2841,6 +3879,10 @@ namespace golf_sim {
         BOOST_LOG_FUNCTION();
         auto spin_detection_start = std::chrono::high_resolution_clock::now();
 
+        // No inference runs during spin analysis, so OpenCV's pool can have
+        // the whole compute budget for the angle-comparison loops
+        GsThreadBudget::ScopedPhase budget_phase(GsThreadBudget::Phase::kSpinAnalysis);
+
         GS_LOG_TRACE_MSG(trace, "GetBallRotation called with ball1 = " + ball1.Format() + ",\nball2 = " + ball2.Format());
         LoggingTools::DebugShowImage("full_gray_image1", full_gray_image1);
         LoggingTools::DebugShowImage("full_gray_image2", full_gray_image2);
@@ -2865,6 +3907,11 @@ namespace golf_sim {
             LoggingTools::LogImage("", ball_image2, std::vector < cv::Point >{}, true, "log_view_ISOLATED_full_gray_image2.png");
         }
 
+        if (GsFlightRecorder::kEnableFlightRecorder) {
+            GsFlightRecorder::RecordImage("spin_isolated_ball1", ball_image1);
+            GsFlightRecorder::RecordImage("spin_isolated_ball2", ball_image2);
+        }
+
         // Just to test.  Ignore the 0 bin
         // CvUtils::DrawGrayImgHistogram(ball_image1, true);
 
@@ -2887,9 +3934,12 @@ namespace golf_sim {
             cv::resize(ball_image1, ball_image1, cv::Size(upWidth, upHeight), cv::INTER_LINEAR);
         }
 
-        // Save the original, non-equalized images for later QA
-        cv::Mat originalBallImg1 = ball_image1.clone();
-        cv::Mat originalBallImg2 = ball_image2.clone();
+        // Save the original, non-equalized images for later QA.  Shared headers
+        // are enough - nothing below writes into ball_image1/2 (they are only
+        // read by the Gabor filtering and reflection removal), so the pixel
+        // buffers can be shared instead of deep-copied.
+        cv::Mat originalBallImg1 = ball_image1;
+        cv::Mat originalBallImg2 = ball_image2;
 
         // Adjust relevant ball radius information accordingly
         local_ball1.measured_radius_pixels_ = local_ball1.measured_radius_pixels_ * ball1RadiusMultiplier;
@@ -2938,6 +3988,21 @@ namespace golf_sim {
         LoggingTools::DebugShowImage("Final ball_image1DimpleEdges after masking outside", ball_image1DimpleEdges);
         LoggingTools::DebugShowImage("Final ball_image2DimpleEdges after masking outside", ball_image2DimpleEdges);
 
+        // Exposure-quality check - when either filtered exposure carries little
+        // dimple signal, the spin result will be low-confidence no matter how
+        // finely we search, so the grid sweeps below are cut down accordingly
+        bool weak_spin_signal = false;
+        if (kUseAdaptiveSpinSearchResolution) {
+            double edge_density1 = MeasureDimpleEdgeDensity(ball_image1DimpleEdges);
+            double edge_density2 = MeasureDimpleEdgeDensity(ball_image2DimpleEdges);
+            weak_spin_signal = (std::min(edge_density1, edge_density2) < kSpinWeakSignalEdgeDensity);
+
+            GS_LOG_MSG(debug, "Dimple-edge densities were " + std::to_string(edge_density1) + " / " +
+                std::to_string(edge_density2) + (weak_spin_signal ?
+                " - weak signal, reducing spin search range and resolution." :
+                " - searching at full resolution."));
+        }
+
         // Finally, rotate the second ball image to make up for the angle imparted by any offset of the ball from the
         // center of the camera's view.  Just reset the view using the angle offsets from the camera's perspective
         cv::Vec3d ball2Distances;
@@ -2963,7 +4028,10 @@ namespace golf_sim {
         cv::Vec3i angleOffsetDeltas1 = CvUtils::Round(angleOffsetDeltas1Float);
 
 
-        cv::Mat unrotatedBallImg1DimpleEdges = ball_image1DimpleEdges.clone();
+        // A shared header keeps the un-rotated pixels alive - GetRotatedImage
+        // re-binds its output to a freshly allocated image, so the input buffer
+        // is never written and no deep copy is needed.
+        cv::Mat unrotatedBallImg1DimpleEdges = ball_image1DimpleEdges;
         GetRotatedImage(unrotatedBallImg1DimpleEdges, local_ball1, angleOffsetDeltas1, ball_image1DimpleEdges);
 
         GS_LOG_TRACE_MSG(trace, "Adjusting rotation for camera view of ball 1 to offset (x,y,z)=" + std::to_string(angleOffsetDeltas1[0]) + "," + std::to_string(angleOffsetDeltas1[1]) + "," + std::to_string(angleOffsetDeltas1[2]));
@@ -2976,17 +4044,19 @@ namespace golf_sim {
         }
 
 
-        cv::Mat unrotatedBallImg2DimpleEdges = ball_image2DimpleEdges.clone();
+        cv::Mat unrotatedBallImg2DimpleEdges = ball_image2DimpleEdges;
         GetRotatedImage(unrotatedBallImg2DimpleEdges, local_ball2, angleOffsetDeltas2, ball_image2DimpleEdges);
         GS_LOG_TRACE_MSG(trace, "Adjusting rotation for camera view of ball 2 to offset (x,y,z)=" + std::to_string(angleOffsetDeltas2[0]) + "," + std::to_string(angleOffsetDeltas2[1]) + "," + std::to_string(angleOffsetDeltas2[2]));
         LoggingTools::DebugShowImage("Final perspective-de-rotated filtered ball_image2DimpleEdges: ", ball_image2DimpleEdges, center1);
 
         // Although unnecessary for the algorithm, the following DEBUG code shows the original image as it would appear rotated in the same way as the Gabor-filtered balls
         
-        cv::Mat normalizedOriginalBallImg1 = originalBallImg1.clone();
+        // Pure outputs - GetRotatedImage allocates them itself, so there is
+        // nothing to pre-populate.
+        cv::Mat normalizedOriginalBallImg1;
         GetRotatedImage(originalBallImg1, local_ball1, angleOffsetDeltas1, normalizedOriginalBallImg1);
         LoggingTools::DebugShowImage("Final rotated originalBall1: ", normalizedOriginalBallImg1, center1);
-        cv::Mat normalizedOriginalBallImg2 = originalBallImg2.clone();
+        cv::Mat normalizedOriginalBallImg2;
         GetRotatedImage(originalBallImg2, local_ball2, angleOffsetDeltas2, normalizedOriginalBallImg2);
         LoggingTools::DebugShowImage("Final rotated originalBall2: ", normalizedOriginalBallImg2, center2);
         
@@ -2999,42 +4069,76 @@ namespace golf_sim {
 
 
 
+        cv::Vec3f rotationResult;
+
+        // These will hold the best (un-normalized) rotation found by whichever search
+        // engine is configured below
+        int best_rot_x = 0;
+        int best_rot_y = 0;
+        int best_rot_z = 0;
+
+        if (kUseIterativeSpinSearch) {
+            // Alternative search engine - instead of exhaustively sweeping the coarse and
+            // fine rotation grids, converge on the best rotation with a pattern search
+            // that typically needs only tens of image comparisons
+            cv::Vec3i best_iterative_rotation;
+
+            if (SearchBallRotationIterative(ball_image1DimpleEdges, local_ball1, ball_image2DimpleEdges, best_iterative_rotation)) {
+                best_rot_x = best_iterative_rotation[0];
+                best_rot_y = best_iterative_rotation[1];
+                best_rot_z = best_iterative_rotation[2];
+            }
+            else {
+                LoggingTools::Warning("Iterative spin search did not find a valid rotation.  Returning 0,0,0 spin results.");
+                rotationResult = cv::Vec3d(0, 0, 0);
+            }
+        }
+        else {
+
         // Now compute all the possible rotations of the first image so we can figure out which angles make it look like the second ball image
         RotationSearchSpace initialSearchSpace;
 
-        // Initial angle search will be fairly coarse
-        initialSearchSpace.anglex_rotation_degrees_increment = kCoarseXRotationDegreesIncrement;
-        initialSearchSpace.anglex_rotation_degrees_start = kCoarseXRotationDegreesStart;
-        initialSearchSpace.anglex_rotation_degrees_end = kCoarseXRotationDegreesEnd;
-        initialSearchSpace.angley_rotation_degrees_increment = kCoarseYRotationDegreesIncrement;
-        initialSearchSpace.angley_rotation_degrees_start = kCoarseYRotationDegreesStart;
-        initialSearchSpace.angley_rotation_degrees_end = kCoarseYRotationDegreesEnd;
-        initialSearchSpace.anglez_rotation_degrees_increment = kCoarseZRotationDegreesIncrement;
-        initialSearchSpace.anglez_rotation_degrees_start = kCoarseZRotationDegreesStart;
-        initialSearchSpace.anglez_rotation_degrees_end = kCoarseZRotationDegreesEnd;
+        // Initial angle search will be fairly coarse.  On a weak-signal
+        // exposure pair, halve the angular range and double the increment -
+        // roughly an 8x reduction in coarse candidates.
+        const int coarse_increment_scale = weak_spin_signal ? 2 : 1;
+        const double coarse_range_scale = weak_spin_signal ? 0.5 : 1.0;
+
+        initialSearchSpace.anglex_rotation_degrees_increment = coarse_increment_scale * kCoarseXRotationDegreesIncrement;
+        initialSearchSpace.anglex_rotation_degrees_start = (int)std::round(coarse_range_scale * kCoarseXRotationDegreesStart);
+        initialSearchSpace.anglex_rotation_degrees_end = (int)std::round(coarse_range_scale * kCoarseXRotationDegreesEnd);
+        initialSearchSpace.angley_rotation_degrees_increment = coarse_increment_scale * kCoarseYRotationDegreesIncrement;
+        initialSearchSpace.angley_rotation_degrees_start = (int)std::round(coarse_range_scale * kCoarseYRotationDegreesStart);
+        initialSearchSpace.angley_rotation_degrees_end = (int)std::round(coarse_range_scale * kCoarseYRotationDegreesEnd);
+        initialSearchSpace.anglez_rotation_degrees_increment = coarse_increment_scale * kCoarseZRotationDegreesIncrement;
+        initialSearchSpace.anglez_rotation_degrees_start = (int)std::round(coarse_range_scale * kCoarseZRotationDegreesStart);
+        initialSearchSpace.anglez_rotation_degrees_end = (int)std::round(coarse_range_scale * kCoarseZRotationDegreesEnd);
 
         cv::Mat outputCandidateElementsMat;
         std::vector< RotationCandidate> candidates;
         cv::Vec3i output_candidate_elements_mat_size;
 
-        ComputeCandidateAngleImages(ball_image1DimpleEdges, initialSearchSpace, outputCandidateElementsMat, output_candidate_elements_mat_size, candidates, local_ball1);
-
-        // Compare the second (presumably rotated) ball image to different candidate rotations of the first ball image to determine the angular change
         std::vector<std::string> comparison_csv_data;
-        int best_candidate_index = CompareCandidateAngleImages(&ball_image2DimpleEdges, &outputCandidateElementsMat, &output_candidate_elements_mat_size, &candidates, comparison_csv_data);
-        
-        cv::Vec3f rotationResult;
+        int best_candidate_index = -1;
+
+        if (kUseFusedSpinPipeline) {
+            // Generate and score each candidate in one pass, recycling a small number of
+            // in-flight projection buffers instead of materializing every candidate image
+            best_candidate_index = ComputeAndCompareCandidateAngleImages(ball_image1DimpleEdges, initialSearchSpace, ball_image2DimpleEdges, local_ball1, candidates);
+        }
+        else {
+            ComputeCandidateAngleImages(ball_image1DimpleEdges, initialSearchSpace, outputCandidateElementsMat, output_candidate_elements_mat_size, candidates, local_ball1);
+
+            // Compare the second (presumably rotated) ball image to different candidate rotations of the first ball image to determine the angular change
+            best_candidate_index = CompareCandidateAngleImages(&ball_image2DimpleEdges, &outputCandidateElementsMat, &output_candidate_elements_mat_size, &candidates, comparison_csv_data);
+        }
 
         if (best_candidate_index < 0) {
             LoggingTools::Warning("No best candidate found.");
             return rotationResult;
         }
 
-        bool write_spin_analysis_CSV_files = false;
-
-        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kWriteSpinAnalysisCsvFiles", write_spin_analysis_CSV_files);
-        
-        if (write_spin_analysis_CSV_files) {
+        if (kWriteSpinAnalysisCsvFiles) {
             // This data export can be used for, say, Excel analysis - CSV format
             std::string csv_fname_coarse = "spin_analysis_coarse.csv";
             ofstream csv_file_coarse(csv_fname_coarse);
@@ -3061,14 +4165,17 @@ namespace golf_sim {
         int anglez_window_width = (int)std::round(ceil(initialSearchSpace.anglez_rotation_degrees_increment / 2.));
 
 
-        finalSearchSpace.anglex_rotation_degrees_increment = 1;
+        // A weak-signal pair is not worth 1-degree precision in the fine pass either
+        const int fine_increment = weak_spin_signal ? 2 : 1;
+
+        finalSearchSpace.anglex_rotation_degrees_increment = fine_increment;
         finalSearchSpace.anglex_rotation_degrees_start = c.x_rotation_degrees - anglex_window_width;
         finalSearchSpace.anglex_rotation_degrees_end = c.x_rotation_degrees + anglex_window_width;
         // Probably not worth it to be too fine-grained on the Y axis.
         finalSearchSpace.angley_rotation_degrees_increment = (int) std::round(kCoarseYRotationDegreesIncrement / 2.);
         finalSearchSpace.angley_rotation_degrees_start = c.y_rotation_degrees - angley_window_width;
         finalSearchSpace.angley_rotation_degrees_end = c.y_rotation_degrees + angley_window_width;
-        finalSearchSpace.anglez_rotation_degrees_increment = 1;
+        finalSearchSpace.anglez_rotation_degrees_increment = fine_increment;
         finalSearchSpace.anglez_rotation_degrees_start = c.z_rotation_degrees - anglez_window_width;
         finalSearchSpace.anglez_rotation_degrees_end = c.z_rotation_degrees + anglez_window_width;
 
@@ -3076,15 +4183,28 @@ namespace golf_sim {
         cv::Vec3i finalOutputCandidateElementsMatSize;
         std::vector< RotationCandidate> finalCandidates;
 
-        // After this, the finalOutputCandidateElementsMat will have X,Y,Z elements with an index into the finalCandidates vector.
-        // Each candidate in finalCandidates will have an image, associated X,Y,Z information and a place to put a score
-        ComputeCandidateAngleImages(ball_image1DimpleEdges, finalSearchSpace, finalOutputCandidateElementsMat, finalOutputCandidateElementsMatSize, finalCandidates, local_ball1);
+        if (kUseFusedSpinPipeline) {
+            best_candidate_index = ComputeAndCompareCandidateAngleImages(ball_image1DimpleEdges, finalSearchSpace, ball_image2DimpleEdges, local_ball1, finalCandidates);
+        }
+        else {
+            // After this, the finalOutputCandidateElementsMat will have X,Y,Z elements with an index into the finalCandidates vector.
+            // Each candidate in finalCandidates will have an image, associated X,Y,Z information and a place to put a score
+            ComputeCandidateAngleImages(ball_image1DimpleEdges, finalSearchSpace, finalOutputCandidateElementsMat, finalOutputCandidateElementsMatSize, finalCandidates, local_ball1);
+
+            // TBD - change CompareCandidateAngleImages to work directly with the "3D" images
+            best_candidate_index = CompareCandidateAngleImages(&ball_image2DimpleEdges, &finalOutputCandidateElementsMat, &finalOutputCandidateElementsMatSize, &finalCandidates, comparison_csv_data);
+        }
 
-        // TBD - change CompareCandidateAngleImages to work directly with the "3D" images
-        best_candidate_index = CompareCandidateAngleImages(&ball_image2DimpleEdges, &finalOutputCandidateElementsMat, &finalOutputCandidateElementsMatSize, &finalCandidates, comparison_csv_data);
+        if (GsFlightRecorder::kEnableFlightRecorder && !comparison_csv_data.empty()) {
+            std::string score_table;
+            for (auto& element : comparison_csv_data) {
+                score_table += element;
+            }
+            GsFlightRecorder::RecordText("spin_scores_fine", score_table);
+        }
 
         // Save all the candidate scores to a CSV file if requested
-        if (write_spin_analysis_CSV_files) {
+        if (kWriteSpinAnalysisCsvFiles) {
 
             std::string csv_fname_fine = "spin_analysis_fine.csv";
             ofstream csv_file_fine(csv_fname_fine);
@@ -3098,10 +4218,6 @@ namespace golf_sim {
         }
 
         // Analyze the fine-grained results
-        int best_rot_x = 0;
-        int best_rot_y = 0;
-        int best_rot_z = 0;
-
         if (best_candidate_index >= 0) {
             RotationCandidate finalC = finalCandidates[best_candidate_index];
             best_rot_x = finalC.x_rotation_degrees;
@@ -3116,16 +4232,21 @@ namespace golf_sim {
             GS_LOG_MSG(debug, s);
 
             /*** FOR DEBUG ***/
+            // (The fused pipeline does not retain candidate images, so there may be nothing to show)
             cv::Mat bestImg3D = finalCandidates[best_candidate_index].img;
-            cv::Mat bestImg2D = cv::Mat::zeros(ball_image1DimpleEdges.rows, ball_image1DimpleEdges.cols, ball_image1DimpleEdges.type());
-            Unproject3dBallTo2dImage(bestImg3D, bestImg2D, ball2);
-            LoggingTools::DebugShowImage("Best Final Rotation Candidate Image", bestImg2D);
+            if (!bestImg3D.empty()) {
+                cv::Mat bestImg2D = cv::Mat::zeros(ball_image1DimpleEdges.rows, ball_image1DimpleEdges.cols, ball_image1DimpleEdges.type());
+                Unproject3dBallTo2dImage(bestImg3D, bestImg2D, ball2);
+                LoggingTools::DebugShowImage("Best Final Rotation Candidate Image", bestImg2D);
+            }
         } 
         else {
             LoggingTools::Warning("No best final candidate found.  Returning 0,0,0 spin results.");
             rotationResult = cv::Vec3d(0, 0, 0);
         }
 
+        }   // End of the grid-based coarse-to-fine search
+
         // The above angular deltas were calculated relative to a coordinate system that is at an angle
         // from the camera to the balls. So...
         // Now translate the spin angles so that the axes are the same as the PiTrac's and Sim's axes, where, 
@@ -3173,7 +4294,7 @@ namespace golf_sim {
         }
 
         // We want to show apples to apples, so show the normalized images
-        cv::Mat test_ball1_image = normalizedOriginalBallImg1.clone();
+        cv::Mat test_ball1_image;
         GetRotatedImage(normalizedOriginalBallImg1, local_ball1, cv::Vec3i(best_rot_x, best_rot_y, best_rot_z), test_ball1_image);
 
         // We'll draw a center-dot on the final image here, but we're not going to re-use that image, so it's ok
@@ -3211,9 +4332,7 @@ namespace golf_sim {
         // Must be called prior to using the iteration() operator
         static void setup(const cv::Mat* target_image,
                           const cv::Mat* candidate_elements_mat,
-                          std::vector<RotationCandidate>* candidates,
-                          std::vector<std::string>* comparisonData ) {
-            ImgComparisonOp::comparisonData_ = comparisonData;
+                          std::vector<RotationCandidate>* candidates ) {
             ImgComparisonOp::target_image_ = target_image;
             ImgComparisonOp::candidate_elements_mat_ = candidate_elements_mat;
             ImgComparisonOp::candidates_ = candidates;
@@ -3245,18 +4364,13 @@ namespace golf_sim {
             // GS_LOG_TRACE_MSG(trace, "I=" + std::to_string(elementIndex) + ", Rot: (" + std::to_string(c.x_rotation_degrees) + ", " + std::to_string(c.y_rotation_degrees) + ", " + std::to_string(c.z_rotation_degrees) + ") " + ".Score : " + std::to_string(results[0]) + " out of " + std::to_string(results[1]) +
             //    ". Scaled = " + std::to_string(scaledScore);
 
-            // CSV (Excel) File format - Comma-Seperated-Values for Excel spreadsheet export
-            // Columns are Idx, Rotx, Roty, Rotz, Score, Out-of, ScaledScore
-            std::string s = std::to_string(c.index) + "\t" + std::to_string(c.x_rotation_degrees) + "\t" + std::to_string(c.y_rotation_degrees) + "\t" + std::to_string(c.z_rotation_degrees) + "\t" + std::to_string(results[0]) + "\t" + std::to_string(results[1]) +
-                "\t" + std::to_string(scaledScore) + "\n";
-
-            // DEBUG - Save a CSV-compatible string for later analysis
-            (*comparisonData_)[c.index] = s;
+            // NOTE - No CSV text is built here.  The candidates themselves hold the raw
+            // numeric results, and any CSV export is formatted lazily after the scoring
+            // loops (and only if the spin-analysis files are enabled).
         }
 
         static const cv::Mat* target_image_;
         static const cv::Mat* candidate_elements_mat_;
-        static std::vector<std::string>* comparisonData_;
         static std::vector<RotationCandidate>* candidates_;
     };
 
@@ -3264,53 +4378,16 @@ namespace golf_sim {
     // Create temporary nonce objects because C++ requires references to point to a valid object.
     // the null/nonce references will go out of scope after setup() is called and these references
     // are set to valid objects
-    std::vector<std::string>* ImgComparisonOp::comparisonData_ = nullptr;
     const cv::Mat* ImgComparisonOp::target_image_ = nullptr;
     const cv::Mat* ImgComparisonOp::candidate_elements_mat_ = nullptr;
     std::vector<RotationCandidate>* ImgComparisonOp::candidates_ = nullptr;
 
 
-    // Returns the index within candidates that has the best comparison.
+    // Picks the best-scoring candidate, applying a penalty for candidates whose
+    // comparisons had unusually few examined pixels.
     // Returns -1 on failure.
-    int BallImageProc::CompareCandidateAngleImages(const cv::Mat* target_image,
-                                                    const cv::Mat* candidate_elements_mat,
-                                                    const cv::Vec3i* candidate_elements_mat_size,
-                                                    std::vector<RotationCandidate>* candidates,
-                                                    std::vector<std::string>& comparison_csv_data) {
-
-        boost::timer::cpu_timer timer1;
-
-        // Assume candidates is a vector that is already pre-sized and filled with candidate information
-        // and that the candidate_elements_mat has x, y, and z bounds that are commensurate with the candidates vector
-        int xSize = (*candidate_elements_mat_size)[0];
-        int ySize = (*candidate_elements_mat_size)[1];
-        int zSize = (*candidate_elements_mat_size)[2];
-
-        int numCandidates = xSize * ySize * zSize;
-        std::vector<std::string> comparisonData(numCandidates);
-
-
-        // Iterate through the matrix of candidates
-
-        ImgComparisonOp::setup(target_image, candidate_elements_mat, candidates, &comparisonData);
+    int BallImageProc::SelectBestRotationCandidate(const std::vector<RotationCandidate>& candidates) {
 
-        //  Serialized version for debugging
-        if (kSerializeOpsForDebug) {
-            for (int x = 0; x < xSize; x++) {
-                for (int y = 0; y < ySize; y++) {
-                    for (int z = 0; z < zSize; z++) {
-                        ushort unusedValue = 0;
-                        int position[]{ x, y, z };
-                        ImgComparisonOp()(unusedValue, position);
-                    }
-                }
-            }
-        }
-        else {
-            (*candidate_elements_mat).forEach<ushort>(ImgComparisonOp());
-        }
-
-        // Find the best candidate from the comparison results
         double maxScaledScore = -1.0;
         double maxPixelsExamined = -1.0;
         double maxPixelsMatching = -1.0;
@@ -3342,9 +4419,9 @@ namespace golf_sim {
         // Find the range of numbers of matching pixels and the total
         // most-available pixels in order to insert that into the mix for
         // a combined score
-        for (auto& element : *candidates)
+        for (auto& element : candidates)
         {
-            RotationCandidate c = element;
+            const RotationCandidate& c = element;
 
             if (c.pixels_examined > maxPixelsExamined) {
                 maxPixelsExamined = c.pixels_examined;
@@ -3360,9 +4437,9 @@ namespace golf_sim {
             }
         }
 
-        for (auto& element : *candidates)
+        for (auto& element : candidates)
         {
-            RotationCandidate c = element;
+            const RotationCandidate& c = element;
 
             low_count_penalty = std::pow((maxPixelsExamined - (double)c.pixels_examined) / kSpinLowCountDifferenceWeightingFactor,
                                 kSpinLowCountPenaltyPower) / kSpinLowCountPenaltyScalingFactor;
@@ -3378,17 +4455,173 @@ namespace golf_sim {
         }
 
         std::string s = "Best Candidate based on number of matching pixels was #" + std::to_string(maxPixelsMatchingIndex) +
-                            " - Rot: (" + std::to_string(bestPixelsMatchingRotX) + ", " + 
+                            " - Rot: (" + std::to_string(bestPixelsMatchingRotX) + ", " +
                             std::to_string(bestPixelsMatchingRotY) + ", " + std::to_string(bestPixelsMatchingRotZ) + ") ";
         // GS_LOG_MSG(debug, s);
 
         s = "Best Candidate based on its scaled score of (" + std::to_string(maxScaledScore) + ") was # " + std::to_string(maxScaledScoreIndex) +
-                            " - Rot: (" + std::to_string(bestScaledScoreRotX) + ", " + 
+                            " - Rot: (" + std::to_string(bestScaledScoreRotX) + ", " +
                             std::to_string(bestScaledScoreRotY) + ", " + std::to_string(bestScaledScoreRotZ) + ") ";
         GS_LOG_MSG(debug, s);
 
-        // Transfer all the csv data to the output variable
-        comparison_csv_data = comparisonData;
+        return maxScaledScoreIndex;
+    }
+
+
+    // Returns the index within candidates that has the best comparison.
+    // Returns -1 on failure.
+    int BallImageProc::CompareCandidateAngleImages(const cv::Mat* target_image,
+                                                    const cv::Mat* candidate_elements_mat,
+                                                    const cv::Vec3i* candidate_elements_mat_size,
+                                                    std::vector<RotationCandidate>* candidates,
+                                                    std::vector<std::string>& comparison_csv_data) {
+
+        GsPerfCounters::ScopedStage perf_stage("CompareCandidateAngleImages");
+
+        boost::timer::cpu_timer timer1;
+
+        // Assume candidates is a vector that is already pre-sized and filled with candidate information
+        // and that the candidate_elements_mat has x, y, and z bounds that are commensurate with the candidates vector
+        int xSize = (*candidate_elements_mat_size)[0];
+        int ySize = (*candidate_elements_mat_size)[1];
+        int zSize = (*candidate_elements_mat_size)[2];
+
+        int numCandidates = xSize * ySize * zSize;
+
+        // Iterate through the matrix of candidates
+
+        ImgComparisonOp::setup(target_image, candidate_elements_mat, candidates);
+
+        //  Serialized version for debugging
+        if (kSerializeOpsForDebug) {
+            for (int x = 0; x < xSize; x++) {
+                for (int y = 0; y < ySize; y++) {
+                    for (int z = 0; z < zSize; z++) {
+                        ushort unusedValue = 0;
+                        int position[]{ x, y, z };
+                        ImgComparisonOp()(unusedValue, position);
+                    }
+                }
+            }
+        }
+        else if (kUseBitPackedSpinImages && !(*candidates).empty() && !(*candidates)[0].packed_img.IsEmpty()) {
+            // Popcount scoring over the bit-packed images - each 64-bit word compares
+            // 64 pixels, and the packed candidate set is ~8x smaller than the unpacked one
+            PackedDimpleImage packed_target;
+            PackDimpleImage(*target_image, packed_target);
+
+            cv::parallel_for_(cv::Range(0, numCandidates), [&](const cv::Range& range) {
+                for (int i = range.start; i < range.end; i++) {
+                    RotationCandidate& c = (*candidates)[i];
+
+                    cv::Vec2i results = BallImageProc::ComparePackedDimpleImages(packed_target, c.packed_img);
+
+                    c.pixels_matching = results[0];
+                    c.pixels_examined = results[1];
+                    c.score = (results[1] > 0) ? (double)results[0] / (double)results[1] : 0.0;
+                }
+            });
+        }
+        else if (kUseSpinCandidatePruning && numCandidates > 8) {
+            // Branch-and-bound scoring.  Phase 1 ranks every candidate using only a
+            // subsampled pixel grid.  Phase 2 then scores only the best-scoring
+            // fraction at full resolution, abandoning any candidate as soon as it
+            // provably cannot beat the best full-resolution score found so far.
+
+            const int stride = std::max(2, kSpinPruningSubsampleStride);
+
+            std::vector<double> coarse_scores(numCandidates, -1.0);
+
+            cv::parallel_for_(cv::Range(0, numCandidates), [&](const cv::Range& range) {
+                for (int i = range.start; i < range.end; i++) {
+                    RotationCandidate& c = (*candidates)[i];
+
+                    cv::Vec2i results = BallImageProc::CompareRotationImageSubsampled(*target_image, c.img, stride);
+
+                    // Scale the strided counts back up so that the low-pixel-count
+                    // penalty in the selection logic below stays comparable between
+                    // pruned and fully-scored candidates.  The ratio is unaffected.
+                    c.pixels_matching = results[0] * stride * stride;
+                    c.pixels_examined = results[1] * stride * stride;
+                    c.score = (results[1] > 0) ? (double)results[0] / (double)results[1] : 0.0;
+                    coarse_scores[i] = c.score;
+                }
+            });
+
+            // Determine the subsampled score that a candidate must have reached to
+            // be worth scoring at full resolution
+            int keep_count = std::max(1, (int)std::ceil(numCandidates * kSpinPruningKeepFraction));
+            keep_count = std::min(keep_count, numCandidates);
+
+            std::vector<double> sorted_scores = coarse_scores;
+            std::nth_element(sorted_scores.begin(), sorted_scores.begin() + (keep_count - 1), sorted_scores.end(), std::greater<double>());
+            double keep_threshold = sorted_scores[keep_count - 1];
+
+            std::atomic<double> best_full_score{ 0.0 };
+
+            cv::parallel_for_(cv::Range(0, numCandidates), [&](const cv::Range& range) {
+                for (int i = range.start; i < range.end; i++) {
+                    if (coarse_scores[i] < keep_threshold) {
+                        continue;
+                    }
+
+                    RotationCandidate& c = (*candidates)[i];
+
+                    cv::Vec2i results;
+                    if (!BallImageProc::CompareRotationImageBounded(*target_image, c.img, best_full_score.load(), results)) {
+                        // Abandoned mid-scan - the candidate keeps its (scaled) subsampled score
+                        continue;
+                    }
+
+                    c.pixels_matching = results[0];
+                    c.pixels_examined = results[1];
+                    c.score = (results[1] > 0) ? (double)results[0] / (double)results[1] : 0.0;
+
+                    // Keep a running maximum of the full-resolution scores for the bound
+                    double prior_best = best_full_score.load();
+                    while (c.score > prior_best && !best_full_score.compare_exchange_weak(prior_best, c.score)) {
+                    }
+                }
+            });
+        }
+        else {
+            // Call the comparison kernel directly for each candidate instead of going
+            // through cv::Mat::forEach and the 3D index matrix - that per-candidate
+            // dispatch was measurable overhead across the thousands of candidates
+            cv::parallel_for_(cv::Range(0, numCandidates), [&](const cv::Range& range) {
+                for (int i = range.start; i < range.end; i++) {
+                    RotationCandidate& c = (*candidates)[i];
+
+                    // Compare the second ball image to this rotated version of the first
+                    // ball image to see how closely they correspond
+                    cv::Vec2i results = BallImageProc::CompareRotationImage(*target_image, c.img, c.index);
+
+                    c.pixels_matching = results[0];
+                    c.pixels_examined = results[1];
+                    c.score = (double)results[0] / (double)results[1];
+                }
+            });
+        }
+
+        // Find the best candidate from the comparison results
+        int maxScaledScoreIndex = SelectBestRotationCandidate(*candidates);
+
+        // The scoring loops above only record raw numbers into the candidates.  Only
+        // spend time on std::to_string formatting if the CSV export is actually enabled.
+        comparison_csv_data.clear();
+
+        if (kWriteSpinAnalysisCsvFiles) {
+            comparison_csv_data.resize(numCandidates);
+
+            // CSV (Excel) File format - Comma-Seperated-Values for Excel spreadsheet export
+            // Columns are Idx, Rotx, Roty, Rotz, Score, Out-of, ScaledScore
+            for (auto& c : *candidates) {
+                comparison_csv_data[c.index] = std::to_string(c.index) + "\t" + std::to_string(c.x_rotation_degrees) + "\t" +
+                    std::to_string(c.y_rotation_degrees) + "\t" + std::to_string(c.z_rotation_degrees) + "\t" +
+                    std::to_string(c.pixels_matching) + "\t" + std::to_string(c.pixels_examined) + "\t" +
+                    std::to_string(c.score) + "\n";
+            }
+        }
 
         timer1.stop();
         boost::timer::cpu_times times = timer1.elapsed();
@@ -3409,6 +4642,29 @@ namespace golf_sim {
 
         CV_Assert((img1.rows == img2.rows && img1.rows == img2.cols));
 
+#if defined(__aarch64__)
+        // The vectorized kernel walks raw rows, so require the usual continuous layout.
+        // All of the candidate and target images will have it in practice.
+        // The kernel itself lives in gs_tuned_kernels.cpp, which is built once per
+        // CPU tuning target - GsCpuDispatch picks the build that matches the Pi
+        // model we are actually running on.
+        if (kUseNEONSpinKernel && img1.isContinuous() && img2.isContinuous()) {
+            if (GsCpuDispatch::GetTuningTarget() == GsCpuDispatch::kTuneCortexA72) {
+                return tuned_a72::CompareRotationImageNEON(img1, img2, kPixelIgnoreValue);
+            }
+
+            return tuned_a76::CompareRotationImageNEON(img1, img2, kPixelIgnoreValue);
+        }
+#endif
+
+        return CompareRotationImageScalar(img1, img2, index);
+    }
+
+
+    cv::Vec2i BallImageProc::CompareRotationImageScalar(const cv::Mat& img1, const cv::Mat& img2, const int index) {
+
+        CV_Assert((img1.rows == img2.rows && img1.rows == img2.cols));
+
         // DEBUG - create a binary image showing what pixels are the same between them
         cv::Mat testCorrespondenceImg = cv::Mat::zeros(img1.rows, img1.cols, img1.type());
 
@@ -3447,6 +4703,159 @@ namespace golf_sim {
     }
 
 
+    void BallImageProc::PackDimpleImage(const cv::Mat& img, PackedDimpleImage& packed) {
+
+        CV_Assert(img.type() == CV_8UC1);
+
+        packed.rows = img.rows;
+        packed.cols = img.cols;
+        packed.words_per_row = (img.cols + 63) / 64;
+        packed.value_bits.assign((size_t)packed.rows * packed.words_per_row, 0);
+        packed.valid_bits.assign((size_t)packed.rows * packed.words_per_row, 0);
+
+        for (int row = 0; row < img.rows; row++) {
+            const uchar* img_row = img.ptr<uchar>(row);
+            uint64_t* value_row = &packed.value_bits[(size_t)row * packed.words_per_row];
+            uint64_t* valid_row = &packed.valid_bits[(size_t)row * packed.words_per_row];
+
+            for (int col = 0; col < img.cols; col++) {
+                uchar p = img_row[col];
+                if (p != kPixelIgnoreValue) {
+                    uint64_t bit = 1ULL << (col & 63);
+                    valid_row[col >> 6] |= bit;
+                    // After the edge thresholding the non-ignore pixels are binary (0 or 255)
+                    if (p == 255) {
+                        value_row[col >> 6] |= bit;
+                    }
+                }
+            }
+        }
+    }
+
+    void BallImageProc::PackCandidateImage(const cv::Mat& candidate_img, PackedDimpleImage& packed) {
+
+        // The candidate projection images hold two interleaved int32 channels per
+        // pixel, with the pixel value in the second channel
+        packed.rows = candidate_img.rows;
+        packed.cols = candidate_img.cols;
+        packed.words_per_row = (candidate_img.cols + 63) / 64;
+        packed.value_bits.assign((size_t)packed.rows * packed.words_per_row, 0);
+        packed.valid_bits.assign((size_t)packed.rows * packed.words_per_row, 0);
+
+        for (int row = 0; row < candidate_img.rows; row++) {
+            const int* img_row = candidate_img.ptr<int>(row);
+            uint64_t* value_row = &packed.value_bits[(size_t)row * packed.words_per_row];
+            uint64_t* valid_row = &packed.valid_bits[(size_t)row * packed.words_per_row];
+
+            for (int col = 0; col < candidate_img.cols; col++) {
+                uchar p = (uchar)img_row[2 * col + 1];
+                if (p != kPixelIgnoreValue) {
+                    uint64_t bit = 1ULL << (col & 63);
+                    valid_row[col >> 6] |= bit;
+                    if (p == 255) {
+                        value_row[col >> 6] |= bit;
+                    }
+                }
+            }
+        }
+    }
+
+    cv::Vec2i BallImageProc::ComparePackedDimpleImages(const PackedDimpleImage& img1, const PackedDimpleImage& img2) {
+
+        CV_Assert(img1.rows == img2.rows && img1.cols == img2.cols);
+
+        long score = 0;
+        long totalPixelsExamined = 0;
+
+        const size_t num_words = img1.valid_bits.size();
+
+        for (size_t i = 0; i < num_words; i++) {
+            // A pixel is only examined if it is valid in both images; it matches if
+            // its value bits agree.  Each word covers 64 pixels.
+            uint64_t valid = img1.valid_bits[i] & img2.valid_bits[i];
+            totalPixelsExamined += __builtin_popcountll(valid);
+            score += __builtin_popcountll(valid & ~(img1.value_bits[i] ^ img2.value_bits[i]));
+        }
+
+        return cv::Vec2i((int)score, (int)totalPixelsExamined);
+    }
+
+
+    cv::Vec2i BallImageProc::CompareRotationImageSubsampled(const cv::Mat& img1, const cv::Mat& img2, int stride) {
+
+        CV_Assert((img1.rows == img2.rows && img1.rows == img2.cols));
+
+        long score = 0;
+        long totalPixelsExamined = 0;
+
+        for (int row = 0; row < img1.rows; row += stride) {
+            const uchar* p1_row = img1.ptr<uchar>(row);
+            const int* p2_row = img2.ptr<int>(row);     // Two interleaved int32 channels per pixel
+
+            for (int col = 0; col < img1.cols; col += stride) {
+                uchar p1 = p1_row[col];
+                uchar p2 = (uchar)p2_row[2 * col + 1];
+
+                if (p1 != kPixelIgnoreValue && p2 != kPixelIgnoreValue) {
+                    totalPixelsExamined++;
+                    if (p1 == p2) {
+                        score++;
+                    }
+                }
+            }
+        }
+
+        return cv::Vec2i((int)score, (int)totalPixelsExamined);
+    }
+
+
+    bool BallImageProc::CompareRotationImageBounded(const cv::Mat& img1, const cv::Mat& img2, double best_score_so_far, cv::Vec2i& results) {
+
+        CV_Assert((img1.rows == img2.rows && img1.rows == img2.cols));
+
+        long score = 0;
+        long totalPixelsExamined = 0;
+
+        const long total_pixels = (long)img1.rows * (long)img1.cols;
+        long pixels_seen = 0;
+
+        for (int row = 0; row < img1.rows; row++) {
+            const uchar* p1_row = img1.ptr<uchar>(row);
+            const int* p2_row = img2.ptr<int>(row);
+
+            for (int col = 0; col < img1.cols; col++) {
+                uchar p1 = p1_row[col];
+                uchar p2 = (uchar)p2_row[2 * col + 1];
+
+                if (p1 != kPixelIgnoreValue && p2 != kPixelIgnoreValue) {
+                    totalPixelsExamined++;
+                    if (p1 == p2) {
+                        score++;
+                    }
+                }
+            }
+
+            pixels_seen += img1.cols;
+
+            // Branch-and-bound check (at row granularity) - optimistically assume every
+            // remaining pixel will be examined and will match.  If even that could not
+            // beat the best score seen so far, this candidate can be abandoned.
+            long remaining = total_pixels - pixels_seen;
+
+            if (totalPixelsExamined + remaining > 0) {
+                double optimistic_score = (double)(score + remaining) / (double)(totalPixelsExamined + remaining);
+
+                if (optimistic_score < best_score_so_far) {
+                    return false;
+                }
+            }
+        }
+
+        results = cv::Vec2i((int)score, (int)totalPixelsExamined);
+        return true;
+    }
+
+
     cv::Mat BallImageProc::CreateGaborKernel(int ks, double sig, double th, double lm, double gm, double ps) {
 
         int hks = (ks - 1) / 2;
@@ -3575,39 +4984,468 @@ namespace golf_sim {
         cv::Mat kernel;
 
 
-        // Sweep through a bunch of different angles for the filter in order to pick up features
-        // in all directions
-        const double thetaIncrement = 11.25; //  5.625; // CURRENT 11.25;  // degrees.  Nominal: 11.25 also works 
-        for (double theta = 0; theta <= 360.0; theta += thetaIncrement) {
-            kernel = CreateGaborKernel(kernel_size, sig, theta, lm, gm, ps);
-            cv::filter2D(img_f32, dest, CV_32F, kernel);
+        // Sweep through a bunch of different angles for the filter in order to pick up features
+        // in all directions
+        const double thetaIncrement = 11.25; //  5.625; // CURRENT 11.25;  // degrees.  Nominal: 11.25 also works 
+        for (double theta = 0; theta <= 360.0; theta += thetaIncrement) {
+            kernel = CreateGaborKernel(kernel_size, sig, theta, lm, gm, ps);
+            cv::filter2D(img_f32, dest, CV_32F, kernel);
+
+            cv::max(accum, dest, accum);
+        }
+
+        cv::Mat accumGray;
+
+        // Convert from the 0.0 to 1.0 range into 0-255
+        accum.convertTo(accumGray, CV_8U, 255, 0);
+
+        cv::Mat dimpleEdges = cv::Mat::zeros(accum.rows, accum.cols, accum.type());
+
+        // Threshold the image to either 0 or 255
+        const int edgeThresholdLow = (int)std::round(binary_threshold * 10.);
+        const int edgeThresholdHigh = 255;
+        cv::threshold(accumGray, dimpleEdges, edgeThresholdLow, edgeThresholdHigh, cv::THRESH_BINARY);
+
+        white_percent = (int)std::round(((double)cv::countNonZero(dimpleEdges) * 100.) / ((double)dimpleEdges.rows * dimpleEdges.cols));
+
+        return dimpleEdges;
+    }
+ 
+    void RotationCandidateArena::Reset(int num_candidates, int rows, int cols, int type) {
+
+        size_t bytes_per_image = (size_t)rows * (size_t)cols * CV_ELEM_SIZE(type);
+        size_t total_bytes = bytes_per_image * (size_t)num_candidates;
+
+        // Only (re-)allocate the backing block if the existing one is too small.
+        // This lets the coarse pass, the fine pass, and subsequent shots all
+        // recycle the same allocation.
+        if (block_.empty() || total_bytes > block_.total() * block_.elemSize()) {
+            block_ = cv::Mat(1, (int)total_bytes, CV_8U);
+        }
+
+        slot_size_bytes_ = bytes_per_image;
+        rows_ = rows;
+        cols_ = cols;
+        type_ = type;
+        next_slot_ = 0;
+        num_slots_ = num_candidates;
+    }
+
+    cv::Mat RotationCandidateArena::AllocateImage() {
+
+        CV_Assert(next_slot_ < num_slots_);
+
+        int sizes[2] = { rows_, cols_ };
+
+        // Build a Mat header over the next slot of the block.  The header does not
+        // own (and will never free) the underlying arena memory.
+        cv::Mat img = cv::Mat(2, sizes, type_, block_.data + slot_size_bytes_ * (size_t)next_slot_);
+        next_slot_++;
+
+        return img;
+    }
+
+    // The candidate images for a shot are all identically-sized, so they are carved
+    // out of this single arena rather than individually heap-allocated.
+    // ComputeCandidateAngleImages is only ever called from the (single) spin-analysis
+    // thread, so a file-scope arena is safe here.
+    static RotationCandidateArena rotation_candidate_arena_;
+
+
+   bool BallImageProc::SearchBallRotationIterative(const cv::Mat& base_dimple_image,
+                                                    const GolfBall& ball,
+                                                    const cv::Mat& target_dimple_image,
+                                                    cv::Vec3i& best_rotation) {
+        boost::timer::cpu_timer timer1;
+
+        int evaluations = 0;
+
+        // Memoize the scores so that re-visited rotations (common as the pattern
+        // collapses toward the optimum) do not cost another full image projection
+        std::map<std::tuple<int, int, int>, double> score_cache;
+
+        auto Score = [&](const cv::Vec3i& rotation) -> double {
+            auto key = std::make_tuple(rotation[0], rotation[1], rotation[2]);
+            auto cached = score_cache.find(key);
+            if (cached != score_cache.end()) {
+                return cached->second;
+            }
+
+            // Same objective as the grid search - project the base ball image out to a
+            // 3D hemisphere at the candidate rotation and compare it to the target image
+            cv::Mat candidate3DImage = Project2dImageTo3dBall(base_dimple_image, ball, rotation);
+            cv::Vec2i results = CompareRotationImage(target_dimple_image, candidate3DImage);
+            evaluations++;
+
+            double score = (results[1] > 0) ? (double)results[0] / (double)results[1] : -1.0;
+            score_cache[key] = score;
+            return score;
+        };
+
+        // Start in the middle of the configured coarse search space so that the
+        // optimizer honors the same angular bounds as the exhaustive grid would
+        cv::Vec3i current((kCoarseXRotationDegreesStart + kCoarseXRotationDegreesEnd) / 2,
+                          (kCoarseYRotationDegreesStart + kCoarseYRotationDegreesEnd) / 2,
+                          (kCoarseZRotationDegreesStart + kCoarseZRotationDegreesEnd) / 2);
+
+        double best_score = Score(current);
+
+        int step = kSpinIterativeInitialStepDegrees;
+
+        while (step >= 1 && evaluations < kSpinIterativeMaxEvaluations) {
+            bool improved = false;
+
+            // Compass search - probe +/- step along each rotation axis from the current point
+            for (int axis = 0; axis < 3 && evaluations < kSpinIterativeMaxEvaluations; axis++) {
+                for (int direction = -1; direction <= 1; direction += 2) {
+                    cv::Vec3i probe = current;
+                    probe[axis] += direction * step;
+
+                    // Keep the search within the configured coarse search bounds
+                    if (probe[0] < kCoarseXRotationDegreesStart || probe[0] > kCoarseXRotationDegreesEnd ||
+                        probe[1] < kCoarseYRotationDegreesStart || probe[1] > kCoarseYRotationDegreesEnd ||
+                        probe[2] < kCoarseZRotationDegreesStart || probe[2] > kCoarseZRotationDegreesEnd) {
+                        continue;
+                    }
+
+                    double score = Score(probe);
+
+                    if (score > best_score) {
+                        best_score = score;
+                        current = probe;
+                        improved = true;
+                    }
+                }
+            }
+
+            // Only tighten the pattern once no direction at the current step helps
+            if (!improved) {
+                step /= 2;
+            }
+        }
+
+        timer1.stop();
+        boost::timer::cpu_times times = timer1.elapsed();
+        std::cout << "SearchBallRotationIterative (" << evaluations << " evaluations): ";
+        std::cout << std::fixed << std::setprecision(8)
+            << times.wall / 1.0e9 << "s wall, "
+            << times.user / 1.0e9 << "s user + "
+            << times.system / 1.0e9 << "s system.\n";
+
+        if (best_score < 0) {
+            return false;
+        }
+
+        best_rotation = current;
+
+        GS_LOG_MSG(debug, "Iterative spin search converged on Rot: (" + std::to_string(best_rotation[0]) + ", " +
+            std::to_string(best_rotation[1]) + ", " + std::to_string(best_rotation[2]) + ") with score " +
+            std::to_string(best_score) + " after " + std::to_string(evaluations) + " evaluations.");
+
+        return true;
+    }
+
+
+    // Reentrant (no static state) candidate projection used by the fused
+    // generate-and-score pipeline, where several candidates with different rotations
+    // are projected concurrently on different cores.  Mirrors the math in
+    // projectionOp / Project2dImageTo3dBall, writing into a caller-provided
+    // CV_32SC2 scratch image.
+    static void ProjectCandidateReentrant(const cv::Mat& base_dimple_image,
+                                          const GolfBall& ball,
+                                          const cv::Vec3i& rotation_degrees,
+                                          cv::Mat& projected_img) {
+
+        projected_img.setTo(cv::Scalar(0, kPixelIgnoreValue));
+
+        // Negative X due to rotation in the X axis being backward (see Project2dImageTo3dBall)
+        const double radX = -CvUtils::DegreesToRadians((double)rotation_degrees[0]);
+        const double radY = CvUtils::DegreesToRadians((double)rotation_degrees[1]);
+        const double radZ = CvUtils::DegreesToRadians((double)rotation_degrees[2]);
+
+        const double sinX = sin(radX), cosX = cos(radX);
+        const double sinY = sin(radY), cosY = cos(radY);
+        const double sinZ = sin(radZ), cosZ = cos(radZ);
+
+        const bool rotatingOnX = (std::abs(radX) > 0.001);
+        const bool rotatingOnY = (std::abs(radY) > 0.001);
+        const bool rotatingOnZ = (std::abs(radZ) > 0.001);
+
+        const double r = ball.measured_radius_pixels_;
+        const double rSquared = r * r;
+        const double ballCenterX = ball.x();
+        const double ballCenterY = ball.y();
+
+        // Same hemisphere-height math as projectionOp::getBallZ
+        auto ballZ = [&](double imageX, double imageY, double& xFromCenter, double& yFromCenter) -> double {
+            xFromCenter = imageX - ballCenterX;
+            yFromCenter = imageY - ballCenterY;
+
+            if (std::abs(xFromCenter) > r || std::abs(yFromCenter) > r) {
+                return 0.0;
+            }
+
+            double diff = rSquared - (xFromCenter * xFromCenter + yFromCenter * yFromCenter);
+            return (diff < 0.0) ? 0.0 : sqrt(diff);
+        };
+
+        for (int imageX = 0; imageX < base_dimple_image.rows; imageX++) {
+            for (int imageY = 0; imageY < base_dimple_image.cols; imageY++) {
+
+                uchar pixelValue = base_dimple_image.at<uchar>(imageX, imageY);
+
+                double xFromCenter = 0.0;
+                double yFromCenter = 0.0;
+                double imageZ = ballZ(imageX, imageY, xFromCenter, yFromCenter);
+
+                bool prerotatedPointNotValid = (imageZ <= 0.0001);
+
+                if (prerotatedPointNotValid) {
+                    // The source point came from outside the visible hemisphere
+                    projected_img.at<cv::Vec2i>(imageX, imageY)[0] = (int)imageZ;
+                    projected_img.at<cv::Vec2i>(imageX, imageY)[1] = kPixelIgnoreValue;
+                }
+
+                if (rotatingOnX) {
+                    double tmpYFromCenter = yFromCenter;
+                    yFromCenter = (yFromCenter * cosX) - (imageZ * sinX);
+                    imageZ = (int)((tmpYFromCenter * sinX) + (imageZ * cosX));
+                }
+
+                if (rotatingOnY) {
+                    double tmpXFromCenter = xFromCenter;
+                    xFromCenter = (xFromCenter * cosY) + (imageZ * sinY);
+                    imageZ = (int)((imageZ * cosY) - (tmpXFromCenter * sinY));
+                }
+
+                if (rotatingOnZ) {
+                    double tmpXFromCenter = xFromCenter;
+                    xFromCenter = (xFromCenter * cosZ) - (yFromCenter * sinZ);
+                    yFromCenter = (tmpXFromCenter * sinZ) + (yFromCenter * cosZ);
+                }
+
+                double destX = xFromCenter + ballCenterX;
+                double destY = yFromCenter + ballCenterY;
+
+                double dummyXFromCenter = 0.0;
+                double dummyYFromCenter = 0.0;
+                double zOfRotatedPoint = ballZ(destX, destY, dummyXFromCenter, dummyYFromCenter);
+
+                if (destX >= 0 &&
+                    destY >= 0 &&
+                    destX < projected_img.cols &&
+                    destY < projected_img.rows &&
+                    zOfRotatedPoint > 0.0) {
+
+                    int roundedX = (int)(destX + 0.5);
+                    int roundedY = (int)(destY + 0.5);
+
+                    projected_img.at<cv::Vec2i>(roundedX, roundedY)[0] = (int)zOfRotatedPoint;
+                    projected_img.at<cv::Vec2i>(roundedX, roundedY)[1] = (prerotatedPointNotValid ? kPixelIgnoreValue : pixelValue);
+                }
+            }
+        }
+    }
+
+
+    void BallImageProc::BuildBallPointCloud(const cv::Mat& base_dimple_image,
+                                            const GolfBall& ball,
+                                            std::vector<BallPointCloudPoint>& point_cloud) {
+
+        const double r = ball.measured_radius_pixels_;
+        const double rSquared = r * r;
+        const double ballCenterX = ball.x();
+        const double ballCenterY = ball.y();
+
+        point_cloud.clear();
+        // Roughly pi/4 of the bounding square is on the visible hemisphere
+        point_cloud.reserve(((size_t)base_dimple_image.rows * base_dimple_image.cols * 8) / 10);
+
+        for (int imageX = 0; imageX < base_dimple_image.rows; imageX++) {
+            for (int imageY = 0; imageY < base_dimple_image.cols; imageY++) {
+
+                double xFromCenter = (double)imageX - ballCenterX;
+                double yFromCenter = (double)imageY - ballCenterY;
+
+                if (std::abs(xFromCenter) > r || std::abs(yFromCenter) > r) {
+                    continue;
+                }
+
+                double diff = rSquared - (xFromCenter * xFromCenter + yFromCenter * yFromCenter);
+
+                // Points off the visible hemisphere never contribute to a candidate
+                // image (the scratch image is pre-filled with the ignore value), so
+                // they are simply left out of the cloud
+                if (diff <= 0.0001) {
+                    continue;
+                }
+
+                BallPointCloudPoint p;
+                p.x_from_center = (float)xFromCenter;
+                p.y_from_center = (float)yFromCenter;
+                p.z = (float)sqrt(diff);
+                p.value = base_dimple_image.at<uchar>(imageX, imageY);
+
+                point_cloud.push_back(p);
+            }
+        }
+    }
+
+
+    void BallImageProc::ProjectPointCloud(const std::vector<BallPointCloudPoint>& point_cloud,
+                                            const GolfBall& ball,
+                                            const cv::Vec3i& rotation_degrees,
+                                            cv::Mat& projected_img) {
+
+        projected_img.setTo(cv::Scalar(0, kPixelIgnoreValue));
+
+        // Negative X due to rotation in the X axis being backward (see Project2dImageTo3dBall)
+        const double radX = -CvUtils::DegreesToRadians((double)rotation_degrees[0]);
+        const double radY = CvUtils::DegreesToRadians((double)rotation_degrees[1]);
+        const double radZ = CvUtils::DegreesToRadians((double)rotation_degrees[2]);
+
+        const double sinX = sin(radX), cosX = cos(radX);
+        const double sinY = sin(radY), cosY = cos(radY);
+        const double sinZ = sin(radZ), cosZ = cos(radZ);
+
+        const double ballCenterX = ball.x();
+        const double ballCenterY = ball.y();
+
+        const int rows = projected_img.rows;
+        const int cols = projected_img.cols;
+
+        for (const BallPointCloudPoint& p : point_cloud) {
+
+            // Same X-then-Y-then-Z rotation order as the per-pixel projection
+            double x = p.x_from_center;
+            double y = p.y_from_center;
+            double z = p.z;
+
+            double tmpY = y;
+            y = (y * cosX) - (z * sinX);
+            z = (tmpY * sinX) + (z * cosX);
+
+            double tmpX = x;
+            x = (x * cosY) + (z * sinY);
+            z = (z * cosY) - (tmpX * sinY);
+
+            tmpX = x;
+            x = (x * cosZ) - (y * sinZ);
+            y = (tmpX * sinZ) + (y * cosZ);
+
+            // A point of the sphere that rotated to the back hemisphere is not visible
+            if (z <= 0.0) {
+                continue;
+            }
+
+            double destX = x + ballCenterX;
+            double destY = y + ballCenterY;
+
+            if (destX >= 0 && destY >= 0 && destX < cols && destY < rows) {
+                int roundedX = (int)(destX + 0.5);
+                int roundedY = (int)(destY + 0.5);
+
+                projected_img.at<cv::Vec2i>(roundedX, roundedY)[0] = (int)z;
+                projected_img.at<cv::Vec2i>(roundedX, roundedY)[1] = p.value;
+            }
+        }
+    }
+
+
+    int BallImageProc::ComputeAndCompareCandidateAngleImages(const cv::Mat& base_dimple_image,
+                                            const RotationSearchSpace& search_space,
+                                            const cv::Mat& target_image,
+                                            const GolfBall& ball,
+                                            std::vector<RotationCandidate>& output_candidates) {
+        boost::timer::cpu_timer timer1;
+
+        // Enumerate the search space up front.  The candidates hold only the raw
+        // numeric tuple - no candidate image is ever retained in this mode.
+        output_candidates.clear();
+
+        short vectorIndex = 0;
+
+        for (int x_rotation_degrees = search_space.anglex_rotation_degrees_start; x_rotation_degrees <= search_space.anglex_rotation_degrees_end; x_rotation_degrees += search_space.anglex_rotation_degrees_increment) {
+            for (int y_rotation_degrees = search_space.angley_rotation_degrees_start; y_rotation_degrees <= search_space.angley_rotation_degrees_end; y_rotation_degrees += search_space.angley_rotation_degrees_increment) {
+                for (int z_rotation_degrees = search_space.anglez_rotation_degrees_start; z_rotation_degrees <= search_space.anglez_rotation_degrees_end; z_rotation_degrees += search_space.anglez_rotation_degrees_increment) {
+
+                    RotationCandidate c;
+                    c.index = vectorIndex;
+                    c.x_rotation_degrees = x_rotation_degrees;
+                    c.y_rotation_degrees = y_rotation_degrees;
+                    c.z_rotation_degrees = z_rotation_degrees;
+                    c.score = 0.0;
+
+                    output_candidates.push_back(c);
+                    vectorIndex++;
+                }
+            }
+        }
+
+        int numCandidates = (int)output_candidates.size();
+
+        GS_LOG_TRACE_MSG(trace, "ComputeAndCompareCandidateAngleImages will evaluate " + std::to_string(numCandidates) + " candidates.");
 
-            cv::max(accum, dest, accum);
+        // When enabled, hoist the hemisphere geometry out of the per-candidate work -
+        // each candidate then only rotates the cached points
+        std::vector<BallPointCloudPoint> point_cloud;
+        if (kUseCachedPointCloudProjection) {
+            BuildBallPointCloud(base_dimple_image, ball, point_cloud);
         }
 
-        cv::Mat accumGray;
+        // cv::parallel_for_ hands out chunks of the range dynamically across the
+        // OpenCV worker pool, so a core that finishes its candidates early steals
+        // the next chunk.  The stripe count is kept well above the thread count so
+        // the grabs stay small and the cores stay busy to the end.
+        double nstripes = (double)std::max(1, kSpinPipelineThreads) * 8.0;
 
-        // Convert from the 0.0 to 1.0 range into 0-255
-        accum.convertTo(accumGray, CV_8U, 255, 0);
+        cv::parallel_for_(cv::Range(0, numCandidates), [&](const cv::Range& range) {
 
-        cv::Mat dimpleEdges = cv::Mat::zeros(accum.rows, accum.cols, accum.type());
+            // One scratch projection buffer per worker chunk, recycled for each of
+            // the chunk's candidates - peak memory is cores-in-flight, not all-candidates
+            int sizes[2] = { base_dimple_image.rows, base_dimple_image.cols };
+            cv::Mat scratch(2, sizes, CV_32SC2);
 
-        // Threshold the image to either 0 or 255
-        const int edgeThresholdLow = (int)std::round(binary_threshold * 10.);
-        const int edgeThresholdHigh = 255;
-        cv::threshold(accumGray, dimpleEdges, edgeThresholdLow, edgeThresholdHigh, cv::THRESH_BINARY);
+            for (int i = range.start; i < range.end; i++) {
+                RotationCandidate& c = output_candidates[i];
 
-        white_percent = (int)std::round(((double)cv::countNonZero(dimpleEdges) * 100.) / ((double)dimpleEdges.rows * dimpleEdges.cols));
+                if (kUseCachedPointCloudProjection) {
+                    ProjectPointCloud(point_cloud, ball,
+                        cv::Vec3i(c.x_rotation_degrees, c.y_rotation_degrees, c.z_rotation_degrees), scratch);
+                }
+                else {
+                    ProjectCandidateReentrant(base_dimple_image, ball,
+                        cv::Vec3i(c.x_rotation_degrees, c.y_rotation_degrees, c.z_rotation_degrees), scratch);
+                }
 
-        return dimpleEdges;
+                cv::Vec2i results = CompareRotationImage(target_image, scratch, c.index);
+
+                c.pixels_matching = results[0];
+                c.pixels_examined = results[1];
+                c.score = (results[1] > 0) ? (double)results[0] / (double)results[1] : 0.0;
+            }
+        }, nstripes);
+
+        timer1.stop();
+        boost::timer::cpu_times times = timer1.elapsed();
+        std::cout << "ComputeAndCompareCandidateAngleImages Time: " << std::fixed << std::setprecision(8)
+            << times.wall / 1.0e9 << "s wall, "
+            << times.user / 1.0e9 << "s user + "
+            << times.system / 1.0e9 << "s system.\n";
+
+        return SelectBestRotationCandidate(output_candidates);
     }
- 
-   bool BallImageProc::ComputeCandidateAngleImages(const cv::Mat& base_dimple_image, 
+
+
+   bool BallImageProc::ComputeCandidateAngleImages(const cv::Mat& base_dimple_image,
                                                     const RotationSearchSpace& search_space, 
                                                     cv::Mat &outputCandidateElementsMat,
                                                     cv::Vec3i &output_candidate_elements_mat_size, 
-                                                    std::vector< RotationCandidate> &output_candidates, 
+                                                    std::vector< RotationCandidate> &output_candidates,
                                                     const GolfBall& ball) {
+
+        GsPerfCounters::ScopedStage perf_stage("ComputeCandidateAngleImages");
+
         boost::timer::cpu_timer timer1;
 
         // These are the ranges of angles that we will create candidate images for
@@ -3664,6 +5502,19 @@ namespace golf_sim {
         int sizes[3] = { xSize, ySize, zSize };
         outputCandidateElementsMat = cv::Mat(3, sizes, CV_16U, cv::Scalar(0));
 
+        // All of the candidate images are carved out of one contiguous arena block
+        // instead of being individually heap-allocated
+        rotation_candidate_arena_.Reset(xSize * ySize * zSize, base_dimple_image.rows, base_dimple_image.cols, CV_32SC2);
+
+        output_candidates.reserve((size_t)(xSize * ySize * zSize));
+
+        // When enabled, the hemisphere lift of the base image is computed once here
+        // and every candidate below just rotates the cached points
+        std::vector<BallPointCloudPoint> point_cloud;
+        if (kUseCachedPointCloudProjection) {
+            BuildBallPointCloud(base_dimple_image, ball, point_cloud);
+        }
+
         short vectorIndex = 0;
 
         int xIndex = 0;
@@ -3679,8 +5530,18 @@ namespace golf_sim {
                     // matrix directly in the comparison
                     // GetRotatedImage(base_dimple_image, ball, cv::Vec3i(x_rotation_degrees, y_rotation_degrees, z_rotation_degrees), ball2DImage);
 
-                    // Project the ball out onto a 3D hemisphere at the current x, y, and z-axis rotation
-                    cv::Mat ball13DImage = Project2dImageTo3dBall(base_dimple_image, ball, cv::Vec3i(x_rotation_degrees, y_rotation_degrees, z_rotation_degrees));
+                    // Project the ball out onto a 3D hemisphere at the current x, y, and z-axis rotation.
+                    // The candidate image lives in (and is recycled with) the arena.
+                    cv::Mat arena_slot = rotation_candidate_arena_.AllocateImage();
+                    cv::Mat ball13DImage;
+
+                    if (kUseCachedPointCloudProjection) {
+                        ProjectPointCloud(point_cloud, ball, cv::Vec3i(x_rotation_degrees, y_rotation_degrees, z_rotation_degrees), arena_slot);
+                        ball13DImage = arena_slot;
+                    }
+                    else {
+                        ball13DImage = Project2dImageTo3dBall(base_dimple_image, ball, cv::Vec3i(x_rotation_degrees, y_rotation_degrees, z_rotation_degrees), &arena_slot);
+                    }
 
                     // Save the current image as a possible candidate to compare to later
                     RotationCandidate c;
@@ -3689,6 +5550,13 @@ namespace golf_sim {
                     // centered in the camera's image
                     c.index = vectorIndex;
                     c.img = ball13DImage;
+
+                    // When bit-packed scoring is enabled, build the 1-bit-per-pixel
+                    // representation now so the comparison pass never has to touch
+                    // the (much larger) unpacked candidate image
+                    if (kUseBitPackedSpinImages) {
+                        PackCandidateImage(ball13DImage, c.packed_img);
+                    }
                     c.x_rotation_degrees = x_rotation_degrees - xAngleOffset;
                     c.y_rotation_degrees = y_rotation_degrees - yAngleOffset;
                     c.z_rotation_degrees = z_rotation_degrees;
@@ -3778,6 +5646,14 @@ namespace golf_sim {
             rotatingOnX_ = (std::abs(x_rotation_degreesAngleRad_) > 0.001) ? true : false;
             rotatingOnY_ = (std::abs(y_rotation_degreesAngleRad_) > 0.001) ? true : false;
             rotatingOnZ_ = (std::abs(z_rotation_degreesAngleRad_) > 0.001) ? true : false;
+
+            // Fetch (lazily building and memory-mapping on first use) the hemisphere
+            // Z-map for this ball's quantized radius.  The per-pixel sqrt in getBallZ
+            // then becomes a pure table lookup.  Returns null if the cache is disabled.
+            int quantized_radius = (int)std::round(currentBall_->measured_radius_pixels_);
+            zMapTable_ = GsProjectionCache::GetZMap(quantized_radius);
+            zMapMargin_ = GsProjectionCache::GetZMapMargin(quantized_radius);
+            zMapSide_ = GsProjectionCache::GetZMapSide(quantized_radius);
         }
 
         // The returned imageXFromCenter and imageYFromCenter are the original imageX & Y in a new coordinate system with the center of the ball at (0,0)
@@ -3798,6 +5674,19 @@ namespace golf_sim {
                 ball3dZ = 0;
                 return;
             }
+
+            // Table-driven path - the hemisphere height for each (dx, dy) offset from the
+            // ball center depends only on the ball radius, so it comes straight out of
+            // the memory-mapped projection cache when that is available
+            if (zMapTable_ != nullptr) {
+                int dx = (int)(imageXFromCenter + (imageXFromCenter >= 0 ? 0.5 : -0.5));
+                int dy = (int)(imageYFromCenter + (imageYFromCenter >= 0 ? 0.5 : -0.5));
+
+                if (std::abs(dx) <= zMapMargin_ && std::abs(dy) <= zMapMargin_) {
+                    ball3dZ = zMapTable_[(size_t)(dy + zMapMargin_) * zMapSide_ + (dx + zMapMargin_)];
+                    return;
+                }
+            }
             // Project the x,y coordinate onto the hemisphere to get the Z-axis position
             // Note that some of the image may be outside the sphere.  Ignore those
             double rSquared = pow(r, 2);
@@ -3951,6 +5840,13 @@ namespace golf_sim {
         static bool rotatingOnX_;
         static bool rotatingOnY_;
         static bool rotatingOnZ_;
+
+        // Memory-mapped hemisphere Z-map for the current (quantized) ball radius.
+        // Null if the projection-map cache is disabled or unavailable, in which case
+        // getBallZ computes the projection directly.  See GsProjectionCache.
+        static const float* zMapTable_;
+        static int zMapMargin_;
+        static int zMapSide_;
     };
 
     // Complete storage for projectionOp struct
@@ -3968,19 +5864,33 @@ namespace golf_sim {
     bool projectionOp::rotatingOnX_ = true;
     bool projectionOp::rotatingOnY_ = true;
     bool projectionOp::rotatingOnZ_ = true;
+    const float* projectionOp::zMapTable_ = nullptr;
+    int projectionOp::zMapMargin_ = 0;
+    int projectionOp::zMapSide_ = 0;
 
 
     // Positive X-axis angles rotate so that the ball appears to go from left to right
     // positive Y-axis angles move the ball from the top to the bottom
     // positive Z-Axis angles are counter-clockwise looking down the positive z-axis
     // The image_gray input Mat is expected to have pixels with only 0, 255, or kPixelIgnoreValue
-    cv::Mat BallImageProc::Project2dImageTo3dBall(const cv::Mat& image_gray, const GolfBall& ball, const cv::Vec3i& rotation_angles_degrees) {
+    cv::Mat BallImageProc::Project2dImageTo3dBall(const cv::Mat& image_gray, const GolfBall& ball, const cv::Vec3i& rotation_angles_degrees, cv::Mat* preallocated_output) {
+
+        cv::Mat projectedImg;
 
-        // Create a new 3D Mat to hold the results
-        int sizes[2] = { image_gray.rows, image_gray.cols };  // , image_gray.rows };
         // It's possible that due to rotations, some of the 3D image might have "holes" where
         // the pixel was not set to a value.  Make sure anything we don't set is ignored.
-        cv::Mat projectedImg = cv::Mat(2, sizes, CV_32SC2, cv::Scalar(0, kPixelIgnoreValue));
+        if (preallocated_output != nullptr) {
+            // The caller (e.g., the RotationCandidateArena) has already provided a
+            // correctly-sized and typed image, so just reset it to the "ignore" state
+            projectedImg = *preallocated_output;
+            projectedImg.setTo(cv::Scalar(0, kPixelIgnoreValue));
+        }
+        else {
+            // Create a new 3D Mat to hold the results
+            int sizes[2] = { image_gray.rows, image_gray.cols };  // , image_gray.rows };
+            projectedImg = cv::Mat(2, sizes, CV_32SC2, cv::Scalar(0, kPixelIgnoreValue));
+        }
+
         // TBD - hack to pass the 3D image size to the call-back function
         // Kind of a hack, because a 3D Mat won't usually have these values set.  TBD
         projectedImg.rows = image_gray.rows;
@@ -4108,6 +6018,264 @@ namespace golf_sim {
         // LoggingTools::DebugShowImage("(closed) destination_image_gray", destination_image_gray);
     }
 
+    namespace {
+
+        // Algebraic (Kasa) least-squares circle fit over points[start..end).
+        // Solves the normal equations of x^2 + y^2 + a*x + b*y + c = 0.
+        // Returns false for degenerate (e.g., collinear) point sets.
+        bool FitCircleToPoints(const std::vector<cv::Point>& points, int start, int end,
+                               double& cx, double& cy, double& radius) {
+            const int n = end - start;
+            if (n < 3) {
+                return false;
+            }
+
+            double sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0, sxz = 0, syz = 0, sz = 0;
+            for (int i = start; i < end; i++) {
+                const double x = points[i].x;
+                const double y = points[i].y;
+                const double z = x * x + y * y;
+                sx += x;  sy += y;
+                sxx += x * x;  syy += y * y;  sxy += x * y;
+                sxz += x * z;  syz += y * z;  sz += z;
+            }
+
+            cv::Matx33d A(sxx, sxy, sx,
+                          sxy, syy, sy,
+                          sx,  sy,  (double)n);
+            cv::Vec3d b(-sxz, -syz, -sz);
+            cv::Vec3d solution;
+            if (!cv::solve(A, b, solution, cv::DECOMP_LU)) {
+                return false;
+            }
+
+            cx = -solution[0] / 2.0;
+            cy = -solution[1] / 2.0;
+            const double radius_squared = cx * cx + cy * cy - solution[2];
+            if (radius_squared <= 0.0) {
+                return false;
+            }
+            radius = std::sqrt(radius_squared);
+            return true;
+        }
+
+        // Mean absolute radial deviation of points[start..end) from the circle
+        double MeanRadialFitError(const std::vector<cv::Point>& points, int start, int end,
+                                  double cx, double cy, double radius) {
+            double error_sum = 0.0;
+            for (int i = start; i < end; i++) {
+                const double dx = points[i].x - cx;
+                const double dy = points[i].y - cy;
+                error_sum += std::abs(std::sqrt(dx * dx + dy * dy) - radius);
+            }
+            return error_sum / (double)(end - start);
+        }
+
+        // A circle candidate assembled from one or more agreeing edge arcs
+        struct EdgeDrawingCircleCandidate {
+            double cx = 0;
+            double cy = 0;
+            double radius = 0;
+            double coverage_degrees = 0;
+            // 10-degree angular histogram bins covered by the member arcs -
+            // disjoint arcs of the same circle add up, overlapping ones do not
+            std::array<bool, 36> covered_bins{};
+            std::vector<cv::Point> points;
+        };
+
+        void MarkCoveredBins(EdgeDrawingCircleCandidate& candidate,
+                             const std::vector<cv::Point>& points, int start, int end) {
+            for (int i = start; i < end; i++) {
+                const double angle = std::atan2(points[i].y - candidate.cy,
+                                                points[i].x - candidate.cx);
+                int bin = (int)((angle + CV_PI) / (2.0 * CV_PI) * 36.0);
+                bin = std::min(35, std::max(0, bin));
+                candidate.covered_bins[bin] = true;
+            }
+        }
+
+    }  // namespace
+
+    bool BallImageProc::EdgeDrawingEnabledForMode(BallSearchMode search_mode) {
+        if (kEdgeDrawingCircleDetectionModes.empty()) {
+            return false;
+        }
+
+        std::string mode_name;
+        switch (search_mode) {
+            case kFindPlacedBall:    mode_name = "placed";             break;
+            case kStrobed:           mode_name = "strobed";            break;
+            case kExternallyStrobed: mode_name = "externally_strobed"; break;
+            case kPutting:           mode_name = "putting";            break;
+            default:                 return false;
+        }
+
+        // Match against the comma-separated mode list, e.g. "placed,putting"
+        const std::string padded_list = "," + kEdgeDrawingCircleDetectionModes + ",";
+        return padded_list.find("," + mode_name + ",") != std::string::npos;
+    }
+
+    bool BallImageProc::DetectBallsEdgeDrawing(const cv::Mat& preprocessed_img,
+                                               double min_radius, double max_radius,
+                                               std::vector<GsCircle>& detected_circles) {
+        auto detection_start = std::chrono::high_resolution_clock::now();
+
+        detected_circles.clear();
+
+        cv::Mat gray_image;
+        if (preprocessed_img.channels() != 1) {
+            cv::cvtColor(preprocessed_img, gray_image, cv::COLOR_BGR2GRAY);
+        }
+        else {
+            gray_image = preprocessed_img;
+        }
+
+        // EDPF is parameter free - the edge segments come out the same however
+        // faint or strong the ball's rim is, with no threshold to walk
+        std::vector<std::vector<cv::Point>> segments;
+        if (kReuseEdgeDetectorBuffers) {
+            reusable_edpf_.Process(gray_image);
+            segments = reusable_edpf_.getSegments();
+        }
+        else {
+            EDPF edpf(gray_image);
+            segments = edpf.getSegments();
+        }
+
+        // Stage 1 - carve each edge segment into circular arcs.  A segment that
+        // does not fit a single circle well is split in half and each half is
+        // retried, down to a minimum arc length.  That cheaply separates the
+        // ball's rim from whatever else its edge chain happens to run into.
+        struct Arc {
+            const std::vector<cv::Point>* segment;
+            int start;
+            int end;
+            double cx, cy, radius;
+        };
+        std::vector<Arc> arcs;
+
+        const int min_arc_points = std::max(10, (int)std::round(0.5 * min_radius));
+
+        for (const auto& segment : segments) {
+            std::vector<std::pair<int, int>> pending_ranges;
+            pending_ranges.emplace_back(0, (int)segment.size());
+
+            while (!pending_ranges.empty()) {
+                const auto [range_start, range_end] = pending_ranges.back();
+                pending_ranges.pop_back();
+
+                const int range_length = range_end - range_start;
+                if (range_length < min_arc_points) {
+                    continue;
+                }
+
+                double cx, cy, radius;
+                const bool fit_ok = FitCircleToPoints(segment, range_start, range_end, cx, cy, radius);
+
+                // Allow some slack around the caller's radius range at the arc
+                // stage - the merged, refitted circle is filtered strictly below
+                if (fit_ok &&
+                    radius >= 0.8 * min_radius && radius <= 1.25 * max_radius &&
+                    MeanRadialFitError(segment, range_start, range_end, cx, cy, radius) <= kEdgeDrawingCircleFitErrorPixels) {
+                    arcs.push_back(Arc{ &segment, range_start, range_end, cx, cy, radius });
+                }
+                else if (range_length >= 2 * min_arc_points) {
+                    const int range_mid = range_start + range_length / 2;
+                    pending_ranges.emplace_back(range_start, range_mid);
+                    pending_ranges.emplace_back(range_mid, range_end);
+                }
+            }
+        }
+
+        if (arcs.empty()) {
+            return false;
+        }
+
+        // Stage 2 - group arcs that describe the same circle and refit each
+        // group over all of its points together
+        std::vector<EdgeDrawingCircleCandidate> candidates;
+
+        for (const auto& arc : arcs) {
+            EdgeDrawingCircleCandidate* group = nullptr;
+            for (auto& candidate : candidates) {
+                const double center_tolerance = std::max(3.0, 0.15 * candidate.radius);
+                const double dx = arc.cx - candidate.cx;
+                const double dy = arc.cy - candidate.cy;
+                if (std::sqrt(dx * dx + dy * dy) <= center_tolerance &&
+                    std::abs(arc.radius - candidate.radius) <= center_tolerance) {
+                    group = &candidate;
+                    break;
+                }
+            }
+
+            if (group == nullptr) {
+                candidates.emplace_back();
+                group = &candidates.back();
+                group->cx = arc.cx;
+                group->cy = arc.cy;
+                group->radius = arc.radius;
+            }
+
+            group->points.insert(group->points.end(),
+                                 arc.segment->begin() + arc.start,
+                                 arc.segment->begin() + arc.end);
+        }
+
+        // Stage 3 - refit, measure angular coverage, filter, and rank
+        std::vector<std::pair<double, GsCircle>> ranked;
+        for (auto& candidate : candidates) {
+            if (!FitCircleToPoints(candidate.points, 0, (int)candidate.points.size(),
+                                   candidate.cx, candidate.cy, candidate.radius)) {
+                continue;
+            }
+
+            if (candidate.radius < min_radius || candidate.radius > max_radius) {
+                continue;
+            }
+
+            if (MeanRadialFitError(candidate.points, 0, (int)candidate.points.size(),
+                                   candidate.cx, candidate.cy, candidate.radius) > kEdgeDrawingCircleFitErrorPixels) {
+                continue;
+            }
+
+            MarkCoveredBins(candidate, candidate.points, 0, (int)candidate.points.size());
+            int bins_covered = 0;
+            for (const bool covered : candidate.covered_bins) {
+                if (covered) {
+                    bins_covered++;
+                }
+            }
+            candidate.coverage_degrees = bins_covered * 10.0;
+
+            if (candidate.coverage_degrees < kEdgeDrawingMinArcCoverageDegrees) {
+                continue;
+            }
+
+            ranked.emplace_back(candidate.coverage_degrees,
+                                GsCircle{ (float)candidate.cx,
+                                          (float)candidate.cy,
+                                          (float)candidate.radius });
+        }
+
+        // Strongest (best-covered) circles first, mirroring the vote ordering
+        // the Hough path returns
+        std::stable_sort(ranked.begin(), ranked.end(),
+                         [](const auto& a, const auto& b) { return a.first > b.first; });
+        detected_circles.reserve(ranked.size());
+        for (const auto& entry : ranked) {
+            detected_circles.push_back(entry.second);
+        }
+
+        auto detection_end = std::chrono::high_resolution_clock::now();
+        auto detection_duration = std::chrono::duration_cast<std::chrono::milliseconds>(detection_end - detection_start);
+
+        GS_LOG_TRACE_MSG(trace, "Edge-drawing circle engine found " + std::to_string(detected_circles.size()) +
+                       " circle(s) from " + std::to_string(arcs.size()) + " arc(s) in " +
+                       std::to_string(detection_duration.count()) + "ms");
+
+        return !detected_circles.empty();
+    }
+
     /**
      * Detection Algorithm Dispatcher
      * Routes detection to HoughCircles or ONNX based on kDetectionMethod configuration
@@ -4148,62 +6316,133 @@ namespace golf_sim {
                                                    float nms_threshold) {
         
         std::vector<int> indices;
-        
+
+        // Radius-consistency pre-filter:  A golf ball's box half-size should land
+        // within a (generous) factor of the expected ball radius, so obviously-wrong
+        // boxes never enter the quadratic suppression stage.  In externally-strobed
+        // mode we can see hundreds of raw detections per frame.
+        const double expected_radius = GolfSimCamera::kExpectedBallRadiusPixelsAt40cm;
+        const double radius_filter_ratio = (double)kONNXNMSRadiusPreFilterRatio;
+        const bool apply_radius_filter = (radius_filter_ratio > 0.0 && expected_radius > 0.0);
+
+        int radius_filtered = 0;
+
         std::vector<std::pair<float, int>> confidence_index_pairs;
         confidence_index_pairs.reserve(boxes.size());
-        
+
         for (size_t i = 0; i < confidences.size(); ++i) {
-            if (confidences[i] >= conf_threshold) {
-                confidence_index_pairs.emplace_back(confidences[i], static_cast<int>(i));
+            if (confidences[i] < conf_threshold) {
+                continue;
+            }
+
+            if (apply_radius_filter) {
+                double half_size = (boxes[i].width + boxes[i].height) / 4.0;
+                if (half_size < expected_radius / radius_filter_ratio ||
+                    half_size > expected_radius * radius_filter_ratio) {
+                    radius_filtered++;
+                    continue;
+                }
             }
+
+            confidence_index_pairs.emplace_back(confidences[i], static_cast<int>(i));
         }
-        
+
         if (confidence_index_pairs.empty()) {
             return indices;
         }
-        
+
         std::sort(confidence_index_pairs.begin(), confidence_index_pairs.end(),
                  [](const auto& a, const auto& b) { return a.first > b.first; });
-        
-        std::vector<bool> suppressed(confidence_index_pairs.size(), false);
-        
-        for (size_t i = 0; i < confidence_index_pairs.size(); ++i) {
-            if (suppressed[i]) continue;
-            
-            int idx_i = confidence_index_pairs[i].second;
-            indices.push_back(idx_i);
-            const cv::Rect& box_i = boxes[idx_i];
-            
-            for (size_t j = i + 1; j < confidence_index_pairs.size(); ++j) {
+
+        // Convert the surviving boxes (in descending-confidence order) into
+        // structure-of-arrays form so that the IoU inner loop can run over
+        // four box pairs at a time.
+        const size_t num_candidates = confidence_index_pairs.size();
+        std::vector<float> box_x1(num_candidates);
+        std::vector<float> box_y1(num_candidates);
+        std::vector<float> box_x2(num_candidates);
+        std::vector<float> box_y2(num_candidates);
+        std::vector<float> box_area(num_candidates);
+
+        for (size_t i = 0; i < num_candidates; ++i) {
+            const cv::Rect& box = boxes[confidence_index_pairs[i].second];
+            box_x1[i] = (float)box.x;
+            box_y1[i] = (float)box.y;
+            box_x2[i] = (float)(box.x + box.width);
+            box_y2[i] = (float)(box.y + box.height);
+            box_area[i] = (float)(box.width * box.height);
+        }
+
+        std::vector<uint8_t> suppressed(num_candidates, 0);
+
+        // Scalar IoU check for the vector-width tail (and non-NEON builds)
+        auto SuppressScalar = [&](size_t i, size_t j_start, size_t j_end) {
+            for (size_t j = j_start; j < j_end; ++j) {
                 if (suppressed[j]) continue;
-                
-                int idx_j = confidence_index_pairs[j].second;
-                const cv::Rect& box_j = boxes[idx_j];
-                
-                int x1 = std::max(box_i.x, box_j.x);
-                int y1 = std::max(box_i.y, box_j.y);
-                int x2 = std::min(box_i.x + box_i.width, box_j.x + box_j.width);
-                int y2 = std::min(box_i.y + box_i.height, box_j.y + box_j.height);
-                
-                int intersection_width = std::max(0, x2 - x1);
-                int intersection_height = std::max(0, y2 - y1);
-                float intersection_area = static_cast<float>(intersection_width * intersection_height);
-                
-                float box_i_area = static_cast<float>(box_i.width * box_i.height);
-                float box_j_area = static_cast<float>(box_j.width * box_j.height);
-                float union_area = box_i_area + box_j_area - intersection_area;
-                
-                float iou = (union_area > 0) ? (intersection_area / union_area) : 0.0f;
-                
-                if (iou > nms_threshold) {
-                    suppressed[j] = true;
+
+                float x1 = std::max(box_x1[i], box_x1[j]);
+                float y1 = std::max(box_y1[i], box_y1[j]);
+                float x2 = std::min(box_x2[i], box_x2[j]);
+                float y2 = std::min(box_y2[i], box_y2[j]);
+
+                float intersection_area = std::max(0.0f, x2 - x1) * std::max(0.0f, y2 - y1);
+                float union_area = box_area[i] + box_area[j] - intersection_area;
+
+                // iou > threshold, rewritten division-free
+                if (intersection_area > nms_threshold * union_area && union_area > 0) {
+                    suppressed[j] = 1;
+                }
+            }
+        };
+
+        for (size_t i = 0; i < num_candidates; ++i) {
+            if (suppressed[i]) continue;
+
+            indices.push_back(confidence_index_pairs[i].second);
+
+#if defined(__aarch64__)
+            const float32x4_t keeper_x1 = vdupq_n_f32(box_x1[i]);
+            const float32x4_t keeper_y1 = vdupq_n_f32(box_y1[i]);
+            const float32x4_t keeper_x2 = vdupq_n_f32(box_x2[i]);
+            const float32x4_t keeper_y2 = vdupq_n_f32(box_y2[i]);
+            const float32x4_t keeper_area = vdupq_n_f32(box_area[i]);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const float32x4_t threshold = vdupq_n_f32(nms_threshold);
+
+            size_t j = i + 1;
+            for (; j + 4 <= num_candidates; j += 4) {
+                float32x4_t x1 = vmaxq_f32(keeper_x1, vld1q_f32(&box_x1[j]));
+                float32x4_t y1 = vmaxq_f32(keeper_y1, vld1q_f32(&box_y1[j]));
+                float32x4_t x2 = vminq_f32(keeper_x2, vld1q_f32(&box_x2[j]));
+                float32x4_t y2 = vminq_f32(keeper_y2, vld1q_f32(&box_y2[j]));
+
+                float32x4_t intersection = vmulq_f32(vmaxq_f32(zero, vsubq_f32(x2, x1)),
+                                                     vmaxq_f32(zero, vsubq_f32(y2, y1)));
+                float32x4_t union_area = vsubq_f32(vaddq_f32(keeper_area, vld1q_f32(&box_area[j])),
+                                                   intersection);
+
+                // Branch-free equivalent of iou > threshold for all four lanes
+                uint32x4_t over_threshold = vandq_u32(
+                    vcgtq_f32(intersection, vmulq_f32(threshold, union_area)),
+                    vcgtq_f32(union_area, zero));
+
+                uint32_t lanes[4];
+                vst1q_u32(lanes, over_threshold);
+                for (int lane = 0; lane < 4; lane++) {
+                    suppressed[j + lane] |= (uint8_t)(lanes[lane] & 1);
                 }
             }
+
+            SuppressScalar(i, j, num_candidates);
+#else
+            SuppressScalar(i, i + 1, num_candidates);
+#endif
         }
-        
-        GS_LOG_TRACE_MSG(trace, "SingleClassNMS: " + std::to_string(boxes.size()) + 
-                        " boxes -> " + std::to_string(indices.size()) + " after NMS");
-        
+
+        GS_LOG_TRACE_MSG(trace, "SingleClassNMS: " + std::to_string(boxes.size()) +
+                        " boxes -> " + std::to_string(indices.size()) + " after NMS (" +
+                        std::to_string(radius_filtered) + " removed by radius pre-filter)");
+
         return indices;
     }
     
@@ -4268,6 +6507,19 @@ namespace golf_sim {
                                        std::vector<GsCircle>& detected_circles) {
         GS_LOG_TRACE_MSG(trace, "BallImageProc::DetectBallsONNX - Dispatching to backend: " + kONNXBackend);
 
+        // Two-tier cascade for ball watching: when a micro gate model is
+        // configured, it looks at the frame first and the full-size pass (and
+        // its OpenCV DNN fallback) only runs when the gate sees a ball.  At
+        // kONNXGateInputSize the gate is an order of magnitude cheaper than
+        // the full model, which is what keeps the FSM's continuous placed-ball
+        // polling affordable on frames where nothing is there yet.
+        if (search_mode == BallSearchMode::kFindPlacedBall && !kONNXGateModelPath.empty()) {
+            if (!BallPresenceGatePasses(preprocessed_img)) {
+                detected_circles.clear();
+                return false;
+            }
+        }
+
         // Dual-Backend Dispatcher: Try ONNX Runtime first, fallback to OpenCV DNN if needed
         if (kONNXBackend == "onnxruntime") {
             if (DetectBallsONNXRuntime(preprocessed_img, search_mode, detected_circles)) {
@@ -4284,6 +6536,83 @@ namespace golf_sim {
         }
     }
 
+    bool BallImageProc::BallPresenceGatePasses(const cv::Mat& preprocessed_img) {
+
+        // If the gate model could not be loaded, fail open so that detection
+        // behaves exactly as it does with no cascade configured
+        if (onnx_gate_detector_failed_.load(std::memory_order_relaxed)) {
+            return true;
+        }
+
+        // Same double-checked locking pattern as the full-size detector
+        if (!onnx_gate_detector_initialized_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(onnx_detector_mutex_);
+            if (!onnx_gate_detector_initialized_.load(std::memory_order_relaxed)) {
+
+                // Another thread may have already tried and failed while we
+                // were waiting on the lock
+                if (onnx_gate_detector_failed_.load(std::memory_order_relaxed)) {
+                    return true;
+                }
+
+                ONNXRuntimeDetector::Config config;
+                config.model_path = kONNXGateModelPath;
+                config.confidence_threshold = kONNXGateConfidenceThreshold;
+                config.nms_threshold = kONNXNMSThreshold;
+                config.input_width = kONNXGateInputSize;
+                config.input_height = kONNXGateInputSize;
+
+                // The gate has to stay cheap - a single thread without a
+                // memory pool is plenty at this input size, and the
+                // optimized-model cache helps its startup just like the
+                // full model's
+                config.num_threads = 1;
+                config.use_thread_affinity = false;
+                config.use_memory_pool = false;
+                config.use_optimized_model_cache = kONNXUseOptimizedModelCache;
+
+                GS_LOG_MSG(info, "Initializing ball-presence gate model: " + config.model_path);
+                onnx_gate_detector_ = std::make_unique<ONNXRuntimeDetector>(config);
+
+                if (!onnx_gate_detector_->Initialize()) {
+                    GS_LOG_MSG(warning, "Failed to initialize ball-presence gate model " + config.model_path +
+                                   " - placed-ball detection will run the full-size model on every frame");
+                    onnx_gate_detector_.reset();
+                    onnx_gate_detector_failed_.store(true, std::memory_order_release);
+                    return true;
+                }
+
+                onnx_gate_detector_initialized_.store(true, std::memory_order_release);
+            }
+        }
+
+        try {
+            // Convert to RGB if needed (minimal overhead)
+            cv::Mat input_image;
+            if (preprocessed_img.channels() == 1) {
+                cv::cvtColor(preprocessed_img, input_image, cv::COLOR_GRAY2RGB);
+            } else {
+                input_image = preprocessed_img;  // Use directly (no copy)
+            }
+
+            std::vector<ONNXRuntimeDetector::Detection> detections = onnx_gate_detector_->Detect(input_image);
+
+            if (detections.empty()) {
+                GS_LOG_TRACE_MSG(trace, "Ball-presence gate negative - skipping full-size detection pass");
+                return false;
+            }
+
+            GS_LOG_TRACE_MSG(trace, "Ball-presence gate positive (" + std::to_string(detections.size()) +
+                           " candidate(s)) - running full-size detection pass");
+            return true;
+
+        } catch (const std::exception& e) {
+            // Fail open on any inference error - the full-size pass is the authority
+            GS_LOG_MSG(warning, "Ball-presence gate inference failed: " + std::string(e.what()));
+            return true;
+        }
+    }
+
     bool BallImageProc::DetectBallsONNXRuntime(const cv::Mat& preprocessed_img, BallSearchMode search_mode,
                                               std::vector<GsCircle>& detected_circles) {
         auto detection_start = std::chrono::high_resolution_clock::now();
@@ -4303,6 +6632,17 @@ namespace golf_sim {
                     config.input_height = kONNXInputSize;
                     config.num_threads = kONNXRuntimeThreads;
 
+                    // INT8 quantization (optional - roughly doubles throughput on Pi CPUs)
+                    config.use_int8_quantization = kONNXUseInt8Quantization;
+                    config.int8_model_path = kONNXInt8ModelPath;
+                    config.calibration_image_dir = kONNXCalibrationImageDir;
+
+                    // FP16 (optional - close to 2x FP32 throughput on Cortex-A76)
+                    config.use_fp16 = kONNXUseFp16;
+                    config.fp16_model_path = kONNXFp16ModelPath;
+
+                    config.use_optimized_model_cache = kONNXUseOptimizedModelCache;
+
                     // Pi-optimized settings
                     config.use_arm_compute_library = true;
                     config.use_thread_affinity = true;
@@ -4310,6 +6650,12 @@ namespace golf_sim {
                     config.use_neon_preprocessing = true;
                     config.use_zero_copy = true;
 
+                    // Keep inference off the dedicated trigger core when the latency-critical
+                    // trigger mode is in use
+                    if (PulseStrobe::kUseRealtimeTriggerThread && config.cpu_cores.size() > 1) {
+                        std::erase(config.cpu_cores, PulseStrobe::kRealtimeTriggerCpuCore);
+                    }
+
                     GS_LOG_MSG(info, "Attempting to initialize ONNX Runtime detector with model: " + config.model_path);
                     onnx_detector_ = std::make_unique<ONNXRuntimeDetector>(config);
 
@@ -4347,9 +6693,15 @@ namespace golf_sim {
                     }
                 }
 
-                // Process all slices in batch for efficiency
+                // Process all slices as one batched tensor in a single session Run
+                ONNXRuntimeDetector::PerformanceMetrics batch_metrics;
                 std::vector<std::vector<ONNXRuntimeDetector::Detection>> batch_detections =
-                    onnx_detector_->DetectBatch(slices);
+                    onnx_detector_->DetectBatch(slices, &batch_metrics);
+
+                GS_LOG_TRACE_MSG(trace, "DetectBatch processed " + std::to_string(slices.size()) +
+                               " slices - preproc: " + std::to_string(batch_metrics.preprocessing_ms) +
+                               "ms, inference: " + std::to_string(batch_metrics.inference_ms) +
+                               "ms, postproc: " + std::to_string(batch_metrics.postprocessing_ms) + "ms");
 
                 // Convert and merge all detections
                 detected_circles.clear();
@@ -4609,6 +6961,17 @@ namespace golf_sim {
             config.input_height = kONNXInputSize;
             config.num_threads = kONNXRuntimeThreads;
 
+            // INT8 quantization (optional - roughly doubles throughput on Pi CPUs)
+            config.use_int8_quantization = kONNXUseInt8Quantization;
+            config.int8_model_path = kONNXInt8ModelPath;
+            config.calibration_image_dir = kONNXCalibrationImageDir;
+
+            // FP16 (optional - close to 2x FP32 throughput on Cortex-A76)
+            config.use_fp16 = kONNXUseFp16;
+            config.fp16_model_path = kONNXFp16ModelPath;
+
+            config.use_optimized_model_cache = kONNXUseOptimizedModelCache;
+
             // Pi-optimized settings
             config.use_arm_compute_library = true;
             config.use_thread_affinity = true;
@@ -4616,6 +6979,12 @@ namespace golf_sim {
             config.use_neon_preprocessing = true;
             config.use_zero_copy = true;
 
+            // Keep inference off the dedicated trigger core when the latency-critical
+            // trigger mode is in use
+            if (PulseStrobe::kUseRealtimeTriggerThread && config.cpu_cores.size() > 1) {
+                std::erase(config.cpu_cores, PulseStrobe::kRealtimeTriggerCpuCore);
+            }
+
             onnx_detector_ = std::make_unique<ONNXRuntimeDetector>(config);
 
             if (!onnx_detector_->Initialize()) {
@@ -4638,6 +7007,65 @@ namespace golf_sim {
         }
     }
 
+    void BallImageProc::PrewarmDetectorAtStartup() {
+
+        // Nothing to pre-warm if neither the in-flight nor the placement
+        // detection uses an experimental (model-based) detector
+        if (kDetectionMethod != "experimental" && kDetectionMethod != "experimental_sahi" &&
+            kBallPlacementDetectionMethod != "experimental") {
+            GS_LOG_TRACE_MSG(trace, "PrewarmDetectorAtStartup - no experimental detection method configured, skipping.");
+            return;
+        }
+
+        GS_LOG_MSG(info, "Pre-warming ball detector at startup so that the first shot does not pay for session creation...");
+
+        if (kONNXBackend == "onnxruntime") {
+            if (!PreloadONNXRuntimeModel()) {
+                GS_LOG_MSG(warning, "Failed to pre-warm ONNX Runtime detector at startup");
+                if (kONNXRuntimeAutoFallback) {
+                    GS_LOG_MSG(info, "Auto-fallback enabled, attempting to preload OpenCV DNN model...");
+                    if (!PreloadYOLOModel()) {
+                        GS_LOG_MSG(warning, "Failed to preload both ONNX Runtime and OpenCV DNN models");
+                    }
+                }
+                return;
+            }
+
+            // The session's Initialize() already ran its own warm-up inferences, but
+            // push one dummy frame through BallImageProc's detection path as well so
+            // that the conversion/NMS code is paged in and any lazy XNNPACK kernel
+            // compilation happens now instead of on the first real shot.
+            try {
+                auto warmup_start = std::chrono::high_resolution_clock::now();
+
+                cv::Mat dummy_image = cv::Mat::zeros(kONNXInputSize, kONNXInputSize, CV_8UC3);
+                std::vector<GsCircle> dummy_circles;
+                (void)DetectBallsONNXRuntime(dummy_image, BallSearchMode::kStrobed, dummy_circles);
+
+                auto warmup_end = std::chrono::high_resolution_clock::now();
+                auto warmup_duration = std::chrono::duration_cast<std::chrono::milliseconds>(warmup_end - warmup_start);
+                GS_LOG_MSG(info, "Detector pre-warm dummy inference completed in " +
+                               std::to_string(warmup_duration.count()) + "ms");
+            }
+            catch (const std::exception& e) {
+                GS_LOG_MSG(warning, "Detector pre-warm dummy inference failed: " + std::string(e.what()));
+            }
+
+            // Also warm the placed-ball cascade's gate model, if one is
+            // configured, so that the first watcher frame does not pay for
+            // its session creation either
+            if (kBallPlacementDetectionMethod == "experimental" && !kONNXGateModelPath.empty()) {
+                cv::Mat dummy_gate_image = cv::Mat::zeros(kONNXGateInputSize, kONNXGateInputSize, CV_8UC3);
+                (void)BallPresenceGatePasses(dummy_gate_image);
+            }
+        }
+        else {
+            if (!PreloadYOLOModel()) {
+                GS_LOG_MSG(warning, "Failed to pre-warm OpenCV DNN model at startup - will load on first detection");
+            }
+        }
+    }
+
     void BallImageProc::CleanupONNXRuntime() {
         std::lock_guard<std::mutex> lock(onnx_detector_mutex_);
         if (onnx_detector_initialized_.load(std::memory_order_relaxed)) {
@@ -4648,6 +7076,10 @@ namespace golf_sim {
 
             GS_LOG_MSG(info, "ONNX Runtime detector cleanup completed");
         }
+        if (onnx_gate_detector_initialized_.load(std::memory_order_relaxed)) {
+            onnx_gate_detector_.reset();
+            onnx_gate_detector_initialized_.store(false, std::memory_order_release);
+        }
     }
 
     void BallImageProc::LoadConfigurationValues() {
@@ -4666,6 +7098,16 @@ namespace golf_sim {
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXBackend", kONNXBackend);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXRuntimeAutoFallback", kONNXRuntimeAutoFallback);
         GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXRuntimeThreads", kONNXRuntimeThreads);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXNMSRadiusPreFilterRatio", kONNXNMSRadiusPreFilterRatio);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXUseInt8Quantization", kONNXUseInt8Quantization);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXUseFp16", kONNXUseFp16);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXFp16ModelPath", kONNXFp16ModelPath);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXUseOptimizedModelCache", kONNXUseOptimizedModelCache);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXInt8ModelPath", kONNXInt8ModelPath);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXCalibrationImageDir", kONNXCalibrationImageDir);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXGateModelPath", kONNXGateModelPath);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXGateInputSize", kONNXGateInputSize);
+        GolfSimConfiguration::SetConstant("gs_config.ball_identification.kONNXGateConfidenceThreshold", kONNXGateConfidenceThreshold);
 
         GS_LOG_MSG(info, "Loaded ONNX Model Path: " + kONNXModelPath);
         GS_LOG_MSG(info, "Loaded Detection Method: " + kDetectionMethod);
@@ -13,6 +13,8 @@
 #include <filesystem>
 #include <mutex>
 #include <atomic>
+#include <cstdint>
+#include <vector>
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -27,6 +29,7 @@
 #include "colorsys.h"
 #include "golf_ball.h"
 #include "onnx_runtime_detector.hpp"
+#include "EDPF.h"
 
 
 namespace golf_sim {
@@ -35,10 +38,39 @@ namespace golf_sim {
 // the comparison should not be performed on the particular pixel
 const uchar kPixelIgnoreValue = 128;
 
+// Bit-packed (1-bit-per-pixel) representation of a dimple-edge image.  The dimple
+// images are effectively binary (0 or 255) after the edge filtering, with a third
+// "ignore" state, so each pixel packs into one value bit plus one validity bit.
+// Each 64-bit word then compares 64 pixels at a time via popcount, and the packed
+// candidate working set is ~8x smaller than the unpacked one.
+struct PackedDimpleImage {
+    int rows = 0;
+    int cols = 0;
+    int words_per_row = 0;
+    std::vector<uint64_t> value_bits;   // 1 = edge pixel is "on" (255)
+    std::vector<uint64_t> valid_bits;   // 1 = pixel participates (i.e., is not the ignore value)
+
+    bool IsEmpty() const { return valid_bits.empty(); }
+};
+
+// One visible-hemisphere point of the base dimple image, lifted to 3D.  A vector
+// of these (see BuildBallPointCloud) caches the expensive part of the candidate
+// projection - the per-pixel hemisphere geometry - so that each candidate rotation
+// only has to apply a rotation matrix to the cached points.
+struct BallPointCloudPoint {
+    float x_from_center = 0.0F;
+    float y_from_center = 0.0F;
+    float z = 0.0F;
+    uchar value = 0;
+};
+
 // Holds one potential rotated golf ball candidate image and associated data
 struct RotationCandidate {
     short index = 0;
     cv::Mat img;
+
+    // Only populated when kUseBitPackedSpinImages is enabled
+    PackedDimpleImage packed_img;
     int x_rotation_degrees = 0; // All Rotations are in degrees
     int y_rotation_degrees = 0;
     int z_rotation_degrees = 0;
@@ -47,6 +79,70 @@ struct RotationCandidate {
     double score = 0;
 };
 
+// Carves all of the (same-sized) candidate images for one shot out of a single
+// contiguous preallocated block.  Generating thousands of candidates then no longer
+// performs thousands of separate heap allocations and frees, and the candidate set
+// stays cache-contiguous for the comparison pass.
+class RotationCandidateArena {
+public:
+    // Prepares the arena to hand out num_candidates images of the given dimensions
+    // and type.  The underlying block is only re-allocated if it is not already
+    // large enough, so the arena can be reused across, e.g., the coarse and fine
+    // passes of a shot (and across shots).
+    void Reset(int num_candidates, int rows, int cols, int type);
+
+    // Returns a cv::Mat header referencing the next free slot in the arena.
+    // No pixel data is copied and no per-image heap allocation is performed.
+    // The returned image contents are uninitialized.
+    cv::Mat AllocateImage();
+
+private:
+    cv::Mat block_;             // One contiguous allocation holding every candidate image
+    size_t slot_size_bytes_ = 0;
+    int rows_ = 0;
+    int cols_ = 0;
+    int type_ = 0;
+    int next_slot_ = 0;
+    int num_slots_ = 0;
+};
+
+// Per-candidate preprocessing products shared between the final refinement
+// stages (DetermineBestCircle and FindBestEllipseFornaciari).  Both stages
+// crop a sub-image around the same candidate circle and then filter it, so
+// without this view each stage re-derives its own crop (and, historically,
+// a full-frame clone) from the raw gray image.  The producing stage records
+// each product together with the parameters that generated it; a consuming
+// stage only reuses a product whose recorded parameters match its own, and
+// falls back to recomputing from gray_sub_image (or the full image) when
+// they do not.
+struct PreprocessedView {
+    // The raw (unfiltered) gray crop and its placement within the full
+    // image.  This is the one product every stage can reuse, because it is
+    // captured before any stage-specific filtering.
+    cv::Mat gray_sub_image;
+    cv::Rect roi_in_full_image;
+    cv::Point offset_sub_to_full;
+    cv::Point offset_full_to_sub;
+
+    // Gaussian-blurred version of gray_sub_image, along with the kernel
+    // size that produced it (0 = not computed).
+    cv::Mat blurred_sub_image;
+    int blur_kernel_size = 0;
+
+    // Canny edge map of blurred_sub_image, along with the thresholds that
+    // produced it (only meaningful when the Mat is non-empty).
+    cv::Mat edge_sub_image;
+    double canny_lower = 0.0;
+    double canny_upper = 0.0;
+
+    // True if the raw gray crop exists and completely contains the given
+    // full-image-coordinate ROI, so a consumer can crop from this view
+    // instead of from the full image.
+    bool GrayCropCovers(const cv::Rect& roi) const {
+        return !gray_sub_image.empty() && (roi_in_full_image & roi) == roi;
+    }
+};
+
 class BallImageProc
 {
 public:
@@ -64,6 +160,55 @@ public:
     static int kCoarseZRotationDegreesStart;
     static int kCoarseZRotationDegreesEnd;
 
+    // If true, GetBallRotation measures how much dimple-edge signal the two
+    // filtered exposures actually contain before sweeping the rotation grids.
+    // When either exposure's edge density falls below
+    // kSpinWeakSignalEdgeDensity, the coarse grid is swept at half the range
+    // and twice the increment (and the fine grid at twice the increment) -
+    // weak exposures produce low-confidence spin numbers at any resolution,
+    // so the full-resolution sweep is reserved for data that can pay for it.
+    static bool kUseAdaptiveSpinSearchResolution;
+    static double kSpinWeakSignalEdgeDensity;
+
+    // If true (and the processor supports it), the vectorized NEON pixel-comparison
+    // kernel will be used to score the spin rotation candidates
+    static bool kUseNEONSpinKernel;
+
+    // If true, GetBallRotation will converge on the best rotation using the iterative
+    // pattern search instead of exhaustively sweeping the coarse and fine grids
+    static bool kUseIterativeSpinSearch;
+    static int kSpinIterativeMaxEvaluations;
+    static int kSpinIterativeInitialStepDegrees;
+
+    // Branch-and-bound pruning for the candidate comparison pass.  Candidates are
+    // first scored on a subsampled pixel grid and only the best-scoring fraction is
+    // scored at full resolution (with an early abort once a candidate provably
+    // cannot beat the best full-resolution score seen so far).
+    static bool kUseSpinCandidatePruning;
+    static double kSpinPruningKeepFraction;
+    static int kSpinPruningSubsampleStride;
+
+    // If true, the candidate and target dimple images are bit-packed and scored
+    // with the 64-pixels-per-word popcount comparer.  Takes precedence over the
+    // candidate-pruning engine when both are enabled.
+    static bool kUseBitPackedSpinImages;
+
+    // If true, the per-candidate spin scores are exported to the
+    // spin_analysis_coarse/fine.csv files for offline analysis
+    static bool kWriteSpinAnalysisCsvFiles;
+
+    // If true, candidate generation and scoring are fused into one multi-core pass -
+    // each worker projects a candidate into its own scratch buffer, scores it
+    // immediately, and recycles the buffer.  Peak memory then holds only the
+    // cores-in-flight candidate images instead of the entire candidate set.
+    static bool kUseFusedSpinPipeline;
+    static int kSpinPipelineThreads;
+
+    // If true, the base dimple image is lifted to a 3D point cloud once per search
+    // and each candidate rotation is produced by rotating the cached points, instead
+    // of re-deriving the hemisphere geometry from the 2D image for every candidate
+    static bool kUseCachedPointCloudProjection;
+
     static double kPlacedBallCannyLower;
     static double kPlacedBallCannyUpper;
     static double kPlacedBallStartingParam2;
@@ -106,6 +251,37 @@ public:
     static int kCLAHEClipLimit;
     static int kCLAHETilesGridSize;
 
+    // If set, strobed preprocessing replaces CLAHE with an integral-image
+    // local contrast normalization: a box-filtered local mean and variance
+    // (whose cost is independent of the window size) followed by a per-pixel
+    // (x - mean) / sigma remap around mid-grey, NEON-vectorized via the
+    // per-CPU-tuned kernels.  Comparable dimple/edge visibility for the
+    // Canny stage at a fraction of CLAHE's tile-histogram cost.  The gain
+    // is in grey levels per local standard deviation; the window size must
+    // be odd (forced up by one if not).
+    static bool kUseFastLocalContrast;
+    static int kFastLocalContrastWindowSize;
+    static double kFastLocalContrastGain;
+
+    // If set, the EDPF edge detector is retained on the BallImageProc
+    // instance (see reusable_edpf_) instead of being re-constructed - and
+    // re-allocating all of its working buffers - on every image
+    static bool kReuseEdgeDetectorBuffers;
+
+    // If set, FindBestEllipseFornaciari masks its sub-image down to just the
+    // annulus where the reference circle says the ball's rim can be before
+    // running the ellipse detector, and pre-filters the returned ellipses
+    // against the plausible radius band.  The pad widens the annulus (in
+    // pixels) on both sides to keep the rim edges intact.
+    static bool kUseFornaciariAnnulusMask;
+    static int kFornaciariAnnulusPadPixels;
+
+    // If set, the output of the strobed-mode preprocessing chain (CLAHE,
+    // pre-Canny blur, Canny, pre-Hough blur) is cached on the instance and
+    // reused whenever the same frame comes back through GetBall with the
+    // same parameter set - see edge_map_cache_output_ below.
+    static bool kUseEdgeMapCache;
+
     static double kPuttingBallStartingParam2;
     static double kPuttingBallMinParam2;
     static double kPuttingBallMaxParam2;
@@ -142,6 +318,30 @@ public:
     static bool kExternallyStrobedUseCLAHEProcessing;
     static int kExternallyStrobedCLAHEClipLimit;
     static int kExternallyStrobedCLAHETilesGridSize;
+    static bool kExternallyStrobedUseFastLocalContrast;
+
+    // If true (and the non-ALT Hough algorithm is in use), the adaptive param2 walk
+    // runs the Hough transform only once - at the loosest threshold, with per-circle
+    // accumulator votes - and re-thresholds the cached votes in memory instead of
+    // re-running the full Canny+accumulator pass for every param2 retry
+    static bool kUseSinglePassHoughAdaptation;
+
+    // If true, placed-ball (waiting-for-ball) searches first locate the approximate
+    // ball on an image downscaled by kPyramidDetectionScaleFactor and then run the
+    // full-precision adaptive search only in a small full-resolution window around
+    // that coarse hit, instead of scanning the whole frame at sensor resolution
+    static bool kUsePyramidCircleDetection;
+    static int kPyramidDetectionScaleFactor;
+
+    // Comma-separated list of search modes ("placed", "strobed",
+    // "externally_strobed", "putting") for which the edge-drawing circle
+    // engine replaces the HoughCircles passes.  The engine runs the
+    // parameter-free EDPF edge detector, splits the edge segments into
+    // circular arcs, groups agreeing arcs and least-squares-fits the result,
+    // so there is no param2 retry walk at all.  Empty disables the engine.
+    static std::string kEdgeDrawingCircleDetectionModes;
+    static double kEdgeDrawingCircleFitErrorPixels;   // Max mean radial fit error for an arc to count
+    static double kEdgeDrawingMinArcCoverageDegrees;  // Min summed angular coverage for a circle
 
     static bool kUseDynamicRadiiAdjustment;
     static int kNumberRadiiToAverageForDynamicAdjustment;
@@ -161,6 +361,11 @@ public:
     static bool kUseBestCircleRefinement;
     static bool kUseBestCircleLargestCircle;
 
+    // If > 0, per-candidate best-circle refinement is skipped for any circle
+    // whose rim edge support (see ComputeCircleEdgeSupport) already meets this
+    // fraction.  0 (the default) refines every candidate as before.
+    static double kBestCircleRefinementConfidenceThreshold;
+
     static double kBestCircleCannyLower;
     static double kBestCircleCannyUpper;
     static int kBestCirclePreCannyBlurSize;
@@ -202,6 +407,27 @@ public:
     static bool kONNXRuntimeAutoFallback;  // Enable automatic fallback to OpenCV DNN
     static int kONNXRuntimeThreads;  // Number of threads for ONNX Runtime (ARM optimization)
 
+    static float kONNXNMSRadiusPreFilterRatio;  // Reject boxes whose half-size is outside
+                                                // expected-radius/ratio..expected-radius*ratio
+                                                // before NMS.  0 disables the pre-filter.
+
+    static bool kONNXUseInt8Quantization;  // Run the INT8-quantized model (XNNPACK INT8 kernels)
+    static std::string kONNXInt8ModelPath;  // Optional explicit quantized-model path
+    static std::string kONNXCalibrationImageDir;  // Strobed images used to capture quantization ranges
+
+    static bool kONNXUseFp16;  // Run the FP16-converted model (XNNPACK FP16 NEON kernels)
+    static std::string kONNXFp16ModelPath;  // Optional explicit converted-model path
+
+    static bool kONNXUseOptimizedModelCache;  // Cache the graph-optimized model on disk next to
+                                              // the model file to skip re-optimizing at startup
+
+    static std::string kONNXGateModelPath;  // Tiny ball-presence model that gates the full-size
+                                            // pass during placed-ball watching.  Empty disables
+                                            // the cascade.
+    static int kONNXGateInputSize;  // Gate model input resolution (much smaller, e.g. 160)
+    static float kONNXGateConfidenceThreshold;  // Gate confidence below which a frame is
+                                                // treated as having no ball
+
     // This determines which potential 3D angles will be searched for spin processing
     struct RotationSearchSpace {
         int anglex_rotation_degrees_increment = 0;
@@ -244,6 +470,55 @@ public:
     // Shows the ball that was identified with a circle and center point on top of original image
     cv::Mat final_result_image_;
 
+    // Scratch buffers reused by PreProcessStrobedImage across shots (same spirit as
+    // the static yolo_input_buffer_/yolo_letterbox_buffer_ reuse).  cv::Mat output
+    // re-use keeps the existing allocation whenever the size and type match, so
+    // after the first shot the whole preprocessing chain runs without touching the
+    // heap.  Note that the caller's image may reference one of these buffers after
+    // PreProcessStrobedImage returns; the buffers are only rewritten by the next
+    // preprocessing call on this instance.
+    cv::Mat preprocess_clahe_buffer_;
+    cv::Mat preprocess_blur_buffer_;
+    cv::Mat preprocess_canny_buffer_;
+
+    // 32F local mean / mean-of-squares scratch images for the fast
+    // local-contrast normalization (kUseFastLocalContrast)
+    cv::Mat local_contrast_mean_buffer_;
+    cv::Mat local_contrast_mean_sq_buffer_;
+
+    // Cached output of the full PreProcessStrobedImage chain, keyed by the
+    // input image's pixel sum and dimensions plus every parameter the chain
+    // consumed (kUseEdgeMapCache).  Repeated GetBall calls over the same
+    // frame - the expanding-search stages, or a re-search after switching
+    // between the primary and ALT Hough configurations - then skip straight
+    // to the Hough transform.  A new frame changes the pixel sum, so the
+    // cache invalidates itself at shot boundaries.  On a hit the caller is
+    // handed this Mat itself (same aliasing as the scratch buffers above),
+    // so consumers must treat the returned search image as read-only.
+    cv::Mat edge_map_cache_output_;
+    double edge_map_cache_signature_ = 0.0;
+    int edge_map_cache_rows_ = 0;
+    int edge_map_cache_cols_ = 0;
+    int edge_map_cache_mode_ = 0;
+    bool edge_map_cache_used_clahe_ = false;
+    int edge_map_cache_clahe_grid_ = 0;
+    int edge_map_cache_clahe_clip_ = 0;
+    bool edge_map_cache_used_fast_contrast_ = false;
+    int edge_map_cache_contrast_window_ = 0;
+    double edge_map_cache_contrast_gain_ = 0.0;
+    int edge_map_cache_pre_canny_blur_ = 0;
+    int edge_map_cache_pre_hough_blur_ = 0;
+    double edge_map_cache_canny_lower_ = 0.0;
+    double edge_map_cache_canny_upper_ = 0.0;
+    long edge_map_cache_hits_ = 0;
+    long edge_map_cache_misses_ = 0;
+
+    // Retained EDPF edge detector, used instead of constructing a fresh
+    // detector per image when kReuseEdgeDetectorBuffers is enabled.  The
+    // detector's internal gradient/direction/edge/chain buffers are then
+    // only re-allocated when the input dimensions change.
+    EDPF reusable_edpf_;
+
     BallImageProc();
     ~BallImageProc();
 
@@ -263,27 +538,80 @@ public:
     // If chooseLargestFinalBall is set true, then even a poorer-matching final ball candidate will be chosen over a smaller, better-scored candidate.
     // If expectingBall is true, then the system will not be as picky when trying to find a ball.  Otherwise, if false (when the system does not
     // know if a ball will be present), the system will require a more perfect ball in order to reduce false positives.
-    bool GetBall(  const cv::Mat& img, 
-                   const GolfBall& baseBallWithSearchParams, 
-                   std::vector<GolfBall> &return_balls, 
-                   cv::Rect& expectedBallArea, 
+    bool GetBall(  const cv::Mat& img,
+                   const GolfBall& baseBallWithSearchParams,
+                   std::vector<GolfBall> &return_balls,
+                   cv::Rect& expectedBallArea,
                    BallSearchMode search_mode,
                    bool chooseLargestFinalBall=false,
                    bool report_find_failures =true );
 
+    // The per-mode instantiation behind GetBall.  The search mode is a template
+    // parameter so that every search_mode comparison inside the (large) pipeline
+    // body folds to a compile-time constant - each instantiation carries only
+    // its own mode's branches and parameter selections.  Callers with a runtime
+    // mode should go through GetBall, which dispatches here; the body lives in
+    // the .cpp and is instantiated there for each BallSearchMode.
+    template <BallSearchMode MODE>
+    bool GetBallForMode(const cv::Mat& img,
+                   const GolfBall& baseBallWithSearchParams,
+                   std::vector<GolfBall>& return_balls,
+                   cv::Rect& expectedBallArea,
+                   bool chooseLargestFinalBall = false,
+                   bool report_find_failures = true);
+
+    // Single-pass replacement for GetBall's adaptive param2 retry walk (see
+    // kUseSinglePassHoughAdaptation).  Runs cv::HoughCircles once at min_param2 with
+    // accumulator votes and then replays the same widen/tighten walk as an in-memory
+    // filter over the cached votes.  Returns false on a hard failure; "no circles
+    // found" leaves circles empty and returns true, just like the retry loop.
+    bool HoughCirclesSinglePassAdaptive(const cv::Mat& search_image,
+                                        double dp,
+                                        double minimum_distance,
+                                        double param1,
+                                        double starting_param2,
+                                        double min_param2,
+                                        double max_param2,
+                                        double param2_increment,
+                                        int minimum_search_radius,
+                                        int maximum_search_radius,
+                                        int min_circles_to_return,
+                                        int max_circles_to_return,
+                                        std::vector<GsCircle>& circles,
+                                        int& final_number_of_found_circles,
+                                        bool report_find_failures);
+
     bool BallIsPresent(const cv::Mat& img);
 
     // Performs some iterative refinement to try to identify the best ball circle.
+    // If view is supplied, the stage reuses any already-matching crop/blur/edge
+    // products it finds there and publishes the ones it computes for any later
+    // per-candidate stage (e.g., the ellipse refinement).
     static bool DetermineBestCircle(const cv::Mat& gray_image,
                                     const GolfBall& reference_ball,
                                     bool choose_largest_final_ball,
-                                    GsCircle& final_circle);
+                                    GsCircle& final_circle,
+                                    PreprocessedView* view = nullptr);
+
+    // Cheap confidence measure for an already-chosen circle - the fraction of
+    // sample points around the circle's rim that sit on a real radial
+    // intensity edge in the gray image.  A well-placed circle on a cleanly
+    // strobed ball scores near 1.0; a circle that is off-center, mis-sized, or
+    // sitting on a smeared/overlapped exposure scores much lower.  Costs a few
+    // dozen pixel reads, versus the Canny+Hough pass of DetermineBestCircle().
+    static double ComputeCircleEdgeSupport(const cv::Mat& gray_image, const GsCircle& circle);
 
 
     // Waits for movement behind the ball (i.e., the club) and returns the first image containing the movement
     // Ignores the first <X> seconds for movement.
     static bool WaitForBallMovement(GolfSimCamera& c, cv::Mat& firstMovementImage, const GolfBall& ball, const long waitTimeSecs);
 
+    // Fraction of the non-ignored pixels in a Gabor-filtered dimple-edge image
+    // that are "on".  A well-exposed, well-focused ball lands near the
+    // kGaborMinWhitePercent..kGaborMaxWhitePercent calibration window; smeared
+    // or reflection-heavy exposures score far lower.
+    static double MeasureDimpleEdgeDensity(const cv::Mat& dimple_edge_image);
+
     // Inputs are two balls and the images within which those balls exist
     // Returns the estimated amount of rotation in x, y, and z axes in degrees
     static cv::Vec3d GetBallRotation(const cv::Mat& full_gray_image1, 
@@ -291,13 +619,48 @@ public:
                                     const cv::Mat& full_gray_image2, 
                                     const GolfBall& ball2);
 
-    static bool ComputeCandidateAngleImages(const cv::Mat& base_dimple_image, 
+    // Pattern (compass) search over the three rotation angles, using the same
+    // CompareRotationImage objective as the grid search, but typically converging
+    // in tens of evaluations instead of thousands.
+    // Returns false if no valid comparison could be made.
+    static bool SearchBallRotationIterative(const cv::Mat& base_dimple_image,
+                                    const GolfBall& ball,
+                                    const cv::Mat& target_dimple_image,
+                                    cv::Vec3i& best_rotation);
+
+    static bool ComputeCandidateAngleImages(const cv::Mat& base_dimple_image,
                                     const RotationSearchSpace& search_space, 
                                     cv::Mat& output_candidate_mat, 
                                     cv::Vec3i& output_candidate_elements_mat_size, 
                                     std::vector< RotationCandidate>& output_candidates, 
                                     const GolfBall& ball);
 
+    // Fused generate-and-score pass over the search space (see kUseFusedSpinPipeline).
+    // The returned candidates carry scores but no retained images.
+    // Returns the index of the best candidate, or -1 on failure.
+    static int ComputeAndCompareCandidateAngleImages(const cv::Mat& base_dimple_image,
+                                            const RotationSearchSpace& search_space,
+                                            const cv::Mat& target_image,
+                                            const GolfBall& ball,
+                                            std::vector<RotationCandidate>& output_candidates);
+
+    // Lifts the visible-hemisphere pixels of the base dimple image into a 3D point
+    // cloud (see kUseCachedPointCloudProjection).  Done once per search space sweep.
+    static void BuildBallPointCloud(const cv::Mat& base_dimple_image,
+                                    const GolfBall& ball,
+                                    std::vector<BallPointCloudPoint>& point_cloud);
+
+    // Produces one candidate projection image by rotating the cached point cloud.
+    // Reentrant - safe to call concurrently for different rotations.
+    static void ProjectPointCloud(const std::vector<BallPointCloudPoint>& point_cloud,
+                                    const GolfBall& ball,
+                                    const cv::Vec3i& rotation_degrees,
+                                    cv::Mat& projected_img);
+
+    // Picks the best-scoring candidate, applying a penalty for candidates whose
+    // comparisons had unusually few examined pixels.  Returns -1 on failure.
+    static int SelectBestRotationCandidate(const std::vector<RotationCandidate>& candidates);
+
     // Returns the index within candidates that has the best comparison.
     // Returns -1 on failure.
     static int CompareCandidateAngleImages(const cv::Mat* target_image,
@@ -308,6 +671,28 @@ public:
 
     static cv::Vec2i CompareRotationImage(const cv::Mat& img1, const cv::Mat& img2, const int index = 0);
 
+    // The original per-pixel comparison loop.  CompareRotationImage dispatches here when
+    // the vectorized kernel is disabled or unavailable on the current platform.
+    static cv::Vec2i CompareRotationImageScalar(const cv::Mat& img1, const cv::Mat& img2, const int index = 0);
+
+    // Cheap first-pass comparison that only examines every stride-th pixel in each
+    // direction.  Used by the candidate-pruning engine to rank candidates before
+    // (possibly) scoring them at full resolution.
+    static cv::Vec2i CompareRotationImageSubsampled(const cv::Mat& img1, const cv::Mat& img2, int stride);
+
+    // Full-resolution comparison with a branch-and-bound abort - returns false
+    // (leaving results unset) as soon as even a perfect match of all remaining
+    // pixels could not reach best_score_so_far.
+    static bool CompareRotationImageBounded(const cv::Mat& img1, const cv::Mat& img2, double best_score_so_far, cv::Vec2i& results);
+
+    // Bit-packing support - pack an 8-bit (target) dimple image or the value channel
+    // of a 2-channel 32-bit (candidate) projection image into a PackedDimpleImage
+    static void PackDimpleImage(const cv::Mat& img, PackedDimpleImage& packed);
+    static void PackCandidateImage(const cv::Mat& candidate_img, PackedDimpleImage& packed);
+
+    // Popcount scorer over two packed images - returns (pixels_matching, pixels_examined)
+    static cv::Vec2i ComparePackedDimpleImages(const PackedDimpleImage& img1, const PackedDimpleImage& img2);
+
     static cv::Mat MaskAreaOutsideBall(cv::Mat& ball_image, const GolfBall& ball, float mask_reduction_factor, const cv::Scalar& maskValue = (255, 255, 255));
 
     static void GetRotatedImage(const cv::Mat& gray_2D_input_image, const GolfBall& ball, const cv::Vec3i rotation, cv::Mat& outputGrayImg);
@@ -317,9 +702,13 @@ public:
     // Img would be a constant reference, but we need to perform sub-imaging on it, so keep non-const for now
     // reference_ball_circle is the circle around where the best approximation of where the ball is
     static cv::RotatedRect FindLargestEllipse(cv::Mat& img, const GsCircle& reference_ball_circle, int mask_radius);
-    static cv::RotatedRect FindBestEllipseFornaciari(cv::Mat& img, 
-                                                    const GsCircle& reference_ball_circle, 
-                                                    int mask_radius);
+    // If view is supplied (typically populated by a preceding DetermineBestCircle
+    // call on the same candidate), the stage crops from the view's products
+    // instead of the full image wherever the recorded parameters match its own.
+    static cv::RotatedRect FindBestEllipseFornaciari(cv::Mat& img,
+                                                    const GsCircle& reference_ball_circle,
+                                                    int mask_radius,
+                                                    const PreprocessedView* view = nullptr);
 
     cv::Mat GetColorMaskImage(const cv::Mat& hsvImage, const GolfBall& ball, double wideningAmount = 0.0);
     static cv::Mat GetColorMaskImage(const cv::Mat& hsvImage,
@@ -327,8 +716,35 @@ public:
         const GsColorTriplet input_upperHsv,
         double wideningAmount = 0.0);
 
+    // Same mask semantics as GetColorMaskImage, but works directly from a BGR
+    // image using a precomputed 64x64x64 in-range lookup table instead of
+    // converting every pixel to HSV and range-testing it.  The table is built
+    // once per set of HSV bounds (through the same cvtColor/inRange path as
+    // above, so the in/out decisions match apart from the 6-bit-per-channel
+    // quantization) and is then reused, so repeated candidate searches cost
+    // one table index per pixel.
+    cv::Mat GetColorMaskImageFromBgr(const cv::Mat& bgrImage, const GolfBall& ball, double wideningAmount = 0.0);
+    static cv::Mat GetColorMaskImageFromBgr(const cv::Mat& bgrImage,
+        const GsColorTriplet input_lowerHsv,
+        const GsColorTriplet input_upperHsv,
+        double wideningAmount = 0.0);
+
     bool PreProcessStrobedImage(cv::Mat& search_image, BallSearchMode search_mode);
 
+    // The integral-image local contrast normalization behind
+    // kUseFastLocalContrast.  result receives an 8-bit image of the same
+    // geometry as image (the two must not alias the same buffer).
+    bool ApplyFastLocalContrast(const cv::Mat& image, cv::Mat& result);
+
+    // Edge-drawing circle detection engine (see kEdgeDrawingCircleDetectionModes).
+    // Fits circles to EDPF edge segments instead of running HoughCircles.  The
+    // returned circles are sorted strongest (most angular coverage) first and
+    // already filtered to the given radius range.
+    bool DetectBallsEdgeDrawing(const cv::Mat& preprocessed_img,
+                                double min_radius, double max_radius,
+                                std::vector<GsCircle>& detected_circles);
+    static bool EdgeDrawingEnabledForMode(BallSearchMode search_mode);
+
     // ONNX Detection Methods
     static bool DetectBalls(const cv::Mat& preprocessed_img, BallSearchMode search_mode, std::vector<GsCircle>& detected_circles);
     static bool DetectBallsHoughCircles(const cv::Mat& preprocessed_img, BallSearchMode search_mode, std::vector<GsCircle>& detected_circles);
@@ -341,6 +757,14 @@ public:
     static bool PreloadONNXRuntimeModel();
     static void CleanupONNXRuntime();
 
+    // Eagerly builds the configured detector session (and runs a dummy
+    // inference at the configured input size) so that the first shot after
+    // startup does not pay for ONNX Runtime session creation and XNNPACK
+    // kernel compilation.  Intended to be called from the FSM's system
+    // startup tasks, after LoadConfigurationValues().  A no-op when no
+    // experimental detection method is configured.
+    static void PrewarmDetectorAtStartup();
+
     // Load configuration values from JSON after config is initialized
     static void LoadConfigurationValues();
 
@@ -356,6 +780,17 @@ private:
     static std::atomic<bool> onnx_detector_initialized_;
     static std::mutex onnx_detector_mutex_;
 
+    // First tier of the two-tier placed-ball cascade.  Returns false only when
+    // the configured micro model is confident there is no ball in the frame,
+    // in which case the full-size pass is skipped entirely.  Fails open (runs
+    // the full pass) when no gate model is configured or it cannot be loaded.
+    static bool BallPresenceGatePasses(const cv::Mat& preprocessed_img);
+
+    // The micro gate detector.  Initialization shares onnx_detector_mutex_.
+    static std::unique_ptr<ONNXRuntimeDetector> onnx_gate_detector_;
+    static std::atomic<bool> onnx_gate_detector_initialized_;
+    static std::atomic<bool> onnx_gate_detector_failed_;
+
     static cv::dnn::Net yolo_model_;
     static bool yolo_model_loaded_;
     static std::mutex yolo_model_mutex_;  // Thread safety for model loading
@@ -421,18 +856,27 @@ private:
 
     static cv::Mat CreateGaborKernel(int ks, double sig, double th, double lm, double gm, double ps);
 
-    static cv::Mat Project2dImageTo3dBall(const cv::Mat& image_gray, const GolfBall& ball, const cv::Vec3i& rotation_angles_degrees);
+    // If preallocated_output is non-null, the projection is written into that
+    // (correctly-sized and typed) image instead of allocating a new one.  See
+    // RotationCandidateArena.
+    static cv::Mat Project2dImageTo3dBall(const cv::Mat& image_gray, const GolfBall& ball, const cv::Vec3i& rotation_angles_degrees, cv::Mat* preallocated_output = nullptr);
 
     static void Unproject3dBallTo2dImage(const cv::Mat& src3D, cv::Mat& destination_image_gray, const GolfBall& ball);
 
-    // Given a grayscale (0-255) image and a percentage, this returns in brightness_cutoff from 0-255 
-    // that represents the value at which brightness_percentage of the pixels in the image are at or 
+    // Given a grayscale (0-255) image and a percentage, this returns in brightness_cutoff from 0-255
+    // that represents the value at which brightness_percentage of the pixels in the image are at or
     // below that value
+    // The statistics are approximate - they are computed from a subsampled grid
+    // of pixels and cached, with recomputation only when the image geometry or
+    // a sparse brightness probe says the scene has changed (or on demand via
+    // force_recalculation).  The consumers of these values (exposure-quality
+    // gating and the like) only need approximate numbers.
     static void GetImageCharacteristics(const cv::Mat& img,
                                         const int brightness_percentage,
                                         int& brightness_cutoff,
                                         int& lowest_brightness,
-                                        int& highest_brightness);
+                                        int& highest_brightness,
+                                        bool force_recalculation = false);
 
 };
 
@@ -23,6 +23,7 @@
 
 #include "logging_tools.h"
 #include "gs_globals.h"
+#include "gs_config.h"
 
 namespace gs = golf_sim;
 
@@ -77,6 +78,33 @@ bool ball_watcher_event_loop(RPiCamEncoder &app, bool & motion_detected)
 	motion_detect_stage.Configure();
 
 
+	// Frame-budget watchdog.  Each iteration gets a deadline derived from the
+	// configured frame rate, and after enough consecutive overruns the motion
+	// detection stage sheds load a level at a time (diagnostic overlays first,
+	// then row subsampling) rather than letting frames queue up and the strobe
+	// trigger drift late.  Load is restored once the loop has stayed within
+	// budget for a while.
+	bool kFrameWatchdogEnabled = true;
+	float kFrameWatchdogBudgetMultiple = 1.5;
+	int kFrameWatchdogOverrunLimit = 5;
+	int kFrameWatchdogRecoveryFrames = 250;
+
+	GolfSimConfiguration::SetConstant("gs_config.motion_detect_stage.kFrameWatchdogEnabled", kFrameWatchdogEnabled);
+	GolfSimConfiguration::SetConstant("gs_config.motion_detect_stage.kFrameWatchdogBudgetMultiple", kFrameWatchdogBudgetMultiple);
+	GolfSimConfiguration::SetConstant("gs_config.motion_detect_stage.kFrameWatchdogOverrunLimit", kFrameWatchdogOverrunLimit);
+	GolfSimConfiguration::SetConstant("gs_config.motion_detect_stage.kFrameWatchdogRecoveryFrames", kFrameWatchdogRecoveryFrames);
+
+	double frame_budget_seconds = 0.0;
+	if (kFrameWatchdogEnabled && options->framerate.value_or(0.) > 0.) {
+		frame_budget_seconds = kFrameWatchdogBudgetMultiple / options->framerate.value_or(0.);
+		GS_LOG_TRACE_MSG(trace, "ball_watcher_event_loop - frame budget is " +
+			std::to_string(frame_budget_seconds * 1000.) + " ms.");
+	}
+
+	int consecutive_overruns = 0;
+	int frames_within_budget = 0;
+	int shed_level = 0;
+
 	auto start_time = std::chrono::high_resolution_clock::now();
 
 	pollfd p[1] = { { STDIN_FILENO, POLLIN, 0 } };
@@ -107,6 +135,8 @@ bool ball_watcher_event_loop(RPiCamEncoder &app, bool & motion_detected)
 			throw std::runtime_error("unrecognised message!");
 
 		// We have a completed request for an image
+		auto frame_start_time = std::chrono::high_resolution_clock::now();
+
 		CompletedRequestPtr &completed_request = std::get<CompletedRequestPtr>(msg.payload);
         if (!app.EncodeBuffer(completed_request, app.VideoStream()))
         {
@@ -120,6 +150,35 @@ bool ball_watcher_event_loop(RPiCamEncoder &app, bool & motion_detected)
 
 		bool result = motion_detect_stage.Process(completed_request);
 
+		// Check this iteration against its deadline and shed (or restore) load
+		// as necessary.
+		if (frame_budget_seconds > 0.) {
+			std::chrono::duration<double> frame_time = std::chrono::high_resolution_clock::now() - frame_start_time;
+
+			if (frame_time.count() > frame_budget_seconds) {
+				frames_within_budget = 0;
+				if (++consecutive_overruns >= kFrameWatchdogOverrunLimit &&
+					shed_level < MotionDetectStage::kMaxLoadShedLevel) {
+					shed_level++;
+					motion_detect_stage.SetLoadShedLevel(shed_level);
+					GS_LOG_MSG(warning, "ball_watcher_event_loop - " + std::to_string(consecutive_overruns) +
+						" consecutive frame-budget overruns (last was " + std::to_string(frame_time.count() * 1000.) +
+						" ms).  Shedding load to level " + std::to_string(shed_level) + ".");
+					consecutive_overruns = 0;
+				}
+			}
+			else {
+				consecutive_overruns = 0;
+				if (++frames_within_budget >= kFrameWatchdogRecoveryFrames && shed_level > 0) {
+					shed_level--;
+					motion_detect_stage.SetLoadShedLevel(shed_level);
+					GS_LOG_TRACE_MSG(trace, "ball_watcher_event_loop - back within the frame budget.  Restoring load to level " +
+						std::to_string(shed_level) + ".");
+					frames_within_budget = 0;
+				}
+			}
+		}
+
 		bool mdResult = false;
 		int getStatus = completed_request->post_process_metadata.Get("motion_detect.result", mdResult);
 		if (getStatus == 0) {
@@ -8,11 +8,104 @@
 #ifdef __unix__  // Ignore in Windows environment
 
 
+#include <algorithm>
+
+#include <opencv2/imgproc.hpp>
+
 #include "ball_watcher_image_buffer.h"
 
 	// Global queue to hold the last <n> frames before motion is detected in the frame
 	// WARNING - NOT THREAD SAFE ON ITS OWN
 	boost::circular_buffer<golf_sim::RecentFrameInfo> golf_sim::RecentFrames(10);
 
+	golf_sim::RecentFrameRing golf_sim::RecentFrameRingBuffer;
+
+namespace golf_sim {
+
+	bool RecentFrameRing::kUseAdaptiveFrameRetention = false;
+	int RecentFrameRing::kFullResolutionWindowFrames = 15;
+	int RecentFrameRing::kThumbnailDownsampleFactor = 4;
+
+	void RecentFrameRing::Resize(size_t capacity) {
+		slots_.clear();
+		slots_.resize(capacity);
+		next_sequence_.store(0, std::memory_order_relaxed);
+		demotion_suspended_ = false;
+	}
+
+	void RecentFrameRing::Push(RecentFrameInfo&& frame_info) {
+		if (slots_.empty()) {
+			return;
+		}
+
+		std::uint64_t sequence = next_sequence_.load(std::memory_order_relaxed);
+
+		frame_info.fullResolutionSize = frame_info.mat.size();
+
+		// Moving into the slot releases whatever the overwritten entry held,
+		// including any retained buffer fence.
+		slots_[sequence % slots_.size()] = std::move(frame_info);
+
+		// The release ordering publishes the slot contents before the new count.
+		next_sequence_.store(sequence + 1, std::memory_order_release);
+
+		// Demote the one entry that just aged out of the full-resolution
+		// window.  The work is bounded to a single downsample per push, and
+		// it runs here on the producer because the slots are single-threaded
+		// by design - a background demoter would race the ring.
+		if (kUseAdaptiveFrameRetention && !demotion_suspended_ &&
+			kFullResolutionWindowFrames > 0 &&
+			sequence + 1 > (std::uint64_t)kFullResolutionWindowFrames) {
+
+			std::uint64_t aged_sequence = sequence - (std::uint64_t)kFullResolutionWindowFrames;
+
+			// Only if the aged entry is still in the ring (a small ring can
+			// have already overwritten it).
+			if (sequence - aged_sequence < slots_.size()) {
+				DemoteSlot(slots_[aged_sequence % slots_.size()]);
+			}
+		}
+	}
+
+	void RecentFrameRing::SuspendDemotion() {
+		demotion_suspended_ = true;
+	}
+
+	void RecentFrameRing::DemoteSlot(RecentFrameInfo& slot) {
+		if (slot.isThumbnail || slot.mat.empty() || kThumbnailDownsampleFactor <= 1) {
+			return;
+		}
+
+		cv::Size thumbnail_size(std::max(1, slot.mat.cols / kThumbnailDownsampleFactor),
+								std::max(1, slot.mat.rows / kThumbnailDownsampleFactor));
+
+		// Nearest-neighbor keeps the per-push cost down - these frames are
+		// only diagnostics, and this runs on the high-FPS capture thread.
+		cv::Mat thumbnail;
+		cv::resize(slot.mat, thumbnail, thumbnail_size, 0, 0, cv::INTER_NEAREST);
+
+		slot.mat = thumbnail;
+		slot.isThumbnail = true;
+
+		// With the full mat gone, the mmap'd camera buffer (if this was a
+		// zero-copy view) can go back to the camera.
+		slot.bufferFence.reset();
+	}
+
+	void RecentFrameRing::Drain(boost::circular_buffer<RecentFrameInfo>& out) {
+		std::uint64_t pushed = next_sequence_.load(std::memory_order_acquire);
+
+		std::uint64_t retained = std::min(pushed, (std::uint64_t)slots_.size());
+
+		for (std::uint64_t sequence = pushed - retained; sequence < pushed; sequence++) {
+			out.push_back(std::move(slots_[sequence % slots_.size()]));
+			slots_[sequence % slots_.size()] = RecentFrameInfo();
+		}
+
+		next_sequence_.store(0, std::memory_order_relaxed);
+	}
+
+}
+
 #endif // #ifdef __unix__  // Ignore in Windows environment
 
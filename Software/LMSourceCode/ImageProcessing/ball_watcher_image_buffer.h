@@ -8,6 +8,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include <opencv2/core/cvdef.h>
 #include <opencv2/highgui.hpp>
 
@@ -24,9 +29,98 @@ namespace golf_sim {
 		// True if this was the frame where motion (the ball hit) was first detected
 		bool isballHitFrame = false;
 		float frameRate = 0.0;
+		// The sensor's own capture timestamp (libcamera SensorTimestamp, in
+		// nanoseconds) for the frame, or 0 when the sensor did not report one.
+		// Unlike times observed in software, this is stamped by the capture
+		// hardware and carries no scheduler jitter, so deltas between frames
+		// are the real inter-exposure times.
+		uint64_t sensorTimestampNs = 0;
+		// When the mat is a zero-copy view of the camera's mmap'd frame buffer
+		// (see GolfSimClubData::kRetainZeroCopyFrames), this holds the completed
+		// request so that the underlying buffer stays mapped (and is not re-queued
+		// to the camera and overwritten) for as long as this entry is alive.
+		// Empty when the mat owns its own pixel data.  Type-erased so that this
+		// header stays free of libcamera types for the Windows build.
+		std::shared_ptr<void> bufferFence;
+		// True once the adaptive retention policy has replaced the mat with a
+		// downsampled thumbnail (see RecentFrameRing::kUseAdaptiveFrameRetention).
+		// The capture metadata above is unaffected.
+		bool isThumbnail = false;
+		// The frame's capture resolution, recorded before any demotion so the
+		// diagnostics can still report what the sensor delivered.
+		cv::Size fullResolutionSize = cv::Size(0, 0);
+	};
+
+	// A preallocated, keep-the-last-<n> ring for handing RecentFrameInfo entries
+	// from the libcamera completion path to the analysis side without taking any
+	// lock.  Push() never blocks and never allocates (a cv::Mat assignment only
+	// copies the header), so the high-FPS capture loop cannot stall on the
+	// consumer - frames dropped right at impact are the worst possible ones to
+	// lose.
+	//
+	// Single-producer only.  Drain() may run concurrently with the producer in
+	// the sense that it will see a consistent prefix of the pushed entries, but
+	// in practice it is called after the capture loop has stopped.
+	class RecentFrameRing {
+	public:
+
+		// A ring sized for the worst case holds its full depth of
+		// full-resolution Mats for the whole session - a large standing RAM
+		// cost on the 2GB units.  With adaptive retention on, only the
+		// newest kFullResolutionWindowFrames entries keep their full frames;
+		// as an entry ages past the window the producer demotes it to a
+		// 1/kThumbnailDownsampleFactor thumbnail (keeping all the capture
+		// metadata) and releases any zero-copy buffer fence it held.  Once
+		// motion is detected, demotion is suspended, so the hit frame's
+		// neighborhood - the window's worth of frames before it, plus every
+		// post-hit frame - is retained at full resolution.
+		static bool kUseAdaptiveFrameRetention;
+		static int kFullResolutionWindowFrames;
+		static int kThumbnailDownsampleFactor;
+
+		// Preallocates the ring to hold the last <capacity> frames.  Not
+		// thread-safe - call before the capture loop starts.  Re-arms
+		// demotion for the next session.
+		void Resize(size_t capacity);
+
+		// Producer side.  Overwrites the oldest entry once the ring is full
+		// (releasing any buffer fence that the entry held), then demotes the
+		// entry that just aged out of the full-resolution window.
+		void Push(RecentFrameInfo&& frame_info);
+
+		// Stops demoting aged entries so the frames around a motion
+		// candidate stay at full resolution.  Producer thread only - the
+		// motion-detect stage calls it from the same completion callback
+		// that pushes.
+		void SuspendDemotion();
+
+		// Moves the retained frames, oldest first, into the (legacy) circular
+		// buffer that the club-data processing works from, and empties the
+		// ring.  Emptying matters - it releases any retained buffer fences,
+		// and that must happen while the camera app is still alive.
+		void Drain(boost::circular_buffer<RecentFrameInfo>& out);
+
+	private:
+
+		// Replaces the slot's mat with a downsampled thumbnail and releases
+		// its buffer fence.
+		void DemoteSlot(RecentFrameInfo& slot);
+
+		std::vector<RecentFrameInfo> slots_;
+
+		// Producer thread only, like Push() itself.
+		bool demotion_suspended_ = false;
+
+		// Total number of frames ever pushed; the next frame goes into
+		// slot (next_sequence_ % slots_.size()).
+		std::atomic<std::uint64_t> next_sequence_{ 0 };
 	};
 
 	// Global queue to hold the last <n> frames before motion is detected in the frame
 	extern boost::circular_buffer<RecentFrameInfo> RecentFrames;
 
+	// The lock-free ring that the motion-detect stage pushes into; drained
+	// into RecentFrames once the watcher loop ends.
+	extern RecentFrameRing RecentFrameRingBuffer;
+
 }
\ No newline at end of file
@@ -9,6 +9,17 @@
 #include <mutex>
 #include <condition_variable>
 
+#ifdef __unix__
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 // This is basically the same algorithm as what the standard python queues use.
 // jHowever, this one has a timed-out "pop" functionality, so that you don't wait 
 // forever on a pop call to an empty queu.
@@ -95,4 +106,245 @@ class queue {
   }
 };
 
+
+// Same blocking/timeout semantics as the queue above, but with two priority
+// lanes.  A pop always drains the high-priority lane before the low one, so
+// (for example) shot-critical events never wait behind housekeeping chatter.
+// Each lane gets the full capacity, so a backed-up low lane cannot block a
+// high-priority push.
+template<typename T>
+class two_lane_queue {
+  std::deque<T> high_content;
+  std::deque<T> low_content;
+  size_t capacity;
+
+  std::mutex mutex;
+  std::condition_variable not_empty;
+  std::condition_variable not_full;
+
+  two_lane_queue(const two_lane_queue &) = delete;
+  two_lane_queue(two_lane_queue &&) = delete;
+  two_lane_queue &operator = (const two_lane_queue &) = delete;
+  two_lane_queue &operator = (two_lane_queue &&) = delete;
+
+ public:
+  two_lane_queue(size_t capacity): capacity(capacity) {}
+
+  void push(T &&item, bool high_priority = false) {
+    {
+      std::unique_lock<std::mutex> lk(mutex);
+      std::deque<T> &lane = high_priority ? high_content : low_content;
+      not_full.wait(lk, [this, &lane]() { return lane.size() < capacity; });
+      lane.push_back(std::move(item));
+    }
+    not_empty.notify_one();
+  }
+
+  // Returns true if the queue was successfully popped.
+  // Will wait (block) forever if time_out_ms == 0
+  bool pop(T &item, unsigned int time_out_ms = 0) {
+      bool timed_out = false;
+
+      {
+      std::unique_lock<std::mutex> lk(mutex);
+      auto have_item = [this]() { return !high_content.empty() || !low_content.empty(); };
+      if (time_out_ms == 0) {
+          not_empty.wait(lk, have_item);
+      }
+      else {
+          not_empty.wait_until(lk,
+              std::chrono::steady_clock::now() + std::chrono::milliseconds(time_out_ms),
+              have_item);
+      }
+      if (!high_content.empty()) {
+          item = std::move(high_content.front());
+          high_content.pop_front();
+      }
+      else if (!low_content.empty()) {
+          item = std::move(low_content.front());
+          low_content.pop_front();
+      }
+      else {
+          timed_out = true;
+      }
+    }
+
+    not_full.notify_one();
+
+    return !timed_out;
+  }
+};
+
+
+#ifdef __unix__
+
+// A bounded, lock-free multi-producer/single-consumer ring (the classic
+// sequence-numbered-cell design).  Producers never take a mutex, so a push
+// from the camera completion handler cannot stall behind a descheduled
+// consumer.  The capacity is rounded up to a power of two.
+//
+// This is just the ring - it never blocks.  See two_lane_mpsc_queue below
+// for the sleeping consumer built on top of it.
+template<typename T>
+class mpsc_ring {
+  struct cell {
+    std::atomic<size_t> sequence;
+    T item;
+  };
+
+  std::vector<cell> cells;
+  size_t mask;
+
+  // Producers race on this with compare-exchange.
+  std::atomic<size_t> enqueue_pos{0};
+
+  // Single consumer - no atomicity needed.
+  size_t dequeue_pos = 0;
+
+  mpsc_ring(const mpsc_ring &) = delete;
+  mpsc_ring &operator = (const mpsc_ring &) = delete;
+
+ public:
+  mpsc_ring(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity)
+      rounded <<= 1;
+    cells = std::vector<cell>(rounded);
+    mask = rounded - 1;
+    for (size_t i = 0; i < rounded; i++)
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  // Returns false if the ring is full.
+  bool try_push(T &&item) {
+    cell *c;
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+
+    for (;;) {
+      c = &cells[pos & mask];
+      size_t seq = c->sequence.load(std::memory_order_acquire);
+      intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+
+      if (dif == 0) {
+        // The cell is free - try to claim it.
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+        // Lost the race to another producer - pos was reloaded, go around.
+      }
+      else if (dif < 0) {
+        return false;   // Full
+      }
+      else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    c->item = std::move(item);
+    c->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Returns false if the ring is empty.
+  bool try_pop(T &item) {
+    cell *c = &cells[dequeue_pos & mask];
+    size_t seq = c->sequence.load(std::memory_order_acquire);
+
+    if ((intptr_t)seq - (intptr_t)(dequeue_pos + 1) < 0)
+      return false;   // Empty
+
+    item = std::move(c->item);
+    c->item = T();
+    c->sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+    dequeue_pos++;
+    return true;
+  }
+};
+
+
+// The lock-free counterpart of two_lane_queue: same two-priority-lane pop
+// semantics and timeout interface, but pushes are wait-free against the
+// consumer and only a truly empty queue puts the consumer to sleep (directly
+// on a futex - there is no mutex or condition_variable anywhere on the path).
+template<typename T>
+class two_lane_mpsc_queue {
+  mpsc_ring<T> high_lane;
+  mpsc_ring<T> low_lane;
+
+  // Futex word - bumped on every push so a sleeping consumer wakes.
+  // Wrap-around is fine; only inequality matters.
+  std::atomic<std::uint32_t> push_count{0};
+
+  // Lets producers skip the futex-wake syscall when nobody is sleeping.
+  // seq_cst on both sides (and on push_count) keeps the classic
+  // flag-vs-counter store/load race sound.
+  std::atomic<bool> consumer_waiting{false};
+
+  static void futex_wait(std::atomic<std::uint32_t> &word, std::uint32_t expected,
+                         const struct timespec *timeout) {
+    syscall(SYS_futex, (std::uint32_t *)&word, FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+  }
+
+  static void futex_wake(std::atomic<std::uint32_t> &word) {
+    syscall(SYS_futex, (std::uint32_t *)&word, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+  }
+
+  two_lane_mpsc_queue(const two_lane_mpsc_queue &) = delete;
+  two_lane_mpsc_queue &operator = (const two_lane_mpsc_queue &) = delete;
+
+ public:
+  two_lane_mpsc_queue(size_t capacity): high_lane(capacity), low_lane(capacity) {}
+
+  void push(T &&item, bool high_priority = false) {
+    mpsc_ring<T> &lane = high_priority ? high_lane : low_lane;
+
+    // A full lane should never happen in practice (the consumer would have
+    // to be wedged) - just yield and retry rather than dropping the event.
+    while (!lane.try_push(std::move(item)))
+      sched_yield();
+
+    push_count.fetch_add(1, std::memory_order_seq_cst);
+
+    if (consumer_waiting.load(std::memory_order_seq_cst))
+      futex_wake(push_count);
+  }
+
+  // Returns true if the queue was successfully popped.
+  // Will wait (block) forever if time_out_ms == 0
+  bool pop(T &item, unsigned int time_out_ms = 0) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(time_out_ms);
+
+    for (;;) {
+      // Snapshot the counter before looking, so a push that lands after a
+      // miss makes the futex wait below return immediately.
+      std::uint32_t observed = push_count.load(std::memory_order_seq_cst);
+
+      if (high_lane.try_pop(item) || low_lane.try_pop(item))
+        return true;
+
+      consumer_waiting.store(true, std::memory_order_seq_cst);
+
+      struct timespec ts;
+      struct timespec *ts_ptr = nullptr;
+
+      if (time_out_ms != 0) {
+        auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds(0)) {
+          consumer_waiting.store(false, std::memory_order_seq_cst);
+          return false;
+        }
+        auto remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        ts.tv_sec = remaining_ns / 1000000000;
+        ts.tv_nsec = remaining_ns % 1000000000;
+        ts_ptr = &ts;
+      }
+
+      futex_wait(push_count, observed, ts_ptr);
+
+      consumer_waiting.store(false, std::memory_order_seq_cst);
+    }
+  }
+};
+
+#endif // __unix__
+
 }
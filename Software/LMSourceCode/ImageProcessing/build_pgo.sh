@@ -0,0 +1,53 @@
+# SPDX-License-Identifier: GPL-2.0-only */
+#
+# Copyright (C) 2022-2025, Verdant Consultants, LLC.
+#
+#!/bin/bash
+
+# Drives the LTO + profile-guided-optimization build flow for pitrac_lm:
+#
+#   1. Configures an instrumented build (-Db_pgo=generate, LTO on).
+#   2. Captures a representative execution profile by replaying the recorded
+#      shot corpus through the pitrac_e2e_bench harness - the same camera-2
+#      analysis path the FSM drives on a live shot.
+#   3. Reconfigures with -Db_pgo=use and rebuilds, so the final pitrac_lm is
+#      optimized for the hot paths the profile actually exercised.
+#
+# Usage:
+#   ./build_pgo.sh <shot_corpus_file> [config_file]
+#
+# The corpus file is the pitrac_e2e_bench format - one
+# "<teed_ball_image> <strobed_image>" pair per line.  The more representative
+# the corpus (lighting, clubs, ball positions), the better the final build.
+#
+# The b_pgo/b_lto knobs are meson built-ins, so a plain release build is
+# untouched - this script just sequences the two-pass flow.
+
+set -e
+
+if [ -z "$1" ]; then
+    echo "Usage: $0 <shot_corpus_file> [config_file]"
+    exit 1
+fi
+
+CORPUS_FILE="$1"
+CONFIG_FILE="${2:-golf_sim_config.json}"
+BUILD_DIR="build_pgo"
+
+echo "=== Pass 1: instrumented build (LTO + profile generation) ==="
+
+meson setup "$BUILD_DIR" --buildtype=release -Db_lto=true -Db_pgo=generate -Denable_e2e_bench=true --reconfigure
+ninja -C "$BUILD_DIR"
+
+echo "=== Profile capture: replaying the shot corpus ==="
+
+# The profile data (.gcda files) lands next to the object files in the build
+# directory as the replay runs
+"$BUILD_DIR"/pitrac_e2e_bench "$CORPUS_FILE" "$BUILD_DIR"/pgo_profile_run.csv 3 "$CONFIG_FILE"
+
+echo "=== Pass 2: rebuilding with the captured profile (LTO + PGO) ==="
+
+meson configure "$BUILD_DIR" -Db_pgo=use
+ninja -C "$BUILD_DIR"
+
+echo "=== Done - profile-optimized pitrac_lm is in $BUILD_DIR ==="
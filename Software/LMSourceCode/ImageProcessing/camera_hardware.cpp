@@ -20,6 +20,7 @@
 #include "gs_options.h"
 #include "gs_config.h"
 #include "camera_hardware.h"
+#include "gs_image_io.h"
 
 
 namespace golf_sim {
@@ -121,13 +122,13 @@ namespace golf_sim {
     void CameraHardware::load_test_images() {
 
         // There are a couple of stationary pictures to simulate slight vibrations
-        TestHitSequence[kStationaryBallIndex_00] = cv::imread(kStationaryBallFileName_00, cv::IMREAD_COLOR);
-        TestHitSequence[kStationaryBallIndex_01] = cv::imread(kStationaryBallFileName_01, cv::IMREAD_COLOR);
+        TestHitSequence[kStationaryBallIndex_00] = GsImageIo::ReadImage(kStationaryBallFileName_00, cv::IMREAD_COLOR);
+        TestHitSequence[kStationaryBallIndex_01] = GsImageIo::ReadImage(kStationaryBallFileName_01, cv::IMREAD_COLOR);
         
         // This picture is of the club just about to hit the ball, in close proximity 
-        TestHitSequence[kPreHitCloseBallIndex_00] = cv::imread(kPreHitCloseBallFileName_00, cv::IMREAD_COLOR);
+        TestHitSequence[kPreHitCloseBallIndex_00] = GsImageIo::ReadImage(kPreHitCloseBallFileName_00, cv::IMREAD_COLOR);
 
-        TestHitSequence[kPostHitBallGoneIndex_00] = cv::imread(kPostHitBallGoneFileName_00, cv::IMREAD_COLOR);
+        TestHitSequence[kPostHitBallGoneIndex_00] = GsImageIo::ReadImage(kPostHitBallGoneFileName_00, cv::IMREAD_COLOR);
 
         // Use whatever (simulated) resolution we find in the image files we just read
         resolution_x_override_ = TestHitSequence[kStationaryBallIndex_00].cols;
@@ -620,7 +621,7 @@ namespace golf_sim {
         if (firstCannedImageFileName.empty()) {
             LoggingTools::Warning("firstCannedImageFileName not set when take_photo called on Windows");
             //img = cv2.imread(kTestPhotoDefault, cv2.IMREAD_COLOR);
-            img = cv::imread(kTestPhotoDefault, cv::IMREAD_COLOR);
+            img = GsImageIo::ReadImage(kTestPhotoDefault, cv::IMREAD_COLOR);
         }
         else {
             if (cannedPhotoIndex == 0) {
@@ -629,7 +630,7 @@ namespace golf_sim {
                     img = firstCannedImage;
                 }
                 else {
-                    img = cv::imread(firstCannedImageFileName, cv::IMREAD_COLOR);
+                    img = GsImageIo::ReadImage(firstCannedImageFileName, cv::IMREAD_COLOR);
                 }
                 cannedPhotoIndex++;
             }
@@ -638,7 +639,7 @@ namespace golf_sim {
                     img = secondCannedImage;
                 }
                 else {
-                    img = cv::imread(secondCannedImageFileName, cv::IMREAD_COLOR);
+                    img = GsImageIo::ReadImage(secondCannedImageFileName, cv::IMREAD_COLOR);
                 }
                 cannedPhotoIndex = 0;
             }
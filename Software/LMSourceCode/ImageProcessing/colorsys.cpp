@@ -9,6 +9,10 @@
 
 #include <algorithm>
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 
 /**
 Conversion functions between RGB and other color systems.
@@ -177,6 +181,81 @@ namespace golf_sim {
         return (GsColorTriplet(h, s, v));
     }
 
+    void colorsys::rgb_to_hsv_batch(const GsColorTriplet* rgb, GsColorTriplet* hsv, size_t count)
+    {
+        size_t i = 0;
+
+#if defined(__aarch64__)
+        // Four interleaved triplets per iteration - vld3q deinterleaves the
+        // packed r,g,b floats into planar lanes
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t two = vdupq_n_f32(2.0f);
+        const float32x4_t four = vdupq_n_f32(4.0f);
+        const float32x4_t one_sixth = vdupq_n_f32(kOneSixth);
+
+        for (; i + 4 <= count; i += 4) {
+
+            float32x4x3_t px = vld3q_f32(reinterpret_cast<const float*>(rgb + i));
+            float32x4_t r = px.val[0];
+            float32x4_t g = px.val[1];
+            float32x4_t b = px.val[2];
+
+            float32x4_t maxc = vmaxq_f32(vmaxq_f32(r, g), b);
+            float32x4_t minc = vminq_f32(vminq_f32(r, g), b);
+            float32x4_t v = maxc;
+
+            // Grey lanes (minc == maxc) get h = s = 0 below, exactly like the
+            // early return in the scalar routine
+            uint32x4_t flat = vceqq_f32(minc, maxc);
+
+            float32x4_t delta = vsubq_f32(maxc, minc);
+
+            // Guard the divisions on the lanes whose results are forced anyway
+            float32x4_t safe_delta = vbslq_f32(flat, one, delta);
+            float32x4_t safe_maxc = vbslq_f32(vceqq_f32(maxc, zero), one, maxc);
+
+            float32x4_t s = vdivq_f32(delta, safe_maxc);
+
+            float32x4_t rc = vdivq_f32(vsubq_f32(maxc, r), safe_delta);
+            float32x4_t gc = vdivq_f32(vsubq_f32(maxc, g), safe_delta);
+            float32x4_t bc = vdivq_f32(vsubq_f32(maxc, b), safe_delta);
+
+            // Same priority as the scalar if-chain: r == maxc wins, then g
+            float32x4_t h = vsubq_f32(vaddq_f32(four, gc), rc);
+            h = vbslq_f32(vceqq_f32(g, maxc), vsubq_f32(vaddq_f32(two, rc), bc), h);
+            h = vbslq_f32(vceqq_f32(r, maxc), vsubq_f32(bc, gc), h);
+
+            // fmods(h / 6, 1):  x - floor(x) lands in the same [0, 1) range
+            h = vmulq_f32(h, one_sixth);
+            h = vsubq_f32(h, vrndmq_f32(h));
+
+            h = vbslq_f32(flat, zero, h);
+            s = vbslq_f32(flat, zero, s);
+
+            float32x4x3_t out;
+            out.val[0] = h;
+            out.val[1] = s;
+            out.val[2] = v;
+            vst3q_f32(reinterpret_cast<float*>(hsv + i), out);
+        }
+#endif
+
+        for (; i < count; i++) {
+            hsv[i] = rgb_to_hsv(rgb[i]);
+        }
+    }
+
+    void colorsys::hsv_to_rgb_batch(const GsColorTriplet* hsv, GsColorTriplet* rgb, size_t count)
+    {
+        // The six-way sector branch in hsv_to_rgb doesn't pay to vectorize at
+        // the candidate-set sizes the callers use, so this is just the batch
+        // shape of the scalar routine
+        for (size_t i = 0; i < count; i++) {
+            rgb[i] = hsv_to_rgb(hsv[i]);
+        }
+    }
+
     GsColorTriplet colorsys::hsv_to_rgb(const GsColorTriplet& hsv)
     {
         float f, p, q, t;
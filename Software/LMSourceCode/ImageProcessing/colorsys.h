@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <cstddef>
+
 #include <opencv2/core/matx.hpp>
 
 #include "gs_globals.h"
@@ -23,6 +25,15 @@ namespace golf_sim {
         static GsColorTriplet rgb_to_hsv(const GsColorTriplet& rgb);
         static GsColorTriplet hsv_to_rgb(const GsColorTriplet& hsv);
 
+        // Batch variants - convert count triplets per call.  An array of
+        // GsColorTriplets is a packed, interleaved float block, so these also
+        // serve as the interleaved-pixel-block API.  On aarch64 the rgb->hsv
+        // sweep runs four triplets at a time with NEON; the element-by-element
+        // routines above are kept as the reference implementations for
+        // exactness comparisons.
+        static void rgb_to_hsv_batch(const GsColorTriplet* rgb, GsColorTriplet* hsv, size_t count);
+        static void hsv_to_rgb_batch(const GsColorTriplet* hsv, GsColorTriplet* rgb, size_t count);
+
     private:
         const static float kOneThird;
         const static float kOneSixth;
@@ -230,6 +230,9 @@ Options::Options()
 			"Set the preview window dimensions, given as x,y,width,height e.g. 0,0,640,480")
 		("fullscreen,f", value<bool>(&fullscreen)->default_value(false)->implicit_value(true),
 			"Use a fullscreen preview window")
+		("preview-max-fps", value<float>(&preview_max_fps)->default_value(0.0),
+			"Cap the preview display rate at this many frames per second (0 = show every frame). "
+			"Excess frames are dropped before they are queued, so the capture/watcher rate is unaffected")
 		("qt-preview", value<bool>(&qt_preview)->default_value(false)->implicit_value(true),
 			"Use Qt-based preview window (WARNING: causes heavy CPU load, fullscreen not supported)")
 		("hflip", value<bool>(&hflip_)->default_value(false)->implicit_value(true), "Request a horizontal flip transform")
@@ -675,6 +678,8 @@ void Options::Print() const
 		std::cerr << "    preview: " << preview_x << "," << preview_y << "," << preview_width << ","
 					<< preview_height << std::endl;
 	std::cerr << "    qt-preview: " << qt_preview << std::endl;
+	if (preview_max_fps > 0)
+		std::cerr << "    preview-max-fps: " << preview_max_fps << std::endl;
 	std::cerr << "    transform: " << transformToString(transform) << std::endl;
 	if (roi_width == 0 || roi_height == 0)
 		std::cerr << "    roi: all" << std::endl;
@@ -185,6 +185,8 @@ void PostProcessor::Configure()
 	{
 		stage->Configure();
 	}
+
+	stage_stats_.assign(stages_.size(), StageStats());
 }
 
 void PostProcessor::Start()
@@ -212,9 +214,22 @@ void PostProcessor::Process(CompletedRequestPtr &request)
 	std::promise<bool> promise;
 	auto process_fn = [this](CompletedRequestPtr &request, std::promise<bool> promise) {
 		bool drop_request = false;
-		for (auto &stage : stages_)
+		for (unsigned int i = 0; i < stages_.size(); i++)
 		{
-			if (stage->Process(request))
+			// Time each stage so we can report which one limits throughput.
+			// Frames in flight already run through the stage chain on separate
+			// threads, so the slowest stage sets the achievable frame rate.
+			auto start_time = std::chrono::high_resolution_clock::now();
+			bool stage_drop = stages_[i]->Process(request);
+			std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start_time;
+			{
+				std::scoped_lock<std::mutex> stats_lock(stats_mutex_);
+				StageStats &stats = stage_stats_[i];
+				stats.total_time += elapsed;
+				stats.max_time = std::max(stats.max_time, elapsed);
+				stats.frames++;
+			}
+			if (stage_drop)
 			{
 				drop_request = true;
 				break;
@@ -274,6 +289,16 @@ void PostProcessor::Stop()
 	}
 
 	output_thread_.join();
+
+	// All the processing threads have drained, so the stats are stable now.
+	for (unsigned int i = 0; i < stages_.size(); i++)
+	{
+		StageStats const &stats = stage_stats_[i];
+		if (stats.frames)
+			LOG(2, "Stage \"" << stages_[i]->Name() << "\": " << stats.frames << " frames, average "
+							  << stats.total_time.count() * 1000 / stats.frames << "ms, worst "
+							  << stats.max_time.count() * 1000 << "ms");
+	}
 }
 
 void PostProcessor::Teardown()
@@ -87,4 +87,16 @@ private:
 	PostProcessorCallback callback_;
 	std::mutex mutex_;
 	std::condition_variable cv_;
+
+	// Per-stage timing, accumulated across the (parallel) per-frame processing
+	// threads and reported when we stop. The stage with the largest average is
+	// the one limiting the achievable frame rate.
+	struct StageStats
+	{
+		std::chrono::duration<double> total_time{ 0 };
+		std::chrono::duration<double> max_time{ 0 };
+		unsigned int frames = 0;
+	};
+	std::vector<StageStats> stage_stats_;
+	std::mutex stats_mutex_;
 };
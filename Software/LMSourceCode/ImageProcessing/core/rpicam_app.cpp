@@ -838,6 +838,10 @@ void RPiCamApp::StartCamera()
 
 	for (std::unique_ptr<Request> &request : requests_)
 	{
+		{
+			std::lock_guard<std::mutex> lock(request_stats_mutex_);
+			request_queue_times_[request.get()] = std::chrono::steady_clock::now();
+		}
 		if (camera_->queueRequest(request.get()) < 0)
 			throw std::runtime_error("Failed to queue request");
 	}
@@ -874,6 +878,20 @@ void RPiCamApp::StopCamera()
 
 	controls_.clear(); // no need for mutex here
 
+	{
+		std::lock_guard<std::mutex> lock(request_stats_mutex_);
+		if (request_latency_count_)
+			LOG(2, "Request completion latency: mean "
+					   << request_latency_sum_ms_ / request_latency_count_ << "ms, max " << request_latency_max_ms_
+					   << "ms over " << request_latency_count_ << " requests; max requests held by app: "
+					   << max_requests_held_);
+		request_queue_times_.clear();
+		request_latency_sum_ms_ = 0.0;
+		request_latency_max_ms_ = 0.0;
+		request_latency_count_ = 0;
+		max_requests_held_ = 0;
+	}
+
 	if (!options_->help)
 		LOG(2, "Camera stopped!");
 }
@@ -935,6 +953,11 @@ void RPiCamApp::queueRequest(CompletedRequest *completed_request)
 		request->controls() = std::move(controls_);
 	}
 
+	{
+		std::lock_guard<std::mutex> lock(request_stats_mutex_);
+		request_queue_times_[request] = std::chrono::steady_clock::now();
+	}
+
 	if (camera_->queueRequest(request) < 0)
 		throw std::runtime_error("failed to queue request");
 }
@@ -1001,6 +1024,23 @@ const libcamera::CameraManager *RPiCamApp::GetCameraManager()
 void RPiCamApp::ShowPreview(CompletedRequestPtr &completed_request, Stream *stream)
 {
 	std::lock_guard<std::mutex> lock(preview_item_mutex_);
+
+	// If a display rate cap has been requested, drop excess frames here, before
+	// the shared_ptr is copied or the preview thread is woken.  The buffer goes
+	// straight back to the camera, so capture runs at full rate regardless of
+	// how fast the preview window can (or needs to) redraw.
+	if (options_->preview_max_fps > 0)
+	{
+		auto now = std::chrono::steady_clock::now();
+		std::chrono::duration<double> min_interval(1.0 / options_->preview_max_fps);
+		if (now - preview_last_frame_time_ < min_interval)
+		{
+			preview_frames_dropped_++;
+			return;
+		}
+		preview_last_frame_time_ = now;
+	}
+
 	if (!preview_item_.stream)
 		preview_item_ = PreviewItem(completed_request, stream); // copy the shared_ptr here
 	else
@@ -1053,6 +1093,8 @@ void RPiCamApp::setupCapture()
 
 	// Next allocate all the buffers we need, mmap them and store them on a free list.
 
+	bool mlock_warned = false;
+
 	for (StreamConfiguration &config : *configuration_)
 	{
 		Stream *stream = config.stream();
@@ -1073,6 +1115,16 @@ void RPiCamApp::setupCapture()
 
 			fb.push_back(std::make_unique<FrameBuffer>(plane));
 			void *memory = mmap(NULL, config.frameSize, PROT_READ | PROT_WRITE, MAP_SHARED, plane[0].fd.get(), 0);
+
+			// Pre-fault and pin the buffer pages now, at configuration time, so the
+			// first frames through a freshly-started camera don't eat page faults on
+			// the capture path.  Best effort - mlock can fail under RLIMIT_MEMLOCK.
+			if (memory != MAP_FAILED && mlock(memory, config.frameSize) < 0 && !mlock_warned)
+			{
+				LOG(1, "Could not lock capture buffers into memory (check RLIMIT_MEMLOCK)");
+				mlock_warned = true;
+			}
+
 			mapped_buffers_[fb.back().get()].push_back(
 						libcamera::Span<uint8_t>(static_cast<uint8_t *>(memory), config.frameSize));
 		}
@@ -1155,6 +1207,27 @@ void RPiCamApp::requestComplete(Request *request)
 	{
 		std::lock_guard<std::mutex> lock(completed_requests_mutex_);
 		completed_requests_.insert(r);
+		// Queue occupancy: how many requests the application is sitting on.  If
+		// this ever reaches the stream's buffer count, the next frame drops.
+		if (completed_requests_.size() > max_requests_held_)
+			max_requests_held_ = (unsigned int)completed_requests_.size();
+	}
+
+	{
+		// Request-completion latency: queueRequest to completion, covering both the
+		// camera's own latency and any time spent waiting behind held buffers.
+		std::lock_guard<std::mutex> lock(request_stats_mutex_);
+		auto it = request_queue_times_.find(request);
+		if (it != request_queue_times_.end())
+		{
+			double latency_ms =
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - it->second).count();
+			request_latency_sum_ms_ += latency_ms;
+			if (latency_ms > request_latency_max_ms_)
+				request_latency_max_ms_ = latency_ms;
+			request_latency_count_++;
+			request_queue_times_.erase(it);
+		}
 	}
 
 	// We calculate the instantaneous framerate in case anyone wants it.
@@ -1228,9 +1301,6 @@ void RPiCamApp::previewThread()
 		BufferReadSync r(this, buffer);
 		libcamera::Span span = r.Get()[0];
 
-		// Fill the frame info with the ControlList items and ancillary bits.
-		FrameInfo frame_info(item.completed_request);
-
 		int fd = buffer->planes()[0].fd.get();
 		{
 			std::lock_guard<std::mutex> lock(preview_mutex_);
@@ -1246,6 +1316,9 @@ void RPiCamApp::previewThread()
 		preview_->Show(fd, span, info);
 		if (!options_->info_text.empty())
 		{
+			// Only pay for the metadata unpack and formatting when there is
+			// info text to display - the DRM/null previews never show any.
+			FrameInfo frame_info(item.completed_request);
 			std::string s = frame_info.ToString(options_->info_text);
 			preview_->SetInfoText(s);
 		}
@@ -9,6 +9,7 @@
 
 #include <sys/mman.h>
 
+#include <chrono>
 #include <condition_variable>
 #include <iostream>
 #include <memory>
@@ -276,10 +277,18 @@ private:
 	bool preview_abort_ = false;
 	uint32_t preview_frames_displayed_ = 0;
 	uint32_t preview_frames_dropped_ = 0;
+	std::chrono::steady_clock::time_point preview_last_frame_time_;
 	std::thread preview_thread_;
 	// For setting camera controls.
 	std::mutex control_mutex_;
 	ControlList controls_;
+	// Request/buffer instrumentation.
+	std::mutex request_stats_mutex_;
+	std::map<Request *, std::chrono::steady_clock::time_point> request_queue_times_;
+	double request_latency_sum_ms_ = 0.0;
+	double request_latency_max_ms_ = 0.0;
+	uint64_t request_latency_count_ = 0;
+	unsigned int max_requests_held_ = 0;
 	// Other:
 	uint64_t last_timestamp_;
 	uint64_t sequence_ = 0;
@@ -8,25 +8,6 @@
 
 namespace golf_sim {
 
-    double CvUtils::CircleRadius(const GsCircle& circle)
-    {
-        return ((double) circle[2]);
-    }
-
-    cv::Vec2i CvUtils::CircleXY(const GsCircle& circle)
-    {
-        return (cv::Vec2i((int)std::round(circle[0]), (int)std::round(circle[1])));
-    }
-
-    int CvUtils::CircleX(const GsCircle& circle) {
-        return ((int)std::round(circle[0]));
-    }
-
-    int CvUtils::CircleY(const GsCircle& circle) {
-        return ((int)std::round(circle[1]));
-    }
-
-
     cv::Vec2i CvUtils::CvSize(const cv::Mat& img)
     {
         return (cv::Vec2i(img.cols, img.rows));
@@ -68,8 +49,27 @@ namespace golf_sim {
         return (hsv);
     }
 
+    std::vector<GsColorTriplet> CvUtils::ConvertRgbToHsvBatch(const std::vector<GsColorTriplet>& rgb)
+    {
+        // Stage the same BGR re-ordering and 0-1 scaling the scalar wrapper
+        // performs, then convert the whole set in one colorsys batch call
+        std::vector<GsColorTriplet> rgb_unscaled(rgb.size());
+        for (size_t i = 0; i < rgb.size(); i++) {
+            rgb_unscaled[i] = GsColorTriplet(rgb[i][2] / 255, rgb[i][1] / 255, rgb[i][0] / 255);
+        }
 
-    // Note that the hsv value will be stored in openCV format 
+        std::vector<GsColorTriplet> hsv(rgb.size());
+        colorsys::rgb_to_hsv_batch(rgb_unscaled.data(), hsv.data(), rgb_unscaled.size());
+
+        for (size_t i = 0; i < hsv.size(); i++) {
+            hsv[i] = GsColorTriplet(hsv[i][0] * (float)kOpenCvHueMax, hsv[i][1] * (float)kOpenCvSatMax, hsv[i][2] * (float)kOpenCvValMax);
+        }
+
+        return (hsv);
+    }
+
+
+    // Note that the hsv value will be stored in openCV format
     GsColorTriplet CvUtils::ConvertHsvToRgb(const GsColorTriplet& hsv)
     {
         GsColorTriplet rgbUnscaled = colorsys::hsv_to_rgb(GsColorTriplet( hsv[0] / (float)kOpenCvHueMax, hsv[1] / (float)kOpenCvSatMax, hsv[2] / (float)kOpenCvValMax ));
@@ -321,15 +321,6 @@ namespace golf_sim {
         return subImg;
     }
 
-    double CvUtils::GetDistance(const cv::Vec3d& location) {
-        return std::sqrt(std::pow(location[0], 2.) + std::pow(location[1], 2.) + std::pow(location[2], 2.));
-    }
-
-    double CvUtils::GetDistance(const cv::Point& point1, const cv::Point& point2) {
-        return std::sqrt(std::pow(std::abs(point1.x - point2.x), 2.) + std::pow(std::abs(point1.y - point2.y), 2.));
-    }
-
-
 void CvUtils::BrightnessAndContrastAutoAlgo2(const cv::Mat& bgr_image, cv::Mat& dst) {
     cv::Mat lab_image;
     cv::cvtColor(bgr_image, lab_image, cv::COLOR_BGR2Lab);
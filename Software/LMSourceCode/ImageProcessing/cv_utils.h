@@ -12,6 +12,7 @@
 
 #include <string_view>
 #include <algorithm>
+#include <cmath>
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -30,11 +31,14 @@ struct CvUtils
 	const static std::byte kOpenCvSatMax{ 255 };
     const static std::byte kOpenCvValMax{ 255 };
 
-    static double CircleRadius(const GsCircle& circle);
+    // The circle accessors are header-only so the per-candidate scoring loops
+    // can inline them.  (OpenCV's Vec accessors are not constexpr, so inline
+    // is as far as these can go.)
+    static double inline CircleRadius(const GsCircle& circle) { return ((double)circle[2]); }
 
-    static cv::Vec2i CircleXY(const GsCircle& circle);
-    static int CircleX(const GsCircle& circle);
-    static int CircleY(const GsCircle& circle);
+    static cv::Vec2i inline CircleXY(const GsCircle& circle) { return (cv::Vec2i((int)std::round(circle[0]), (int)std::round(circle[1]))); }
+    static int inline CircleX(const GsCircle& circle) { return ((int)std::round(circle[0])); }
+    static int inline CircleY(const GsCircle& circle) { return ((int)std::round(circle[1])); }
 
     static cv::Vec2i CvSize(const cv::Mat& img);
 
@@ -54,6 +58,11 @@ struct CvUtils
     // Note that the rgb value will be stored in openCV format - i.e., as bgr
     static GsColorTriplet ConvertRgbToHsv(const GsColorTriplet& rgb);
 
+    // Batch shape of ConvertRgbToHsv for whole candidate sets - same BGR
+    // ordering and OpenCV scaling, converted through the NEON-backed
+    // colorsys batch sweep
+    static std::vector<GsColorTriplet> ConvertRgbToHsvBatch(const std::vector<GsColorTriplet>& rgb);
+
     // Note that the hsv value will be stored in openCV format 
     static GsColorTriplet ConvertHsvToRgb(const GsColorTriplet& hsv);
 
@@ -75,8 +84,12 @@ struct CvUtils
     static double MetersPerSecondToMPH(double mps);
     static double MetersToYards(double m);
 
-    static double GetDistance(const cv::Vec3d& location);
-    static double GetDistance(const cv::Point& point1, const cv::Point& point2);
+    static double inline GetDistance(const cv::Vec3d& location) {
+        return std::sqrt(std::pow(location[0], 2.) + std::pow(location[1], 2.) + std::pow(location[2], 2.));
+    }
+    static double inline GetDistance(const cv::Point& point1, const cv::Point& point2) {
+        return std::sqrt(std::pow(std::abs(point1.x - point2.x), 2.) + std::pow(std::abs(point1.y - point2.y), 2.));
+    }
 
     // Size the result image to the size of the image_to_size
     static void SetMatSize(const cv::Mat& image_to_size, cv::Mat & result_image);
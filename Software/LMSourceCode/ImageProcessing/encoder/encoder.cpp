@@ -15,6 +15,7 @@
 #include "encoder.hpp"
 #include "h264_encoder.hpp"
 #include "mjpeg_encoder.hpp"
+#include "mjpeg_hw_encoder.hpp"
 #include "null_encoder.hpp"
 
 #if LIBAV_PRESENT
@@ -35,6 +36,26 @@ static Encoder *h264_codec_select(VideoOptions *options, const StreamInfo &info)
 	throw std::runtime_error("Unable to find an appropriate H.264 codec");
 }
 
+static Encoder *mjpeg_codec_select(VideoOptions *options, const StreamInfo &info)
+{
+	// Prefer the V4L2 hardware codec where one exists - it imports the camera
+	// DMABUF directly, avoiding the per-frame copy through libjpeg.
+	if (options->GetPlatform() == Platform::VC4)
+	{
+		try
+		{
+			return new MjpegHwEncoder(options, info);
+		}
+		catch (std::exception const &e)
+		{
+			LOG(1, "Hardware MJPEG codec unavailable (" << e.what() << "), using software encoder");
+		}
+	}
+
+	// No JPEG codec node (e.g. Pi 5) - encode in software.
+	return new MjpegEncoder(options);
+}
+
 #if LIBAV_PRESENT
 static Encoder *libav_codec_select(VideoOptions *options, const StreamInfo &info)
 {
@@ -60,6 +81,6 @@ Encoder *Encoder::Create(VideoOptions *options, const StreamInfo &info)
 		return libav_codec_select(options, info);
 #endif
 	else if (strcasecmp(options->codec.c_str(), "mjpeg") == 0)
-		return new MjpegEncoder(options);
+		return mjpeg_codec_select(options, info);
 	throw std::runtime_error("Unrecognised codec " + options->codec);
 }
@@ -7,6 +7,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <vector>
 
 #include <jpeglib.h>
 
@@ -39,23 +40,68 @@ MjpegEncoder::~MjpegEncoder()
 
 void MjpegEncoder::EncodeBuffer(int fd, size_t size, void *mem, StreamInfo const &info, int64_t timestamp_us)
 {
+	// Split the frame into horizontal stripes so that a single frame can be
+	// encoded on all the threads at once. Every stripe except possibly the
+	// last must cover the same number of 16-row MCU bands, as the restart
+	// interval that makes the stitched entropy data legal is a single value
+	// for the whole scan.
+	unsigned int mcu_rows = (info.height + 15) / 16;
+	unsigned int num_stripes = std::min((unsigned int)NUM_ENC_THREADS, mcu_rows);
+	unsigned int rows_per_stripe = (mcu_rows + num_stripes - 1) / num_stripes;
+	num_stripes = (mcu_rows + rows_per_stripe - 1) / rows_per_stripe;
+	unsigned int restart_interval = ((info.width + 15) / 16) * rows_per_stripe;
+	// The restart interval is a 16 bit field, so enormous frames go as one stripe.
+	if (restart_interval > 65535)
+	{
+		num_stripes = 1;
+		rows_per_stripe = mcu_rows;
+	}
+
 	std::lock_guard<std::mutex> lock(encode_mutex_);
-	EncodeItem item = { mem, info, timestamp_us, index_++ };
-	encode_queue_.push(item);
+	for (unsigned int stripe = 0; stripe < num_stripes; stripe++)
+	{
+		unsigned int y_offset = stripe * rows_per_stripe * 16;
+		unsigned int slice_height = std::min(rows_per_stripe * 16, info.height - y_offset);
+		EncodeItem item = { mem, info, timestamp_us, index_, stripe, num_stripes,
+							y_offset, slice_height, num_stripes > 1 ? restart_interval : 0 };
+		encode_queue_.push(item);
+	}
+	index_++;
 	encode_cond_var_.notify_all();
 }
 
+// Step through the marker segments of a freshly encoded JPEG and return the
+// offset of the given marker, or zero if it is not found.
+static size_t find_marker(uint8_t const *buf, size_t len, uint8_t marker)
+{
+	size_t pos = 2; // skip the SOI
+	while (pos + 4 <= len && buf[pos] == 0xff)
+	{
+		if (buf[pos + 1] == marker)
+			return pos;
+		if (buf[pos + 1] == 0xda) // entropy-coded data follows the SOS segment
+			break;
+		pos += 2 + ((buf[pos + 2] << 8) | buf[pos + 3]);
+	}
+	return 0;
+}
+
 void MjpegEncoder::encodeJPEG(struct jpeg_compress_struct &cinfo, EncodeItem &item, uint8_t *&encoded_buffer,
 							  size_t &buffer_len)
 {
-	// Copied from YUV420_to_JPEG_fast in jpeg.cpp.
+	// Copied from YUV420_to_JPEG_fast in jpeg.cpp, but encoding only this
+	// item's stripe of the frame. Quality and the default tables are the same
+	// for every stripe, so the headers of all but the first can be discarded.
 	cinfo.image_width = item.info.width;
-	cinfo.image_height = item.info.height;
+	cinfo.image_height = item.slice_height;
 	cinfo.input_components = 3;
 	cinfo.in_color_space = JCS_YCbCr;
-	cinfo.restart_interval = 0;
 
 	jpeg_set_defaults(&cinfo);
+	// Must come after jpeg_set_defaults, which resets the interval to 0.
+	// This is what emits the DRI segment that makes the spliced RSTn
+	// markers between the stitched stripes legal.
+	cinfo.restart_interval = item.restart_interval;
 	cinfo.raw_data_in = TRUE;
 	jpeg_set_quality(&cinfo, options_->quality, TRUE);
 	encoded_buffer = nullptr;
@@ -65,18 +111,21 @@ void MjpegEncoder::encodeJPEG(struct jpeg_compress_struct &cinfo, EncodeItem &it
 	jpeg_start_compress(&cinfo, TRUE);
 
 	int stride2 = item.info.stride / 2;
-	uint8_t *Y = (uint8_t *)item.mem;
-	uint8_t *U = (uint8_t *)Y + item.info.stride * item.info.height;
-	uint8_t *V = (uint8_t *)U + stride2 * (item.info.height / 2);
-	uint8_t *Y_max = U - item.info.stride;
-	uint8_t *U_max = V - stride2;
+	uint8_t *frame_Y = (uint8_t *)item.mem;
+	uint8_t *frame_U = frame_Y + item.info.stride * item.info.height;
+	uint8_t *frame_V = frame_U + stride2 * (item.info.height / 2);
+	uint8_t *Y = frame_Y + item.info.stride * item.y_offset;
+	uint8_t *U = frame_U + stride2 * (item.y_offset / 2);
+	uint8_t *V = frame_V + stride2 * (item.y_offset / 2);
+	uint8_t *Y_max = frame_U - item.info.stride;
+	uint8_t *U_max = frame_V - stride2;
 	uint8_t *V_max = U_max + stride2 * (item.info.height / 2);
 
 	JSAMPROW y_rows[16];
 	JSAMPROW u_rows[8];
 	JSAMPROW v_rows[8];
 
-	for (uint8_t *Y_row = Y, *U_row = U, *V_row = V; cinfo.next_scanline < item.info.height;)
+	for (uint8_t *Y_row = Y, *U_row = U, *V_row = V; cinfo.next_scanline < item.slice_height;)
 	{
 		for (int i = 0; i < 16; i++, Y_row += item.info.stride)
 			y_rows[i] = std::min(Y_row, Y_max);
@@ -111,7 +160,7 @@ void MjpegEncoder::encodeThread(int num)
 				if (abortEncode_ && encode_queue_.empty())
 				{
 					if (frames)
-						LOG(2, "Encode " << frames << " frames, average time " << encode_time.count() * 1000 / frames
+						LOG(2, "Encode " << frames << " stripes, average time " << encode_time.count() * 1000 / frames
 										 << "ms");
 					jpeg_destroy_compress(&cinfo);
 					return;
@@ -140,7 +189,32 @@ void MjpegEncoder::encodeThread(int num)
 		// We push this encoded buffer to another thread so that our
 		// application can take its time with the data without blocking the
 		// encode process.
-		OutputItem output_item = { encoded_buffer, buffer_len, encode_item.timestamp_us, encode_item.index };
+		OutputItem output_item = { encoded_buffer, buffer_len, encode_item.timestamp_us, encode_item.index,
+								   encode_item.stripe, encode_item.num_stripes, 0 };
+		if (encode_item.num_stripes > 1)
+		{
+			// Drop the EOI; the stitched frame gets a single one at the end.
+			output_item.bytes_used -= 2;
+			if (encode_item.stripe == 0)
+			{
+				// The first stripe supplies the frame header - patch its SOF
+				// height up to the full frame height.
+				size_t sof = find_marker(encoded_buffer, buffer_len, 0xc0);
+				if (!sof)
+					sof = find_marker(encoded_buffer, buffer_len, 0xc1);
+				if (sof)
+				{
+					encoded_buffer[sof + 5] = encode_item.info.height >> 8;
+					encoded_buffer[sof + 6] = encode_item.info.height & 0xff;
+				}
+			}
+			else
+			{
+				// Later stripes contribute only their entropy-coded data.
+				size_t sos = find_marker(encoded_buffer, buffer_len, 0xda);
+				output_item.entropy_offset = sos + 2 + ((encoded_buffer[sos + 2] << 8) | encoded_buffer[sos + 3]);
+			}
+		}
 		std::lock_guard<std::mutex> lock(output_mutex_);
 		output_queue_[num].push(output_item);
 		output_cond_var_.notify_one();
@@ -151,6 +225,8 @@ void MjpegEncoder::outputThread()
 {
 	OutputItem item;
 	uint64_t index = 0;
+	unsigned int stripe = 0;
+	std::vector<uint8_t> frame;
 	while (true)
 	{
 		{
@@ -158,7 +234,7 @@ void MjpegEncoder::outputThread()
 			while (true)
 			{
 				using namespace std::chrono_literals;
-				// We look for the thread that's completed the frame we want next.
+				// We look for the thread that's completed the stripe we want next.
 				// If we don't find it, we wait.
 				//
 				// Must also check for an abort signal, and if set, all queues must
@@ -170,7 +246,7 @@ void MjpegEncoder::outputThread()
 					if (abort && !q.empty())
 						abort = false;
 
-					if (!q.empty() && q.front().index == index)
+					if (!q.empty() && q.front().index == index && q.front().stripe == stripe)
 					{
 						item = q.front();
 						q.pop();
@@ -184,10 +260,40 @@ void MjpegEncoder::outputThread()
 			}
 		}
 	got_item:
-		input_done_callback_(nullptr);
+		if (item.num_stripes == 1)
+		{
+			input_done_callback_(nullptr);
 
-		output_ready_callback_(item.mem, item.bytes_used, item.timestamp_us, true);
-		free(item.mem);
-		index++;
+			output_ready_callback_(item.mem, item.bytes_used, item.timestamp_us, true);
+			free(item.mem);
+			index++;
+		}
+		else
+		{
+			// Stitch the stripes back into a single JPEG. A restart marker at
+			// each join resets the decoder's DC predictors, which is what makes
+			// the independently encoded entropy segments legal back to back.
+			uint8_t *mem = (uint8_t *)item.mem;
+			if (item.stripe == 0)
+				frame.clear();
+			else
+			{
+				frame.push_back(0xff);
+				frame.push_back(0xd0 + ((item.stripe - 1) & 7));
+			}
+			frame.insert(frame.end(), mem + item.entropy_offset, mem + item.bytes_used);
+			free(item.mem);
+			if (++stripe == item.num_stripes)
+			{
+				frame.push_back(0xff); // EOI
+				frame.push_back(0xd9);
+				// Only now have all the encode threads finished with the input.
+				input_done_callback_(nullptr);
+
+				output_ready_callback_(frame.data(), frame.size(), item.timestamp_us, true);
+				stripe = 0;
+				index++;
+			}
+		}
 	}
 }
@@ -40,12 +40,21 @@ private:
 	bool abortOutput_;
 	uint64_t index_;
 
+	// Frames are split into horizontal stripes (each a whole number of 16-row
+	// MCU bands) so that a single frame can be spread across all the encode
+	// threads at once. The stripes are stitched back into one JPEG, with
+	// restart markers at the joins, in the output thread.
 	struct EncodeItem
 	{
 		void *mem;
 		StreamInfo info;
 		int64_t timestamp_us;
 		uint64_t index;
+		unsigned int stripe;
+		unsigned int num_stripes;
+		unsigned int y_offset;
+		unsigned int slice_height;
+		unsigned int restart_interval;
 	};
 	std::queue<EncodeItem> encode_queue_;
 	std::mutex encode_mutex_;
@@ -59,6 +68,11 @@ private:
 		size_t bytes_used;
 		int64_t timestamp_us;
 		uint64_t index;
+		unsigned int stripe;
+		unsigned int num_stripes;
+		// Where the entropy-coded data starts; everything before it is header
+		// and is discarded for all but the first stripe of a frame.
+		size_t entropy_offset;
 	};
 	std::queue<OutputItem> output_queue_[NUM_ENC_THREADS];
 	std::mutex output_mutex_;
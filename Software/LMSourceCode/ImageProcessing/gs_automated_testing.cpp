@@ -13,7 +13,13 @@
 
 
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
 
 #include <boost/timer/timer.hpp>
 #include <boost/filesystem.hpp>
@@ -21,9 +27,12 @@
 #include <opencv2/calib3d/calib3d.hpp>
 
 #include "gs_config.h"
+#include "gs_options.h"
+#include "gs_raw_frame.h"
 #include "pulse_strobe.h"
 
 #include "gs_automated_testing.h"
+#include "gs_image_io.h"
 
 
 namespace fs = boost::filesystem;
@@ -194,7 +203,271 @@ std::vector<std::string> GsAutomatedTesting::get_files_by_wildcard(const std::st
 }
 
 
-bool GsAutomatedTesting::TestFinalShotResultData() {
+/**
+ * Runs a single automated test scenario - reads the scenario's images, pushes them
+ * through the same camera-2 processing used for live shots, and compares the results
+ * to the expected values.  The image-processing caches this path exercises are all
+ * mutex-guarded, which is what allows TestFinalShotResultData to fan the corpus out
+ * across cores.
+ *
+ * \param test The scenario to run.  The image filenames must already be resolved.
+ * \param tolerances The comparison tolerances from the .json configuration file
+ * \return The outcome, including pass/fail, wall-clock timing, and the pre-formatted
+ * results-CSV row for the scenario.
+ */
+GsAutomatedTesting::FinalResultsTestOutcome GsAutomatedTesting::RunFinalShotResultTest(const FinalResultsTestScenario& test, const GsResults& tolerances) {
+
+    FinalResultsTestOutcome outcome;
+
+    auto start_time = std::chrono::steady_clock::now();
+
+    GS_LOG_TRACE_MSG(info, "Starting Test No. " + std::to_string(test.test_index) + ".");
+
+    CameraHardware::CameraModel  camera_model = CameraHardware::PiGS;
+
+    const std::string teed_ball_image_filename = test.teed_ball_filename;
+    const std::string strobed_balls_image_filename = test.strobed_ball_filename;
+    // The (simulated) camera and ball position will depend on the test images we use, above.
+
+    // NOTE - These tests are expected to be run using the same .json configuration file
+    // with which the original images were captured.
+
+    cv::Mat teed_ball_ImgGray;
+    cv::Mat strobed_balls_ImgGray;
+    cv::Mat teed_ball_ImgColor;
+    cv::Mat strobed_balls_ImgColor;
+
+    if (!GsAutomatedTesting::ReadTestImages(teed_ball_image_filename, strobed_balls_image_filename,
+                            teed_ball_ImgGray, strobed_balls_ImgGray, teed_ball_ImgColor, strobed_balls_ImgColor, camera_model, false /* No undistort)*/, true /* do_not_alter_filenames */)) {
+        GS_LOG_TRACE_MSG(warning, "Failed to read valid images for Test No. " + std::to_string(test.test_index));
+        return outcome;
+    }
+
+    // Run the test using whatever current .json configuration we have
+
+    GolfBall result_ball;
+    cv::Vec3d rotation_results;
+    cv::Mat exposures_image;
+    cv::Mat dummy_pre_image;
+    std::vector<GolfBall> exposure_balls;
+
+    if (!GolfSimCamera::ProcessReceivedCam2Image(teed_ball_ImgColor,
+                                                 strobed_balls_ImgColor,
+                                                 dummy_pre_image,
+                                                 result_ball,
+                                                 rotation_results,
+                                                 exposures_image,
+                                                 exposure_balls)) {
+        GS_LOG_TRACE_MSG(warning, "Failed to ProcessReceivedCam2Image() for Test No. " + std::to_string(test.test_index));
+        return outcome;
+    }
+
+    result_ball.PrintBallFlightResults();
+
+    outcome.ran = true;
+
+    // The analysis just ran (entirely) on this thread, so the thread-local stage
+    // timings it recorded belong to this test case
+    outcome.strobed_analysis_ms = GolfSimCamera::last_strobed_analysis_time_ms_;
+    outcome.spin_analysis_ms = GolfSimCamera::last_spin_analysis_time_ms_;
+
+    // Compare the results to the expected results
+    bool test_passed = true;
+
+    if (!AbsResultsPass((float)CvUtils::MetersPerSecondToMPH((float)result_ball.velocity_), test.expected_results.speed_mph_, (float)tolerances.speed_mph_)) {
+        GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball shot speed measurement.");
+        test_passed = false;
+    }
+
+    if (!AbsResultsPass( (float)result_ball.angles_ball_perspective_[0], test.expected_results.hla_deg_, (float)tolerances.hla_deg_)) {
+        GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball HLA measurement.");
+        test_passed = false;
+    }
+
+    if (!AbsResultsPass((float)result_ball.angles_ball_perspective_[1], test.expected_results.vla_deg_, (float)tolerances.vla_deg_)) {
+        GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball VLA measurement.");
+        test_passed = false;
+    }
+
+    if (!AbsResultsPass( (int)result_ball.rotation_speeds_RPM_[2], test.expected_results.back_spin_rpm_, tolerances.back_spin_rpm_)) {
+        GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball back spin measurement.");
+        test_passed = false;
+    }
+
+    if (!AbsResultsPass((int)result_ball.rotation_speeds_RPM_[0], test.expected_results.side_spin_rpm_, tolerances.side_spin_rpm_)) {
+        GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball side spin measurement.");
+        test_passed = false;
+    }
+
+    outcome.passed = test_passed;
+
+    // Save the results (both the actual numbers and the differences) for the csv file
+    std::ostringstream csv_row;
+    csv_row << ",";
+    csv_row << test.shot_number << ",";
+
+    float speed_mph_delta = (float)CvUtils::MetersPerSecondToMPH((float)result_ball.velocity_) - test.expected_results.speed_mph_;
+    float hla_deg_delta = (float)(result_ball.angles_ball_perspective_[0] - test.expected_results.hla_deg_);
+    float vla_deg_delta = (float)(result_ball.angles_ball_perspective_[1] - test.expected_results.vla_deg_);
+    int back_spin_rpm_delta = (int)(result_ball.rotation_speeds_RPM_[2] - test.expected_results.back_spin_rpm_);
+    int side_spin_rpm_delta = (int)(result_ball.rotation_speeds_RPM_[0] - test.expected_results.side_spin_rpm_);
+
+    csv_row << speed_mph_delta << ",";
+    csv_row << hla_deg_delta << ",";
+    csv_row << vla_deg_delta << ",";
+    csv_row << back_spin_rpm_delta << ",";
+    csv_row << side_spin_rpm_delta << ", ,";
+
+    csv_row << test.expected_results.speed_mph_ << "," << CvUtils::MetersPerSecondToMPH((float)result_ball.velocity_) << ", ,";
+    csv_row << test.expected_results.vla_deg_ << "," << result_ball.angles_ball_perspective_[1] << ", ,";
+    csv_row << test.expected_results.hla_deg_ << "," << result_ball.angles_ball_perspective_[0] << ", ,";
+    csv_row << test.expected_results.back_spin_rpm_ << "," << result_ball.rotation_speeds_RPM_[2] << ", ,";
+    csv_row << test.expected_results.side_spin_rpm_ << "," << result_ball.rotation_speeds_RPM_[0] << ",";
+    csv_row << (test_passed? "PASS" : "FAIL") << std::endl;
+    csv_row << " , , , ," << std::endl;
+
+    outcome.csv_row = csv_row.str();
+
+    outcome.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    return outcome;
+}
+
+
+/**
+ * Compares the timings from the current corpus run to the golden timings recorded in
+ * the given CSV file and flags any case whose detection, spin, or total time got more
+ * than tolerance_percent slower.  If the golden file does not exist yet, this run's
+ * timings are recorded as the new golden baseline instead (delete the file after an
+ * intentional performance change to re-baseline).
+ *
+ * \param golden_timings_filename Full path of the golden timings CSV file
+ * \param tolerance_percent How much slower (in percent) a timing may be before it is flagged
+ * \param tests The corpus scenarios, parallel to the outcomes
+ * \param outcomes The outcomes of the current run (cases that did not run are skipped)
+ * \return The number of flagged performance regressions (0 when recording a new baseline)
+ */
+int GsAutomatedTesting::CheckPerformanceAgainstGoldenTimings(const std::string& golden_timings_filename,
+                            double tolerance_percent,
+                            const std::vector<FinalResultsTestScenario>& tests,
+                            const std::vector<FinalResultsTestOutcome>& outcomes) {
+
+    struct GoldenTiming {
+        double strobed_analysis_ms = 0.0;
+        double spin_analysis_ms = 0.0;
+        double total_ms = 0.0;
+    };
+
+    // Timings below this aren't worth flagging - percentages of nearly-nothing
+    // produce noisy failures (e.g., a spin stage that a putting case skips entirely)
+    const double kMinimumComparableMs = 1.0;
+
+    std::ifstream golden_file(golden_timings_filename);
+
+    if (!golden_file.is_open()) {
+        // No baseline yet - record one from this run
+        std::ofstream new_golden_file(golden_timings_filename);
+
+        if (!new_golden_file) {
+            GS_LOG_MSG(error, "CheckPerformanceAgainstGoldenTimings - could not create golden timings file: " + golden_timings_filename);
+            return 0;
+        }
+
+        new_golden_file << "shot_number,strobed_analysis_ms,spin_analysis_ms,total_ms" << std::endl;
+
+        for (size_t i = 0; i < tests.size(); i++) {
+            if (!outcomes[i].ran) {
+                continue;
+            }
+            new_golden_file << tests[i].shot_number << ","
+                << outcomes[i].strobed_analysis_ms << ","
+                << outcomes[i].spin_analysis_ms << ","
+                << (outcomes[i].elapsed_seconds * 1000.0) << std::endl;
+        }
+
+        GS_LOG_MSG(info, "CheckPerformanceAgainstGoldenTimings - no golden timings existed, so this run's timings were recorded to: " +
+            golden_timings_filename + ".  Future runs will be compared against them.");
+
+        return 0;
+    }
+
+    std::map<int, GoldenTiming> golden_timings;
+    std::string line;
+
+    // Skip the column-heading line
+    std::getline(golden_file, line);
+
+    while (std::getline(golden_file, line)) {
+        GoldenTiming golden;
+        int shot_number = 0;
+
+        std::istringstream line_stream(line);
+        char comma;
+        if (line_stream >> shot_number >> comma >> golden.strobed_analysis_ms >> comma >> golden.spin_analysis_ms >> comma >> golden.total_ms) {
+            golden_timings[shot_number] = golden;
+        }
+    }
+
+    golden_file.close();
+
+    int num_regressions = 0;
+
+    for (size_t i = 0; i < tests.size(); i++) {
+
+        const FinalResultsTestScenario& test = tests[i];
+        const FinalResultsTestOutcome& outcome = outcomes[i];
+
+        if (!outcome.ran) {
+            continue;
+        }
+
+        auto golden_iter = golden_timings.find(test.shot_number);
+        if (golden_iter == golden_timings.end()) {
+            GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " (Shot " + std::to_string(test.shot_number) +
+                ") has no golden timings - skipping the performance comparison for it.");
+            continue;
+        }
+
+        const GoldenTiming& golden = golden_iter->second;
+        const double allowed_ratio = 1.0 + tolerance_percent / 100.0;
+        const double total_ms = outcome.elapsed_seconds * 1000.0;
+
+        std::string slower_stages;
+
+        if (golden.strobed_analysis_ms >= kMinimumComparableMs && outcome.strobed_analysis_ms > golden.strobed_analysis_ms * allowed_ratio) {
+            slower_stages += "  detection: " + std::to_string(golden.strobed_analysis_ms) + " -> " + std::to_string(outcome.strobed_analysis_ms) + " ms.";
+        }
+        if (golden.spin_analysis_ms >= kMinimumComparableMs && outcome.spin_analysis_ms > golden.spin_analysis_ms * allowed_ratio) {
+            slower_stages += "  spin: " + std::to_string(golden.spin_analysis_ms) + " -> " + std::to_string(outcome.spin_analysis_ms) + " ms.";
+        }
+        if (golden.total_ms >= kMinimumComparableMs && total_ms > golden.total_ms * allowed_ratio) {
+            slower_stages += "  total: " + std::to_string(golden.total_ms) + " -> " + std::to_string(total_ms) + " ms.";
+        }
+
+        if (!slower_stages.empty()) {
+            num_regressions++;
+            GS_LOG_MSG(warning, "PERFORMANCE REGRESSION - Test No. " + std::to_string(test.test_index) + " (Shot " + std::to_string(test.shot_number) +
+                ") is more than " + std::to_string((int)tolerance_percent) + "% slower than golden:" + slower_stages);
+        }
+    }
+
+    return num_regressions;
+}
+
+
+/**
+ * Loads the automated-test corpus configured in the .json file - the expected results,
+ * comparison tolerances, and the (wildcard-resolved) image filenames for each scenario.
+ * Shared between TestFinalShotResultData and the pitrac_tune parameter-sweep tool.
+ *
+ * \param test_suite_directory Receives the configured test-suite directory
+ * \param tests Receives the corpus scenarios, with the image filenames resolved
+ * \param tolerances Receives the comparison tolerances from the .json configuration file
+ * \return True iff the corpus could be loaded
+ */
+bool GsAutomatedTesting::LoadFinalResultsCorpus(std::string& test_suite_directory,
+                            std::vector<FinalResultsTestScenario>& tests,
+                            GsResults& tolerances) {
 
     std::string kWebServerLastTeedBallImageFilenamePrefix;
     std::string kWebServerCamera2ImageFilenamePrefix;
@@ -204,7 +477,6 @@ bool GsAutomatedTesting::TestFinalShotResultData() {
 
     std::string kAutomatedTestSuiteDirectory;
     std::string kAutomatedTestExpectedResultsCSV;
-    GsResults tolerances;
 
     GolfSimConfiguration::SetConstant("gs_config.testing.kAutomatedTestSuiteDirectory", kAutomatedTestSuiteDirectory);
     GolfSimConfiguration::SetConstant("gs_config.testing.kAutomatedTestExpectedResultsCSV", kAutomatedTestExpectedResultsCSV);
@@ -214,12 +486,11 @@ bool GsAutomatedTesting::TestFinalShotResultData() {
     GolfSimConfiguration::SetConstant("gs_config.testing.kAutomatedTestToleranceBackSpin", tolerances.back_spin_rpm_);
     GolfSimConfiguration::SetConstant("gs_config.testing.kAutomatedTestToleranceSideSpin", tolerances.side_spin_rpm_);
 
+    test_suite_directory = kAutomatedTestSuiteDirectory;
+
     // Create absolute file path(s)
     kAutomatedTestExpectedResultsCSV = kAutomatedTestSuiteDirectory + kAutomatedTestExpectedResultsCSV;
 
-
-    std::vector<FinalResultsTestScenario> tests;
-
     try {
         if (!ReadExpectedResults(kAutomatedTestExpectedResultsCSV, tests)) {
             GS_LOG_MSG(error, "Could not ReadExpectedResults().");
@@ -259,6 +530,20 @@ bool GsAutomatedTesting::TestFinalShotResultData() {
         r.strobed_ball_filename = strobed_ball_filename;
     }
 
+    return true;
+}
+
+
+bool GsAutomatedTesting::TestFinalShotResultData() {
+
+    std::string kAutomatedTestSuiteDirectory;
+    std::vector<FinalResultsTestScenario> tests;
+    GsResults tolerances;
+
+    if (!LoadFinalResultsCorpus(kAutomatedTestSuiteDirectory, tests, tolerances)) {
+        return false;
+    }
+
     // The pulses must be setup so that we can determine, e.g., pulse-ratios for distance and time measurements
 
     if (!PulseStrobe::InitGPIOSystem(nullptr /* Signal handler not needed here */)) {
@@ -275,135 +560,128 @@ bool GsAutomatedTesting::TestFinalShotResultData() {
     std::ofstream testing_results_csv_file(kAutomatedTestSuiteDirectory + kAutomatedTestResultsCSV);
     GS_LOG_TRACE_MSG(trace, "Writing CSV result data to: " + kAutomatedTestResultsCSV);
     testing_results_csv_file << "Shot ID,,Comparison (PiTrac value minus Uneekor),,,,,,System Data,,,,,,,,,,,,,,,,,,," << std::endl;
-    testing_results_csv_file << "Ball, PiTrac Shot, Speed ? (mph), VLA ? , HLA ? �, Back Spin ? (rpm), Side Spin ? (rpm), , Uneekor Speed, PiTrac Speed, , Uneekor VLA�, PiTrac VLA�, , Uneekor HLA�, PiTrac HLA�, , Uneekor Back Spin, PiTrac Back Spin, , Uneekor Side Spin, PiTrac Side Spin, , Ball ID Picture, Spin Ball 1, Spin Ball 2, Test Result Ball, Notes" << std::endl;
-    
+    testing_results_csv_file << "Ball, PiTrac Shot, Speed ? (mph), VLA ? , HLA ? �, Back Spin ? (rpm), Side Spin ? (rpm), , Uneekor Speed, PiTrac Speed, , Uneekor VLA�, PiTrac VLA�, , Uneekor HLA�, PiTrac HLA�, , Uneekor Back Spin, PiTrac Back Spin, , Uneekor Side Spin, PiTrac Side Spin, , Ball ID Picture, Spin Ball 1, Spin Ball 2, Test Result Ball, Notes" << std::endl;
 
-    boost::timer::cpu_timer timer1;
 
-    bool allTestsPassed = true;
-    int numTotalTests = 0;
-    int numTestsFailed = 0;
+    // Sharding allows a long corpus run to be split across machines.  Each instance
+    // runs only the cases where (test_index % shard_count) == shard_index, and skipped
+    // cases produce no CSV rows, so the per-shard result files concatenate cleanly.
+    const int shard_index = GolfSimOptions::GetCommandLineOptions().test_shard_index_;
+    const int shard_count = GolfSimOptions::GetCommandLineOptions().test_shard_count_;
 
-    CameraHardware::CameraModel  camera_model = CameraHardware::PiGS;
+    // 0 (the default) means one worker per core.  Set to 1 to fall back to a
+    // fully-sequential run, e.g., when diagnosing a single failing case.
+    int kAutomatedTestParallelWorkers = 0;
+    GolfSimConfiguration::SetConstant("gs_config.testing.kAutomatedTestParallelWorkers", kAutomatedTestParallelWorkers);
 
-    for (auto& test : tests) {
+    int num_workers = kAutomatedTestParallelWorkers;
+    if (num_workers <= 0) {
+        num_workers = (int)std::thread::hardware_concurrency();
+    }
+    num_workers = std::max(1, std::min(num_workers, (int)tests.size()));
 
-        numTotalTests++;
+    GS_LOG_TRACE_MSG(info, "Running " + std::to_string(tests.size()) + " test(s) on " + std::to_string(num_workers) +
+        " worker(s) as shard " + std::to_string(shard_index) + "/" + std::to_string(shard_count) + ".");
 
-        GS_LOG_TRACE_MSG(info, "Starting Test No. " + std::to_string(test.test_index) + ".");
+    boost::timer::cpu_timer timer1;
 
-        if (test.ignore_shot) {
-            GS_LOG_TRACE_MSG(info, "Ignoring Test No. " + std::to_string(test.test_index) + ".");
+    // Each test case is independent (images in, ball results out), so the cases are
+    // fanned out across a small worker pool.  The outcomes (including the CSV rows)
+    // are indexed by test so that reporting below stays in corpus order.
+    std::vector<FinalResultsTestOutcome> outcomes(tests.size());
+    std::atomic<size_t> next_test_index{ 0 };
 
-            // Just leave a blank line with the shot number
-            testing_results_csv_file << ",";
-            testing_results_csv_file << test.shot_number << "," << std::endl;
-            continue;
-        }
+    auto test_worker = [&]() {
+        for (;;) {
+            size_t i = next_test_index.fetch_add(1);
 
-        const std::string teed_ball_image_filename = test.teed_ball_filename;
-        const std::string strobed_balls_image_filename = test.strobed_ball_filename;
-        // The (simulated) camera and ball position will depend on the test images we use, above.
+            if (i >= tests.size()) {
+                return;
+            }
 
-        // NOTE - These tests are expected to be run using the same .json configuration file
-        // with which the original images were captured.
+            const FinalResultsTestScenario& test = tests[i];
 
-        cv::Mat teed_ball_ImgGray;
-        cv::Mat strobed_balls_ImgGray;
-        cv::Mat teed_ball_ImgColor;
-        cv::Mat strobed_balls_ImgColor;
+            if (test.ignore_shot || (test.test_index % shard_count) != shard_index) {
+                continue;
+            }
 
-        if (!GsAutomatedTesting::ReadTestImages(teed_ball_image_filename, strobed_balls_image_filename, 
-                                teed_ball_ImgGray, strobed_balls_ImgGray, teed_ball_ImgColor, strobed_balls_ImgColor, camera_model, false /* No undistort)*/, true /* do_not_alter_filenames */)) {
-            GS_LOG_TRACE_MSG(warning, "Failed to read valid images for Test No. " + std::to_string(test.test_index));
-            numTestsFailed++;
-            continue;
+            outcomes[i] = RunFinalShotResultTest(test, tolerances);
         }
+    };
 
-        // Run the test using whatever current .json configuration we have
-
-        GolfBall result_ball;
-        cv::Vec3d rotation_results;
-        cv::Mat exposures_image;
-        cv::Mat dummy_pre_image;
-        std::vector<GolfBall> exposure_balls;
-
-        if (!GolfSimCamera::ProcessReceivedCam2Image(teed_ball_ImgColor,
-                                                     strobed_balls_ImgColor,
-                                                     dummy_pre_image,
-                                                     result_ball,
-                                                     rotation_results,
-                                                     exposures_image,
-                                                     exposure_balls)) {
-            GS_LOG_TRACE_MSG(warning, "Failed to ProcessReceivedCam2Image() for Test No. " + std::to_string(test.test_index));
-            numTestsFailed++;
-            continue;
-        }
+    std::vector<std::thread> workers;
+    for (int i = 0; i < num_workers; i++) {
+        workers.emplace_back(test_worker);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
 
-        result_ball.PrintBallFlightResults();
+    bool allTestsPassed = true;
+    int numTotalTests = 0;
+    int numTestsFailed = 0;
+    int numShardedOutTests = 0;
 
-        // Compare the results to the expected results
-        bool test_passed = true;
+    for (size_t i = 0; i < tests.size(); i++) {
 
-        if (!AbsResultsPass((float)CvUtils::MetersPerSecondToMPH((float)result_ball.velocity_), test.expected_results.speed_mph_, (float)tolerances.speed_mph_)) {
-            GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball shot speed measurement.");
-            test_passed = false;
-        }
+        const FinalResultsTestScenario& test = tests[i];
+        const FinalResultsTestOutcome& outcome = outcomes[i];
 
-        if (!AbsResultsPass( (float)result_ball.angles_ball_perspective_[0], test.expected_results.hla_deg_, (float)tolerances.hla_deg_)) {
-            GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball HLA measurement.");
-            test_passed = false;
+        if ((test.test_index % shard_count) != shard_index) {
+            numShardedOutTests++;
+            continue;
         }
 
-        if (!AbsResultsPass((float)result_ball.angles_ball_perspective_[1], test.expected_results.vla_deg_, (float)tolerances.vla_deg_)) {
-            GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball VLA measurement.");
-            test_passed = false;
-        }
+        numTotalTests++;
 
-        if (!AbsResultsPass( (int)result_ball.rotation_speeds_RPM_[2], test.expected_results.back_spin_rpm_, tolerances.back_spin_rpm_)) {
-            GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball back spin measurement.");
-            test_passed = false;
-        }
+        if (test.ignore_shot) {
+            GS_LOG_TRACE_MSG(info, "Ignoring Test No. " + std::to_string(test.test_index) + ".");
 
-        if (!AbsResultsPass((int)result_ball.rotation_speeds_RPM_[0], test.expected_results.side_spin_rpm_, tolerances.side_spin_rpm_)) {
-            GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - Failed ball side spin measurement.");
-            test_passed = false;
+            // Just leave a blank line with the shot number
+            testing_results_csv_file << ",";
+            testing_results_csv_file << test.shot_number << "," << std::endl;
+            continue;
         }
 
-        if (!test_passed) {
+        if (!outcome.ran || !outcome.passed) {
             numTestsFailed++;
+            allTestsPassed = false;
         }
 
+        if (outcome.ran) {
+            GS_LOG_TRACE_MSG(info, "Test No. " + std::to_string(test.test_index) + " - " +
+                (outcome.passed ? "PASS" : "FAIL") + " in " + std::to_string(outcome.elapsed_seconds) + " seconds.");
+        }
 
-        // Save the results (both the actual numbers and the differences) in the csv file
-        testing_results_csv_file << ",";
-        testing_results_csv_file << test.shot_number << ",";
+        testing_results_csv_file << outcome.csv_row;
+    }
 
-        float speed_mph_delta = (float)CvUtils::MetersPerSecondToMPH((float)result_ball.velocity_) - test.expected_results.speed_mph_;
-        float hla_deg_delta = (float)(result_ball.angles_ball_perspective_[0] - test.expected_results.hla_deg_);
-        float vla_deg_delta = (float)(result_ball.angles_ball_perspective_[1] - test.expected_results.vla_deg_);
-        int back_spin_rpm_delta = (int)(result_ball.rotation_speeds_RPM_[2] - test.expected_results.back_spin_rpm_);
-        int side_spin_rpm_delta = (int)(result_ball.rotation_speeds_RPM_[0] - test.expected_results.side_spin_rpm_);
+    testing_results_csv_file.close();
 
-        testing_results_csv_file << speed_mph_delta << ",";
-        testing_results_csv_file << hla_deg_delta << ",";
-        testing_results_csv_file << vla_deg_delta << ",";
-        testing_results_csv_file << back_spin_rpm_delta << ",";
-        testing_results_csv_file << side_spin_rpm_delta << ", ,";
+    // If a golden-timings file is configured, also check for performance
+    // regressions - cases whose detection/spin/total time got slower even though
+    // their ball values may still be within tolerance.
 
-        testing_results_csv_file << test.expected_results.speed_mph_ << "," << CvUtils::MetersPerSecondToMPH((float)result_ball.velocity_) << ", ,";
-        testing_results_csv_file << test.expected_results.vla_deg_ << "," << result_ball.angles_ball_perspective_[1] << ", ,";
-        testing_results_csv_file << test.expected_results.hla_deg_ << "," << result_ball.angles_ball_perspective_[0] << ", ,";
-        testing_results_csv_file << test.expected_results.back_spin_rpm_ << "," << result_ball.rotation_speeds_RPM_[2] << ", ,";
-        testing_results_csv_file << test.expected_results.side_spin_rpm_ << "," << result_ball.rotation_speeds_RPM_[0] << ",";
-        testing_results_csv_file << (test_passed? "PASS" : "FAIL") << std::endl;
-        testing_results_csv_file << " , , , ," << std::endl;
-    }
+    std::string kAutomatedTestGoldenTimingsCSV;
+    double kAutomatedTestPerfTolerancePercent = 25.0;
+    GolfSimConfiguration::SetConstant("gs_config.testing.kAutomatedTestGoldenTimingsCSV", kAutomatedTestGoldenTimingsCSV);
+    GolfSimConfiguration::SetConstant("gs_config.testing.kAutomatedTestPerfTolerancePercent", kAutomatedTestPerfTolerancePercent);
 
-    testing_results_csv_file.close();
+    int numPerfRegressions = 0;
 
+    if (!kAutomatedTestGoldenTimingsCSV.empty()) {
+        numPerfRegressions = CheckPerformanceAgainstGoldenTimings(kAutomatedTestSuiteDirectory + kAutomatedTestGoldenTimingsCSV,
+            kAutomatedTestPerfTolerancePercent, tests, outcomes);
+    }
 
-    GS_LOG_TRACE_MSG(trace, "Final Test Statistics:\nTotal Tests: " + std::to_string(numTotalTests) + ".\nTests Failed: " + std::to_string(numTestsFailed) + ".");
+    std::string statistics = "Final Test Statistics:\nTotal Tests: " + std::to_string(numTotalTests) + ".\nTests Failed: " + std::to_string(numTestsFailed) + ".";
+    if (shard_count > 1) {
+        statistics += "\nTests left to other shards: " + std::to_string(numShardedOutTests) + ".";
+    }
+    if (!kAutomatedTestGoldenTimingsCSV.empty()) {
+        statistics += "\nPerformance Regressions: " + std::to_string(numPerfRegressions) + ".";
+    }
+    GS_LOG_TRACE_MSG(trace, statistics);
 
     timer1.stop();
     boost::timer::cpu_times times = timer1.elapsed();
@@ -429,9 +707,25 @@ cv::Mat GsAutomatedTesting::UndistortImage(const cv::Mat& img, CameraHardware::C
     cv::Mat cameraDistortionVector_ = c.camera_hardware_.cameraDistortionVector_;
 
     cv::Mat unDistortedBall1Img;
-    cv::Mat m_undistMap1, m_undistMap2;
-    // TBD - is the size rows, cols?  or cols, rows?
-    cv::initUndistortRectifyMap(cameracalibrationMatrix_, cameraDistortionVector_, cv::Mat(), cameracalibrationMatrix_, cv::Size(img.cols, img.rows), CV_32FC1, m_undistMap1, m_undistMap2);
+
+    // The maps depend only on the calibration and image geometry, so cache
+    // them across calls - the test paths undistort two images per shot read.
+    // This function only runs on the (single-threaded) testing paths, so
+    // function-local statics are fine here.
+    static cv::Mat m_undistMap1, m_undistMap2;
+    static cv::Size cached_map_size;
+    static CameraHardware::CameraModel cached_camera_model;
+    static CameraHardware::LensType cached_lens_type;
+
+    if (m_undistMap1.empty() || cached_map_size != img.size() ||
+        cached_camera_model != camera_model || cached_lens_type != lens_type) {
+        // TBD - is the size rows, cols?  or cols, rows?
+        cv::initUndistortRectifyMap(cameracalibrationMatrix_, cameraDistortionVector_, cv::Mat(), cameracalibrationMatrix_, cv::Size(img.cols, img.rows), CV_32FC1, m_undistMap1, m_undistMap2);
+        cached_map_size = img.size();
+        cached_camera_model = camera_model;
+        cached_lens_type = lens_type;
+    }
+
     cv::remap(img, unDistortedBall1Img, m_undistMap1, m_undistMap2, cv::INTER_LINEAR);
 
     return unDistortedBall1Img;
@@ -471,8 +765,16 @@ bool GsAutomatedTesting::ReadTestImages(const std::string& img_1_base_filename,
     GS_LOG_TRACE_MSG(trace, "Raw Image1: " + img1FileName);
     GS_LOG_TRACE_MSG(trace, "Raw Image2: " + img2FileName);
 
-    ball1Img = cv::imread(img1FileName, cv::IMREAD_COLOR);
-    ball2Img = cv::imread(img2FileName, cv::IMREAD_COLOR);
+    // Raw frame files skip the PNG decode entirely - the Mats below become
+    // views over file mappings, which is what keeps large corpus runs fast
+    if (GsRawFrame::IsRawFrameFile(img1FileName)) {
+        GsRawFrame::Load(img1FileName, ball1Img);
+        GsRawFrame::Load(img2FileName, ball2Img);
+    }
+    else {
+        ball1Img = GsImageIo::ReadImage(img1FileName, cv::IMREAD_COLOR);
+        ball2Img = GsImageIo::ReadImage(img2FileName, cv::IMREAD_COLOR);
+    }
 
     if (ball1Img.empty() || ball2Img.empty()) {
         return false;
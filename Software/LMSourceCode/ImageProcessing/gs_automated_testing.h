@@ -55,6 +55,18 @@ namespace golf_sim {
             cv::Vec3d expected_xyz_rotation_degrees;
         };
 
+        // The result of running a single FinalResultsTestScenario.  The CSV row is
+        // pre-formatted by the (possibly parallel) test workers so that the rows can
+        // be written to the results file in corpus order afterward.
+        struct FinalResultsTestOutcome {
+            bool ran = false;       // False if the images could not be read or the image processing failed outright
+            bool passed = false;
+            double elapsed_seconds = 0.0;
+            double strobed_analysis_ms = 0.0;   // Ball detection/identification within the strobed image
+            double spin_analysis_ms = 0.0;      // Rotation (spin) measurement, 0 if the case skipped spin
+            std::string csv_row;
+        };
+
         static std::string kAutomatedTestDir;
 
 
@@ -62,6 +74,17 @@ namespace golf_sim {
 
         static bool TestFinalShotResultData();
 
+        static bool LoadFinalResultsCorpus(std::string& test_suite_directory,
+                                    std::vector<FinalResultsTestScenario>& tests,
+                                    GsResults& tolerances);
+
+        static FinalResultsTestOutcome RunFinalShotResultTest(const FinalResultsTestScenario& test, const GsResults& tolerances);
+
+        static int CheckPerformanceAgainstGoldenTimings(const std::string& golden_timings_filename,
+                                    double tolerance_percent,
+                                    const std::vector<FinalResultsTestScenario>& tests,
+                                    const std::vector<FinalResultsTestOutcome>& outcomes);
+
         static void ConvertInchesToMeters(const cv::Vec3d& expectedPositionsInches, cv::Vec3d& expectedPositionsMeters);
 
         static bool ReadTestImages(const std::string& img_1_base_filename, 
@@ -0,0 +1,285 @@
+/*****************************************************************//**
+ * \file   gs_cam2_predetect.cpp
+ * \brief  Camera-2-side pre-detection with ROI-only image shipment.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <opencv2/imgproc.hpp>
+
+#include "gs_cam2_predetect.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+#include "gs_options.h"
+
+#ifdef __unix__
+#include "gs_ipc_message.h"
+#include "gs_ipc_system.h"
+#endif
+
+namespace golf_sim {
+
+    bool GsCam2PreDetect::kEnableCam2PreDetection = false;
+    int GsCam2PreDetect::kCam2PreDetectBrightnessThreshold = 60;
+    int GsCam2PreDetect::kCam2PreDetectRoiPadPixels = 32;
+    double GsCam2PreDetect::kCam2PreDetectMaxRoiFraction = 0.6;
+    int GsCam2PreDetect::kCam2FullFrameTimeoutMs = 2000;
+
+    namespace {
+
+        // Camera-2 side state: the full frame behind the last ROI send,
+        // retained so a full-frame request can be answered without a
+        // re-capture (which is impossible - the ball is long gone).
+        std::mutex retained_frame_mutex;
+        cv::Mat retained_full_frame;
+
+        // Camera-1 side state: at most one full-frame request is in flight
+        // at a time (a shot's analysis retries at most once), so a single
+        // delivery slot under one mutex is enough.
+        std::mutex full_frame_mutex;
+        std::condition_variable full_frame_cv;
+        bool full_frame_pending = false;
+        bool full_frame_received = false;
+        cv::Mat delivered_full_frame;
+
+        // Camera-1 side: whether the current analysis frame was an ROI
+        // reduction, making the fallback worth asking for
+        bool last_frame_was_roi_reduced = false;
+    }
+
+
+    void GsCam2PreDetect::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kEnableCam2PreDetection", kEnableCam2PreDetection);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kCam2PreDetectBrightnessThreshold", kCam2PreDetectBrightnessThreshold);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kCam2PreDetectRoiPadPixels", kCam2PreDetectRoiPadPixels);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kCam2PreDetectMaxRoiFraction", kCam2PreDetectMaxRoiFraction);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kCam2FullFrameTimeoutMs", kCam2FullFrameTimeoutMs);
+
+        if (kEnableCam2PreDetection) {
+            GS_LOG_TRACE_MSG(trace, "GsCam2PreDetect enabled - brightness threshold " +
+                std::to_string(kCam2PreDetectBrightnessThreshold) + ", ROI pad " +
+                std::to_string(kCam2PreDetectRoiPadPixels) + " pixels.");
+        }
+    }
+
+
+    bool GsCam2PreDetect::ReduceToCandidateRoi(const cv::Mat& full_image,
+                                               cv::Mat& roi,
+                                               int& offset_x,
+                                               int& offset_y) {
+
+        if (full_image.empty()) {
+            return false;
+        }
+
+        // The candidate search just needs brightness - one gray channel is
+        // plenty, and cheap enough to run on every shot
+        cv::Mat gray;
+
+        if (full_image.channels() == 1) {
+            gray = full_image;
+        }
+        else {
+            cv::cvtColor(full_image, gray, cv::COLOR_BGR2GRAY);
+        }
+
+        cv::Mat bright_mask;
+        cv::threshold(gray, bright_mask, (double)kCam2PreDetectBrightnessThreshold, 255.0, cv::THRESH_BINARY);
+
+        // The bounding box of every bright pixel is deliberately
+        // over-inclusive - a stray reflection only costs a few extra rows,
+        // while a missed exposure would cost the shot
+        std::vector<cv::Point> bright_points;
+        cv::findNonZero(bright_mask, bright_points);
+
+        if (bright_points.empty()) {
+            GS_LOG_TRACE_MSG(trace, "GsCam2PreDetect - no bright candidate pixels.  Sending the full frame.");
+            return false;
+        }
+
+        cv::Rect box = cv::boundingRect(bright_points);
+
+        box.x -= kCam2PreDetectRoiPadPixels;
+        box.y -= kCam2PreDetectRoiPadPixels;
+        box.width += 2 * kCam2PreDetectRoiPadPixels;
+        box.height += 2 * kCam2PreDetectRoiPadPixels;
+
+        box &= cv::Rect(0, 0, full_image.cols, full_image.rows);
+
+        double roi_fraction = (double)box.area() / ((double)full_image.cols * (double)full_image.rows);
+
+        if (roi_fraction > kCam2PreDetectMaxRoiFraction) {
+            GS_LOG_TRACE_MSG(trace, "GsCam2PreDetect - candidate box covers " +
+                std::to_string((int)(roi_fraction * 100.0)) + "% of the frame.  Sending the full frame.");
+            return false;
+        }
+
+        // Retain the full frame in case camera 1 rejects the candidates and
+        // asks for it.  Clone - the caller's buffer belongs to the camera
+        // pipeline and will be recycled.
+        {
+            std::lock_guard<std::mutex> lock(retained_frame_mutex);
+            retained_full_frame = full_image.clone();
+        }
+
+        // Clone so the crop is continuous for serialization
+        roi = full_image(box).clone();
+        offset_x = box.x;
+        offset_y = box.y;
+
+        GS_LOG_MSG(info, "GsCam2PreDetect - shipping a " + std::to_string(box.width) + "x" +
+            std::to_string(box.height) + " ROI (" + std::to_string((int)(roi_fraction * 100.0)) +
+            "% of the frame) at (" + std::to_string(box.x) + ", " + std::to_string(box.y) + ").");
+
+        return true;
+    }
+
+
+    cv::Mat GsCam2PreDetect::ExpandRoiImage(const cv::Mat& roi,
+                                            int offset_x,
+                                            int offset_y,
+                                            int full_width,
+                                            int full_height) {
+
+        cv::Mat canvas = cv::Mat::zeros(full_height, full_width, roi.type());
+
+        cv::Rect placement(offset_x, offset_y, roi.cols, roi.rows);
+        placement &= cv::Rect(0, 0, full_width, full_height);
+
+        if (placement.width > 0 && placement.height > 0) {
+            roi(cv::Rect(0, 0, placement.width, placement.height)).copyTo(canvas(placement));
+        }
+        else {
+            LoggingTools::Warning("GsCam2PreDetect::ExpandRoiImage received an ROI that falls outside its own frame.");
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(full_frame_mutex);
+            last_frame_was_roi_reduced = true;
+        }
+
+        return canvas;
+    }
+
+
+    bool GsCam2PreDetect::LastFrameWasRoiReduced() {
+        std::lock_guard<std::mutex> lock(full_frame_mutex);
+        return last_frame_was_roi_reduced;
+    }
+
+
+#ifdef __unix__
+
+    bool GsCam2PreDetect::HandleFullFrameRequest() {
+
+        GS_LOG_TRACE_MSG(trace, "GsCam2PreDetect::HandleFullFrameRequest.");
+
+        cv::Mat full_frame;
+
+        {
+            std::lock_guard<std::mutex> lock(retained_frame_mutex);
+            full_frame = retained_full_frame;
+        }
+
+        if (full_frame.empty()) {
+            GS_LOG_MSG(warning, "GsCam2PreDetect - a full frame was requested, but none is retained.");
+            return false;
+        }
+
+        GS_LOG_MSG(info, "GsCam2PreDetect - resending the retained full frame.");
+
+        // allow_roi_reduction = false - this send exists precisely because
+        // the reduction hid something camera 1 needed
+        return GolfSimIpcSystem::SendCamera2ImageMessage(full_frame, false);
+    }
+
+
+    bool GsCam2PreDetect::RequestAndAwaitFullFrame(cv::Mat& full_image) {
+
+        if (!kEnableCam2PreDetection) {
+            return false;
+        }
+
+        GS_LOG_MSG(info, "GsCam2PreDetect - the ROI candidates did not pan out.  Requesting the full frame from the camera-2 system.");
+
+        {
+            std::lock_guard<std::mutex> lock(full_frame_mutex);
+            full_frame_pending = true;
+            full_frame_received = false;
+            last_frame_was_roi_reduced = false;
+        }
+
+        GolfSimIPCMessage request(GolfSimIPCMessage::IPCMessageType::kRequestCamera2FullFrame);
+
+        if (!GolfSimIpcSystem::SendIpcMessage(request)) {
+            GS_LOG_MSG(warning, "GsCam2PreDetect - failed to send the full-frame request.");
+            std::lock_guard<std::mutex> lock(full_frame_mutex);
+            full_frame_pending = false;
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(full_frame_mutex);
+
+        bool answered = full_frame_cv.wait_for(lock, std::chrono::milliseconds(kCam2FullFrameTimeoutMs),
+                                               []() { return full_frame_received; });
+
+        full_frame_pending = false;
+
+        if (!answered) {
+            GS_LOG_MSG(warning, "GsCam2PreDetect - no full frame from the camera-2 system within " +
+                std::to_string(kCam2FullFrameTimeoutMs) + "ms.");
+            return false;
+        }
+
+        full_image = delivered_full_frame;
+        delivered_full_frame = cv::Mat();
+
+        return true;
+    }
+
+
+    bool GsCam2PreDetect::TryDeliverAwaitedFullFrame(const cv::Mat& image) {
+
+        std::lock_guard<std::mutex> lock(full_frame_mutex);
+
+        if (!full_frame_pending) {
+            return false;
+        }
+
+        delivered_full_frame = image;
+        full_frame_received = true;
+
+        full_frame_cv.notify_one();
+
+        return true;
+    }
+
+#else
+
+    bool GsCam2PreDetect::HandleFullFrameRequest() {
+        return true;
+    }
+
+    bool GsCam2PreDetect::RequestAndAwaitFullFrame(cv::Mat&) {
+        return false;
+    }
+
+    bool GsCam2PreDetect::TryDeliverAwaitedFullFrame(const cv::Mat&) {
+        return false;
+    }
+
+#endif
+
+}
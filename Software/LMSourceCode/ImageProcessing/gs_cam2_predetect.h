@@ -0,0 +1,109 @@
+/*****************************************************************//**
+ * \file   gs_cam2_predetect.h
+ * \brief  Camera-2-side pre-detection with ROI-only image shipment.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+    class GolfSimIPCMessage;
+
+    // In the two-Pi setup, the camera-2 Pi ships its entire strobed frame
+    // to camera 1 even though the ball exposures only occupy a fraction of
+    // it.  When enabled, the camera-2 system finds the bright strobed
+    // exposures itself (they sit on a nearly black background), and ships
+    // only a padded bounding-box crop of them plus its frame coordinates.
+    // The camera-1 receive path places the crop back on a full-size black
+    // canvas, so the downstream search geometry (calibration, angles,
+    // expected ball positions) is unchanged.
+    //
+    // The reduction is strictly opportunistic: if the bright-region box is
+    // empty or covers most of the frame, the full frame is sent as always.
+    // And if camera 1 fails to find the ball in a reduced frame, it asks
+    // camera 2 - which retains the last full frame - to resend it, and
+    // searches once more before declaring the shot lost.
+    //
+    // Off by default (gs_config.ipc_interface.kEnableCam2PreDetection);
+    // both Pis must run builds that understand the exchange.
+
+    class GsCam2PreDetect {
+
+    public:
+
+        static bool kEnableCam2PreDetection;
+
+        // The strobed exposures are bright on a dark background - pixels at
+        // or above this (8-bit) brightness count as candidate ball pixels.
+        static int kCam2PreDetectBrightnessThreshold;
+
+        // Padding added around the candidate bounding box so the edge of a
+        // dim exposure is never clipped off
+        static int kCam2PreDetectRoiPadPixels;
+
+        // If the padded box covers more than this fraction of the frame
+        // area, the reduction is not worth the risk and the full frame is
+        // sent instead
+        static double kCam2PreDetectMaxRoiFraction;
+
+        // How long camera 1 waits for the resent full frame before giving
+        // up on the shot
+        static int kCam2FullFrameTimeoutMs;
+
+        // Reads the configuration values above.  Call once at startup.
+        static void Initialize();
+
+        // Camera-2 side.  Finds the padded bounding box of the bright
+        // candidate pixels and returns true with the (continuous) crop and
+        // its top-left frame coordinates.  Retains the full frame for a
+        // possible later full-frame request.  Returns false - and the
+        // caller should send the full frame as always - when the box is
+        // empty or covers more than kCam2PreDetectMaxRoiFraction of the
+        // frame.
+        static bool ReduceToCandidateRoi(const cv::Mat& full_image,
+                                         cv::Mat& roi,
+                                         int& offset_x,
+                                         int& offset_y);
+
+        // Camera-2 side.  Resends the retained full frame, bypassing the
+        // reduction.  Called from the IPC dispatch (see
+        // GolfSimIpcSystem::DispatchRequestCamera2FullFrameMessage).
+        static bool HandleFullFrameRequest();
+
+        // Camera-1 side.  Places a received ROI crop back onto a full-size
+        // black canvas at its original position and notes that the current
+        // frame was reduced (see LastFrameWasRoiReduced).
+        static cv::Mat ExpandRoiImage(const cv::Mat& roi,
+                                      int offset_x,
+                                      int offset_y,
+                                      int full_width,
+                                      int full_height);
+
+        // Camera-1 side.  True if the most recently received camera-2 image
+        // was an ROI reduction, so a failed ball search still has the
+        // full-frame fallback to try.
+        static bool LastFrameWasRoiReduced();
+
+        // Camera-1 side.  Sends the full-frame request and blocks (up to
+        // kCam2FullFrameTimeoutMs) for camera 2's resend.  Returns true
+        // with the full frame if it arrived in time.
+        static bool RequestAndAwaitFullFrame(cv::Mat& full_image);
+
+        // Camera-1 side.  Hands a just-received camera-2 image to a waiting
+        // RequestAndAwaitFullFrame call, if there is one.  Returns true if
+        // the image was consumed (and so must not go to the FSM).  Called
+        // from the IPC dispatch.
+        static bool TryDeliverAwaitedFullFrame(const cv::Mat& image);
+    };
+
+}
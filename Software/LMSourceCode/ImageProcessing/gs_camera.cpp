@@ -5,6 +5,12 @@
 
 #include <algorithm>
 #include <bitset>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <numeric>
+#include <thread>
 
 #include "gs_options.h"
 #include "ball_image_proc.h"
@@ -12,6 +18,14 @@
 #include "gs_ui_system.h"
 #include "gs_config.h"
 #include "gs_clubs.h"
+#include "gs_perf_counters.h"
+#include "gs_geometry.h"
+#include "gs_image_io.h"
+#include "gs_thread_budget.h"
+#include "gs_cpu_dispatch.h"
+#include "gs_tuned_kernels.h"
+#include "gs_spin_offload.h"
+#include "gs_sim_interface.h"
 
 #include "libcamera_interface.h"
 
@@ -48,6 +62,18 @@ namespace golf_sim {
     double GolfSimCamera::kMaxDistanceFromTrajectory = 20.;
 
     int GolfSimCamera::kClosestBallPairEdgeBackoffPixels = 200;
+    bool GolfSimCamera::kUseVectorizedPairScoring = false;
+    bool GolfSimCamera::kUseBatchedBallLocalization = false;
+    bool GolfSimCamera::kUsePipelinedShotAnalysis = true;
+    bool GolfSimCamera::kUseOverlappedShotProcessing = false;
+    int GolfSimCamera::kMaxInFlightShots = 1;
+    bool GolfSimCamera::kUseSpeculativeSpinAnalysis = true;
+    bool GolfSimCamera::kUsePuttingFastPath = true;
+    bool GolfSimCamera::kUsePrefetchedFrames = false;
+    long GolfSimCamera::last_frame_staleness_us_ = 0;
+
+    thread_local double GolfSimCamera::last_strobed_analysis_time_ms_ = 0.0;
+    thread_local double GolfSimCamera::last_spin_analysis_time_ms_ = 0.0;
 
     double GolfSimCamera::kMaxIntermediateBallRadiusChangePercent = 10.0;
     double GolfSimCamera::kMaxPuttingIntermediateBallRadiusChangePercent = 10.0;
@@ -72,6 +98,12 @@ namespace golf_sim {
     double GolfSimCamera::kExpectedBallPositionXcm = -50.0;
     double GolfSimCamera::kExpectedBallPositionYcm = -28.0;
     double GolfSimCamera::kExpectedBallPositionZcm = 50.0;
+    bool GolfSimCamera::kUsePredictiveBallSearchROI = false;
+    double GolfSimCamera::kPredictiveROIRadiiAboveCenter = 10.0;
+    double GolfSimCamera::kPredictiveROIRadiiBelowCenter = 6.0;
+    bool GolfSimCamera::kUseExpandingBallSearch = false;
+    int GolfSimCamera::kBallSearchMinInitialCandidates = 2;
+    double GolfSimCamera::kBallSearchExpansionFactor = 2.0;
     double GolfSimCamera::kExpectedBallRadiusPixelsAt40cm = 50;
     float GolfSimCamera::kMaxMovedBallRadiusRatio = 1.40f;
     float GolfSimCamera::kMinMovedBallRadiusRatio = 0.50f;
@@ -94,6 +126,7 @@ namespace golf_sim {
     bool GolfSimCamera::kCameraRequiresFlushPulse = false;
 
     int GolfSimCamera::kMaxBallsToRetain = 18;
+    bool GolfSimCamera::kUseEarlyCandidateTruncation = false;
 
     bool GolfSimCamera::kExternallyStrobedEnvFilterImage = true;
     int GolfSimCamera::kExternallyStrobedEnvBottomIgnoreHeight = 70;
@@ -133,6 +166,26 @@ namespace golf_sim {
     }
 
 
+    namespace {
+
+        // Double-buffered frame prefetch state behind kUsePrefetchedFrames.
+        // One capture thread stays exactly one frame ahead of the (single)
+        // getNextFrame consumer: it captures into prefetched_frame while the
+        // consumer analyzes the previous frame, then blocks until that frame
+        // is taken.  Every captured frame is handed over exactly once, so
+        // the test-harness frame sequencing is preserved.
+        std::mutex frame_prefetch_mutex;
+        std::condition_variable frame_prefetch_cv;
+        std::thread* frame_prefetch_thread = nullptr;
+        GolfSimCamera* frame_prefetch_owner = nullptr;
+        cv::Mat prefetched_frame;
+        std::chrono::steady_clock::time_point prefetched_frame_capture_time;
+        bool prefetched_frame_ready = false;
+        bool frame_prefetch_running = false;
+        long frames_prefetched = 0;
+    }
+
+
     GolfSimCamera::GolfSimCamera() {
 
         // TBD - Probably shouldn't be doing all of this in the constructor
@@ -160,7 +213,15 @@ namespace golf_sim {
         GolfSimConfiguration::SetConstant("gs_config.ball_exposure_selection.kMaxDistanceFromTrajectory", kMaxDistanceFromTrajectory);
 
         GolfSimConfiguration::SetConstant("gs_config.ball_exposure_selection.kClosestBallPairEdgeBackoffPixels", kClosestBallPairEdgeBackoffPixels);
+        GolfSimConfiguration::SetConstant("gs_config.ball_exposure_selection.kUseVectorizedPairScoring", kUseVectorizedPairScoring);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kUsePipelinedShotAnalysis", kUsePipelinedShotAnalysis);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kUseSpeculativeSpinAnalysis", kUseSpeculativeSpinAnalysis);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kUseOverlappedShotProcessing", kUseOverlappedShotProcessing);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kMaxInFlightShots", kMaxInFlightShots);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kUsePuttingFastPath", kUsePuttingFastPath);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kUsePrefetchedFrames", kUsePrefetchedFrames);
         GolfSimConfiguration::SetConstant("gs_config.ball_exposure_selection.kMaxBallsToRetain", kMaxBallsToRetain);
+        GolfSimConfiguration::SetConstant("gs_config.ball_exposure_selection.kUseEarlyCandidateTruncation", kUseEarlyCandidateTruncation);
         
         GolfSimConfiguration::SetConstant("gs_config.strobing.kStandardBallSpeedSlowdownPercentage", kStandardBallSpeedSlowdownPercentage);
         GolfSimConfiguration::SetConstant("gs_config.strobing.kPracticeBallSpeedSlowdownPercentage", kPracticeBallSpeedSlowdownPercentage);
@@ -192,10 +253,24 @@ namespace golf_sim {
         GolfSimConfiguration::SetConstant("gs_config.cameras.kCamera1YOffsetForTilt", kCamera1YOffsetForTilt);
         GolfSimConfiguration::SetConstant("gs_config.cameras.kCamera2XOffsetForTilt", kCamera2XOffsetForTilt);
         GolfSimConfiguration::SetConstant("gs_config.cameras.kCamera2YOffsetForTilt", kCamera2YOffsetForTilt);
+        GolfSimConfiguration::SetConstant("gs_config.cameras.kUseBatchedBallLocalization", kUseBatchedBallLocalization);
 
         GolfSimConfiguration::SetConstant("gs_config.ball_position.kExpectedBallPositionXcm", kExpectedBallPositionXcm);
         GolfSimConfiguration::SetConstant("gs_config.ball_position.kExpectedBallPositionYcm", kExpectedBallPositionYcm);
         GolfSimConfiguration::SetConstant("gs_config.ball_position.kExpectedBallPositionZcm", kExpectedBallPositionZcm);
+        GolfSimConfiguration::SetConstant("gs_config.ball_position.kUsePredictiveBallSearchROI", kUsePredictiveBallSearchROI);
+        GolfSimConfiguration::SetConstant("gs_config.ball_position.kPredictiveROIRadiiAboveCenter", kPredictiveROIRadiiAboveCenter);
+        GolfSimConfiguration::SetConstant("gs_config.ball_position.kPredictiveROIRadiiBelowCenter", kPredictiveROIRadiiBelowCenter);
+        GolfSimConfiguration::SetConstant("gs_config.ball_position.kUseExpandingBallSearch", kUseExpandingBallSearch);
+        GolfSimConfiguration::SetConstant("gs_config.ball_position.kBallSearchMinInitialCandidates", kBallSearchMinInitialCandidates);
+        GolfSimConfiguration::SetConstant("gs_config.ball_position.kBallSearchExpansionFactor", kBallSearchExpansionFactor);
+
+        // The expanding search must actually expand, or it would rescan the
+        // same corridor forever
+        if (kBallSearchExpansionFactor < 1.1) {
+            LoggingTools::Warning("kBallSearchExpansionFactor must be at least 1.1.  Using 1.1.");
+            kBallSearchExpansionFactor = 1.1;
+        }
         GolfSimConfiguration::SetConstant("gs_config.ball_position.kExpectedBallRadiusPixelsAt40cm", kExpectedBallRadiusPixelsAt40cm);
         GolfSimConfiguration::SetConstant("gs_config.ball_position.kMaxMovedBallRadiusRatio", kMaxMovedBallRadiusRatio);
         GolfSimConfiguration::SetConstant("gs_config.ball_position.kMinMovedBallRadiusRatio", kMinMovedBallRadiusRatio);
@@ -238,6 +313,11 @@ namespace golf_sim {
     }
 
     GolfSimCamera::~GolfSimCamera() {
+        // The prefetch capture thread captures through this instance's
+        // camera hardware, so it must not outlive us
+        if (frame_prefetch_owner == this) {
+            StopFramePrefetch();
+        }
     }
 
     bool GolfSimCamera::DetermineHandedness(const std::vector<GolfBall>& input_balls,
@@ -704,6 +784,111 @@ namespace golf_sim {
         return true;
     }
 
+    bool GolfSimCamera::ComputeBallsXYZOrthoCamPerspective(const GolfSimCamera& camera, std::vector<GolfBall*>& balls) {
+
+        if (balls.empty()) {
+            return true;
+        }
+
+        auto batch_start = std::chrono::high_resolution_clock::now();
+
+        const CameraHardware& hw = camera.camera_hardware_;
+
+        // The camera-geometry terms that the scalar path re-derives for every
+        // candidate.  See ComputeDistanceToBallUsingRadius and
+        // convertX/YDistanceToMeters for the underlying algebra.
+        const double half_resolution_x = std::round(hw.resolution_x_ / 2.0);
+        const double half_resolution_y = std::round(hw.resolution_y_ / 2.0);
+        const double x_pixels_to_meters = hw.sensor_width_ / (hw.focal_length_ * hw.resolution_x_);
+        const double y_pixels_to_meters = hw.sensor_height_ / (hw.focal_length_ * hw.resolution_y_);
+        const double radius_to_distance = hw.resolution_x_ * GolfBall::kBallRadiusMeters * hw.focal_length_ / hw.sensor_width_;
+        const double camera_angle_x = hw.camera_angles_[0];
+        const double camera_angle_y = hw.camera_angles_[1];
+
+        bool all_succeeded = true;
+
+        // Structure-of-arrays staging so the sweeps below are tight loops over
+        // contiguous doubles
+        std::vector<GolfBall*> batched;
+        std::vector<double> radii;
+        std::vector<double> x_pixels;
+        std::vector<double> y_pixels;
+        batched.reserve(balls.size());
+        radii.reserve(balls.size());
+        x_pixels.reserve(balls.size());
+        y_pixels.reserve(balls.size());
+
+        for (GolfBall* ball : balls) {
+
+            const double radius = CvUtils::CircleRadius(ball->ball_circle_);
+
+            // The ellipse representation is deprecated but still honored by
+            // the scalar path, and a degenerate radius needs the scalar
+            // path's diagnostics - both go through
+            // ComputeSingleBallXYZOrthoCamPerspective unchanged.
+            if ((ball->ball_ellipse_.size.width > 0 && ball->ball_ellipse_.size.height > 0) || radius <= 0.0) {
+                if (!ComputeSingleBallXYZOrthoCamPerspective(camera, *ball)) {
+                    all_succeeded = false;
+                }
+                continue;
+            }
+
+            batched.push_back(ball);
+            radii.push_back(radius);
+            x_pixels.push_back(ball->x());
+            y_pixels.push_back(ball->y());
+        }
+
+        const size_t batch_size = batched.size();
+
+        std::vector<double> z_meters(batch_size);
+        std::vector<double> x_meters(batch_size);
+        std::vector<double> y_meters(batch_size);
+
+        for (size_t i = 0; i < batch_size; i++) {
+            z_meters[i] = radius_to_distance / radii[i];
+        }
+
+        for (size_t i = 0; i < batch_size; i++) {
+            x_meters[i] = z_meters[i] * x_pixels_to_meters * (x_pixels[i] - half_resolution_x);
+            y_meters[i] = -(z_meters[i] * y_pixels_to_meters * (y_pixels[i] - half_resolution_y));
+        }
+
+        // The same camera-angle fold-in and spherical-to-cartesian conversion
+        // that ComputeXyzDistanceFromOrthoCamPerspective performs one
+        // candidate at a time
+        for (size_t i = 0; i < batch_size; i++) {
+
+            const double theta_radians = CvUtils::DegreesToRadians(
+                camera_angle_x - CvUtils::RadiansToDegrees(atan(x_meters[i] / z_meters[i])));
+            const double phi_radians = CvUtils::DegreesToRadians(
+                90. + camera_angle_y + CvUtils::RadiansToDegrees(atan(y_meters[i] / z_meters[i])));
+
+            const double cartesian_x = z_meters[i] * sin(phi_radians) * cos(theta_radians);
+            const double cartesian_y = z_meters[i] * sin(phi_radians) * sin(theta_radians);
+            const double cartesian_z = z_meters[i] * cos(phi_radians);
+
+            GolfBall* ball = batched[i];
+            ball->distance_to_z_plane_from_lens_ = z_meters[i];
+            ball->distances_ortho_camera_perspective_ = cv::Vec3d(-cartesian_y, -cartesian_z, cartesian_x);
+        }
+
+        for (size_t i = 0; i < batch_size; i++) {
+            if (!ComputeBallXYAnglesFromCameraPerspective(batched[i]->distances_ortho_camera_perspective_,
+                                                          batched[i]->angles_camera_ortho_perspective_)) {
+                all_succeeded = false;
+            }
+        }
+
+        auto batch_end = std::chrono::high_resolution_clock::now();
+
+        GS_LOG_TRACE_MSG(trace, "ComputeBallsXYZOrthoCamPerspective localized " + std::to_string(batch_size) +
+            " of " + std::to_string(balls.size()) + " candidates in " +
+            std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(batch_end - batch_start).count() / 1000.0) + " ms.");
+
+        return all_succeeded;
+    }
+
 
 
         // returns a new golf ball object with the ball's current information
@@ -1228,8 +1413,105 @@ namespace golf_sim {
             return true;
         }
 
+        void GolfSimCamera::RunFramePrefetchThread() {
+
+            GS_LOG_TRACE_MSG(trace, "GolfSimCamera frame-prefetch thread started.");
+
+            while (true) {
+
+                {
+                    std::lock_guard<std::mutex> lock(frame_prefetch_mutex);
+                    if (!frame_prefetch_running) {
+                        break;
+                    }
+                }
+
+                // The capture happens outside the lock - this is the exposure
+                // and readout work that now overlaps the consumer's analysis
+                // of the previous frame
+                cv::Mat frame = camera_hardware_.getNextFrame();
+                std::chrono::steady_clock::time_point capture_time = std::chrono::steady_clock::now();
+
+                std::unique_lock<std::mutex> lock(frame_prefetch_mutex);
+
+                if (!frame_prefetch_running) {
+                    break;
+                }
+
+                prefetched_frame = std::move(frame);
+                prefetched_frame_capture_time = capture_time;
+                prefetched_frame_ready = true;
+                frames_prefetched++;
+
+                frame_prefetch_cv.notify_all();
+
+                // Staying exactly one frame ahead is the contract - wait here
+                // until the consumer takes the buffered frame
+                frame_prefetch_cv.wait(lock, []() { return !prefetched_frame_ready || !frame_prefetch_running; });
+            }
+        }
+
         cv::Mat  GolfSimCamera::getNextFrame() {
-            return camera_hardware_.getNextFrame();
+
+            if (!kUsePrefetchedFrames) {
+                last_frame_staleness_us_ = 0;
+                return camera_hardware_.getNextFrame();
+            }
+
+            std::unique_lock<std::mutex> lock(frame_prefetch_mutex);
+
+            if (!frame_prefetch_running) {
+                // First call - prime the pipeline.  This first frame is
+                // effectively synchronous; every later one should already be
+                // waiting in the buffer by the time the caller asks for it.
+                frame_prefetch_running = true;
+                prefetched_frame_ready = false;
+                frame_prefetch_owner = this;
+                frame_prefetch_thread = new std::thread(&GolfSimCamera::RunFramePrefetchThread, this);
+            }
+
+            frame_prefetch_cv.wait(lock, []() { return prefetched_frame_ready; });
+
+            cv::Mat frame = std::move(prefetched_frame);
+            prefetched_frame_ready = false;
+
+            last_frame_staleness_us_ = (long)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - prefetched_frame_capture_time).count();
+
+            lock.unlock();
+
+            // Wake the capture side to go get the next frame while the caller
+            // works on this one
+            frame_prefetch_cv.notify_all();
+
+            return frame;
+        }
+
+        void GolfSimCamera::StopFramePrefetch() {
+
+            std::thread* worker = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(frame_prefetch_mutex);
+
+                if (frame_prefetch_thread == nullptr) {
+                    return;
+                }
+
+                frame_prefetch_running = false;
+                prefetched_frame_ready = false;
+                worker = frame_prefetch_thread;
+                frame_prefetch_thread = nullptr;
+                frame_prefetch_owner = nullptr;
+            }
+
+            frame_prefetch_cv.notify_all();
+
+            worker->join();
+            delete worker;
+
+            GS_LOG_TRACE_MSG(trace, "GolfSimCamera frame-prefetch thread stopped after " +
+                std::to_string(frames_prefetched) + " prefetched frames.");
         }
 
         bool GolfSimCamera::ShowAndLogBalls(const std::string& title, 
@@ -1278,15 +1560,30 @@ namespace golf_sim {
 
         void GolfSimCamera::SortBallsByXPosition(std::vector<GolfBall>& balls) {
 
+            // GolfBall is a fat object, so instead of letting std::sort swap
+            // the balls themselves around O(n log n) times, sort a lightweight
+            // index array on the x coordinates and then apply the resulting
+            // permutation to the ball vector in a single pass.
+            std::vector<size_t> order(balls.size());
+            std::iota(order.begin(), order.end(), (size_t)0);
+
             if (GolfSimOptions::GetCommandLineOptions().golfer_orientation_ == GolferOrientation::kRightHanded) {
-                std::sort(balls.begin(), balls.end(), [](const GolfBall& a, const GolfBall& b)
-                    { return (a.x() < b.x()); });
+                std::sort(order.begin(), order.end(), [&balls](size_t a, size_t b)
+                    { return (balls[a].x() < balls[b].x()); });
             }
             else {
-                std::sort(balls.begin(), balls.end(), [](const GolfBall& a, const GolfBall& b)
-                    { return (a.x() > b.x()); });
+                std::sort(order.begin(), order.end(), [&balls](size_t a, size_t b)
+                    { return (balls[a].x() > balls[b].x()); });
             }
 
+            std::vector<GolfBall> sorted_balls;
+            sorted_balls.reserve(balls.size());
+
+            for (size_t i : order) {
+                sorted_balls.push_back(std::move(balls[i]));
+            }
+
+            balls = std::move(sorted_balls);
         }
 
         int GolfSimCamera::GetMostCenteredBallIndex(const std::vector<GolfBall>& balls, const int ball_to_ignore_index) {
@@ -1338,37 +1635,31 @@ namespace golf_sim {
             }
 
             // First get the inter-ball distances.  There will be one less distance element
-            // than the number of balls.
-            // "size()-1" because we need at least two balls for a single inter-ball distance
-            for (size_t ball_index = 0; ball_index < balls.size() - 1; ball_index++) {
-
-                const GolfBall& left_ball =  balls[ball_index];
-                const GolfBall& right_ball = balls[ball_index + 1];
+            // than the number of balls.  The positions are staged into
+            // structure-of-arrays vectors and both sweeps run as batch
+            // primitives - same rounded-pixel math as PixelDistanceFromBall.
+            std::vector<double> ball_xs;
+            std::vector<double> ball_ys;
+            ball_xs.reserve(balls.size());
+            ball_ys.reserve(balls.size());
 
-                double distance = left_ball.PixelDistanceFromBall(right_ball);
-
-                distances.push_back(distance);
+            for (const GolfBall& ball : balls) {
+                ball_xs.push_back(CvUtils::CircleX(ball.ball_circle_));
+                ball_ys.push_back(CvUtils::CircleY(ball.ball_circle_));
             }
 
+            GsGeometry::ConsecutivePairDistances(ball_xs, ball_ys, distances);
+
             // There will be one less distance ratio than distances in a perfect world.
             // But there may be times when one of the circles is dropped and we have a lot fewer
-            // distances
-            for (size_t distance_index = 0; distance_index < distances.size() - 1; distance_index++) {
-
-                double left_distance =  distances[distance_index];
-                double right_distance = distances[distance_index + 1];
+            // distances.
+            // The friction-slowing adjustment is a constant scale for the whole
+            // shot, so it is hoisted out of the ratio sweep.
+            const double slowing_scale = AdjustDistanceForSlowing(1.0);
 
-                // Account for friction forces that would tend to decrease the ideal distance
-                // that would have occurred with a constant-velocity assumption
-                right_distance = AdjustDistanceForSlowing(right_distance);
-
-                if (left_distance <= 1.0) {
-                    LoggingTools::Warning("Found invalid (<1.0) distance");
-                    return false;
-                }
-                double distance_ratio = right_distance / left_distance;
-
-                distance_ratios.push_back(distance_ratio);
+            if (!GsGeometry::AdjacentScaledRatios(distances, slowing_scale, distance_ratios)) {
+                LoggingTools::Warning("Found invalid (<1.0) distance");
+                return false;
             }
 
             return true;
@@ -1463,30 +1754,10 @@ namespace golf_sim {
 
             // See, e.g., https://math.stackexchange.com/questions/2757318/distance-between-a-point-and-a-line-defined-by-2-points
             // The following was only for a line SEGMENT: https://stackoverflow.com/questions/849211/shortest-distance-between-a-point-and-a-line-segment
-            
-            // If the line is vertical, then the distance is just the x difference to the line
-            if (std::abs(xb - xa) < 0.0001) {
-                return (std::abs(xc - xb));
-            }
-
-            // If the line is horizontal, then the distance is just the y difference to the line
-            if (std::abs(yb - ya) < 0.0001) {
-                return (std::abs(yc - yb));
-            }
-
-            double nA = xb - xa;
-            double nB = yc - ya;
-            double nC = yb - ya;
-            double nD = xc - xa;
-
-            double numerator = std::abs(nA * nB - nC * nD);
 
-            double dA = xb - xa;
-            double dB = yb - ya;
-
-            double denominator = sqrt(dA * dA + dB * dB);
-
-            return numerator / denominator;
+            // The formula itself now lives with the other (batchable) geometry
+            // primitives so that the scalar and batch paths cannot drift apart
+            return GsGeometry::PerpendicularDistanceFromLine(xc, yc, xa, ya, xb, yb);
         }
 
         void GolfSimCamera::RemoveLowScoringBalls(std::vector<GolfBall>& balls, const int max_balls_to_retain) {
@@ -1600,6 +1871,23 @@ namespace golf_sim {
                 return;
             }
 
+            // Compute all of the trajectory distances in one batch so the
+            // line's normalization term is derived once, not per candidate
+            std::vector<double> candidate_xs;
+            std::vector<double> candidate_ys;
+            candidate_xs.reserve(initial_balls.size());
+            candidate_ys.reserve(initial_balls.size());
+
+            for (const GolfBall& b : initial_balls) {
+                candidate_xs.push_back(b.x());
+                candidate_ys.push_back(b.y());
+            }
+
+            std::vector<double> trajectory_distances;
+            GsGeometry::PerpendicularDistancesFromLine(candidate_xs, candidate_ys,
+                best_ball.x(), best_ball.y(), second_best_ball.x(), second_best_ball.y(),
+                trajectory_distances);
+
             // Identify any balls that are far from the projected trajectory
             for (int i = (int)initial_balls.size() - 1; i >= 0; i--) {
                 GolfBall& b = initial_balls[i];
@@ -1610,7 +1898,7 @@ namespace golf_sim {
                     continue;
                 }
 
-                double ball_distance = GetPerpendicularDistanceFromLine(b.x(), b.y(), best_ball.x(), best_ball.y(), second_best_ball.x(), second_best_ball.y());
+                double ball_distance = trajectory_distances[i];
 
                 if (ball_distance > max_distance_from_trajectory) {
                     // GS_LOG_TRACE_MSG(trace, "Not analyzing ball " + std::to_string(i) + " due to it having off - trajectory distance of : " + std::to_string(ball_distance));
@@ -1632,21 +1920,39 @@ namespace golf_sim {
             // Examine each of the search balls and remove any other balls that are both
             // much worse in quality and nearby the search ball
 
-            std::vector<GolfBall> balls_copy = initial_balls;
+            // Snapshot just the metrics this filter reads (the erase()s below
+            // must not shift the outer iteration) instead of deep-copying the
+            // whole fat-GolfBall vector
+            struct CandidateMetrics {
+                double x;
+                double y;
+                uint quality_ranking;
+                GolfBall::BallColor ball_color;
+            };
+
+            std::vector<CandidateMetrics> candidates;
+            candidates.reserve(initial_balls.size());
+
+            for (const GolfBall& b : initial_balls) {
+                candidates.push_back(CandidateMetrics{ CvUtils::CircleX(b.ball_circle_), CvUtils::CircleY(b.ball_circle_),
+                                                       b.quality_ranking, b.ball_color_ });
+            }
 
-            for (size_t outer_index = 0; outer_index < balls_copy.size(); outer_index++) {
+            for (size_t outer_index = 0; outer_index < candidates.size(); outer_index++) {
 
-                GolfBall& current_ball = balls_copy[outer_index];
+                const CandidateMetrics& current_ball = candidates[outer_index];
 
                 for (int i = (int)initial_balls.size() - 1; i > (int)outer_index; i--) {
                     GolfBall& b = initial_balls[i];
 
-                    double ball_distance = current_ball.PixelDistanceFromBall(b);
-                    
+                    double x_distance = std::abs(current_ball.x - CvUtils::CircleX(b.ball_circle_));
+                    double y_distance = std::abs(current_ball.y - CvUtils::CircleY(b.ball_circle_));
+                    double ball_distance = std::sqrt(x_distance * x_distance + y_distance * y_distance);
+
                     // For ONNX balls, use position-based quality instead of HoughCircles quality ranking
                     int quality_difference;
-                    if (b.ball_color_ == GolfBall::BallColor::kONNXDetected && 
-                        current_ball.ball_color_ == GolfBall::BallColor::kONNXDetected) {
+                    if (b.ball_color_ == GolfBall::BallColor::kONNXDetected &&
+                        current_ball.ball_color == GolfBall::BallColor::kONNXDetected) {
                         // For ONNX balls, all have high confidence - use position difference as quality proxy
                         quality_difference = std::abs(i - (int)outer_index); // Position difference in sorted list
                     } else {
@@ -1888,8 +2194,6 @@ namespace golf_sim {
             // near another high-quality ball (e.g., position 1), but the second ball is a mistake and is
             // at a weird angle below/above the higher-quality ball.
 
-            std::vector<GolfBall> balls_copy = initial_balls;
-
             // This index should point to the highest-quality ball
             size_t outer_index = 0;
 
@@ -2120,14 +2424,21 @@ namespace golf_sim {
 
             GS_LOG_TRACE_MSG(trace, "AnalyzeStrobedBalls(ball).  calibrated_ball = " + calibrated_ball.Format());
 
+            // During detection, ONNX Runtime's intra-op pool is busy, so trim
+            // OpenCV's share of the cores to what the budget leaves over
+            GsThreadBudget::ScopedPhase budget_phase(GsThreadBudget::Phase::kDetection);
+
             if (!calibrated_ball.calibrated) {
 
                 GS_LOG_MSG(error, "AnalyzeStrobedBall called without a properly calibrated ball.");
                 return false;
             }
 
+            const bool putting_fast_path = kUsePuttingFastPath &&
+                GolfSimClubs::GetCurrentClubType() == GolfSimClubs::kPutter;
+
             if (GolfSimClubs::GetCurrentClubType() == GolfSimClubs::kPutter) {
-                GS_LOG_MSG(info, "In putting mode.");
+                GS_LOG_MSG(info, "In putting mode." + std::string(putting_fast_path ? "  Using the putting fast path." : ""));
             }
             else {
                 GS_LOG_MSG(info, "In driving mode.");
@@ -2188,6 +2499,32 @@ namespace golf_sim {
                 roi = cv::Rect{ 0, (int)(0.5 * strobed_balls_color_image.rows),
                            strobed_balls_color_image.cols, (int)(strobed_balls_color_image.rows * 0.49) };
             }
+            else if (kUsePredictiveBallSearchROI && processing_mode == BallImageProc::BallSearchMode::kStrobed) {
+                // The teed-up camera-1 ball plus the launch geometry constrains where
+                // the strobed exposures can appear, so search only that corridor.
+                // The corridor keeps the full image width (the ball crosses the frame
+                // horizontally) but clips the rows to a band around the expected ball
+                // center, sized by the expected strobed-ball radius (which already
+                // reflects the calibrated ball's distance for the camera-2 view).
+                cv::Vec2i expected_center = GetExpectedBallCenter();
+
+                int corridor_top = (int)std::round(expected_center[1] - kPredictiveROIRadiiAboveCenter * expected_strobed_ball_radius);
+                int corridor_bottom = (int)std::round(expected_center[1] + kPredictiveROIRadiiBelowCenter * expected_strobed_ball_radius);
+
+                corridor_top = std::max(0, corridor_top);
+                corridor_bottom = std::min(strobed_balls_color_image.rows - 1, corridor_bottom);
+
+                if (corridor_bottom > corridor_top) {
+                    roi = cv::Rect{ 0, corridor_top,
+                               strobed_balls_color_image.cols, corridor_bottom - corridor_top };
+
+                    GS_LOG_TRACE_MSG(trace, "AnalyzeStrobedBalls predictive ROI rows = [" + std::to_string(corridor_top) +
+                        ", " + std::to_string(corridor_bottom) + "] of " + std::to_string(strobed_balls_color_image.rows) + " total rows.");
+                }
+                else {
+                    GS_LOG_MSG(warning, "AnalyzeStrobedBalls predictive ROI collapsed - falling back to a full-frame search.");
+                }
+            }
             else {
                 // Leave the ROI as it was originally constructed by default - all 0's
             }
@@ -2196,7 +2533,57 @@ namespace golf_sim {
             GolfBall non_const_ball = calibrated_ball;
             non_const_ball.average_color_ = GsColorTriplet(0, 0, 0);
 
-            bool result = ip->GetBall(strobed_balls_color_image, non_const_ball, initial_balls, roi, processing_mode, useLargestFoundBall, dontReportErrors);
+            bool result = false;
+
+            if (!kUseExpandingBallSearch || roi.height <= 0 ||
+                processing_mode != BallImageProc::BallSearchMode::kStrobed) {
+                result = ip->GetBall(strobed_balls_color_image, non_const_ball, initial_balls, roi, processing_mode, useLargestFoundBall, dontReportErrors);
+            }
+            else {
+                // Expanding search - scan the high-probability corridor first and
+                // only widen (by kBallSearchExpansionFactor each time) when too few
+                // candidates turn up, ending with a full-frame scan for mishits.
+                // Typical shots finish after the first, small pass.  The expensive
+                // full-frame color mask is computed once by the first GetBall call
+                // and reused by any later passes (see color_mask_image_).
+                cv::Vec2i expansion_center = GetExpectedBallCenter();
+
+                double radii_above = kPredictiveROIRadiiAboveCenter;
+                double radii_below = kPredictiveROIRadiiBelowCenter;
+
+                for (int search_stage = 0; ; search_stage++) {
+
+                    int corridor_top = std::max(0, (int)std::round(expansion_center[1] - radii_above * expected_strobed_ball_radius));
+                    int corridor_bottom = std::min(strobed_balls_color_image.rows - 1,
+                        (int)std::round(expansion_center[1] + radii_below * expected_strobed_ball_radius));
+
+                    bool is_full_frame = (corridor_top == 0 && corridor_bottom == strobed_balls_color_image.rows - 1);
+
+                    cv::Rect stage_roi;
+                    if (!is_full_frame) {
+                        stage_roi = cv::Rect{ 0, corridor_top,
+                                   strobed_balls_color_image.cols, corridor_bottom - corridor_top };
+                    }
+
+                    initial_balls.clear();
+                    result = ip->GetBall(strobed_balls_color_image, non_const_ball, initial_balls, stage_roi, processing_mode, useLargestFoundBall, dontReportErrors);
+
+                    if ((result && (int)initial_balls.size() >= kBallSearchMinInitialCandidates) || is_full_frame) {
+                        GS_LOG_TRACE_MSG(trace, "AnalyzeStrobedBalls expanding search finished at stage " +
+                            std::to_string(search_stage) + (is_full_frame ? " (full frame)" :
+                            " (rows [" + std::to_string(corridor_top) + ", " + std::to_string(corridor_bottom) + "])") +
+                            " with " + std::to_string(initial_balls.size()) + " candidate(s).");
+                        break;
+                    }
+
+                    GS_LOG_TRACE_MSG(trace, "AnalyzeStrobedBalls expanding search found only " +
+                        std::to_string(initial_balls.size()) + " candidate(s) in rows [" + std::to_string(corridor_top) +
+                        ", " + std::to_string(corridor_bottom) + "] - widening the corridor.");
+
+                    radii_above *= kBallSearchExpansionFactor;
+                    radii_below *= kBallSearchExpansionFactor;
+                }
+            }
 
             int number_of_initial_balls = (int)initial_balls.size();
 
@@ -2208,6 +2595,17 @@ namespace golf_sim {
 
             ShowAndLogBalls("AnalyzeStrobedBall_Initial_Candidate_Balls", strobed_balls_color_image, initial_balls, kLogIntermediateExposureImagesToFile);
 
+            // Cut the candidate set down to the retain horizon before the
+            // per-candidate stages below (localization, color statistics)
+            // spend time on balls that cannot survive the later
+            // RemoveLowScoringBalls calls anyway.  The list arrives
+            // quality-sorted from GetBall, so this is a pure truncation.
+            if (kUseEarlyCandidateTruncation && (int)initial_balls.size() > kMaxBallsToRetain) {
+                GS_LOG_TRACE_MSG(trace, "AnalyzeStrobedBalls truncating " + std::to_string(initial_balls.size()) +
+                    " candidates to the top " + std::to_string(kMaxBallsToRetain) + " before the per-candidate stages.");
+                RemoveLowScoringBalls(initial_balls, kMaxBallsToRetain);
+            }
+
             GolferOrientation handedness;
 
             if (!DetermineHandedness(initial_balls, handedness)) {
@@ -2232,22 +2630,46 @@ namespace golf_sim {
             double max_color_difference = (GolfSimClubs::GetCurrentClubType() == GolfSimClubs::kPutter) ? kMaxPuttingBallColorDifferenceRelaxed : kMaxStrobedBallColorDifferenceRelaxed;
             
             // *** ONNX PHYSICS CALCULATION - Essential distance/angle calculations for ONNX balls ***
-            for (auto& ball : initial_balls) {
-                if (ball.ball_color_ == GolfBall::BallColor::kONNXDetected) {
-                    GS_LOG_TRACE_MSG(trace, "Adding physics calculations for ONNX ball at (" + 
-                                   std::to_string(ball.x()) + "," + std::to_string(ball.y()) + ")");
-                    
-                    // 1. Compute essential distance/angle/calibration data
-                    if (!ComputeSingleBallXYZOrthoCamPerspective(*this, ball)) {
-                        GS_LOG_MSG(warning, "Failed to compute spatial physics for ONNX ball - continuing anyway");
+            if (kUseBatchedBallLocalization) {
+
+                // Localize all of the candidates in one batched pass instead of
+                // re-deriving the camera-angle trig ball-by-ball
+                std::vector<GolfBall*> onnx_balls;
+                for (auto& ball : initial_balls) {
+                    if (ball.ball_color_ == GolfBall::BallColor::kONNXDetected) {
+                        onnx_balls.push_back(&ball);
+                    }
+                }
+
+                if (!onnx_balls.empty()) {
+                    if (!ComputeBallsXYZOrthoCamPerspective(*this, onnx_balls)) {
+                        GS_LOG_MSG(warning, "Failed to compute spatial physics for one or more ONNX balls - continuing anyway");
+                    }
+
+                    // Get color information for display/logging (avgC, stdC fields)
+                    for (GolfBall* ball : onnx_balls) {
+                        GetBallColorInformation(strobed_balls_color_image, *ball);
+                    }
+                }
+            }
+            else {
+                for (auto& ball : initial_balls) {
+                    if (ball.ball_color_ == GolfBall::BallColor::kONNXDetected) {
+                        GS_LOG_TRACE_MSG(trace, "Adding physics calculations for ONNX ball at (" +
+                                       std::to_string(ball.x()) + "," + std::to_string(ball.y()) + ")");
+
+                        // 1. Compute essential distance/angle/calibration data
+                        if (!ComputeSingleBallXYZOrthoCamPerspective(*this, ball)) {
+                            GS_LOG_MSG(warning, "Failed to compute spatial physics for ONNX ball - continuing anyway");
+                        }
+
+                        // 2. Get color information for display/logging (avgC, stdC fields)
+                        GetBallColorInformation(strobed_balls_color_image, ball);
+
+                        GS_LOG_TRACE_MSG(trace, "ONNX ball physics complete: DistFromLens=" +
+                                       std::to_string(ball.distance_to_z_plane_from_lens_) + "m, CalFocLen=" +
+                                       std::to_string(ball.calibrated_focal_length_));
                     }
-                    
-                    // 2. Get color information for display/logging (avgC, stdC fields)
-                    GetBallColorInformation(strobed_balls_color_image, ball);
-                    
-                    GS_LOG_TRACE_MSG(trace, "ONNX ball physics complete: DistFromLens=" + 
-                                   std::to_string(ball.distance_to_z_plane_from_lens_) + "m, CalFocLen=" + 
-                                   std::to_string(ball.calibrated_focal_length_));
                 }
             }
             
@@ -2469,6 +2891,28 @@ namespace golf_sim {
                 for (size_t first_index = 0; first_index < return_balls.size(); first_index++) {
                     GolfBall& original_ball = return_balls[first_index];
 
+                    // On the putting fast path, only the two exposures that the putt
+                    // result will actually be computed from are worth refining.
+                    if (putting_fast_path &&
+                        (int)first_index != most_centered_ball_index && (int)first_index != second_ball_index) {
+                        continue;
+                    }
+
+                    // Confidence gate - when the circle we already have shows strong,
+                    // consistent edge support all around its rim, the targeted
+                    // refinement (Canny + Hough over the ball's ROI) will not move it
+                    // meaningfully, so skip that work for this candidate.
+                    if (BallImageProc::kBestCircleRefinementConfidenceThreshold > 0.0) {
+                        double edge_support = BallImageProc::ComputeCircleEdgeSupport(
+                            strobed_balls_gray_image, original_ball.ball_circle_);
+
+                        if (edge_support >= BallImageProc::kBestCircleRefinementConfidenceThreshold) {
+                            GS_LOG_TRACE_MSG(trace, "Skipping best-circle refinement for ball " + std::to_string(first_index) +
+                                " - rim edge support of " + std::to_string(edge_support) + " is already above threshold.");
+                            continue;
+                        }
+                    }
+
                     GsCircle best_circle;
 
                     if (first_index == 0) {
@@ -2518,6 +2962,14 @@ namespace golf_sim {
             face_ball = return_balls[most_centered_ball_index];
             ball2 = return_balls[second_ball_index];
 
+            // The non-overlapping exposure set below exists only to feed the spin
+            // analysis, and putts never run it (see ProcessReceivedCam2Image), so
+            // the putting fast path can return with just the two chosen exposures.
+            if (putting_fast_path) {
+                non_overlapping_balls_and_timing.clear();
+                return true;
+            }
+
             // Also return a set of fairly-strictly-non-overlapping balls for use with, e.g., spin analysis
             // NOTE - if there is a negative %, it is here to make sure the balls are well-separated.  
             // Otherwise, we sometimes get some overlap with a ball that was missed.
@@ -3230,6 +3682,12 @@ namespace golf_sim {
 
             GS_LOG_TRACE_MSG(trace, "ProcessReceivedCam2Image called.");
 
+            // The per-stage timings (and perf counters, if enabled) are rebuilt
+            // over the course of this call
+            last_strobed_analysis_time_ms_ = 0.0;
+            last_spin_analysis_time_ms_ = 0.0;
+            GsPerfCounters::ResetShotCounters();
+
             if (ball1_mat.empty()) {
                 GS_LOG_MSG(error, "ProcessReceivedCam2Image received empty ball1_mat.");
                 return false;
@@ -3240,7 +3698,45 @@ namespace golf_sim {
                 return false;
             }
 
-            cv::Mat prepared_strobed_ball_mat = strobed_ball_mat.clone();
+            const CameraHardware::CameraModel  camera_1_model = GolfSimCamera::kSystemSlot1CameraType;
+            const CameraHardware::LensType  camera_lens_type = GolfSimCamera::kSystemSlot1LensType;
+
+            // Get the ball data.  We will calibrate based on the first ball and then get the second one
+            // using that calibrated data from the first ball.
+
+            GolfSimCamera camera_1;
+            camera_1.camera_hardware_.init_camera_parameters(GsCameraNumber::kGsCamera1, camera_1_model, camera_lens_type);
+
+            cv::Vec2i expectedBallCenter = cv::Vec2i(1456 / 2, 1088 / 2);
+
+            if (GolfSimOptions::GetCommandLineOptions().search_center_x_ > 0) {
+                expectedBallCenter[0] = GolfSimOptions::GetCommandLineOptions().search_center_x_;
+            }
+
+            if (GolfSimOptions::GetCommandLineOptions().search_center_y_ > 0) {
+                expectedBallCenter[1] = GolfSimOptions::GetCommandLineOptions().search_center_y_;
+            }
+
+            // Will hold the location information about the first ball from the initial, static, image
+            GolfBall calibrated_ball;
+
+            // The teed-ball calibration reads only the camera-1 image, and the
+            // strobed-image preparation below touches only camera-2 data, so
+            // the two can overlap.  On the Pi 5's four cores this reclaims
+            // time that would otherwise be spent back-to-back on this thread.
+            std::future<bool> calibrated_ball_future;
+
+            if (kUsePipelinedShotAnalysis) {
+                calibrated_ball_future = std::async(std::launch::async, [&]() {
+                    return camera_1.GetCalibratedBall(camera_1, ball1_mat, calibrated_ball, expectedBallCenter);
+                    });
+            }
+
+            // Only the pre-image-subtraction branch below writes into the incoming
+            // buffer, so only that branch needs a defensive copy.  Everything
+            // downstream reads this image without modifying it, so a shared
+            // header is otherwise enough.
+            cv::Mat prepared_strobed_ball_mat = strobed_ball_mat;
 
             if (!kUsePreImageSubtraction) {
                 // Do no subtraction
@@ -3274,23 +3770,59 @@ namespace golf_sim {
                     GolfSimConfiguration::SetConstant("gs_config.ball_exposure_selection.kPreImageWeightingRed", kPreImageWeightingRed);
 
 
-                    std::vector<cv::Mat> bgr;
+                    // Subtract the (per-channel weighted) pre-image from the incoming strobed
+                    // image to (hopefully) end up with just the golf balls and not all the
+                    // background clutter.
+                    // The subtraction writes into the incoming buffer, so take the
+                    // defensive copy (the only one this function still needs) here.
+                    prepared_strobed_ball_mat = strobed_ball_mat.clone();
+
+                    bool subtraction_done = false;
+
+#if defined(__aarch64__)
+                    // Fused single-pass kernel: applies the channel weights and the
+                    // subtraction in one walk over the interleaved BGR data, instead of
+                    // the split / multiply / merge / subtract full-frame passes below.
+                    // This runs at full resolution on the critical path of every
+                    // strobed shot.
+                    if (prepared_strobed_ball_mat.type() == CV_8UC3 &&
+                        camera2_pre_image_.type() == CV_8UC3 &&
+                        prepared_strobed_ball_mat.size() == camera2_pre_image_.size() &&
+                        prepared_strobed_ball_mat.isContinuous() && camera2_pre_image_.isContinuous()) {
+
+                        float weight_blue = (float)(kPreImageWeightingOverall * kPreImageWeightingBlue);
+                        float weight_green = (float)(kPreImageWeightingOverall * kPreImageWeightingGreen);
+                        float weight_red = (float)(kPreImageWeightingOverall * kPreImageWeightingRed);
+
+                        if (GsCpuDispatch::GetTuningTarget() == GsCpuDispatch::kTuneCortexA72) {
+                            tuned_a72::WeightedPreImageSubtractNEON(prepared_strobed_ball_mat, camera2_pre_image_,
+                                weight_blue, weight_green, weight_red, strobed_ball_mat);
+                        }
+                        else {
+                            tuned_a76::WeightedPreImageSubtractNEON(prepared_strobed_ball_mat, camera2_pre_image_,
+                                weight_blue, weight_green, weight_red, strobed_ball_mat);
+                        }
+
+                        subtraction_done = true;
+                    }
+#endif
+
+                    if (!subtraction_done) {
+                        std::vector<cv::Mat> bgr;
 
-                    cv::split(camera2_pre_image_, bgr);
-                    bgr[0] = bgr[0] * kPreImageWeightingOverall * kPreImageWeightingBlue;
-                    bgr[1] = bgr[1] * kPreImageWeightingOverall * kPreImageWeightingGreen;
-                    bgr[2] = bgr[2] * kPreImageWeightingOverall * kPreImageWeightingRed;
+                        cv::split(camera2_pre_image_, bgr);
+                        bgr[0] = bgr[0] * kPreImageWeightingOverall * kPreImageWeightingBlue;
+                        bgr[1] = bgr[1] * kPreImageWeightingOverall * kPreImageWeightingGreen;
+                        bgr[2] = bgr[2] * kPreImageWeightingOverall * kPreImageWeightingRed;
 
+                        cv::Mat final_pre_image;    // = camera2_pre_image_;
+                        cv::merge(bgr, final_pre_image);
 
-                    cv::Mat final_pre_image;    // = camera2_pre_image_;
-                    cv::merge(bgr, final_pre_image);
+                        // LoggingTools::LogImage("", final_pre_image, std::vector < cv::Point >{}, true, "scaled_pre_image.png");
 
-                    // LoggingTools::LogImage("", final_pre_image, std::vector < cv::Point >{}, true, "scaled_pre_image.png");
+                        cv::subtract(prepared_strobed_ball_mat, final_pre_image, strobed_ball_mat);
+                    }
 
-                    // Subtract the pre-image from the incoming strobed image to (hopefully) end up with just
-                    // the golf balls and not all the background clutter
-                    cv::Mat strobed_ball_mat_copy = prepared_strobed_ball_mat.clone();
-                    cv::subtract(strobed_ball_mat_copy, final_pre_image, strobed_ball_mat);
                     LoggingTools::LogImage("", prepared_strobed_ball_mat, std::vector < cv::Point >{}, true, "strobed_img_minus_pre_image.png");
                 }
             }
@@ -3317,19 +3849,22 @@ namespace golf_sim {
             auto grayscale_duration = std::chrono::duration_cast<std::chrono::microseconds>(grayscale_end - grayscale_start);
             GS_LOG_MSG(info, "Grayscale conversion completed in " + std::to_string(grayscale_duration.count()) + "us");
 
-            const CameraHardware::CameraModel  camera_1_model = GolfSimCamera::kSystemSlot1CameraType;
-            const CameraHardware::LensType  camera_lens_type = GolfSimCamera::kSystemSlot1LensType;
-
-            // Get the ball data.  We will calibrate based on the first ball and then get the second one
-            // using that calibrated data from the first ball.
+            /*****************************  Get the first (teed) ball  ***************************/
+            bool success;
 
-            GolfSimCamera camera_1;
-            camera_1.camera_hardware_.init_camera_parameters(GsCameraNumber::kGsCamera1, camera_1_model, camera_lens_type);
+            if (kUsePipelinedShotAnalysis) {
+                // Join with the calibration that ran alongside the strobed-image
+                // preparation above
+                success = calibrated_ball_future.get();
+            }
+            else {
+                success = camera_1.GetCalibratedBall(camera_1, ball1_mat, calibrated_ball, expectedBallCenter);
+            }
 
             // One set of positions, below describes the relationship of camera2 to itself and the z-plane of the ball.
             // That set does not contain any displacement in the X,Y plane.
             // The offsets are from the origin, which is assumed to be where the ball is placed
-            // A second set of positions describes the relationship of camera2 to camera1 so that trajectories 
+            // A second set of positions describes the relationship of camera2 to camera1 so that trajectories
             // may be calculated as between the initial ball image and the second images.
 
             // TBD - Get rid of this stuff
@@ -3338,22 +3873,6 @@ namespace golf_sim {
             camera_1.camera_hardware_.firstCannedImage = ball1ImgColor;
             camera_1.camera_hardware_.secondCannedImage = strobed_balls_color_image;
 
-            cv::Vec2i expectedBallCenter = cv::Vec2i(1456 / 2, 1088 / 2);
-
-            if (GolfSimOptions::GetCommandLineOptions().search_center_x_ > 0) {
-                expectedBallCenter[0] = GolfSimOptions::GetCommandLineOptions().search_center_x_;
-            }
-
-            if (GolfSimOptions::GetCommandLineOptions().search_center_y_ > 0) {
-                expectedBallCenter[1] = GolfSimOptions::GetCommandLineOptions().search_center_y_;
-            }
-
-            // Get the location information about the first ball from the initial, static, image
-            GolfBall calibrated_ball;
-
-            /*****************************  Get the first (teed) ball  ***************************/
-            bool success = camera_1.GetCalibratedBall(camera_1, ball1_mat, calibrated_ball, expectedBallCenter);
-
             if (!success) {
                 GS_LOG_TRACE_MSG(trace, "ProcessReceivedCam2Image - Failed to GetCalibratedBall.");
                 return false;
@@ -3389,15 +3908,20 @@ namespace golf_sim {
             camera_2.camera_hardware_.init_camera_parameters(GsCameraNumber::kGsCamera2, camera_2_model, camera_2_lens_type);
 
 
+            const auto strobed_analysis_start_time = std::chrono::steady_clock::now();
+
             success = camera_2.AnalyzeStrobedBalls(strobed_balls_color_image,
                                             strobed_balls_gray_image,
-                                            calibrated_ball, 
-                                            return_balls_and_timing, 
-                                            non_overlapping_balls_and_timing, 
-                                            first_strobed_ball, 
-                                            second_strobed_ball, 
+                                            calibrated_ball,
+                                            return_balls_and_timing,
+                                            non_overlapping_balls_and_timing,
+                                            first_strobed_ball,
+                                            second_strobed_ball,
                                             time_between_balls_uS);
 
+            last_strobed_analysis_time_ms_ = std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - strobed_analysis_start_time).count();
+
             if (!success || return_balls_and_timing.size() < 2) {
                 GS_LOG_TRACE_MSG(trace, "ProcessReceivedCam2Image - Could not find two balls");
                 ReportBallSearchError((int)return_balls_and_timing.size());
@@ -3412,6 +3936,42 @@ namespace golf_sim {
                 exposure_balls.push_back(exposure_ball_and_timing.ball);
             }
 
+            bool kSkipSpinCalculation = false;
+            GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.kSkipSpinCalculation", kSkipSpinCalculation);
+
+            const bool spin_analysis_needed = !kSkipSpinCalculation &&
+                GolfSimClubs::GetCurrentClubType() != GolfSimClubs::kPutter &&
+                non_overlapping_balls_and_timing.size() >= 2;
+
+            // The spin-ball pair is fully determined by the non-overlapping
+            // exposure set that was just selected, so the (lengthy) rotation
+            // measurement can start now and run in parallel with all of the
+            // angle and velocity work below.  Nothing here is discarded - the
+            // rotation is applied to the result ball at the join point.
+            std::future<bool> spin_rotation_future;
+            cv::Vec3d early_rotation_results;
+            double early_spin_timing_interval_uS = 0.0;
+            double speculative_spin_elapsed_ms = 0.0;
+
+            if (kUseSpeculativeSpinAnalysis && spin_analysis_needed) {
+                spin_rotation_future = std::async(std::launch::async, [&]() {
+                    // A private camera object, so that the worker shares
+                    // nothing mutable with the work on this thread
+                    GolfSimCamera spin_camera;
+                    spin_camera.camera_hardware_.init_camera_parameters(GsCameraNumber::kGsCamera2, camera_2_model, camera_2_lens_type);
+
+                    const auto spin_start_time = std::chrono::steady_clock::now();
+
+                    bool spin_ok = ComputeSpinRotation(spin_camera, strobed_balls_gray_image, non_overlapping_balls_and_timing,
+                        early_rotation_results, early_spin_timing_interval_uS);
+
+                    speculative_spin_elapsed_ms = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - spin_start_time).count();
+
+                    return spin_ok;
+                    });
+            }
+
             // First, determine a velocity based on the two best balls as determined by the
             // AnalyzeStrobedBall method.
 
@@ -3542,16 +4102,19 @@ namespace golf_sim {
             // Overwrite the VLA angle information with the (hopefully) more accurate angles formed by the angles between each of the strobed balls
             result_ball.angles_ball_perspective_[1] = average_of_strobed_ball_data.angles_ball_perspective_[1];
 
-            // Send a quick IPCResult message here to allow the user to quickly
-            // see the angular and velocity information before we do the (lengthy) spin measurement.
-#ifdef __unix__ 
-            // TBD - Note the sleep in the send will slow us down getting to the spin measurement
-            // once spin is faster, we should just send the final message
-            // GsUISystem::SendIPCHitMessage(result_ball);
+            // The kinematics are final at this point - only the (much slower)
+            // spin measurement is still outstanding.  With progressive
+            // delivery on, get the ballistics out the door now:  the GUI
+            // shows speed and launch angles immediately, and sims whose
+            // protocol takes a later update for the same shot number get the
+            // spin as a follow-up from the caller's SendResultsToGolfSims.
+#ifdef __unix__
+            if (GsSimInterface::kUseProgressiveResultDelivery) {
+                GsResults early_results(result_ball);
+                GsSimInterface::SendBallisticsToGolfSims(early_results);
+                GsUISystem::SendIPCHitMessage(result_ball, " Ballistics final - spin measurement still running.");
+            }
 #endif
-            bool kSkipSpinCalculation = false;
-            GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.kSkipSpinCalculation", kSkipSpinCalculation);
-
             if (kSkipSpinCalculation || GolfSimClubs::GetCurrentClubType() == GolfSimClubs::kPutter) {
                 // Do nothing regarding spin and just get back as quickly as possible
                 GS_LOG_TRACE_MSG(trace, "Skipping spin analysis.");
@@ -3569,12 +4132,38 @@ namespace golf_sim {
                     return true;
                 }
 
-                // Determine the spin based on the two closest balls in the strictly 
+                // Determine the spin based on the two closest balls in the strictly
                 // non-overlapping set of balls, and apply that information to the result_ball
                 // that we are building up.
-                if (!ProcessSpin(camera_2, strobed_balls_gray_image, non_overlapping_balls_and_timing,
-                    result_ball, rotationResults)) {
+                bool spin_success;
+
+                if (kUseSpeculativeSpinAnalysis) {
+                    // The rotation measurement has been running alongside the
+                    // angle and velocity work above - just collect and apply it
+                    spin_success = spin_rotation_future.get();
+
+                    // The worker's measurement duration, not the (usually much
+                    // shorter) wait for the future - regressions in the spin code
+                    // would otherwise hide behind the overlapped execution
+                    last_spin_analysis_time_ms_ = speculative_spin_elapsed_ms;
+
+                    if (spin_success) {
+                        rotationResults = early_rotation_results;
+                        CalculateBallSpinRates(result_ball, rotationResults, (long)std::round(early_spin_timing_interval_uS));
+                        result_ball.time_between_angle_measures_for_rpm_uS_ = (long)std::round(early_spin_timing_interval_uS);
+                    }
+                }
+                else {
+                    const auto spin_start_time = std::chrono::steady_clock::now();
+
+                    spin_success = ProcessSpin(camera_2, strobed_balls_gray_image, non_overlapping_balls_and_timing,
+                        result_ball, rotationResults);
 
+                    last_spin_analysis_time_ms_ = std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - spin_start_time).count();
+                }
+
+                if (!spin_success) {
                     // If we can't compute spin, it's a bummer, but it shouldn't be fatal
                     std::string error_str = "Unable to compute spin.";
                     GS_LOG_MSG(warning, error_str);
@@ -3592,13 +4181,35 @@ namespace golf_sim {
 
         bool GolfSimCamera::ProcessSpin(GolfSimCamera &camera,
                                         const cv::Mat& strobed_balls_gray_image,
-                                        const GsBallsAndTimingVector& non_overlapping_balls_and_timing, 
+                                        const GsBallsAndTimingVector& non_overlapping_balls_and_timing,
                                         GolfBall& result_ball,
                                         cv::Vec3d& rotationResults) {
 
+            double spin_timing_interval_uS = 0.0;
+
+            if (!ComputeSpinRotation(camera, strobed_balls_gray_image, non_overlapping_balls_and_timing,
+                                     rotationResults, spin_timing_interval_uS)) {
+                return false;
+            }
+
+            // Calculate the spin RPMs into the result ball
+            camera.CalculateBallSpinRates(result_ball, rotationResults, (long)std::round(spin_timing_interval_uS));
+
+            result_ball.time_between_angle_measures_for_rpm_uS_ = (long)std::round(spin_timing_interval_uS);
+
+            return true;
+        }
+
+
+        bool GolfSimCamera::ComputeSpinRotation(GolfSimCamera& camera,
+                                        const cv::Mat& strobed_balls_gray_image,
+                                        const GsBallsAndTimingVector& non_overlapping_balls_and_timing,
+                                        cv::Vec3d& rotationResults,
+                                        double& spin_timing_interval_uS) {
+
             GolfBall spin_ball1;
             GolfBall spin_ball2;
-            double spin_timing_interval_uS = 0.0;
+            spin_timing_interval_uS = 0.0;
 
             // Try to find the two closest balls while avoiding any balls really close to the edge if we can.
             // Back off if necessary
@@ -3612,7 +4223,7 @@ namespace golf_sim {
             // Now use the two 'best' balls to determine the position deltas for the balls so that we 
             // can, for example, compute velocity
             if (!camera.ComputeBallDeltas(spin_ball1, spin_ball2, camera, camera)) {
-                GS_LOG_MSG(error, "ProcessSpin - failed to ComputeBallDeltas for spin ball.");
+                GS_LOG_MSG(error, "ComputeSpinRotation - failed to ComputeBallDeltas for spin ball.");
                 return false;
             }
 
@@ -3625,15 +4236,14 @@ namespace golf_sim {
             ShowAndLogBalls("ProcessSpin - Final Spin Balls", strobed_balls_gray_image, finalSpinBalls, kLogIntermediateExposureImagesToFile);
 
 
-            // The best spin analysis will likely be between the two closest balls that are non-overlapping
-            rotationResults = BallImageProc::GetBallRotation(strobed_balls_gray_image, spin_ball1, strobed_balls_gray_image, spin_ball2);
+            // The best spin analysis will likely be between the two closest balls that are non-overlapping.
+            // If the idle camera-2 Pi is available to run the rotation search (see
+            // GsSpinOffload), use it; otherwise compute here as always.
+            if (!GsSpinOffload::TryRemoteBallRotation(strobed_balls_gray_image, spin_ball1, strobed_balls_gray_image, spin_ball2, rotationResults)) {
+                rotationResults = BallImageProc::GetBallRotation(strobed_balls_gray_image, spin_ball1, strobed_balls_gray_image, spin_ball2);
+            }
 
             // TBD - Find the interval between spin_ball1 and spin_ball2
-            // 
-            // Calculate the spin RPMs into the result ball
-            camera.CalculateBallSpinRates(result_ball, rotationResults, (long)std::round(spin_timing_interval_uS));
-
-            result_ball.time_between_angle_measures_for_rpm_uS_ = (long)std::round(spin_timing_interval_uS);
 
             return true;
         }
@@ -3822,12 +4432,134 @@ namespace golf_sim {
             double kRadiusSimilarityScoreWeighting = 7;
 
 
-            for (size_t i = 0; i < balls_and_timing.size(); i++) { 
+            if (kUseVectorizedPairScoring && balls_and_timing.size() >= 2) {
+
+                // With kStrobedBallsMaxHoughReturnCircles candidates the pair scoring below is
+                // quadratic, so hoist the per-ball quantities into structure-of-arrays row
+                // vectors once and compute the pairwise metrics as whole-matrix OpenCV
+                // operations.  The score formulas are identical to the scalar loop in the
+                // else-branch - element (i, j) of each matrix describes the pair (ball i, ball j).
+                const int num_balls = (int)balls_and_timing.size();
+
+                cv::Mat ball_xs(1, num_balls, CV_64F);
+                cv::Mat ball_ys(1, num_balls, CV_64F);
+                cv::Mat ball_radii(1, num_balls, CV_64F);
+                cv::Mat ball_std_blues(1, num_balls, CV_64F);
+                cv::Mat ball_std_greens(1, num_balls, CV_64F);
+                cv::Mat ball_std_reds(1, num_balls, CV_64F);
+                cv::Mat ball_edge_penalties(1, num_balls, CV_64F);
+                cv::Mat ball_middle_scores(1, num_balls, CV_64F);
+
+                cv::Point screen_center = cv::Point(img.cols / 2, img.rows / 2);
+                cv::Point screen_edge = cv::Point(img.cols, img.rows);
+                double distance_from_screen_center_to_edge = CvUtils::GetDistance(screen_edge, screen_center);
+
+                for (int i = 0; i < num_balls; i++) {
+                    const GolfBall& ball = balls_and_timing[i].ball;
+                    // Create one vector of just the balls (no timing) to use for averaging
+                    balls.push_back(ball);
+
+                    ball_xs.at<double>(i) = ball.x();
+                    ball_ys.at<double>(i) = ball.y();
+                    ball_radii.at<double>(i) = ball.measured_radius_pixels_;
+                    ball_std_blues.at<double>(i) = ball.std_color_[0];
+                    ball_std_greens.at<double>(i) = ball.std_color_[1];
+                    ball_std_reds.at<double>(i) = ball.std_color_[2];
+
+                    bool is_near_edge = (ball.x() - ball.measured_radius_pixels_ < minX ||
+                                         ball.x() + ball.measured_radius_pixels_ > maxX ||
+                                         ball.y() - ball.measured_radius_pixels_ < minY ||
+                                         ball.y() + ball.measured_radius_pixels_ > maxY);
+                    ball_edge_penalties.at<double>(i) = is_near_edge ? 5.0 : 0.0;
+
+                    double ball_distance_from_screen_center = CvUtils::GetDistance(cv::Point(ball.x(), ball.y()), screen_center);
+                    ball_middle_scores.at<double>(i) = 5.0 * ((distance_from_screen_center_to_edge - ball_distance_from_screen_center) / distance_from_screen_center_to_edge);
+                }
+
+                // Broadcast the row vectors into num_balls x num_balls matrices.  Element
+                // (i, j) of the repeated matrix is the j'th ball's value, and of its
+                // transpose the i'th ball's value.
+                cv::Mat x_js = cv::repeat(ball_xs, num_balls, 1);
+                cv::Mat x_is = x_js.t();
+                cv::Mat y_js = cv::repeat(ball_ys, num_balls, 1);
+                cv::Mat y_is = y_js.t();
+                cv::Mat radius_js = cv::repeat(ball_radii, num_balls, 1);
+                cv::Mat radius_is = radius_js.t();
+
+                cv::Mat pair_distances;
+                cv::magnitude(x_is - x_js, y_is - y_js, pair_distances);
+
+                cv::Mat radius_sums = radius_is + radius_js;
+
+                // If the balls are overlapping, give the result a low score - they will
+                // likely be too smudgy for a good spin calculation.  (The division by a
+                // zero self-distance on the diagonal is masked out here as well.)
+                cv::Mat pair_proximity_scores = 10.0 * radius_sums / pair_distances;
+                pair_proximity_scores.setTo(0.0, pair_distances < 0.95 * radius_sums);
+
+                // A large difference in color STD suggests that one ball has some overlap with
+                // something bright that will affect its ability to be accurately filtered for spin
+                cv::Mat blue_js = cv::repeat(ball_std_blues, num_balls, 1);
+                cv::Mat green_js = cv::repeat(ball_std_greens, num_balls, 1);
+                cv::Mat red_js = cv::repeat(ball_std_reds, num_balls, 1);
+                cv::Mat blue_deltas = cv::Mat(blue_js.t()) - blue_js;
+                cv::Mat green_deltas = cv::Mat(green_js.t()) - green_js;
+                cv::Mat red_deltas = cv::Mat(red_js.t()) - red_js;
+
+                cv::Mat std_diffs;
+                cv::sqrt(blue_deltas.mul(blue_deltas) + green_deltas.mul(green_deltas) + red_deltas.mul(red_deltas), std_diffs);
+                cv::Mat color_std_scores = cv::max((30.0 - std_diffs) / 3.0, 0.0);
+
+                // The 13.6 and 8 just allows the too-big-of-a-radius-change limit to be relative to the
+                // number of pixels we have to work with.  Should be about 08.
+                cv::Mat radius_deltas = radius_is - radius_js;
+                cv::Mat radius_terms = (img.rows / 13.6) - 3.0 * radius_deltas.mul(radius_deltas);
+                cv::Mat radius_similarity_scores = cv::max(radius_terms, 0.0) / 8.;
+
+                // Not implemented yet - TBD (mirrors the scalar loop, which zeroes the
+                // leg-proximity weighting for both golfer orientations)
+                kLegProximityScoreWeighting = 0;
+
+                // Gather the upper triangle of the score matrices back into the per-pair
+                // elements used for sorting and tracing.
+                for (int i = 0; i < num_balls - 1; i++) {
+                    for (int j = i + 1; j < num_balls; j++) {
+
+                        GsBallPairAndSpinCandidateScoreElement ball_pair_element;
+
+                        ball_pair_element.ball1 = balls_and_timing[i].ball;
+                        ball_pair_element.ball2 = balls_and_timing[j].ball;
+
+                        ball_pair_element.ball1_index = i;
+                        ball_pair_element.ball2_index = j;
+
+                        ball_pair_element.edge_proximity_score = 10.0 - ball_edge_penalties.at<double>(i) - ball_edge_penalties.at<double>(j);
+                        ball_pair_element.pair_proximity_score = pair_proximity_scores.at<double>(i, j);
+                        ball_pair_element.color_std_score = color_std_scores.at<double>(i, j);
+                        ball_pair_element.middle_proximity_score = ball_middle_scores.at<double>(i) + ball_middle_scores.at<double>(j);
+                        ball_pair_element.leg_proximity_score = 0;
+                        ball_pair_element.radius_similarity_score = radius_similarity_scores.at<double>(i, j);
+
+                        ball_pair_element.total_pair_score =
+                            kEdgeProximityScoreWeighting * ball_pair_element.edge_proximity_score +
+                            kPairProximityScoreWeighting * ball_pair_element.pair_proximity_score +
+                            kColorStdScoreWeighting * ball_pair_element.color_std_score +
+                            kMiddleProximityScoreWeighting * ball_pair_element.middle_proximity_score +
+                            kLegProximityScoreWeighting * ball_pair_element.leg_proximity_score +
+                            kRadiusSimilarityScoreWeighting * ball_pair_element.radius_similarity_score;
+
+                        ball_pair_elements.push_back(ball_pair_element);
+                    }
+                }
+            }
+            else {
+
+            for (size_t i = 0; i < balls_and_timing.size(); i++) {
                 const GolfBall& ball1 = balls_and_timing[i].ball;
                 // Create one vector of just the balls (no timing) to use for averaging
                 balls.push_back(ball1);
 
-                // For each ball, pair it with all the other balls 
+                // For each ball, pair it with all the other balls
                 // (shouldn't be much more than 100 pairs)
                 for (size_t j = i + 1; j < balls_and_timing.size(); j++) {
                     const GolfBall& ball2 = balls_and_timing[j].ball;
@@ -3925,9 +4657,10 @@ namespace golf_sim {
 
                     ball_pair_elements.push_back(ball_pair_element);
                 }
-                
+
             }
 
+            }
 
             if (ball_pair_elements.size() < 1) {
                 GS_LOG_TRACE_MSG(warning, "Could not find any potential ball pairs for spin analysis");
@@ -4167,10 +4900,7 @@ namespace golf_sim {
             sleep(6);
 
             // Get the image that the IPC system should have saved
-            {
-                std::lock_guard<std::mutex> lock(GolfSimIpcSystem::last_received_image_mutex_);
-                color_image = GolfSimIpcSystem::last_received_image_.clone();
-            }
+            color_image = GolfSimIpcSystem::GetLastReceivedImage();
 
             if (color_image.empty()) {
                 GS_LOG_MSG(error, "FAILED to find an image from the IPC system.");
@@ -4185,7 +4915,7 @@ namespace golf_sim {
             // Pull the image from a static file for off-Pi testing
             BallImageProc* ip = get_image_processor();
 
-            color_image = cv::imread(kTestAutoCalibrationFileName, cv::IMREAD_COLOR);
+            color_image = GsImageIo::ReadImage(kTestAutoCalibrationFileName, cv::IMREAD_COLOR);
             ip->image_name_ = kTestAutoCalibrationFileName;
 
 #endif
@@ -4200,6 +4930,7 @@ namespace golf_sim {
         // the calibration rig puts the ball in space.
         cv::Vec3d GolfSimCamera::kAutoCalibrationBallPositionFromCameraMeters;
         int GolfSimCamera::kNumberPicturesForFocalLengthAverage = 1;
+        double GolfSimCamera::kAutoCalibrationConvergenceTolerancePercent = 0.5;
 
 
         bool GolfSimCamera::RetrieveAutoCalibrationConstants(const GsCameraNumber camera_number) {
@@ -4213,10 +4944,12 @@ namespace golf_sim {
             
             GolfSimConfiguration::SetConstant("gs_config.calibration.kNumberPicturesForFocalLengthAverage", kNumberPicturesForFocalLengthAverage);
 
+            GolfSimConfiguration::SetConstant("gs_config.calibration.kAutoCalibrationConvergenceTolerancePercent", kAutoCalibrationConvergenceTolerancePercent);
+
             return true;
         }
 
-        double GolfSimCamera::DetermineFocalLengthForAutoCalibration(const cv::Mat& color_image, const GolfSimCamera& camera) {
+        double GolfSimCamera::DetermineFocalLengthForAutoCalibration(const cv::Mat& color_image, const GolfSimCamera& camera, const cv::Rect& search_ROI, GolfBall* detected_ball) {
             GS_LOG_TRACE_MSG(trace, "DetermineFocalLengthUsingAutoCalibration called");
 
             // Find the ball in the image
@@ -4227,11 +4960,21 @@ namespace golf_sim {
             BallImageProc* ip = get_image_processor();
 
             // The search mode depends on the camera we are calibrating.  The camera2 pictures will be more like that
-            // of typical strobed (ball in flight) pictures.  
+            // of typical strobed (ball in flight) pictures.
             // TBD - Still not sure this is the best mode?  Seems like kStrobed is best for camera 2 calibration
             BallImageProc::BallSearchMode search_mode = (camera.camera_hardware_.camera_number_ == 1) ? BallImageProc::BallSearchMode::kFindPlacedBall : BallImageProc::BallSearchMode::kStrobed;
 
-            bool result = ip->GetBall(color_image, ball, return_balls, nullROI, search_mode);
+            // GetBall takes a non-const ROI reference, so work on a local copy
+            cv::Rect roi = search_ROI;
+
+            bool result = ip->GetBall(color_image, ball, return_balls, roi, search_mode);
+
+            if ((!result || return_balls.empty()) && !search_ROI.empty()) {
+                // The ball may have been moved (or the prior calibration may simply be stale).
+                // Fall back to the full frame before giving up.
+                GS_LOG_TRACE_MSG(trace, "No ball found within the restricted search ROI.  Retrying with the full frame.");
+                result = ip->GetBall(color_image, ball, return_balls, nullROI, search_mode);
+            }
 
             if (!result || return_balls.empty()) {
                 GS_LOG_MSG(error, "GetBall() failed to get a ball.  Consider setting  --show_images=1  in order to determine why no ball was found.");
@@ -4240,6 +4983,10 @@ namespace golf_sim {
 
             ball = return_balls[0];
 
+            if (detected_ball != nullptr) {
+                *detected_ball = ball;
+            }
+
             // Because we are auto-calibrating, we know the exact distance from the ball to the lens
             double distance_direct_to_ball = CvUtils::GetDistance(kAutoCalibrationBallPositionFromCameraMeters);
 
@@ -4262,7 +5009,7 @@ namespace golf_sim {
             return calibrated_focal_length;
         }
 
-        bool GolfSimCamera::DetermineCameraAngles(const cv::Mat& color_image, const GolfSimCamera& camera, cv::Vec2d& camera_angles) {
+        bool GolfSimCamera::DetermineCameraAngles(const cv::Mat& color_image, const GolfSimCamera& camera, cv::Vec2d& camera_angles, const cv::Rect& search_ROI) {
 
             GS_LOG_TRACE_MSG(trace, "DetermineCameraAngles called");
 
@@ -4279,11 +5026,19 @@ namespace golf_sim {
             BallImageProc* ip = get_image_processor();
 
             // The search mode depends on the camera we are calibrating.  The camera2 pictures will be more like that
-            // of typical strobed (ball in flight) pictures.  
+            // of typical strobed (ball in flight) pictures.
             // TBD - Still not sure this is the best mode?
             BallImageProc::BallSearchMode search_mode = (camera.camera_hardware_.camera_number_ == 1) ? BallImageProc::BallSearchMode::kFindPlacedBall : BallImageProc::BallSearchMode::kStrobed;
 
-            bool result = ip->GetBall(color_image, ball, return_balls, nullROI, search_mode);
+            // GetBall takes a non-const ROI reference, so work on a local copy
+            cv::Rect roi = search_ROI;
+
+            bool result = ip->GetBall(color_image, ball, return_balls, roi, search_mode);
+
+            if ((!result || return_balls.empty()) && !search_ROI.empty()) {
+                GS_LOG_TRACE_MSG(trace, "No ball found within the restricted search ROI.  Retrying with the full frame.");
+                result = ip->GetBall(color_image, ball, return_balls, nullROI, search_mode);
+            }
 
             if (!result || return_balls.empty()) {
                 GS_LOG_MSG(error, "GetBall() failed to get a ball.");
@@ -4464,7 +5219,30 @@ namespace golf_sim {
 
             GS_LOG_TRACE_MSG(trace, "Min/Max expected ball radii are: " + std::to_string(ip->min_ball_radius_) + " / " + std::to_string(ip->max_ball_radius_));
 
-            GS_LOG_TRACE_MSG(trace, "Determining focal length for auto-calibration. Will average " + std::to_string(number_attempts) + " samples.");
+            GS_LOG_TRACE_MSG(trace, "Determining focal length for auto-calibration. Will average up to " + std::to_string(number_attempts) + " samples.");
+
+            // The ball does not move during calibration, so once we have found it the first time we
+            // can restrict the later (much more expensive, full-frame) searches to its neighborhood.
+            cv::Rect search_roi;
+
+            // If a prior calibration recorded where the ball was, warm-start the search from there.
+            // The full-frame retry inside DetermineFocalLengthForAutoCalibration covers the case
+            // where the ball (or the camera) has since been moved.
+            std::string last_ball_center_tag_name = "gs_config.calibration.kCamera" + std::to_string(camera_number) + "LastAutoCalibrationBallCenterPixels";
+
+            cv::Vec2d last_ball_center;
+            if (GolfSimConfiguration::PropertyExists(last_ball_center_tag_name)) {
+                GolfSimConfiguration::SetConstant(last_ball_center_tag_name, last_ball_center);
+
+                int roi_margin = (int)std::round(expectedRadius * 6.0);
+                search_roi = cv::Rect((int)last_ball_center[0] - roi_margin, (int)last_ball_center[1] - roi_margin, 2 * roi_margin, 2 * roi_margin) &
+                    cv::Rect(0, 0, camera.camera_hardware_.resolution_x_, camera.camera_hardware_.resolution_y_);
+
+                GS_LOG_TRACE_MSG(trace, "Warm-starting ball search from prior calibration ROI: " + std::to_string(search_roi.x) + ", " +
+                    std::to_string(search_roi.y) + ", " + std::to_string(search_roi.width) + ", " + std::to_string(search_roi.height));
+            }
+
+            double prior_running_average = 0.0;
 
             // Focal length can be touchy because of small changes in the perceived radius of the ball due to small changes in, for example, lighting
             // Find an average focal length
@@ -4482,13 +5260,22 @@ namespace golf_sim {
                 // We cannot determine this without determining the focal length, so do that first and
                 // then use is to determine the angles.
 
-                double focal_length = DetermineFocalLengthForAutoCalibration(color_image, camera);
+                GolfBall detected_ball;
+                double focal_length = DetermineFocalLengthForAutoCalibration(color_image, camera, search_roi, &detected_ball);
 
                 if (focal_length < 0.0) {
                     GS_LOG_MSG(error, "Could not DetermineFocalLengthForAutoCalibration.");
                     return false;
                 }
 
+                // Narrow the search area for the remaining samples to the neighborhood of the
+                // ball we just found.  The intersection clamps the ROI to the image bounds.
+                int roi_margin = (int)std::round(expectedRadius * 6.0);
+                search_roi = cv::Rect((int)detected_ball.x() - roi_margin, (int)detected_ball.y() - roi_margin, 2 * roi_margin, 2 * roi_margin) &
+                    cv::Rect(0, 0, color_image.cols, color_image.rows);
+
+                last_ball_center = cv::Vec2d(detected_ball.x(), detected_ball.y());
+
                 // The intermediate image is useful to see if the circles are being identified accurately
                 LoggingTools::LogImage("", ip->final_result_image_, std::vector < cv::Point >{}, true, "Focal_Length_Autocalibration_Results_Image_" + std::to_string(i) + ".png");
 
@@ -4497,6 +5284,20 @@ namespace golf_sim {
                 average_focal_length += focal_length;
                 std::string calibration_results_message = "Next Sampled Focal Length = " + std::to_string(focal_length) + ".";
                 GS_LOG_MSG(info, calibration_results_message);
+
+                // Stop sampling early once the running average has settled.  There is no point in
+                // taking (and waiting for) additional pictures that will not change the result.
+                double running_average = average_focal_length / number_samples;
+
+                const int kMinSamplesForConvergence = 3;
+                if (kAutoCalibrationConvergenceTolerancePercent > 0.0 && number_samples >= kMinSamplesForConvergence &&
+                    std::abs(running_average - prior_running_average) < (kAutoCalibrationConvergenceTolerancePercent / 100.0) * std::abs(running_average)) {
+                    GS_LOG_MSG(info, "Focal length converged after " + std::to_string(number_samples) + " samples (average changed by less than " +
+                        std::to_string(kAutoCalibrationConvergenceTolerancePercent) + "%). Stopping sampling early.");
+                    break;
+                }
+
+                prior_running_average = running_average;
             }
 
             if (number_samples == 0) {
@@ -4531,7 +5332,7 @@ namespace golf_sim {
             cv::Vec2d camera_angles;
             
             // Use the last-taken image to determine at what angle the ball is to the bore-line of the camera's center
-            if (!DetermineCameraAngles(color_image, camera, camera_angles)) {
+            if (!DetermineCameraAngles(color_image, camera, camera_angles, search_roi)) {
                 GS_LOG_MSG(error, "Could not DetermineCameraAngles.");
                 return false;
             }
@@ -4545,6 +5346,9 @@ namespace golf_sim {
 
             GolfSimConfiguration::SetTreeValue(focal_length_tag_name, average_focal_length);
             GolfSimConfiguration::SetTreeValue(camera_angles_tag_name, camera_angles);
+
+            // Remember where the ball was so that the next calibration run can warm-start its search
+            GolfSimConfiguration::SetTreeValue(last_ball_center_tag_name, last_ball_center);
             
             WebApi::UpdateCalibration(focal_length_tag_name, average_focal_length);
             
@@ -124,6 +124,64 @@ namespace golf_sim {
 
         static int kClosestBallPairEdgeBackoffPixels;
 
+        // If true, the quadratic spin-ball pair scoring hoists the per-ball
+        // metrics into structure-of-arrays row vectors and computes the
+        // pairwise scores as whole-matrix OpenCV operations instead of the
+        // scalar pair-by-pair loop.
+        static bool kUseVectorizedPairScoring;
+
+        // If true, AnalyzeStrobedBalls localizes the strobed candidates in one
+        // batched pass with the camera-geometry terms hoisted out of the loop,
+        // instead of calling ComputeSingleBallXYZOrthoCamPerspective
+        // candidate-by-candidate.
+        static bool kUseBatchedBallLocalization;
+
+        // If true, the camera-1 teed-ball calibration in ProcessReceivedCam2Image
+        // runs on a worker thread while the camera-2 strobed image is being
+        // prepared, instead of the two running back-to-back on the FSM thread.
+        static bool kUsePipelinedShotAnalysis;
+
+        // If true, the (lengthy) spin rotation measurement starts on a worker
+        // thread as soon as the strobed exposures have been selected, running
+        // in parallel with the launch-angle and velocity computations.
+        static bool kUseSpeculativeSpinAnalysis;
+
+        // If true, the FSM hands the complete shot analysis (detection, spin,
+        // result delivery) to a pool worker as soon as the strobed camera-2
+        // image has been snapshotted, and re-enters ball watching immediately
+        // instead of going blind until the previous shot finishes.  At most
+        // kMaxInFlightShots analyses run behind the watching FSM; a hit
+        // arriving at the bound is processed synchronously as before.
+        static bool kUseOverlappedShotProcessing;
+        static int kMaxInFlightShots;
+
+        // If true, putting mode (selected by the club-change control message)
+        // takes a reduced pipeline through AnalyzeStrobedBalls - circle
+        // refinement only for the two exposures the putt result actually
+        // uses, and no non-overlapping-exposure selection, which exists only
+        // to feed the spin analysis that putts never run.
+        static bool kUsePuttingFastPath;
+
+        // If true, getNextFrame is fed by a capture thread that always keeps
+        // the next frame ready in a second buffer, so the sensor's exposure
+        // and readout overlap the caller's analysis of the previous frame.
+        // The waiting/stabilization loops then run at the rate of the slower
+        // of capture and analysis instead of their sum.  getNextFrame reduces
+        // to a buffer swap; the age of each handed-over frame is left in
+        // last_frame_staleness_us_.
+        static bool kUsePrefetchedFrames;
+
+        // Capture-to-hand-off age (microseconds) of the last frame returned
+        // by getNextFrame.  0 for synchronously captured frames.
+        static long last_frame_staleness_us_;
+
+        // Wall-clock durations (in milliseconds) of the two dominant stages of
+        // the most recent ProcessReceivedCam2Image call made on this thread.
+        // Thread-local so that the (parallel) automated-test runner can collect
+        // per-case stage timings for its performance-regression checking.
+        static thread_local double last_strobed_analysis_time_ms_;
+        static thread_local double last_spin_analysis_time_ms_;
+
         static double kMaxIntermediateBallRadiusChangePercent;
         static double kMaxPuttingIntermediateBallRadiusChangePercent;
         static double kMaxOverlappedBallRadiusChangeRatio;
@@ -140,6 +198,27 @@ namespace golf_sim {
         static double kExpectedBallPositionXcm;
         static double kExpectedBallPositionYcm;
         static double kExpectedBallPositionZcm;
+
+        // If true, the strobed-ball search is cropped to a horizontal trajectory
+        // corridor predicted from the teed-up (camera 1) ball instead of scanning
+        // the full camera-2 frame.  The corridor spans the full image width (the
+        // ball crosses the frame) but only the band of rows where exposures can
+        // plausibly appear, expressed in multiples of the expected strobed-ball
+        // radius above/below the expected ball center row.
+        static bool kUsePredictiveBallSearchROI;
+        static double kPredictiveROIRadiiAboveCenter;
+        static double kPredictiveROIRadiiBelowCenter;
+
+        // If true (and the predictive ROI is on), the strobed search expands
+        // outward in stages instead of committing to a single corridor: the
+        // first pass scans the corridor above, and only if it yields fewer
+        // than kBallSearchMinInitialCandidates candidates does the search
+        // widen the row band by kBallSearchExpansionFactor and rescan,
+        // finishing with a full-frame pass for mishits.  Typical shots stop
+        // after the first (small) pass.
+        static bool kUseExpandingBallSearch;
+        static int kBallSearchMinInitialCandidates;
+        static double kBallSearchExpansionFactor;
         static double kExpectedBallRadiusPixelsAt40cm;
         static double kMinRadiusRatio;
         static double kMaxRadiusRatio;
@@ -163,7 +242,17 @@ namespace golf_sim {
 
         static int kMaxBallsToRetain;
 
-        // The following group of constants configure the system that attempts to 
+        // If true, the candidate set is cut down to the top kMaxBallsToRetain
+        // (by detection quality) as soon as it comes back from GetBall,
+        // before the per-candidate localization and color-statistics stages
+        // run, instead of only after them.  Only kMaxBallsToRetain candidates
+        // can survive the later RemoveLowScoringBalls calls anyway, so the
+        // losers exit before the expensive work rather than after it.  The
+        // (small) risk is that a low-ranked detection that the color/radius
+        // filters would have promoted is dropped earlier.
+        static bool kUseEarlyCandidateTruncation;
+
+        // The following group of constants configure the system that attempts to
         // overcome problems associated with using the LM with another (also strobed)
         // LM
         static bool kExternallyStrobedEnvFilterImage;
@@ -190,6 +279,12 @@ namespace golf_sim {
         static cv::Vec3d kAutoCalibrationBallPositionFromCameraMeters;
         static int kNumberPicturesForFocalLengthAverage;
 
+        // If > 0, the focal-length sampling loop stops as soon as the running
+        // average changes by less than this percentage from one sample to the
+        // next, instead of always taking kNumberPicturesForFocalLengthAverage
+        // captures.  0 restores the fixed capture count.
+        static double kAutoCalibrationConvergenceTolerancePercent;
+
         // Here, the "1" refers not necessarily to the camera that is named camera 1 functionally 
         // (the camera that watches the teed-up ball).
         static CameraHardware::CameraModel kSystemSlot1CameraType;
@@ -240,6 +335,15 @@ namespace golf_sim {
 
         static bool ComputeSingleBallXYZOrthoCamPerspective(const GolfSimCamera& camera, GolfBall& initial_ball);
 
+        // Batched equivalent of ComputeSingleBallXYZOrthoCamPerspective.  The
+        // candidate positions and radii are staged into structure-of-arrays
+        // vectors and localized in tight loops, with the per-camera terms
+        // (pixel-to-meter factors, radius-to-distance factor, camera angles)
+        // computed once for the whole batch rather than re-derived per ball.
+        // Candidates carrying the (deprecated) ellipse representation are
+        // routed through the scalar path so their results stay identical.
+        static bool ComputeBallsXYZOrthoCamPerspective(const GolfSimCamera& camera, std::vector<GolfBall*>& balls);
+
         // Use the specified time delay and the already-calculated deltas in the ball to determine velocity
         static void CalculateBallVelocity(GolfBall& b, long time_delay_us);
 
@@ -289,6 +393,14 @@ namespace golf_sim {
         bool prepareToTakeVideo();
         cv::Mat getNextFrame();
 
+        // Stops the frame-prefetch capture thread behind getNextFrame
+        // (no-op if kUsePrefetchedFrames is off or the thread never started)
+        void StopFramePrefetch();
+
+        // The body of the prefetch capture thread - stays exactly one frame
+        // ahead of the getNextFrame consumer
+        void RunFramePrefetchThread();
+
         bool prepareToTakePhoto();
 
         cv::Vec2i GetExpectedBallCenter();
@@ -489,12 +601,22 @@ namespace golf_sim {
                                              cv::Mat& exposures_image,
                                              std::vector<GolfBall>& exposure_balls);
 
-        static bool ProcessSpin(GolfSimCamera& camera, 
+        static bool ProcessSpin(GolfSimCamera& camera,
                                 const cv::Mat& strobed_balls_gray_image,
                                 const GsBallsAndTimingVector& non_overlapping_balls_and_timing,
                                 GolfBall& result_ball,
                                 cv::Vec3d& rotationResults);
 
+        // The spin-ball selection and rotation measurement half of
+        // ProcessSpin.  Split out so that it can run on a worker thread in
+        // parallel with the angle/velocity work, with the resulting rotation
+        // applied to the result ball afterwards on the calling thread.
+        static bool ComputeSpinRotation(GolfSimCamera& camera,
+                                const cv::Mat& strobed_balls_gray_image,
+                                const GsBallsAndTimingVector& non_overlapping_balls_and_timing,
+                                cv::Vec3d& rotationResults,
+                                double& spin_timing_interval_uS);
+
         static void DrawFilterLines(const std::vector<cv::Vec4i>& lines,
                                     cv::Mat& image, 
                                     const cv::Scalar& color, 
@@ -507,14 +629,23 @@ namespace golf_sim {
 
         static bool RetrieveAutoCalibrationConstants(GsCameraNumber camera_number);
 
-        static bool DetermineCameraAngles(const cv::Mat& color_image, const GolfSimCamera& camera, cv::Vec2d& camera_angles);
+        // If search_ROI is non-empty, the ball detection is restricted to it
+        // (with a full-frame retry if nothing is found there)
+        static bool DetermineCameraAngles(const cv::Mat& color_image, const GolfSimCamera& camera, cv::Vec2d& camera_angles,
+                                          const cv::Rect& search_ROI = cv::Rect());
 
         // Take a single still picture with the specified camera.  May require the Pi 2 (Camera 2) 
         // process to be running if that is the specified camera.
         static bool TakeStillPicture(const GolfSimCamera& camera, cv::Mat& color_image);
 
-        // Returns -1.0 on error, otherwise a positive focal length (e.g., 6.3)
-        static double DetermineFocalLengthForAutoCalibration(const cv::Mat& color_image, const GolfSimCamera& camera);
+        // Returns -1.0 on error, otherwise a positive focal length (e.g., 6.3).
+        // If search_ROI is non-empty, the ball detection is restricted to it
+        // (with a full-frame retry if nothing is found there).  If
+        // detected_ball is non-null, the ball that was found is returned in it
+        // so that the caller can, e.g., narrow the next capture's search.
+        static double DetermineFocalLengthForAutoCalibration(const cv::Mat& color_image, const GolfSimCamera& camera,
+                                                             const cv::Rect& search_ROI = cv::Rect(),
+                                                             GolfBall* detected_ball = nullptr);
 
         // Determine how much we widen the color mask from the average color of the ball
         // TBD - determine whether H, S, and V need different multipliers ?
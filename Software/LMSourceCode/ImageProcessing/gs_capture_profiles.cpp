@@ -0,0 +1,287 @@
+/*****************************************************************//**
+ * \file   gs_capture_profiles.cpp
+ * \brief  Per-bay calibrated exposure/gain profiles for each capture mode.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <opencv2/imgproc.hpp>
+
+#include "gs_capture_profiles.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+
+namespace golf_sim {
+
+    bool GsCaptureProfiles::kEnableCaptureProfiles = false;
+    std::string GsCaptureProfiles::kCaptureProfilesFile = "/var/cache/pitrac/pitrac_capture_profiles.json";
+    double GsCaptureProfiles::kIdleFrameTargetBrightness = 110.0;
+    double GsCaptureProfiles::kIdleFrameBrightnessTolerancePct = 15.0;
+    int GsCaptureProfiles::kRecalibrationIntervalSecs = 60;
+    double GsCaptureProfiles::kRecalibrationStepLimitPct = 10.0;
+
+    namespace {
+
+        // Gains outside this range are a recalibration running away (e.g.,
+        // someone turned the bay lights off), not a profile worth keeping.
+        const double kMinProfileGain = 0.5;
+        const double kMaxProfileGain = 16.0;
+
+        // One calibrated gain.  Until a mode's configured default has been
+        // seen (or a persisted value loaded), the profile has no opinion.
+        struct ProfileValue {
+            double gain = 0.;
+            bool is_set = false;
+        };
+
+        struct CaptureProfile {
+            ProfileValue still_gain;
+            ProfileValue watch_gain;
+            ProfileValue strobed_gain;
+        };
+
+        CaptureProfile profile_;
+
+        // This bay's key within the profile file.
+        std::string profile_key_ = "default";
+
+        // The accessors run on the FSM/camera threads; the recalibration on
+        // whichever thread polls the ball search.
+        std::mutex profile_mutex_;
+
+        std::chrono::steady_clock::time_point last_recalibration_time_;
+        bool recalibration_save_failed_logged_ = false;
+
+        void LoadProfile() {
+
+            boost::property_tree::ptree file_tree;
+
+            try {
+                boost::property_tree::read_json(GsCaptureProfiles::kCaptureProfilesFile, file_tree);
+            }
+            catch (std::exception&) {
+                // No file yet - the profile seeds from the configured
+                // defaults as the modes are first used
+                return;
+            }
+
+            auto bay_tree = file_tree.get_child_optional(profile_key_);
+            if (!bay_tree) {
+                return;
+            }
+
+            auto load_value = [&bay_tree](const char* name, ProfileValue& value) {
+                auto stored = bay_tree->get_optional<double>(name);
+                if (stored && *stored >= kMinProfileGain && *stored <= kMaxProfileGain) {
+                    value.gain = *stored;
+                    value.is_set = true;
+                }
+            };
+
+            load_value("still_gain", profile_.still_gain);
+            load_value("watch_gain", profile_.watch_gain);
+            load_value("strobed_gain", profile_.strobed_gain);
+
+            GS_LOG_MSG(info, "GsCaptureProfiles loaded profile '" + profile_key_ + "' from " +
+                GsCaptureProfiles::kCaptureProfilesFile + ".");
+        }
+
+        // Writes the whole file back, preserving any other bays' profiles.
+        // Called rarely (at most once per recalibration interval).
+        void SaveProfile() {
+
+            boost::property_tree::ptree file_tree;
+
+            try {
+                boost::property_tree::read_json(GsCaptureProfiles::kCaptureProfilesFile, file_tree);
+            }
+            catch (std::exception&) {
+                // First save - start from an empty tree
+            }
+
+            boost::property_tree::ptree bay_tree;
+
+            if (profile_.still_gain.is_set) {
+                bay_tree.put("still_gain", profile_.still_gain.gain);
+            }
+            if (profile_.watch_gain.is_set) {
+                bay_tree.put("watch_gain", profile_.watch_gain.gain);
+            }
+            if (profile_.strobed_gain.is_set) {
+                bay_tree.put("strobed_gain", profile_.strobed_gain.gain);
+            }
+
+            file_tree.put_child(profile_key_, bay_tree);
+
+            try {
+                std::filesystem::path profile_path(GsCaptureProfiles::kCaptureProfilesFile);
+
+                if (profile_path.has_parent_path()) {
+                    std::error_code ec;
+                    std::filesystem::create_directories(profile_path.parent_path(), ec);
+                }
+
+                boost::property_tree::write_json(GsCaptureProfiles::kCaptureProfilesFile, file_tree);
+            }
+            catch (std::exception& e) {
+                if (!recalibration_save_failed_logged_) {
+                    LoggingTools::Warning("GsCaptureProfiles could not save " +
+                        GsCaptureProfiles::kCaptureProfilesFile + " (" + std::string(e.what()) +
+                        ").  Recalibrated values will not survive a restart.");
+                    recalibration_save_failed_logged_ = true;
+                }
+            }
+        }
+
+        // Returns the profile's gain for the mode, seeding it from the
+        // configured default on first use so recalibration has a starting
+        // point even before any persisted value exists.
+        double ProfileGain(ProfileValue& value, double configured_gain) {
+
+            if (!GsCaptureProfiles::kEnableCaptureProfiles) {
+                return configured_gain;
+            }
+
+            std::lock_guard<std::mutex> lock(profile_mutex_);
+
+            if (!value.is_set) {
+                value.gain = configured_gain;
+                value.is_set = true;
+            }
+
+            return value.gain;
+        }
+    }
+
+
+    void GsCaptureProfiles::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.cameras.kEnableCaptureProfiles", kEnableCaptureProfiles);
+        GolfSimConfiguration::SetConstant("gs_config.cameras.kCaptureProfilesFile", kCaptureProfilesFile);
+        GolfSimConfiguration::SetConstant("gs_config.cameras.kIdleFrameTargetBrightness", kIdleFrameTargetBrightness);
+        GolfSimConfiguration::SetConstant("gs_config.cameras.kIdleFrameBrightnessTolerancePct", kIdleFrameBrightnessTolerancePct);
+        GolfSimConfiguration::SetConstant("gs_config.cameras.kRecalibrationIntervalSecs", kRecalibrationIntervalSecs);
+        GolfSimConfiguration::SetConstant("gs_config.cameras.kRecalibrationStepLimitPct", kRecalibrationStepLimitPct);
+
+        if (!kEnableCaptureProfiles) {
+            return;
+        }
+
+        // Multi-bay installations share one profile file, keyed by bay
+        std::string bay_id;
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kActiveMQBayId", bay_id);
+
+        if (!bay_id.empty()) {
+            profile_key_ = bay_id;
+        }
+
+        std::lock_guard<std::mutex> lock(profile_mutex_);
+        LoadProfile();
+
+        last_recalibration_time_ = std::chrono::steady_clock::now();
+    }
+
+
+    double GsCaptureProfiles::StillGain(double configured_gain) {
+        return ProfileGain(profile_.still_gain, configured_gain);
+    }
+
+    double GsCaptureProfiles::WatchModeGain(double configured_gain) {
+        return ProfileGain(profile_.watch_gain, configured_gain);
+    }
+
+    double GsCaptureProfiles::StrobedGain(double configured_gain) {
+        return ProfileGain(profile_.strobed_gain, configured_gain);
+    }
+
+
+    void GsCaptureProfiles::ObserveIdleStillFrame(const cv::Mat& frame) {
+
+        if (!kEnableCaptureProfiles || frame.empty()) {
+            return;
+        }
+
+        // The ball search polls continuously while idle - the interval
+        // check keeps the measurement (and any file write) rare
+        auto now = std::chrono::steady_clock::now();
+
+        {
+            std::lock_guard<std::mutex> lock(profile_mutex_);
+
+            if (std::chrono::duration_cast<std::chrono::seconds>(now - last_recalibration_time_).count() <
+                kRecalibrationIntervalSecs) {
+                return;
+            }
+
+            last_recalibration_time_ = now;
+        }
+
+        cv::Scalar channel_means = cv::mean(frame);
+        double mean_brightness = (frame.channels() >= 3) ?
+            (channel_means[0] + channel_means[1] + channel_means[2]) / 3.0 : channel_means[0];
+
+        if (mean_brightness <= 0.) {
+            return;
+        }
+
+        double relative_error = kIdleFrameTargetBrightness / mean_brightness;
+
+        if (std::abs(mean_brightness - kIdleFrameTargetBrightness) <=
+            kIdleFrameTargetBrightness * (kIdleFrameBrightnessTolerancePct / 100.0)) {
+            // Within the band - the profile is right for the current light
+            return;
+        }
+
+        // One damped step toward the target.  Large lighting changes are
+        // corrected over several intervals rather than chased in one jump.
+        double step_limit = kRecalibrationStepLimitPct / 100.0;
+        double factor = std::clamp(relative_error, 1.0 - step_limit, 1.0 + step_limit);
+
+        std::lock_guard<std::mutex> lock(profile_mutex_);
+
+        // The still and watch exposures both see the ambient light the idle
+        // frames measure.  The strobed exposure is lit by the strobe pulse,
+        // which this frame says nothing about - it is never touched here.
+        bool adjusted = false;
+
+        if (profile_.still_gain.is_set) {
+            profile_.still_gain.gain = std::clamp(profile_.still_gain.gain * factor,
+                                                  kMinProfileGain, kMaxProfileGain);
+            adjusted = true;
+        }
+
+        if (profile_.watch_gain.is_set) {
+            profile_.watch_gain.gain = std::clamp(profile_.watch_gain.gain * factor,
+                                                  kMinProfileGain, kMaxProfileGain);
+            adjusted = true;
+        }
+
+        if (!adjusted) {
+            // Neither mode has run yet this session, so there is nothing to
+            // correct - the first use will seed from the configured values
+            return;
+        }
+
+        GS_LOG_MSG(info, "GsCaptureProfiles recalibrated for idle brightness " +
+            std::to_string(mean_brightness) + " (target " + std::to_string(kIdleFrameTargetBrightness) +
+            "): gain step x" + std::to_string(factor) + ".");
+
+        SaveProfile();
+    }
+
+}
@@ -0,0 +1,86 @@
+/*****************************************************************//**
+ * \file   gs_capture_profiles.h
+ * \brief  Per-bay calibrated exposure/gain profiles for each capture mode.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+    // The cameras already run fully manual exposure - the gain and shutter
+    // for the still, watch and strobed configurations come from the .json
+    // configuration file, and no AE loop ever runs around a shot.  But
+    // those values are hand-tuned once, globally: every bay ships the same
+    // numbers, and when a bay's lighting drifts (bulbs age, a projector
+    // screen changes, daylight moves) the only fix is a human re-editing
+    // the configuration.
+    //
+    // This service layers a per-bay capture profile over the configured
+    // defaults: a small persisted file of calibrated gain values, applied
+    // as the fixed camera controls the moment each mode is configured - the
+    // very first frame of a mode is already correctly exposed, with nothing
+    // to settle.  While the system idles waiting for a ball, the profile is
+    // slowly recalibrated from the frames the ball search is already
+    // taking: if their mean brightness drifts from the target, the still
+    // and watch gains are nudged (damped and rate-limited) and the profile
+    // is written back, so the next mode change starts from the corrected
+    // values.  The strobed gain is deliberately left alone - that exposure
+    // is dominated by the strobe pulse, not the ambient light the idle
+    // frames measure.
+    //
+    // Off by default (gs_config.cameras.kEnableCaptureProfiles).
+
+    class GsCaptureProfiles {
+
+    public:
+
+        static bool kEnableCaptureProfiles;
+
+        // Where the per-bay profile persists across restarts.  In a
+        // multi-bay installation each bay gets its own entry within the
+        // file, keyed by gs_config.ipc_interface.kActiveMQBayId.
+        static std::string kCaptureProfilesFile;
+
+        // The mean grey level (0-255) the idle recalibration steers the
+        // ball-search frames toward, and the band (as a percentage of the
+        // target) within which it leaves the profile alone.
+        static double kIdleFrameTargetBrightness;
+        static double kIdleFrameBrightnessTolerancePct;
+
+        // Seconds between recalibration steps, and the largest relative
+        // gain change one step may make.  Both keep the recalibration slow
+        // - it corrects drift across a session, it does not chase shadows.
+        static int kRecalibrationIntervalSecs;
+        static double kRecalibrationStepLimitPct;
+
+        // Reads the configuration values above and loads this bay's
+        // profile (if one has been persisted).  Call once at startup,
+        // after the JSON configuration has been parsed.
+        static void Initialize();
+
+        // The gain to use for the given mode: the calibrated profile value
+        // when one exists, otherwise the configured default that was passed
+        // in (which also seeds the profile the first time it is used).
+        static double StillGain(double configured_gain);
+        static double WatchModeGain(double configured_gain);
+        static double StrobedGain(double configured_gain);
+
+        // Feeds one frame from the idle ball-search loop to the background
+        // recalibration.  Cheap when disabled or rate-limited; otherwise
+        // measures the frame and (rarely) nudges and persists the profile.
+        static void ObserveIdleStillFrame(const cv::Mat& frame);
+    };
+
+}
@@ -0,0 +1,325 @@
+/*****************************************************************//**
+ * \file   gs_clock_sync.cpp
+ * \brief  Cross-Pi clock offset/drift estimation over the IPC link.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "gs_clock_sync.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+#include "gs_options.h"
+
+#ifdef __unix__
+#include "gs_ipc_system.h"
+#endif
+
+namespace golf_sim {
+
+    bool GsClockSync::kEnableClockSync = false;
+    int GsClockSync::kClockSyncIntervalSecs = 10;
+
+    namespace {
+
+        // NTP-style smoothing gain for the offset, and the round-trip
+        // multiple beyond which a sample is considered queue-delayed and
+        // discarded rather than folded in.
+        const double kOffsetSmoothingAlpha = 0.125;
+        const double kRejectRttMultiple = 3.0;
+        const double kDriftSmoothingAlpha = 0.25;
+
+        // Exchanges are only usable for drift estimation when some real time
+        // has passed between them.
+        const int64_t kMinDriftBaselineNs = 2000000000LL;
+
+        std::mutex sync_model_mutex;
+
+        long samples_accepted = 0;
+        long samples_rejected = 0;
+
+        double smoothed_offset_ns = 0.0;
+        double smoothed_drift_ppm = 0.0;
+
+        int64_t best_rtt_ns = 0;
+        int64_t last_rtt_ns = 0;
+
+        // When (on this machine's clock) the last accepted sample arrived,
+        // and the offset it reported - the baseline for the drift estimate.
+        int64_t last_sample_time_ns = 0;
+        double last_sample_offset_ns = 0.0;
+
+        std::thread* requester_thread = nullptr;
+        std::mutex requester_mutex;
+        std::condition_variable requester_cv;
+        bool requester_exit = false;
+    }
+
+    int64_t GsClockSync::LocalTimeNs() {
+        return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void GsClockSync::Initialize() {
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kEnableClockSync", kEnableClockSync);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kClockSyncIntervalSecs", kClockSyncIntervalSecs);
+
+        if (kClockSyncIntervalSecs < 1) {
+            LoggingTools::Warning("kClockSyncIntervalSecs must be at least 1.  Using 1.");
+            kClockSyncIntervalSecs = 1;
+        }
+    }
+
+    bool GsClockSync::OffsetIsKnown() {
+        std::lock_guard<std::mutex> lock(sync_model_mutex);
+
+        if (samples_accepted < 3) {
+            return false;
+        }
+
+        // A model that has stopped being refreshed is stale - the drift term
+        // only extrapolates credibly for a handful of missed exchanges.
+        int64_t age_ns = LocalTimeNs() - last_sample_time_ns;
+        return age_ns < (int64_t)kClockSyncIntervalSecs * 10 * 1000000000LL;
+    }
+
+    double GsClockSync::OffsetMicroseconds() {
+        std::lock_guard<std::mutex> lock(sync_model_mutex);
+        return smoothed_offset_ns / 1000.0;
+    }
+
+    double GsClockSync::DriftPartsPerMillion() {
+        std::lock_guard<std::mutex> lock(sync_model_mutex);
+        return smoothed_drift_ppm;
+    }
+
+    int64_t GsClockSync::RemoteTimeNsToLocalNs(int64_t remote_time_ns) {
+
+        if (!OffsetIsKnown()) {
+            return remote_time_ns;
+        }
+
+        std::lock_guard<std::mutex> lock(sync_model_mutex);
+
+        // Extrapolate the offset forward from the last exchange using the
+        // drift estimate, then take it off the remote time.
+        int64_t extrapolation_ns = LocalTimeNs() - last_sample_time_ns;
+        double offset_now_ns = smoothed_offset_ns +
+            (smoothed_drift_ppm * 1.0e-6) * (double)extrapolation_ns;
+
+        return remote_time_ns - (int64_t)std::llround(offset_now_ns);
+    }
+
+    std::string GsClockSync::StatusSuffix() {
+
+        if (!kEnableClockSync) {
+            return "";
+        }
+
+        std::lock_guard<std::mutex> lock(sync_model_mutex);
+
+        if (samples_accepted == 0) {
+            return "  [Clock sync: no exchanges yet]";
+        }
+
+        return "  [Clock sync: offset " + std::to_string((long)std::llround(smoothed_offset_ns / 1000.0)) +
+            " uS, drift " + std::to_string(smoothed_drift_ppm) +
+            " ppm, rtt " + std::to_string(last_rtt_ns / 1000) +
+            " uS, " + std::to_string(samples_accepted) + " samples" +
+            (samples_rejected > 0 ? (", " + std::to_string(samples_rejected) + " rejected") : "") + "]";
+    }
+
+#ifdef __unix__
+
+    namespace {
+
+        void RunClockSyncRequesterThread() {
+
+            GS_LOG_TRACE_MSG(trace, "GsClockSync requester thread starting.");
+
+            std::unique_lock<std::mutex> lock(requester_mutex);
+
+            while (!requester_exit) {
+
+                lock.unlock();
+
+                GolfSimIPCMessage request(GolfSimIPCMessage::IPCMessageType::kClockSyncRequest);
+                request.SetClockSyncTimes(GsClockSync::LocalTimeNs(), 0, 0);
+
+                if (!GolfSimIpcSystem::SendIpcMessage(request)) {
+                    GS_LOG_TRACE_MSG(warning, "GsClockSync failed to send a kClockSyncRequest message.");
+                }
+
+                lock.lock();
+
+                requester_cv.wait_for(lock, std::chrono::seconds(GsClockSync::kClockSyncIntervalSecs),
+                                      []() { return requester_exit; });
+            }
+
+            GS_LOG_TRACE_MSG(trace, "GsClockSync requester thread exiting.");
+        }
+    }
+
+    void GsClockSync::Start() {
+
+        if (!kEnableClockSync) {
+            return;
+        }
+
+        // Only the camera-1 half of a two-Pi setup originates the exchange
+        if (GolfSimOptions::GetCommandLineOptions().system_mode_ != SystemMode::kCamera1) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(requester_mutex);
+
+        if (requester_thread != nullptr) {
+            return;
+        }
+
+        requester_exit = false;
+        requester_thread = new std::thread(RunClockSyncRequesterThread);
+    }
+
+    void GsClockSync::Shutdown() {
+
+        std::thread* thread_to_join = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(requester_mutex);
+
+            if (requester_thread == nullptr) {
+                return;
+            }
+
+            requester_exit = true;
+            thread_to_join = requester_thread;
+            requester_thread = nullptr;
+        }
+
+        requester_cv.notify_one();
+        thread_to_join->join();
+        delete thread_to_join;
+    }
+
+    bool GsClockSync::HandleSyncRequest(const GolfSimIPCMessage& message) {
+
+        // Stamp the receive time as early as possible - everything after
+        // this line is processing delay that the estimate should not include
+        int64_t t2 = LocalTimeNs();
+
+        if (!kEnableClockSync) {
+            return true;
+        }
+
+        GolfSimIPCMessage response(GolfSimIPCMessage::IPCMessageType::kClockSyncResponse);
+        response.SetClockSyncTimes(message.GetClockSyncT1(), t2, LocalTimeNs());
+
+        if (!GolfSimIpcSystem::SendIpcMessage(response)) {
+            GS_LOG_TRACE_MSG(warning, "GsClockSync failed to send a kClockSyncResponse message.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GsClockSync::HandleSyncResponse(const GolfSimIPCMessage& message) {
+
+        int64_t t4 = LocalTimeNs();
+
+        if (!kEnableClockSync) {
+            return true;
+        }
+
+        int64_t t1 = message.GetClockSyncT1();
+        int64_t t2 = message.GetClockSyncT2();
+        int64_t t3 = message.GetClockSyncT3();
+
+        int64_t rtt_ns = (t4 - t1) - (t3 - t2);
+
+        if (t1 <= 0 || t2 <= 0 || t3 <= 0 || rtt_ns <= 0) {
+            GS_LOG_TRACE_MSG(warning, "GsClockSync received a kClockSyncResponse with nonsensical timestamps.  Ignoring it.");
+            return false;
+        }
+
+        // Symmetric-path estimate of (camera-2 clock - camera-1 clock)
+        double offset_ns = (((double)(t2 - t1)) + ((double)(t3 - t4))) / 2.0;
+
+        std::lock_guard<std::mutex> lock(sync_model_mutex);
+
+        last_rtt_ns = rtt_ns;
+
+        // A sample whose round trip is far above the best we have seen spent
+        // the difference sitting in queues, and its midpoint says more about
+        // the queueing than about the clocks.
+        if (samples_accepted >= 4 && best_rtt_ns > 0 &&
+            (double)rtt_ns > kRejectRttMultiple * (double)best_rtt_ns) {
+            samples_rejected++;
+            GS_LOG_TRACE_MSG(trace, "GsClockSync rejected a sample with rtt " + std::to_string(rtt_ns / 1000) +
+                " uS (best is " + std::to_string(best_rtt_ns / 1000) + " uS).");
+            return true;
+        }
+
+        if (best_rtt_ns == 0 || rtt_ns < best_rtt_ns) {
+            best_rtt_ns = rtt_ns;
+        }
+
+        if (samples_accepted == 0) {
+            smoothed_offset_ns = offset_ns;
+        }
+        else {
+            // The drift estimate needs a real time baseline between samples
+            int64_t elapsed_ns = t4 - last_sample_time_ns;
+
+            if (elapsed_ns > kMinDriftBaselineNs) {
+                double instantaneous_ppm = (offset_ns - last_sample_offset_ns) / (double)elapsed_ns * 1.0e6;
+                smoothed_drift_ppm += kDriftSmoothingAlpha * (instantaneous_ppm - smoothed_drift_ppm);
+            }
+
+            smoothed_offset_ns += kOffsetSmoothingAlpha * (offset_ns - smoothed_offset_ns);
+        }
+
+        samples_accepted++;
+        last_sample_time_ns = t4;
+        last_sample_offset_ns = offset_ns;
+
+        GS_LOG_TRACE_MSG(trace, "GsClockSync accepted sample " + std::to_string(samples_accepted) +
+            ": offset " + std::to_string((long)std::llround(offset_ns / 1000.0)) +
+            " uS, rtt " + std::to_string(rtt_ns / 1000) + " uS.");
+
+        return true;
+    }
+
+#else
+
+    // The IPC system (and the second Pi) only exist on the Pi builds
+
+    void GsClockSync::Start() {
+    }
+
+    void GsClockSync::Shutdown() {
+    }
+
+    bool GsClockSync::HandleSyncRequest(const GolfSimIPCMessage&) {
+        return true;
+    }
+
+    bool GsClockSync::HandleSyncResponse(const GolfSimIPCMessage&) {
+        return true;
+    }
+
+#endif // #ifdef __unix__
+
+}
@@ -0,0 +1,99 @@
+/*****************************************************************//**
+ * \file   gs_clock_sync.h
+ * \brief  Cross-Pi clock offset/drift estimation over the IPC link.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace golf_sim {
+
+    class GolfSimIPCMessage;
+
+    // In the two-Pi configuration, any comparison of a time observed on the
+    // camera-1 Pi with a time observed on the camera-2 Pi (trigger sent
+    // versus exposure taken) rides on an uncharacterized offset between the
+    // two machines' clocks.  This service runs a PTP-style two-way timestamp
+    // exchange over the existing ActiveMQ link: camera 1 periodically sends
+    // a kClockSyncRequest stamped with its send time (t1), camera 2 replies
+    // with its receive (t2) and send (t3) times, and camera 1 notes the
+    // response arrival (t4).  The classic symmetric-path estimate
+    // offset = ((t2 - t1) + (t3 - t4)) / 2 is then filtered into a smoothed
+    // offset and drift model, with high-round-trip samples discarded the way
+    // NTP discards them.
+    //
+    // All timestamps are each machine's own steady clock in nanoseconds -
+    // the model maps camera-2 time onto camera-1 time, it does not need the
+    // wall clocks to agree.  The timing code can translate remote times with
+    // RemoteTimeNsToLocalNs() and should check OffsetIsKnown() first; the
+    // health summary rides the outgoing status messages so that a broken
+    // exchange is visible from the GUI.
+    //
+    // Off by default (gs_config.ipc_interface.kEnableClockSync).
+
+    class GsClockSync {
+
+    public:
+
+        static bool kEnableClockSync;
+
+        // Seconds between timestamp exchanges once the link is up.
+        static int kClockSyncIntervalSecs;
+
+        // Reads the configuration values above.  Call once at startup, after
+        // the JSON configuration has been parsed.  Does not start anything -
+        // the exchange needs the IPC system, which comes up later.
+        static void Initialize();
+
+        // Starts the camera-1 side's periodic requester thread.  Call after
+        // the IPC system is up; a no-op when disabled or on system modes
+        // that are not the camera-1 half of a two-Pi setup.
+        static void Start();
+
+        // Stops the requester thread (if running).  Call before the IPC
+        // system is torn down.
+        static void Shutdown();
+
+        // Camera-2 side: answers a kClockSyncRequest with a
+        // kClockSyncResponse carrying this machine's receive/send times.
+        static bool HandleSyncRequest(const GolfSimIPCMessage& message);
+
+        // Camera-1 side: folds a kClockSyncResponse into the offset/drift
+        // model.
+        static bool HandleSyncResponse(const GolfSimIPCMessage& message);
+
+        // True once enough exchanges have been accepted for the offset to be
+        // meaningful.
+        static bool OffsetIsKnown();
+
+        // The smoothed offset (camera-2 clock minus camera-1 clock) in
+        // microseconds, and the estimated relative drift between the two
+        // clocks.  Only meaningful when OffsetIsKnown().
+        static double OffsetMicroseconds();
+        static double DriftPartsPerMillion();
+
+        // Maps a camera-2 steady-clock time onto the camera-1 steady clock.
+        // Returns the input unchanged when the offset is not yet known.
+        static int64_t RemoteTimeNsToLocalNs(int64_t remote_time_ns);
+
+        // A short health summary (offset, drift, round-trip, sample count)
+        // for the status messages, or an empty string when there is nothing
+        // to report.
+        static std::string StatusSuffix();
+
+        // This machine's steady clock in nanoseconds - the time base every
+        // exchanged timestamp uses.
+        static int64_t LocalTimeNs();
+    };
+
+}
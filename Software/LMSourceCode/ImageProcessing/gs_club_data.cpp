@@ -4,9 +4,16 @@
  */
 
 
+#include <cmath>
+#include <future>
+#include <memory>
+#include <utility>
+
 #include <boost/circular_buffer.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <opencv2/imgproc.hpp>
+
 #include "logging_tools.h"
 #include "gs_options.h"
 #include "gs_config.h"
@@ -34,6 +41,16 @@ namespace golf_sim {
 	 uint GolfSimClubData::kNumberFramesToSaveBeforeHit = 4;
 	 uint GolfSimClubData::kNumberFramesToSaveAfterHit = 4;
 
+	 float GolfSimClubData::kPreTriggerWindowSecs = 0.0F;
+
+	namespace {
+		// The frame rate the watcher camera was configured for, recorded by
+		// SetExpectedFrameRateFps.  Zero until the camera has been set up.
+		uint expected_frame_rate_fps = 0;
+	}
+
+	 bool GolfSimClubData::kRetainZeroCopyFrames = false;
+
 	 float GolfSimClubData::kClubImageCameraGain = 30.0F;
 	 float GolfSimClubData::kClubImageShutterSpeedMultiplier = 0.4F;
 
@@ -47,16 +64,38 @@ namespace golf_sim {
 			GolfSimConfiguration::SetConstant("gs_config.club_data.kEnableClubImages", kClubImageOutputDir);
 			GolfSimConfiguration::SetConstant("gs_config.club_data.kNumberFramesToSaveBeforeHit", kNumberFramesToSaveBeforeHit);
 			GolfSimConfiguration::SetConstant("gs_config.club_data.kNumberFramesToSaveAfterHit", kNumberFramesToSaveAfterHit);
+			GolfSimConfiguration::SetConstant("gs_config.club_data.kPreTriggerWindowSecs", kPreTriggerWindowSecs);
 			GolfSimConfiguration::SetConstant("gs_config.club_data.kClubImageWidthPixels", kClubImageWidthPixels);
 			GolfSimConfiguration::SetConstant("gs_config.club_data.kClubImageHeightPixels", kClubImageHeightPixels);
 			GolfSimConfiguration::SetConstant("gs_config.club_data.kClubImageCameraGain", kClubImageCameraGain);
 			GolfSimConfiguration::SetConstant("gs_config.club_data.kClubImageShutterSpeedMultiplier", kClubImageShutterSpeedMultiplier);
+			GolfSimConfiguration::SetConstant("gs_config.club_data.kRetainZeroCopyFrames", kRetainZeroCopyFrames);
+			GolfSimConfiguration::SetConstant("gs_config.club_data.kUseAdaptiveFrameRetention", RecentFrameRing::kUseAdaptiveFrameRetention);
+			GolfSimConfiguration::SetConstant("gs_config.club_data.kFullResolutionWindowFrames", RecentFrameRing::kFullResolutionWindowFrames);
+			GolfSimConfiguration::SetConstant("gs_config.club_data.kThumbnailDownsampleFactor", RecentFrameRing::kThumbnailDownsampleFactor);
 		}
 
 		// Not too much can go wrong so far
 		return true;
 	}
 
+	void GolfSimClubData::SetExpectedFrameRateFps(uint frames_per_second) {
+		expected_frame_rate_fps = frames_per_second;
+	}
+
+	uint GolfSimClubData::GetPreTriggerFrameCount() {
+
+		if (kPreTriggerWindowSecs > 0.0F && expected_frame_rate_fps > 0) {
+			uint frame_count = (uint)std::ceil(kPreTriggerWindowSecs * (float)expected_frame_rate_fps);
+			GS_LOG_TRACE_MSG(trace, "GolfSimClubData::GetPreTriggerFrameCount - " +
+				std::to_string(kPreTriggerWindowSecs) + "s at " + std::to_string(expected_frame_rate_fps) +
+				" FPS = " + std::to_string(frame_count) + " pre-hit frames.");
+			return frame_count;
+		}
+
+		return kNumberFramesToSaveBeforeHit;
+	}
+
 	bool GolfSimClubData::ProcessClubStrikeData(boost::circular_buffer<RecentFrameInfo>& frame_info) {
 		GS_LOG_TRACE_MSG(trace, "GolfSimClubData::ProcessClubStrikeData.");
 
@@ -76,6 +115,65 @@ namespace golf_sim {
 	}
 
 
+	bool GolfSimClubData::ProcessClubStrikeDataAsync(boost::circular_buffer<RecentFrameInfo>& frame_info) {
+
+		if (!kGatherClubData) {
+			GS_LOG_TRACE_MSG(trace, "Not gathering club data.");
+			return true;
+		}
+
+		// One worker at a time.  If the previous shot's diagnostics are somehow
+		// still running (they have had the entire inter-shot interval to finish),
+		// wait for them rather than racing two ffmpeg runs over the same files.
+		static std::future<bool> club_data_future;
+
+		if (club_data_future.valid()) {
+			club_data_future.wait();
+		}
+
+		// Snapshot the frames by moving them - the cv::Mat headers transfer
+		// their pixel ownership, so no image data is copied.  The buffer itself
+		// keeps its capacity for the next shot.
+		auto snapshot = std::make_shared<boost::circular_buffer<RecentFrameInfo>>(std::max<size_t>(frame_info.size(), 1));
+
+		for (auto& frame : frame_info) {
+			snapshot->push_back(std::move(frame));
+		}
+		frame_info.clear();
+
+		club_data_future = std::async(std::launch::async, [snapshot]() {
+
+			if (!ProcessClubStrikeData(*snapshot)) {
+				GS_LOG_TRACE_MSG(warning, "GolfSimClubData::ProcessClubStrikeData failed (deferred).");
+				return false;
+			}
+
+			return true;
+		});
+
+		return true;
+	}
+
+
+	void GolfSimClubData::MaterializeZeroCopyFrames(boost::circular_buffer<RecentFrameInfo>& frame_info) {
+
+		if (!kRetainZeroCopyFrames) {
+			return;
+		}
+
+		GS_LOG_TRACE_MSG(trace, "GolfSimClubData::MaterializeZeroCopyFrames with " + std::to_string(frame_info.size()) + " frames.");
+
+		// This is a one-time cost of a few frames after the hit, instead of a
+		// per-frame copy in the high-FPS watcher loop.
+		for (auto& it : frame_info) {
+			if (it.bufferFence) {
+				it.mat = it.mat.clone();
+				it.bufferFence.reset();
+			}
+		}
+	}
+
+
 	bool GolfSimClubData::CreateClubStrikeVideo(boost::circular_buffer<RecentFrameInfo>& frame_info) {
 		GS_LOG_TRACE_MSG(trace, "GolfSimClubData::CreateClubStrikeVideo with " + std::to_string(frame_info.size()) + " frames.");
 
@@ -90,7 +188,14 @@ namespace golf_sim {
 
 		for (auto& it : frame_info) {
 
-			cv::Mat& next_frame_mat = it.mat;
+			cv::Mat next_frame_mat = it.mat;
+
+			// Thumbnails from the adaptive retention policy are scaled back
+			// up to the capture resolution so every frame in the sequence is
+			// the same size - ffmpeg will not encode a mixed-size glob.
+			if (it.isThumbnail && it.fullResolutionSize.area() > 0) {
+				cv::resize(it.mat, next_frame_mat, it.fullResolutionSize, 0, 0, cv::INTER_LINEAR);
+			}
 
 			std::string frame_number = std::to_string(frame_index);
 			frame_number = std::string(3 /* zeros */ - frame_number.length(), '0') + frame_number;
@@ -20,8 +20,24 @@ namespace golf_sim {
 		// perform analysis, etc.
 		static bool ProcessClubStrikeData(boost::circular_buffer<RecentFrameInfo>& frame_info);
 
+		// Moves the frames out of frame_info and hands them to a background
+		// worker that runs ProcessClubStrikeData after this call has returned.
+		// The shot result is latency-critical and the club diagnostics (image
+		// writes plus an ffmpeg run) are not, so they should never ride the FSM
+		// thread.  The frames must already own their pixels (see
+		// MaterializeZeroCopyFrames) since the worker outlives the camera app.
+		// frame_info is left empty but keeps its capacity.
+		static bool ProcessClubStrikeDataAsync(boost::circular_buffer<RecentFrameInfo>& frame_info);
+
 		static bool CreateClubStrikeVideo(boost::circular_buffer<RecentFrameInfo>& frame_info);
 
+		// Replaces any zero-copy frame views in the buffer with deep copies and
+		// releases their retained requests (see kRetainZeroCopyFrames).  Must be
+		// called while the camera app that produced the frames is still alive -
+		// once it shuts down, the underlying buffers are unmapped and the views
+		// would dangle.  A no-op for frames that already own their pixels.
+		static void MaterializeZeroCopyFrames(boost::circular_buffer<RecentFrameInfo>& frame_info);
+
 
 	public:
 
@@ -45,6 +61,32 @@ namespace golf_sim {
 		static uint kNumberFramesToSaveBeforeHit;
 		static uint kNumberFramesToSaveAfterHit;
 
+		// When greater than zero, the pre-trigger ring is sized to hold this
+		// many seconds of frames at the frame rate the watcher camera was
+		// configured for, instead of exactly kNumberFramesToSaveBeforeHit
+		// frames.  Sizing in seconds stays correct when the frame rate
+		// changes with the cropping window.
+		static float kPreTriggerWindowSecs;
+
+		// Records the frame rate the watcher camera was configured for, so
+		// that the pre-trigger window can be sized in seconds.  Called from
+		// the camera setup path before the motion-detect stage is configured.
+		static void SetExpectedFrameRateFps(uint frames_per_second);
+
+		// The number of pre-hit frames the ring should retain - either
+		// kNumberFramesToSaveBeforeHit, or kPreTriggerWindowSecs' worth of
+		// frames at the configured rate when that is set and the rate is
+		// known.
+		static uint GetPreTriggerFrameCount();
+
+		// If true, the frames saved into the RecentFrames buffer are zero-copy
+		// views of the camera's own mmap'd frame buffers instead of ~1.5MB clones.
+		// The completed request for each frame is retained (see
+		// RecentFrameInfo::bufferFence) until its entry is recycled, so the
+		// camera must be configured with enough extra buffers (--buffer-count)
+		// to cover the RecentFrames depth or the pipeline will stall.
+		static bool kRetainZeroCopyFrames;
+
 		// TBD - This is experimental - we are trying to shorten the usual
 		// camera 1 shutter time and increase gain to reduce blur when we are attempting
 		// to gather club strike images.
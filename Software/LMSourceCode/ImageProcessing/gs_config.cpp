@@ -6,6 +6,7 @@
 #ifdef __unix__  // Ignore in Windows environment
 #endif
 #include <boost/foreach.hpp>
+#include <chrono>
 #include <cstdlib>
 #include <memory>
 #include <fstream>
@@ -13,6 +14,7 @@
 #include <sstream>
 #include "logging_tools.h"
 #include "gs_camera.h"
+#include "gs_flight_recorder.h"
 #include "gs_ui_system.h"
 #include "gs_config.h"
 #include "configuration_manager.h"
@@ -25,9 +27,49 @@
 namespace golf_sim {
 
 	boost::property_tree::ptree GolfSimConfiguration::configuration_root_;
+	std::string GolfSimConfiguration::configuration_filename_;
+	std::unordered_map<std::string, std::string> GolfSimConfiguration::flat_values_;
+
+	namespace {
+		// Records every leaf of the tree into the index under its full dotted
+		// path.  Unnamed children (JSON array elements) have no dotted path, so
+		// arrays are left for the compound SetConstant overloads to walk.
+		void AddLeafValuesToIndex(const boost::property_tree::ptree& node,
+								  const std::string& path,
+								  std::unordered_map<std::string, std::string>& index) {
+			for (const boost::property_tree::ptree::value_type& child : node) {
+				if (child.first.empty()) {
+					continue;
+				}
+
+				std::string child_path = path.empty() ? child.first : path + "." + child.first;
+
+				if (child.second.empty()) {
+					index[child_path] = child.second.data();
+				}
+				else {
+					AddLeafValuesToIndex(child.second, child_path, index);
+				}
+			}
+		}
+	}
+
+	void GolfSimConfiguration::BuildFlatValueIndex() {
+		flat_values_.clear();
+		AddLeafValuesToIndex(configuration_root_, "", flat_values_);
+	}
+
+	const std::string* GolfSimConfiguration::LookupFlatValue(const std::string& tag_name) {
+		auto iter = flat_values_.find(tag_name);
+		return (iter == flat_values_.end()) ? nullptr : &iter->second;
+	}
 
 	bool GolfSimConfiguration::Initialize(const std::string& configuration_filename) {
 
+		const auto load_start_time = std::chrono::steady_clock::now();
+
+		configuration_filename_ = configuration_filename;
+
 		try {
 			boost::property_tree::read_json(configuration_filename, configuration_root_);
 		}
@@ -37,6 +79,10 @@ namespace golf_sim {
 			return false;
 		}
 
+		// Index the tree once so that the constant-stuffing below (and later
+		// SetConstant calls throughout the system) are O(1) lookups
+		BuildFlatValueIndex();
+
 		// Initialize new ConfigurationManager for override support
 		ConfigurationManager& config_mgr = ConfigurationManager::GetInstance();
 		if (!config_mgr.Initialize(configuration_filename)) {
@@ -50,9 +96,49 @@ namespace golf_sim {
 			return false;
 		}
 
+		long load_time_ms = (long)std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - load_start_time).count();
+		GS_LOG_MSG(info, "GolfSimConfiguration::Initialize - configuration parsed, indexed and constants set in " +
+			std::to_string(load_time_ms) + " ms.");
+
 		return true;
 	}
 
+	const std::string& GolfSimConfiguration::GetConfigurationFilename() {
+		return configuration_filename_;
+	}
+
+	bool GolfSimConfiguration::Reload() {
+
+		GS_LOG_MSG(info, "GolfSimConfiguration::Reload - re-reading " + configuration_filename_);
+
+		// Parse into a scratch tree first so that a malformed edit leaves the
+		// running configuration untouched
+		boost::property_tree::ptree new_root;
+
+		try {
+			boost::property_tree::read_json(configuration_filename_, new_root);
+		}
+		catch (std::exception const& e)
+		{
+			GS_LOG_MSG(error, "GolfSimConfiguration::Reload failed - keeping current configuration. ERROR: *** " + std::string(e.what()) + " ***");
+			return false;
+		}
+
+		configuration_root_.swap(new_root);
+		BuildFlatValueIndex();
+
+		// Bring the override layers (YAML/CLI) back in step with the new file
+		if (!ConfigurationManager::GetInstance().Reload()) {
+			GS_LOG_MSG(warning, "ConfigurationManager reload failed, using JSON only");
+		}
+
+		// Republish the constants that are read centrally.  Constants that
+		// modules stuff in their own constructors will pick up the new values
+		// the next time those objects are created.
+		return ReadValues();
+	}
+
 	// Helper function to safely get environment variable as std::string
 	std::string GolfSimConfiguration::safe_getenv(const std::string& varname) {
 		char* buffer = nullptr;
@@ -158,6 +244,13 @@ bool GolfSimConfiguration::ReadValues() {
 
 	SetConstant("gs_config.physical_constants.kBallRadiusMeters", GolfBall::kBallRadiusMeters);
 
+	SetConstant("gs_config.logging.kLogImagesAsynchronously", LoggingTools::kLogImagesAsynchronously);
+
+	SetConstant("gs_config.logging.kEnableFlightRecorder", GsFlightRecorder::kEnableFlightRecorder);
+	SetConstant("gs_config.logging.kFlightRecorderMaxImages", GsFlightRecorder::kMaxRecordedImages);
+	SetConstant("gs_config.logging.kFlightRecorderMinConfidence", GsFlightRecorder::kMinAcceptableConfidence);
+	SetConstant("gs_config.logging.kFlightRecorderDumpRawFrames", GsFlightRecorder::kDumpImagesAsRawFrames);
+
 	SetConstant("gs_config.cameras.kCamera1PositionsFromExpectedBallMeters", GolfSimCamera::kCamera1PositionsFromExpectedBallMeters);
 	SetConstant("gs_config.cameras.kCamera2PositionsFromExpectedBallMeters", GolfSimCamera::kCamera2PositionsFromExpectedBallMeters);
 	SetConstant("gs_config.cameras.kCamera2OffsetFromCamera1OriginMeters", GolfSimCamera::kCamera2OffsetFromCamera1OriginMeters);
@@ -170,9 +263,29 @@ bool GolfSimConfiguration::ReadValues() {
 	SetConstant("gs_config.user_interface.kWebServerResultBallRotatedByBestAngles", GsUISystem::kWebServerResultBallRotatedByBestAngles);
 	SetConstant("gs_config.user_interface.kWebServerErrorExposuresImage", GsUISystem::kWebServerErrorExposuresImage);
 	SetConstant("gs_config.user_interface.kWebServerBallSearchAreaImage", GsUISystem::kWebServerBallSearchAreaImage);
+	SetConstant("gs_config.user_interface.kWebServerShotSummaryFile", GsUISystem::kWebServerShotSummaryFile);
+	SetConstant("gs_config.user_interface.kWebServerUseJpegImages", GsUISystem::kWebServerUseJpegImages);
+	SetConstant("gs_config.user_interface.kWebServerJpegQuality", GsUISystem::kWebServerJpegQuality);
+	SetConstant("gs_config.user_interface.kWebServerImageMaxWidth", GsUISystem::kWebServerImageMaxWidth);
+	SetConstant("gs_config.user_interface.kWebServerUseOverlayMetadata", GsUISystem::kWebServerUseOverlayMetadata);
+	SetConstant("gs_config.user_interface.kWebServerUseAtomicImagePublish", GsUISystem::kWebServerUseAtomicImagePublish);
+	SetConstant("gs_config.user_interface.kWebServerImageStagingDirectory", GsUISystem::kWebServerImageStagingDirectory);
+	SetConstant("gs_config.user_interface.kWebServerImageCacheMaxMb", GsUISystem::kWebServerImageCacheMaxMb);
+	SetConstant("gs_config.user_interface.kStatusMessageCoalesceWindowMs", GsUISystem::kStatusMessageCoalesceWindowMs);
+	SetConstant("gs_config.user_interface.kStatusMessageRateLimitPerSec", GsUISystem::kStatusMessageRateLimitPerSec);
+	SetConstant("gs_config.user_interface.kStatusMessageRateLimitBurst", GsUISystem::kStatusMessageRateLimitBurst);
 	
 	SetConstant("gs_config.image_capture.kMaxWatchingCropWidth", LibCameraInterface::kMaxWatchingCropWidth);
 	SetConstant("gs_config.image_capture.kMaxWatchingCropHeight", LibCameraInterface::kMaxWatchingCropHeight);
+	SetConstant("gs_config.image_capture.kUsePlacedBallFrameCache", LibCameraInterface::kUsePlacedBallFrameCache);
+	SetConstant("gs_config.image_capture.kPlacedBallFrameCacheEpsilon", LibCameraInterface::kPlacedBallFrameCacheEpsilon);
+	SetConstant("gs_config.image_capture.kUseLowResWatchStream", LibCameraInterface::kUseLowResWatchStream);
+	SetConstant("gs_config.image_capture.kLowResWatchWidth", LibCameraInterface::kLowResWatchWidth);
+	SetConstant("gs_config.image_capture.kLowResWatchHeight", LibCameraInterface::kLowResWatchHeight);
+	SetConstant("gs_config.image_capture.kUseDynamicWatchCrop", LibCameraInterface::kUseDynamicWatchCrop);
+	SetConstant("gs_config.image_capture.kDynamicCropPadPixels", LibCameraInterface::kDynamicCropPadPixels);
+	SetConstant("gs_config.image_capture.kMinDynamicCropWidth", LibCameraInterface::kMinDynamicCropWidth);
+	SetConstant("gs_config.image_capture.kMinDynamicCropHeight", LibCameraInterface::kMinDynamicCropHeight);
 	SetConstant("gs_config.cameras.kCamera1Gain", LibCameraInterface::kCamera1Gain);
 	SetConstant("gs_config.cameras.kCamera1HighFPSGain", LibCameraInterface::kCamera1HighFPSGain);
 	SetConstant("gs_config.cameras.kCamera1Contrast", LibCameraInterface::kCamera1Contrast);
@@ -304,7 +417,13 @@ bool GolfSimConfiguration::ReadValues() {
 
 		// Fall back to original JSON behavior
 		try {
-			constant_value = configuration_root_.get<bool>(tag_name, false);
+			const std::string* raw_value = LookupFlatValue(tag_name);
+			if (raw_value != nullptr) {
+				constant_value = (*raw_value == "true" || *raw_value == "1");
+			}
+			else {
+				constant_value = configuration_root_.get<bool>(tag_name, false);
+			}
 		}
 		catch (std::exception const& e)
 		{
@@ -327,7 +446,8 @@ bool GolfSimConfiguration::ReadValues() {
 
 		// Fall back to original JSON behavior
 		try {
-			constant_value = configuration_root_.get<int>(tag_name, 0);
+			const std::string* raw_value = LookupFlatValue(tag_name);
+			constant_value = (raw_value != nullptr) ? std::stoi(*raw_value) : configuration_root_.get<int>(tag_name, 0);
 		}
 		catch (std::exception const& e)
 		{
@@ -338,7 +458,8 @@ bool GolfSimConfiguration::ReadValues() {
 
 	void GolfSimConfiguration::SetConstant(const std::string& tag_name, long& constant_value) {
 		try {
-			constant_value = configuration_root_.get<long>(tag_name, 0);
+			const std::string* raw_value = LookupFlatValue(tag_name);
+			constant_value = (raw_value != nullptr) ? std::stol(*raw_value) : configuration_root_.get<long>(tag_name, 0);
 		}
 		catch (std::exception const& e)
 		{
@@ -349,7 +470,8 @@ bool GolfSimConfiguration::ReadValues() {
 
 	void GolfSimConfiguration::SetConstant(const std::string& tag_name, unsigned int& constant_value) {
 		try {
-			constant_value = configuration_root_.get<uint>(tag_name, 0);
+			const std::string* raw_value = LookupFlatValue(tag_name);
+			constant_value = (raw_value != nullptr) ? (unsigned int)std::stoul(*raw_value) : configuration_root_.get<uint>(tag_name, 0);
 		}
 		catch (std::exception const& e)
 		{
@@ -372,7 +494,8 @@ bool GolfSimConfiguration::ReadValues() {
 
 		// Fall back to original JSON behavior
 		try {
-			constant_value = configuration_root_.get<float>(tag_name, 0.0);
+			const std::string* raw_value = LookupFlatValue(tag_name);
+			constant_value = (raw_value != nullptr) ? std::stof(*raw_value) : configuration_root_.get<float>(tag_name, 0.0);
 		}
 		catch (std::exception const& e)
 		{
@@ -383,7 +506,8 @@ bool GolfSimConfiguration::ReadValues() {
 
 	 void GolfSimConfiguration::SetConstant(const std::string& tag_name, double& constant_value) {
 		try {
-			constant_value = configuration_root_.get<double>(tag_name, 0.0);
+			const std::string* raw_value = LookupFlatValue(tag_name);
+			constant_value = (raw_value != nullptr) ? std::stod(*raw_value) : configuration_root_.get<double>(tag_name, 0.0);
 		}
 		catch (std::exception const& e)
 		{
@@ -412,7 +536,13 @@ bool GolfSimConfiguration::ReadValues() {
 
 		// Fall back to original JSON behavior
 		 try {
-			 constant_value = configuration_root_.get<std::string>(tag_name, constant_value);
+			 const std::string* raw_value = LookupFlatValue(tag_name);
+			 if (raw_value != nullptr) {
+				 constant_value = *raw_value;
+			 }
+			 else {
+				 constant_value = configuration_root_.get<std::string>(tag_name, constant_value);
+			 }
 		 }
 		 catch (std::exception const& e)
 		 {
@@ -523,6 +653,7 @@ bool GolfSimConfiguration::ReadValues() {
 
 			 if (PropertyExists(tag_name)) {
 				 configuration_root_.erase(tag_name);
+				 BuildFlatValueIndex();
 				 return true;
 			 }
 		 }
@@ -563,6 +694,9 @@ bool GolfSimConfiguration::ReadValues() {
 
 				 configuration_root_.add_child(tag_name, new_node);
 			 }
+
+			 // Keep the flat lookup index in step with the modified tree
+			 BuildFlatValueIndex();
 		 }
 		 catch (std::exception const& e)
 		 {
@@ -581,6 +715,9 @@ bool GolfSimConfiguration::ReadValues() {
 
 		 try {
 			 configuration_root_.put(tag_name, value);
+
+			 // Keep the flat lookup index in step with the modified tree
+			 flat_values_[tag_name] = configuration_root_.get<std::string>(tag_name, "");
 		 }
 		 catch (std::exception const& e)
 		 {
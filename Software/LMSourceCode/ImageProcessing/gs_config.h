@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <boost/program_options.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <opencv2/core.hpp>
@@ -29,6 +31,17 @@ namespace golf_sim {
 
 		static bool Initialize(const std::string& configuration_filename = "gs_config.json");
 
+		// Re-reads the file that Initialize() loaded and republishes the static
+		// constants that ReadValues() covers.  Constants that modules read at
+		// construction time pick up the new values on their next construction.
+		// Intended for between-shot tuning without a process restart.
+		// The current configuration is left untouched if the file fails to parse.
+		static bool Reload();
+
+		// The path of the .json file that Initialize() loaded (used, e.g., to
+		// fingerprint state derived from the configuration)
+		static const std::string& GetConfigurationFilename();
+
 		// Uses a safer version of getenv when in Windows environment.
 		static std::string safe_getenv(const std::string& varname);
 
@@ -80,6 +93,24 @@ namespace golf_sim {
 	protected:
 
 		static boost::property_tree::ptree configuration_root_;
+
+		// Remembered so that Reload() can re-read the same file
+		static std::string configuration_filename_;
+
+		// A flat (dotted-path -> raw string) index over configuration_root_.
+		// It is built once when the .json file is parsed so that the hundreds of
+		// SetConstant calls made at startup are single hash lookups instead of
+		// each re-traversing the property tree by path.
+		static std::unordered_map<std::string, std::string> flat_values_;
+
+		// (Re)builds flat_values_ from the current configuration_root_.  Must be
+		// called again after anything mutates the tree (e.g., SetTreeValue) so
+		// the index does not go stale.
+		static void BuildFlatValueIndex();
+
+		// Returns a pointer to the raw string value for the tag, or nullptr if
+		// the tag is not a leaf value in the tree
+		static const std::string* LookupFlatValue(const std::string& tag_name);
 	};
 
 }
@@ -0,0 +1,260 @@
+/*****************************************************************//**
+ * \file   gs_core_affinity.cpp
+ * \brief  Startup IRQ steering and verified thread-core affinity.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef __unix__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include "gs_core_affinity.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+
+namespace golf_sim {
+
+    bool GsCoreAffinity::kSteerIrqsAtStartup = false;
+    int GsCoreAffinity::kIrqSteeringCore = 0;
+    std::string GsCoreAffinity::kIrqDeviceMatchList = "eth,wlan,mmc,sdhci,usb,xhci,dwc";
+
+    namespace {
+
+        std::string CoreListString(const std::vector<int>& cores) {
+            std::string s;
+            for (int core : cores) {
+                if (!s.empty()) {
+                    s += ",";
+                }
+                s += std::to_string(core);
+            }
+            return s;
+        }
+
+#ifdef __unix__
+        std::string CoreSetString(const cpu_set_t& cpuset) {
+            std::string s;
+            for (int core = 0; core < CPU_SETSIZE; core++) {
+                if (CPU_ISSET(core, &cpuset)) {
+                    if (!s.empty()) {
+                        s += ",";
+                    }
+                    s += std::to_string(core);
+                }
+            }
+            return s;
+        }
+#endif
+
+        std::vector<std::string> SplitMatchList(const std::string& list) {
+            std::vector<std::string> tokens;
+            std::stringstream ss(list);
+            std::string token;
+            while (std::getline(ss, token, ',')) {
+                std::transform(token.begin(), token.end(), token.begin(),
+                               [](unsigned char c) { return (char)std::tolower(c); });
+                if (!token.empty()) {
+                    tokens.push_back(token);
+                }
+            }
+            return tokens;
+        }
+
+    }
+
+
+    void GsCoreAffinity::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.modes.kSteerIrqsAtStartup", kSteerIrqsAtStartup);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kIrqSteeringCore", kIrqSteeringCore);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kIrqDeviceMatchList", kIrqDeviceMatchList);
+
+        if (kSteerIrqsAtStartup) {
+            SteerIrqs();
+        }
+        else {
+            GS_LOG_TRACE_MSG(trace, "GsCoreAffinity - IRQ steering is disabled, device IRQ placement is left to the kernel.");
+        }
+
+        LogCoreMap("startup");
+    }
+
+
+    void GsCoreAffinity::SteerIrqs() {
+#ifdef __unix__
+        std::ifstream interrupts("/proc/interrupts");
+        if (!interrupts.is_open()) {
+            GS_LOG_MSG(warning, "GsCoreAffinity - could not read /proc/interrupts, IRQs were not steered.");
+            return;
+        }
+
+        const std::vector<std::string> match_tokens = SplitMatchList(kIrqDeviceMatchList);
+        if (match_tokens.empty()) {
+            GS_LOG_MSG(warning, "GsCoreAffinity - kIrqDeviceMatchList is empty, IRQs were not steered.");
+            return;
+        }
+
+        int steered = 0;
+        int failed = 0;
+
+        std::string line;
+        while (std::getline(interrupts, line)) {
+
+            // Device lines start with the IRQ number and a colon; the
+            // summary rows (ERR:, MIS:, the per-CPU header) do not.
+            const size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+
+            const std::string irq_field = line.substr(0, colon);
+            const size_t digits_start = irq_field.find_first_not_of(' ');
+            if (digits_start == std::string::npos ||
+                irq_field.find_first_not_of("0123456789", digits_start) != std::string::npos) {
+                continue;
+            }
+            const std::string irq_number = irq_field.substr(digits_start);
+
+            std::string lowered = line;
+            std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                           [](unsigned char c) { return (char)std::tolower(c); });
+
+            bool matched = false;
+            for (const std::string& token : match_tokens) {
+                if (lowered.find(token, colon) != std::string::npos) {
+                    matched = true;
+                    break;
+                }
+            }
+            if (!matched) {
+                continue;
+            }
+
+            std::ofstream affinity("/proc/irq/" + irq_number + "/smp_affinity_list");
+            if (affinity.is_open()) {
+                affinity << kIrqSteeringCore;
+            }
+            if (affinity.good()) {
+                steered++;
+                GS_LOG_TRACE_MSG(trace, "GsCoreAffinity - steered IRQ " + irq_number + " to core " +
+                    std::to_string(kIrqSteeringCore) + ".");
+            }
+            else {
+                // Some matched IRQs (per-CPU and chained ones) legitimately
+                // refuse an affinity, so individual failures are not fatal.
+                failed++;
+            }
+        }
+
+        if (steered == 0 && failed > 0) {
+            GS_LOG_MSG(info, "GsCoreAffinity - could not steer any of the " + std::to_string(failed) +
+                " matched IRQs (writing /proc/irq requires root).  Device IRQ placement is left to the kernel.");
+        }
+        else {
+            GS_LOG_MSG(info, "GsCoreAffinity - steered " + std::to_string(steered) + " device IRQ(s) to core " +
+                std::to_string(kIrqSteeringCore) +
+                (failed > 0 ? " (" + std::to_string(failed) + " refused the change)." : "."));
+        }
+#else
+        GS_LOG_MSG(warning, "GsCoreAffinity - IRQ steering is only available on Linux.");
+#endif
+    }
+
+
+#ifdef __unix__
+    bool GsCoreAffinity::ApplyAndVerify(pthread_t thread,
+                                        const std::vector<int>& cores,
+                                        const std::string& pool_name) {
+
+        if (cores.empty()) {
+            GS_LOG_MSG(warning, "GsCoreAffinity - no cores were configured for the " + pool_name + " pool.");
+            return false;
+        }
+
+        cpu_set_t requested;
+        CPU_ZERO(&requested);
+        for (int core : cores) {
+            CPU_SET(core, &requested);
+        }
+
+        int result = pthread_setaffinity_np(thread, sizeof(cpu_set_t), &requested);
+        if (result != 0) {
+            GS_LOG_MSG(warning, "GsCoreAffinity - failed to set the " + pool_name + " pool's affinity to cores " +
+                CoreListString(cores) + " (error " + std::to_string(result) +
+                ").  The thread will run wherever the scheduler places it.");
+            return false;
+        }
+
+        // Read it back - the kernel can accept the call but intersect the
+        // mask with the cores that actually exist, which would quietly
+        // defeat the per-core budgeting.
+        cpu_set_t applied;
+        CPU_ZERO(&applied);
+        result = pthread_getaffinity_np(thread, sizeof(cpu_set_t), &applied);
+
+        if (result != 0 || !CPU_EQUAL(&requested, &applied)) {
+            GS_LOG_MSG(warning, "GsCoreAffinity - the " + pool_name + " pool requested cores " +
+                CoreListString(cores) + " but is running on cores " + CoreSetString(applied) + ".");
+            return false;
+        }
+
+        GS_LOG_TRACE_MSG(trace, "GsCoreAffinity - the " + pool_name + " pool is pinned to cores " +
+            CoreListString(cores) + ".");
+        return true;
+    }
+#endif
+
+
+    void GsCoreAffinity::LogCoreMap(const std::string& context) {
+#ifdef __unix__
+        std::string map;
+
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator("/proc/self/task", ec)) {
+
+            const std::string tid_string = entry.path().filename().string();
+
+            std::string comm;
+            std::ifstream comm_file(entry.path() / "comm");
+            std::getline(comm_file, comm);
+
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            const pid_t tid = (pid_t)std::stol(tid_string);
+            if (sched_getaffinity(tid, sizeof(cpu_set_t), &cpuset) != 0) {
+                continue;
+            }
+
+            if (!map.empty()) {
+                map += "; ";
+            }
+            map += comm + " (tid " + tid_string + ") -> " + CoreSetString(cpuset);
+        }
+
+        if (ec || map.empty()) {
+            GS_LOG_TRACE_MSG(trace, "GsCoreAffinity - could not enumerate /proc/self/task for the core map.");
+            return;
+        }
+
+        GS_LOG_MSG(info, "GsCoreAffinity - " + context + " core map: " + map);
+#else
+        (void)context;
+#endif
+    }
+
+}
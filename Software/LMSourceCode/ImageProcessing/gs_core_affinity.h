@@ -0,0 +1,81 @@
+/*****************************************************************//**
+ * \file   gs_core_affinity.h
+ * \brief  Startup IRQ steering and verified thread-core affinity.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#ifdef __unix__
+#include <pthread.h>
+#endif
+
+namespace golf_sim {
+
+    // The per-core budgeting throughout the system (the detector's
+    // cpu_cores, the strobe trigger's dedicated core, the thread budget
+    // manager's partitions) assumes that core 0 absorbs the Pi's device
+    // interrupts and the analysis cores run undisturbed.  Nothing enforced
+    // that:  the kernel leaves network, SD and USB IRQs free to land on any
+    // core, and an affinity call that fails (a core number past the
+    // hardware, an EINVAL from an offlined core) failed silently, leaving a
+    // pool running wherever the scheduler put it.  This module makes both
+    // explicit at startup - it steers the noisy IRQs onto the housekeeping
+    // core when the process is privileged enough to do so, provides the
+    // apply-and-verify affinity call the pools route through, and logs the
+    // final thread-to-core map so a misconfiguration shows up in the log
+    // instead of as unexplained jitter.
+    //
+    // IRQ steering is off by default (gs_config.modes.kSteerIrqsAtStartup)
+    // and is best-effort:  an unprivileged process logs one notice and
+    // moves on, since /proc/irq is root-writable.
+
+    class GsCoreAffinity {
+
+    public:
+
+        static bool kSteerIrqsAtStartup;
+
+        // The housekeeping core the matched IRQs are steered to.
+        static int kIrqSteeringCore;
+
+        // Comma-separated substrings matched against the device names in
+        // /proc/interrupts to pick the IRQs worth steering.
+        static std::string kIrqDeviceMatchList;
+
+        // Reads the configuration, steers the matched IRQs (when enabled
+        // and privileged), and logs the process's thread-to-core map.
+        // Call once at startup, after the JSON configuration is available.
+        static void Initialize();
+
+#ifdef __unix__
+        // Applies the given core set to the thread and reads it back to
+        // confirm the kernel accepted it.  Logs a warning naming the pool
+        // on failure or mismatch.  Returns true only when the verified
+        // affinity matches the request.
+        static bool ApplyAndVerify(pthread_t thread,
+                                   const std::vector<int>& cores,
+                                   const std::string& pool_name);
+#endif
+
+        // Logs one line per thread of this process with its name and the
+        // cores it may run on.  Also called from Initialize(); exposed so
+        // the map can be re-logged after the late-starting pools are up.
+        static void LogCoreMap(const std::string& context);
+
+    private:
+
+        static void SteerIrqs();
+    };
+
+}
@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include "gs_cpu_dispatch.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+
+namespace golf_sim {
+
+    GsCpuDispatch::TuningTarget GsCpuDispatch::GetTuningTarget() {
+
+        // The model cannot change while the process is running, so detect it
+        // once and hand back the cached answer on the hot paths.
+        static TuningTarget tuning_target = []() {
+
+            TuningTarget target = kTuneCortexA76;
+
+            if (GolfSimConfiguration::GetPiModel() == GolfSimConfiguration::PiModel::kRPi4) {
+                target = kTuneCortexA72;
+            }
+
+            GS_LOG_TRACE_MSG(trace, "GsCpuDispatch - selected kernel tuning target: " + TuningTargetName(target));
+
+            return target;
+        }();
+
+        return tuning_target;
+    }
+
+    std::string GsCpuDispatch::TuningTargetName(TuningTarget target) {
+
+        switch (target) {
+            case kTuneCortexA72:
+                return "Cortex-A72 (Pi 4)";
+            case kTuneCortexA76:
+            default:
+                return "Cortex-A76 (Pi 5)";
+        }
+    }
+
+}
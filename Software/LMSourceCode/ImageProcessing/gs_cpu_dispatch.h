@@ -0,0 +1,42 @@
+/*****************************************************************//**
+ * \file   gs_cpu_dispatch.h
+ * \brief  Runtime selection of per-CPU-tuned kernel builds.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace golf_sim {
+
+    // The deployed fleet is split between Pi 4s (Cortex-A72) and Pi 5s
+    // (Cortex-A76), but a single binary is shipped to both.  The hand-written
+    // hot kernels are therefore compiled twice - once tuned for each core (see
+    // gs_tuned_kernels.cpp and the static libraries in meson.build) - and the
+    // call sites pick the right build at runtime based on the detected model.
+
+    class GsCpuDispatch {
+
+    public:
+
+        enum TuningTarget {
+            kTuneCortexA72 = 0,     // Pi 4 / CM4
+            kTuneCortexA76 = 1      // Pi 5 (and the default for unknown models)
+        };
+
+        // Returns the tuning target for the machine we are running on.
+        // Detected once (via GolfSimConfiguration::GetPiModel) and cached.
+        static TuningTarget GetTuningTarget();
+
+        static std::string TuningTargetName(TuningTarget target);
+    };
+
+}
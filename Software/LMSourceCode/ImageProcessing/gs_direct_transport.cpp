@@ -0,0 +1,413 @@
+/*****************************************************************//**
+ * \file   gs_direct_transport.cpp
+ * \brief  Broker-less peer-to-peer transport for the two-Pi image path.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "gs_direct_transport.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+#include "gs_globals.h"
+#include "gs_options.h"
+#include "gs_ipc_message.h"
+#include "gs_ipc_message_pool.h"
+#include "gs_ipc_system.h"
+#include "gs_shot_trace.h"
+
+namespace golf_sim {
+
+    bool GsDirectTransport::kEnableDirectTransport = false;
+    int GsDirectTransport::kDirectTransportPort = 51717;
+    std::string GsDirectTransport::kDirectTransportPeerAddress = "";
+
+    namespace {
+
+        // Bump whenever the frame layout changes.  A version mismatch means
+        // one Pi is running an older build - the link is refused and both
+        // sides simply stay on the broker.
+        const uint32_t kFrameVersion = 1;
+        const uint32_t kFrameMagic = 0x54445450;  // "PTDT"
+
+        // A frame body larger than this is a corrupted or hostile header,
+        // not an image - the link is torn down rather than the allocation
+        // attempted.
+        const uint64_t kMaxFrameBodyBytes = 256ULL * 1024 * 1024;
+
+        // The per-frame header.  The two Pis are the same architecture, so
+        // the fields travel in native layout the same way the shared-memory
+        // channel's slots do.
+        struct FrameHeader {
+            uint32_t magic;
+            uint32_t frame_version;
+            int32_t message_type;
+            int32_t band_index;
+            int32_t band_count;
+            int32_t spin_offload_split_col;
+            uint32_t spin_offload_ball1_length;
+            uint32_t spin_offload_ball2_length;
+            uint64_t shot_trace_id;
+            uint64_t body_length;
+        };
+
+        static_assert(sizeof(FrameHeader) == 48, "Unexpected direct-transport frame header size");
+
+        boost::asio::io_context io_context_;
+
+        // The connected peer socket.  Written by the link thread, used by
+        // any sending thread - both under socket_mutex_.
+        std::unique_ptr<boost::asio::ip::tcp::socket> peer_socket_;
+        std::mutex socket_mutex_;
+
+        std::atomic<bool> peer_connected_{ false };
+        std::atomic<bool> transport_exit_{ false };
+
+        std::thread* link_thread_ = nullptr;
+
+        // Used by the link thread to interrupt a blocking accept on Stop()
+        std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor_;
+
+        // Tears down the current peer connection (from either a send-side
+        // write failure or the receive loop seeing the link drop).
+        void CloseLink() {
+
+            std::lock_guard<std::mutex> lock(socket_mutex_);
+
+            peer_connected_.store(false);
+
+            if (peer_socket_ != nullptr) {
+                boost::system::error_code ignored;
+                peer_socket_->close(ignored);
+            }
+        }
+
+        // Reads exactly length bytes, returning false on EOF or error.
+        bool ReadFully(boost::asio::ip::tcp::socket& socket, void* destination, size_t length) {
+
+            boost::system::error_code error;
+            boost::asio::read(socket, boost::asio::buffer(destination, length), error);
+            return !error;
+        }
+
+        // Receives frames until the link drops or the transport is stopped.
+        // The buffers are reused across frames, so steady-state reception
+        // does not allocate (beyond what UnpackMatData itself does).
+        void ReceiveLoop(boost::asio::ip::tcp::socket& socket) {
+
+            std::vector<char> body_buffer;
+            std::vector<char> ball1_buffer;
+            std::vector<char> ball2_buffer;
+
+            while (!transport_exit_) {
+
+                FrameHeader header{};
+
+                if (!ReadFully(socket, &header, sizeof(header))) {
+                    break;
+                }
+
+                if (header.magic != kFrameMagic || header.frame_version != kFrameVersion ||
+                    header.body_length > kMaxFrameBodyBytes) {
+                    GS_LOG_MSG(warning, "GsDirectTransport received an unrecognized frame header.  Dropping the link.");
+                    break;
+                }
+
+                ball1_buffer.resize(header.spin_offload_ball1_length);
+                ball2_buffer.resize(header.spin_offload_ball2_length);
+                body_buffer.resize((size_t)header.body_length);
+
+                if ((header.spin_offload_ball1_length > 0 && !ReadFully(socket, ball1_buffer.data(), ball1_buffer.size())) ||
+                    (header.spin_offload_ball2_length > 0 && !ReadFully(socket, ball2_buffer.data(), ball2_buffer.size())) ||
+                    (header.body_length > 0 && !ReadFully(socket, body_buffer.data(), body_buffer.size()))) {
+                    break;
+                }
+
+                // Take on the sender's shot trace ID just as the broker
+                // receive path does
+                GsShotTrace::AdoptShotTrace(header.shot_trace_id);
+
+                std::shared_ptr<GolfSimIPCMessage> ipc_message =
+                    GsIPCMessagePool::AcquireMessage((GolfSimIPCMessage::IPCMessageType)header.message_type);
+
+                if (ipc_message == nullptr) {
+                    continue;
+                }
+
+                if (header.body_length > 0) {
+                    ipc_message->UnpackMatData(body_buffer.data(), (size_t)header.body_length);
+                }
+
+                if (header.band_count > 1) {
+                    ipc_message->SetImageBandInfo(header.band_index, header.band_count);
+                }
+
+                if (header.spin_offload_ball1_length > 0) {
+                    ipc_message->SetSpinOffloadRequestData(
+                        std::string(ball1_buffer.data(), ball1_buffer.size()),
+                        std::string(ball2_buffer.data(), ball2_buffer.size()),
+                        header.spin_offload_split_col);
+                }
+
+                // Everything downstream of the transport is the regular
+                // dispatch path
+                GolfSimIpcSystem::DispatchBuiltIpcMessage(ipc_message);
+            }
+        }
+
+        // Installs a freshly connected peer socket and runs its receive loop
+        void RunConnectedPeer(std::unique_ptr<boost::asio::ip::tcp::socket> socket) {
+
+            // The frames are already full messages - never let the kernel
+            // hold a header back waiting for more data
+            boost::system::error_code error;
+            socket->set_option(boost::asio::ip::tcp::no_delay(true), error);
+
+            boost::asio::ip::tcp::socket* raw_socket = socket.get();
+
+            {
+                std::lock_guard<std::mutex> lock(socket_mutex_);
+                peer_socket_ = std::move(socket);
+                peer_connected_.store(true);
+            }
+
+            GS_LOG_MSG(info, "GsDirectTransport link is up - image-bearing messages will bypass the broker.");
+
+            ReceiveLoop(*raw_socket);
+
+            CloseLink();
+
+            if (!transport_exit_) {
+                GS_LOG_MSG(info, "GsDirectTransport link dropped.  Falling back to the broker until it returns.");
+            }
+        }
+
+        // The camera-1 side: accept one peer at a time, for as long as the
+        // transport is up
+        void RunListener() {
+
+            try {
+                acceptor_ = std::make_unique<boost::asio::ip::tcp::acceptor>(io_context_,
+                    boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(),
+                                                   (unsigned short)GsDirectTransport::kDirectTransportPort));
+            }
+            catch (std::exception& e) {
+                GS_LOG_MSG(warning, "GsDirectTransport could not listen on port " +
+                    std::to_string(GsDirectTransport::kDirectTransportPort) + " (" + std::string(e.what()) +
+                    ").  Staying on the broker.");
+                return;
+            }
+
+            while (!transport_exit_) {
+
+                auto socket = std::make_unique<boost::asio::ip::tcp::socket>(io_context_);
+
+                boost::system::error_code error;
+                acceptor_->accept(*socket, error);
+
+                if (transport_exit_) {
+                    return;
+                }
+
+                if (error) {
+                    continue;
+                }
+
+                RunConnectedPeer(std::move(socket));
+            }
+        }
+
+        // The camera-2 side: connect to the camera-1 system, re-connecting
+        // (quietly) whenever the link is down
+        void RunConnector() {
+
+            bool connect_failure_logged = false;
+
+            while (!transport_exit_) {
+
+                auto socket = std::make_unique<boost::asio::ip::tcp::socket>(io_context_);
+
+                boost::system::error_code error;
+                boost::asio::ip::tcp::endpoint peer(
+                    boost::asio::ip::make_address(GsDirectTransport::kDirectTransportPeerAddress, error),
+                    (unsigned short)GsDirectTransport::kDirectTransportPort);
+
+                if (!error) {
+                    socket->connect(peer, error);
+                }
+
+                if (error) {
+                    // One notice, not one per retry - the other Pi may just
+                    // not be up yet
+                    if (!connect_failure_logged) {
+                        GS_LOG_MSG(info, "GsDirectTransport could not connect to " +
+                            GsDirectTransport::kDirectTransportPeerAddress + ":" +
+                            std::to_string(GsDirectTransport::kDirectTransportPort) +
+                            " yet.  Will keep retrying in the background.");
+                        connect_failure_logged = true;
+                    }
+
+                    for (int i = 0; i < 20 && !transport_exit_; i++) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    }
+                    continue;
+                }
+
+                connect_failure_logged = false;
+
+                RunConnectedPeer(std::move(socket));
+            }
+        }
+    }
+
+
+    void GsDirectTransport::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kEnableDirectTransport", kEnableDirectTransport);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kDirectTransportPort", kDirectTransportPort);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kDirectTransportPeerAddress", kDirectTransportPeerAddress);
+    }
+
+
+    bool GsDirectTransport::Start() {
+
+        if (!kEnableDirectTransport || link_thread_ != nullptr) {
+            return true;
+        }
+
+        SystemMode mode = GolfSimOptions::GetCommandLineOptions().system_mode_;
+
+        if (mode == SystemMode::kCamera1) {
+            transport_exit_ = false;
+            link_thread_ = new std::thread(RunListener);
+        }
+        else if (mode == SystemMode::kCamera2) {
+
+            if (kDirectTransportPeerAddress.empty()) {
+                GS_LOG_MSG(warning, "GsDirectTransport is enabled, but kDirectTransportPeerAddress is not set.  Staying on the broker.");
+                return true;
+            }
+
+            transport_exit_ = false;
+            link_thread_ = new std::thread(RunConnector);
+        }
+
+        // Other modes (tests, calibration) are single-process - nothing to do
+
+        return true;
+    }
+
+
+    void GsDirectTransport::Stop() {
+
+        if (link_thread_ == nullptr) {
+            return;
+        }
+
+        transport_exit_ = true;
+
+        // Unblock a pending accept/read so the link thread can exit
+        if (acceptor_ != nullptr) {
+            boost::system::error_code ignored;
+            acceptor_->close(ignored);
+        }
+
+        CloseLink();
+
+        link_thread_->join();
+        delete link_thread_;
+        link_thread_ = nullptr;
+    }
+
+
+    bool GsDirectTransport::IsConnected() {
+        return peer_connected_.load();
+    }
+
+
+    bool GsDirectTransport::SendIpcMessage(const GolfSimIPCMessage& ipc_message) {
+
+        if (!peer_connected_.load()) {
+            return false;
+        }
+
+        size_t body_length = 0;
+        unsigned char* body_data = ipc_message.GetImageMatBytePointer(body_length);
+
+        if (body_data == nullptr || body_length == 0) {
+            // The image is riding the shared-memory channel (or there is no
+            // image at all) - either way, this is not a frame for the link
+            return false;
+        }
+
+        const std::string& ball1_data = ipc_message.GetSpinOffloadBall1Data();
+        const std::string& ball2_data = ipc_message.GetSpinOffloadBall2Data();
+
+        FrameHeader header{};
+        header.magic = kFrameMagic;
+        header.frame_version = kFrameVersion;
+        header.message_type = (int32_t)ipc_message.GetMessageType();
+        header.band_index = ipc_message.GetImageBandIndex();
+        header.band_count = ipc_message.GetImageBandCount();
+        header.spin_offload_split_col = ipc_message.GetSpinOffloadSplitCol();
+        header.spin_offload_ball1_length = (uint32_t)ball1_data.length();
+        header.spin_offload_ball2_length = (uint32_t)ball2_data.length();
+        header.shot_trace_id = GsShotTrace::Current();
+        header.body_length = (uint64_t)body_length;
+
+        // A single gather-write - the serialized image bytes go to the
+        // socket straight from the message, with no intermediate send
+        // buffer and no broker re-send on the far side of one.
+        std::array<boost::asio::const_buffer, 4> frame = {
+            boost::asio::buffer(&header, sizeof(header)),
+            boost::asio::buffer(ball1_data),
+            boost::asio::buffer(ball2_data),
+            boost::asio::buffer(body_data, body_length)
+        };
+
+        std::lock_guard<std::mutex> lock(socket_mutex_);
+
+        if (!peer_connected_.load() || peer_socket_ == nullptr) {
+            return false;
+        }
+
+        boost::system::error_code error;
+        boost::asio::write(*peer_socket_, frame, error);
+
+        if (error) {
+            GS_LOG_MSG(warning, "GsDirectTransport write failed (" + error.message() +
+                ").  Falling back to the broker for this message.");
+
+            peer_connected_.store(false);
+
+            boost::system::error_code ignored;
+            peer_socket_->close(ignored);
+            return false;
+        }
+
+        return true;
+    }
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
@@ -0,0 +1,84 @@
+/*****************************************************************//**
+ * \file   gs_direct_transport.h
+ * \brief  Broker-less peer-to-peer transport for the two-Pi image path.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <string>
+
+namespace golf_sim {
+
+    class GolfSimIPCMessage;
+
+    // Routing the strobed camera-2 image through the ActiveMQ broker adds a
+    // store-and-forward hop - the broker receives, buffers and re-sends the
+    // single largest transfer of the shot sequence - plus the copies that
+    // come with marshalling it into a broker message.  This transport is a
+    // direct TCP connection between the two LM processes, negotiated at
+    // startup (the camera-1 system listens, the camera-2 system connects
+    // and re-connects), and carries the image-bearing message types
+    // point-to-point while control and status traffic stays on the broker
+    // for the GUI and tooling.
+    //
+    // A frame is a small fixed header plus the very same serialized image
+    // body the broker path sends (GsIPCMat packing, compression and all),
+    // gather-written so the pixels are never copied into a send buffer.
+    // The receive side rebuilds a GolfSimIPCMessage and hands it to the
+    // regular dispatch switch, so everything downstream of the transport is
+    // unchanged.  If the link is down, the send path reports failure and
+    // the caller falls back to the broker - the direct path is an
+    // optimization, never a single point of failure.
+    //
+    // Off by default (gs_config.ipc_interface.kEnableDirectTransport).
+
+    class GsDirectTransport {
+
+    public:
+
+        static bool kEnableDirectTransport;
+
+        // The TCP port the camera-1 system listens on.
+        static int kDirectTransportPort;
+
+        // The camera-1 system's address, used by the camera-2 system to
+        // connect.  Empty disables the transport on the camera-2 side.
+        static std::string kDirectTransportPeerAddress;
+
+        // Reads the configuration values above.  Call once at startup,
+        // after the JSON configuration has been parsed.
+        static void Initialize();
+
+        // Starts the link thread for this process's role (listen on the
+        // camera-1 system, connect-with-retry on the camera-2 system).  A
+        // no-op when disabled or in a mode that is not one half of a
+        // two-Pi setup.
+        static bool Start();
+
+        // Closes the link and joins the thread.
+        static void Stop();
+
+        // True while a peer is connected and frames can be sent.
+        static bool IsConnected();
+
+        // Sends an image-bearing message over the direct link.  Returns
+        // false - without logging an error - when the link is down or the
+        // message's image is not carried in-body (e.g., it rides the
+        // shared-memory channel), so the caller can fall back to the
+        // broker.
+        static bool SendIpcMessage(const GolfSimIPCMessage& ipc_message);
+    };
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
@@ -0,0 +1,241 @@
+/*****************************************************************//**
+ * \file   gs_e2e_bench.cpp
+ * \brief  End-to-end latency benchmark replaying recorded shots.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+ /* SPDX-License-Identifier: GPL-2.0-only */
+ /*
+  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+  */
+
+// Builds as the (optional) pitrac_e2e_bench executable.  The benchmark replays
+// recorded shots - a teed-ball (camera 1) image plus the strobed camera-2 image,
+// the same artifacts the automated test suite uses - through
+// GolfSimCamera::ProcessReceivedCam2Image, which is the exact call the FSM makes
+// when a Camera2ImageReceived event arrives.  Each replay is timed stage by
+// stage (image load, analysis) and one CSV row per iteration is written so that
+// latency regressions can be caught without a human swinging a club.
+//
+// The full RunGolfSimFsm loop additionally needs ActiveMQ, the cameras and the
+// strobe hardware; everything the FSM itself does per shot between the
+// Camera2ImageReceived event and the IPC send is inside the call benchmarked
+// here.  (On a live system, the FSM transition tracer provides the
+// corresponding state-level timing.)
+//
+// Usage:
+//      pitrac_e2e_bench <shot_corpus_file> <output_csv_file> [iterations_per_shot] [config_file]
+//
+// The corpus file holds one shot per line ("<teed_ball_image> <strobed_image>",
+// '#' comments allowed), with file names relative to the usual base image
+// directory from the .json configuration file.
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gs_config.h"
+#include "gs_options.h"
+#include "gs_globals.h"
+#include "logging_tools.h"
+#include "ball_image_proc.h"
+#include "gs_camera.h"
+#include "gs_automated_testing.h"
+#include "cv_utils.h"
+#include "pulse_strobe.h"
+
+
+using namespace golf_sim;
+
+
+struct E2eBenchShot {
+    std::string teed_ball_image_filename;
+    std::string strobed_image_filename;
+};
+
+
+static bool ReadCorpusFile(const std::string& corpus_filename, std::vector<E2eBenchShot>& shots) {
+
+    std::ifstream file(corpus_filename);
+
+    if (!file.is_open()) {
+        std::cerr << "Could not open corpus file: " << corpus_filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        // Strip comments and skip blank lines
+        size_t comment_pos = line.find('#');
+        if (comment_pos != std::string::npos) {
+            line = line.substr(0, comment_pos);
+        }
+
+        std::istringstream line_stream(line);
+        E2eBenchShot shot;
+        if (line_stream >> shot.teed_ball_image_filename >> shot.strobed_image_filename) {
+            shots.push_back(shot);
+        }
+    }
+
+    return !shots.empty();
+}
+
+
+static double ElapsedMs(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+
+// Replays one recorded shot num_iterations times, appending a CSV row per
+// iteration.  Returns false if the shot could not be replayed at all.
+static bool BenchmarkOneShot(const E2eBenchShot& shot, int num_iterations, std::ofstream& csv_file) {
+
+    CameraHardware::CameraModel camera_model = CameraHardware::PiGS;
+
+    for (int i = 0; i < num_iterations; i++) {
+
+        cv::Mat teed_ball_ImgGray;
+        cv::Mat strobed_balls_ImgGray;
+        cv::Mat teed_ball_ImgColor;
+        cv::Mat strobed_balls_ImgColor;
+
+        // Stage 1 - image load/decode (what the camera DMA delivers for free
+        // on a live system, but part of every corpus run)
+        const auto load_start = std::chrono::steady_clock::now();
+
+        if (!GsAutomatedTesting::ReadTestImages(shot.teed_ball_image_filename, shot.strobed_image_filename,
+            teed_ball_ImgGray, strobed_balls_ImgGray, teed_ball_ImgColor, strobed_balls_ImgColor,
+            camera_model, false /* No undistort */)) {
+            std::cerr << "Could not read images for shot: " << shot.teed_ball_image_filename
+                << " / " << shot.strobed_image_filename << std::endl;
+            return false;
+        }
+
+        double load_ms = ElapsedMs(load_start);
+
+        // Stage 2 - the genuine camera-2 analysis path, exactly as the FSM
+        // invokes it when a Camera2ImageReceived event arrives
+        GolfBall result_ball;
+        cv::Vec3d rotation_results;
+        cv::Mat exposures_image;
+        cv::Mat dummy_pre_image;
+        std::vector<GolfBall> exposure_balls;
+
+        const auto analysis_start = std::chrono::steady_clock::now();
+
+        bool success = GolfSimCamera::ProcessReceivedCam2Image(teed_ball_ImgColor,
+                                                               strobed_balls_ImgColor,
+                                                               dummy_pre_image,
+                                                               result_ball,
+                                                               rotation_results,
+                                                               exposures_image,
+                                                               exposure_balls);
+
+        double analysis_ms = ElapsedMs(analysis_start);
+
+        csv_file << shot.teed_ball_image_filename << ","
+            << i << ","
+            << std::fixed << std::setprecision(3)
+            << load_ms << ","
+            << analysis_ms << ","
+            << (load_ms + analysis_ms) << ","
+            << (success ? "OK" : "FAILED") << ","
+            << std::setprecision(2)
+            << CvUtils::MetersPerSecondToMPH((float)result_ball.velocity_) << ","
+            << result_ball.angles_ball_perspective_[0] << ","
+            << result_ball.angles_ball_perspective_[1] << ","
+            << (int)result_ball.rotation_speeds_RPM_[2] << ","
+            << (int)result_ball.rotation_speeds_RPM_[0] << std::endl;
+
+        std::cout << "=== E2E_BENCH shot=" << shot.teed_ball_image_filename << " iteration=" << i
+            << "  load=" << std::fixed << std::setprecision(3) << load_ms << "ms"
+            << "  analysis=" << analysis_ms << "ms"
+            << "  " << (success ? "OK" : "FAILED") << " ===" << std::endl;
+
+        if (!success && i == 0) {
+            // If the first replay of the shot fails, the rest will too
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 3) {
+            std::cerr << "Usage: pitrac_e2e_bench <shot_corpus_file> <output_csv_file> [iterations_per_shot] [config_file]" << std::endl;
+            return 1;
+        }
+
+        std::string corpus_filename = argv[1];
+        std::string output_csv_filename = argv[2];
+        int num_iterations = (argc > 3) ? std::stoi(argv[3]) : 3;
+        std::string config_file_name = (argc > 4) ? argv[4] : "golf_sim_config.json";
+
+        LoggingTools::InitLogging();
+
+        if (!GolfSimConfiguration::Initialize(config_file_name)) {
+            std::cerr << "Could not initialize configuration module using config file: " << config_file_name << std::endl;
+            return 1;
+        }
+
+        GolfSimGlobals::golf_sim_running_ = true;
+
+        BallImageProc::LoadConfigurationValues();
+
+        // The pulse intervals must be set up so that the analysis can determine
+        // pulse-ratios for distance and time measurements
+        if (!PulseStrobe::InitGPIOSystem(nullptr /* Signal handler not needed here */)) {
+            std::cerr << "Failed to InitGPIOSystem." << std::endl;
+            return 1;
+        }
+
+        std::vector<E2eBenchShot> shots;
+        if (!ReadCorpusFile(corpus_filename, shots)) {
+            std::cerr << "No usable shots found in corpus file: " << corpus_filename << std::endl;
+            return 1;
+        }
+
+        std::ofstream csv_file(output_csv_filename, std::ios::trunc);
+        if (!csv_file) {
+            std::cerr << "Could not open output CSV file: " << output_csv_filename << std::endl;
+            return 1;
+        }
+
+        csv_file << "shot,iteration,load_ms,analysis_ms,total_ms,result,speed_mph,hla_deg,vla_deg,back_spin_rpm,side_spin_rpm" << std::endl;
+
+        std::cout << "pitrac_e2e_bench - " << shots.size() << " shot(s), " << num_iterations << " iteration(s) per shot." << std::endl;
+
+        int num_failed_shots = 0;
+
+        for (const auto& shot : shots) {
+            if (!BenchmarkOneShot(shot, num_iterations, csv_file)) {
+                num_failed_shots++;
+            }
+        }
+
+        std::cout << "pitrac_e2e_bench - wrote " << output_csv_filename << std::endl;
+
+        if (num_failed_shots > 0) {
+            std::cerr << num_failed_shots << " shot(s) could not be replayed." << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+    catch (std::exception const& e) {
+        std::cerr << "pitrac_e2e_bench ERROR: " << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -101,10 +101,50 @@ namespace golf_sim {
 
         // We should later receive a handshake message back
 
+        // Build the shot-independent protocol messages now, while nothing is
+        // time-critical, rather than on the shot path
+        PrepareArmedShotMessages();
+
         return true;
     }
 
 
+    void GsE6Interface::PrepareArmedShotMessages() {
+
+        if (!club_data_message_.empty()) {
+            return;
+        }
+
+        // E6 requires SetClubData and SendShot messages along with the ball
+        // data.  We don't actually have club information, so the club data is
+        // all dummy values - the same bytes every shot.  Both messages are
+        // built here (at initialization/arm time) and just written to the
+        // socket when a shot comes through.
+
+        boost::property_tree::ptree root;
+        root.put("Type", "SetClubData");
+
+        boost::property_tree::ptree club_data_child;
+
+        // Create a dummy club data - we really don't have this information
+        // Head speed is feet per second
+        club_data_child.put("ClubHeadSpeed", GsResults::FormatDoubleAsString(0.0)); // (results.speed_mph_ / 3600.) * 5280.));
+        club_data_child.put("ClubAngleFace", GsResults::FormatDoubleAsString(0.0));
+        club_data_child.put("ClubAnglePath", GsResults::FormatDoubleAsString(0.0));
+        club_data_child.put("ClubHeadSpeedMPH", GsResults::FormatDoubleAsString(0.0));  // results.speed_mph_));
+
+        root.add_child("ClubData", club_data_child);
+
+        club_data_message_ = GsE6Results::GenerateStringFromJsonTree(root);
+
+        if (club_data_message_ == "") {
+            GS_LOG_MSG(warning, "GsE6Interface::PrepareArmedShotMessages created an empty club data message.");
+        }
+
+        send_shot_message_ = "{\"Type\":\"SendShot\"}";
+    }
+
+
     void GsE6Interface::DeInitialize() {
 
         // Send disconnect message to TruGolf before we finish up
@@ -117,11 +157,20 @@ namespace golf_sim {
 
 
     void GsE6Interface::SetSimSystemArmed(const bool is_armed) {
+
+        // Arming is the last quiet moment before a shot, so make sure the
+        // cached protocol messages are in place (outside the arming lock)
+        if (is_armed) {
+            PrepareArmedShotMessages();
+        }
+
         boost::lock_guard<boost::mutex> lock(sim_arming_mutex_);
 
         GS_LOG_TRACE_MSG(trace, "GsE6Interface::SetSimSystemArmed called.");
 
         sim_system_is_armed_ = is_armed;
+
+        InvalidateArmedStateCache();
     }
 
     bool GsE6Interface::GetSimSystemArmed() {
@@ -157,14 +206,21 @@ namespace golf_sim {
             }
         }
 
+        // Only the ball data depends on the shot.  The club data and SendShot
+        // messages were pre-built at arm time, so the work below is three
+        // socket writes (plus the pacing delays the protocol needs).
+        if (club_data_message_.empty()) {
+            PrepareArmedShotMessages();
+        }
+
         GsE6Results results(input_results);
 
         size_t write_length = -1;
 
-        std::string results_msg = results.Format();
+        results.FormatInto(ball_data_message_buffer_);
 
-        GS_LOG_MSG(info, "Sending E6 shot results message:\n" + results_msg);
-        write_length = SendSimMessage(results_msg);
+        GS_LOG_MSG(info, "Sending E6 shot results message:\n" + ball_data_message_buffer_);
+        write_length = SendSimMessage(ball_data_message_buffer_);
 
         if (write_length <= 0) {
             GS_LOG_MSG(error, "GsE6Interface::SendResults was not able to send Ball Data.");
@@ -175,28 +231,7 @@ namespace golf_sim {
         // Give E6 a moment to proces the earlier message
         usleep(kE6InterMessageDelayMs * 1000);
 
-        boost::property_tree::ptree root;
-        root.put("Type", "SetClubData");
-
-        // Create the three required children objects and add to the JSON root
-        boost::property_tree::ptree club_data_child;
-
-        // Create a dummy club data - we really don't have this information
-        // Head speed is feet per second
-        club_data_child.put("ClubHeadSpeed", GsResults::FormatDoubleAsString(0.0)); // (results.speed_mph_ / 3600.) * 5280.));
-        club_data_child.put("ClubAngleFace", GsResults::FormatDoubleAsString(0.0));
-        club_data_child.put("ClubAnglePath", GsResults::FormatDoubleAsString(0.0));
-        club_data_child.put("ClubHeadSpeedMPH", GsResults::FormatDoubleAsString(0.0));  // results.speed_mph_));
-
-        root.add_child("ClubData", club_data_child);
-
-        std::string club_data_message = GsE6Results::GenerateStringFromJsonTree(root);
-
-        if (club_data_message == "") {
-            GS_LOG_MSG(warning, "GsE6Results::Format() returning empty string.");
-        }
-
-        write_length = SendSimMessage(club_data_message);
+        write_length = SendSimMessage(club_data_message_);
 
         if (write_length <= 0) {
             GS_LOG_MSG(error, "GsE6Interface::SendResults was not able to send Club Data.");
@@ -206,19 +241,25 @@ namespace golf_sim {
         // ShotData
         usleep(kE6InterMessageDelayMs * 1000);
 
-        results_msg = "{\"Type\":\"SendShot\"}";
-
-        write_length = SendSimMessage(results_msg);
+        write_length = SendSimMessage(send_shot_message_);
 
         if (write_length <= 0) {
             GS_LOG_MSG(error, "GsE6Interface::SendResults was not able to send SendShot message.");
             return false;
         }
 
-        // If we successfully sent a shot, we assume that E6 is no longer armed
-        SetSimSystemArmed(false);
+        if (kRetainArmedStateAcrossShots) {
+            // E6 re-arms right after a shot in normal play, so keep the armed
+            // state and let the FSM go straight back to WaitingForBall.  A
+            // disarm message from E6 or a connection drop still clears it.
+            GS_LOG_TRACE_MSG(trace, "GsE6Interface::SendResults - retaining armed state across the shot.");
+        }
+        else {
+            // If we successfully sent a shot, we assume that E6 is no longer armed
+            SetSimSystemArmed(false);
+        }
 
-        GS_LOG_TRACE_MSG(trace, "Finished Sending E6 results input message:\n" + results.Format());
+        GS_LOG_TRACE_MSG(trace, "Finished Sending E6 results input message:\n" + ball_data_message_buffer_);
 
         return true;
     }
@@ -47,8 +47,21 @@ namespace golf_sim {
 
         virtual bool ProcessReceivedData(const std::string received_data);
 
+        // Builds (once) the protocol messages whose contents do not depend
+        // on the shot, so that sending a shot is just socket writes
+        void PrepareArmedShotMessages();
+
     protected:
         static long kE6InterMessageDelayMs;
+
+        // Pre-built at arm time.  The club data we send is all dummy values
+        // and the SendShot message is a constant, so neither needs to be
+        // re-serialized per shot.
+        std::string club_data_message_;
+        std::string send_shot_message_;
+
+        // Reused across shots so the ball-data serialization doesn't allocate
+        std::string ball_data_message_buffer_;
     };
 
 }
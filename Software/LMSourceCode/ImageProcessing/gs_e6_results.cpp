@@ -7,10 +7,10 @@
 // The PiTrac project is not endorsed, sponsored by or associated with TrueGolf products or services.
 
 
-#include <regex>
+#include <algorithm>
 #include <boost/program_options.hpp>
-#include <boost/property_tree/json_parser.hpp>
 
+#include "gs_format_lib.h"
 #include "logging_tools.h"
 
 #include "gs_e6_results.h"
@@ -34,45 +34,51 @@ namespace golf_sim {
 
 
     std::string GsE6Results::Format() const {
-        // Create a JSON object based on https://e6golf.com/E6ConnectV1.html
-        // Create a property tree object
-        boost::property_tree::ptree root;
 
-        // Create the three required children objects and add to the JSON root
-        boost::property_tree::ptree ball_data_child;
-        boost::property_tree::ptree club_data_child;
-        boost::property_tree::ptree shot_data_options_child;
-
-        // Root-level values
-        root.put("Type", "SetBallData");
-
-        // E6 Enforces certain ranges.  Make sure we do, too
-        int back_spin_rpm = std::min(back_spin_rpm_, 19999);
-        back_spin_rpm = std::max(back_spin_rpm_, -999);
+        std::string buffer;
+        FormatInto(buffer);
+        return buffer;
+    }
 
-        float speed_mph = std::min(speed_mph_, (float)249.9);
-        speed_mph = std::max(speed_mph_, (float)0.09);
 
-        int side_spin_rpm = std::min(side_spin_rpm_, 5999);
-        side_spin_rpm = std::max(side_spin_rpm_, -5999);
+    void GsE6Results::FormatInto(std::string& buffer) const {
+        // Create a JSON message based on https://e6golf.com/E6ConnectV1.html
+        //
+        // The message is serialized in a single pass.  The previous
+        // implementation built a property tree, pretty-printed it, and then
+        // regex-replaced the quoting that boost's JSON writer gets wrong -
+        // measurable work on every shot.
 
+        buffer.clear();
 
-        // Ball data - some of the values such as tilt are not required and we don't include them
-        ball_data_child.put("BackSpin", FormatDoubleAsString(back_spin_rpm_));
-        ball_data_child.put("BallSpeed", FormatDoubleAsString(speed_mph_));
-        ball_data_child.put("LaunchAngle", FormatDoubleAsString(vla_deg_));
-        ball_data_child.put("LaunchDirection", FormatDoubleAsString(hla_deg_));
-        ball_data_child.put("SideSpin", FormatDoubleAsString(side_spin_rpm_));
+        if (buffer.capacity() < 512) {
+            buffer.reserve(512);
+        }
 
-        root.add_child("BallData", ball_data_child);
+        // E6 Enforces certain ranges.  Make sure we do, too
+        int back_spin_rpm = std::clamp(back_spin_rpm_, -999, 19999);
 
-        std::string result = GenerateStringFromJsonTree(root);
+        float speed_mph = std::clamp(speed_mph_, (float)0.09, (float)249.9);
 
-        if (result == "") {
-            GS_LOG_MSG(warning, "GsE6Results::Format() returning empty string.");
-        }
+        int side_spin_rpm = std::clamp(side_spin_rpm_, -5999, 5999);
 
-        return result;
+        // Ball data - some of the values such as tilt are not required and we don't include them
+        buffer += GS_FORMATLIB_FORMAT(
+            "{{\n"
+            "    \"Type\": \"SetBallData\",\n"
+            "    \"BallData\": {{\n"
+            "        \"BackSpin\": {},\n"
+            "        \"BallSpeed\": {},\n"
+            "        \"LaunchAngle\": {},\n"
+            "        \"LaunchDirection\": {},\n"
+            "        \"SideSpin\": {}\n"
+            "    }}\n"
+            "}}\n",
+            FormatDoubleAsString(back_spin_rpm),
+            FormatDoubleAsString(speed_mph),
+            FormatDoubleAsString(vla_deg_),
+            FormatDoubleAsString(hla_deg_),
+            FormatDoubleAsString(side_spin_rpm));
     }
 
 }
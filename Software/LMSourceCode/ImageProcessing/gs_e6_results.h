@@ -26,6 +26,11 @@ namespace golf_sim {
         // Will enforce range limits
         virtual std::string Format() const;
 
+        // Serializes into buffer, which is cleared first.  Lets a caller
+        // reuse one buffer across shots instead of building a new string
+        // (and property tree) for each one.
+        virtual void FormatInto(std::string& buffer) const;
+
     };
 
 }
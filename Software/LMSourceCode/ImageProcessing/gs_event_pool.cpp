@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <algorithm>
+#include <new>
+
+#include <boost/lockfree/stack.hpp>
+
+#include "gs_events.h"
+
+#include "gs_event_pool.h"
+
+namespace golf_sim {
+
+    namespace {
+
+        // One block must be able to hold any of the event classes in the
+        // PossibleEvent list.  They are all small and fixed-size - the
+        // largest carry a GolfBall and/or a cv::Mat header (the Mat's pixel
+        // data is reference-counted and lives elsewhere).
+        constexpr std::size_t kEventBlockBytes = std::max({
+            sizeof(GolfSimEvent::BeginWaitingForSimulatorArmed),
+            sizeof(GolfSimEvent::SimulatorIsArmed),
+            sizeof(GolfSimEvent::BeginWaitingForBallPlaced),
+            sizeof(GolfSimEvent::CheckForBallStable),
+            sizeof(GolfSimEvent::BallStabilized),
+            sizeof(GolfSimEvent::BallHit),
+            sizeof(GolfSimEvent::ControlMessage),
+            sizeof(GolfSimEvent::BeginWatchingForBallHit),
+            sizeof(GolfSimEvent::FoundMultipleBalls),
+            sizeof(GolfSimEvent::ArmCamera2MessageReceived),
+            sizeof(GolfSimEvent::Camera2Triggered),
+            sizeof(GolfSimEvent::CheckForCam2ImageReceived),
+            sizeof(GolfSimEvent::Camera2ImageReceived),
+            sizeof(GolfSimEvent::Camera2PreImageReceived),
+            sizeof(GolfSimEvent::Exit),
+            sizeof(GolfSimEvent::Restart) });
+
+        // Each block starts with a header recording whether it belongs to the
+        // slab or was a heap fallback, so Free can route it back correctly.
+        // The header is padded to max alignment to keep the event storage
+        // behind it suitably aligned.
+        struct BlockHeader {
+            bool pooled;
+        };
+
+        constexpr std::size_t kHeaderBytes = alignof(std::max_align_t);
+
+        static_assert(sizeof(BlockHeader) <= kHeaderBytes,
+            "The block header must fit within its alignment padding");
+
+        char* NewRawBlock(std::size_t payload_bytes, bool pooled) {
+            char* raw_block = (char*)::operator new(kHeaderBytes + payload_bytes);
+            ((BlockHeader*)raw_block)->pooled = pooled;
+            return raw_block;
+        }
+
+        // The free list of slab blocks.  fixed_sized keeps the stack's own
+        // nodes pre-allocated, so push/pop never touch the heap.  The slab
+        // blocks are created up front, which is also why push-on-free can
+        // never find the stack full.  Built on first use (thread-safe per
+        // C++11 static initialization) and deliberately never destroyed -
+        // events can be in flight until the very end of the process.
+        boost::lockfree::stack<char*, boost::lockfree::fixed_sized<true>>& FreeBlocks() {
+
+            static auto* free_blocks = []() {
+                auto* stack = new boost::lockfree::stack<char*, boost::lockfree::fixed_sized<true>>(GsEventPool::kEventPoolSize);
+
+                for (int i = 0; i < GsEventPool::kEventPoolSize; i++) {
+                    stack->push(NewRawBlock(kEventBlockBytes, true));
+                }
+
+                return stack;
+            }();
+
+            return *free_blocks;
+        }
+
+    }
+
+    void* GsEventPool::Allocate(std::size_t size) {
+
+        if (size <= kEventBlockBytes) {
+            char* raw_block = nullptr;
+
+            if (FreeBlocks().pop(raw_block)) {
+                return raw_block + kHeaderBytes;
+            }
+
+            // Slab momentarily exhausted - fall through to the heap
+        }
+
+        return NewRawBlock(size, false) + kHeaderBytes;
+    }
+
+    void GsEventPool::Free(void* block) {
+
+        if (block == nullptr) {
+            return;
+        }
+
+        char* raw_block = (char*)block - kHeaderBytes;
+
+        if (((BlockHeader*)raw_block)->pooled) {
+            FreeBlocks().push(raw_block);
+        }
+        else {
+            ::operator delete(raw_block);
+        }
+    }
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
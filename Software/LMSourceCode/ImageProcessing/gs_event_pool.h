@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// A slab of fixed-size blocks for the FSM event objects, recycled through a
+// lock-free free list.  The event system queues and frees small event objects
+// at tick rate for the life of the process; drawing them from this pool
+// instead of the general-purpose heap makes the steady-state event traffic
+// allocation-free.
+
+#pragma once
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <cstddef>
+
+namespace golf_sim {
+
+    class GsEventPool {
+
+    public:
+
+        // Number of event-sized blocks in the slab.  Events live only from
+        // QueueEvent to the end of their FSM dispatch, so the number in
+        // flight is bounded by the event queue depth
+        // (GolfSimEventQueue::kMaxQueueSize) plus the few being constructed
+        // or drained at any moment.
+        static constexpr int kEventPoolSize = 64;
+
+        // Returns storage for one event.  Served from the free list when a
+        // block is available and the request fits an event-sized block;
+        // otherwise falls back to the heap (the block remembers which, so
+        // Free routes it correctly either way).
+        static void* Allocate(std::size_t size);
+
+        // Returns the block to the free list (or the heap, for fallback
+        // allocations).  Safe to call from any thread.
+        static void Free(void* block);
+    };
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
@@ -7,19 +7,32 @@
 // types of events that occur in the launch monitor system.
 
 #include "gs_events.h"
-#include "logging_tools.h" 
+#include "gs_event_pool.h"
+#include "logging_tools.h"
 
 #ifdef __unix__  // Ignore in Windows environment
 
 
 namespace golf_sim {
 
+    void* GolfSimEventBase::operator new(std::size_t size) {
+        return GsEventPool::Allocate(size);
+    }
+
+    void GolfSimEventBase::operator delete(void* block) {
+        GsEventPool::Free(block);
+    }
+
 	// boost::lockfree::queue<GolfSimEventElement, boost::lockfree::capacity<GolfSimEventQueue::kMaxQueueSize>> GolfSimEventQueue::queue_;
-    queue<GolfSimEventElement> GolfSimEventQueue::queue_(GolfSimEventQueue::kMaxQueueSize);
+    two_lane_mpsc_queue<GolfSimEventElement> GolfSimEventQueue::queue_(GolfSimEventQueue::kMaxQueueSize);
     int GolfSimEventQueue::queue_size_ = 0;
 
 	bool GolfSimEventQueue::QueueEvent(GolfSimEventElement& event) {
-		queue_.push(std::move(event));
+        // Determine the lane before the move - afterward the element's event
+        // pointer belongs to the queue.
+        bool shot_critical = EventIsShotCritical(event.e_);
+
+		queue_.push(std::move(event), shot_critical);
         queue_size_++;
         return true;
 	}
@@ -44,7 +57,15 @@ namespace golf_sim {
         return (dynamic_cast<GolfSimEvent::ControlMessage*>(event) != nullptr);
     }
 
+    bool GolfSimEventQueue::EventIsShotCritical(GolfSimEventBase* event) {
+        return (dynamic_cast<GolfSimEvent::BallHit*>(event) != nullptr ||
+                dynamic_cast<GolfSimEvent::Camera2Triggered*>(event) != nullptr ||
+                dynamic_cast<GolfSimEvent::Camera2ImageReceived*>(event) != nullptr);
+    }
+
     // Down-cast a specific derived event type into the PossibleEvent variant type
+    // The event's payload (images, ball data) is moved into the variant, not
+    // copied - the caller deletes the (now-drained) event object afterward.
     // TBD - Seems really clunky - how to improve?
     PossibleEvent GolfSimEventQueue::ConvertEventToPossibleEvent(GolfSimEventBase *event) {
         PossibleEvent possible_event;
@@ -52,7 +73,6 @@ namespace golf_sim {
         GolfSimEvent::BeginWaitingForBallPlaced* beginWaitingForBallPlaced = nullptr;
         GolfSimEvent::SimulatorIsArmed* simulatorIsArmed = nullptr;
         GolfSimEvent::BeginWaitingForSimulatorArmed* beginWaitingForSimulatorArmed = nullptr;
-        GolfSimEvent::EventLoopTick* eventLoopTick = nullptr;
         GolfSimEvent::BallStabilized* ballStabilized = nullptr;
         GolfSimEvent::BallHit* ballHit = nullptr;
         GolfSimEvent::ControlMessage* controlMessage = nullptr;
@@ -69,55 +89,52 @@ namespace golf_sim {
 
 
         if ((beginWaitingForSimulatorArmed = dynamic_cast<GolfSimEvent::BeginWaitingForSimulatorArmed*>(event))) {
-            possible_event = *beginWaitingForSimulatorArmed;
+            possible_event = std::move(*beginWaitingForSimulatorArmed);
         }
         else if ((simulatorIsArmed = dynamic_cast<GolfSimEvent::SimulatorIsArmed*>(event))) {
-            possible_event = *simulatorIsArmed;
+            possible_event = std::move(*simulatorIsArmed);
         }
         else if ((beginWaitingForBallPlaced = dynamic_cast<GolfSimEvent::BeginWaitingForBallPlaced*>(event))) {
-            possible_event = *beginWaitingForBallPlaced;
-        }
-        else if ((eventLoopTick = dynamic_cast<GolfSimEvent::EventLoopTick*>(event))) {
-            possible_event = *eventLoopTick;
+            possible_event = std::move(*beginWaitingForBallPlaced);
         }
         else if ((ballStabilized = dynamic_cast<GolfSimEvent::BallStabilized*>(event))) {
-            possible_event = *ballStabilized;
+            possible_event = std::move(*ballStabilized);
         }
         else if ((ballHit = dynamic_cast<GolfSimEvent::BallHit*>(event))) {
-            possible_event = *ballHit;
+            possible_event = std::move(*ballHit);
         }
         else if ((controlMessage = dynamic_cast<GolfSimEvent::ControlMessage*>(event))) {
-            possible_event = *controlMessage;
+            possible_event = std::move(*controlMessage);
         }
         else if ((beginWatchingForBallHit = dynamic_cast<GolfSimEvent::BeginWatchingForBallHit*>(event))) {
-            possible_event = *beginWatchingForBallHit;
+            possible_event = std::move(*beginWatchingForBallHit);
         }
         else if ((foundMultipleBalls = dynamic_cast<GolfSimEvent::FoundMultipleBalls*>(event))) {
-            possible_event = *foundMultipleBalls;
+            possible_event = std::move(*foundMultipleBalls);
         }
         else if ((cam2Triggered = dynamic_cast<GolfSimEvent::Camera2Triggered*>(event))) {
-            possible_event = *cam2Triggered;
+            possible_event = std::move(*cam2Triggered);
         }
         else if ((cam2ImageReceived = dynamic_cast<GolfSimEvent::Camera2ImageReceived*>(event))) {
-            possible_event = *cam2ImageReceived;
+            possible_event = std::move(*cam2ImageReceived);
         }
         else if ((cam2PreImageReceived = dynamic_cast<GolfSimEvent::Camera2PreImageReceived*>(event))) {
-            possible_event = *cam2PreImageReceived;
+            possible_event = std::move(*cam2PreImageReceived);
         }
         else if ((checkForCam2ImageReceived = dynamic_cast<GolfSimEvent::CheckForCam2ImageReceived*>(event))) {
-            possible_event = *checkForCam2ImageReceived;
+            possible_event = std::move(*checkForCam2ImageReceived);
         }
         else if ((armCamera2MessageReceived = dynamic_cast<GolfSimEvent::ArmCamera2MessageReceived*>(event))) {
-            possible_event = *armCamera2MessageReceived;
+            possible_event = std::move(*armCamera2MessageReceived);
         }
         else if ((restart = dynamic_cast<GolfSimEvent::Restart*>(event))) {
-            possible_event = *restart;
+            possible_event = std::move(*restart);
         }
         else if ((exit = dynamic_cast<GolfSimEvent::Exit*>(event))) {
-            possible_event = *exit;
+            possible_event = std::move(*exit);
         }
         else if ((checkForBallStable = dynamic_cast<GolfSimEvent::CheckForBallStable*>(event))) {
-            possible_event = *checkForBallStable;
+            possible_event = std::move(*checkForBallStable);
         }
         else {
             GS_LOG_MSG(error, "ConvertEventToPossibleEvent could not cast to PossibleEvent variant type");
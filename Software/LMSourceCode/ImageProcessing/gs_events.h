@@ -32,19 +32,17 @@ namespace golf_sim {
         virtual ~GolfSimEventBase() {};
 
         virtual std::string Format() { return "GolfSimEventBase - Should have been overridden"; };
+
+        // Events are small, fixed-size objects allocated at tick rate for the
+        // life of the process, so their storage comes from GsEventPool's
+        // lock-free free list instead of the general-purpose heap.  Inherited
+        // by all of the event classes below.
+        static void* operator new(std::size_t size);
+        static void operator delete(void* block);
     };
 
     namespace GolfSimEvent {
 
-        class EventLoopTick : public GolfSimEventBase
-        {
-        public:
-            EventLoopTick() {};
-            ~EventLoopTick() {};
-
-            virtual std::string Format() override { return "EventLoopTick"; };
-        };
-
         class BeginWatchingForBallHit : public GolfSimEventBase
         {
         public:
@@ -225,8 +223,7 @@ namespace golf_sim {
 
     }
 
-    using PossibleEvent = std::variant< GolfSimEvent::EventLoopTick, 
-                                        GolfSimEvent::BeginWaitingForSimulatorArmed,
+    using PossibleEvent = std::variant< GolfSimEvent::BeginWaitingForSimulatorArmed,
                                         GolfSimEvent::SimulatorIsArmed,
                                         GolfSimEvent::BeginWaitingForBallPlaced,
                                         GolfSimEvent::CheckForBallStable, 
@@ -280,11 +277,17 @@ namespace golf_sim {
 
         static bool EventIsControlEvent(GolfSimEventBase* event);
 
+        // Shot-critical events go into the queue's high-priority lane so that
+        // they are never stuck behind status chatter.
+        static bool EventIsShotCritical(GolfSimEventBase* event);
+
         // Not thread safe
         static int GetQueueLength();
 
         // static boost::lockfree::queue<GolfSimEventElement, boost::lockfree::capacity<kMaxQueueSize>> queue_;
-        static queue<GolfSimEventElement> queue_;
+        // Lock-free on the push side - the camera completion handler and the
+        // IPC consumer thread both queue events from latency-sensitive code.
+        static two_lane_mpsc_queue<GolfSimEventElement> queue_;
 
         static int queue_size_;
     };
@@ -0,0 +1,171 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <deque>
+#include <fstream>
+#include <mutex>
+
+#include "logging_tools.h"
+#include "gs_raw_frame.h"
+
+#include "gs_flight_recorder.h"
+
+namespace golf_sim {
+
+    bool GsFlightRecorder::kEnableFlightRecorder = false;
+    int GsFlightRecorder::kMaxRecordedImages = 12;
+    int GsFlightRecorder::kMinAcceptableConfidence = 0;
+    bool GsFlightRecorder::kDumpImagesAsRawFrames = false;
+
+    namespace {
+
+        struct RecordedImage {
+            std::string tag;
+            cv::Mat img;
+        };
+
+        struct RecordedText {
+            std::string tag;
+            std::string text;
+        };
+
+        // The text artifacts are small, so the cap is just a backstop
+        const size_t kMaxRecordedTexts = 32;
+
+        std::mutex recorder_mutex_;
+        std::deque<RecordedImage> recorded_images_;
+        std::deque<RecordedText> recorded_texts_;
+
+        // Used to give the dumped artifacts per-shot unique names
+        int recorder_shot_number_ = 0;
+    }
+
+
+    void GsFlightRecorder::StartShot() {
+
+        if (!kEnableFlightRecorder) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(recorder_mutex_);
+
+        recorded_images_.clear();
+        recorded_texts_.clear();
+        recorder_shot_number_++;
+    }
+
+
+    void GsFlightRecorder::RecordImage(const std::string& tag, const cv::Mat& img) {
+
+        if (!kEnableFlightRecorder || img.empty()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(recorder_mutex_);
+
+        if (recorded_images_.size() >= (size_t)kMaxRecordedImages) {
+            recorded_images_.pop_front();
+        }
+
+        // A cv::Mat copy is a shallow, refcounted reference - no pixels move
+        recorded_images_.push_back(RecordedImage{ tag, img });
+    }
+
+
+    void GsFlightRecorder::RecordText(const std::string& tag, const std::string& text) {
+
+        if (!kEnableFlightRecorder || text.empty()) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(recorder_mutex_);
+
+        if (recorded_texts_.size() >= kMaxRecordedTexts) {
+            recorded_texts_.pop_front();
+        }
+
+        recorded_texts_.push_back(RecordedText{ tag, text });
+    }
+
+
+    void GsFlightRecorder::FinishShot(int confidence) {
+
+        if (!kEnableFlightRecorder) {
+            return;
+        }
+
+        if (kMinAcceptableConfidence > 0 && confidence <= kMinAcceptableConfidence) {
+            DumpShot("confidence " + std::to_string(confidence) + " was at or below the threshold of " + std::to_string(kMinAcceptableConfidence));
+            return;
+        }
+
+        // The shot was good - just let the retained artifacts go
+        std::lock_guard<std::mutex> lock(recorder_mutex_);
+        recorded_images_.clear();
+        recorded_texts_.clear();
+    }
+
+
+    void GsFlightRecorder::DumpShot(const std::string& reason) {
+
+        if (!kEnableFlightRecorder) {
+            return;
+        }
+
+        std::deque<RecordedImage> images;
+        std::deque<RecordedText> texts;
+        int shot_number;
+
+        // Take the retained artifacts out from under the lock so that the
+        // (slow) writes below do not block any concurrent recording
+        {
+            std::lock_guard<std::mutex> lock(recorder_mutex_);
+            images.swap(recorded_images_);
+            texts.swap(recorded_texts_);
+            shot_number = recorder_shot_number_;
+        }
+
+        if (images.empty() && texts.empty()) {
+            GS_LOG_MSG(warning, "GsFlightRecorder::DumpShot (" + reason + ") - nothing was recorded for the shot.");
+            return;
+        }
+
+        GS_LOG_MSG(info, "GsFlightRecorder::DumpShot - writing shot " + std::to_string(shot_number) + " diagnostics because: " + reason);
+
+        std::string shot_prefix = "flight_recorder_shot_" + std::to_string(shot_number) + "_";
+
+        int i = 0;
+        for (auto& recorded : images) {
+            if (kDumpImagesAsRawFrames) {
+                std::string fname = LoggingTools::kBaseImageLoggingDir + shot_prefix +
+                    std::to_string(i) + "_" + recorded.tag + GsRawFrame::kRawFrameExtension;
+                GsRawFrame::Write(fname, recorded.img);
+            }
+            else {
+                LoggingTools::LogImage(shot_prefix + std::to_string(i) + "_" + recorded.tag + "_", recorded.img, std::vector<cv::Point>{});
+            }
+            i++;
+        }
+
+        if (!texts.empty()) {
+
+            std::string fname = LoggingTools::kBaseImageLoggingDir + shot_prefix + "diagnostics.txt";
+
+            std::ofstream text_file(fname, std::ios::trunc);
+
+            if (!text_file) {
+                GS_LOG_MSG(warning, "GsFlightRecorder::DumpShot - could not write to file name: " + fname);
+                return;
+            }
+
+            text_file << "Flight-recorder dump for shot " << shot_number << ".  Reason: " << reason << "\n\n";
+
+            for (auto& recorded : texts) {
+                text_file << "===== " << recorded.tag << " =====\n" << recorded.text << "\n\n";
+            }
+        }
+    }
+
+}
@@ -0,0 +1,65 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// A flight recorder for shot diagnostics.  Intermediate artifacts from the
+// shot analysis (preprocessed images, circle-candidate lists, spin score
+// tables) are retained in a bounded in-memory ring while a shot is being
+// processed.  Nothing touches the disk unless the shot is flagged as bad -
+// either automatically (low confidence or a failed analysis) or by the user
+// from the GUI.  That way full diagnostics are available for a mis-read
+// without paying the throughput and SD-card cost of always-on image logging.
+
+#pragma once
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+    class GsFlightRecorder {
+
+    public:
+
+        // Off by default.  When off, the Record* calls return immediately.
+        static bool kEnableFlightRecorder;
+
+        // Maximum number of intermediate images retained per shot.  Oldest
+        // is dropped first when the ring is full.
+        static int kMaxRecordedImages;
+
+        // A shot whose confidence is at or below this value is dumped
+        // automatically.  0 disables the automatic dump (the user can still
+        // trigger one from the GUI).
+        static int kMinAcceptableConfidence;
+
+        // When set, dumped images are written as raw (.gsraw) frame files
+        // instead of PNGs.  Raw frames skip the PNG encode here and the
+        // decode in downstream corpus/regression runs.
+        static bool kDumpImagesAsRawFrames;
+
+        // Forgets everything retained for the prior shot and starts
+        // recording the next one
+        static void StartShot();
+
+        // Retains a shallow (refcounted) reference to an intermediate image
+        // under the given tag - no pixel copy is made
+        static void RecordImage(const std::string& tag, const cv::Mat& img);
+
+        // Retains a block of diagnostic text (e.g., a circle-candidate list
+        // or a spin score table) under the given tag
+        static void RecordText(const std::string& tag, const std::string& text);
+
+        // Called when the shot's results have been determined.  Dumps the
+        // recording if the confidence is at or below kMinAcceptableConfidence,
+        // and otherwise just clears it - a good shot costs no I/O.
+        static void FinishShot(int confidence);
+
+        // Writes everything retained for the current shot to the image
+        // logging directory and then clears the recording
+        static void DumpShot(const std::string& reason);
+    };
+
+}
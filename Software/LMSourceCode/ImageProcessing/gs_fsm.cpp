@@ -8,6 +8,10 @@
 #ifdef __unix__  // Ignore in Windows environment
 
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <variant>
 #include <thread>
 #include "gs_format_lib.h"
@@ -32,6 +36,17 @@
 #include "libcamera_interface.h"
 
 #include "gs_fsm.h"
+#include "gs_fsm_tracer.h"
+#include "gs_shot_trace.h"
+#include "gs_shot_telemetry.h"
+#include "gs_session_stats.h"
+#include "gs_cam2_predetect.h"
+#include "gs_flight_recorder.h"
+#include "gs_mat_pool_allocator.h"
+#include "gs_warm_restart.h"
+#include "gs_clock_sync.h"
+#include "gs_thermal_governor.h"
+#include "gs_web_api.h"
 
 
 namespace golf_sim {
@@ -59,8 +74,14 @@ namespace golf_sim {
         template<class... Ts> struct overload : Ts... { using Ts::operator()...; };
     }
 
-    TimedCallbackThread* BallStabilizationCheckTimerThread = nullptr;
-    TimedCallbackThread* ReceivedCam2ImageCheckTimerThread = nullptr;
+    // All of the FSM's deadline timers run on this single service thread.
+    // Scheduling is exact (the service sleeps until the earliest deadline)
+    // and a timer that is no longer wanted is cancelled on state transition
+    // instead of firing into the wrong state.
+    TimerWheelThread* FsmTimerService = nullptr;
+
+    long BallStabilizationTimerId = 0;
+    long ReceivedCam2ImageTimerId = 0;
 
 
     void queueBallStabilizationCheck() {
@@ -81,12 +102,12 @@ namespace golf_sim {
     void setupBallStabilizationCheckTimer() {
 
         GS_LOG_TRACE_MSG(trace, "setupBallStabilizationCheckTimer.");
-        // queueBallStabilizationCheck();
 
-        if (BallStabilizationCheckTimerThread == nullptr) {
-            BallStabilizationCheckTimerThread = new TimedCallbackThread("BallStabilizationCheckTimerThread", kBallStabilizationTime * 1000, queueBallStabilizationCheck);
-            BallStabilizationCheckTimerThread->CreateThread();
+        if (FsmTimerService == nullptr) {
+            FsmTimerService = new TimerWheelThread("FsmTimerServiceThread");
         }
+
+        BallStabilizationTimerId = FsmTimerService->ScheduleTimer(kBallStabilizationTime * 1000, queueBallStabilizationCheck);
     }
 
 
@@ -109,10 +130,11 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "setupCam2ImageReceivedCheckTimer - Setting call back for " + std::to_string(kMaxCam2ImageReceivedTimeMs) + " milliseconds.");
 
-        if (ReceivedCam2ImageCheckTimerThread == nullptr) {
-            ReceivedCam2ImageCheckTimerThread = new TimedCallbackThread("setupCam2ImageReceivedCheckTimerThread", kMaxCam2ImageReceivedTimeMs * 1000, queueCam2ImageReceivedCheck);
-            ReceivedCam2ImageCheckTimerThread->CreateThread();
+        if (FsmTimerService == nullptr) {
+            FsmTimerService = new TimerWheelThread("FsmTimerServiceThread");
         }
+
+        ReceivedCam2ImageTimerId = FsmTimerService->ScheduleTimer(kMaxCam2ImageReceivedTimeMs, queueCam2ImageReceivedCheck);
     }
 
 
@@ -237,7 +259,7 @@ namespace golf_sim {
 
     /*********** WaitingForBallStabilization ************/
 
-    GolfSimState onEvent(const state::WaitingForBallStabilization& waitingForBallStabilization,
+    GolfSimState onEvent(state::WaitingForBallStabilization& waitingForBallStabilization,
         const GolfSimEvent::CheckForBallStable& CheckForBallStableEvent) {
 
         GS_LOG_MSG(debug, "GolfSim state transition: WaitingForBallStabilization - Received CheckForBallStableEvent ");
@@ -249,12 +271,8 @@ namespace golf_sim {
         // LoggingTools::LogImage("", img, std::vector < cv::Point >{}, true, "log_last_ball_2bcompared2_still.png");
 
 
-        // We were called by a timer in a separate thread.  Clean up that thread
-        if (BallStabilizationCheckTimerThread != nullptr) {
-            BallStabilizationCheckTimerThread->ExitThread();
-            delete BallStabilizationCheckTimerThread;
-            BallStabilizationCheckTimerThread = nullptr;
-        }
+        // The timer that queued this event was one-shot - nothing to clean up.
+        BallStabilizationTimerId = 0;
 
         bool ballMoved = true;
 
@@ -327,9 +345,10 @@ namespace golf_sim {
             GolfSimEventQueue::QueueEvent(beginWatchingForBallHit);
 
             cv::Mat empty_mat;
+            // The outgoing state is dead after this return - move its payload
             return state::WaitingForBallHit{ std::chrono::steady_clock::now(),
-                                             waitingForBallStabilization.cam1_ball_,
-                                             waitingForBallStabilization.ball_image_,
+                                             std::move(waitingForBallStabilization.cam1_ball_),
+                                             std::move(waitingForBallStabilization.ball_image_),
                                              empty_mat };
 
         }
@@ -337,7 +356,7 @@ namespace golf_sim {
 
 
     /*********** WaitingForCamera2PreImage ************/
-    GolfSimState onEvent(const state::WaitingForCamera2PreImage& waitingForCamera2PreImage,
+    GolfSimState onEvent(state::WaitingForCamera2PreImage& waitingForCamera2PreImage,
         const GolfSimEvent::Camera2PreImageReceived& camera2PreImageReceived) {
         GS_LOG_MSG(debug, "GolfSim state transition: WaitingForCamera2PreImage - Received Camera2PreImageReceived.");
 
@@ -346,8 +365,8 @@ namespace golf_sim {
         GolfSimEventQueue::QueueEvent(beginWatchingForBallHit);
 
         return state::WaitingForBallHit{ std::chrono::steady_clock::now(),
-                                         waitingForCamera2PreImage.cam1_ball_,
-                                         waitingForCamera2PreImage.ball_image_,
+                                         std::move(waitingForCamera2PreImage.cam1_ball_),
+                                         std::move(waitingForCamera2PreImage.ball_image_),
                                          camera2PreImageReceived.GetBallFlightPreImage() };
     }
 
@@ -398,7 +417,7 @@ namespace golf_sim {
 
     /*********** WaitingForBallHit ************/
 
-    GolfSimState onEvent(const state::WaitingForBallHit& waitingForBallHit,
+    GolfSimState onEvent(state::WaitingForBallHit& waitingForBallHit,
         const GolfSimEvent::BeginWatchingForBallHit& beginWatchingForBallHit) {
         GS_LOG_MSG(debug, "GolfSim state transition: WaitingForBallHit - Received BeginWatchingForBallHit.");
 
@@ -420,59 +439,105 @@ namespace golf_sim {
             return state::InitializingCamera1System{};
         }
 
+        // The hit starts a new shot - allocate the trace ID that will tag
+        // this shot's log lines, IPC messages and journal entry on both Pis
+        GsShotTrace::BeginShotTrace();
+
+        // Snapshot the process's memory state so the shot's results can
+        // report how much this shot cost (if configured)
+        GsShotTelemetry::BeginShot();
+
         // TBD - Consider case where we did NOT get a ball hit indication for some reason
         GS_LOG_MSG(info, "============= BALL HIT ===============\n");
 
         // Make sure we do something sensible if we don't receive an image from the camera 2
         // system in a reasonable amount of time.
-        // TBD - How to turn the check off when we DO get an image?
+        // The Camera2ImageReceived handler cancels this timer if the image
+        // does show up in time.
         setupCam2ImageReceivedCheckTimer();
 
-        // Start waiting for the camera 2 image to returned. 
-        // TBD - Should probably start timer to make sure we get an image soon.
-        return state::BallHitNowWaitingForCam2Image{ waitingForBallHit.cam1_ball_, waitingForBallHit.ball_image_, waitingForBallHit.camera2_pre_image_ };
+        // Start waiting for the camera 2 image to returned.
+        return state::BallHitNowWaitingForCam2Image{ std::move(waitingForBallHit.cam1_ball_),
+                                                     std::move(waitingForBallHit.ball_image_),
+                                                     std::move(waitingForBallHit.camera2_pre_image_) };
     }
 
-    GolfSimState onEvent(const state::WaitingForBallHit& waitingForBallHit,
+    GolfSimState onEvent(state::WaitingForBallHit& waitingForBallHit,
         const GolfSimEvent::BallHit& ballHit) {
         GS_LOG_MSG(debug, "GolfSim state transition: WaitingForBallHit - Received BallHit ");
 
         // TBD - Perform state transition processing here
 
-        return state::BallHitNowWaitingForCam2Image{ waitingForBallHit.cam1_ball_, waitingForBallHit.ball_image_, waitingForBallHit.camera2_pre_image_ };
+        return state::BallHitNowWaitingForCam2Image{ std::move(waitingForBallHit.cam1_ball_),
+                                                     std::move(waitingForBallHit.ball_image_),
+                                                     std::move(waitingForBallHit.camera2_pre_image_) };
     }
 
     /*********** BallHitNowWaitingForCam2Image ************/
 
-    GolfSimState onEvent(const state::BallHitNowWaitingForCam2Image& BallHitNowWaitingForCam2Image,
-        const GolfSimEvent::Camera2ImageReceived& cam2ImageReceived) {
-        GS_LOG_MSG(debug, "GolfSim state transition: BallHitNowWaitingForCam2Image - Received Camera2ImageReceived ");
+    // Analyses running behind the watching FSM when overlapped shot
+    // processing is enabled.  Bounded by GolfSimCamera::kMaxInFlightShots.
+    static std::atomic<int> in_flight_shot_count_ = 0;
 
-        // TBD - Perform state transition processing here
-        // Most importantly, all of the hit analysis!
+    // The complete per-shot analysis and result delivery, from the strobed
+    // camera-2 image to the sim/GUI sends.  Runs on the FSM thread in the
+    // classic flow, or on a pool worker when overlapped shot processing has
+    // re-armed ball watching for the next golfer.  The Mats share the
+    // captured pixel data - nothing mutates them once the shot is over.
+    static void ProcessCam2ImageAndDeliverResults(const cv::Mat& ball_image,
+                                                  const cv::Mat& cam2_mat,
+                                                  const cv::Mat& camera2_pre_image) {
 
-        const cv::Mat& cam2_mat = cam2ImageReceived.GetBallFlightImage();
+        // The analysis below records its intermediate artifacts (if the
+        // flight recorder is enabled), so isolate this shot's recording
+        GsFlightRecorder::StartShot();
 
         GolfBall result_ball;
         cv::Vec3d rotation_results;
         cv::Mat exposures_image;
         std::vector<GolfBall> exposure_balls;
 
-        if (!GolfSimCamera::ProcessReceivedCam2Image(BallHitNowWaitingForCam2Image.ball_image_,
-                                                    cam2_mat,
-                                                    BallHitNowWaitingForCam2Image.camera2_pre_image_,
-                                                    result_ball,
-                                                    rotation_results,
-                                                    exposures_image,
-                                                    exposure_balls)) {
+        cv::Mat analysis_mat = cam2_mat;
+
+        bool processed = GolfSimCamera::ProcessReceivedCam2Image(ball_image,
+                                                                analysis_mat,
+                                                                camera2_pre_image,
+                                                                result_ball,
+                                                                rotation_results,
+                                                                exposures_image,
+                                                                exposure_balls);
+
+        // If the camera-2 system shipped an ROI-reduced frame and its
+        // candidates did not pan out, ask for the retained full frame and
+        // search it once more before declaring the shot lost (see
+        // GsCam2PreDetect)
+        if (!processed && GsCam2PreDetect::LastFrameWasRoiReduced()) {
+
+            cv::Mat full_frame;
+
+            if (GsCam2PreDetect::RequestAndAwaitFullFrame(full_frame)) {
+                analysis_mat = full_frame;
+                processed = GolfSimCamera::ProcessReceivedCam2Image(ball_image,
+                                                                    analysis_mat,
+                                                                    camera2_pre_image,
+                                                                    result_ball,
+                                                                    rotation_results,
+                                                                    exposures_image,
+                                                                    exposure_balls);
+            }
+        }
+
+        if (!processed) {
             GS_LOG_MSG(error, "GolfSim FSM could not ProcessReceivedCam2Image.");
-#ifdef __unix__ 
+#ifdef __unix__
             // Give the webserver UI something to show the user
-            GsUISystem::SaveWebserverImage(GsUISystem::kWebServerErrorExposuresImage, cam2_mat);
+            GsUISystem::SaveWebserverImage(GsUISystem::kWebServerErrorExposuresImage, analysis_mat);
 #endif
 
             GsUISystem::SendIPCErrorStatusMessage("GolfSim FSM could not ProcessReceivedCam2Image.");
 
+            GsFlightRecorder::DumpShot("could not ProcessReceivedCam2Image");
+
             GS_LOG_MSG(info, "BALL_HIT_CSV, " + std::to_string(GsSimInterface::GetShotCounter()) + ", (carry - Error), (Total - Error), (Side Dest - Error), (Smash Factor - Error), (Club Speed - Error), "
                 + std::to_string(0) + ", "
                 + std::to_string(0) + ", "
@@ -504,7 +569,15 @@ namespace golf_sim {
 
             GsUISystem::SendIPCHitMessage(result_ball, s);
 
-#ifdef __unix__ 
+            // The results are out the door - if transition tracing is on,
+            // summarize where the time went between the hit and now.
+            GsFsmTracer::ReportShotSummary();
+
+            // TBD - Pass the real confidence through once the analysis
+            // computes one (it is currently pegged at 5 in the hit message)
+            GsFlightRecorder::FinishShot(5);
+
+#ifdef __unix__
             if (exposures_image.empty()) {
                 GS_LOG_MSG(warning, "Exposures_image from ProcessReceivedCamera2 was empty.");
             }
@@ -514,6 +587,56 @@ namespace golf_sim {
 
         }
 
+        // The shot is over - drain the asynchronous log sink so the log file
+        // is complete (and any dropped-record count is reported) before the
+        // system starts waiting for the next ball
+        LoggingTools::FlushLogSink();
+    }
+
+    GolfSimState onEvent(const state::BallHitNowWaitingForCam2Image& BallHitNowWaitingForCam2Image,
+        const GolfSimEvent::Camera2ImageReceived& cam2ImageReceived) {
+        GS_LOG_MSG(debug, "GolfSim state transition: BallHitNowWaitingForCam2Image - Received Camera2ImageReceived ");
+
+        // The image showed up, so the did-the-image-arrive timeout is moot.
+        if (FsmTimerService != nullptr && ReceivedCam2ImageTimerId != 0) {
+            FsmTimerService->CancelTimer(ReceivedCam2ImageTimerId);
+            ReceivedCam2ImageTimerId = 0;
+        }
+
+        // All of the strobed evidence is now safely in hand - cv::Mat header
+        // copies keep the pixel data alive after this state is discarded
+        cv::Mat ball_image = BallHitNowWaitingForCam2Image.ball_image_;
+        cv::Mat cam2_mat = cam2ImageReceived.GetBallFlightImage();
+        cv::Mat camera2_pre_image = BallHitNowWaitingForCam2Image.camera2_pre_image_;
+
+        if (GolfSimCamera::kUseOverlappedShotProcessing &&
+            in_flight_shot_count_.load() < GolfSimCamera::kMaxInFlightShots) {
+
+            // Hand the analysis to a pool worker and re-arm ball watching
+            // right away - a golfer who quickly re-tees is seen immediately
+            // instead of hitting into a blind system.  The captured shot
+            // number rides along, pinned on the worker, because the live
+            // counter will advance as soon as the next ball stabilizes.
+            in_flight_shot_count_++;
+
+            long shot_number = GsSimInterface::GetShotCounter();
+
+            GsTaskPool::PostTask("gs_fsm.overlapped_shot",
+                [ball_image, cam2_mat, camera2_pre_image, shot_number]() {
+                    GsSimInterface::PinShotNumberForThread(shot_number);
+                    ProcessCam2ImageAndDeliverResults(ball_image, cam2_mat, camera2_pre_image);
+                    GsSimInterface::PinShotNumberForThread(0);
+                    in_flight_shot_count_--;
+                },
+                GsTaskPriority::kShotCritical);
+        }
+        else {
+            // Classic flow (and the fallback once the in-flight bound is
+            // reached) - the FSM goes back to watching only when this
+            // shot's analysis and delivery are done
+            ProcessCam2ImageAndDeliverResults(ball_image, cam2_mat, camera2_pre_image);
+        }
+
         // Setup to go through the whole sequence again
         GolfSimEventElement beginWaitingForBallPlacedEvent{ new GolfSimEvent::BeginWaitingForBallPlaced{ } };
         GolfSimEventQueue::QueueEvent(beginWaitingForBallPlacedEvent);
@@ -528,6 +651,8 @@ namespace golf_sim {
 
         GS_LOG_MSG(error, "BallHitNowWaitingForCam2Image - Timed out waiting for Cam2Image.  Restarting... ");
 
+        ReceivedCam2ImageTimerId = 0;
+
         GolfSimEventElement restartEvent{ new GolfSimEvent::Restart{ } };
         GolfSimEventQueue::QueueEvent(restartEvent);
 
@@ -535,16 +660,6 @@ namespace golf_sim {
     }
 
 
-    GolfSimState onEvent(const auto& state, const GolfSimEvent::EventLoopTick& eventLoopTick) {
-        GS_LOG_MSG(debug, "Got an eventLoopTick.  Ignoring");
-
-        // TBD - At some point, may want to check to make sure we're not shutting down or
-        // perform some statistics updating, or etc.
-
-        return state;
-    }
-
-
     /*********** InitializingCamera2System  ************/
 
     GolfSimState onEvent(const state::InitializingCamera2System& initializing,
@@ -578,10 +693,9 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "WaitForCam2Trigger returned with image. ");
 
-        // Send the image back to the cam1 system
-        GolfSimIPCMessage ipc_message(GolfSimIPCMessage::IPCMessageType::kCamera2Image);
-        ipc_message.SetImageMat(image);
-        GolfSimIpcSystem::SendIpcMessage(ipc_message);
+        // Send the image back to the cam1 system (in bands, if the banded
+        // transfer is enabled - see kImageTransferBandCount)
+        GolfSimIpcSystem::SendCamera2ImageMessage(image);
 
         // Save the image for later analysis
         if (GolfSimOptions::GetCommandLineOptions().artifact_save_level_ != ArtifactSaveLevel::kNoArtifacts) {
@@ -650,9 +764,17 @@ namespace golf_sim {
         }
 
         void processEvent(const PossibleEvent& event) {
+            // Record the pre-transition state (and the event and timestamp)
+            // before the handler below overwrites it
+            GsFsmTracer::RecordTransition(state_, event);
+
+            // The state is passed through as a mutable reference so that a
+            // transition handler can move (rather than copy) any images and
+            // ball data the outgoing state carries into its successor.  The
+            // outgoing state is overwritten by the assignment anyway.
             state_ = std::visit(
                 helper::overload{
-                    [](const auto& state, const auto& evt) {
+                    [](auto& state, const auto& evt) {
                         return onEvent(state, evt);
                     }
                 },
@@ -724,6 +846,30 @@ namespace golf_sim {
         else if (message_type == GsIPCControlMsgType::kClubChangeToDriver) {
             GolfSimClubs::SetCurrentClubType(GolfSimClubs::GsClubType::kDriver);
         }
+        else if (message_type == GsIPCControlMsgType::kDumpFlightRecorder) {
+            GsFlightRecorder::DumpShot("flagged by the user");
+
+            // The thread-usage inventory rides along with the diagnostic dump
+            GS_LOG_MSG(info, GsTaskPool::FormatInventory());
+        }
+        else if (message_type == GsIPCControlMsgType::kReloadConfiguration) {
+            // Runs between shots on the FSM event loop, so the constants are
+            // republished atomically with respect to shot processing
+            if (!GolfSimConfiguration::Reload()) {
+                GS_LOG_MSG(error, "Could not reload the configuration file.");
+            }
+        }
+        else if (message_type == GsIPCControlMsgType::kRequestSessionStats) {
+            // The aggregates are already folded up - answering is just a
+            // format and a status message, regardless of session length
+            std::string session_stats = GsSessionStats::FormatSessionStats();
+
+            if (session_stats.empty()) {
+                session_stats = "No session statistics are available.";
+            }
+
+            GsUISystem::SendIPCStatusMessage(GsIPCResultType::kControlMessage, session_stats);
+        }
         else {
             GS_LOG_MSG(error, "Received ControlMessage event with unknown message type.");
         }
@@ -747,6 +893,7 @@ namespace golf_sim {
         }
 
         GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kMaxCam2ImageReceivedTimeMs", kMaxCam2ImageReceivedTimeMs);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kEnableTransitionTracing", GsFsmTracer::kEnableTransitionTracing);
 
         GolfSimConfiguration::SetConstant("gs_config.user_interface.kWebServerCamera2Image", kWebServerCamera2Image);
         GolfSimConfiguration::SetConstant("gs_config.user_interface.kWebServerLastTeedBallImage", kWebServerLastTeedBallImage);        
@@ -881,21 +1028,18 @@ namespace golf_sim {
         // Allow other things that might be checking the running flag to do so
         std::this_thread::yield();
 
-        // Clean up any threads that still exist
-        // TBD - This is not thread-safe - move to a central function with a lock
-        if (BallStabilizationCheckTimerThread != nullptr) {
-            GS_LOG_TRACE_MSG(trace, "Shutting down BallStabilizationCheckTimerThread");
-            BallStabilizationCheckTimerThread->ExitThread();
-            delete BallStabilizationCheckTimerThread;
-            BallStabilizationCheckTimerThread = nullptr;
-        }
-        if (ReceivedCam2ImageCheckTimerThread != nullptr) {
-            GS_LOG_TRACE_MSG(trace, "Shutting down ReceivedCam2ImageCheckTimerThread");
-            ReceivedCam2ImageCheckTimerThread->ExitThread();
-            delete ReceivedCam2ImageCheckTimerThread;
-            ReceivedCam2ImageCheckTimerThread = nullptr;
+        // Clean up the timer service thread (along with any timers still
+        // pending on it)
+        if (FsmTimerService != nullptr) {
+            GS_LOG_TRACE_MSG(trace, "Shutting down FsmTimerService");
+            FsmTimerService->ExitThread();
+            delete FsmTimerService;
+            FsmTimerService = nullptr;
         }
 
+        // Drain and stop the shared task pool (logs its usage inventory)
+        GsTaskPool::Shutdown();
+
         std::this_thread::yield();
 
         // Only the camera1 system deals with the simulator interfaces
@@ -903,13 +1047,40 @@ namespace golf_sim {
             GsSimInterface::DeInitializeSims();
         }
 
+        // The clock-sync requester sends through the IPC system, so stop it
+        // before the IPC system goes away
+        GsClockSync::Shutdown();
+
+        // Stop the thermal polling and put the workload knobs back where the
+        // configuration set them
+        GsThermalGovernor::Shutdown();
+
         GS_LOG_TRACE_MSG(trace, "Shutting down IPC System");
         GolfSimIpcSystem::ShutdownIPCSystem();
 
+        // Flush any diagnostic images still queued for the background writer
+        LoggingTools::ShutdownAsyncImageLogging();
+
+        // Likewise, send any calibration updates still queued for the web API
+        WebApi::Shutdown();
+
+        // Dump the cv::Mat pool-allocator churn statistics (no-op if the pool
+        // is disabled)
+        GsMatPoolAllocator::LogStatistics();
+
+        // This is the clean-shutdown path, so persist the derived-state
+        // snapshot for the next start to adopt (no-op if disabled)
+        GsWarmRestart::SaveSnapshot();
+
         if (GolfSimOptions::GetCommandLineOptions().system_mode_ == SystemMode::kCamera1 ||
                GolfSimOptions::GetCommandLineOptions().system_mode_ == SystemMode::kCamera1TestStandalone) {
             PulseStrobe::DeinitGPIOSystem();
         }
+
+        // Last of all (so that the shutdown messages above make it to the
+        // log file), drain and stop the asynchronous text-log sink
+        LoggingTools::ShutdownAsyncTextLogging();
+
         return true;
     }
 
@@ -927,27 +1098,71 @@ namespace golf_sim {
                            mode == SystemMode::kTestGSProServer ||
                            mode == SystemMode::kAutomatedTesting);
 
+        const auto startup_start_time = std::chrono::steady_clock::now();
+
+        // Logs how long each subsystem took so that a slow cold start can be
+        // attributed to the subsystem responsible for it
+        auto run_timed = [](const char* name, std::function<bool()> task) {
+            const auto task_start_time = std::chrono::steady_clock::now();
+            bool success = task();
+            long task_time_ms = (long)std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - task_start_time).count();
+            GS_LOG_MSG(info, "PerformSystemStartupTasks - " + std::string(name) + " took " +
+                std::to_string(task_time_ms) + " ms" + (success ? "." : " (FAILED).") );
+            return success;
+        };
+
+        // The camera, ball-detector, IPC and GPIO initializations are independent
+        // of one another, so run them concurrently.  That brings the cold start
+        // closer to the time of the slowest single subsystem instead of the sum
+        // of all of them.
+        std::future<bool> camera_result;
+
         if (!skip_camera) {
             // Setup the Pi Camera to be internally or externally triggered as appropriate
-            if (!PerformCameraSystemStartup() ) {
-                GS_LOG_MSG(error, "Failed to PerformCameraSystemStartup.");
-                return false;
-            }
+            camera_result = std::async(std::launch::async, run_timed, "camera system startup",
+                std::function<bool()>(PerformCameraSystemStartup));
         } else {
             GS_LOG_MSG(info, "Skipping camera initialization for test mode: " + std::to_string(mode));
         }
 
-        if (!GolfSimIpcSystem::InitializeIPCSystem()) {
+        // Build (and warm up) any model-based ball detector now, while the system is
+        // still initializing.  Otherwise the first shot after startup pays for ONNX
+        // Runtime session creation and XNNPACK kernel compilation, which can take
+        // several seconds on a Pi 4.
+        std::future<bool> detector_result = std::async(std::launch::async, run_timed, "ball detector pre-warm",
+            std::function<bool()>([]() { BallImageProc::PrewarmDetectorAtStartup(); return true; }));
+
+        std::future<bool> ipc_result = std::async(std::launch::async, run_timed, "IPC system startup",
+            std::function<bool()>(GolfSimIpcSystem::InitializeIPCSystem));
+
+        std::future<bool> gpio_result = std::async(std::launch::async, run_timed, "GPIO/strobe startup",
+            std::function<bool()>([]() { return PulseStrobe::InitGPIOSystem(default_signal_handler); }));
+
+        bool ipc_initialized = ipc_result.get();
+        bool gpio_initialized = gpio_result.get();
+        detector_result.get();
+
+        if (!skip_camera && !camera_result.get()) {
+            GS_LOG_MSG(error, "Failed to PerformCameraSystemStartup.");
+            return false;
+        }
+
+        if (!ipc_initialized) {
             GS_LOG_MSG(error, "Failed to InitializeIPCSystem.");
             return false;
         }
 
         // Give the IPC system time to set up before trying to send any messages
         sleep(1);
-        
+
         GsUISystem::SendIPCStatusMessage(GsIPCResultType::kInitializing);
 
-        if (!PulseStrobe::InitGPIOSystem(default_signal_handler)) {
+        // With the broker up, the camera-1 side can start characterizing the
+        // clock offset to the camera-2 Pi (if configured)
+        GsClockSync::Start();
+
+        if (!gpio_initialized) {
             GS_LOG_MSG(error, "Failed to InitGPIOSystem.");
             return false;
         }
@@ -975,6 +1190,10 @@ namespace golf_sim {
         // Give the other threads a chance to get going
         std::this_thread::yield();
 
+        long startup_time_ms = (long)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startup_start_time).count();
+        GS_LOG_MSG(info, "PerformSystemStartupTasks - total startup took " + std::to_string(startup_time_ms) + " ms.");
+
         return true;
     }
 
@@ -0,0 +1,168 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <chrono>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "logging_tools.h"
+#include "gs_shot_trace.h"
+#include "gs_ui_system.h"
+
+#include "gs_fsm_tracer.h"
+
+#ifdef __unix__  // Ignore in Windows environment
+
+
+namespace golf_sim {
+
+    bool GsFsmTracer::kEnableTransitionTracing = false;
+
+    namespace {
+
+        struct TraceRecord {
+            const char* previous_state = "";
+            const char* event = "";
+            std::chrono::steady_clock::time_point time;
+        };
+
+        // Far more records than a single shot cycle ever generates, so
+        // wrapping only ever discards long-past history.
+        const size_t kMaxTraceRecords = 128;
+
+        // Preallocated so that recording a transition never allocates.
+        // Record number n lives at trace_ring_[n % kMaxTraceRecords].
+        std::vector<TraceRecord> trace_ring_(kMaxTraceRecords);
+
+        // Total number of transitions recorded so far
+        size_t num_records_ = 0;
+
+        // Record number of the most recent BallHit transition (the start of
+        // the in-flight shot), or -1 if no hit has been recorded yet.
+        long shot_start_record_ = -1;
+    }
+
+
+    void GsFsmTracer::RecordTransition(const GolfSimState& previous_state, const PossibleEvent& event) {
+
+        if (!kEnableTransitionTracing) {
+            return;
+        }
+
+        TraceRecord& record = trace_ring_[num_records_ % kMaxTraceRecords];
+
+        record.previous_state = StateName(previous_state);
+        record.event = EventName(event);
+        record.time = std::chrono::steady_clock::now();
+
+        if (std::holds_alternative<GolfSimEvent::BallHit>(event)) {
+            shot_start_record_ = (long)num_records_;
+        }
+
+        num_records_++;
+    }
+
+
+    void GsFsmTracer::ReportShotSummary() {
+
+        if (!kEnableTransitionTracing || shot_start_record_ < 0) {
+            return;
+        }
+
+        if (num_records_ - (size_t)shot_start_record_ > kMaxTraceRecords) {
+            GS_LOG_MSG(warning, "GsFsmTracer::ReportShotSummary - the shot generated more transitions than the trace ring holds.  Skipping the summary.");
+            shot_start_record_ = -1;
+            return;
+        }
+
+        // The state that record n transitioned into is the previous_state of
+        // record n+1, and the time spent in it is the gap between the two
+        // records' timestamps.
+        std::string summary = "FSM shot summary (BallHit to results dispatch)";
+
+        // The trace ID ties this summary to the same shot's log lines and
+        // journal entry on both Pis
+        if (GsShotTrace::Current() != 0) {
+            summary += " for shot:" + std::to_string(GsShotTrace::Current());
+        }
+
+        summary += ":";
+
+        for (size_t n = (size_t)shot_start_record_; n + 1 < num_records_; n++) {
+
+            const TraceRecord& entered = trace_ring_[n % kMaxTraceRecords];
+            const TraceRecord& left = trace_ring_[(n + 1) % kMaxTraceRecords];
+
+            long ms_in_state = (long)std::chrono::duration_cast<std::chrono::milliseconds>(left.time - entered.time).count();
+
+            summary += "\n  " + std::string(left.previous_state) + " (entered on " + entered.event + "): " + std::to_string(ms_in_state) + " ms";
+        }
+
+        const TraceRecord& hit_record = trace_ring_[(size_t)shot_start_record_ % kMaxTraceRecords];
+
+        long total_ms = (long)std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - hit_record.time).count();
+
+        summary += "\n  Total time from BallHit to results dispatch: " + std::to_string(total_ms) + " ms";
+
+        // The shot is complete - the next summary starts at the next BallHit
+        shot_start_record_ = -1;
+
+        GsUISystem::SendFsmShotSummary(summary);
+    }
+
+
+    const char* GsFsmTracer::StateName(const GolfSimState& state) {
+
+        return std::visit([](const auto& s) -> const char* {
+            using T = std::decay_t<decltype(s)>;
+
+            if constexpr (std::is_same_v<T, state::InitializingCamera1System>) return "InitializingCamera1System";
+            else if constexpr (std::is_same_v<T, state::Exiting>) return "Exiting";
+            else if constexpr (std::is_same_v<T, state::WaitingForSimulatorArmed>) return "WaitingForSimulatorArmed";
+            else if constexpr (std::is_same_v<T, state::WaitingForBall>) return "WaitingForBall";
+            else if constexpr (std::is_same_v<T, state::WaitingForBallStabilization>) return "WaitingForBallStabilization";
+            else if constexpr (std::is_same_v<T, state::WaitingForBallHit>) return "WaitingForBallHit";
+            else if constexpr (std::is_same_v<T, state::WaitingForCamera2PreImage>) return "WaitingForCamera2PreImage";
+            else if constexpr (std::is_same_v<T, state::BallHitNowWaitingForCam2Image>) return "BallHitNowWaitingForCam2Image";
+            else if constexpr (std::is_same_v<T, state::InitializingCamera2System>) return "InitializingCamera2System";
+            else if constexpr (std::is_same_v<T, state::WaitingForCameraArmMessage>) return "WaitingForCameraArmMessage";
+            else if constexpr (std::is_same_v<T, state::WaitingForCameraTrigger>) return "WaitingForCameraTrigger";
+            else return "UnknownState";
+        }, state);
+    }
+
+
+    const char* GsFsmTracer::EventName(const PossibleEvent& event) {
+
+        // The events have Format() methods, but those return freshly-built
+        // std::strings - the trace ring wants static names.
+        return std::visit([](const auto& e) -> const char* {
+            using T = std::decay_t<decltype(e)>;
+
+            if constexpr (std::is_same_v<T, GolfSimEvent::BeginWaitingForSimulatorArmed>) return "BeginWaitingForSimulatorArmed";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::SimulatorIsArmed>) return "SimulatorIsArmed";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::BeginWaitingForBallPlaced>) return "BeginWaitingForBallPlaced";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::CheckForBallStable>) return "CheckForBallStable";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::BallStabilized>) return "BallStabilized";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::BallHit>) return "BallHit";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::ControlMessage>) return "ControlMessage";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::BeginWatchingForBallHit>) return "BeginWatchingForBallHit";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::FoundMultipleBalls>) return "FoundMultipleBalls";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::ArmCamera2MessageReceived>) return "ArmCamera2MessageReceived";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::Camera2Triggered>) return "Camera2Triggered";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::CheckForCam2ImageReceived>) return "CheckForCam2ImageReceived";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::Camera2ImageReceived>) return "Camera2ImageReceived";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::Camera2PreImageReceived>) return "Camera2PreImageReceived";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::Exit>) return "Exit";
+            else if constexpr (std::is_same_v<T, GolfSimEvent::Restart>) return "Restart";
+            else return "UnknownEvent";
+        }, event);
+    }
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
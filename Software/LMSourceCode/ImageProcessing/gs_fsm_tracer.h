@@ -0,0 +1,50 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// Lightweight, built-in tracing of the FSM's state transitions.  When
+// enabled, every transition is recorded (previous state, triggering event,
+// timestamp) into a preallocated ring, and after each shot a summary of the
+// time spent in each state from the BallHit event to the dispatch of the
+// results message is logged and handed to the GsUISystem for display.
+
+#pragma once
+
+#ifdef __unix__  // Ignore in Windows environment
+
+
+#include "gs_events.h"
+#include "gs_fsm.h"
+
+namespace golf_sim {
+
+    class GsFsmTracer {
+
+    public:
+
+        // Off by default.  Recording a transition is only a few pointer-sized
+        // stores, but there is no reason to pay even that in the field unless
+        // someone is chasing shot-to-shot latency.
+        static bool kEnableTransitionTracing;
+
+        // Records a single state transition.  Called from the FSM's event
+        // processing with the state as it stood before the transition handler
+        // ran.  Never allocates - the trace ring is preallocated and the
+        // state/event names are string literals.
+        static void RecordTransition(const GolfSimState& previous_state, const PossibleEvent& event);
+
+        // Called once the shot results have been dispatched.  Formats the
+        // time-in-each-state summary for the shot that began at the most
+        // recent BallHit event, logs it, and hands it to the GsUISystem.
+        static void ReportShotSummary();
+
+    private:
+
+        static const char* StateName(const GolfSimState& state);
+        static const char* EventName(const PossibleEvent& event);
+    };
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
@@ -0,0 +1,399 @@
+/*****************************************************************//**
+ * \file   gs_fused_edge_detect.cpp
+ * \brief  Fused separable-blur + Canny edge-map kernel.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <opencv2/imgproc.hpp>
+
+#include "gs_fused_edge_detect.h"
+
+namespace golf_sim {
+
+    bool GsFusedEdgeDetect::kUseFusedBlurCanny = false;
+
+    namespace {
+
+        constexpr uchar kWeakEdge = 128;
+        constexpr uchar kStrongEdge = 255;
+
+        struct BlurKernel {
+            int taps[7];
+            int size;
+            int shift;  // The taps sum to 1 << shift
+        };
+
+        // The fixed kernels cv::GaussianBlur falls back on for small
+        // apertures with an unspecified sigma, scaled up to integers, so
+        // the fused blur matches the separate pass it replaces
+        bool KernelFor(int blur_size, BlurKernel& kernel) {
+            switch (blur_size) {
+                case 3: kernel = { {1, 2, 1}, 3, 2 }; return true;
+                case 5: kernel = { {1, 4, 6, 4, 1}, 5, 4 }; return true;
+                case 7: kernel = { {2, 7, 14, 18, 14, 7, 2}, 7, 6 }; return true;
+                default: return false;
+            }
+        }
+
+        // cv::GaussianBlur's default border (BORDER_REFLECT_101)
+        int Reflect101(int index, int limit) {
+            if (index < 0) {
+                return -index;
+            }
+            if (index >= limit) {
+                return 2 * limit - 2 - index;
+            }
+            return index;
+        }
+
+        // The horizontal half of the separable blur for one source row.
+        // The destination holds un-normalized tap sums (at most 255 << shift,
+        // so 16 bits always suffice).
+        void HorizontalBlurRow(const uchar* src_row, int cols, const BlurKernel& kernel, uint16_t* dest) {
+
+            const int radius = kernel.size / 2;
+
+            for (int x = 0; x < radius; x++) {
+                uint32_t acc = 0;
+                for (int t = 0; t < kernel.size; t++) {
+                    acc += (uint32_t)src_row[Reflect101(x + t - radius, cols)] * kernel.taps[t];
+                }
+                dest[x] = (uint16_t)acc;
+            }
+
+            for (int x = cols - radius; x < cols; x++) {
+                uint32_t acc = 0;
+                for (int t = 0; t < kernel.size; t++) {
+                    acc += (uint32_t)src_row[Reflect101(x + t - radius, cols)] * kernel.taps[t];
+                }
+                dest[x] = (uint16_t)acc;
+            }
+
+            int x = radius;
+
+#if defined(__aarch64__)
+            for (; x + 16 <= cols - radius; x += 16) {
+                uint16x8_t acc_lo = vdupq_n_u16(0);
+                uint16x8_t acc_hi = vdupq_n_u16(0);
+
+                for (int t = 0; t < kernel.size; t++) {
+                    uint8x16_t v = vld1q_u8(src_row + x + t - radius);
+                    uint16_t coefficient = (uint16_t)kernel.taps[t];
+                    acc_lo = vmlaq_n_u16(acc_lo, vmovl_u8(vget_low_u8(v)), coefficient);
+                    acc_hi = vmlaq_n_u16(acc_hi, vmovl_u8(vget_high_u8(v)), coefficient);
+                }
+
+                vst1q_u16(dest + x, acc_lo);
+                vst1q_u16(dest + x + 8, acc_hi);
+            }
+#endif
+
+            for (; x < cols - radius; x++) {
+                uint32_t acc = 0;
+                for (int t = 0; t < kernel.size; t++) {
+                    acc += (uint32_t)src_row[x + t - radius] * kernel.taps[t];
+                }
+                dest[x] = (uint16_t)acc;
+            }
+        }
+
+        // The vertical half:  combines kernel.size horizontally-blurred rows
+        // into one finished (normalized, rounded) blurred row.
+        void VerticalBlurRow(const uint16_t* const* taps, int cols, const BlurKernel& kernel, uchar* dest) {
+
+            const int total_shift = 2 * kernel.shift;
+            const uint32_t rounding = 1u << (total_shift - 1);
+
+            int x = 0;
+
+#if defined(__aarch64__)
+            const int32x4_t negative_shift = vdupq_n_s32(-total_shift);
+            const uint32x4_t vrounding = vdupq_n_u32(rounding);
+
+            for (; x + 8 <= cols; x += 8) {
+                uint32x4_t acc_lo = vrounding;
+                uint32x4_t acc_hi = vrounding;
+
+                for (int t = 0; t < kernel.size; t++) {
+                    uint16x8_t v = vld1q_u16(taps[t] + x);
+                    uint16_t coefficient = (uint16_t)kernel.taps[t];
+                    acc_lo = vmlal_n_u16(acc_lo, vget_low_u16(v), coefficient);
+                    acc_hi = vmlal_n_u16(acc_hi, vget_high_u16(v), coefficient);
+                }
+
+                acc_lo = vshlq_u32(acc_lo, negative_shift);
+                acc_hi = vshlq_u32(acc_hi, negative_shift);
+
+                uint16x8_t narrowed = vcombine_u16(vmovn_u32(acc_lo), vmovn_u32(acc_hi));
+                vst1_u8(dest + x, vmovn_u16(narrowed));
+            }
+#endif
+
+            for (; x < cols; x++) {
+                uint32_t acc = rounding;
+                for (int t = 0; t < kernel.size; t++) {
+                    acc += (uint32_t)taps[t][x] * kernel.taps[t];
+                }
+                dest[x] = (uchar)(acc >> total_shift);
+            }
+        }
+
+        // 3x3 Sobel and L1 gradient magnitude for one blurred row (the same
+        // derivative cv::Canny computes when L2gradient is off).
+        void SobelMagRow(const uchar* above, const uchar* center, const uchar* below,
+                         int cols, int16_t* dx, int16_t* dy, int16_t* mag) {
+
+            auto sobel_one = [&](int x) {
+                int xl = Reflect101(x - 1, cols);
+                int xr = Reflect101(x + 1, cols);
+
+                int gx = (above[xr] + 2 * center[xr] + below[xr]) - (above[xl] + 2 * center[xl] + below[xl]);
+                int gy = (below[xl] + 2 * below[x] + below[xr]) - (above[xl] + 2 * above[x] + above[xr]);
+
+                dx[x] = (int16_t)gx;
+                dy[x] = (int16_t)gy;
+                mag[x] = (int16_t)(std::abs(gx) + std::abs(gy));
+            };
+
+            sobel_one(0);
+            sobel_one(cols - 1);
+
+            int x = 1;
+
+#if defined(__aarch64__)
+            // All of the 3x3 tap sums fit comfortably in int16 lanes (the
+            // largest possible |dx| or |dy| is 4 * 255)
+            auto widen = [](const uchar* p) {
+                return vreinterpretq_s16_u16(vmovl_u8(vld1_u8(p)));
+            };
+
+            for (; x + 8 <= cols - 1; x += 8) {
+                int16x8_t a_l = widen(above + x - 1);
+                int16x8_t a_c = widen(above + x);
+                int16x8_t a_r = widen(above + x + 1);
+                int16x8_t c_l = widen(center + x - 1);
+                int16x8_t c_r = widen(center + x + 1);
+                int16x8_t b_l = widen(below + x - 1);
+                int16x8_t b_c = widen(below + x);
+                int16x8_t b_r = widen(below + x + 1);
+
+                int16x8_t row_above = vaddq_s16(vaddq_s16(a_l, a_r), vshlq_n_s16(a_c, 1));
+                int16x8_t row_below = vaddq_s16(vaddq_s16(b_l, b_r), vshlq_n_s16(b_c, 1));
+                int16x8_t vdy = vsubq_s16(row_below, row_above);
+
+                int16x8_t col_right = vaddq_s16(vaddq_s16(a_r, b_r), vshlq_n_s16(c_r, 1));
+                int16x8_t col_left = vaddq_s16(vaddq_s16(a_l, b_l), vshlq_n_s16(c_l, 1));
+                int16x8_t vdx = vsubq_s16(col_right, col_left);
+
+                vst1q_s16(dx + x, vdx);
+                vst1q_s16(dy + x, vdy);
+                vst1q_s16(mag + x, vaddq_s16(vabsq_s16(vdx), vabsq_s16(vdy)));
+            }
+#endif
+
+            for (; x < cols - 1; x++) {
+                sobel_one(x);
+            }
+        }
+
+        // Non-maximum suppression and double thresholding for one row.
+        // Survivors above the high threshold are labeled strong (and seed
+        // the hysteresis); the rest are weak, pending connectivity.
+        void NonMaxSuppressRow(const int16_t* mag_above, const int16_t* mag_c, const int16_t* mag_below,
+                               const int16_t* dx_row, const int16_t* dy_row,
+                               int cols, int low, int high,
+                               uchar* edge_row, int row_base, std::vector<int>& strong_seeds) {
+
+            // tan(22.5 deg) in Q15 - the same sector quantization cv::Canny
+            // uses, so a gradient falls in the same sector (and the pixel
+            // survives or not) exactly as it would there
+            constexpr int kTan22Q15 = 13573;
+            constexpr int kQ15Shift = 15;
+
+            edge_row[0] = 0;
+            edge_row[cols - 1] = 0;
+
+            for (int x = 1; x < cols - 1; x++) {
+
+                int m = mag_c[x];
+                uchar label = 0;
+
+                if (m > low) {
+
+                    int xs = dx_row[x];
+                    int ys = dy_row[x];
+                    int ax = std::abs(xs);
+                    int ay = std::abs(ys) << kQ15Shift;
+
+                    bool is_local_max = false;
+                    int tg22 = ax * kTan22Q15;
+
+                    if (ay < tg22) {
+                        // Mostly-horizontal gradient: compare along the row
+                        is_local_max = (m > mag_c[x - 1] && m >= mag_c[x + 1]);
+                    }
+                    else {
+                        int tg67 = tg22 + ((ax + ax) << kQ15Shift);
+
+                        if (ay > tg67) {
+                            // Mostly-vertical: compare across the rows
+                            is_local_max = (m > mag_above[x] && m >= mag_below[x]);
+                        }
+                        else {
+                            // Diagonal - the signs pick which one
+                            int s = ((xs ^ ys) < 0) ? -1 : 1;
+                            is_local_max = (m > mag_above[x - s] && m > mag_below[x + s]);
+                        }
+                    }
+
+                    if (is_local_max) {
+                        if (m > high) {
+                            label = kStrongEdge;
+                            strong_seeds.push_back(row_base + x);
+                        }
+                        else {
+                            label = kWeakEdge;
+                        }
+                    }
+                }
+
+                edge_row[x] = label;
+            }
+        }
+    }
+
+
+    bool GsFusedEdgeDetect::BlurAndCanny(const cv::Mat& src,
+                                         cv::Mat& edges,
+                                         int blur_size,
+                                         double canny_lower,
+                                         double canny_upper) {
+
+        BlurKernel kernel;
+
+        if (src.empty() || src.type() != CV_8UC1 || src.rows < 8 || src.cols < 8 ||
+            !KernelFor(blur_size, kernel)) {
+            return false;
+        }
+
+        const int rows = src.rows;
+        const int cols = src.cols;
+        const int radius = kernel.size / 2;
+
+        // cv::Canny floors its thresholds for the L1 gradient
+        const int low = cvFloor(canny_lower);
+        const int high = cvFloor(canny_upper);
+
+        edges.create(rows, cols, CV_8UC1);
+
+        // The rolling rings.  This is the whole per-frame working set of the
+        // fused pass - a handful of rows that stay cache-resident as the
+        // pipeline advances down the image, instead of a full blurred frame
+        // making a round trip through memory.
+        std::vector<uint16_t> hblur_store((size_t)kernel.size * cols);
+        std::vector<uchar> blur_store((size_t)3 * cols);
+        std::vector<int16_t> dx_store((size_t)3 * cols);
+        std::vector<int16_t> dy_store((size_t)3 * cols);
+        std::vector<int16_t> mag_store((size_t)3 * cols);
+
+        std::vector<int> strong_seeds;
+        strong_seeds.reserve(1024);
+
+        auto hblur_row_ptr = [&](int src_y) {
+            int slot = ((src_y % kernel.size) + kernel.size) % kernel.size;
+            return hblur_store.data() + (size_t)slot * cols;
+        };
+        auto ring3_slot = [](int y) { return ((y % 3) + 3) % 3; };
+        auto blur_row_ptr = [&](int y) { return blur_store.data() + (size_t)ring3_slot(y) * cols; };
+        auto dx_row_ptr = [&](int y) { return dx_store.data() + (size_t)ring3_slot(y) * cols; };
+        auto dy_row_ptr = [&](int y) { return dy_store.data() + (size_t)ring3_slot(y) * cols; };
+        auto mag_row_ptr = [&](int y) { return mag_store.data() + (size_t)ring3_slot(y) * cols; };
+
+        // The suppression needs a full 3x3 neighborhood, so the 1-pixel
+        // border stays empty (the row borders here, the column borders in
+        // NonMaxSuppressRow)
+        std::memset(edges.ptr<uchar>(0), 0, cols);
+        std::memset(edges.ptr<uchar>(rows - 1), 0, cols);
+
+        // Prime the horizontal ring with all but the last row the first
+        // blurred row needs - each pipeline step below then adds exactly one
+        for (int s = -1 - radius; s < -1 + radius; s++) {
+            HorizontalBlurRow(src.ptr<uchar>(Reflect101(s, rows)), cols, kernel, hblur_row_ptr(s));
+        }
+
+        // The fused pipeline:  each step pulls one new source row through
+        // the horizontal blur, which completes one blurred row, which
+        // completes one gradient row, which completes one suppressed output
+        // row - all within the rings above.
+        for (int b = -1; b <= rows; b++) {
+
+            HorizontalBlurRow(src.ptr<uchar>(Reflect101(b + radius, rows)), cols, kernel, hblur_row_ptr(b + radius));
+
+            {
+                const uint16_t* taps[7];
+                for (int t = 0; t < kernel.size; t++) {
+                    taps[t] = hblur_row_ptr(b - radius + t);
+                }
+                VerticalBlurRow(taps, cols, kernel, blur_row_ptr(b));
+            }
+
+            int m = b - 1;
+            if (m >= 0 && m <= rows - 1) {
+                SobelMagRow(blur_row_ptr(m - 1), blur_row_ptr(m), blur_row_ptr(m + 1), cols,
+                            dx_row_ptr(m), dy_row_ptr(m), mag_row_ptr(m));
+            }
+
+            int y = b - 2;
+            if (y >= 1 && y <= rows - 2) {
+                NonMaxSuppressRow(mag_row_ptr(y - 1), mag_row_ptr(y), mag_row_ptr(y + 1),
+                                  dx_row_ptr(y), dy_row_ptr(y),
+                                  cols, low, high,
+                                  edges.ptr<uchar>(y), y * cols, strong_seeds);
+            }
+        }
+
+        // Hysteresis:  weak pixels survive only if 8-connected to a strong
+        // one.  The border was left unlabeled above, so a neighbor index
+        // can never wrap onto a promotable pixel (or leave the buffer - the
+        // seeds all sit at least one full row and column inside it) and no
+        // per-pixel bounds checks are needed.
+        uchar* labels = edges.ptr<uchar>(0);
+
+        const int neighbor_offsets[8] = { -cols - 1, -cols, -cols + 1, -1, 1, cols - 1, cols, cols + 1 };
+
+        while (!strong_seeds.empty()) {
+            int index = strong_seeds.back();
+            strong_seeds.pop_back();
+
+            for (int n = 0; n < 8; n++) {
+                int neighbor = index + neighbor_offsets[n];
+                if (labels[neighbor] == kWeakEdge) {
+                    labels[neighbor] = kStrongEdge;
+                    strong_seeds.push_back(neighbor);
+                }
+            }
+        }
+
+        // Unconnected weak pixels drop out
+        cv::threshold(edges, edges, kWeakEdge + 1, 255, cv::THRESH_BINARY);
+
+        return true;
+    }
+
+}
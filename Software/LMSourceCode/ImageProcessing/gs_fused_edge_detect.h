@@ -0,0 +1,52 @@
+/*****************************************************************//**
+ * \file   gs_fused_edge_detect.h
+ * \brief  Fused separable-blur + Canny edge-map kernel.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+    // The pre-Canny Gaussian blur and the Canny itself are bandwidth-bound
+    // on the Pi, not arithmetic-bound - run separately, the full blurred
+    // frame is written out to memory only to be read straight back in.
+    // BlurAndCanny fuses the two: the separable blur, the Sobel gradient
+    // and the non-maximum suppression advance together down the image in a
+    // rolling ring of rows, so the blurred intermediate never exists as
+    // more than a handful of cache-resident rows.  The inner loops are
+    // NEON-vectorized on aarch64, with scalar code everywhere else.
+    //
+    // The output matches cv::GaussianBlur followed by cv::Canny (L1
+    // gradient) to within rounding, except that the 1-pixel image border is
+    // left empty - irrelevant to the ball edges the Hough transform feeds
+    // on.  Off by default
+    // (gs_config.ball_identification.kUseFusedBlurCanny).
+
+    class GsFusedEdgeDetect {
+
+    public:
+
+        static bool kUseFusedBlurCanny;
+
+        // Drop-in for the cv::GaussianBlur(blur_size) + cv::Canny pair.
+        // Returns false - and the caller should run the separate passes as
+        // always - when the input is not something the fused kernel
+        // handles (not CV_8UC1, tiny, or a blur size other than 3, 5 or 7).
+        static bool BlurAndCanny(const cv::Mat& src,
+                                 cv::Mat& edges,
+                                 int blur_size,
+                                 double canny_lower,
+                                 double canny_upper);
+    };
+
+}
@@ -0,0 +1,138 @@
+/*****************************************************************//**
+ * \file   gs_geometry.h
+ * \brief  Header-only batch geometry primitives for the scoring loops.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace golf_sim {
+
+    // The candidate-scoring loops in GolfSimCamera lean on a handful of tiny
+    // geometry helpers.  Keeping them header-only lets the compiler inline
+    // them straight into the loops, and the batch variants take whole
+    // structure-of-arrays candidate sets so the invariant terms - the
+    // trajectory-line normalization, the friction-slowing scale - are
+    // computed once per set instead of once per element.
+    //
+    // Everything here works on plain doubles.  OpenCV's vector accessors are
+    // not constexpr, so call sites unpack circles/points before batching.
+
+    struct GsGeometry {
+
+        // Perpendicular distance from (xc, yc) to the infinite line through
+        // (xa, ya) and (xb, yb).  Same math as the scalar
+        // GolfSimCamera::GetPerpendicularDistanceFromLine.
+        static inline double PerpendicularDistanceFromLine(double xc, double yc,
+                                                           double xa, double ya,
+                                                           double xb, double yb) {
+
+            // If the line is vertical, then the distance is just the x difference to the line
+            if (std::abs(xb - xa) < 0.0001) {
+                return (std::abs(xc - xb));
+            }
+
+            // If the line is horizontal, then the distance is just the y difference to the line
+            if (std::abs(yb - ya) < 0.0001) {
+                return (std::abs(yc - yb));
+            }
+
+            double numerator = std::abs((xb - xa) * (yc - ya) - (yb - ya) * (xc - xa));
+            double denominator = std::sqrt((xb - xa) * (xb - xa) + (yb - ya) * (yb - ya));
+
+            return (numerator / denominator);
+        }
+
+        // Batch variant - distances of N candidate points to one trajectory
+        // line, with the degenerate-line tests and the normalization term
+        // hoisted out of the per-point loop.
+        static inline void PerpendicularDistancesFromLine(const std::vector<double>& xs,
+                                                          const std::vector<double>& ys,
+                                                          double xa, double ya,
+                                                          double xb, double yb,
+                                                          std::vector<double>& distances) {
+
+            distances.resize(xs.size());
+
+            if (std::abs(xb - xa) < 0.0001) {
+                for (size_t i = 0; i < xs.size(); i++) {
+                    distances[i] = std::abs(xs[i] - xb);
+                }
+                return;
+            }
+
+            if (std::abs(yb - ya) < 0.0001) {
+                for (size_t i = 0; i < ys.size(); i++) {
+                    distances[i] = std::abs(ys[i] - yb);
+                }
+                return;
+            }
+
+            const double line_dx = xb - xa;
+            const double line_dy = yb - ya;
+            const double denominator = std::sqrt(line_dx * line_dx + line_dy * line_dy);
+
+            for (size_t i = 0; i < xs.size(); i++) {
+                distances[i] = std::abs(line_dx * (ys[i] - ya) - line_dy * (xs[i] - xa)) / denominator;
+            }
+        }
+
+        // Inter-point distances of N consecutive candidate positions (N-1
+        // outputs) - the first half of GetBallDistancesAndRatios.
+        static inline void ConsecutivePairDistances(const std::vector<double>& xs,
+                                                    const std::vector<double>& ys,
+                                                    std::vector<double>& distances) {
+
+            if (xs.size() < 2) {
+                distances.clear();
+                return;
+            }
+
+            distances.resize(xs.size() - 1);
+
+            for (size_t i = 0; i + 1 < xs.size(); i++) {
+                const double x_distance = std::abs(xs[i + 1] - xs[i]);
+                const double y_distance = std::abs(ys[i + 1] - ys[i]);
+                distances[i] = std::sqrt(x_distance * x_distance + y_distance * y_distance);
+            }
+        }
+
+        // Ratios of each adjacent value pair, with a constant scale folded
+        // into the right-hand element (used for the friction-slowing
+        // adjustment, which is the same for every pair of a shot).  Returns
+        // false if any left-hand value is degenerate (<= 1.0).
+        static inline bool AdjacentScaledRatios(const std::vector<double>& values,
+                                                double right_scale,
+                                                std::vector<double>& ratios) {
+
+            ratios.clear();
+
+            if (values.size() < 2) {
+                return true;
+            }
+
+            ratios.reserve(values.size() - 1);
+
+            for (size_t i = 0; i + 1 < values.size(); i++) {
+                if (values[i] <= 1.0) {
+                    return false;
+                }
+                ratios.push_back((values[i + 1] * right_scale) / values[i]);
+            }
+
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,633 @@
+/*****************************************************************//**
+ * \file   gs_gpu_preprocess.cpp
+ * \brief  GLES 3.1 compute-shader backend for image preprocessing stages.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include "gs_gpu_preprocess.h"
+
+#include "logging_tools.h"
+
+namespace golf_sim {
+
+    bool GsGpuPreprocess::kUseGpuPreprocessing = false;
+
+}
+
+#ifndef GS_GPU_PREPROCESS
+
+// Stub backend - built when meson was configured without
+// -Denable_gpu_preprocess=true.  Every stage reports that it could not run,
+// so the callers stay on their cv:: CPU paths.
+
+namespace golf_sim {
+
+    bool GsGpuPreprocess::Available() {
+        return false;
+    }
+
+    bool GsGpuPreprocess::GaussianBlur(const cv::Mat&, cv::Mat&, int) {
+        return false;
+    }
+
+    bool GsGpuPreprocess::SobelMagnitude(const cv::Mat&, cv::Mat&) {
+        return false;
+    }
+
+    bool GsGpuPreprocess::Threshold(const cv::Mat&, cv::Mat&, double, double) {
+        return false;
+    }
+
+    bool GsGpuPreprocess::Downscale(const cv::Mat&, cv::Mat&, int) {
+        return false;
+    }
+
+    void GsGpuPreprocess::Shutdown() {
+    }
+
+}
+
+#else  // GS_GPU_PREPROCESS
+
+#include <EGL/egl.h>
+#include <GLES3/gl31.h>
+
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace golf_sim {
+
+    namespace {
+
+        // The images travel as SSBOs of packed uints (4 pixels per word) rather
+        // than textures - the stages are pure gather/scatter over 8-bit pixels,
+        // and plain buffers keep the upload/readback copies trivial.  Rows are
+        // padded to a multiple of 4 pixels so each invocation owns exactly one
+        // output word and no two invocations ever write the same word.
+
+        const char* kShaderPreamble = R"(#version 310 es
+layout(local_size_x = 16, local_size_y = 16) in;
+layout(std430, binding = 0) readonly buffer SrcBuf { uint src_words[]; };
+layout(std430, binding = 1) writeonly buffer DstBuf { uint dst_words[]; };
+uniform int u_width;
+uniform int u_height;
+uniform int u_stride;
+
+uint load_px(int x, int y) {
+    x = clamp(x, 0, u_width - 1);
+    y = clamp(y, 0, u_height - 1);
+    int idx = y * u_stride + x;
+    return (src_words[idx >> 2] >> (8u * uint(idx & 3))) & 0xFFu;
+}
+)";
+
+        // Separable Gaussian - run twice, with u_direction (1,0) then (0,1).
+        const char* kBlurShaderBody = R"(
+layout(std430, binding = 2) readonly buffer WeightBuf { float weights[]; };
+uniform int u_radius;
+uniform ivec2 u_direction;
+
+void main() {
+    int word_x = int(gl_GlobalInvocationID.x);
+    int y = int(gl_GlobalInvocationID.y);
+    if (word_x * 4 >= u_width || y >= u_height) {
+        return;
+    }
+    uint packed = 0u;
+    for (int lane = 0; lane < 4; lane++) {
+        int x = word_x * 4 + lane;
+        float acc = 0.0;
+        for (int k = -u_radius; k <= u_radius; k++) {
+            acc += weights[k + u_radius] *
+                   float(load_px(x + k * u_direction.x, y + k * u_direction.y));
+        }
+        packed |= (uint(clamp(acc + 0.5, 0.0, 255.0)) & 0xFFu) << (8u * uint(lane));
+    }
+    dst_words[(y * u_stride + word_x * 4) >> 2] = packed;
+}
+)";
+
+        const char* kSobelShaderBody = R"(
+void main() {
+    int word_x = int(gl_GlobalInvocationID.x);
+    int y = int(gl_GlobalInvocationID.y);
+    if (word_x * 4 >= u_width || y >= u_height) {
+        return;
+    }
+    uint packed = 0u;
+    for (int lane = 0; lane < 4; lane++) {
+        int x = word_x * 4 + lane;
+        float p00 = float(load_px(x - 1, y - 1));
+        float p10 = float(load_px(x,     y - 1));
+        float p20 = float(load_px(x + 1, y - 1));
+        float p01 = float(load_px(x - 1, y));
+        float p21 = float(load_px(x + 1, y));
+        float p02 = float(load_px(x - 1, y + 1));
+        float p12 = float(load_px(x,     y + 1));
+        float p22 = float(load_px(x + 1, y + 1));
+        float gx = (p20 + 2.0 * p21 + p22) - (p00 + 2.0 * p01 + p02);
+        float gy = (p02 + 2.0 * p12 + p22) - (p00 + 2.0 * p10 + p20);
+        float mag = sqrt(gx * gx + gy * gy);
+        packed |= (uint(clamp(mag, 0.0, 255.0)) & 0xFFu) << (8u * uint(lane));
+    }
+    dst_words[(y * u_stride + word_x * 4) >> 2] = packed;
+}
+)";
+
+        const char* kThresholdShaderBody = R"(
+uniform float u_threshold;
+uniform float u_max_value;
+
+void main() {
+    int word_x = int(gl_GlobalInvocationID.x);
+    int y = int(gl_GlobalInvocationID.y);
+    if (word_x * 4 >= u_width || y >= u_height) {
+        return;
+    }
+    uint packed = 0u;
+    for (int lane = 0; lane < 4; lane++) {
+        int x = word_x * 4 + lane;
+        float value = float(load_px(x, y)) > u_threshold ? u_max_value : 0.0;
+        packed |= (uint(clamp(value, 0.0, 255.0)) & 0xFFu) << (8u * uint(lane));
+    }
+    dst_words[(y * u_stride + word_x * 4) >> 2] = packed;
+}
+)";
+
+        // Box-average downscale.  u_width/u_height/u_stride describe the
+        // source (for load_px); the u_dst_* uniforms describe the output grid.
+        const char* kDownscaleShaderBody = R"(
+uniform int u_factor;
+uniform int u_dst_width;
+uniform int u_dst_height;
+uniform int u_dst_stride;
+
+void main() {
+    int word_x = int(gl_GlobalInvocationID.x);
+    int y = int(gl_GlobalInvocationID.y);
+    if (word_x * 4 >= u_dst_width || y >= u_dst_height) {
+        return;
+    }
+    uint packed = 0u;
+    for (int lane = 0; lane < 4; lane++) {
+        int x = word_x * 4 + lane;
+        float acc = 0.0;
+        for (int dy = 0; dy < u_factor; dy++) {
+            for (int dx = 0; dx < u_factor; dx++) {
+                acc += float(load_px(x * u_factor + dx, y * u_factor + dy));
+            }
+        }
+        float avg = acc / float(u_factor * u_factor);
+        packed |= (uint(clamp(avg + 0.5, 0.0, 255.0)) & 0xFFu) << (8u * uint(lane));
+    }
+    dst_words[(y * u_dst_stride + word_x * 4) >> 2] = packed;
+}
+)";
+
+        struct GpuContext {
+            EGLDisplay display = EGL_NO_DISPLAY;
+            EGLContext context = EGL_NO_CONTEXT;
+            GLuint blur_program = 0;
+            GLuint sobel_program = 0;
+            GLuint threshold_program = 0;
+            GLuint downscale_program = 0;
+            GLuint src_ssbo = 0;
+            GLuint dst_ssbo = 0;
+            GLuint weight_ssbo = 0;
+            size_t src_capacity = 0;
+            size_t dst_capacity = 0;
+        };
+
+        GpuContext gpu_context;
+        std::mutex gpu_mutex;
+        bool gpu_initialized = false;
+        bool gpu_failed = false;
+
+        // Staging copy used when a Mat's rows need re-packing to the padded
+        // stride.  Guarded by gpu_mutex like everything else here.
+        std::vector<uint8_t> staging_buffer;
+
+        int PaddedStride(int cols) {
+            return (cols + 3) & ~3;
+        }
+
+        GLuint CompileComputeProgram(const std::string& name, const char* body) {
+            std::string source = std::string(kShaderPreamble) + body;
+            const char* source_ptr = source.c_str();
+
+            GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+            glShaderSource(shader, 1, &source_ptr, nullptr);
+            glCompileShader(shader);
+
+            GLint compiled = GL_FALSE;
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+            if (!compiled) {
+                char info_log[1024] = { 0 };
+                glGetShaderInfoLog(shader, sizeof(info_log) - 1, nullptr, info_log);
+                GS_LOG_MSG(warning, "GsGpuPreprocess - failed to compile " + name +
+                    " shader: " + std::string(info_log));
+                glDeleteShader(shader);
+                return 0;
+            }
+
+            GLuint program = glCreateProgram();
+            glAttachShader(program, shader);
+            glLinkProgram(program);
+            glDeleteShader(shader);
+
+            GLint linked = GL_FALSE;
+            glGetProgramiv(program, GL_LINK_STATUS, &linked);
+            if (!linked) {
+                char info_log[1024] = { 0 };
+                glGetProgramInfoLog(program, sizeof(info_log) - 1, nullptr, info_log);
+                GS_LOG_MSG(warning, "GsGpuPreprocess - failed to link " + name +
+                    " program: " + std::string(info_log));
+                glDeleteProgram(program);
+                return 0;
+            }
+
+            return program;
+        }
+
+        // Brings up a surfaceless GLES 3.1 context on the default display.
+        // Returns false (leaving gpu_failed set by the caller) if any step
+        // fails - e.g., the v3d driver or EGL_KHR_surfaceless_context is
+        // missing on this install.
+        bool InitializeLocked() {
+
+            gpu_context.display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+            if (gpu_context.display == EGL_NO_DISPLAY ||
+                !eglInitialize(gpu_context.display, nullptr, nullptr)) {
+                GS_LOG_MSG(warning, "GsGpuPreprocess - no EGL display available.  Preprocessing stays on the CPU.");
+                return false;
+            }
+
+            eglBindAPI(EGL_OPENGL_ES_API);
+
+            const EGLint config_attribs[] = {
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
+                EGL_NONE
+            };
+            EGLConfig config;
+            EGLint num_configs = 0;
+            if (!eglChooseConfig(gpu_context.display, config_attribs, &config, 1, &num_configs) ||
+                num_configs < 1) {
+                GS_LOG_MSG(warning, "GsGpuPreprocess - no GLES3-capable EGL config.  Preprocessing stays on the CPU.");
+                return false;
+            }
+
+            const EGLint context_attribs[] = {
+                EGL_CONTEXT_MAJOR_VERSION, 3,
+                EGL_CONTEXT_MINOR_VERSION, 1,
+                EGL_NONE
+            };
+            gpu_context.context = eglCreateContext(gpu_context.display, config,
+                                                   EGL_NO_CONTEXT, context_attribs);
+            if (gpu_context.context == EGL_NO_CONTEXT) {
+                GS_LOG_MSG(warning, "GsGpuPreprocess - could not create a GLES 3.1 context.  Preprocessing stays on the CPU.");
+                return false;
+            }
+
+            if (!eglMakeCurrent(gpu_context.display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                                gpu_context.context)) {
+                GS_LOG_MSG(warning, "GsGpuPreprocess - surfaceless eglMakeCurrent failed.  Preprocessing stays on the CPU.");
+                return false;
+            }
+
+            gpu_context.blur_program = CompileComputeProgram("blur", kBlurShaderBody);
+            gpu_context.sobel_program = CompileComputeProgram("sobel", kSobelShaderBody);
+            gpu_context.threshold_program = CompileComputeProgram("threshold", kThresholdShaderBody);
+            gpu_context.downscale_program = CompileComputeProgram("downscale", kDownscaleShaderBody);
+
+            if (gpu_context.blur_program == 0 || gpu_context.sobel_program == 0 ||
+                gpu_context.threshold_program == 0 || gpu_context.downscale_program == 0) {
+                return false;
+            }
+
+            glGenBuffers(1, &gpu_context.src_ssbo);
+            glGenBuffers(1, &gpu_context.dst_ssbo);
+            glGenBuffers(1, &gpu_context.weight_ssbo);
+
+            const GLubyte* renderer = glGetString(GL_RENDERER);
+            GS_LOG_MSG(info, "GsGpuPreprocess - GPU preprocessing backend up on " +
+                std::string(renderer != nullptr ? reinterpret_cast<const char*>(renderer) : "(unknown renderer)"));
+
+            return true;
+        }
+
+        bool EnsureInitializedLocked() {
+            if (gpu_initialized) {
+                return !gpu_failed;
+            }
+            gpu_initialized = true;
+            gpu_failed = !InitializeLocked();
+            return !gpu_failed;
+        }
+
+        // The EGL context is bound to whichever thread is inside the mutex, so
+        // every entry point re-asserts it - a no-op when nothing has changed.
+        bool BindContextLocked() {
+            return eglMakeCurrent(gpu_context.display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                                  gpu_context.context) == EGL_TRUE;
+        }
+
+        void EnsureBufferCapacity(GLuint ssbo, size_t& capacity, size_t needed_bytes) {
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+            if (capacity < needed_bytes) {
+                glBufferData(GL_SHADER_STORAGE_BUFFER, needed_bytes, nullptr, GL_DYNAMIC_DRAW);
+                capacity = needed_bytes;
+            }
+        }
+
+        void UploadMatLocked(const cv::Mat& src, GLuint ssbo, size_t& capacity) {
+            const int stride = PaddedStride(src.cols);
+            const size_t needed_bytes = static_cast<size_t>(stride) * src.rows;
+
+            EnsureBufferCapacity(ssbo, capacity, needed_bytes);
+
+            if (stride == src.cols && src.isContinuous()) {
+                glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, needed_bytes, src.data);
+                return;
+            }
+
+            staging_buffer.resize(needed_bytes);
+            for (int row = 0; row < src.rows; row++) {
+                std::memcpy(staging_buffer.data() + static_cast<size_t>(row) * stride,
+                            src.ptr<uint8_t>(row), src.cols);
+            }
+            glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, needed_bytes, staging_buffer.data());
+        }
+
+        bool ReadbackMatLocked(GLuint ssbo, int rows, int cols, cv::Mat& dst) {
+            const int stride = PaddedStride(cols);
+            const size_t total_bytes = static_cast<size_t>(stride) * rows;
+
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo);
+            const void* mapped = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, total_bytes,
+                                                  GL_MAP_READ_BIT);
+            if (mapped == nullptr) {
+                return false;
+            }
+
+            dst.create(rows, cols, CV_8UC1);
+            const uint8_t* mapped_bytes = static_cast<const uint8_t*>(mapped);
+            for (int row = 0; row < rows; row++) {
+                std::memcpy(dst.ptr<uint8_t>(row),
+                            mapped_bytes + static_cast<size_t>(row) * stride, cols);
+            }
+            glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+            return true;
+        }
+
+        void SetImageUniforms(GLuint program, int width, int height, int stride) {
+            glUniform1i(glGetUniformLocation(program, "u_width"), width);
+            glUniform1i(glGetUniformLocation(program, "u_height"), height);
+            glUniform1i(glGetUniformLocation(program, "u_stride"), stride);
+        }
+
+        void DispatchOverWords(int width, int height) {
+            const GLuint groups_x = (static_cast<GLuint>((width + 3) / 4) + 15) / 16;
+            const GLuint groups_y = (static_cast<GLuint>(height) + 15) / 16;
+            glDispatchCompute(groups_x, groups_y, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+        }
+
+        bool StagePreconditionsOk(const cv::Mat& src) {
+            return !src.empty() && src.dims == 2 && src.type() == CV_8UC1;
+        }
+
+        // Same default-sigma formula OpenCV applies when GaussianBlur is called
+        // with sigma = 0, so the GPU result tracks the CPU path it replaces.
+        std::vector<float> GaussianWeights(int kernel_size) {
+            const double sigma = 0.3 * ((kernel_size - 1) * 0.5 - 1.0) + 0.8;
+            std::vector<float> weights(kernel_size);
+            const int radius = kernel_size / 2;
+            double sum = 0.0;
+            for (int i = 0; i < kernel_size; i++) {
+                const double x = i - radius;
+                weights[i] = static_cast<float>(std::exp(-(x * x) / (2.0 * sigma * sigma)));
+                sum += weights[i];
+            }
+            for (int i = 0; i < kernel_size; i++) {
+                weights[i] = static_cast<float>(weights[i] / sum);
+            }
+            return weights;
+        }
+
+    }  // namespace
+
+
+    bool GsGpuPreprocess::Available() {
+        std::lock_guard<std::mutex> lock(gpu_mutex);
+        return EnsureInitializedLocked();
+    }
+
+    bool GsGpuPreprocess::GaussianBlur(const cv::Mat& src, cv::Mat& dst, int kernel_size) {
+
+        if (!StagePreconditionsOk(src) || kernel_size < 3 || kernel_size > 31 ||
+            kernel_size % 2 != 1) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(gpu_mutex);
+        if (!EnsureInitializedLocked() || !BindContextLocked()) {
+            return false;
+        }
+
+        const int stride = PaddedStride(src.cols);
+        UploadMatLocked(src, gpu_context.src_ssbo, gpu_context.src_capacity);
+        EnsureBufferCapacity(gpu_context.dst_ssbo, gpu_context.dst_capacity,
+                             static_cast<size_t>(stride) * src.rows);
+
+        const std::vector<float> weights = GaussianWeights(kernel_size);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, gpu_context.weight_ssbo);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, weights.size() * sizeof(float),
+                     weights.data(), GL_DYNAMIC_DRAW);
+
+        glUseProgram(gpu_context.blur_program);
+        SetImageUniforms(gpu_context.blur_program, src.cols, src.rows, stride);
+        glUniform1i(glGetUniformLocation(gpu_context.blur_program, "u_radius"), kernel_size / 2);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gpu_context.weight_ssbo);
+
+        // Horizontal pass src -> dst, then vertical pass dst -> src, so the
+        // finished image is read back from the source buffer.
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpu_context.src_ssbo);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpu_context.dst_ssbo);
+        glUniform2i(glGetUniformLocation(gpu_context.blur_program, "u_direction"), 1, 0);
+        DispatchOverWords(src.cols, src.rows);
+
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpu_context.dst_ssbo);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpu_context.src_ssbo);
+        glUniform2i(glGetUniformLocation(gpu_context.blur_program, "u_direction"), 0, 1);
+        DispatchOverWords(src.cols, src.rows);
+
+        if (!ReadbackMatLocked(gpu_context.src_ssbo, src.rows, src.cols, dst)) {
+            return false;
+        }
+
+        if (glGetError() != GL_NO_ERROR) {
+            GS_LOG_MSG(warning, "GsGpuPreprocess - GL error during GaussianBlur.  Falling back to the CPU.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GsGpuPreprocess::SobelMagnitude(const cv::Mat& src, cv::Mat& dst) {
+
+        if (!StagePreconditionsOk(src)) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(gpu_mutex);
+        if (!EnsureInitializedLocked() || !BindContextLocked()) {
+            return false;
+        }
+
+        const int stride = PaddedStride(src.cols);
+        UploadMatLocked(src, gpu_context.src_ssbo, gpu_context.src_capacity);
+        EnsureBufferCapacity(gpu_context.dst_ssbo, gpu_context.dst_capacity,
+                             static_cast<size_t>(stride) * src.rows);
+
+        glUseProgram(gpu_context.sobel_program);
+        SetImageUniforms(gpu_context.sobel_program, src.cols, src.rows, stride);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpu_context.src_ssbo);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpu_context.dst_ssbo);
+        DispatchOverWords(src.cols, src.rows);
+
+        if (!ReadbackMatLocked(gpu_context.dst_ssbo, src.rows, src.cols, dst)) {
+            return false;
+        }
+
+        if (glGetError() != GL_NO_ERROR) {
+            GS_LOG_MSG(warning, "GsGpuPreprocess - GL error during SobelMagnitude.  Falling back to the CPU.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GsGpuPreprocess::Threshold(const cv::Mat& src, cv::Mat& dst,
+                                    double threshold_value, double max_value) {
+
+        if (!StagePreconditionsOk(src)) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(gpu_mutex);
+        if (!EnsureInitializedLocked() || !BindContextLocked()) {
+            return false;
+        }
+
+        const int stride = PaddedStride(src.cols);
+        UploadMatLocked(src, gpu_context.src_ssbo, gpu_context.src_capacity);
+        EnsureBufferCapacity(gpu_context.dst_ssbo, gpu_context.dst_capacity,
+                             static_cast<size_t>(stride) * src.rows);
+
+        glUseProgram(gpu_context.threshold_program);
+        SetImageUniforms(gpu_context.threshold_program, src.cols, src.rows, stride);
+        glUniform1f(glGetUniformLocation(gpu_context.threshold_program, "u_threshold"),
+                    static_cast<float>(threshold_value));
+        glUniform1f(glGetUniformLocation(gpu_context.threshold_program, "u_max_value"),
+                    static_cast<float>(max_value));
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpu_context.src_ssbo);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpu_context.dst_ssbo);
+        DispatchOverWords(src.cols, src.rows);
+
+        if (!ReadbackMatLocked(gpu_context.dst_ssbo, src.rows, src.cols, dst)) {
+            return false;
+        }
+
+        if (glGetError() != GL_NO_ERROR) {
+            GS_LOG_MSG(warning, "GsGpuPreprocess - GL error during Threshold.  Falling back to the CPU.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool GsGpuPreprocess::Downscale(const cv::Mat& src, cv::Mat& dst, int factor) {
+
+        if (!StagePreconditionsOk(src) || factor < 2 ||
+            src.cols / factor < 1 || src.rows / factor < 1) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(gpu_mutex);
+        if (!EnsureInitializedLocked() || !BindContextLocked()) {
+            return false;
+        }
+
+        const int dst_cols = src.cols / factor;
+        const int dst_rows = src.rows / factor;
+        const int src_stride = PaddedStride(src.cols);
+        const int dst_stride = PaddedStride(dst_cols);
+
+        UploadMatLocked(src, gpu_context.src_ssbo, gpu_context.src_capacity);
+        EnsureBufferCapacity(gpu_context.dst_ssbo, gpu_context.dst_capacity,
+                             static_cast<size_t>(dst_stride) * dst_rows);
+
+        glUseProgram(gpu_context.downscale_program);
+        SetImageUniforms(gpu_context.downscale_program, src.cols, src.rows, src_stride);
+        glUniform1i(glGetUniformLocation(gpu_context.downscale_program, "u_factor"), factor);
+        glUniform1i(glGetUniformLocation(gpu_context.downscale_program, "u_dst_width"), dst_cols);
+        glUniform1i(glGetUniformLocation(gpu_context.downscale_program, "u_dst_height"), dst_rows);
+        glUniform1i(glGetUniformLocation(gpu_context.downscale_program, "u_dst_stride"), dst_stride);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gpu_context.src_ssbo);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gpu_context.dst_ssbo);
+        DispatchOverWords(dst_cols, dst_rows);
+
+        if (!ReadbackMatLocked(gpu_context.dst_ssbo, dst_rows, dst_cols, dst)) {
+            return false;
+        }
+
+        if (glGetError() != GL_NO_ERROR) {
+            GS_LOG_MSG(warning, "GsGpuPreprocess - GL error during Downscale.  Falling back to the CPU.");
+            return false;
+        }
+
+        return true;
+    }
+
+    void GsGpuPreprocess::Shutdown() {
+
+        std::lock_guard<std::mutex> lock(gpu_mutex);
+
+        if (gpu_context.display != EGL_NO_DISPLAY) {
+            if (gpu_context.context != EGL_NO_CONTEXT) {
+                eglMakeCurrent(gpu_context.display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                               gpu_context.context);
+                if (gpu_context.blur_program != 0) glDeleteProgram(gpu_context.blur_program);
+                if (gpu_context.sobel_program != 0) glDeleteProgram(gpu_context.sobel_program);
+                if (gpu_context.threshold_program != 0) glDeleteProgram(gpu_context.threshold_program);
+                if (gpu_context.downscale_program != 0) glDeleteProgram(gpu_context.downscale_program);
+                if (gpu_context.src_ssbo != 0) glDeleteBuffers(1, &gpu_context.src_ssbo);
+                if (gpu_context.dst_ssbo != 0) glDeleteBuffers(1, &gpu_context.dst_ssbo);
+                if (gpu_context.weight_ssbo != 0) glDeleteBuffers(1, &gpu_context.weight_ssbo);
+                eglMakeCurrent(gpu_context.display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                               EGL_NO_CONTEXT);
+                eglDestroyContext(gpu_context.display, gpu_context.context);
+            }
+            eglTerminate(gpu_context.display);
+        }
+
+        gpu_context = GpuContext();
+        gpu_initialized = false;
+        gpu_failed = false;
+        staging_buffer.clear();
+        staging_buffer.shrink_to_fit();
+    }
+
+}
+
+#endif  // GS_GPU_PREPROCESS
@@ -0,0 +1,64 @@
+/*****************************************************************//**
+ * \file   gs_gpu_preprocess.h
+ * \brief  GLES 3.1 compute-shader backend for image preprocessing stages.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+    // Offloads the dense per-pixel preprocessing stages (Gaussian blur, Sobel
+    // gradient magnitude, threshold, box downscale) to the Pi 5's VideoCore VII
+    // via GLES 3.1 compute shaders on a headless (surfaceless) EGL context.
+    //
+    // The dispatch is deliberately pluggable:  every stage entry point returns
+    // false whenever the work could not run on the GPU - the backend was
+    // compiled out, the v3d driver is absent, context creation failed, or the
+    // Mat isn't a type the shaders handle - and the caller then just performs
+    // the usual cv:: call, so enabling the backend can never lose a stage.
+    //
+    // Only built when meson is configured with -Denable_gpu_preprocess=true
+    // (which requires EGL and GLESv2); otherwise the entry points are stubs
+    // that always report false and everything stays on the CPU path.
+
+    class GsGpuPreprocess {
+
+    public:
+
+        // Master switch, off by default (gs_config.ball_identification.kUseGpuPreprocessing)
+        static bool kUseGpuPreprocessing;
+
+        // True once the EGL/GLES compute context has been brought up successfully.
+        // Triggers lazy initialization on the first call.
+        static bool Available();
+
+        // Each stage works on CV_8UC1 images and returns true only if the GPU
+        // produced dst.  kernel_size must be odd (same contract as cv::GaussianBlur).
+        static bool GaussianBlur(const cv::Mat& src, cv::Mat& dst, int kernel_size);
+
+        // L2 gradient magnitude from a 3x3 Sobel pair, saturated to 8 bits.
+        static bool SobelMagnitude(const cv::Mat& src, cv::Mat& dst);
+
+        // Binary threshold - pixels strictly above threshold_value become
+        // max_value, everything else 0 (cv::THRESH_BINARY semantics).
+        static bool Threshold(const cv::Mat& src, cv::Mat& dst, double threshold_value, double max_value);
+
+        // Box-average downscale by an integer factor >= 2.
+        static bool Downscale(const cv::Mat& src, cv::Mat& dst, int factor);
+
+        // Tears down the GL objects and the EGL context.  Safe to call even if
+        // initialization never ran or failed.
+        static void Shutdown();
+    };
+
+}
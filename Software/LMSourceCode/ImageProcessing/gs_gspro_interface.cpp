@@ -3,6 +3,7 @@
  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
  */
 
+#include <chrono>
 #include <iostream>
 
 #ifdef __unix__  // Ignore in Windows environment
@@ -28,6 +29,8 @@ using ip::tcp;
 
 namespace golf_sim {
 
+    int GsGSProInterface::kGSProHeartbeatIntervalSec = 30;
+
 
     GsGSProInterface::GsGSProInterface() {
 
@@ -39,6 +42,7 @@ namespace golf_sim {
             GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.GSPro.kGSProConnectAddress", socket_connect_address_);
         }
         GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.GSPro.kGSProConnectPort", socket_connect_port_);
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.GSPro.kGSProHeartbeatIntervalSec", kGSProHeartbeatIntervalSec);
     }
 
     GsGSProInterface::~GsGSProInterface() {
@@ -95,17 +99,64 @@ namespace golf_sim {
 
         initialized_ = true;
 
-        // Send an initial "I'm alive" message
+        // The keep-alive message never changes, so build it once and reuse it
+        // for the initial "I'm alive" and every heartbeat after it
         GsGSProResults keep_alive_results;
         keep_alive_results.result_message_is_keepalive_ = true;
+        keep_alive_results.FormatInto(keep_alive_message_);
 
         // TBD - Currently, it doesn't appear we get a response for a keep-alive ?
-        SendResults(keep_alive_results);
+        SendSimMessage(keep_alive_message_);
+
+        // Keep the connection warm between shots so that no shot ever pays
+        // for a reconnect
+        if (kGSProHeartbeatIntervalSec > 0 && heartbeat_thread_ == nullptr) {
+            heartbeat_exit_ = false;
+            heartbeat_thread_ = new std::thread(&GsGSProInterface::SendHeartbeats, this);
+        }
+
         return true;
     }
 
+
+    void GsGSProInterface::SendHeartbeats() {
+
+        std::unique_lock<std::mutex> lock(heartbeat_mutex_);
+
+        while (!heartbeat_exit_) {
+
+            heartbeat_cv_.wait_for(lock, std::chrono::seconds(kGSProHeartbeatIntervalSec));
+
+            if (heartbeat_exit_) {
+                return;
+            }
+
+            // If the connection is down, let the normal re-initialization in
+            // SendResults deal with it rather than racing it here
+            if (!initialized_ || receive_thread_exited_) {
+                continue;
+            }
+
+            // SendSimMessage serializes against shot sends with its own mutex
+            SendSimMessage(keep_alive_message_);
+        }
+    }
+
     void GsGSProInterface::DeInitialize() {
 
+        // Stop the heartbeat before the socket goes away
+        {
+            std::lock_guard<std::mutex> lock(heartbeat_mutex_);
+            heartbeat_exit_ = true;
+        }
+        heartbeat_cv_.notify_one();
+
+        if (heartbeat_thread_ != nullptr) {
+            heartbeat_thread_->join();
+            delete heartbeat_thread_;
+            heartbeat_thread_ = nullptr;
+        }
+
         // TBD - Send disconnect message to TruGolf before we finish up
         /*
         results_msg = "{\"Type\":\"Disconnect\"}";
@@ -122,6 +173,8 @@ namespace golf_sim {
         GS_LOG_TRACE_MSG(trace, "GsGSProInterface::SetSimSystemArmed called.");
 
         sim_system_is_armed_ = is_armed;
+
+        InvalidateArmedStateCache();
     }
 
     bool GsGSProInterface::GetSimSystemArmed() {
@@ -132,6 +185,21 @@ namespace golf_sim {
         return true;
     }
 
+    bool GsGSProInterface::SupportsProgressiveResults() {
+        return true;
+    }
+
+    bool GsGSProInterface::SendSpinUpdate(const GsResults& results) {
+
+        GS_LOG_TRACE_MSG(trace, "GsGSProInterface::SendSpinUpdate for shot " +
+            std::to_string(results.shot_number_) + ".");
+
+        // The update is just the complete shot message again - same
+        // ShotNumber, now with the measured spin - which GSPro applies to
+        // the shot it already has in flight
+        return SendResults(results);
+    }
+
     bool GsGSProInterface::SendResults(const GsResults& input_results) {
 
         if (!initialized_) {
@@ -152,15 +220,13 @@ namespace golf_sim {
 
         GsGSProResults results(input_results);
 
-        GS_LOG_TRACE_MSG(trace, "Sending GSPro results input message:\n" + results.Format());
-
-        try {
-            static std::array<char, 2000> buf;
-            boost::system::error_code error;
+        // Serialize into the member buffer that is reused across shots
+        results.FormatInto(results_message_buffer_);
 
-            std::string results_msg = results.Format();
+        GS_LOG_TRACE_MSG(trace, "Sending GSPro results input message:\n" + results_message_buffer_);
 
-            size_t write_length = SendSimMessage(results_msg);
+        try {
+            size_t write_length = SendSimMessage(results_message_buffer_);
         }
         catch (std::exception& e)
         {
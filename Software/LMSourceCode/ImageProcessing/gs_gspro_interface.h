@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #include <boost/asio.hpp>
 
 #include "gs_results.h"
@@ -37,11 +42,37 @@ namespace golf_sim {
          virtual void SetSimSystemArmed(const bool is_armed);
          virtual bool GetSimSystemArmed();
 
+         // GSPro's OpenConnect protocol applies a re-sent shot message with
+         // the same ShotNumber to the existing shot, so it can take the
+         // ballistics first and the spin as a follow-up
+         virtual bool SupportsProgressiveResults();
+         virtual bool SendSpinUpdate(const GsResults& results);
+
+        // Seconds between application-level keep-alive (heartbeat) messages.
+        // The heartbeat keeps GSPro (and anything between us and it) from
+        // tearing down the idle connection between shots.  0 disables it.
+        static int kGSProHeartbeatIntervalSec;
+
     protected:
 
         virtual std::string GenerateResultsDataToSend(const GsResults& results);
 
          virtual bool ProcessReceivedData(const std::string received_data);
+
+        // Body of the heartbeat thread
+        void SendHeartbeats();
+
+        // Serialization buffer reused across shots so that sending a result
+        // does not allocate
+        std::string results_message_buffer_;
+
+        // The keep-alive message never changes, so it is built once
+        std::string keep_alive_message_;
+
+        std::thread* heartbeat_thread_ = nullptr;
+        bool heartbeat_exit_ = false;
+        std::mutex heartbeat_mutex_;
+        std::condition_variable heartbeat_cv_;
     };
 
 }
@@ -31,73 +31,78 @@ namespace golf_sim {
 
 
     std::string GsGSProResults::Format() const {
-        // Create a JSON object based on https://gsprogolf.com/GSProConnectV1.html
-        // Create a property tree object
-        boost::property_tree::ptree root;
-
-        // Create the three required children objects and add to the JSON root
-        boost::property_tree::ptree ball_data_child;
-        boost::property_tree::ptree club_data_child;
-        boost::property_tree::ptree shot_data_options_child;
-
-        // Root-level values
-        root.put("DeviceID", "PiTrac LM 0.1");
-        root.put("Units", "Yards");
-        // The shot number should be increased with each shot
-        root.put("ShotNumber", shot_number_);
-        root.put("APIversion", "1");
-
-        // Ball data - some of these values are not required
-        ball_data_child.put("Speed", FormatDoubleAsString(speed_mph_));
-        ball_data_child.put("SpinAxis", FormatDoubleAsString(GetSpinAxis()));
-        ball_data_child.put("TotalSpin", "0.0");
-        ball_data_child.put("BackSpin", FormatDoubleAsString(back_spin_rpm_));
-        ball_data_child.put("SideSpin", FormatDoubleAsString(side_spin_rpm_));
-        ball_data_child.put("HLA", FormatDoubleAsString(hla_deg_));
-        ball_data_child.put("VLA", FormatDoubleAsString(vla_deg_));
-        // ball_data_child.put("CarryDistance", 0.0);
-
-        // Club data - we don't currently implement any of this, but
-        // just to be safe, we will still send the information
-        club_data_child.put("Speed", "0.0");
-        club_data_child.put("AngleOfAttack", "0.0");
-        club_data_child.put("FaceToTarget", "0.0");
-        club_data_child.put("Lie", "0.0");
-        club_data_child.put("Loft", "0.0");
-        club_data_child.put("Path", "0.0");
-        club_data_child.put("SpeedAtImpact", "0.0");
-        club_data_child.put("VerticalFaceImpact", "0.0");
-        club_data_child.put("HorizontalFaceImpact", "0.0");
-        club_data_child.put("ClosureRate", "0.0");
-        
-        if (!result_message_is_keepalive_) {
-            // Only the ball data is valid
-            shot_data_options_child.put("ContainsBallData", true);
-            shot_data_options_child.put("ContainsClubData", false);
-            // TBD - Consider if we want to send the next two values in a heartbeat?
-            shot_data_options_child.put("LaunchMonitorIsReady", true);
-            shot_data_options_child.put("LaunchMonitorBallDetected", true);
-            shot_data_options_child.put("IsHeartBeat", false);
-        }
-        else {
-            shot_data_options_child.put("ContainsBallData", false);
-            shot_data_options_child.put("ContainsClubData", false);
-            shot_data_options_child.put("LaunchMonitorIsReady", true);
-            shot_data_options_child.put("LaunchMonitorBallDetected", true);
-            shot_data_options_child.put("IsHeartBeat", true);
-        }
 
-        root.add_child("BallData", ball_data_child);
-        root.add_child("ClubData", club_data_child);
-        root.add_child("ShotDataOptions", shot_data_options_child);
+        std::string buffer;
+        FormatInto(buffer);
+        return buffer;
+    }
+
+
+    void GsGSProResults::FormatInto(std::string& buffer) const {
+        // Create a JSON message based on https://gsprogolf.com/GSProConnectV1.html
+        //
+        // The message is serialized in a single pass.  The previous
+        // implementation built a property tree, pretty-printed it, and then
+        // regex-replaced the quoting that boost's JSON writer gets wrong -
+        // measurable work on every shot (and every heartbeat).
 
-        std::string result = GenerateStringFromJsonTree(root);
+        buffer.clear();
 
-        if (result == "") {
-            GS_LOG_MSG(warning, "GsGSProResults::Format() returning empty string.");
+        // One shot message is well under this size; reserving once lets the
+        // same buffer be reused across shots without reallocating
+        if (buffer.capacity() < 1024) {
+            buffer.reserve(1024);
         }
 
-        return result;
+        // Only the ball data is valid (when this is not just a keep-alive)
+        // TBD - Consider if we want to send the LaunchMonitor* values in a heartbeat?
+
+        // Club data is not currently implemented, but just to be safe, we
+        // will still send the (zeroed) information
+        buffer += GS_FORMATLIB_FORMAT(
+            "{{\n"
+            "    \"DeviceID\": \"PiTrac LM 0.1\",\n"
+            "    \"Units\": \"Yards\",\n"
+            "    \"ShotNumber\": {},\n"
+            "    \"APIversion\": \"1\",\n"
+            "    \"BallData\": {{\n"
+            "        \"Speed\": {},\n"
+            "        \"SpinAxis\": {},\n"
+            "        \"TotalSpin\": 0.0,\n"
+            "        \"BackSpin\": {},\n"
+            "        \"SideSpin\": {},\n"
+            "        \"HLA\": {},\n"
+            "        \"VLA\": {}\n"
+            "    }},\n"
+            "    \"ClubData\": {{\n"
+            "        \"Speed\": 0.0,\n"
+            "        \"AngleOfAttack\": 0.0,\n"
+            "        \"FaceToTarget\": 0.0,\n"
+            "        \"Lie\": 0.0,\n"
+            "        \"Loft\": 0.0,\n"
+            "        \"Path\": 0.0,\n"
+            "        \"SpeedAtImpact\": 0.0,\n"
+            "        \"VerticalFaceImpact\": 0.0,\n"
+            "        \"HorizontalFaceImpact\": 0.0,\n"
+            "        \"ClosureRate\": 0.0\n"
+            "    }},\n"
+            "    \"ShotDataOptions\": {{\n"
+            "        \"ContainsBallData\": {},\n"
+            "        \"ContainsClubData\": false,\n"
+            "        \"LaunchMonitorIsReady\": true,\n"
+            "        \"LaunchMonitorBallDetected\": true,\n"
+            "        \"IsHeartBeat\": {}\n"
+            "    }}\n"
+            "}}\n",
+            shot_number_,
+            FormatDoubleAsString(speed_mph_),
+            FormatDoubleAsString(GetSpinAxis()),
+            FormatDoubleAsString(back_spin_rpm_),
+            FormatDoubleAsString(side_spin_rpm_),
+            FormatDoubleAsString(hla_deg_),
+            FormatDoubleAsString(vla_deg_),
+            result_message_is_keepalive_ ? "false" : "true",
+            result_message_is_keepalive_ ? "true" : "false");
     }
 
 }
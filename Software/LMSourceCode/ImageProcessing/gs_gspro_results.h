@@ -21,6 +21,11 @@ namespace golf_sim {
         virtual ~GsGSProResults();
         virtual std::string Format() const;
 
+        // Serializes the shot message into the caller's buffer in a single
+        // pass.  The buffer's capacity is retained, so a caller that reuses
+        // the same buffer across shots pays no per-shot allocations.
+        virtual void FormatInto(std::string& buffer) const;
+
     };
 
 }
@@ -3,8 +3,12 @@
  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
  */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <thread>
 #include <boost/asio.hpp>
 #include <boost/bind/bind.hpp>
 #include <boost/enable_shared_from_this.hpp>
@@ -21,6 +25,76 @@ using boost::asio::ip::tcp;
 
 namespace golf_sim {
 
+    int GsGSProTestServer::kTestServerResponseDelayMs = 0;
+    int GsGSProTestServer::kTestServerResponseDelayJitterMs = 0;
+    int GsGSProTestServer::kTestServerDisconnectEveryNShots = 0;
+    int GsGSProTestServer::kTestServerStatsEveryNShots = 100;
+
+    namespace {
+
+        // Harness-wide timing capture.  Kept across connections so that the
+        // scripted disconnects do not reset the soak-test statistics.
+        long harness_message_count = 0;
+        std::chrono::steady_clock::time_point harness_first_receive_time;
+        std::chrono::steady_clock::time_point harness_last_receive_time;
+
+        double inter_arrival_min_ms = 0.0;
+        double inter_arrival_max_ms = 0.0;
+        double inter_arrival_sum_ms = 0.0;
+
+        double service_min_ms = 0.0;
+        double service_max_ms = 0.0;
+        double service_sum_ms = 0.0;
+
+        // Folds one received message into the statistics and logs the
+        // periodic summary.  service_ms is receive-to-response-queued,
+        // including any scripted delay.
+        void RecordMessageTiming(const std::chrono::steady_clock::time_point& receive_time, double service_ms) {
+
+            harness_message_count++;
+
+            if (harness_message_count == 1) {
+                harness_first_receive_time = receive_time;
+                service_min_ms = service_max_ms = service_sum_ms = service_ms;
+            }
+            else {
+                double inter_arrival_ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+                    receive_time - harness_last_receive_time).count();
+
+                if (harness_message_count == 2) {
+                    inter_arrival_min_ms = inter_arrival_max_ms = inter_arrival_ms;
+                }
+                inter_arrival_min_ms = std::min(inter_arrival_min_ms, inter_arrival_ms);
+                inter_arrival_max_ms = std::max(inter_arrival_max_ms, inter_arrival_ms);
+                inter_arrival_sum_ms += inter_arrival_ms;
+
+                service_min_ms = std::min(service_min_ms, service_ms);
+                service_max_ms = std::max(service_max_ms, service_ms);
+                service_sum_ms += service_ms;
+            }
+
+            harness_last_receive_time = receive_time;
+
+            if (GsGSProTestServer::kTestServerStatsEveryNShots > 0 &&
+                harness_message_count % GsGSProTestServer::kTestServerStatsEveryNShots == 0) {
+
+                double elapsed_secs = std::chrono::duration_cast<std::chrono::duration<double>>(
+                    receive_time - harness_first_receive_time).count();
+                double rate_per_minute = (elapsed_secs > 0.0) ? (double)(harness_message_count - 1) / elapsed_secs * 60.0 : 0.0;
+                long intervals = harness_message_count - 1;
+
+                GS_LOG_MSG(info, "GsGSProTestServer - " + std::to_string(harness_message_count) +
+                    " messages, " + std::to_string(rate_per_minute) + " shots/min.  Inter-arrival min/avg/max = " +
+                    std::to_string(inter_arrival_min_ms) + "/" +
+                    std::to_string(intervals > 0 ? inter_arrival_sum_ms / intervals : 0.0) + "/" +
+                    std::to_string(inter_arrival_max_ms) + " ms.  Service min/avg/max = " +
+                    std::to_string(service_min_ms) + "/" +
+                    std::to_string(service_sum_ms / harness_message_count) + "/" +
+                    std::to_string(service_max_ms) + " ms.");
+            }
+        }
+    }
+
     GsGSProConnection::pointer GsGSProConnection::Create(boost::asio::io_context& io_context, int port_number)
     {
         return pointer(new GsGSProConnection(io_context, port_number));
@@ -55,6 +129,7 @@ namespace golf_sim {
         while (true) {
             GS_LOG_TRACE_MSG(trace, "About to read data.");
             size_t len = socket_.read_some(boost::asio::buffer(buf), error);
+            auto receive_time = std::chrono::steady_clock::now();
             if (len == 0) {
                 GS_LOG_MSG(warning, "Received a 0-length string from GSPro server.");
             }
@@ -76,6 +151,27 @@ namespace golf_sim {
 
             GS_LOG_TRACE_MSG(trace, "Received the following message from the Launch Monitor: " + buffer_string);
 
+            // Each message gets its own response, so don't let earlier
+            // messages accumulate in front of it for the whole soak run
+            buffer_string.clear();
+
+            // Scripted response latency - a fixed delay plus a uniform
+            // random +/- jitter - simulates a slow or erratic simulator PC
+            if (GsGSProTestServer::kTestServerResponseDelayMs > 0 ||
+                GsGSProTestServer::kTestServerResponseDelayJitterMs > 0) {
+
+                int delay_ms = GsGSProTestServer::kTestServerResponseDelayMs;
+
+                if (GsGSProTestServer::kTestServerResponseDelayJitterMs > 0) {
+                    delay_ms += (std::rand() % (2 * GsGSProTestServer::kTestServerResponseDelayJitterMs + 1)) -
+                        GsGSProTestServer::kTestServerResponseDelayJitterMs;
+                }
+
+                if (delay_ms > 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+                }
+            }
+
             message_ = GenerateResponseString();
 
             GS_LOG_TRACE_MSG(trace, "Sending the following message from the GSPro simulated server: " + message_);
@@ -83,6 +179,22 @@ namespace golf_sim {
                 boost::bind(&GsGSProConnection::HandleWrite, shared_from_this(),
                     boost::asio::placeholders::error,
                     boost::asio::placeholders::bytes_transferred));
+
+            double service_ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+                std::chrono::steady_clock::now() - receive_time).count();
+            RecordMessageTiming(receive_time, service_ms);
+
+            // Scripted disconnect - drop the connection every Nth message so
+            // the LM's reconnect and retry paths get exercised continuously
+            if (GsGSProTestServer::kTestServerDisconnectEveryNShots > 0 &&
+                harness_message_count % GsGSProTestServer::kTestServerDisconnectEveryNShots == 0) {
+
+                GS_LOG_MSG(info, "GsGSProTestServer - scripted disconnect after message " +
+                    std::to_string(harness_message_count) + ".");
+                boost::system::error_code ignored;
+                socket_.close(ignored);
+                return;
+            }
         }
     }
 
@@ -104,6 +216,12 @@ namespace golf_sim {
                                     acceptor_(io_context, tcp::endpoint(tcp::v4(), port_number))
     {
         port_number_ = port_number;
+
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.GSPro.kTestServerResponseDelayMs", kTestServerResponseDelayMs);
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.GSPro.kTestServerResponseDelayJitterMs", kTestServerResponseDelayJitterMs);
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.GSPro.kTestServerDisconnectEveryNShots", kTestServerDisconnectEveryNShots);
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.GSPro.kTestServerStatsEveryNShots", kTestServerStatsEveryNShots);
+
         StartAccept();
     }
 
@@ -4,6 +4,10 @@
  */
 
 // Just for testing.  This class simulates the GSPro golf simulator interface.
+// Besides passively answering shots, it can act as a load harness: scripted
+// response latency (fixed plus jitter), scripted disconnects every N shots
+// to exercise the sender's retry/reconnect paths, and per-message timing
+// capture with periodic summaries.  See the kTestServer* settings below.
 
 #pragma once
 
@@ -42,6 +46,22 @@ namespace golf_sim {
     class GsGSProTestServer
     {
     public:
+
+        // Milliseconds to sit on each received shot before answering, plus a
+        // uniform random +/- jitter, simulating a slow or erratic simulator.
+        static int kTestServerResponseDelayMs;
+        static int kTestServerResponseDelayJitterMs;
+
+        // When greater than zero, the server drops the connection after
+        // every Nth received message, so the LM's reconnect and retry
+        // behavior gets exercised continuously.  0 never disconnects.
+        static int kTestServerDisconnectEveryNShots;
+
+        // How often (in received messages) to log the timing summary:
+        // message count, rate, and min/avg/max inter-arrival and service
+        // times.  0 logs no summaries.
+        static int kTestServerStatsEveryNShots;
+
         GsGSProTestServer(boost::asio::io_context& io_context, int port_number);
 
     private:
@@ -0,0 +1,393 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <fstream>
+#include <mutex>
+
+#include <opencv2/imgproc.hpp>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/select.h>
+#include <linux/videodev2.h>
+#endif
+
+#include "logging_tools.h"
+
+#include "gs_hw_jpeg_encoder.h"
+
+
+namespace golf_sim {
+
+#ifdef __unix__
+
+	namespace {
+
+		// Serializes access to the single codec node - encodes are short, and the
+		// image-writer thread is the main client anyway
+		std::mutex hw_jpeg_mutex_;
+
+		int hw_jpeg_fd_ = -1;
+		bool hw_jpeg_probe_done_ = false;
+
+		// How long to wait for the codec to finish one frame before giving up
+		const long kEncodeTimeoutMs = 2000;
+
+		// Finds (and keeps open) a V4L2 memory-to-memory device that can produce
+		// JPEG on its capture side.  Returns -1 if none exists on this Pi.
+		int OpenJpegCodecNode() {
+
+			for (int i = 0; i < 64; i++) {
+
+				std::string device_name = "/dev/video" + std::to_string(i);
+
+				int fd = open(device_name.c_str(), O_RDWR | O_NONBLOCK, 0);
+				if (fd < 0) {
+					continue;
+				}
+
+				v4l2_capability cap;
+				std::memset(&cap, 0, sizeof(cap));
+
+				if (ioctl(fd, VIDIOC_QUERYCAP, &cap) == 0 &&
+					(cap.capabilities & (V4L2_CAP_VIDEO_M2M | V4L2_CAP_VIDEO_M2M_MPLANE))) {
+
+					// Make sure this M2M device can actually emit JPEG
+					v4l2_fmtdesc fmtdesc;
+					std::memset(&fmtdesc, 0, sizeof(fmtdesc));
+					fmtdesc.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+
+					for (fmtdesc.index = 0; ioctl(fd, VIDIOC_ENUM_FMT, &fmtdesc) == 0; fmtdesc.index++) {
+						if (fmtdesc.pixelformat == V4L2_PIX_FMT_JPEG) {
+							GS_LOG_TRACE_MSG(trace, "GsHwJpegEncoder - found hardware JPEG codec at " + device_name);
+							return fd;
+						}
+					}
+				}
+
+				close(fd);
+			}
+
+			GS_LOG_TRACE_MSG(trace, "GsHwJpegEncoder - no hardware JPEG codec node found.  Will use software encoding.");
+			return -1;
+		}
+
+		struct MappedBuffer {
+			void* start = nullptr;
+			size_t length = 0;
+		};
+
+		bool MapOneBuffer(int fd, v4l2_buf_type type, MappedBuffer& mapped) {
+
+			v4l2_requestbuffers reqbufs;
+			std::memset(&reqbufs, 0, sizeof(reqbufs));
+			reqbufs.count = 1;
+			reqbufs.type = type;
+			reqbufs.memory = V4L2_MEMORY_MMAP;
+
+			if (ioctl(fd, VIDIOC_REQBUFS, &reqbufs) < 0 || reqbufs.count < 1) {
+				return false;
+			}
+
+			v4l2_plane planes[VIDEO_MAX_PLANES];
+			v4l2_buffer buffer;
+			std::memset(&buffer, 0, sizeof(buffer));
+			std::memset(planes, 0, sizeof(planes));
+			buffer.type = type;
+			buffer.memory = V4L2_MEMORY_MMAP;
+			buffer.index = 0;
+			buffer.length = 1;
+			buffer.m.planes = planes;
+
+			if (ioctl(fd, VIDIOC_QUERYBUF, &buffer) < 0) {
+				return false;
+			}
+
+			mapped.length = buffer.m.planes[0].length;
+			mapped.start = mmap(nullptr, mapped.length, PROT_READ | PROT_WRITE, MAP_SHARED,
+								fd, buffer.m.planes[0].m.mem_offset);
+
+			return mapped.start != MAP_FAILED;
+		}
+
+		void ReleaseBuffers(int fd, v4l2_buf_type type, MappedBuffer& mapped) {
+
+			if (mapped.start != nullptr && mapped.start != MAP_FAILED) {
+				munmap(mapped.start, mapped.length);
+				mapped.start = nullptr;
+			}
+
+			v4l2_requestbuffers reqbufs;
+			std::memset(&reqbufs, 0, sizeof(reqbufs));
+			reqbufs.count = 0;
+			reqbufs.type = type;
+			reqbufs.memory = V4L2_MEMORY_MMAP;
+			ioctl(fd, VIDIOC_REQBUFS, &reqbufs);
+		}
+	}
+
+
+	bool GsHwJpegEncoder::IsAvailable() {
+
+		std::lock_guard<std::mutex> lock(hw_jpeg_mutex_);
+
+		if (!hw_jpeg_probe_done_) {
+			hw_jpeg_fd_ = OpenJpegCodecNode();
+			hw_jpeg_probe_done_ = true;
+		}
+
+		return hw_jpeg_fd_ >= 0;
+	}
+
+	bool GsHwJpegEncoder::EncodeToBuffer(const cv::Mat& img, int quality, std::vector<unsigned char>& jpeg_data) {
+
+		// The codec wants even dimensions for YUV420 - crop a single row/column
+		// off the edge if necessary rather than re-sampling the whole frame
+		int width = img.cols & ~1;
+		int height = img.rows & ~1;
+
+		if (width < 2 || height < 2) {
+			return false;
+		}
+
+		cv::Mat bgr_image = img(cv::Rect(0, 0, width, height));
+
+		if (bgr_image.channels() == 1) {
+			cv::cvtColor(bgr_image, bgr_image, cv::COLOR_GRAY2BGR);
+		}
+
+		cv::Mat yuv_image;
+		cv::cvtColor(bgr_image, yuv_image, cv::COLOR_BGR2YUV_I420);
+
+		std::lock_guard<std::mutex> lock(hw_jpeg_mutex_);
+
+		if (hw_jpeg_fd_ < 0) {
+			return false;
+		}
+
+		int fd = hw_jpeg_fd_;
+
+		// Negotiate the input (OUTPUT queue) and output (CAPTURE queue) formats
+
+		v4l2_format output_format;
+		std::memset(&output_format, 0, sizeof(output_format));
+		output_format.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+		output_format.fmt.pix_mp.width = width;
+		output_format.fmt.pix_mp.height = height;
+		output_format.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_YUV420;
+		output_format.fmt.pix_mp.field = V4L2_FIELD_NONE;
+		output_format.fmt.pix_mp.num_planes = 1;
+
+		if (ioctl(fd, VIDIOC_S_FMT, &output_format) < 0) {
+			GS_LOG_MSG(warning, "GsHwJpegEncoder - VIDIOC_S_FMT (output) failed.  Disabling hardware JPEG.");
+			close(hw_jpeg_fd_);
+			hw_jpeg_fd_ = -1;
+			return false;
+		}
+
+		v4l2_format capture_format;
+		std::memset(&capture_format, 0, sizeof(capture_format));
+		capture_format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+		capture_format.fmt.pix_mp.width = width;
+		capture_format.fmt.pix_mp.height = height;
+		capture_format.fmt.pix_mp.pixelformat = V4L2_PIX_FMT_JPEG;
+		capture_format.fmt.pix_mp.field = V4L2_FIELD_NONE;
+		capture_format.fmt.pix_mp.num_planes = 1;
+
+		if (ioctl(fd, VIDIOC_S_FMT, &capture_format) < 0) {
+			GS_LOG_MSG(warning, "GsHwJpegEncoder - VIDIOC_S_FMT (capture) failed.  Disabling hardware JPEG.");
+			close(hw_jpeg_fd_);
+			hw_jpeg_fd_ = -1;
+			return false;
+		}
+
+		v4l2_control quality_control;
+		std::memset(&quality_control, 0, sizeof(quality_control));
+		quality_control.id = V4L2_CID_JPEG_COMPRESSION_QUALITY;
+		quality_control.value = quality;
+
+		// Not all codecs expose the quality control - a failure here is benign
+		ioctl(fd, VIDIOC_S_CTRL, &quality_control);
+
+		MappedBuffer output_buffer;
+		MappedBuffer capture_buffer;
+
+		bool success = false;
+
+		// Everything from here on needs the unwind at the bottom, so no early returns
+		do {
+			if (!MapOneBuffer(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, output_buffer) ||
+				!MapOneBuffer(fd, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE, capture_buffer)) {
+				GS_LOG_MSG(warning, "GsHwJpegEncoder - failed to map codec buffers.");
+				break;
+			}
+
+			// Copy the planar YUV into the codec buffer, honoring the stride the
+			// driver chose.  yuv_image is a single tightly-packed plane of
+			// height*3/2 rows of 'width' bytes.
+			unsigned int driver_stride = output_format.fmt.pix_mp.plane_fmt[0].bytesperline;
+			unsigned char* destination = (unsigned char*)output_buffer.start;
+			const unsigned char* source = yuv_image.data;
+
+			if (driver_stride == (unsigned int)width) {
+				std::memcpy(destination, source, (size_t)width * height * 3 / 2);
+			}
+			else {
+				// Luma rows, then the half-width chroma rows at half the stride
+				for (int y = 0; y < height; y++) {
+					std::memcpy(destination + (size_t)y * driver_stride, source + (size_t)y * width, width);
+				}
+				unsigned char* chroma_destination = destination + (size_t)driver_stride * height;
+				const unsigned char* chroma_source = source + (size_t)width * height;
+				for (int y = 0; y < height; y++) {
+					std::memcpy(chroma_destination + (size_t)y * (driver_stride / 2), chroma_source + (size_t)y * (width / 2), width / 2);
+				}
+			}
+
+			v4l2_plane planes[VIDEO_MAX_PLANES];
+			v4l2_buffer buffer;
+
+			std::memset(&buffer, 0, sizeof(buffer));
+			std::memset(planes, 0, sizeof(planes));
+			buffer.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+			buffer.memory = V4L2_MEMORY_MMAP;
+			buffer.index = 0;
+			buffer.length = 1;
+			buffer.m.planes = planes;
+			buffer.m.planes[0].bytesused = (unsigned int)((size_t)driver_stride * height * 3 / 2);
+
+			if (ioctl(fd, VIDIOC_QBUF, &buffer) < 0) {
+				GS_LOG_MSG(warning, "GsHwJpegEncoder - VIDIOC_QBUF (output) failed.");
+				break;
+			}
+
+			std::memset(&buffer, 0, sizeof(buffer));
+			std::memset(planes, 0, sizeof(planes));
+			buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+			buffer.memory = V4L2_MEMORY_MMAP;
+			buffer.index = 0;
+			buffer.length = 1;
+			buffer.m.planes = planes;
+
+			if (ioctl(fd, VIDIOC_QBUF, &buffer) < 0) {
+				GS_LOG_MSG(warning, "GsHwJpegEncoder - VIDIOC_QBUF (capture) failed.");
+				break;
+			}
+
+			int output_type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+			int capture_type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+
+			if (ioctl(fd, VIDIOC_STREAMON, &output_type) < 0 ||
+				ioctl(fd, VIDIOC_STREAMON, &capture_type) < 0) {
+				GS_LOG_MSG(warning, "GsHwJpegEncoder - VIDIOC_STREAMON failed.");
+				break;
+			}
+
+			// Wait (the node is non-blocking) for the encoded frame
+			bool dequeued = false;
+
+			fd_set read_fds;
+			timeval timeout;
+			timeout.tv_sec = kEncodeTimeoutMs / 1000;
+			timeout.tv_usec = (kEncodeTimeoutMs % 1000) * 1000;
+
+			FD_ZERO(&read_fds);
+			FD_SET(fd, &read_fds);
+
+			while (select(fd + 1, &read_fds, nullptr, nullptr, &timeout) > 0) {
+
+				std::memset(&buffer, 0, sizeof(buffer));
+				std::memset(planes, 0, sizeof(planes));
+				buffer.type = V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE;
+				buffer.memory = V4L2_MEMORY_MMAP;
+				buffer.length = 1;
+				buffer.m.planes = planes;
+
+				if (ioctl(fd, VIDIOC_DQBUF, &buffer) == 0) {
+					jpeg_data.assign((unsigned char*)capture_buffer.start,
+									 (unsigned char*)capture_buffer.start + buffer.m.planes[0].bytesused);
+					dequeued = true;
+					break;
+				}
+
+				FD_ZERO(&read_fds);
+				FD_SET(fd, &read_fds);
+			}
+
+			if (!dequeued) {
+				GS_LOG_MSG(warning, "GsHwJpegEncoder - timed out waiting for the codec.");
+			}
+			else {
+				// Reclaim the consumed input buffer as well
+				std::memset(&buffer, 0, sizeof(buffer));
+				std::memset(planes, 0, sizeof(planes));
+				buffer.type = V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE;
+				buffer.memory = V4L2_MEMORY_MMAP;
+				buffer.length = 1;
+				buffer.m.planes = planes;
+				ioctl(fd, VIDIOC_DQBUF, &buffer);
+
+				success = true;
+			}
+
+			ioctl(fd, VIDIOC_STREAMOFF, &output_type);
+			ioctl(fd, VIDIOC_STREAMOFF, &capture_type);
+
+		} while (false);
+
+		ReleaseBuffers(fd, V4L2_BUF_TYPE_VIDEO_OUTPUT_MPLANE, output_buffer);
+		ReleaseBuffers(fd, V4L2_BUF_TYPE_VIDEO_CAPTURE_MPLANE, capture_buffer);
+
+		return success;
+	}
+
+#else
+
+	bool GsHwJpegEncoder::IsAvailable() {
+		return false;
+	}
+
+	bool GsHwJpegEncoder::EncodeToBuffer(const cv::Mat& img, int quality, std::vector<unsigned char>& jpeg_data) {
+		return false;
+	}
+
+#endif // #ifdef __unix__
+
+
+	bool GsHwJpegEncoder::EncodeToFile(const cv::Mat& img, const std::string& fname, int quality) {
+
+		// Only JPEG targets can go through the codec - .png (and anything else)
+		// always takes the software path
+		if (fname.find(".jpg") == std::string::npos && fname.find(".jpeg") == std::string::npos) {
+			return false;
+		}
+
+		if (img.empty() || !IsAvailable()) {
+			return false;
+		}
+
+		std::vector<unsigned char> jpeg_data;
+
+		if (!EncodeToBuffer(img, quality, jpeg_data) || jpeg_data.empty()) {
+			return false;
+		}
+
+		std::ofstream output_file(fname, std::ios::binary | std::ios::trunc);
+
+		if (!output_file) {
+			GS_LOG_MSG(warning, "GsHwJpegEncoder - could not open output file: " + fname);
+			return false;
+		}
+
+		output_file.write((const char*)jpeg_data.data(), (std::streamsize)jpeg_data.size());
+
+		return output_file.good();
+	}
+
+}
@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// A thin wrapper around the Pi's V4L2 memory-to-memory JPEG codec (the
+// bcm2835-codec encoder, typically /dev/video31 on a Pi 4).  Software JPEG
+// encodes of full frames take 150-300ms each, and the system emits several
+// per shot.  Where no JPEG codec node exists (for example on the Pi 5),
+// EncodeToFile simply returns false and the caller falls back to the
+// software (cv::imwrite) path.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+	class GsHwJpegEncoder {
+
+	public:
+
+		static const int kDefaultJpegQuality = 90;
+
+		// Returns true only if a JPEG-capable V4L2 codec node was found.
+		// The device probe happens once, on the first call.
+		static bool IsAvailable();
+
+		// Encodes img (BGR or grayscale) to fname using the hardware codec.
+		// Returns false - without touching the file - if fname is not a
+		// .jpg/.jpeg target, no codec node is present, or the encode failed.
+		// The caller should fall back to a software encode in that case.
+		static bool EncodeToFile(const cv::Mat& img, const std::string& fname, int quality = kDefaultJpegQuality);
+
+	protected:
+
+		// Performs the actual memory-to-memory encode.  Returns false on any
+		// V4L2 failure (and marks the codec unavailable if the failure was
+		// during device negotiation).
+		static bool EncodeToBuffer(const cv::Mat& img, int quality, std::vector<unsigned char>& jpeg_data);
+	};
+
+}
@@ -0,0 +1,161 @@
+/*****************************************************************//**
+ * \file   gs_image_io.cpp
+ * \brief  Cached and scale-on-decode still-image reads for the replay paths.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "gs_image_io.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+
+namespace golf_sim {
+
+    bool GsImageIo::kUseImageReadCache = false;
+    int GsImageIo::kImageReadCacheMaxMegabytes = 256;
+
+    namespace {
+
+        struct ImageCacheEntry {
+            std::string key;
+            cv::Mat image;
+            size_t bytes = 0;
+        };
+
+        // Front of the list is the most recently used entry.  The index maps
+        // cache keys to their list positions so hits are O(1).
+        std::mutex image_cache_mutex;
+        std::list<ImageCacheEntry> image_cache_entries;
+        std::unordered_map<std::string, std::list<ImageCacheEntry>::iterator> image_cache_index;
+        size_t image_cache_bytes = 0;
+
+        // Reduced and full-size decodes of the same file are distinct entries
+        std::string ImageCacheKey(const std::string& file_name, int imread_flags) {
+            return file_name + "|" + std::to_string(imread_flags);
+        }
+
+        cv::Mat CachedRead(const std::string& file_name, int imread_flags) {
+
+            const std::string key = ImageCacheKey(file_name, imread_flags);
+
+            {
+                std::lock_guard<std::mutex> lock(image_cache_mutex);
+
+                auto it = image_cache_index.find(key);
+                if (it != image_cache_index.end()) {
+                    // Move to the front and hand back a private copy so the
+                    // caller can mutate it like a fresh decode
+                    image_cache_entries.splice(image_cache_entries.begin(), image_cache_entries, it->second);
+                    return it->second->image.clone();
+                }
+            }
+
+            // Decode outside the lock - a miss shouldn't stall other readers
+            cv::Mat decoded = cv::imread(file_name, imread_flags);
+
+            if (decoded.empty()) {
+                return decoded;
+            }
+
+            size_t bytes = decoded.total() * decoded.elemSize();
+            size_t limit = (size_t)std::max(1, GsImageIo::kImageReadCacheMaxMegabytes) * 1024 * 1024;
+
+            if (bytes <= limit) {
+                std::lock_guard<std::mutex> lock(image_cache_mutex);
+
+                if (image_cache_index.find(key) == image_cache_index.end()) {
+                    image_cache_entries.push_front(ImageCacheEntry{ key, decoded, bytes });
+                    image_cache_index[key] = image_cache_entries.begin();
+                    image_cache_bytes += bytes;
+
+                    while (image_cache_bytes > limit && image_cache_entries.size() > 1) {
+                        ImageCacheEntry& oldest = image_cache_entries.back();
+                        GS_LOG_TRACE_MSG(trace, "GsImageIo - evicting cached decode of " + oldest.key);
+                        image_cache_bytes -= oldest.bytes;
+                        image_cache_index.erase(oldest.key);
+                        image_cache_entries.pop_back();
+                    }
+                }
+            }
+
+            // The freshly-decoded Mat now shares its pixels with the cache
+            // entry, so give the caller a private copy here as well
+            return decoded.clone();
+        }
+
+    }  // namespace
+
+
+    void GsImageIo::Initialize() {
+        GolfSimConfiguration::SetConstant("gs_config.testing.kUseImageReadCache", kUseImageReadCache);
+        GolfSimConfiguration::SetConstant("gs_config.testing.kImageReadCacheMaxMegabytes", kImageReadCacheMaxMegabytes);
+    }
+
+    cv::Mat GsImageIo::ReadImage(const std::string& file_name, int imread_flags) {
+
+        if (!kUseImageReadCache) {
+            return cv::imread(file_name, imread_flags);
+        }
+
+        return CachedRead(file_name, imread_flags);
+    }
+
+    cv::Mat GsImageIo::ReadImageReduced(const std::string& file_name, int reduction) {
+
+        int imread_flags = cv::IMREAD_COLOR;
+
+        switch (reduction) {
+            case 1:
+                break;
+            case 2:
+                imread_flags = cv::IMREAD_REDUCED_COLOR_2;
+                break;
+            case 4:
+                imread_flags = cv::IMREAD_REDUCED_COLOR_4;
+                break;
+            default:
+                LoggingTools::Warning("GsImageIo::ReadImageReduced - unsupported reduction " +
+                    std::to_string(reduction) + ". Decoding full size.");
+                break;
+        }
+
+        return ReadImage(file_name, imread_flags);
+    }
+
+    int GsImageIo::ReductionForTargetWidth(int source_width, int target_width) {
+
+        if (source_width <= 0 || target_width <= 0) {
+            return 1;
+        }
+
+        if (source_width / 4 >= target_width) {
+            return 4;
+        }
+
+        if (source_width / 2 >= target_width) {
+            return 2;
+        }
+
+        return 1;
+    }
+
+    void GsImageIo::ClearCache() {
+        std::lock_guard<std::mutex> lock(image_cache_mutex);
+        image_cache_entries.clear();
+        image_cache_index.clear();
+        image_cache_bytes = 0;
+    }
+
+}
@@ -0,0 +1,72 @@
+/*****************************************************************//**
+ * \file   gs_image_io.h
+ * \brief  Cached and scale-on-decode still-image reads for the replay paths.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <string>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgcodecs.hpp>
+
+namespace golf_sim {
+
+    // The canned-photo, two-image-test and automated-test-corpus paths decode
+    // the same full-size files over and over through cv::imread - the
+    // simulated camera re-decodes its canned images on every take_photo, and
+    // a corpus run re-decodes each image on every pass.  This facade puts a
+    // small byte-bounded LRU cache in front of those reads and exposes
+    // scale-on-decode variants (OpenCV's IMREAD_REDUCED_COLOR_2/_4, which
+    // libjpeg/libjpeg-turbo serves as a true scaled decode for JPEG sources)
+    // for consumers that immediately downscale.
+    //
+    // The cache assumes the files are immutable for the life of the process,
+    // which holds for the test corpus and canned camera images it fronts.
+    // Readers of files that get rewritten at runtime (e.g. the gs_log
+    // images) should stay on cv::imread, or call ClearCache() between passes.
+
+    class GsImageIo {
+
+    public:
+
+        // Off by default (gs_config.testing.kUseImageReadCache); when
+        // disabled every call falls straight through to cv::imread.
+        static bool kUseImageReadCache;
+
+        // Upper bound on the decoded bytes the cache will hold.  Images
+        // larger than the whole budget are returned but never cached.
+        static int kImageReadCacheMaxMegabytes;
+
+        // Reads the configuration values above.  Call once at startup,
+        // after the JSON configuration has been parsed.
+        static void Initialize();
+
+        // Drop-in replacement for cv::imread on the replay/corpus paths.
+        // Cache hits return a private copy, so callers remain free to draw
+        // on or resize the result just as with a fresh decode.
+        static cv::Mat ReadImage(const std::string& file_name, int imread_flags = cv::IMREAD_COLOR);
+
+        // Scale-on-decode read for consumers that immediately downscale.
+        // reduction must be 1, 2 or 4 (anything else is warned about and
+        // treated as 1).  Reduced reads are cached separately from
+        // full-size reads of the same file.
+        static cv::Mat ReadImageReduced(const std::string& file_name, int reduction);
+
+        // Largest supported reduction (1, 2 or 4) that still leaves the
+        // decoded width at or above target_width.
+        static int ReductionForTargetWidth(int source_width, int target_width);
+
+        // Discard every cached decode and return the memory.
+        static void ClearCache();
+    };
+
+}
@@ -0,0 +1,466 @@
+/*****************************************************************//**
+ * \file   gs_ipc_bench.cpp
+ * \brief  Round-trip latency/throughput benchmark for the IPC transport.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+ /* SPDX-License-Identifier: GPL-2.0-only */
+ /*
+  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+  */
+
+// Builds as the (optional) pitrac_ipc_bench executable.  The benchmark opens
+// its own producer and consumer on a bench-only topic ("Golf.Sim.IpcBench"),
+// publishes messages of each class the launch monitor actually sends
+// (control, status, hit results, and Mat-bearing at several payload sizes),
+// and times the round trip from send to receipt of its own message back from
+// the broker - including the real serialization and deserialization code
+// (GsIPCMat / msgpack) on both ends.  It reports wall-clock percentiles per
+// message class plus a back-to-back throughput figure.
+//
+// Usage:
+//      pitrac_ipc_bench <broker_URI> [iterations] [config_file]
+//
+// e.g.   pitrac_ipc_bench "tcp://localhost:61616" 200
+//        pitrac_ipc_bench "tcp://rsp05.local:61616" 200
+//
+// Run it once against the local broker and once against the remote one to
+// separate broker cost from network cost.  The optional config file applies
+// the usual gs_config.ipc_interface constants (image compression, flat
+// encoding), so the benchmark measures the transport as configured.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <activemq/library/ActiveMQCPP.h>
+#include <activemq/core/ActiveMQConnectionFactory.h>
+#include <cms/Connection.h>
+#include <cms/Session.h>
+#include <cms/BytesMessage.h>
+#include <cms/MessageListener.h>
+
+#include <opencv2/core.hpp>
+
+#include "gs_config.h"
+#include "gs_globals.h"
+#include "logging_tools.h"
+#include "gs_ipc_mat.h"
+#include "gs_ipc_result.h"
+#include "gs_ipc_control_msg.h"
+
+using namespace golf_sim;
+
+
+// The topic is bench-only so that runs against a production broker do not
+// disturb (or get disturbed by) a live launch monitor pair.
+static const std::string kIpcBenchDestination = "Golf.Sim.IpcBench";
+
+enum class BenchMessageClass {
+    kControl,
+    kStatus,
+    kHitResult,
+    kMat
+};
+
+
+// Returns the p-th percentile (0-100) of the sample set using nearest-rank
+static double Percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t rank = (size_t)std::ceil((p / 100.0) * (double)samples.size());
+    if (rank > 0) {
+        rank--;
+    }
+    return samples[rank];
+}
+
+
+static void ReportPercentiles(const std::string& label, const std::vector<double>& samples_ms) {
+    std::cout << std::fixed << std::setprecision(3)
+        << label << ": n=" << samples_ms.size()
+        << "  min=" << Percentile(samples_ms, 0) << "ms"
+        << "  p50=" << Percentile(samples_ms, 50) << "ms"
+        << "  p90=" << Percentile(samples_ms, 90) << "ms"
+        << "  p99=" << Percentile(samples_ms, 99) << "ms"
+        << "  max=" << Percentile(samples_ms, 100) << "ms" << std::endl;
+}
+
+
+// Owns a producer and consumer on the bench topic.  The consumer receives the
+// benchmark's own messages back from the broker; on receipt, the payload is
+// deserialized with the same code the launch monitor uses, and the waiting
+// sender is released.
+class GsIpcBench : public cms::MessageListener {
+
+public:
+
+    bool Connect(const std::string& broker_URI) {
+
+        try {
+            std::unique_ptr<cms::ConnectionFactory> factory(
+                cms::ConnectionFactory::createCMSConnectionFactory(broker_URI));
+
+            connection_ = factory->createConnection();
+            connection_->start();
+
+            session_ = connection_->createSession(cms::Session::AUTO_ACKNOWLEDGE);
+            destination_ = session_->createTopic(kIpcBenchDestination);
+
+            producer_ = session_->createProducer(destination_);
+            producer_->setDeliveryMode(cms::DeliveryMode::NON_PERSISTENT);
+
+            consumer_ = session_->createConsumer(destination_);
+            consumer_->setMessageListener(this);
+        }
+        catch (cms::CMSException& e) {
+            std::cerr << "Could not connect to broker: " << broker_URI << std::endl;
+            e.printStackTrace();
+            return false;
+        }
+
+        return true;
+    }
+
+    void Close() {
+        try {
+            if (connection_ != nullptr) {
+                connection_->close();
+            }
+            delete consumer_;
+            delete producer_;
+            delete destination_;
+            delete session_;
+            delete connection_;
+        }
+        catch (cms::CMSException& e) {
+            e.printStackTrace();
+        }
+    }
+
+    // Called on the CMS dispatch thread for every message the broker echoes
+    // back to us.
+    virtual void onMessage(const cms::Message* message) {
+
+        const cms::BytesMessage* bytes_message = dynamic_cast<const cms::BytesMessage*>(message);
+
+        if (bytes_message == nullptr) {
+            return;
+        }
+
+        // Deserialize with the production code so that the measured round
+        // trip includes both ends of the real transport work
+        try {
+            int message_class = bytes_message->getIntProperty("Bench_Class");
+            int body_length = bytes_message->getBodyLength();
+
+            std::unique_ptr<unsigned char[]> body_data(bytes_message->getBodyBytes());
+
+            switch ((BenchMessageClass)message_class) {
+                case BenchMessageClass::kMat:
+                {
+                    GsIPCMat ipc_mat;
+                    ipc_mat.UnpackMatData((char*)body_data.get(), body_length);
+                    cv::Mat received = ipc_mat.GetImageMat();
+                    if (received.empty()) {
+                        decode_failures_++;
+                    }
+                    break;
+                }
+                case BenchMessageClass::kControl:
+                {
+                    msgpack::object_handle oh;
+                    msgpack::unpack(oh, (const char*)body_data.get(), body_length);
+                    int control_msg_type = 0;
+                    oh.get().convert(control_msg_type);
+                    break;
+                }
+                case BenchMessageClass::kStatus:
+                case BenchMessageClass::kHitResult:
+                {
+                    msgpack::unpacked unpacked_result;
+                    msgpack::unpack(unpacked_result, (const char*)body_data.get(), body_length);
+                    GsIPCResult result = unpacked_result.get().as<GsIPCResult>();
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+        catch (std::exception& ex) {
+            decode_failures_++;
+        }
+        catch (cms::CMSException& e) {
+            decode_failures_++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            received_count_++;
+        }
+        received_signal_.notify_all();
+    }
+
+    // Sends one message carrying the given pre-serialized payload and blocks
+    // until the broker has echoed it back (or the wait times out).  Returns
+    // the round-trip wall time in milliseconds, or a negative value on
+    // timeout.
+    double TimeOneRoundTrip(BenchMessageClass message_class, const char* payload, size_t payload_length) {
+
+        std::unique_ptr<cms::BytesMessage> message(session_->createBytesMessage());
+        message->setIntProperty("Bench_Class", (int)message_class);
+        message->setBodyBytes((const unsigned char*)payload, (int)payload_length);
+
+        int awaited_count;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            awaited_count = received_count_ + 1;
+        }
+
+        auto start_time = std::chrono::steady_clock::now();
+
+        producer_->send(message.get());
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!received_signal_.wait_for(lock, std::chrono::seconds(10),
+                [this, awaited_count] { return received_count_ >= awaited_count; })) {
+            return -1.0;
+        }
+
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_time;
+        return elapsed.count();
+    }
+
+    // Sends num_messages back to back and waits for them all to come back.
+    // Returns the total wall seconds, or a negative value on timeout.
+    double TimeThroughput(BenchMessageClass message_class, const char* payload, size_t payload_length, int num_messages) {
+
+        int awaited_count;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            awaited_count = received_count_ + num_messages;
+        }
+
+        auto start_time = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < num_messages; i++) {
+            std::unique_ptr<cms::BytesMessage> message(session_->createBytesMessage());
+            message->setIntProperty("Bench_Class", (int)message_class);
+            message->setBodyBytes((const unsigned char*)payload, (int)payload_length);
+            producer_->send(message.get());
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!received_signal_.wait_for(lock, std::chrono::seconds(60),
+                [this, awaited_count] { return received_count_ >= awaited_count; })) {
+            return -1.0;
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+        return elapsed.count();
+    }
+
+    long GetDecodeFailures() const { return decode_failures_; }
+
+private:
+
+    cms::Connection* connection_ = nullptr;
+    cms::Session* session_ = nullptr;
+    cms::Destination* destination_ = nullptr;
+    cms::MessageProducer* producer_ = nullptr;
+    cms::MessageConsumer* consumer_ = nullptr;
+
+    std::mutex mutex_;
+    std::condition_variable received_signal_;
+    int received_count_ = 0;
+    std::atomic<long> decode_failures_{ 0 };
+};
+
+
+// Runs the latency loop plus a throughput pass for one payload, reporting both.
+static bool BenchmarkOnePayload(GsIpcBench& bench, const std::string& label, BenchMessageClass message_class,
+                                const char* payload, size_t payload_length, int iterations) {
+
+    // One warm-up round trip to get connections, pools and caches settled
+    bench.TimeOneRoundTrip(message_class, payload, payload_length);
+
+    std::vector<double> samples_ms;
+
+    for (int i = 0; i < iterations; i++) {
+        double round_trip_ms = bench.TimeOneRoundTrip(message_class, payload, payload_length);
+
+        if (round_trip_ms < 0.0) {
+            std::cerr << label << ": round trip timed out - is the broker reachable?" << std::endl;
+            return false;
+        }
+
+        samples_ms.push_back(round_trip_ms);
+    }
+
+    ReportPercentiles(label + " (payload " + std::to_string(payload_length) + " bytes)", samples_ms);
+
+    // Throughput: enough messages to smooth out scheduling, but bounded so
+    // the large Mat payloads do not take forever on a slow link
+    int num_messages = (payload_length > 1000000) ? 20 : 100;
+
+    double total_seconds = bench.TimeThroughput(message_class, payload, payload_length, num_messages);
+
+    if (total_seconds < 0.0) {
+        std::cerr << label << ": throughput pass timed out." << std::endl;
+        return false;
+    }
+
+    double megabytes = (double)payload_length * num_messages / 1.0e6;
+
+    std::cout << std::fixed << std::setprecision(1)
+        << label << " throughput: " << (num_messages / total_seconds) << " msg/s, "
+        << std::setprecision(2) << (megabytes / total_seconds) << " MB/s ("
+        << num_messages << " messages back to back)" << std::endl;
+
+    return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: pitrac_ipc_bench <broker_URI> [iterations] [config_file]" << std::endl;
+            std::cerr << "e.g.:  pitrac_ipc_bench \"tcp://localhost:61616\" 200" << std::endl;
+            return 1;
+        }
+
+        std::string broker_host = argv[1];
+        int iterations = (argc > 2) ? std::stoi(argv[2]) : 100;
+        std::string config_file_name = (argc > 3) ? argv[3] : "";
+
+        LoggingTools::InitLogging();
+        GolfSimGlobals::golf_sim_running_ = true;
+
+        // Apply the configured transport settings (compression, flat
+        // encoding), so the benchmark measures the transport as deployed
+        if (!config_file_name.empty()) {
+            if (!GolfSimConfiguration::Initialize(config_file_name)) {
+                std::cerr << "Could not initialize configuration module using config file: " << config_file_name << std::endl;
+                return 1;
+            }
+
+            GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUseIPCImageCompression", GsIPCMat::kUseIPCImageCompression);
+            GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kIPCJpegQuality", GsIPCMat::kIPCJpegQuality);
+            GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUseFlatImageEncoding", GsIPCMat::kUseFlatImageEncoding);
+        }
+
+        activemq::library::ActiveMQCPP::initializeLibrary();
+
+        std::string broker_URI = "failover:(" + broker_host + ")?useCompression=true&initialReconnectDelay=2000&maxReconnectAttempts=2";
+
+        std::cout << "pitrac_ipc_bench - broker " << broker_host << ", " << iterations
+            << " iteration(s) per message class, topic " << kIpcBenchDestination << "." << std::endl;
+
+        GsIpcBench bench;
+
+        if (!bench.Connect(broker_URI)) {
+            activemq::library::ActiveMQCPP::shutdownLibrary();
+            return 1;
+        }
+
+        bool all_passed = true;
+
+        // Control message: a msgpack'd control type, just as
+        // BuildBytesMessageObjectFromIpcMessage sends it
+        {
+            msgpack::sbuffer serialized_control;
+            msgpack::pack(&serialized_control, (int)GsIPCControlMsgType::kClubChangeToDriver);
+
+            all_passed &= BenchmarkOnePayload(bench, "control", BenchMessageClass::kControl,
+                serialized_control.data(), serialized_control.size(), iterations);
+        }
+
+        // Status message: a GsIPCResult carrying only a status type and text
+        {
+            GsIPCResult status_result;
+            status_result.result_type_ = GsIPCResultType::kWaitingForBallToAppear;
+            status_result.message_ = "Waiting for ball to be teed up.";
+
+            msgpack::sbuffer serialized_status;
+            msgpack::pack(&serialized_status, status_result);
+
+            all_passed &= BenchmarkOnePayload(bench, "status", BenchMessageClass::kStatus,
+                serialized_status.data(), serialized_status.size(), iterations);
+        }
+
+        // Hit-result message: a fully-populated GsIPCResult including the
+        // recent-log-message ride-along that makes real results much larger
+        {
+            GsIPCResult hit_result;
+            hit_result.result_type_ = GsIPCResultType::kHit;
+            hit_result.speed_mpers_ = 70.5;
+            hit_result.launch_angle_deg_ = 12.3;
+            hit_result.side_angle_deg_ = -1.2;
+            hit_result.back_spin_rpm_ = 2850;
+            hit_result.side_spin_rpm_ = -300;
+            hit_result.confidence_ = 5;
+            hit_result.message_ = "Ball Hit - Results returned.";
+            hit_result.image_file_paths_.push_back("ball_exposure_candidates.png");
+            hit_result.image_file_paths_.push_back("ball1_rotated_by_best_angles.png");
+            for (int i = 0; i < 50; i++) {
+                hit_result.log_messages_.push_back("Representative recent log message number " + std::to_string(i) + " riding along with the hit result.");
+            }
+
+            msgpack::sbuffer serialized_hit;
+            msgpack::pack(&serialized_hit, hit_result);
+
+            all_passed &= BenchmarkOnePayload(bench, "hit result", BenchMessageClass::kHitResult,
+                serialized_hit.data(), serialized_hit.size(), iterations);
+        }
+
+        // Mat-bearing messages at several payload sizes, up to the full
+        // 1456x1088 strobed camera-2 frame, packed by the production GsIPCMat
+        // path (so compression settings apply)
+        {
+            struct MatSize { int cols; int rows; };
+            const std::vector<MatSize> mat_sizes = { { 364, 272 }, { 728, 544 }, { 1456, 1088 } };
+
+            for (const MatSize& size : mat_sizes) {
+
+                cv::Mat test_image(size.rows, size.cols, CV_8UC3);
+                cv::randu(test_image, cv::Scalar(0, 0, 0), cv::Scalar(255, 255, 255));
+
+                GsIPCMat ipc_mat;
+                ipc_mat.SetAndPackMat(test_image, GsIPCMat::kUseIPCImageCompression ?
+                    GsIPCMat::kLosslessCompression : GsIPCMat::kNoCompression);
+
+                const msgpack::sbuffer& serialized_mat = ipc_mat.GetSerializedMat();
+
+                all_passed &= BenchmarkOnePayload(bench,
+                    "Mat " + std::to_string(size.cols) + "x" + std::to_string(size.rows),
+                    BenchMessageClass::kMat, serialized_mat.data(), serialized_mat.size(), iterations);
+            }
+        }
+
+        if (bench.GetDecodeFailures() > 0) {
+            std::cerr << bench.GetDecodeFailures() << " received message(s) failed to deserialize." << std::endl;
+            all_passed = false;
+        }
+
+        bench.Close();
+        activemq::library::ActiveMQCPP::shutdownLibrary();
+
+        return all_passed ? 0 : 1;
+    }
+    catch (std::exception const& e) {
+        std::cerr << "pitrac_ipc_bench ERROR: " << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -26,7 +26,10 @@ namespace golf_sim {
         std::map<GsIPCControlMsgType, std::string> result_table =
         { {   GsIPCControlMsgType::kUnknown, "Unknown" },
             { GsIPCControlMsgType::kClubChangeToPutter, "Change club to putter" },
-            { GsIPCControlMsgType::kClubChangeToDriver, "Change club to driver" }
+            { GsIPCControlMsgType::kClubChangeToDriver, "Change club to driver" },
+            { GsIPCControlMsgType::kDumpFlightRecorder, "Dump flight-recorder diagnostics" },
+            { GsIPCControlMsgType::kReloadConfiguration, "Reload configuration" },
+            { GsIPCControlMsgType::kRequestSessionStats, "Request session statistics" }
         };
 
         if (result_table.count(t) == 0) {
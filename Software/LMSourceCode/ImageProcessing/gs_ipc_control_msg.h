@@ -32,6 +32,16 @@ namespace golf_sim {
         kUnknown = 0, 
         kClubChangeToPutter = 1,
         kClubChangeToDriver = 2,
+        // The user flagged the last shot as a mis-read - dump the
+        // flight-recorder diagnostics for it
+        kDumpFlightRecorder = 3,
+        // Re-read golf_sim_config.json and republish the static constants
+        // without restarting the LM process
+        kReloadConfiguration = 4,
+        // Asks for the running per-club session statistics (see
+        // GsSessionStats).  The formatted summary comes back on the normal
+        // status-message path.
+        kRequestSessionStats = 5,
     };
 
     // This class is mostly designed to compartmentalize the details of (De)serializing
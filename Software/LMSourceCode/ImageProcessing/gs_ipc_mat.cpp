@@ -6,26 +6,110 @@
 
 #ifdef __unix__  // Ignore in Windows environment
 
+#include <cstring>
+#include <limits>
+
 #include "logging_tools.h"
+#include "gs_perf_counters.h"
 
 #include "gs_ipc_mat.h"
 
 namespace golf_sim {
 
+    bool GsIPCMat::kUseFlatImageEncoding = false;
+    bool GsIPCMat::kUseIPCImageCompression = false;
+    int GsIPCMat::kIPCJpegQuality = 85;
+
     GsIPCMat::GsIPCMat() {
     }
 
     GsIPCMat::~GsIPCMat() {
     }
 
-    void GsIPCMat::SetAndPackMat(cv::Mat& mat) {
+    void GsIPCMat::Clear() {
+        // clear() on both containers keeps the underlying allocations, which
+        // is the point - the next image of a similar size packs in place.
+        mat_holder_.matrix.clear();
+        mat_holder_.rows = 0;
+        mat_holder_.cols = 0;
+        mat_holder_.type = 0;
+        mat_holder_.compression = 0;
+
+        serialized_image_.clear();
+    }
+
+    void GsIPCMat::SetAndPackMat(cv::Mat& mat, CompressionType compression) {
+
+        GsPerfCounters::ScopedStage perf_stage("GsIPCMat::SetAndPackMat");
+
+        // The image codecs only handle 8-bit images, so anything deeper goes
+        // out raw no matter what the caller asked for.
+        if (mat.depth() != CV_8U) {
+            compression = kNoCompression;
+        }
+
+        switch (compression) {
+            case kLosslessCompression:
+            {
+                // A fast compression level - the point is shrinking the wire
+                // transfer, not squeezing out the last few percent.
+                std::vector<int> png_params = { cv::IMWRITE_PNG_COMPRESSION, 1 };
+                cv::imencode(".png", mat, mat_holder_.matrix, png_params);
+                break;
+            }
+            case kJpegCompression:
+            {
+                std::vector<int> jpeg_params = { cv::IMWRITE_JPEG_QUALITY, kIPCJpegQuality };
+                cv::imencode(".jpg", mat, mat_holder_.matrix, jpeg_params);
+                break;
+            }
+            case kNoCompression:
+            default:
+            {
+                // The flat encoding writes uncompressed pixels straight from
+                // the Mat, so the intermediate copy is only needed for msgpack.
+                if (!kUseFlatImageEncoding) {
+                    mat_holder_.matrix = std::vector<uchar>(mat.data, mat.data + (mat.rows * mat.cols * mat.channels()));
+                }
+                break;
+            }
+        }
 
-        mat_holder_.matrix = std::vector<uchar>(mat.data, mat.data + (mat.rows * mat.cols * mat.channels()));
         mat_holder_.rows = mat.rows;
         mat_holder_.cols = mat.cols;
         mat_holder_.type = mat.type();
+        mat_holder_.compression = (int)compression;
+
+        if (kUseFlatImageEncoding) {
+
+            GsIPCFlatMatHeader header;
+            header.compression = (std::uint8_t)compression;
+            header.rows = mat.rows;
+            header.cols = mat.cols;
+            header.type = mat.type();
+
+            const char* payload = nullptr;
+
+            if (compression == kNoCompression) {
+                header.data_bytes = (std::uint64_t)mat.rows * mat.cols * mat.elemSize();
+                payload = (const char*)mat.data;
+            }
+            else {
+                header.data_bytes = mat_holder_.matrix.size();
+                payload = (const char*)mat_holder_.matrix.data();
+            }
+
+            GS_LOG_TRACE_MSG(trace, "GsIPCMat::SetAndPackMat (flat) called with row/cols/type/compression = " + std::to_string(header.rows) + "/" + std::to_string(header.cols) +
+                "/" + std::to_string(header.type) + "/" + std::to_string((int)header.compression) + ".  Payload bytes: " + std::to_string(header.data_bytes) + ".");
+
+            serialized_image_.write((const char*)&header, sizeof(header));
+            serialized_image_.write(payload, header.data_bytes);
 
-        GS_LOG_TRACE_MSG(trace, "GsIPCMat::SetAndPackMat called with row/cols/type = " + std::to_string(mat_holder_.rows) + "/" + std::to_string(mat_holder_.cols) + "/" + std::to_string(mat_holder_.type) + ".");
+            return;
+        }
+
+        GS_LOG_TRACE_MSG(trace, "GsIPCMat::SetAndPackMat called with row/cols/type/compression = " + std::to_string(mat_holder_.rows) + "/" + std::to_string(mat_holder_.cols) +
+            "/" + std::to_string(mat_holder_.type) + "/" + std::to_string(mat_holder_.compression) + ".  Payload bytes: " + std::to_string(mat_holder_.matrix.size()) + ".");
 
         /* pack/serialize the data using msgpack */
         msgpack::pack(&serialized_image_, mat_holder_);
@@ -42,6 +126,51 @@ namespace golf_sim {
             GS_LOG_TRACE_MSG(trace, "GsIPCMat::GetImageMat called, but no serialized_image data exists!");
             return emptyMat;
         }
+        const char* raw_data = static_cast<const char*>(serialized_image_.data());
+
+        // The marker byte distinguishes the flat fixed-layout format from
+        // msgpack data, whatever the sending build was configured to use.
+        if ((std::uint8_t)raw_data[0] == kFlatMatMarker) {
+
+            if (serialized_image_.size() < sizeof(GsIPCFlatMatHeader)) {
+                GS_LOG_MSG(error, "GsIPCMat::GetImageMat received a truncated flat image header.");
+                return emptyMat;
+            }
+
+            GsIPCFlatMatHeader header;
+            std::memcpy(&header, raw_data, sizeof(header));
+
+            if (header.version > kFlatMatVersion) {
+                GS_LOG_MSG(error, "GsIPCMat::GetImageMat received flat image format version " +
+                    std::to_string((int)header.version) + ", but this build only understands version " +
+                    std::to_string((int)kFlatMatVersion) + ".");
+                return emptyMat;
+            }
+
+            if (serialized_image_.size() - sizeof(header) < header.data_bytes) {
+                GS_LOG_MSG(error, "GsIPCMat::GetImageMat received a truncated flat image payload.");
+                return emptyMat;
+            }
+
+            const char* payload = raw_data + sizeof(header);
+
+            if (header.compression != (int)kNoCompression) {
+                cv::Mat encoded_bytes(1, (int)header.data_bytes, CV_8U, (void*)payload);
+                cv::Mat decoded_mat = cv::imdecode(encoded_bytes, cv::IMREAD_UNCHANGED);
+
+                if (decoded_mat.empty() || decoded_mat.rows != header.rows || decoded_mat.cols != header.cols) {
+                    GS_LOG_MSG(error, "GsIPCMat::GetImageMat could not decode the compressed flat image payload.");
+                    return emptyMat;
+                }
+
+                return decoded_mat;
+            }
+
+            // Have to clone the Mat, as the payload belongs to serialized_image_
+            cv::Mat flat_mat(header.rows, header.cols, header.type, (void*)payload);
+            return flat_mat.clone();
+        }
+
         msgpack::unpacked unpacked_mat_data;
         msgpack::unpack(unpacked_mat_data,
             static_cast<const char*>(serialized_image_.data()),
@@ -49,6 +178,19 @@ namespace golf_sim {
 
         auto unpacked_mat = unpacked_mat_data.get().as<GsIPCMatHolder>();
 
+        if (unpacked_mat.compression != (int)kNoCompression) {
+
+            // The payload is an encoded (PNG or JPEG) image - decode it
+            cv::Mat decoded_mat = cv::imdecode(unpacked_mat.matrix, cv::IMREAD_UNCHANGED);
+
+            if (decoded_mat.empty() || decoded_mat.rows != unpacked_mat.rows || decoded_mat.cols != unpacked_mat.cols) {
+                GS_LOG_MSG(error, "GsIPCMat::GetImageMat could not decode the compressed image payload.");
+                return emptyMat;
+            }
+
+            return decoded_mat;
+        }
+
         /* return back the vector<uchar> to cv::Mat image and show it  */
         cv::Mat mat(unpacked_mat.rows, unpacked_mat.cols,
             unpacked_mat.type, unpacked_mat.matrix.data() );
@@ -69,6 +211,58 @@ namespace golf_sim {
         return true;
     }
 
+
+    bool GsIPCMat::UnpackMatDataDirect(const std::function<int(unsigned char*, int)>& read_body_bytes,
+                                       size_t body_length,
+                                       cv::Mat& direct_mat) {
+
+        GsIPCFlatMatHeader header;
+
+        if (body_length < sizeof(header)) {
+            return false;
+        }
+
+        // The eligibility checks all ride on the (small) header, so a payload
+        // that has to take the buffered path is rejected before any of its
+        // pixel bytes have been read.
+        if (read_body_bytes((unsigned char*)&header, (int)sizeof(header)) != (int)sizeof(header)) {
+            return false;
+        }
+
+        if (header.marker != kFlatMatMarker || header.version > kFlatMatVersion) {
+            // A msgpack-packed payload (or a format from a newer build)
+            return false;
+        }
+
+        if (header.compression != (int)kNoCompression) {
+            // Encoded payloads go through cv::imdecode, which needs the whole
+            // body in one buffer anyway
+            return false;
+        }
+
+        if (body_length - sizeof(header) < header.data_bytes ||
+            header.data_bytes > (std::uint64_t)std::numeric_limits<int>::max()) {
+            GS_LOG_MSG(error, "GsIPCMat::UnpackMatDataDirect received a truncated or over-sized flat image payload.");
+            return false;
+        }
+
+        direct_mat.create(header.rows, header.cols, header.type);
+
+        if (!direct_mat.isContinuous() ||
+            direct_mat.total() * direct_mat.elemSize() != (size_t)header.data_bytes) {
+            GS_LOG_MSG(error, "GsIPCMat::UnpackMatDataDirect - the flat header geometry does not match its payload size.");
+            return false;
+        }
+
+        // The one remaining copy - provider internals straight into the Mat
+        if (read_body_bytes(direct_mat.data, (int)header.data_bytes) != (int)header.data_bytes) {
+            GS_LOG_MSG(error, "GsIPCMat::UnpackMatDataDirect could not read the full image payload.");
+            return false;
+        }
+
+        return true;
+    }
+
 }
 
 #endif // #ifdef __unix__  // Ignore in Windows environment
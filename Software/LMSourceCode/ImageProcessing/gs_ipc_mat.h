@@ -8,6 +8,9 @@
 #ifdef __unix__  // Ignore in Windows environment
 
 
+#include <cstdint>
+#include <functional>
+
 #include <msgpack.hpp>
 
 #include <opencv2/core.hpp>
@@ -33,14 +36,48 @@ namespace golf_sim {
             int rows = 0;
             int cols = 0;
             int type = 0;
-            MSGPACK_DEFINE(matrix, rows, cols, type);
+            // One of the CompressionType values below.  Recorded in the packed
+            // data so the receiving side decodes with whatever codec the
+            // sender chose.
+            int compression = 0;
+            MSGPACK_DEFINE(matrix, rows, cols, type, compression);
         };
 
     public:
+
+        // How the pixel data is encoded inside the serialized message.
+        enum CompressionType {
+            kNoCompression = 0,     // raw pixel bytes (the original format)
+            kLosslessCompression,   // PNG at a fast compression level - for images that feed analysis
+            kJpegCompression        // lossy, kIPCJpegQuality - for display-only images
+        };
+
+        // If true, image payloads are serialized as a small fixed-layout
+        // (and versioned) header followed by the raw pixel (or encoded) bytes,
+        // instead of being packed through msgpack.  Packing becomes a pair of
+        // memcpys rather than a field-by-field walk over a multi-megabyte
+        // vector.  The header starts with a marker byte that msgpack never
+        // emits, so the receive side auto-detects the format and a mixed-build
+        // pair of Pis still interoperates.
+        // See the ipc_interface section of the .json configuration file.
+        static bool kUseFlatImageEncoding;
+
+        // If true, image payloads are compressed per the CompressionType the
+        // caller picks, cutting the multi-megabyte camera-2 transfers down for
+        // slow (e.g., Wi-Fi-bridged) links between the Pis.  Both processes
+        // must run a build that understands the compression field.
+        // See the ipc_interface section of the .json configuration file.
+        static bool kUseIPCImageCompression;
+        static int kIPCJpegQuality;
+
         GsIPCMat();
         virtual ~GsIPCMat();
 
-        void SetAndPackMat(cv::Mat& mat);
+        void SetAndPackMat(cv::Mat& mat, CompressionType compression = kNoCompression);
+
+        // Empties any previously packed image while keeping the buffer
+        // capacity, so a recycled GsIPCMat does not have to re-allocate.
+        void Clear();
 
         const msgpack::sbuffer& GetSerializedMat() const;
 
@@ -55,7 +92,41 @@ namespace golf_sim {
         // Returns true if successful, false otherwise.
         bool UnpackMatData(char* data, size_t length);
 
+        // Zero-copy receive path for flat-encoded, uncompressed image payloads
+        // (see kUseFlatImageEncoding).  The reader callback must read exactly
+        // the requested number of body bytes into the supplied buffer (and
+        // return the number actually read); the header is read first, and the
+        // pixel bytes then go straight from the provider into a freshly
+        // created direct_mat - no intermediate body copy and no staging
+        // through serialized_image_.  Returns false, without touching this
+        // object, when the payload is not eligible (msgpack-packed,
+        // compressed, or truncated) - the caller should then rewind the
+        // provider and take the buffered UnpackMatData path instead.
+        static bool UnpackMatDataDirect(const std::function<int(unsigned char*, int)>& read_body_bytes,
+                                        size_t body_length,
+                                        cv::Mat& direct_mat);
+
     private:
+
+        // The fixed-layout wire header used when kUseFlatImageEncoding is on.
+        // 24 bytes, naturally aligned - no implicit padding.  New fields must
+        // be appended (never inserted) along with a version bump.
+        struct GsIPCFlatMatHeader {
+            std::uint8_t marker = kFlatMatMarker;
+            std::uint8_t version = kFlatMatVersion;
+            std::uint8_t compression = 0;   // One of the CompressionType values
+            std::uint8_t unused = 0;
+            std::int32_t rows = 0;
+            std::int32_t cols = 0;
+            std::int32_t type = 0;
+            std::uint64_t data_bytes = 0;
+        };
+
+        // 0xC1 is the one byte value the msgpack specification reserves as
+        // "never used", so it cleanly distinguishes the two formats.
+        static const std::uint8_t kFlatMatMarker = 0xC1;
+        static const std::uint8_t kFlatMatVersion = 1;
+
         GsIPCMatHolder mat_holder_;
 
         // Will hold the serialized mat
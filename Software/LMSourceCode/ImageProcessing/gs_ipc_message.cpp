@@ -8,6 +8,7 @@
 
 #include "logging_tools.h"
 
+#include "gs_ipc_shm_channel.h"
 #include "gs_ipc_message.h"
 
 
@@ -35,11 +36,74 @@ namespace golf_sim {
         return message_type_;
     }
 
+    void GolfSimIPCMessage::Reset(IPCMessageType message_type) {
+        message_type_ = message_type;
+
+        ipc_mat_.Clear();
+        ipc_result_ = GsIPCResult();
+        ipc_control_message_ = GsIPCControlMsg();
+
+        direct_image_mat_ = cv::Mat();
+        shm_slot_index_ = -1;
+        shm_sequence_ = 0;
+
+        image_band_index_ = 0;
+        image_band_count_ = 1;
+
+        roi_offset_x_ = 0;
+        roi_offset_y_ = 0;
+        roi_full_width_ = 0;
+        roi_full_height_ = 0;
+
+        clock_sync_t1_ns_ = 0;
+        clock_sync_t2_ns_ = 0;
+        clock_sync_t3_ns_ = 0;
+
+        spin_offload_ball1_data_.clear();
+        spin_offload_ball2_data_.clear();
+        spin_offload_split_col_ = 0;
+        spin_offload_rotation_[0] = spin_offload_rotation_[1] = spin_offload_rotation_[2] = 0.0;
+        spin_offload_succeeded_ = false;
+    }
+
     void GolfSimIPCMessage::SetImageMat(cv::Mat& mat) {
-        ipc_mat_.SetAndPackMat(mat);
+
+        // On a single-machine configuration the image can travel through the
+        // shared-memory channel, with only a slot reference going through the
+        // message broker.  That skips the (expensive) serialization entirely.
+        if (GsIPCShmImageChannel::kUseSharedMemoryImageTransport &&
+            GsIPCShmImageChannel::WriteImage(mat, shm_slot_index_, shm_sequence_)) {
+            direct_image_mat_ = mat;
+            return;
+        }
+
+        shm_slot_index_ = -1;
+
+        // Pick the codec by what the image is for: the strobed camera-2 image
+        // feeds the ball analysis and must be lossless, while the pre-image is
+        // display/diagnostic only and can take JPEG.  The choice is recorded
+        // in the packed payload, so the receiver decodes accordingly.
+        GsIPCMat::CompressionType compression = GsIPCMat::kNoCompression;
+
+        if (GsIPCMat::kUseIPCImageCompression) {
+            if (message_type_ == IPCMessageType::kCamera2ReturnPreImage) {
+                compression = GsIPCMat::kJpegCompression;
+            }
+            else if (message_type_ == IPCMessageType::kCamera2Image ||
+                     message_type_ == IPCMessageType::kSpinOffloadRequest) {
+                // These images feed the ball analysis and must be lossless
+                compression = GsIPCMat::kLosslessCompression;
+            }
+        }
+
+        ipc_mat_.SetAndPackMat(mat, compression);
     }
 
     cv::Mat GolfSimIPCMessage::GetImageMat() const {
+        if (!direct_image_mat_.empty()) {
+            return direct_image_mat_;
+        }
+
         return ipc_mat_.GetImageMat();
     }
 
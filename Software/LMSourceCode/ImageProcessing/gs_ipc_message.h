@@ -9,6 +9,8 @@
 
 #ifdef __unix__  // Ignore in Windows environment
 
+#include <cstdint>
+
 #include <activemq/commands/ActiveMQBytesMessage.h>
 #include <cms/TextMessage.h>
 #include <opencv2/core.hpp>
@@ -47,7 +49,12 @@ namespace golf_sim {
             kResults = 4,   // The result of the current system's operation, such as a ball hit
             kShutdown = 5,  // Tells the system to shutdown and exit
             kCamera2ReturnPreImage = 6,  // Picture of the 'hit' area before the ball is actually hit
-            kControlMessage = 7    // These are messages coming to the LM from outside
+            kControlMessage = 7,    // These are messages coming to the LM from outside
+            kClockSyncRequest = 8,  // Camera 1 asks camera 2 for a timestamp exchange (see GsClockSync)
+            kClockSyncResponse = 9, // Camera 2's reply, carrying its receive and send times
+            kSpinOffloadRequest = 10,  // Camera 1 ships the two isolated spin-ball crops to camera 2 (see GsSpinOffload)
+            kSpinOffloadResponse = 11,  // Camera 2's computed rotation vector
+            kRequestCamera2FullFrame = 12  // Camera 1 asks camera 2 to resend the full frame behind an ROI-reduced image (see GsCam2PreDetect)
         };
 
 
@@ -60,6 +67,11 @@ namespace golf_sim {
         void SetMessageType(IPCMessageType &message_type);
         IPCMessageType GetMessageType() const;
 
+        // Returns the message to a just-constructed state with the given type.
+        // The internal serialization buffers keep their capacity, so a reused
+        // message (see GsIPCMessagePool) does not have to re-allocate.
+        void Reset(IPCMessageType message_type);
+
         // A serialized copy of the Mat will be made and stored in the message
         // See setters/getters below
         void SetImageMat(cv::Mat& mat);
@@ -74,18 +86,110 @@ namespace golf_sim {
         // Takes the data and unpacks it into the cv::Mat for this object.
         bool UnpackMatData(char* data, size_t length);
 
+        // Shared-memory image transport (see GsIPCShmImageChannel).  When
+        // SetImageMat placed the image into a shared-memory slot instead of
+        // serializing it, these return the slot reference that should travel
+        // in place of the image bytes.  The slot index is -1 otherwise.
+        int GetShmSlotIndex() const { return shm_slot_index_; };
+        std::uint64_t GetShmSequence() const { return shm_sequence_; };
+
+        // Used by the receive path when the image arrived through the
+        // shared-memory channel rather than in the message body.
+        void SetDirectImageMat(const cv::Mat& mat) { direct_image_mat_ = mat; };
+
+        // Banded image transfer (see GolfSimIpcSystem::SendCamera2ImageMessage).
+        // Identifies which horizontal band of the full image this message
+        // carries.  A band count of 1 (the default) means the whole image
+        // travels in this one message.
+        void SetImageBandInfo(int band_index, int band_count) { image_band_index_ = band_index; image_band_count_ = band_count; };
+        int GetImageBandIndex() const { return image_band_index_; };
+        int GetImageBandCount() const { return image_band_count_; };
+
+        // ROI-reduced image transfer (see GsCam2PreDetect).  When the
+        // camera-2 system ships only the candidate ROI of its strobed
+        // frame, these carry the crop's top-left position and the full
+        // frame's dimensions so the receiver can rebuild the canvas.  A
+        // full width of 0 (the default) means the image is not a reduction.
+        void SetRoiInfo(int offset_x, int offset_y, int full_width, int full_height) {
+            roi_offset_x_ = offset_x; roi_offset_y_ = offset_y;
+            roi_full_width_ = full_width; roi_full_height_ = full_height;
+        };
+        int GetRoiOffsetX() const { return roi_offset_x_; };
+        int GetRoiOffsetY() const { return roi_offset_y_; };
+        int GetRoiFullWidth() const { return roi_full_width_; };
+        int GetRoiFullHeight() const { return roi_full_height_; };
+
         const GsIPCResult& GetResults() const { return ipc_result_; };
         GsIPCResult& GetResultsForModification() { return ipc_result_; };
 
         const GsIPCControlMsg& GetControlMessage() const { return ipc_control_message_; };
         GsIPCControlMsg& GetControlMessageForModification() { return ipc_control_message_; };
 
+        // Clock-sync timestamp exchange (see GsClockSync).  t1 is the
+        // requester's send time; t2 and t3 are the responder's receive and
+        // send times.  Each is that machine's own steady clock in
+        // nanoseconds; unused legs are zero.
+        void SetClockSyncTimes(int64_t t1, int64_t t2, int64_t t3) {
+            clock_sync_t1_ns_ = t1; clock_sync_t2_ns_ = t2; clock_sync_t3_ns_ = t3;
+        };
+        int64_t GetClockSyncT1() const { return clock_sync_t1_ns_; };
+        int64_t GetClockSyncT2() const { return clock_sync_t2_ns_; };
+        int64_t GetClockSyncT3() const { return clock_sync_t3_ns_; };
+
+        // Spin-offload exchange (see GsSpinOffload).  The request's image mat
+        // holds the two isolated ball crops side by side, split at split_col;
+        // the ball-data strings carry the geometry GetBallRotation needs
+        // (packed/unpacked by GsSpinOffload).
+        void SetSpinOffloadRequestData(const std::string& ball1_data, const std::string& ball2_data, int split_col) {
+            spin_offload_ball1_data_ = ball1_data;
+            spin_offload_ball2_data_ = ball2_data;
+            spin_offload_split_col_ = split_col;
+        };
+        const std::string& GetSpinOffloadBall1Data() const { return spin_offload_ball1_data_; };
+        const std::string& GetSpinOffloadBall2Data() const { return spin_offload_ball2_data_; };
+        int GetSpinOffloadSplitCol() const { return spin_offload_split_col_; };
+
+        void SetSpinOffloadResult(double x_deg, double y_deg, double z_deg, bool succeeded) {
+            spin_offload_rotation_[0] = x_deg;
+            spin_offload_rotation_[1] = y_deg;
+            spin_offload_rotation_[2] = z_deg;
+            spin_offload_succeeded_ = succeeded;
+        };
+        double GetSpinOffloadRotationX() const { return spin_offload_rotation_[0]; };
+        double GetSpinOffloadRotationY() const { return spin_offload_rotation_[1]; };
+        double GetSpinOffloadRotationZ() const { return spin_offload_rotation_[2]; };
+        bool GetSpinOffloadSucceeded() const { return spin_offload_succeeded_; };
+
     private:
         IPCMessageType message_type_ = IPCMessageType::kUnknown;
 
         GsIPCMat ipc_mat_;
         GsIPCResult ipc_result_;
         GsIPCControlMsg ipc_control_message_;
+
+        // The un-serialized image when it travels through the shared-memory
+        // channel instead of the message body.
+        cv::Mat direct_image_mat_;
+        int shm_slot_index_ = -1;
+        std::uint64_t shm_sequence_ = 0;
+
+        int image_band_index_ = 0;
+        int image_band_count_ = 1;
+
+        int roi_offset_x_ = 0;
+        int roi_offset_y_ = 0;
+        int roi_full_width_ = 0;
+        int roi_full_height_ = 0;
+
+        int64_t clock_sync_t1_ns_ = 0;
+        int64_t clock_sync_t2_ns_ = 0;
+        int64_t clock_sync_t3_ns_ = 0;
+
+        std::string spin_offload_ball1_data_;
+        std::string spin_offload_ball2_data_;
+        int spin_offload_split_col_ = 0;
+        double spin_offload_rotation_[3] = { 0.0, 0.0, 0.0 };
+        bool spin_offload_succeeded_ = false;
     };
 
 }
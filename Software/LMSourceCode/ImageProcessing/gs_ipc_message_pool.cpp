@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include "logging_tools.h"
+
+#include "gs_ipc_message_pool.h"
+
+
+namespace golf_sim {
+
+    bool GsIPCMessagePool::kUseIPCMessagePool = false;
+    int GsIPCMessagePool::kIPCMessagePoolSize = 8;
+
+    std::mutex GsIPCMessagePool::pool_mutex_;
+    std::vector<GolfSimIPCMessage*> GsIPCMessagePool::free_messages_;
+    bool GsIPCMessagePool::pool_initialized_ = false;
+
+    std::atomic<long> GsIPCMessagePool::pool_hit_count_{ 0 };
+    std::atomic<long> GsIPCMessagePool::overflow_count_{ 0 };
+
+
+    std::shared_ptr<GolfSimIPCMessage> GsIPCMessagePool::AcquireMessage(GolfSimIPCMessage::IPCMessageType message_type) {
+
+        if (kUseIPCMessagePool) {
+
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+
+            // Created lazily so that the pool size can first be set from the
+            // .json configuration file.
+            if (!pool_initialized_) {
+                GS_LOG_TRACE_MSG(trace, "GsIPCMessagePool creating " + std::to_string(kIPCMessagePoolSize) + " pooled messages.");
+
+                for (int i = 0; i < kIPCMessagePoolSize; i++) {
+                    free_messages_.push_back(new GolfSimIPCMessage());
+                }
+                pool_initialized_ = true;
+            }
+
+            if (!free_messages_.empty()) {
+                GolfSimIPCMessage* message = free_messages_.back();
+                free_messages_.pop_back();
+
+                message->Reset(message_type);
+
+                pool_hit_count_.fetch_add(1, std::memory_order_relaxed);
+
+                // The custom deleter sends the message back to the pool when
+                // the last reference goes away.
+                return std::shared_ptr<GolfSimIPCMessage>(message, ReturnMessage);
+            }
+
+            // Pool exhausted - fall through and heap-allocate.  The default
+            // deleter means this overflow message will not be pooled.
+            GS_LOG_TRACE_MSG(trace, "GsIPCMessagePool exhausted - heap-allocating an overflow message.");
+
+            overflow_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        return std::shared_ptr<GolfSimIPCMessage>(new GolfSimIPCMessage(message_type));
+    }
+
+    void GsIPCMessagePool::ReturnMessage(GolfSimIPCMessage* message) {
+
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+
+        // If the pool has already shut down, just release the message.
+        if (!pool_initialized_) {
+            delete message;
+            return;
+        }
+
+        free_messages_.push_back(message);
+    }
+
+    void GsIPCMessagePool::GetStatistics(long& pool_hits, long& overflow_allocations) {
+        pool_hits = pool_hit_count_.load(std::memory_order_relaxed);
+        overflow_allocations = overflow_count_.load(std::memory_order_relaxed);
+    }
+
+    void GsIPCMessagePool::Shutdown() {
+
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+
+        for (GolfSimIPCMessage* message : free_messages_) {
+            delete message;
+        }
+        free_messages_.clear();
+        pool_initialized_ = false;
+    }
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// Recycles GolfSimIPCMessage objects so that the steady-state IPC receive
+// path (which includes high-rate status traffic to the GUI) does not have
+// to heap-allocate a message - and the serialization buffers inside it -
+// for every single ActiveMQ message.
+
+#pragma once
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "gs_ipc_message.h"
+
+
+namespace golf_sim {
+
+    class GsIPCMessagePool {
+
+    public:
+
+        // If true, received IPC messages are drawn from (and automatically
+        // returned to) a fixed-size pool instead of being heap-allocated per
+        // message.  A recycled message keeps the capacity of its internal
+        // serialization buffers, so repeat traffic runs allocation-free.
+        // See the ipc_interface section of the .json configuration file.
+        static bool kUseIPCMessagePool;
+        static int kIPCMessagePoolSize;
+
+        // Returns a message of the given type, reset and ready for use.
+        // When the pool is enabled, the message returns to the pool
+        // automatically when the last shared_ptr reference goes away.  If the
+        // pool is disabled (or momentarily exhausted), the message is simply
+        // heap-allocated as before.
+        static std::shared_ptr<GolfSimIPCMessage> AcquireMessage(GolfSimIPCMessage::IPCMessageType message_type);
+
+        // Releases the pooled messages.  Any messages still checked out will
+        // be deleted (not re-pooled) when their last reference goes away.
+        static void Shutdown();
+
+        // Running totals since startup, for the per-shot memory telemetry
+        // (see GsShotTelemetry).  Both zero while the pool is disabled.
+        static void GetStatistics(long& pool_hits, long& overflow_allocations);
+
+    private:
+
+        // The shared_ptr deleter for pooled messages.
+        static void ReturnMessage(GolfSimIPCMessage* message);
+
+        static std::mutex pool_mutex_;
+        static std::vector<GolfSimIPCMessage*> free_messages_;
+        static bool pool_initialized_;
+
+        static std::atomic<long> pool_hit_count_;
+        static std::atomic<long> overflow_count_;
+    };
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
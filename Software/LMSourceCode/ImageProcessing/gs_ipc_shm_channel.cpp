@@ -0,0 +1,229 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <cstring>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logging_tools.h"
+
+#include "gs_ipc_shm_channel.h"
+
+namespace golf_sim {
+
+    // The name under which both processes find the channel.  A leading slash
+    // per shm_open(3); the object appears as /dev/shm/PiTracCam2ImageChannel.
+    static const char* kSharedMemoryChannelName = "/PiTracCam2ImageChannel";
+
+    bool GsIPCShmImageChannel::kUseSharedMemoryImageTransport = false;
+
+    // 1456 * 1088 * 3 - a full-resolution 3-channel GS-camera frame
+    long GsIPCShmImageChannel::kSharedMemorySlotBytes = 4753664;
+
+    GsIPCShmImageChannel::ChannelHeader* GsIPCShmImageChannel::header_ = nullptr;
+    void* GsIPCShmImageChannel::mapped_region_ = nullptr;
+    std::size_t GsIPCShmImageChannel::mapped_size_ = 0;
+
+    static std::mutex shm_channel_mutex;
+
+
+    bool GsIPCShmImageChannel::EnsureChannel(bool create_if_needed) {
+
+        std::lock_guard<std::mutex> lock(shm_channel_mutex);
+
+        if (header_ != nullptr) {
+            return true;
+        }
+
+        std::size_t total_size = sizeof(ChannelHeader) + (std::size_t)kSlotCount * (std::size_t)kSharedMemorySlotBytes;
+
+        int fd = shm_open(kSharedMemoryChannelName, O_RDWR, 0660);
+
+        bool created = false;
+
+        if (fd < 0) {
+            if (!create_if_needed) {
+                GS_LOG_TRACE_MSG(trace, "GsIPCShmImageChannel::EnsureChannel - channel does not exist (and this side will not create it).");
+                return false;
+            }
+
+            fd = shm_open(kSharedMemoryChannelName, O_RDWR | O_CREAT | O_EXCL, 0660);
+
+            if (fd < 0) {
+                // Lost a creation race - try a plain open once more
+                fd = shm_open(kSharedMemoryChannelName, O_RDWR, 0660);
+
+                if (fd < 0) {
+                    GS_LOG_MSG(error, "GsIPCShmImageChannel::EnsureChannel - shm_open failed.");
+                    return false;
+                }
+            }
+            else {
+                created = true;
+
+                if (ftruncate(fd, (off_t)total_size) != 0) {
+                    GS_LOG_MSG(error, "GsIPCShmImageChannel::EnsureChannel - ftruncate failed.");
+                    close(fd);
+                    shm_unlink(kSharedMemoryChannelName);
+                    return false;
+                }
+            }
+        }
+
+        void* mapping = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+        // The mapping keeps its own reference to the object
+        close(fd);
+
+        if (mapping == MAP_FAILED) {
+            GS_LOG_MSG(error, "GsIPCShmImageChannel::EnsureChannel - mmap failed.");
+            return false;
+        }
+
+        ChannelHeader* header = reinterpret_cast<ChannelHeader*>(mapping);
+
+        if (created) {
+            // shm objects start zero-filled, so the atomics and counters are
+            // already in a sane state.  Publish the layout, magic last.
+            header->slot_count = kSlotCount;
+            header->slot_bytes = (std::uint64_t)kSharedMemorySlotBytes;
+            header->magic.store(kChannelMagic, std::memory_order_release);
+        }
+        else if (header->magic.load(std::memory_order_acquire) != kChannelMagic) {
+            // The creator has not finished initializing (or the object is not
+            // ours).  Treat the channel as unavailable for now.
+            GS_LOG_TRACE_MSG(trace, "GsIPCShmImageChannel::EnsureChannel - channel not (yet) initialized.");
+            munmap(mapping, total_size);
+            return false;
+        }
+        else if (header->slot_count != (std::uint32_t)kSlotCount ||
+                 header->slot_bytes != (std::uint64_t)kSharedMemorySlotBytes) {
+            GS_LOG_MSG(error, "GsIPCShmImageChannel::EnsureChannel - channel layout mismatch.  Check that both processes use the same kSharedMemorySlotBytes.");
+            munmap(mapping, total_size);
+            return false;
+        }
+
+        mapped_region_ = mapping;
+        mapped_size_ = total_size;
+        header_ = header;
+
+        GS_LOG_TRACE_MSG(trace, "GsIPCShmImageChannel::EnsureChannel - channel mapped with " + std::to_string(kSlotCount) +
+            " slots of " + std::to_string(kSharedMemorySlotBytes) + " bytes each.");
+
+        return true;
+    }
+
+
+    std::uint8_t* GsIPCShmImageChannel::SlotData(int slot_index) {
+        return reinterpret_cast<std::uint8_t*>(mapped_region_) + sizeof(ChannelHeader) +
+            (std::size_t)slot_index * (std::size_t)header_->slot_bytes;
+    }
+
+
+    bool GsIPCShmImageChannel::WriteImage(const cv::Mat& mat, int& slot_index, std::uint64_t& sequence) {
+
+        if (!EnsureChannel(true /* create_if_needed */)) {
+            return false;
+        }
+
+        std::size_t data_bytes = mat.total() * mat.elemSize();
+
+        if (mat.empty() || data_bytes > header_->slot_bytes) {
+            GS_LOG_TRACE_MSG(trace, "GsIPCShmImageChannel::WriteImage - image of " + std::to_string(data_bytes) +
+                " bytes does not fit a slot of " + std::to_string(header_->slot_bytes) + " bytes.");
+            return false;
+        }
+
+        // The copy below assumes contiguous pixel data
+        cv::Mat continuous_mat = mat.isContinuous() ? mat : mat.clone();
+
+        std::uint64_t new_sequence = header_->next_sequence.fetch_add(1, std::memory_order_relaxed) + 1;
+        int new_slot_index = (int)(new_sequence % header_->slot_count);
+
+        SlotHeader& slot = header_->slots[new_slot_index];
+
+        // Mark the slot in-progress so a concurrent reader of the previous
+        // image in this slot sees it as gone rather than reading torn data
+        slot.sequence.store(0, std::memory_order_release);
+
+        slot.rows = continuous_mat.rows;
+        slot.cols = continuous_mat.cols;
+        slot.type = continuous_mat.type();
+        slot.data_bytes = data_bytes;
+
+        std::memcpy(SlotData(new_slot_index), continuous_mat.data, data_bytes);
+
+        // Publish
+        slot.sequence.store(new_sequence, std::memory_order_release);
+
+        slot_index = new_slot_index;
+        sequence = new_sequence;
+
+        return true;
+    }
+
+
+    bool GsIPCShmImageChannel::ReadImage(int slot_index, std::uint64_t sequence, cv::Mat& mat) {
+
+        if (!EnsureChannel(false /* create_if_needed */)) {
+            return false;
+        }
+
+        if (slot_index < 0 || slot_index >= (int)header_->slot_count || sequence == 0) {
+            GS_LOG_MSG(error, "GsIPCShmImageChannel::ReadImage - invalid slot index " + std::to_string(slot_index) +
+                " or sequence " + std::to_string(sequence) + ".");
+            return false;
+        }
+
+        SlotHeader& slot = header_->slots[slot_index];
+
+        if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+            GS_LOG_MSG(warning, "GsIPCShmImageChannel::ReadImage - slot " + std::to_string(slot_index) +
+                " no longer holds sequence " + std::to_string(sequence) + " (producer has lapped the ring).");
+            return false;
+        }
+
+        cv::Mat slot_mat(slot.rows, slot.cols, slot.type, SlotData(slot_index));
+        cv::Mat copied_mat = slot_mat.clone();
+
+        // Re-check after the copy - if the producer overwrote the slot while
+        // we were reading, the copy may be torn and must be discarded
+        if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+            GS_LOG_MSG(warning, "GsIPCShmImageChannel::ReadImage - slot " + std::to_string(slot_index) +
+                " was overwritten during the read.");
+            return false;
+        }
+
+        mat = copied_mat;
+
+        return true;
+    }
+
+
+    void GsIPCShmImageChannel::Shutdown() {
+
+        std::lock_guard<std::mutex> lock(shm_channel_mutex);
+
+        if (mapped_region_ != nullptr) {
+            munmap(mapped_region_, mapped_size_);
+            mapped_region_ = nullptr;
+            mapped_size_ = 0;
+            header_ = nullptr;
+        }
+
+        // The shared-memory object itself is deliberately left in place so
+        // that the peer process can keep using (or re-open) it.
+    }
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// Shared-memory transport for the large camera-2 image messages.  On the
+// single-Pi configuration, both LM processes run on one machine, but the
+// strobed image still travels through the ActiveMQ broker as a serialized,
+// multi-megabyte message body.  This channel instead keeps a small ring of
+// preallocated image slots in shared memory; the image pixels are written
+// into a slot once, and only a slot index and sequence number travel through
+// the broker.
+
+#pragma once
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <atomic>
+#include <cstdint>
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+    class GsIPCShmImageChannel {
+
+    public:
+
+        // If true, camera-2 image messages carry only a shared-memory slot
+        // reference instead of the serialized image.  Only valid when the
+        // producing and consuming processes are on the same machine (e.g.,
+        // the single-Pi configuration) - they find the channel by name.
+        // See the ipc_interface section of the .json configuration file.
+        static bool kUseSharedMemoryImageTransport;
+
+        // The size of each preallocated image slot.  Images larger than this
+        // fall back to the serialized in-message transport.  The default
+        // covers a full-resolution 1456x1088 3-channel frame.
+        static long kSharedMemorySlotBytes;
+
+        // Number of image slots in the ring.  The producer overwrites the
+        // oldest slot, so this bounds how many in-flight images can exist
+        // before a not-yet-consumed image is lost.
+        static const int kSlotCount = 4;
+
+        // Copies the image pixels into the next ring slot.  Returns the slot
+        // index and the publication sequence number to send to the consumer.
+        // Returns false (and the caller should fall back to the serialized
+        // transport) if the channel cannot be created or the image does not
+        // fit in a slot.
+        static bool WriteImage(const cv::Mat& mat, int& slot_index, std::uint64_t& sequence);
+
+        // Retrieves the image published under the given slot index and
+        // sequence number.  Returns false if the channel cannot be opened or
+        // the slot has already been overwritten by a later image.
+        static bool ReadImage(int slot_index, std::uint64_t sequence, cv::Mat& mat);
+
+        // Unmaps the channel.  The underlying shared-memory object is left in
+        // place for the peer process.
+        static void Shutdown();
+
+    private:
+
+        struct SlotHeader {
+            // 0 while the producer is writing the slot, otherwise the
+            // publication sequence number of the image the slot holds.
+            std::atomic<std::uint64_t> sequence;
+            std::int32_t rows;
+            std::int32_t cols;
+            std::int32_t type;
+            std::uint64_t data_bytes;
+        };
+
+        struct ChannelHeader {
+            // Set last during creation so an opening process can tell the
+            // channel is fully initialized.
+            std::atomic<std::uint32_t> magic;
+            std::uint32_t slot_count;
+            std::uint64_t slot_bytes;
+            std::atomic<std::uint64_t> next_sequence;
+            SlotHeader slots[kSlotCount];
+        };
+
+        static const std::uint32_t kChannelMagic = 0x47534943;  // "GSIC"
+
+        // Maps (creating first if asked and necessary) the shared-memory
+        // channel into this process.  Idempotent after the first success.
+        static bool EnsureChannel(bool create_if_needed);
+
+        static std::uint8_t* SlotData(int slot_index);
+
+        static ChannelHeader* header_;
+        static void* mapped_region_;
+        static std::size_t mapped_size_;
+    };
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
@@ -5,10 +5,22 @@
 
 #ifdef __unix__  // Ignore in Windows environment
 
+#include <atomic>
+#include <memory>
+
 #include "gs_globals.h"
 #include "logging_tools.h"
 
+#include "gs_clock_sync.h"
+#ifdef __unix__
+#include "gs_direct_transport.h"
+#endif
+#include "gs_shot_trace.h"
+#include "gs_spin_offload.h"
+#include "gs_cam2_predetect.h"
 #include "gs_ipc_message.h"
+#include "gs_ipc_message_pool.h"
+#include "gs_ipc_shm_channel.h"
 #include "gs_options.h"
 #include "gs_config.h"
 #include "gs_ipc_system.h"
@@ -81,9 +93,124 @@ namespace golf_sim {
 
     std::string GolfSimIpcSystem::kActiveMQLMIdProperty = "LM_System_ID";
 
+    std::string GolfSimIpcSystem::kActiveMQBayId = "";
+    bool GolfSimIpcSystem::kUsePartitionedImageDestination = true;
+    bool GolfSimIpcSystem::kUseZeroCopyImageReceive = false;
+
+    const std::string GolfSimIpcSystem::kShmImageSlotProperty = "SHM_Image_Slot";
+    const std::string GolfSimIpcSystem::kShmImageSequenceProperty = "SHM_Image_Sequence";
+
+    const std::string GolfSimIpcSystem::kImageBandIndexProperty = "Image_Band_Index";
+    const std::string GolfSimIpcSystem::kImageBandCountProperty = "Image_Band_Count";
+
+    const std::string GolfSimIpcSystem::kRoiOffsetXProperty = "Roi_Offset_X";
+    const std::string GolfSimIpcSystem::kRoiOffsetYProperty = "Roi_Offset_Y";
+    const std::string GolfSimIpcSystem::kRoiFullWidthProperty = "Roi_Full_Width";
+    const std::string GolfSimIpcSystem::kRoiFullHeightProperty = "Roi_Full_Height";
+
+    const std::string GolfSimIpcSystem::kClockSyncT1Property = "Clock_Sync_T1";
+    const std::string GolfSimIpcSystem::kClockSyncT2Property = "Clock_Sync_T2";
+    const std::string GolfSimIpcSystem::kClockSyncT3Property = "Clock_Sync_T3";
+
+    const std::string GolfSimIpcSystem::kSpinOffloadBall1Property = "Spin_Offload_Ball1";
+    const std::string GolfSimIpcSystem::kSpinOffloadBall2Property = "Spin_Offload_Ball2";
+    const std::string GolfSimIpcSystem::kSpinOffloadSplitColProperty = "Spin_Offload_Split_Col";
+    const std::string GolfSimIpcSystem::kSpinOffloadRotationXProperty = "Spin_Offload_Rotation_X";
+    const std::string GolfSimIpcSystem::kSpinOffloadRotationYProperty = "Spin_Offload_Rotation_Y";
+    const std::string GolfSimIpcSystem::kSpinOffloadRotationZProperty = "Spin_Offload_Rotation_Z";
+    const std::string GolfSimIpcSystem::kSpinOffloadSucceededProperty = "Spin_Offload_Succeeded";
+
+    const std::string GolfSimIpcSystem::kShotTraceIdProperty = "Shot_Trace_Id";
+
+    int GolfSimIpcSystem::kImageTransferBandCount = 1;
+
+
+    namespace {
+        // The published image lives behind an atomically-swapped shared_ptr.  The
+        // IPC dispatch thread builds the new Mat entirely outside any critical
+        // section and then swaps the pointer in; a concurrent FSM-thread reader
+        // either sees the old image or the new one, and whichever it grabbed
+        // stays alive (via the shared_ptr) for as long as the reader needs it.
+        std::shared_ptr<const cv::Mat> last_received_image_ptr;
+
+        // Reassembly state for the banded camera-2 image transfer.  Each band
+        // is decoded the moment it arrives - overlapping the wire transfer of
+        // the bands still in flight - and the strips are concatenated when the
+        // last one lands.  Only the IPC dispatch thread touches this (both
+        // message consumers share one CMS session, which delivers serially).
+        std::vector<cv::Mat> received_image_bands;
+        int received_image_band_count = 0;
+
+        // Accumulates one band.  Returns true (and the full image via
+        // assembled_image) only once every band of the transfer has arrived.
+        bool AssembleImageBand(const cv::Mat& band, int band_index, int band_count, cv::Mat& assembled_image) {
+
+            // The first band of a transfer (or a change in band count, which
+            // means the earlier transfer was abandoned) resets the assembly
+            if (band_index == 0 || band_count != received_image_band_count) {
+                received_image_bands.assign(band_count, cv::Mat());
+                received_image_band_count = band_count;
+            }
+
+            if (band.empty() || band_index < 0 || band_index >= received_image_band_count) {
+                GS_LOG_MSG(error, "GolfSimIpcSystem - received an invalid image band (index " + std::to_string(band_index) +
+                    " of " + std::to_string(band_count) + ").  Discarding the transfer.");
+                received_image_bands.clear();
+                received_image_band_count = 0;
+                return false;
+            }
+
+            received_image_bands[band_index] = band;
+
+            if (band_index < band_count - 1) {
+                return false;
+            }
+
+            // The last band has arrived - make sure none of the earlier ones
+            // were lost before stitching the strips back together
+            for (const cv::Mat& received_band : received_image_bands) {
+                if (received_band.empty()) {
+                    GS_LOG_MSG(error, "GolfSimIpcSystem - a banded image transfer completed with missing bands.  Discarding the transfer.");
+                    received_image_bands.clear();
+                    received_image_band_count = 0;
+                    return false;
+                }
+            }
+
+            cv::vconcat(received_image_bands, assembled_image);
+
+            received_image_bands.clear();
+            received_image_band_count = 0;
+
+            return true;
+        }
+    }
+
+    void GolfSimIpcSystem::StoreLastReceivedImage(const cv::Mat& image) {
+        std::atomic_store(&last_received_image_ptr, std::make_shared<const cv::Mat>(image.clone()));
+    }
+
+    std::string GolfSimIpcSystem::BaseDestinationName() {
+        if (kActiveMQBayId.empty()) {
+            return "Golf.Sim";
+        }
+
+        return "Golf.Sim." + kActiveMQBayId;
+    }
+
+    std::string GolfSimIpcSystem::ImageDestinationName() {
+        return BaseDestinationName() + ".Images";
+    }
 
-    cv::Mat GolfSimIpcSystem::last_received_image_;
-    std::mutex GolfSimIpcSystem::last_received_image_mutex_;
+    cv::Mat GolfSimIpcSystem::GetLastReceivedImage() {
+        std::shared_ptr<const cv::Mat> image_ptr = std::atomic_load(&last_received_image_ptr);
+
+        if (!image_ptr) {
+            return cv::Mat();
+        }
+
+        return image_ptr->clone();
+    }
 
     bool GolfSimIpcSystem::InitializeIPCSystem() {
 
@@ -101,6 +228,42 @@ namespace golf_sim {
             }
         }
 
+        // The shared-memory image channel only works when both LM processes
+        // are on the same machine (e.g., the single-Pi configuration), so it
+        // is off unless the configuration file says otherwise.
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUseSharedMemoryImageTransport", GsIPCShmImageChannel::kUseSharedMemoryImageTransport);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kSharedMemorySlotBytes", GsIPCShmImageChannel::kSharedMemorySlotBytes);
+
+        // Image payload compression for slow links between the Pis.  Both
+        // processes must run a build that understands the compression field.
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUseIPCImageCompression", GsIPCMat::kUseIPCImageCompression);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kIPCJpegQuality", GsIPCMat::kIPCJpegQuality);
+
+        // Flat (versioned, fixed-layout) image serialization.  The receive
+        // side auto-detects the format, so this only gates the send side.
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUseFlatImageEncoding", GsIPCMat::kUseFlatImageEncoding);
+
+        // Zero-copy receive of flat, uncompressed image bodies.
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUseZeroCopyImageReceive", kUseZeroCopyImageReceive);
+
+        // Recycling received messages avoids per-message allocation churn in
+        // the IPC consumer thread.
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUseIPCMessagePool", GsIPCMessagePool::kUseIPCMessagePool);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kIPCMessagePoolSize", GsIPCMessagePool::kIPCMessagePoolSize);
+
+        // Multi-bay brokers: partition this bay's traffic onto its own topics
+        // so the broker filters cross-bay messages before they reach us.
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kActiveMQBayId", kActiveMQBayId);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUsePartitionedImageDestination", kUsePartitionedImageDestination);
+
+        // Banded (streaming) camera-2 image transfer for slow inter-Pi links.
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kImageTransferBandCount", kImageTransferBandCount);
+
+        // Asynchronous (spooled) message sending, so callers never block on
+        // broker I/O.
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kUseAsyncMessageSend", GolfSimMessageProducer::kUseAsyncMessageSend);
+        GolfSimConfiguration::SetConstant("gs_config.ipc_interface.kAsyncSendSpoolSize", GolfSimMessageProducer::kAsyncSendSpoolSize);
+
         activemq::library::ActiveMQCPP::initializeLibrary();
 
 
@@ -184,6 +347,15 @@ namespace golf_sim {
             return false;
         }
 
+#ifdef __unix__
+        // The (optional) direct peer-to-peer link for the image-bearing
+        // message types.  Even if the peer is not up yet, the link thread
+        // keeps trying in the background - the broker carries everything
+        // until it connects.
+        GsDirectTransport::Initialize();
+        GsDirectTransport::Start();
+#endif
+
         std::this_thread::yield();
 
         return true;
@@ -193,6 +365,10 @@ namespace golf_sim {
     bool GolfSimIpcSystem::ShutdownIPCSystem() {
         GS_LOG_TRACE_MSG(trace, "GolfSimIpcSystem::ShutdownIPC");
 
+#ifdef __unix__
+        GsDirectTransport::Stop();
+#endif
+
         // Consumer may be null if test mode skipped initialization
         if (consumer_ != nullptr) {
             consumer_->Shutdown();
@@ -208,6 +384,9 @@ namespace golf_sim {
         }
         delete producer_;
 
+        GsIPCShmImageChannel::Shutdown();
+        GsIPCMessagePool::Shutdown();
+
         activemq::library::ActiveMQCPP::shutdownLibrary();
 
         return true;
@@ -217,13 +396,23 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "DispatchReceivedIpcMessage::Dispatch Received Ipc Message.");
 
-        GolfSimIPCMessage* ipc_message = BuildIpcMessageFromBytesMessage(message);
+        std::shared_ptr<GolfSimIPCMessage> ipc_message = BuildIpcMessageFromBytesMessage(message);
 
         if (ipc_message == nullptr) {
             LoggingTools::Warning("Unable to convert ActiveMQ Message to a GolfSimIPCMessage.");
             return false;
         }
 
+        return DispatchBuiltIpcMessage(ipc_message);
+    }
+
+
+    // The dispatch switch itself, shared by the broker receive path above
+    // and the direct peer-to-peer transport (see GsDirectTransport), which
+    // rebuilds its GolfSimIPCMessages without an ActiveMQ message ever
+    // existing.
+    bool GolfSimIpcSystem::DispatchBuiltIpcMessage(std::shared_ptr<GolfSimIPCMessage> ipc_message) {
+
         bool result = false;
 
         GS_LOG_TRACE_MSG(trace, "DispatchReceivedIpcMessage::Dispatch - message type: " + ipc_message->Format());
@@ -274,6 +463,36 @@ namespace golf_sim {
                 DispatchControlMsgMessage(*ipc_message);
                 break;
             }
+            case GolfSimIPCMessage::IPCMessageType::kClockSyncRequest:
+            {
+                GS_LOG_TRACE_MSG(trace, "Dispatching kClockSyncRequest IPC message.");
+                result = DispatchClockSyncRequestMessage(*ipc_message);
+                break;
+            }
+            case GolfSimIPCMessage::IPCMessageType::kClockSyncResponse:
+            {
+                GS_LOG_TRACE_MSG(trace, "Dispatching kClockSyncResponse IPC message.");
+                result = DispatchClockSyncResponseMessage(*ipc_message);
+                break;
+            }
+            case GolfSimIPCMessage::IPCMessageType::kSpinOffloadRequest:
+            {
+                GS_LOG_TRACE_MSG(trace, "Dispatching kSpinOffloadRequest IPC message.");
+                result = DispatchSpinOffloadRequestMessage(*ipc_message);
+                break;
+            }
+            case GolfSimIPCMessage::IPCMessageType::kSpinOffloadResponse:
+            {
+                GS_LOG_TRACE_MSG(trace, "Dispatching kSpinOffloadResponse IPC message.");
+                result = DispatchSpinOffloadResponseMessage(*ipc_message);
+                break;
+            }
+            case GolfSimIPCMessage::IPCMessageType::kRequestCamera2FullFrame:
+            {
+                GS_LOG_TRACE_MSG(trace, "Dispatching kRequestCamera2FullFrame IPC message.");
+                result = DispatchRequestCamera2FullFrameMessage(*ipc_message);
+                break;
+            }
             default:
             {
                 GS_LOG_MSG(error, "Could not dispatch unknown IPC message of type " +
@@ -282,8 +501,9 @@ namespace golf_sim {
             }
         }
 
-        // We own the new ipc_message, so clean it up here
-        delete ipc_message;
+        // Dropping the last reference returns the message to the pool (or
+        // deletes it, if it was an un-pooled overflow allocation).
+        ipc_message.reset();
 
         std::this_thread::yield();
 
@@ -326,6 +546,95 @@ namespace golf_sim {
         return true;
     }
 
+    bool GolfSimIpcSystem::DispatchClockSyncRequestMessage(const GolfSimIPCMessage& message) {
+
+        GS_LOG_TRACE_MSG(trace, "DispatchClockSyncRequestMessage Received Ipc Message.");
+
+        // Both halves of the system share the broker topic, so each side
+        // sees the other's traffic (and its own).  Only the camera-2 half
+        // answers the exchange.
+        switch (GolfSimOptions::GetCommandLineOptions().system_mode_) {
+
+            case SystemMode::kCamera2:
+            case SystemMode::kRunCam2ProcessForPi1Processing:
+                return GsClockSync::HandleSyncRequest(message);
+
+            default:
+                // This message is only for the camera 2 system.  Ignore it
+                break;
+        }
+
+        return true;
+    }
+
+    bool GolfSimIpcSystem::DispatchClockSyncResponseMessage(const GolfSimIPCMessage& message) {
+
+        GS_LOG_TRACE_MSG(trace, "DispatchClockSyncResponseMessage Received Ipc Message.");
+
+        // Only the camera-1 half (which originated the exchange) folds the
+        // response into its offset/drift model.
+        if (GolfSimOptions::GetCommandLineOptions().system_mode_ == SystemMode::kCamera1) {
+            return GsClockSync::HandleSyncResponse(message);
+        }
+
+        return true;
+    }
+
+    bool GolfSimIpcSystem::DispatchSpinOffloadRequestMessage(const GolfSimIPCMessage& message) {
+
+        GS_LOG_TRACE_MSG(trace, "DispatchSpinOffloadRequestMessage Received Ipc Message.");
+
+        // Only the camera-2 half runs offloaded spin work.  The computation
+        // happens right here on the dispatch thread - camera 2 is otherwise
+        // idle once its strobed image has been sent, and the camera-1
+        // requester has its own timeout-and-compute-locally fallback.
+        switch (GolfSimOptions::GetCommandLineOptions().system_mode_) {
+
+            case SystemMode::kCamera2:
+            case SystemMode::kRunCam2ProcessForPi1Processing:
+                return GsSpinOffload::HandleOffloadRequest(message);
+
+            default:
+                // This message is only for the camera 2 system.  Ignore it
+                break;
+        }
+
+        return true;
+    }
+
+    bool GolfSimIpcSystem::DispatchSpinOffloadResponseMessage(const GolfSimIPCMessage& message) {
+
+        GS_LOG_TRACE_MSG(trace, "DispatchSpinOffloadResponseMessage Received Ipc Message.");
+
+        // Only the camera-1 half (which shipped the crops out) is waiting
+        // for the rotation vector.
+        if (GolfSimOptions::GetCommandLineOptions().system_mode_ == SystemMode::kCamera1) {
+            return GsSpinOffload::HandleOffloadResponse(message);
+        }
+
+        return true;
+    }
+
+    bool GolfSimIpcSystem::DispatchRequestCamera2FullFrameMessage(const GolfSimIPCMessage& message) {
+
+        GS_LOG_TRACE_MSG(trace, "DispatchRequestCamera2FullFrameMessage Received Ipc Message.");
+
+        // Only the camera-2 half retains the full frame behind an ROI
+        // reduction (see GsCam2PreDetect).
+        switch (GolfSimOptions::GetCommandLineOptions().system_mode_) {
+
+            case SystemMode::kCamera2:
+            case SystemMode::kRunCam2ProcessForPi1Processing:
+                return GsCam2PreDetect::HandleFullFrameRequest();
+
+            default:
+                // This message is only for the camera 2 system.  Ignore it
+                break;
+        }
+
+        return true;
+    }
+
 
 
 
@@ -419,6 +728,30 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "DispatchCamera2ImageMessage received Ipc Message.");
 
+        // Decoding here (rather than when the image is consumed) is what lets
+        // a banded transfer overlap its deserialization with the flight of
+        // the later bands.
+        cv::Mat received_image = message.GetImageMat();
+
+        if (message.GetImageBandCount() > 1) {
+            if (!AssembleImageBand(received_image, message.GetImageBandIndex(),
+                                   message.GetImageBandCount(), received_image)) {
+                // Later bands of the image are still in flight
+                return true;
+            }
+        }
+
+        if (message.GetRoiFullWidth() > 0) {
+            // The camera-2 system shipped only the candidate ROI of its
+            // strobed frame (see GsCam2PreDetect) - place it back onto a
+            // full-size canvas so the downstream search geometry is unchanged
+            received_image = GsCam2PreDetect::ExpandRoiImage(received_image,
+                                                             message.GetRoiOffsetX(),
+                                                             message.GetRoiOffsetY(),
+                                                             message.GetRoiFullWidth(),
+                                                             message.GetRoiFullHeight());
+        }
+
         // If in still-image mode, we won't inform the state machine about the message.
         // Instead just save the image so that someone can get to it.
         if (GolfSimOptions::GetCommandLineOptions().camera_still_mode_ ||
@@ -428,10 +761,7 @@ namespace golf_sim {
             GolfSimOptions::GetCommandLineOptions().system_mode_ == SystemMode::kCamera2BallLocation) {
             GS_LOG_TRACE_MSG(trace, "In still-picture, locate or AutoCalibrate camera mode.  Will save received image.");
 
-            {
-                std::lock_guard<std::mutex> lock(last_received_image_mutex_);
-                last_received_image_ = message.GetImageMat().clone();
-            }
+            StoreLastReceivedImage(received_image);
 
             return true;
         }
@@ -451,8 +781,15 @@ namespace golf_sim {
             case SystemMode::kCamera1TestStandalone:
             case SystemMode::kCamera1:
             {
+                // A full frame that a shot's analysis asked for after
+                // rejecting the ROI candidates goes straight to that
+                // waiting thread, not to the FSM (see GsCam2PreDetect)
+                if (GsCam2PreDetect::TryDeliverAwaitedFullFrame(received_image)) {
+                    break;
+                }
+
                 // Let the FSM deal with the message by entering a related message (including the image) into the queue
-                GolfSimEventElement cam2ImageMessageReceived{ new GolfSimEvent::Camera2ImageReceived{ message.GetImageMat() } };
+                GolfSimEventElement cam2ImageMessageReceived{ new GolfSimEvent::Camera2ImageReceived{ received_image } };
                 GS_LOG_TRACE_MSG(trace, "    QueueEvent: " + cam2ImageMessageReceived.e_->Format());
                 GolfSimEventQueue::QueueEvent(cam2ImageMessageReceived);
 
@@ -509,11 +846,10 @@ namespace golf_sim {
 
 
     // Caller owns the resulting message.  Returns nullptr if an error.
-    GolfSimIPCMessage* GolfSimIpcSystem::BuildIpcMessageFromBytesMessage(const BytesMessage& active_mq_message) {
+    std::shared_ptr<GolfSimIPCMessage> GolfSimIpcSystem::BuildIpcMessageFromBytesMessage(const BytesMessage& active_mq_message) {
 
         GS_LOG_TRACE_MSG(trace, "BuildIpcMessageFromBytesMessage called.");
-        GolfSimIPCMessage* ipc_message = nullptr;
-        std::unique_ptr<GolfSimIPCMessage> ipc_message_ptr;
+        std::shared_ptr<GolfSimIPCMessage> ipc_message;
 
         try {
             std::string main_message_type = active_mq_message.getStringProperty(kGolfSimMessageTypeTag);
@@ -533,21 +869,105 @@ namespace golf_sim {
             GS_LOG_TRACE_MSG(trace, "BuildIpcMessageFromBytesMessage converting Active-MQ message of type " + main_message_type +
                                         " and message-type " + std::to_string((int)ipc_message_type) + " to GolfSimIpcMessage");
 
-            ipc_message_ptr.reset(new GolfSimIPCMessage(ipc_message_type));
-            ipc_message = ipc_message_ptr.get();
+            // Take on the sender's shot trace ID (if any) before any further
+            // processing, so that even this message's own handling logs under
+            // the right shot (see GsShotTrace)
+            if (active_mq_message.propertyExists(kShotTraceIdProperty)) {
+                GsShotTrace::AdoptShotTrace((uint64_t)active_mq_message.getLongProperty(kShotTraceIdProperty));
+            }
+
+            // Draw the message from the pool (if enabled) so that steady-state
+            // traffic does not heap-allocate for every received message.
+            ipc_message = GsIPCMessagePool::AcquireMessage(ipc_message_type);
 
             if (ipc_message == nullptr) {
                 return nullptr;
             }
 
             if (ipc_message->GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2Image ||
-                ipc_message->GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2ReturnPreImage) {
-
-                GS_LOG_TRACE_MSG(trace, "BuildIpcMessageFromBytesMessage about to UnpackMatData.");
-                // The ActiveMQ message's Byte body has the serialized data from which
-                // the cv::Mat can be reconstructed.
-                std::unique_ptr<char[]> body_data((char*)active_mq_message.getBodyBytes());
-                ipc_message->UnpackMatData(body_data.get(), active_mq_message.getBodyLength());
+                ipc_message->GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2ReturnPreImage ||
+                ipc_message->GetMessageType() == GolfSimIPCMessage::IPCMessageType::kSpinOffloadRequest) {
+
+                if (active_mq_message.propertyExists(kShmImageSlotProperty)) {
+
+                    // The image pixels traveled through the shared-memory
+                    // channel - the message only carries the slot reference.
+                    int slot_index = active_mq_message.getIntProperty(kShmImageSlotProperty);
+                    std::uint64_t sequence = (std::uint64_t)active_mq_message.getLongProperty(kShmImageSequenceProperty);
+
+                    GS_LOG_TRACE_MSG(trace, "BuildIpcMessageFromBytesMessage retrieving image from shared-memory slot " +
+                        std::to_string(slot_index) + ", sequence " + std::to_string(sequence) + ".");
+
+                    cv::Mat shm_mat;
+
+                    if (!GsIPCShmImageChannel::ReadImage(slot_index, sequence, shm_mat)) {
+                        GS_LOG_MSG(error, "BuildIpcMessageFromBytesMessage could not retrieve the image from the shared-memory channel.");
+                        return nullptr;
+                    }
+
+                    ipc_message->SetDirectImageMat(shm_mat);
+                }
+                else {
+                    bool unpacked_directly = false;
+
+                    if (kUseZeroCopyImageReceive) {
+                        // readBytes() hands the body bytes over without the extra
+                        // heap buffer that getBodyBytes() allocates.  Reading only
+                        // moves the provider's read position, so the const_cast is
+                        // benign - and an ineligible payload is rewound below for
+                        // the buffered path.
+                        BytesMessage& readable_message = const_cast<BytesMessage&>(active_mq_message);
+
+                        auto read_body_bytes = [&readable_message](unsigned char* dest, int length) -> int {
+                            return readable_message.readBytes(dest, length);
+                        };
+
+                        cv::Mat direct_mat;
+
+                        if (GsIPCMat::UnpackMatDataDirect(read_body_bytes,
+                                                          (size_t)active_mq_message.getBodyLength(),
+                                                          direct_mat)) {
+                            GS_LOG_TRACE_MSG(trace, "BuildIpcMessageFromBytesMessage read the image body directly into the destination Mat.");
+                            ipc_message->SetDirectImageMat(direct_mat);
+                            unpacked_directly = true;
+                        }
+                        else {
+                            readable_message.reset();
+                        }
+                    }
+
+                    if (!unpacked_directly) {
+                        GS_LOG_TRACE_MSG(trace, "BuildIpcMessageFromBytesMessage about to UnpackMatData.");
+                        // The ActiveMQ message's Byte body has the serialized data from which
+                        // the cv::Mat can be reconstructed.
+                        std::unique_ptr<char[]> body_data((char*)active_mq_message.getBodyBytes());
+                        ipc_message->UnpackMatData(body_data.get(), active_mq_message.getBodyLength());
+                    }
+                }
+
+                // The image may be just one horizontal band of a larger
+                // banded transfer (see SendCamera2ImageMessage)
+                if (active_mq_message.propertyExists(kImageBandCountProperty)) {
+                    ipc_message->SetImageBandInfo(active_mq_message.getIntProperty(kImageBandIndexProperty),
+                                                  active_mq_message.getIntProperty(kImageBandCountProperty));
+                }
+
+                // The image may be only the candidate ROI of the strobed
+                // frame (see GsCam2PreDetect)
+                if (active_mq_message.propertyExists(kRoiFullWidthProperty)) {
+                    ipc_message->SetRoiInfo(active_mq_message.getIntProperty(kRoiOffsetXProperty),
+                                            active_mq_message.getIntProperty(kRoiOffsetYProperty),
+                                            active_mq_message.getIntProperty(kRoiFullWidthProperty),
+                                            active_mq_message.getIntProperty(kRoiFullHeightProperty));
+                }
+
+                // An offload request also carries the ball geometry for the
+                // two crops (see GsSpinOffload)
+                if (active_mq_message.propertyExists(kSpinOffloadBall1Property)) {
+                    ipc_message->SetSpinOffloadRequestData(active_mq_message.getStringProperty(kSpinOffloadBall1Property),
+                                                           active_mq_message.getStringProperty(kSpinOffloadBall2Property),
+                                                           active_mq_message.getIntProperty(kSpinOffloadSplitColProperty));
+                }
             }
             else if (ipc_message->GetMessageType() == GolfSimIPCMessage::IPCMessageType::kResults) {
 
@@ -594,6 +1014,28 @@ namespace golf_sim {
 
                 GS_LOG_TRACE_MSG(trace, "Unpacked IPCMessageType::kControlMessage - message was: " + ipc_message->GetControlMessage().Format());
             }
+            else if (ipc_message->GetMessageType() == GolfSimIPCMessage::IPCMessageType::kClockSyncRequest ||
+                     ipc_message->GetMessageType() == GolfSimIPCMessage::IPCMessageType::kClockSyncResponse) {
+
+                // The timestamp legs ride as properties - these messages
+                // have no body (see BuildBytesMessageObjectFromIpcMessage)
+                if (active_mq_message.propertyExists(kClockSyncT1Property)) {
+                    ipc_message->SetClockSyncTimes((int64_t)active_mq_message.getLongProperty(kClockSyncT1Property),
+                                                   (int64_t)active_mq_message.getLongProperty(kClockSyncT2Property),
+                                                   (int64_t)active_mq_message.getLongProperty(kClockSyncT3Property));
+                }
+            }
+            else if (ipc_message->GetMessageType() == GolfSimIPCMessage::IPCMessageType::kSpinOffloadResponse) {
+
+                // The rotation vector rides as properties - this message has
+                // no body (see BuildBytesMessageObjectFromIpcMessage)
+                if (active_mq_message.propertyExists(kSpinOffloadRotationXProperty)) {
+                    ipc_message->SetSpinOffloadResult(active_mq_message.getDoubleProperty(kSpinOffloadRotationXProperty),
+                                                      active_mq_message.getDoubleProperty(kSpinOffloadRotationYProperty),
+                                                      active_mq_message.getDoubleProperty(kSpinOffloadRotationZProperty),
+                                                      active_mq_message.getBooleanProperty(kSpinOffloadSucceededProperty));
+                }
+            }
         }
         catch (CMSException& e) {
             GS_LOG_TRACE_MSG(trace, "BuildIpcMessageFromBytesMessage received an exception.  Stack trace is:");
@@ -605,7 +1047,7 @@ namespace golf_sim {
             return nullptr;
         }
 
-        return ipc_message_ptr.release();
+        return ipc_message;
     }
 
 
@@ -627,11 +1069,69 @@ namespace golf_sim {
         active_mq_message->setStringProperty(kGolfSimMessageTypeTag, kGolfSimMessageType);
         active_mq_message->setIntProperty(kGolfSimIPCMessageTypeTag, ipc_message.GetMessageType());
 
+        // Every message carries the current shot's trace ID so that the
+        // receiving system tags its work with the same ID (see GsShotTrace)
+        if (GsShotTrace::Current() != 0) {
+            active_mq_message->setLongProperty(kShotTraceIdProperty, (long long)GsShotTrace::Current());
+        }
+
+        if (ipc_message.GetImageBandCount() > 1) {
+            active_mq_message->setIntProperty(kImageBandIndexProperty, ipc_message.GetImageBandIndex());
+            active_mq_message->setIntProperty(kImageBandCountProperty, ipc_message.GetImageBandCount());
+        }
+
+        if (ipc_message.GetRoiFullWidth() > 0) {
+            active_mq_message->setIntProperty(kRoiOffsetXProperty, ipc_message.GetRoiOffsetX());
+            active_mq_message->setIntProperty(kRoiOffsetYProperty, ipc_message.GetRoiOffsetY());
+            active_mq_message->setIntProperty(kRoiFullWidthProperty, ipc_message.GetRoiFullWidth());
+            active_mq_message->setIntProperty(kRoiFullHeightProperty, ipc_message.GetRoiFullHeight());
+        }
+
+        if (ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kClockSyncRequest ||
+            ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kClockSyncResponse) {
+
+            // The timestamp legs ride as properties - these messages have no body
+            active_mq_message->setLongProperty(kClockSyncT1Property, (long long)ipc_message.GetClockSyncT1());
+            active_mq_message->setLongProperty(kClockSyncT2Property, (long long)ipc_message.GetClockSyncT2());
+            active_mq_message->setLongProperty(kClockSyncT3Property, (long long)ipc_message.GetClockSyncT3());
+        }
+
+        if (ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kSpinOffloadRequest) {
+
+            // The ball geometry rides as properties; the crops travel as the
+            // (image) body below
+            active_mq_message->setStringProperty(kSpinOffloadBall1Property, ipc_message.GetSpinOffloadBall1Data());
+            active_mq_message->setStringProperty(kSpinOffloadBall2Property, ipc_message.GetSpinOffloadBall2Data());
+            active_mq_message->setIntProperty(kSpinOffloadSplitColProperty, ipc_message.GetSpinOffloadSplitCol());
+        }
+
+        if (ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kSpinOffloadResponse) {
+
+            // The rotation vector rides as properties - this message has no body
+            active_mq_message->setDoubleProperty(kSpinOffloadRotationXProperty, ipc_message.GetSpinOffloadRotationX());
+            active_mq_message->setDoubleProperty(kSpinOffloadRotationYProperty, ipc_message.GetSpinOffloadRotationY());
+            active_mq_message->setDoubleProperty(kSpinOffloadRotationZProperty, ipc_message.GetSpinOffloadRotationZ());
+            active_mq_message->setBooleanProperty(kSpinOffloadSucceededProperty, ipc_message.GetSpinOffloadSucceeded());
+        }
+
         size_t image_mat_byte_length = 0;
         unsigned char* data = ipc_message.GetImageMatBytePointer(image_mat_byte_length);
 
-        if ( (ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2Image ||
-            ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2ReturnPreImage) &&
+        if ((ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2Image ||
+            ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2ReturnPreImage ||
+            ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kSpinOffloadRequest) &&
+                ipc_message.GetShmSlotIndex() >= 0) {
+
+            // SetImageMat placed the pixels in the shared-memory channel, so
+            // the message only needs to carry the slot reference.
+            GS_LOG_TRACE_MSG(trace, "GolfSimIpcSystem::BuildBytesMessageObjectFromIpcMessage sending image via shared-memory slot " +
+                std::to_string(ipc_message.GetShmSlotIndex()) + ", sequence " + std::to_string(ipc_message.GetShmSequence()));
+            active_mq_message->setIntProperty(kShmImageSlotProperty, ipc_message.GetShmSlotIndex());
+            active_mq_message->setLongProperty(kShmImageSequenceProperty, (long long)ipc_message.GetShmSequence());
+        }
+        else if ( (ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2Image ||
+            ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2ReturnPreImage ||
+            ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kSpinOffloadRequest) &&
                 data != nullptr) {
 
             GS_LOG_TRACE_MSG(trace, "GolfSimIpcSystem::BuildBytesMessageObjectFromIpcMessage has image -- setting body data of length = " + std::to_string(image_mat_byte_length));
@@ -660,6 +1160,27 @@ namespace golf_sim {
     bool GolfSimIpcSystem::SendIpcMessage(const GolfSimIPCMessage& ipc_message) {
         GS_LOG_TRACE_MSG(trace, "GolfSimIpcSystem::SendIpcMessage");
 
+#ifdef __unix__
+        // The image-bearing message types can bypass the broker's
+        // store-and-forward hop entirely when the direct peer-to-peer link
+        // is up.  Control and status traffic stays on the broker, where the
+        // GUI and tooling can see it.  A false return here just means the
+        // link is down (or the image rides the shared-memory channel), and
+        // the message takes the broker path below as always.  ROI-reduced
+        // images are excluded - the direct link's fixed frame header has no
+        // room for the ROI coordinates (see GsCam2PreDetect).
+        if (GsDirectTransport::kEnableDirectTransport &&
+            ipc_message.GetRoiFullWidth() == 0 &&
+            (ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2Image ||
+             ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2ReturnPreImage ||
+             ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kSpinOffloadRequest)) {
+
+            if (GsDirectTransport::SendIpcMessage(ipc_message)) {
+                return true;
+            }
+        }
+#endif
+
         std::unique_ptr<cms::BytesMessage> activeMQ_message = BuildBytesMessageObjectFromIpcMessage(ipc_message);
 
         if (activeMQ_message == nullptr) {
@@ -667,13 +1188,94 @@ namespace golf_sim {
             return false;
         }
 
-        bool result = producer_->SendMessage(activeMQ_message.get());
+        // The big camera-2 image messages can ride a dedicated topic that the
+        // GUI does not subscribe to (see kUsePartitionedImageDestination)
+        bool image_bearing = kUsePartitionedImageDestination &&
+            (ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2Image ||
+             ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kCamera2ReturnPreImage);
+
+        bool result;
+
+        if (GolfSimMessageProducer::kUseAsyncMessageSend) {
+            // Hand the message to the producer's local spool and return
+            // without touching the broker - the caller is often the FSM
+            // thread, which must never wait on broker I/O.  Clock-sync legs
+            // are worthless once stale, so they are the messages the spool
+            // may discard under overflow.
+            bool droppable =
+                ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kClockSyncRequest ||
+                ipc_message.GetMessageType() == GolfSimIPCMessage::IPCMessageType::kClockSyncResponse;
+
+            result = producer_->QueueMessageForSend(activeMQ_message.release(), image_bearing, droppable);
+        }
+        else {
+            result = producer_->SendMessage(activeMQ_message.get(), image_bearing);
+        }
 
         std::this_thread::yield();
 
         return result;
     }
 
+    bool GolfSimIpcSystem::SendCamera2ImageMessage(cv::Mat& image, bool allow_roi_reduction) {
+
+        // Camera-2-side pre-detection (see GsCam2PreDetect): ship only the
+        // padded bounding box of the bright strobed exposures, tagged with
+        // its frame coordinates so the receiver can rebuild the canvas.  A
+        // declined reduction (no candidates, or a box covering most of the
+        // frame) falls through to the legacy full-frame send.
+        if (allow_roi_reduction && GsCam2PreDetect::kEnableCam2PreDetection) {
+
+            cv::Mat roi;
+            int offset_x = 0;
+            int offset_y = 0;
+
+            if (GsCam2PreDetect::ReduceToCandidateRoi(image, roi, offset_x, offset_y)) {
+                GolfSimIPCMessage ipc_message(GolfSimIPCMessage::IPCMessageType::kCamera2Image);
+                ipc_message.SetRoiInfo(offset_x, offset_y, image.cols, image.rows);
+                ipc_message.SetImageMat(roi);
+                return SendIpcMessage(ipc_message);
+            }
+        }
+
+        int band_count = kImageTransferBandCount;
+
+        // Banding only helps when the pixels actually cross the network -
+        // the shared-memory channel already hands over the whole image at
+        // once, with no serialization to overlap.
+        if (band_count <= 1 || image.rows < band_count ||
+            GsIPCShmImageChannel::kUseSharedMemoryImageTransport) {
+
+            GolfSimIPCMessage ipc_message(GolfSimIPCMessage::IPCMessageType::kCamera2Image);
+            ipc_message.SetImageMat(image);
+            return SendIpcMessage(ipc_message);
+        }
+
+        GS_LOG_TRACE_MSG(trace, "GolfSimIpcSystem::SendCamera2ImageMessage sending image in " +
+            std::to_string(band_count) + " bands.");
+
+        for (int band = 0; band < band_count; band++) {
+
+            // Full-width row ranges of a continuous Mat are themselves
+            // continuous, so each band packs without a copy
+            int first_row = (image.rows * band) / band_count;
+            int end_row = (image.rows * (band + 1)) / band_count;
+
+            cv::Mat band_mat = image.rowRange(first_row, end_row);
+
+            GolfSimIPCMessage ipc_message(GolfSimIPCMessage::IPCMessageType::kCamera2Image);
+            ipc_message.SetImageBandInfo(band, band_count);
+            ipc_message.SetImageMat(band_mat);
+
+            if (!SendIpcMessage(ipc_message)) {
+                GS_LOG_MSG(error, "GolfSimIpcSystem::SendCamera2ImageMessage failed to send image band " + std::to_string(band) + ".");
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     bool GolfSimIpcSystem::SimulateCamera2ImageMessage() {
         GS_LOG_TRACE_MSG(trace, "GolfSimIpcSystem::SimulateCame");
 
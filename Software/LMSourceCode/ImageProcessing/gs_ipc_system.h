@@ -13,6 +13,7 @@
 #include <activemq/library/ActiveMQCPP.h>
 #include <cms/BytesMessage.h>
 #include <cms/BytesMessage.h>
+#include <memory>
 #include <mutex>
 
 
@@ -27,24 +28,116 @@ namespace golf_sim {
 
 	public:
 
-		static const int kIpcLoopIntervalMs = 2000;
 		static std::string kWebActiveMQHostAddress;
 
 		static std::string kActiveMQLMIdProperty;
 
+		// Identifies this launch monitor's bay on a broker shared by several
+		// bays.  When set, the system's traffic rides bay-specific topics
+		// (e.g., "Golf.Sim.Bay3"), so the broker - not every consumer in the
+		// fleet - does the cross-bay filtering.  Empty (the default) keeps
+		// the original single-bay "Golf.Sim" destination.
+		static std::string kActiveMQBayId;
+
+		// When true, the large camera-2 image messages are sent on a separate
+		// ".Images" topic that only the LM processes subscribe to, keeping
+		// them off the destination the GUI consumes.  The consumer always
+		// listens on both topics, so the setting only needs to match on the
+		// sending side.
+		static bool kUsePartitionedImageDestination;
+
+		// When true, received flat-encoded, uncompressed image bodies are
+		// read straight from the provider into the destination cv::Mat
+		// (see GsIPCMat::UnpackMatDataDirect) instead of being copied into
+		// an intermediate body buffer first.  Ineligible payloads fall back
+		// to the buffered path automatically.
+		static bool kUseZeroCopyImageReceive;
+
+		// The destination (topic/queue) names, with any bay partitioning
+		// applied.
+		static std::string BaseDestinationName();
+		static std::string ImageDestinationName();
+
 		// Properties (and their potential values) that will be sent within
 		// ActiveMQ messages.
 		static const std::string kGolfSimMessageTypeTag;
 		static const std::string kGolfSimMessageType;
 		static const std::string kGolfSimIPCMessageTypeTag;
 
-		static cv::Mat last_received_image_;
-		static std::mutex last_received_image_mutex_;
+		// Set on image messages whose pixels travel through the shared-memory
+		// channel (see GsIPCShmImageChannel) instead of the message body.
+		static const std::string kShmImageSlotProperty;
+		static const std::string kShmImageSequenceProperty;
+
+		// Set on image messages that carry one horizontal band of a larger
+		// image (see SendCamera2ImageMessage).
+		static const std::string kImageBandIndexProperty;
+		static const std::string kImageBandCountProperty;
+
+		// Set on camera-2 image messages that carry only the candidate ROI
+		// of the strobed frame (see GsCam2PreDetect).
+		static const std::string kRoiOffsetXProperty;
+		static const std::string kRoiOffsetYProperty;
+		static const std::string kRoiFullWidthProperty;
+		static const std::string kRoiFullHeightProperty;
+
+		// The timestamp legs of a clock-sync exchange (see GsClockSync).
+		static const std::string kClockSyncT1Property;
+		static const std::string kClockSyncT2Property;
+		static const std::string kClockSyncT3Property;
+
+		// The spin-offload exchange (see GsSpinOffload).  The ball-geometry
+		// strings and crop split column ride the request; the rotation
+		// vector rides the response.
+		static const std::string kSpinOffloadBall1Property;
+		static const std::string kSpinOffloadBall2Property;
+		static const std::string kSpinOffloadSplitColProperty;
+		static const std::string kSpinOffloadRotationXProperty;
+		static const std::string kSpinOffloadRotationYProperty;
+		static const std::string kSpinOffloadRotationZProperty;
+		static const std::string kSpinOffloadSucceededProperty;
+
+		// The trace ID of the shot the message belongs to (see
+		// GsShotTrace).  Set on every outgoing message once a shot has been
+		// traced, and adopted from every incoming one, so that both Pis'
+		// logs and journals tag their work with the same ID.
+		static const std::string kShotTraceIdProperty;
+
+		// When greater than 1, the strobed camera-2 image is sent as this
+		// many horizontal bands, each in its own message.  The receiver
+		// decodes each band as it arrives, so the deserialization overlaps
+		// the wire transfer of the later bands instead of waiting for the
+		// whole image.  Only worthwhile on slow (e.g., Wi-Fi) links between
+		// the Pis; 1 (the default) sends the image in a single message.
+		static int kImageTransferBandCount;
+
+		// The most-recently received camera-2 image.  Published by the IPC
+		// dispatch thread and read by the FSM thread, so the image rides an
+		// atomically-swapped pointer instead of a mutex - each store publishes a
+		// freshly-built Mat, and neither thread ever waits on the other.
+		static void StoreLastReceivedImage(const cv::Mat& image);
+		static cv::Mat GetLastReceivedImage();
 
 		static bool DispatchReceivedIpcMessage(const BytesMessage& message);
+
+		// Dispatches an already-built message - the shared tail of the
+		// broker receive path and the direct peer-to-peer transport (see
+		// GsDirectTransport).
+		static bool DispatchBuiltIpcMessage(std::shared_ptr<GolfSimIPCMessage> ipc_message);
 		static bool SendIpcMessage(const GolfSimIPCMessage& ipc_message);
 
-		static GolfSimIPCMessage* BuildIpcMessageFromBytesMessage(const BytesMessage& active_mq_message);
+		// Sends the strobed camera-2 image back to the camera-1 system,
+		// split into kImageTransferBandCount horizontal bands when banding
+		// is enabled (and the image is not riding the shared-memory channel).
+		// When camera-2 pre-detection is enabled, only the candidate ROI is
+		// shipped (see GsCam2PreDetect); allow_roi_reduction = false forces
+		// the full frame, as a full-frame request's resend must.
+		static bool SendCamera2ImageMessage(cv::Mat& image, bool allow_roi_reduction = true);
+
+		// The resulting message comes from the GsIPCMessagePool and returns
+		// there (or is deleted) when the last reference goes away.
+		// Returns nullptr if an error.
+		static std::shared_ptr<GolfSimIPCMessage> BuildIpcMessageFromBytesMessage(const BytesMessage& active_mq_message);
 
 		static std::unique_ptr<cms::BytesMessage> BuildBytesMessageObjectFromIpcMessage(const GolfSimIPCMessage& ipc_message);
 
@@ -59,7 +152,12 @@ namespace golf_sim {
 		static bool DispatchShutdownMessage(const GolfSimIPCMessage& message);
 		static bool DispatchRequestForCamera2TestStillImage(const GolfSimIPCMessage& message);
 		static bool DispatchResultsMessage(const GolfSimIPCMessage& message);
-		static bool DispatchControlMsgMessage(const GolfSimIPCMessage& message);	
+		static bool DispatchControlMsgMessage(const GolfSimIPCMessage& message);
+		static bool DispatchClockSyncRequestMessage(const GolfSimIPCMessage& message);
+		static bool DispatchClockSyncResponseMessage(const GolfSimIPCMessage& message);
+		static bool DispatchSpinOffloadRequestMessage(const GolfSimIPCMessage& message);
+		static bool DispatchSpinOffloadResponseMessage(const GolfSimIPCMessage& message);
+		static bool DispatchRequestCamera2FullFrameMessage(const GolfSimIPCMessage& message);
 
 
 		static bool SimulateCamera2ImageMessage();
@@ -0,0 +1,372 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __unix__
+#include <sys/mman.h>
+#endif
+
+#include "logging_tools.h"
+#include "gs_config.h"
+
+#include "gs_mat_pool_allocator.h"
+
+
+namespace golf_sim {
+
+    bool GsMatPoolAllocator::kEnableMatPoolAllocator = true;
+    int GsMatPoolAllocator::kMaxPooledBuffersPerBucket = 6;
+    int GsMatPoolAllocator::kMaxPooledMegabytes = 128;
+    bool GsMatPoolAllocator::kUseHugePageBuffers = true;
+
+    namespace {
+
+        // Buckets are powers of two from 2^12 (4KB - anything smaller isn't
+        // worth pooling) up to 2^26 (64MB - larger buffers are one-offs and go
+        // straight to the OS).
+        const int kMinBucketShift = 12;
+        const int kMaxBucketShift = 26;
+        const int kNumBuckets = kMaxBucketShift - kMinBucketShift + 1;
+
+        struct Bucket {
+            std::vector<void*> free_buffers;
+            uint64_t allocation_count = 0;
+            uint64_t pool_hit_count = 0;
+        };
+
+        std::mutex pool_mutex;
+        Bucket buckets[kNumBuckets];
+        size_t pooled_bytes = 0;
+        uint64_t unpooled_allocation_count = 0;
+
+        // Buffers that were mmap'd for huge-page backing (as opposed to
+        // coming from cv::fastMalloc), so ReleaseBuffer frees them the same
+        // way they were allocated.  Guarded by pool_mutex.
+        std::unordered_set<void*> huge_page_buffers;
+
+        const size_t kHugePageBytes = 2 * 1024 * 1024;
+
+        uint64_t huge_page_buffer_count = 0;
+        size_t huge_page_bytes_mapped = 0;
+        uint64_t huge_page_fallback_count = 0;
+        uint64_t mlock_failure_count = 0;
+
+        // The index of the bucket a buffer of the given size lives in, or -1
+        // if the size is too large to pool
+        int BucketIndexForSize(size_t total_bytes) {
+            for (int i = 0; i < kNumBuckets; i++) {
+                if (total_bytes <= ((size_t)1 << (kMinBucketShift + i))) {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        size_t BucketSize(int bucket_index) {
+            return (size_t)1 << (kMinBucketShift + bucket_index);
+        }
+
+#ifdef __unix__
+        // Maps an anonymous region big enough for the bucket, aligned to the
+        // 2MB huge-page boundary so the kernel can actually use huge pages
+        // for it, then advises THP and locks it in.  Returns nullptr (and the
+        // caller falls back to cv::fastMalloc) if the mapping fails.
+        void* MapHugePageBuffer(size_t bucket_bytes) {
+
+            size_t mapped_bytes = (bucket_bytes + kHugePageBytes - 1) & ~(kHugePageBytes - 1);
+
+            // Over-map by one huge page so an aligned sub-range always fits,
+            // then trim the unaligned head and tail back off
+            size_t over_mapped_bytes = mapped_bytes + kHugePageBytes;
+
+            void* raw = mmap(nullptr, over_mapped_bytes, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) {
+                return nullptr;
+            }
+
+            uintptr_t raw_address = (uintptr_t)raw;
+            uintptr_t aligned_address = (raw_address + kHugePageBytes - 1) & ~(uintptr_t)(kHugePageBytes - 1);
+
+            size_t head_bytes = aligned_address - raw_address;
+            if (head_bytes > 0) {
+                munmap(raw, head_bytes);
+            }
+
+            size_t tail_bytes = over_mapped_bytes - head_bytes - mapped_bytes;
+            if (tail_bytes > 0) {
+                munmap((void*)(aligned_address + mapped_bytes), tail_bytes);
+            }
+
+            void* buffer = (void*)aligned_address;
+
+#ifdef MADV_HUGEPAGE
+            madvise(buffer, mapped_bytes, MADV_HUGEPAGE);
+#endif
+
+            // Locking defends against major faults after memory pressure.
+            // RLIMIT_MEMLOCK can make this fail - the buffer still works,
+            // just without the residency guarantee
+            if (mlock(buffer, mapped_bytes) != 0) {
+                mlock_failure_count++;
+            }
+
+            return buffer;
+        }
+
+        void UnmapHugePageBuffer(void* buffer, size_t bucket_bytes) {
+            size_t mapped_bytes = (bucket_bytes + kHugePageBytes - 1) & ~(kHugePageBytes - 1);
+            munmap(buffer, mapped_bytes);
+        }
+#endif
+
+        // Allocates the backing store for one pooled bucket buffer.  Buckets
+        // of a huge page or more get mlock'd, THP-advised mappings; smaller
+        // buckets (and any mapping failure) use cv::fastMalloc as always.
+        uchar* AllocateBucketBuffer(int bucket_index) {
+
+            size_t bucket_bytes = BucketSize(bucket_index);
+
+#ifdef __unix__
+            if (GsMatPoolAllocator::kUseHugePageBuffers && bucket_bytes >= kHugePageBytes) {
+
+                void* buffer = MapHugePageBuffer(bucket_bytes);
+
+                std::lock_guard<std::mutex> lock(pool_mutex);
+
+                if (buffer != nullptr) {
+                    huge_page_buffers.insert(buffer);
+                    huge_page_buffer_count++;
+                    huge_page_bytes_mapped += (bucket_bytes + kHugePageBytes - 1) & ~(kHugePageBytes - 1);
+                    return (uchar*)buffer;
+                }
+
+                huge_page_fallback_count++;
+            }
+#endif
+
+            return (uchar*)cv::fastMalloc(bucket_bytes);
+        }
+
+        void FreeBucketBuffer(void* buffer, int bucket_index) {
+
+#ifdef __unix__
+            bool was_huge_page_buffer = false;
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                was_huge_page_buffer = huge_page_buffers.erase(buffer) > 0;
+            }
+
+            if (was_huge_page_buffer) {
+                UnmapHugePageBuffer(buffer, BucketSize(bucket_index));
+                return;
+            }
+#endif
+
+            cv::fastFree(buffer);
+        }
+
+        uchar* AcquireBuffer(size_t total_bytes) {
+
+            int bucket_index = BucketIndexForSize(total_bytes);
+
+            if (bucket_index < 0) {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                unpooled_allocation_count++;
+                return (uchar*)cv::fastMalloc(total_bytes);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+
+                Bucket& bucket = buckets[bucket_index];
+                bucket.allocation_count++;
+
+                if (!bucket.free_buffers.empty()) {
+                    void* buffer = bucket.free_buffers.back();
+                    bucket.free_buffers.pop_back();
+                    bucket.pool_hit_count++;
+                    pooled_bytes -= BucketSize(bucket_index);
+                    return (uchar*)buffer;
+                }
+            }
+
+            // Allocate the full bucket size so the buffer is reusable for any
+            // request that maps to the same bucket
+            return AllocateBucketBuffer(bucket_index);
+        }
+
+        void ReleaseBuffer(void* buffer, size_t total_bytes) {
+
+            int bucket_index = BucketIndexForSize(total_bytes);
+
+            if (bucket_index < 0) {
+                cv::fastFree(buffer);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+
+                Bucket& bucket = buckets[bucket_index];
+
+                if ((int)bucket.free_buffers.size() < GsMatPoolAllocator::kMaxPooledBuffersPerBucket &&
+                    pooled_bytes + BucketSize(bucket_index) <= (size_t)GsMatPoolAllocator::kMaxPooledMegabytes * 1024 * 1024) {
+                    bucket.free_buffers.push_back(buffer);
+                    pooled_bytes += BucketSize(bucket_index);
+                    return;
+                }
+            }
+
+            FreeBucketBuffer(buffer, bucket_index);
+        }
+
+        GsMatPoolAllocator pool_allocator_instance;
+    }
+
+
+    void GsMatPoolAllocator::Install() {
+
+        GolfSimConfiguration::SetConstant("gs_config.image_processing.kEnableMatPoolAllocator", kEnableMatPoolAllocator);
+        GolfSimConfiguration::SetConstant("gs_config.image_processing.kMaxPooledBuffersPerBucket", kMaxPooledBuffersPerBucket);
+        GolfSimConfiguration::SetConstant("gs_config.image_processing.kMaxPooledMegabytes", kMaxPooledMegabytes);
+        GolfSimConfiguration::SetConstant("gs_config.image_processing.kUseHugePageBuffers", kUseHugePageBuffers);
+
+        if (!kEnableMatPoolAllocator) {
+            GS_LOG_TRACE_MSG(trace, "GsMatPoolAllocator is disabled - using the OpenCV default allocator.");
+            return;
+        }
+
+        GS_LOG_TRACE_MSG(trace, "GsMatPoolAllocator::Install - pooling cv::Mat buffers (" +
+            std::to_string(kMaxPooledBuffersPerBucket) + " buffers/bucket, " +
+            std::to_string(kMaxPooledMegabytes) + "MB cap).");
+
+        cv::Mat::setDefaultAllocator(&pool_allocator_instance);
+    }
+
+
+    void GsMatPoolAllocator::LogStatistics() {
+
+        if (!kEnableMatPoolAllocator) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(pool_mutex);
+
+        std::string s = "GsMatPoolAllocator statistics (allocations / pool hits / retained):";
+
+        for (int i = 0; i < kNumBuckets; i++) {
+            const Bucket& bucket = buckets[i];
+
+            if (bucket.allocation_count == 0 && bucket.free_buffers.empty()) {
+                continue;
+            }
+
+            size_t bucket_kb = BucketSize(i) / 1024;
+            s += "\n    <= " + std::to_string(bucket_kb) + "KB: " +
+                std::to_string(bucket.allocation_count) + " / " +
+                std::to_string(bucket.pool_hit_count) + " / " +
+                std::to_string(bucket.free_buffers.size());
+        }
+
+        s += "\n    unpooled (> " + std::to_string(BucketSize(kNumBuckets - 1) / (1024 * 1024)) + "MB): " +
+            std::to_string(unpooled_allocation_count) + " allocations.";
+
+        if (kUseHugePageBuffers) {
+            s += "\n    hugepage-backed: " + std::to_string(huge_page_buffer_count) + " buffers, " +
+                std::to_string(huge_page_bytes_mapped / (1024 * 1024)) + "MB mapped, " +
+                std::to_string(huge_page_fallback_count) + " fallbacks, " +
+                std::to_string(mlock_failure_count) + " mlock failures.";
+        }
+
+        GS_LOG_MSG(info, s);
+    }
+
+
+    void GsMatPoolAllocator::GetStatistics(uint64_t& total_allocations, uint64_t& total_pool_hits,
+                                           size_t& retained_bytes) {
+
+        total_allocations = 0;
+        total_pool_hits = 0;
+        retained_bytes = 0;
+
+        if (!kEnableMatPoolAllocator) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(pool_mutex);
+
+        for (int i = 0; i < kNumBuckets; i++) {
+            total_allocations += buckets[i].allocation_count;
+            total_pool_hits += buckets[i].pool_hit_count;
+        }
+
+        total_allocations += unpooled_allocation_count;
+        retained_bytes = pooled_bytes;
+    }
+
+
+    // The allocation logic below mirrors OpenCV's StdMatAllocator, with the
+    // buffer acquisition/release routed through the pool.
+
+    cv::UMatData* GsMatPoolAllocator::allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                                               cv::AccessFlag /*flags*/, cv::UMatUsageFlags /*usageFlags*/) const {
+
+        size_t total = CV_ELEM_SIZE(type);
+
+        for (int i = dims - 1; i >= 0; i--) {
+            if (step) {
+                if (data && step[i] != CV_AUTOSTEP) {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else {
+                    step[i] = total;
+                }
+            }
+            total *= sizes[i];
+        }
+
+        uchar* data0 = data ? (uchar*)data : AcquireBuffer(total);
+
+        cv::UMatData* u = new cv::UMatData(this);
+        u->data = u->origdata = data0;
+        u->size = total;
+
+        if (data) {
+            u->flags |= cv::UMatData::USER_ALLOCATED;
+        }
+
+        return u;
+    }
+
+
+    bool GsMatPoolAllocator::allocate(cv::UMatData* u, cv::AccessFlag /*flags*/, cv::UMatUsageFlags /*usageFlags*/) const {
+        return u != nullptr;
+    }
+
+
+    void GsMatPoolAllocator::deallocate(cv::UMatData* u) const {
+
+        if (u == nullptr) {
+            return;
+        }
+
+        CV_Assert(u->urefcount == 0 && u->refcount == 0);
+
+        if (!(u->flags & cv::UMatData::USER_ALLOCATED)) {
+            ReleaseBuffer(u->origdata, u->size);
+            u->origdata = nullptr;
+        }
+
+        delete u;
+    }
+
+}
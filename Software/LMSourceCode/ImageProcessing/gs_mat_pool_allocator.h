@@ -0,0 +1,63 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// A size-bucketed pooling allocator for cv::Mat pixel buffers.  The shot
+// workload allocates and frees the same handful of buffer sizes over and over
+// (full camera frames, ball ROIs, candidate images), and OpenCV's default
+// allocator hands each buffer straight back to the OS, which shows up as
+// heavy mmap/munmap traffic on the Pi.  When enabled, the pool is installed
+// as the process-wide default allocator at startup (see run_main in
+// lm_main.cpp); freed buffers are retained in power-of-two buckets for reuse
+// and per-bucket statistics are kept so the churn can be inspected.
+
+#pragma once
+
+#include <cstdint>
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+    class GsMatPoolAllocator : public cv::MatAllocator {
+
+    public:
+
+        // Set from the configuration .json file
+        static bool kEnableMatPoolAllocator;
+        // The most freed buffers any single size bucket will retain
+        static int kMaxPooledBuffersPerBucket;
+        // The total amount of memory the pool may hold in retained (idle)
+        // buffers before further frees go back to the OS
+        static int kMaxPooledMegabytes;
+        // When true (and on Linux), buckets of 2MB and up are backed by
+        // mlock'd, transparent-huge-page-advised mappings instead of the
+        // normal heap.  Full-frame pixel loops then walk far fewer TLB
+        // entries, and the buffers cannot be swapped out and major-fault
+        // back in after memory pressure.  Falls back to the heap per-buffer
+        // if a mapping fails.
+        static bool kUseHugePageBuffers;
+
+        // Installs the pool as the process-wide default cv::Mat allocator if
+        // enabled in the configuration.  Must be called once, at startup,
+        // before other threads begin allocating images.
+        static void Install();
+
+        // Logs the per-bucket statistics (allocations, pool hits, buffers
+        // currently retained).  Intended for the shutdown-time dump.
+        static void LogStatistics();
+
+        // Totals across all buckets, for the per-shot memory telemetry
+        // (see GsShotTelemetry).  All zeros when the pool is disabled.
+        static void GetStatistics(uint64_t& total_allocations, uint64_t& total_pool_hits,
+                                  size_t& retained_bytes);
+
+        // cv::MatAllocator interface
+        cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                               cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override;
+        bool allocate(cv::UMatData* u, cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override;
+        void deallocate(cv::UMatData* u) const override;
+    };
+
+}
@@ -52,17 +52,17 @@ using namespace std;
 namespace golf_sim {
 
 
-    GolfSimMessageConsumer::GolfSimMessageConsumer(const std::string& brokerURI, 
-                                                    bool useTopic, 
-                                                    bool sessionTransacted, 
-                                                    int waitMillis) :
+    GolfSimMessageConsumer::GolfSimMessageConsumer(const std::string& brokerURI,
+                                                    bool useTopic,
+                                                    bool sessionTransacted) :
         latch(1),
         doneLatch(1),
         connection(nullptr),
         session_(nullptr),
         destination(nullptr),
         consumer_(nullptr),
-        waitMillis(waitMillis),
+        image_destination_(nullptr),
+        image_consumer_(nullptr),
         useTopic(useTopic),
         sessionTransacted(sessionTransacted),
         brokerURI(brokerURI) {
@@ -106,24 +106,38 @@ namespace golf_sim {
                 session_ = connection->createSession(Session::AUTO_ACKNOWLEDGE);
             }
 
-            // Create the destination (Topic or Queue)
+            // Create the destinations (Topic or Queue).  The names are
+            // bay-partitioned when several bays share the broker, so the
+            // broker drops cross-bay traffic before it ever reaches us.  We
+            // subscribe to the image destination as well as the main one -
+            // that way messages arrive regardless of whether the sender has
+            // kUsePartitionedImageDestination enabled.
+            std::string base_destination_name = GolfSimIpcSystem::BaseDestinationName();
+            std::string image_destination_name = GolfSimIpcSystem::ImageDestinationName();
+
             if (useTopic) {
-                destination = session_->createTopic("Golf.Sim");
+                destination = session_->createTopic(base_destination_name);
+                image_destination_ = session_->createTopic(image_destination_name);
             } else {
-                destination = session_->createQueue("Golf.Sim");
+                destination = session_->createQueue(base_destination_name);
+                image_destination_ = session_->createQueue(image_destination_name);
             }
 
-            // We don't want our own messages fed back to us, so exclude them
+            // We don't want our own messages fed back to us, so have the
+            // broker exclude them server-side
             std::string system_id_to_exclude = GolfSimConfiguration::GetSystemID();
 
             std::string selector = GolfSimIpcSystem::kActiveMQLMIdProperty + " <> '" + system_id_to_exclude + "'";
 
-            GS_LOG_TRACE_MSG(trace, "GolfSimMessageConsumer message selector: " + selector);
+            GS_LOG_TRACE_MSG(trace, "GolfSimMessageConsumer destinations: " + base_destination_name + ", " +
+                             image_destination_name + ", message selector: " + selector);
 
-            // Create a MessageConsumer from the Session to the Topic or Queue
+            // Create the MessageConsumers from the Session to the Topics or Queues
             consumer_ = session_->createConsumer(destination, selector);
+            image_consumer_ = session_->createConsumer(image_destination_, selector);
 
             consumer_->setMessageListener(this);
+            image_consumer_->setMessageListener(this);
 
             std::cout.flush();
             std::cerr.flush();
@@ -131,12 +145,12 @@ namespace golf_sim {
             // Indicate we are ready for messages.
             latch.countDown();
 
-            // Wait while asynchronous messages come in.
-
-            // Loop around, but check every so often to ensure things are still running
-            while (GolfSimGlobals::golf_sim_running_) {
-                doneLatch.await(waitMillis);
-            }
+            // Wait while asynchronous messages come in.  The registered
+            // message listener dispatches each message (and queues any
+            // resulting FSM events) the moment it arrives, so there is
+            // nothing to poll for here - just block until Shutdown()
+            // releases the done latch.
+            doneLatch.await();
 
         } catch (CMSException& e) {
             GS_LOG_TRACE_MSG(warning, "GolfSimMessageConsumer::run failed.");
@@ -209,10 +223,18 @@ namespace golf_sim {
                 delete destination;
                 destination = nullptr;
             }
+            if (image_destination_ != nullptr) {
+                delete image_destination_;
+                image_destination_ = nullptr;
+            }
             if (consumer_ != nullptr) {
                 delete consumer_;
                 consumer_ = nullptr;
             }
+            if (image_consumer_ != nullptr) {
+                delete image_consumer_;
+                image_consumer_ = nullptr;
+            }
             if (session_ != nullptr) {
                 delete session_;
                 session_ = nullptr;
@@ -240,7 +262,7 @@ namespace golf_sim {
         bool useTopics = true;
         bool sessionTransacted = false;
 
-        GolfSimMessageConsumer* listener = new GolfSimMessageConsumer(broker_URI, useTopics, sessionTransacted, GolfSimIpcSystem::kIpcLoopIntervalMs);
+        GolfSimMessageConsumer* listener = new GolfSimMessageConsumer(broker_URI, useTopics, sessionTransacted);
 
         if (listener == nullptr) {
             GS_LOG_MSG(error, "could not create an IPC GolfSimMessageConsumer.");
@@ -257,12 +279,11 @@ namespace golf_sim {
 
         listener->consumer_thread_->start();
 
-        // Wait for the consumer to indicate that it's ready to go.
+        // Wait for the consumer to indicate that it's ready to go.  The ready
+        // latch is only counted down after the message listener is registered,
+        // so no additional settling delay is needed here.
         listener->waitUntilReady();
 
-        // Wait for the producer to get started up
-        sleep(GolfSimIpcSystem::kIpcLoopIntervalMs / 1000);
-
         // At this point, the listener/watcher thread will just keep
         // running until something tells it to quit.
 
@@ -274,14 +295,10 @@ namespace golf_sim {
     bool GolfSimMessageConsumer::Shutdown() {
         GS_LOG_TRACE_MSG(trace, "GolfSimMessageConsumer::Shutdown called.");
 
-        // If the consumer's run() function is waiting on the done latch, mark that
-        // latch as finished.
+        // The consumer's run() function is blocked on the done latch - counting
+        // it down releases the thread immediately.
         doneLatch.countDown();
 
-        // Wait for the thread loops to have a chance to shutdown
-        // TBD - Figure out a cleaner way of doing this.
-        sleep(GolfSimIpcSystem::kIpcLoopIntervalMs / 500);
-
         // Execution will continue here after the listener stops
         // Wait for the threads to complete.
         GS_LOG_TRACE_MSG(trace, "GolfSimMessageConsumer::consumer_thread_ closing.  Waiting for join...");
@@ -295,6 +312,10 @@ namespace golf_sim {
             consumer_->close();
         }
 
+        if (image_consumer_ != nullptr) {
+            image_consumer_->close();
+        }
+
         GS_LOG_TRACE_MSG(trace, "Returning from GolfSimMessageConsumer::Shutdown.");
 
         return true;
@@ -54,7 +54,11 @@ namespace golf_sim {
         Session* session_;
         Destination* destination;
         MessageConsumer* consumer_;
-        long waitMillis;
+        // Second subscription for the image-bearing messages, which the
+        // producer can route onto a dedicated destination that the GUI never
+        // subscribes to.  See GolfSimIpcSystem::ImageDestinationName().
+        Destination* image_destination_;
+        MessageConsumer* image_consumer_;
         bool useTopic;
         bool sessionTransacted;
         std::string brokerURI;
@@ -73,7 +77,7 @@ namespace golf_sim {
         // 
         bool Shutdown();
 
-        GolfSimMessageConsumer(const std::string& brokerURI, bool useTopic = false, bool sessionTransacted = false, int waitMillis = 30000);
+        GolfSimMessageConsumer(const std::string& brokerURI, bool useTopic = false, bool sessionTransacted = false);
 
         virtual ~GolfSimMessageConsumer();
 
@@ -24,6 +24,7 @@
 #include <cms/MessageListener.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <chrono>
 #include <iostream>
 #include <memory>
 
@@ -50,13 +51,18 @@ using namespace std;
 
 namespace golf_sim {
 
-    GolfSimMessageProducer::GolfSimMessageProducer(const std::string& brokerURI, 
+    bool GolfSimMessageProducer::kUseAsyncMessageSend = false;
+    int GolfSimMessageProducer::kAsyncSendSpoolSize = 32;
+
+    GolfSimMessageProducer::GolfSimMessageProducer(const std::string& brokerURI,
                                                     bool useTopic, 
                                                     bool sessionTransacted) :
         connection(nullptr),
         session_(nullptr),
         destination(nullptr),
         producer_(nullptr),
+        image_destination_(nullptr),
+        image_producer_(nullptr),
         useTopic(useTopic),
         sessionTransacted(sessionTransacted),
         brokerURI(brokerURI) 
@@ -77,9 +83,19 @@ namespace golf_sim {
 
         try {
 
+            std::string effective_broker_URI = brokerURI;
+
+            if (kUseAsyncMessageSend && effective_broker_URI.find("useAsyncSend") == std::string::npos) {
+                // Put the CMS layer itself into async send mode as well, so
+                // the spool-draining thread is not held up waiting for
+                // per-message broker receipts.
+                effective_broker_URI += (effective_broker_URI.find('?') == std::string::npos) ?
+                    "?connection.useAsyncSend=true" : "&connection.useAsyncSend=true";
+            }
+
             // Create a ConnectionFactory
             unique_ptr<ConnectionFactory> connectionFactory(
-                ConnectionFactory::createCMSConnectionFactory(brokerURI));
+                ConnectionFactory::createCMSConnectionFactory(effective_broker_URI));
 
             // Create a Connection
             connection = connectionFactory->createConnection();
@@ -95,18 +111,30 @@ namespace golf_sim {
                 session_ = connection->createSession(Session::AUTO_ACKNOWLEDGE);
             }
 
-            // Create the destination (Topic or Queue)
+            // Create the destinations (Topic or Queue).  The destination names
+            // are bay-partitioned when several bays share the broker, and the
+            // image-bearing messages get their own destination.
+            std::string base_destination_name = GolfSimIpcSystem::BaseDestinationName();
+            std::string image_destination_name = GolfSimIpcSystem::ImageDestinationName();
+
+            GS_LOG_TRACE_MSG(trace, "GolfSimMessageProducer destinations: " + base_destination_name + ", " + image_destination_name);
+
             if (useTopic) {
-                destination = session_->createTopic("Golf.Sim");
+                destination = session_->createTopic(base_destination_name);
+                image_destination_ = session_->createTopic(image_destination_name);
             }
             else {
-                destination = session_->createQueue("Golf.Sim");
+                destination = session_->createQueue(base_destination_name);
+                image_destination_ = session_->createQueue(image_destination_name);
             }
 
             // Create a MessageProducer from the Session to the Topic or Queue
             producer_ = session_->createProducer(destination);
             producer_->setDeliveryMode(DeliveryMode::NON_PERSISTENT);
 
+            image_producer_ = session_->createProducer(image_destination_);
+            image_producer_->setDeliveryMode(DeliveryMode::NON_PERSISTENT);
+
             // The producer should be ready to send messagers
         }
         catch (CMSException& e) {
@@ -130,6 +158,9 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "GolfSimMessageProducer::cleanup");
 
+        // The sender thread must be gone before the producers are deleted
+        StopAsyncSender();
+
         if (connection != NULL) {
             try {
                 connection->close();
@@ -144,10 +175,18 @@ namespace golf_sim {
                 delete destination;
                 destination = nullptr;
             }
+            if (image_destination_ != nullptr) {
+                delete image_destination_;
+                image_destination_ = nullptr;
+            }
             if (producer_ != nullptr) {
                 delete producer_;
                 producer_ = nullptr;
             }
+            if (image_producer_ != nullptr) {
+                delete image_producer_;
+                image_producer_ = nullptr;
+            }
             if (session_ != nullptr) {
                 delete session_;
                 session_ = nullptr;
@@ -202,6 +241,10 @@ namespace golf_sim {
     bool GolfSimMessageProducer::Shutdown() {
         GS_LOG_TRACE_MSG(trace, "GolfSimMessageProducer::Shutdown called.  Waiting for join...");
 
+        // Drains (or abandons, if the broker is unreachable) whatever is
+        // still spooled, then joins the sender thread
+        StopAsyncSender();
+
         // Execution will continue here after the listener stops
         // Wait for the threads to complete.
         if (producer_thread_ != nullptr) {
@@ -231,7 +274,7 @@ namespace golf_sim {
         return new_msg;
     }
 
-    bool GolfSimMessageProducer::SendMessage(BytesMessage* message) {
+    bool GolfSimMessageProducer::SendMessage(BytesMessage* message, bool image_bearing) {
 
         if (message == nullptr) {
             GS_LOG_TRACE_MSG(trace, "Attempt to SendMessage a nullptr message.");
@@ -251,10 +294,148 @@ namespace golf_sim {
 
         message->setStringProperty(GolfSimIpcSystem::kActiveMQLMIdProperty, system_id);
 
-        producer_->send(message);
+        if (image_bearing && image_producer_ != nullptr) {
+            image_producer_->send(message);
+        }
+        else {
+            producer_->send(message);
+        }
 
         return true;
     }
+
+    bool GolfSimMessageProducer::QueueMessageForSend(BytesMessage* message, bool image_bearing, bool droppable) {
+
+        if (message == nullptr) {
+            GS_LOG_TRACE_MSG(trace, "Attempt to QueueMessageForSend a nullptr message.");
+            return false;
+        }
+
+        BytesMessage* overflow_casualty = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(spool_mutex_);
+
+            if (async_sender_thread_ == nullptr) {
+                async_sender_running_ = true;
+                async_sender_thread_ = new std::thread(&GolfSimMessageProducer::RunAsyncSenderThread, this);
+            }
+
+            if ((int)spool_.size() >= kAsyncSendSpoolSize) {
+
+                // Make room by discarding the oldest droppable (stale-tolerant)
+                // message.  Image and result messages are never casualties.
+                for (auto it = spool_.begin(); it != spool_.end(); ++it) {
+                    if (it->droppable) {
+                        overflow_casualty = it->message;
+                        spool_.erase(it);
+                        break;
+                    }
+                }
+
+                if (overflow_casualty == nullptr) {
+                    if (droppable) {
+                        // Everything queued ahead of us outranks us - drop the
+                        // newcomer instead.
+                        spooled_messages_dropped_++;
+                        lock.unlock();
+                        delete message;
+                        GS_LOG_TRACE_MSG(trace, "GolfSimMessageProducer - send spool full.  Dropped an incoming droppable message.");
+                        return true;
+                    }
+
+                    // A must-deliver message on a full spool of must-deliver
+                    // messages - exceed the bound rather than lose it.
+                    GS_LOG_MSG(warning, "GolfSimMessageProducer - send spool over its bound of " +
+                        std::to_string(kAsyncSendSpoolSize) + " messages.  Is the broker reachable?");
+                }
+                else {
+                    spooled_messages_dropped_++;
+                }
+            }
+
+            spool_.push_back(SpooledMessage{ message, image_bearing, droppable });
+        }
+
+        spool_cv_.notify_all();
+
+        if (overflow_casualty != nullptr) {
+            delete overflow_casualty;
+            GS_LOG_TRACE_MSG(trace, "GolfSimMessageProducer - send spool full.  Dropped the oldest droppable spooled message.");
+        }
+
+        return true;
+    }
+
+    void GolfSimMessageProducer::RunAsyncSenderThread() {
+
+        GS_LOG_TRACE_MSG(trace, "GolfSimMessageProducer::RunAsyncSenderThread started.");
+
+        for (;;) {
+
+            SpooledMessage next;
+
+            {
+                std::unique_lock<std::mutex> lock(spool_mutex_);
+
+                spool_cv_.wait(lock, [this] { return !spool_.empty() || !async_sender_running_; });
+
+                if (!async_sender_running_ && spool_.empty()) {
+                    break;
+                }
+
+                // The session is established on the (separate) connection
+                // thread - hold spooled messages until it is ready.
+                if (producer_ == nullptr) {
+                    spool_cv_.wait_for(lock, std::chrono::milliseconds(50));
+                    continue;
+                }
+
+                next = spool_.front();
+                spool_.pop_front();
+            }
+
+            try {
+                SendMessage(next.message, next.image_bearing);
+            }
+            catch (CMSException& e) {
+                GS_LOG_MSG(warning, "GolfSimMessageProducer::RunAsyncSenderThread failed to send a spooled message.");
+                e.printStackTrace();
+            }
+
+            delete next.message;
+        }
+
+        GS_LOG_TRACE_MSG(trace, "GolfSimMessageProducer::RunAsyncSenderThread ended.  " +
+            std::to_string(spooled_messages_dropped_) + " message(s) were dropped over the session.");
+    }
+
+    void GolfSimMessageProducer::StopAsyncSender() {
+
+        std::thread* thread_to_join = nullptr;
+
+        {
+            std::unique_lock<std::mutex> lock(spool_mutex_);
+
+            if (async_sender_thread_ == nullptr) {
+                return;
+            }
+
+            async_sender_running_ = false;
+            thread_to_join = async_sender_thread_;
+            async_sender_thread_ = nullptr;
+        }
+
+        spool_cv_.notify_all();
+        thread_to_join->join();
+        delete thread_to_join;
+
+        // Anything still spooled at shutdown is not going anywhere
+        for (SpooledMessage& m : spool_) {
+            delete m.message;
+        }
+        spool_.clear();
+    }
 }
 
 #endif // #ifdef __unix__  // Ignore in Windows environment
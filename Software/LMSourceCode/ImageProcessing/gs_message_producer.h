@@ -27,6 +27,11 @@
 #include <cms/ExceptionListener.h>
 #include <cms/MessageListener.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "gs_ipc_message.h"
 #include "logging_tools.h"
 
@@ -50,6 +55,11 @@ namespace golf_sim {
         Session* session_;
         Destination* destination;
         MessageProducer* producer_;
+        // Separate destination for the large image-bearing messages, so they
+        // stay off the topic the GUI consumes.  See
+        // GolfSimIpcSystem::kUsePartitionedImageDestination.
+        Destination* image_destination_;
+        MessageProducer* image_producer_;
         long waitMillis;
         bool useTopic;
         bool sessionTransacted;
@@ -62,6 +72,20 @@ namespace golf_sim {
 
     public:
 
+        // When true, SendIpcMessage callers hand their message to a bounded
+        // local spool and return immediately; a dedicated sender thread
+        // drains the spool to the broker (which is itself put into async
+        // send mode).  The calling thread - often the FSM thread - then
+        // never blocks on broker I/O, even when the link is slow or down.
+        // See the ipc_interface section of the .json configuration file.
+        static bool kUseAsyncMessageSend;
+
+        // The maximum number of messages the spool holds.  On overflow, the
+        // oldest droppable (stale-tolerant, e.g. clock-sync) message is
+        // discarded first; image and result messages are never dropped, and
+        // will exceed the bound (with a warning) rather than be lost.
+        static int kAsyncSendSpoolSize;
+
         // Creates and starts the listener (consumer) messaging thread.
         // Acts as a factory
         static GolfSimMessageProducer* Initialize(std::string& broker_URI);
@@ -72,7 +96,15 @@ namespace golf_sim {
 
         virtual ~GolfSimMessageProducer();
 
-        bool SendMessage(BytesMessage* message);
+        // image_bearing routes the message onto the separate image
+        // destination instead of the main one.
+        bool SendMessage(BytesMessage* message, bool image_bearing = false);
+
+        // Asynchronous entry point (see kUseAsyncMessageSend) - takes
+        // ownership of the message, spools it, and returns without touching
+        // the broker.  droppable marks messages whose value expires quickly;
+        // only those are discarded when the spool overflows.
+        bool QueueMessageForSend(BytesMessage* message, bool image_bearing, bool droppable);
 
         void close();
 
@@ -86,7 +118,27 @@ namespace golf_sim {
         void onException(const CMSException& ex AMQCPP_UNUSED);
         void cleanup();
 
+        // The spool-draining loop behind kUseAsyncMessageSend, and its
+        // shutdown counterpart (called from Shutdown/cleanup).
+        void RunAsyncSenderThread();
+        void StopAsyncSender();
+
         Thread* producer_thread_ = nullptr;
+
+        // One spooled, not-yet-sent message.  The spool owns the message
+        // until it is sent (or dropped).
+        struct SpooledMessage {
+            BytesMessage* message = nullptr;
+            bool image_bearing = false;
+            bool droppable = false;
+        };
+
+        std::mutex spool_mutex_;
+        std::condition_variable spool_cv_;
+        std::deque<SpooledMessage> spool_;
+        std::thread* async_sender_thread_ = nullptr;
+        bool async_sender_running_ = false;
+        long spooled_messages_dropped_ = 0;
     };
 
 
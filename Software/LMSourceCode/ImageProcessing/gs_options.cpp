@@ -107,6 +107,16 @@ bool GolfSimOptions::Parse(int argc, char *argv[])
 		throw std::runtime_error("Invalid golfer_orientation: " + golfer_orientation_string_);
 	golfer_orientation_ = (GolferOrientation)orientation_table[golfer_orientation_string_];
 
+	if (!test_shard_string_.empty()) {
+		size_t separator_position = test_shard_string_.find('/');
+		if (separator_position == std::string::npos)
+			throw std::runtime_error("Invalid test_shard (expected <index>/<count>): " + test_shard_string_);
+		test_shard_index_ = std::stoi(test_shard_string_.substr(0, separator_position));
+		test_shard_count_ = std::stoi(test_shard_string_.substr(separator_position + 1));
+		if (test_shard_count_ < 1 || test_shard_index_ < 0 || test_shard_index_ >= test_shard_count_)
+			throw std::runtime_error("Invalid test_shard (expected 0 <= index < count): " + test_shard_string_);
+	}
+
 	if (help_)
 	{
 		std::cout << options_;
@@ -147,6 +157,8 @@ void GolfSimOptions::Print() const
 		std::cout << "    gspro_host_address: " << gspro_host_address_ << std::endl;
 	if (!config_file_.empty())
 		std::cout << "    configuration file: " << config_file_ << std::endl;
+	if (!test_shard_string_.empty())
+		std::cout << "    test_shard: " << test_shard_string_ << std::endl;
 	std::cout << "    pulse_test: " << std::to_string(perform_pulse_test_) << std::endl;
 	std::cout << "    golfer_orientation: " << golfer_orientation_string_ << std::endl;
 	std::cout << "    practice_ball: " << std::to_string(practice_ball_) << std::endl;
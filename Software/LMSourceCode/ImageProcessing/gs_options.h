@@ -126,6 +126,8 @@ namespace golf_sim {
 					"Specify the name or IP address of the host PC that is running the GSPro simulator.  Default is: <empty string>, indicating no GSPro sim is connected.")
 				("config_file", value<std::string>(&config_file_)->default_value("golf_sim_config.json"),
 					"Specify the filename with the JSON configuration.  Default is: golf_sim_config.json")
+				("test_shard", value<std::string>(&test_shard_string_)->default_value(""),
+					"In automated_testing mode, run only every <count>th test case, starting at <index>.  Format is <index>/<count>, e.g., 0/3.  Allows a test corpus to be split across machines.  Default is: <empty> (run all cases)")
 				("cmd_file,cmd", value<std::string>(&command_line_file_)->implicit_value("config.txt"),
 					"Read the options from a file. If no filename is specified, default to config.txt. "
 					"In case of duplicate options, the ones provided on the command line will be used. "
@@ -164,6 +166,9 @@ namespace golf_sim {
 		std::string e6_host_address_;
 		std::string gspro_host_address_;
 		std::string config_file_;
+		std::string test_shard_string_;
+		int test_shard_index_ = 0;
+		int test_shard_count_ = 1;
 		std::string golfer_orientation_string_;
 		SystemMode system_mode_;
 		LoggingLevel logging_level_;
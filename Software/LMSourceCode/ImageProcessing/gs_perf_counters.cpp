@@ -0,0 +1,202 @@
+/*****************************************************************//**
+ * \file   gs_perf_counters.cpp
+ * \brief  Hardware performance-counter brackets for the pipeline stages.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+ /* SPDX-License-Identifier: GPL-2.0-only */
+ /*
+  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+  */
+
+#ifdef __unix__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <map>
+#include <mutex>
+
+#include "logging_tools.h"
+#include "gs_config.h"
+
+#include "gs_perf_counters.h"
+
+
+namespace golf_sim {
+
+    bool GsPerfCounters::kEnablePerfCounters = false;
+
+    namespace {
+
+        struct StageCounters {
+            long long calls = 0;
+            long long cycles = 0;
+            long long cache_misses = 0;
+            long long branch_misses = 0;
+        };
+
+        std::mutex counters_mutex;
+        std::map<std::string, StageCounters> shot_stage_counters;
+
+#ifdef __unix__
+
+        // The counter file descriptors are per-thread (perf_event follows the
+        // opening thread), opened lazily on the first bracket a thread runs
+        struct ThreadPerfFds {
+            int cycles_fd = -1;
+            int cache_misses_fd = -1;
+            int branch_misses_fd = -1;
+            bool open_attempted = false;
+
+            ~ThreadPerfFds() {
+                if (cycles_fd >= 0) close(cycles_fd);
+                if (cache_misses_fd >= 0) close(cache_misses_fd);
+                if (branch_misses_fd >= 0) close(branch_misses_fd);
+            }
+        };
+
+        thread_local ThreadPerfFds thread_perf_fds;
+
+        int OpenHardwareCounter(uint64_t config) {
+            struct perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = config;
+            attr.disabled = 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            // This thread, any CPU
+            return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+
+        bool EnsureThreadCounters() {
+            if (!thread_perf_fds.open_attempted) {
+                thread_perf_fds.open_attempted = true;
+
+                thread_perf_fds.cycles_fd = OpenHardwareCounter(PERF_COUNT_HW_CPU_CYCLES);
+                thread_perf_fds.cache_misses_fd = OpenHardwareCounter(PERF_COUNT_HW_CACHE_MISSES);
+                thread_perf_fds.branch_misses_fd = OpenHardwareCounter(PERF_COUNT_HW_BRANCH_MISSES);
+
+                if (thread_perf_fds.cycles_fd < 0) {
+                    // Most likely kernel.perf_event_paranoid is too restrictive
+                    GS_LOG_MSG(warning, "GsPerfCounters - perf_event_open failed (check /proc/sys/kernel/perf_event_paranoid).  "
+                        "Counters will not be gathered on this thread.");
+                }
+            }
+
+            return thread_perf_fds.cycles_fd >= 0;
+        }
+
+        long long ReadCounter(int fd) {
+            long long value = 0;
+
+            if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value)) {
+                return 0;
+            }
+
+            return value;
+        }
+
+#endif // __unix__
+    }
+
+
+    void GsPerfCounters::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.logging.kEnablePerfCounters", kEnablePerfCounters);
+
+        if (kEnablePerfCounters) {
+            GS_LOG_TRACE_MSG(trace, "GsPerfCounters enabled - gathering cycles/cache-misses/branch-misses per pipeline stage.");
+        }
+    }
+
+
+    void GsPerfCounters::ResetShotCounters() {
+
+        if (!kEnablePerfCounters) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(counters_mutex);
+        shot_stage_counters.clear();
+    }
+
+
+    std::string GsPerfCounters::FormatShotCounters() {
+
+        if (!kEnablePerfCounters) {
+            return "";
+        }
+
+        std::lock_guard<std::mutex> lock(counters_mutex);
+
+        if (shot_stage_counters.empty()) {
+            return "";
+        }
+
+        std::string s = "Perf counters (cycles / cache-misses / branch-misses):";
+
+        for (const auto& [stage_name, counters] : shot_stage_counters) {
+            s += "\n    " + stage_name + ": " +
+                std::to_string(counters.cycles) + " / " +
+                std::to_string(counters.cache_misses) + " / " +
+                std::to_string(counters.branch_misses) +
+                " (" + std::to_string(counters.calls) + " call(s))";
+        }
+
+        return s;
+    }
+
+
+#ifdef __unix__
+
+    GsPerfCounters::ScopedStage::ScopedStage(const char* stage_name) : stage_name_(stage_name) {
+
+        if (!kEnablePerfCounters || !EnsureThreadCounters()) {
+            return;
+        }
+
+        active_ = true;
+        start_cycles_ = ReadCounter(thread_perf_fds.cycles_fd);
+        start_cache_misses_ = ReadCounter(thread_perf_fds.cache_misses_fd);
+        start_branch_misses_ = ReadCounter(thread_perf_fds.branch_misses_fd);
+    }
+
+
+    GsPerfCounters::ScopedStage::~ScopedStage() {
+
+        if (!active_) {
+            return;
+        }
+
+        long long cycles = ReadCounter(thread_perf_fds.cycles_fd) - start_cycles_;
+        long long cache_misses = ReadCounter(thread_perf_fds.cache_misses_fd) - start_cache_misses_;
+        long long branch_misses = ReadCounter(thread_perf_fds.branch_misses_fd) - start_branch_misses_;
+
+        std::lock_guard<std::mutex> lock(counters_mutex);
+
+        StageCounters& counters = shot_stage_counters[stage_name_];
+        counters.calls++;
+        counters.cycles += cycles;
+        counters.cache_misses += cache_misses;
+        counters.branch_misses += branch_misses;
+    }
+
+#else // Not __unix__ - no perf_event, so the brackets are inert
+
+    GsPerfCounters::ScopedStage::ScopedStage(const char* stage_name) : stage_name_(stage_name) {
+    }
+
+    GsPerfCounters::ScopedStage::~ScopedStage() {
+    }
+
+#endif
+
+}
@@ -0,0 +1,68 @@
+/*****************************************************************//**
+ * \file   gs_perf_counters.h
+ * \brief  Hardware performance-counter brackets for the pipeline stages.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace golf_sim {
+
+    // A lightweight Linux perf_event layer that brackets the named image-processing
+    // stages and accumulates per-shot hardware counters - CPU cycles, cache misses,
+    // and branch misses.  GS_LOG wall-clock timings say how long a stage took; the
+    // counters say why, which is what the SIMD/cache work needs to target.
+    //
+    // Disabled by default (gs_config.logging.kEnablePerfCounters).  On non-Linux
+    // builds, or when perf_event_open is unavailable (e.g., a restrictive
+    // perf_event_paranoid setting), the brackets quietly do nothing.
+
+    class GsPerfCounters {
+
+    public:
+
+        static bool kEnablePerfCounters;
+
+        // Reads the configuration.  Call once at startup.
+        static void Initialize();
+
+        // Clears the per-stage accumulators.  Called at the start of each
+        // shot analysis.
+        static void ResetShotCounters();
+
+        // Returns a per-stage summary of the counters gathered since the last
+        // reset, or an empty string if disabled or nothing was recorded.
+        static std::string FormatShotCounters();
+
+        // RAII bracket for one named pipeline stage.  The counters are read on
+        // construction and destruction, and the deltas are accumulated under
+        // the stage's name.  The counters are per-thread, so a stage running on
+        // a worker thread charges only its own work.
+        class ScopedStage {
+
+        public:
+            explicit ScopedStage(const char* stage_name);
+            ~ScopedStage();
+
+            ScopedStage(const ScopedStage&) = delete;
+            ScopedStage& operator=(const ScopedStage&) = delete;
+
+        private:
+            const char* stage_name_;
+            bool active_ = false;
+            long long start_cycles_ = 0;
+            long long start_cache_misses_ = 0;
+            long long start_branch_misses_ = 0;
+        };
+    };
+
+}
@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "gs_projection_cache.h"
+#include "gs_config.h"
+#include "logging_tools.h"
+
+namespace golf_sim {
+
+    bool GsProjectionCache::kEnableProjectionMapCache = true;
+    std::string GsProjectionCache::kProjectionMapCacheDir = "/tmp/pitrac_projection_cache";
+
+    std::map<int, GsProjectionCache::MappedZMap*> GsProjectionCache::mapped_z_maps_;
+    std::mutex GsProjectionCache::cache_mutex_;
+    bool GsProjectionCache::configuration_loaded_ = false;
+
+    // Simple header so that stale or truncated cache files can be recognized and rebuilt
+    struct ZMapFileHeader {
+        uint32_t magic = 0x505A4D31;    // "PZM1"
+        uint32_t radius_pixels = 0;
+        uint32_t side = 0;
+    };
+
+    struct GsProjectionCache::MappedZMap {
+        boost::interprocess::file_mapping file_mapping_;
+        boost::interprocess::mapped_region mapped_region_;
+        const float* table_ = nullptr;
+    };
+
+    int GsProjectionCache::GetZMapMargin(int radius_pixels) {
+        return radius_pixels + 1;
+    }
+
+    int GsProjectionCache::GetZMapSide(int radius_pixels) {
+        return 2 * GetZMapMargin(radius_pixels) + 1;
+    }
+
+    std::string GsProjectionCache::GetZMapFileName(int radius_pixels) {
+        return kProjectionMapCacheDir + "/projection_z_r" + std::to_string(radius_pixels) + ".bin";
+    }
+
+    bool GsProjectionCache::BuildZMapFile(const std::string& file_name, int radius_pixels) {
+
+        const int margin = GetZMapMargin(radius_pixels);
+        const int side = GetZMapSide(radius_pixels);
+        const double r_squared = (double)radius_pixels * (double)radius_pixels;
+
+        std::vector<float> table((size_t)side * (size_t)side, 0.0F);
+
+        for (int dy = -margin; dy <= margin; dy++) {
+            for (int dx = -margin; dx <= margin; dx++) {
+                double diff = r_squared - ((double)dx * dx + (double)dy * dy);
+                if (diff > 0.0) {
+                    table[(size_t)(dy + margin) * side + (dx + margin)] = (float)sqrt(diff);
+                }
+            }
+        }
+
+        ZMapFileHeader header;
+        header.radius_pixels = (uint32_t)radius_pixels;
+        header.side = (uint32_t)side;
+
+        std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            GS_LOG_MSG(warning, "GsProjectionCache could not create cache file: " + file_name);
+            return false;
+        }
+
+        file.write((const char*)&header, sizeof(header));
+        file.write((const char*)table.data(), (std::streamsize)(table.size() * sizeof(float)));
+        file.close();
+
+        return file.good();
+    }
+
+    const float* GsProjectionCache::GetZMap(int radius_pixels) {
+
+        if (radius_pixels <= 0) {
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+
+        if (!configuration_loaded_) {
+            GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kEnableProjectionMapCache", kEnableProjectionMapCache);
+            GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kProjectionMapCacheDir", kProjectionMapCacheDir);
+            configuration_loaded_ = true;
+        }
+
+        if (!kEnableProjectionMapCache) {
+            return nullptr;
+        }
+
+        auto existing = mapped_z_maps_.find(radius_pixels);
+        if (existing != mapped_z_maps_.end()) {
+            return existing->second->table_;
+        }
+
+        const std::string file_name = GetZMapFileName(radius_pixels);
+        const size_t expected_size = sizeof(ZMapFileHeader) +
+            (size_t)GetZMapSide(radius_pixels) * (size_t)GetZMapSide(radius_pixels) * sizeof(float);
+
+        try {
+            std::error_code ec;
+            std::filesystem::create_directories(kProjectionMapCacheDir, ec);
+
+            // (Re-)build the file if it is missing or does not look right
+            bool needs_build = !std::filesystem::exists(file_name, ec) ||
+                std::filesystem::file_size(file_name, ec) != expected_size;
+
+            if (needs_build && !BuildZMapFile(file_name, radius_pixels)) {
+                return nullptr;
+            }
+
+            MappedZMap* map = new MappedZMap;
+            map->file_mapping_ = boost::interprocess::file_mapping(file_name.c_str(), boost::interprocess::read_only);
+            map->mapped_region_ = boost::interprocess::mapped_region(map->file_mapping_, boost::interprocess::read_only);
+
+            const ZMapFileHeader* header = (const ZMapFileHeader*)map->mapped_region_.get_address();
+
+            if (map->mapped_region_.get_size() != expected_size ||
+                header->magic != ZMapFileHeader().magic ||
+                header->radius_pixels != (uint32_t)radius_pixels) {
+                GS_LOG_MSG(warning, "GsProjectionCache found an invalid cache file (will not use): " + file_name);
+                delete map;
+                return nullptr;
+            }
+
+            map->table_ = (const float*)((const char*)map->mapped_region_.get_address() + sizeof(ZMapFileHeader));
+            mapped_z_maps_[radius_pixels] = map;
+
+            GS_LOG_TRACE_MSG(trace, "GsProjectionCache mapped Z-map for radius " + std::to_string(radius_pixels) +
+                " from " + file_name);
+
+            return map->table_;
+        }
+        catch (const std::exception& e) {
+            GS_LOG_MSG(warning, "GsProjectionCache failed to map " + file_name + ": " + std::string(e.what()));
+            return nullptr;
+        }
+    }
+
+}
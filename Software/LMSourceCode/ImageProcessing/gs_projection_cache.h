@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// A persistent, memory-mapped cache of the 2D->3D ball projection geometry used by
+// the spin analysis.  For a given (quantized) ball radius, the hemisphere Z-height of
+// each pixel relative to the ball center is always the same, so that table is computed
+// once, persisted to a file, and memory-mapped on subsequent shots and process runs.
+// The per-pixel sqrt work in Project2dImageTo3dBall then becomes a table lookup.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace golf_sim {
+
+    class GsProjectionCache {
+
+    public:
+
+        // Set from the configuration .json file
+        static bool kEnableProjectionMapCache;
+        static std::string kProjectionMapCacheDir;
+
+        // Returns a pointer to the hemisphere Z-map for the given ball radius
+        // (in pixels, quantized to the nearest integer), creating and memory-mapping
+        // the backing file on first use.  Returns nullptr if the cache is disabled
+        // or could not be created - callers must then fall back to computing the
+        // projection directly.
+        //
+        // The returned table is row-major with side length (2 * radius_margin + 1),
+        // indexed by the X and Y pixel offsets from the ball center as
+        //      z = table[(dy + radius_margin) * side + (dx + radius_margin)]
+        // where radius_margin = GetZMapMargin(radius_pixels).  Entries outside the
+        // ball circle are 0.  The table remains valid (and mapped) for the life of
+        // the process.
+        static const float* GetZMap(int radius_pixels);
+
+        // The table extends a pixel beyond the quantized radius to keep lookups for
+        // slightly-outside points in bounds
+        static int GetZMapMargin(int radius_pixels);
+
+        // The side length of the (square) Z-map table for the given radius
+        static int GetZMapSide(int radius_pixels);
+
+    private:
+
+        // Computes the Z-map for the given radius and writes it to the cache file.
+        // Returns true on success.
+        static bool BuildZMapFile(const std::string& file_name, int radius_pixels);
+
+        static std::string GetZMapFileName(int radius_pixels);
+
+        // Holds the open mappings (keyed by quantized radius) for the life of the process
+        struct MappedZMap;
+        static std::map<int, MappedZMap*> mapped_z_maps_;
+        static std::mutex cache_mutex_;
+        static bool configuration_loaded_;
+    };
+
+}
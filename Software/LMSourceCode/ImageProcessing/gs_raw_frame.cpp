@@ -0,0 +1,206 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "logging_tools.h"
+
+#include "gs_raw_frame.h"
+
+namespace golf_sim {
+
+    const std::string GsRawFrame::kRawFrameExtension = ".gsraw";
+
+    namespace {
+
+        constexpr char kRawFrameMagic[4] = { 'G', 'S', 'R', 'F' };
+        constexpr uint32_t kRawFrameVersion = 1;
+
+        // The pixel plane starts on this boundary within the file so that a
+        // mapped plane is alignment-friendly for OpenCV and NEON code
+        constexpr uint32_t kRawFrameDataOffset = 64;
+
+        struct GsRawFrameHeader {
+            char magic[4];
+            uint32_t version;
+            int32_t rows;
+            int32_t cols;
+            int32_t cv_type;
+            uint32_t data_offset;
+            uint64_t step;       // Bytes per pixel row in the file
+            uint64_t data_size;  // rows * step
+        };
+
+        static_assert(sizeof(GsRawFrameHeader) <= kRawFrameDataOffset,
+                      "The raw frame header must fit before the aligned pixel plane");
+
+#ifdef __unix__
+        struct FrameMapping {
+            void* address;
+            size_t length;
+        };
+
+        // Tracks the live mappings so that the Mat views that Load hands out
+        // stay valid until the caller explicitly releases them
+        std::mutex mappings_mutex_;
+        std::vector<FrameMapping> mappings_;
+#endif
+    }
+
+
+    bool GsRawFrame::Write(const std::string& file_name, const cv::Mat& img) {
+
+        if (img.empty()) {
+            GS_LOG_MSG(warning, "GsRawFrame::Write called with an empty image for file name: " + file_name);
+            return false;
+        }
+
+        GsRawFrameHeader header{};
+        std::memcpy(header.magic, kRawFrameMagic, sizeof(header.magic));
+        header.version = kRawFrameVersion;
+        header.rows = img.rows;
+        header.cols = img.cols;
+        header.cv_type = img.type();
+        header.data_offset = kRawFrameDataOffset;
+        header.step = (uint64_t)img.cols * img.elemSize();
+        header.data_size = header.step * (uint64_t)img.rows;
+
+        std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+
+        if (!file) {
+            GS_LOG_MSG(warning, "GsRawFrame::Write - could not open file name: " + file_name);
+            return false;
+        }
+
+        file.write((const char*)&header, sizeof(header));
+
+        std::vector<char> padding(kRawFrameDataOffset - sizeof(header), 0);
+        file.write(padding.data(), (std::streamsize)padding.size());
+
+        // Write row by row so that Mats with row padding come out dense
+        for (int row = 0; row < img.rows; row++) {
+            file.write((const char*)img.ptr(row), (std::streamsize)header.step);
+        }
+
+        return (bool)file;
+    }
+
+
+    bool GsRawFrame::Load(const std::string& file_name, cv::Mat& img) {
+
+#ifdef __unix__
+        int fd = open(file_name.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            GS_LOG_MSG(warning, "GsRawFrame::Load - could not open file name: " + file_name);
+            return false;
+        }
+
+        struct stat file_info {};
+        if (fstat(fd, &file_info) != 0) {
+            close(fd);
+            return false;
+        }
+
+        size_t file_length = (size_t)file_info.st_size;
+
+        if (file_length < kRawFrameDataOffset) {
+            GS_LOG_MSG(warning, "GsRawFrame::Load - file is too small to be a raw frame: " + file_name);
+            close(fd);
+            return false;
+        }
+
+        // A private mapping lets the caller write to the returned Mat
+        // (copy-on-write) without disturbing the file
+        void* address = mmap(nullptr, file_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (address == MAP_FAILED) {
+            GS_LOG_MSG(warning, "GsRawFrame::Load - could not mmap file name: " + file_name);
+            return false;
+        }
+
+        const GsRawFrameHeader* header = (const GsRawFrameHeader*)address;
+
+        if (std::memcmp(header->magic, kRawFrameMagic, sizeof(kRawFrameMagic)) != 0 ||
+            header->version != kRawFrameVersion ||
+            (uint64_t)header->data_offset + header->data_size > file_length) {
+            GS_LOG_MSG(warning, "GsRawFrame::Load - not a valid raw frame file: " + file_name);
+            munmap(address, file_length);
+            return false;
+        }
+
+        img = cv::Mat(header->rows, header->cols, header->cv_type,
+                      (uint8_t*)address + header->data_offset, (size_t)header->step);
+
+        std::lock_guard<std::mutex> lock(mappings_mutex_);
+        mappings_.push_back(FrameMapping{ address, file_length });
+
+        return true;
+#else
+        // No mmap on this platform - fall back to an ordinary (but still
+        // decode-free) read into an owning Mat
+        std::ifstream file(file_name, std::ios::binary);
+
+        if (!file) {
+            GS_LOG_MSG(warning, "GsRawFrame::Load - could not open file name: " + file_name);
+            return false;
+        }
+
+        GsRawFrameHeader header{};
+        file.read((char*)&header, sizeof(header));
+
+        if (!file ||
+            std::memcmp(header.magic, kRawFrameMagic, sizeof(kRawFrameMagic)) != 0 ||
+            header.version != kRawFrameVersion) {
+            GS_LOG_MSG(warning, "GsRawFrame::Load - not a valid raw frame file: " + file_name);
+            return false;
+        }
+
+        img.create(header.rows, header.cols, header.cv_type);
+
+        file.seekg(header.data_offset);
+        for (int row = 0; row < img.rows; row++) {
+            file.read((char*)img.ptr(row), (std::streamsize)header.step);
+        }
+
+        return (bool)file;
+#endif
+    }
+
+
+    bool GsRawFrame::IsRawFrameFile(const std::string& file_name) {
+        if (file_name.size() < kRawFrameExtension.size()) {
+            return false;
+        }
+        return file_name.compare(file_name.size() - kRawFrameExtension.size(),
+                                 kRawFrameExtension.size(), kRawFrameExtension) == 0;
+    }
+
+
+    void GsRawFrame::ReleaseMappings() {
+#ifdef __unix__
+        std::lock_guard<std::mutex> lock(mappings_mutex_);
+
+        for (const FrameMapping& mapping : mappings_) {
+            munmap(mapping.address, mapping.length);
+        }
+
+        mappings_.clear();
+#endif
+    }
+
+}
@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// A minimal, mmap-able container for raw (un-encoded) frames.
+//
+// PNG encode/decode dominates the run time of image-heavy regression jobs,
+// so the test harness and the flight recorder can shuttle frames through
+// this format instead:  a small header followed by the uncompressed pixel
+// plane, with the plane 64-byte aligned in the file so that a loaded frame
+// can be used as a cv::Mat view directly over the memory mapping.
+
+#pragma once
+
+#include <string>
+
+#include <opencv2/core.hpp>
+
+namespace golf_sim {
+
+    class GsRawFrame {
+
+    public:
+
+        // The file extension that identifies raw frame files (".gsraw")
+        static const std::string kRawFrameExtension;
+
+        // Writes the image to file_name, uncompressed.  Mats with row padding
+        // (e.g., ROI views) are written densely.
+        static bool Write(const std::string& file_name, const cv::Mat& img);
+
+        // Loads a raw frame file.  On Linux the returned Mat is a view directly
+        // over a private (copy-on-write) file mapping - no pixels are copied or
+        // decoded.  The mapping remains valid until ReleaseMappings() is called,
+        // after which any Mats returned by Load must no longer be used.
+        static bool Load(const std::string& file_name, cv::Mat& img);
+
+        // Returns true if the file name ends in kRawFrameExtension
+        static bool IsRawFrameFile(const std::string& file_name);
+
+        // Unmaps every file mapping created by Load.  Intended for the end of
+        // a corpus run.
+        static void ReleaseMappings();
+    };
+
+}
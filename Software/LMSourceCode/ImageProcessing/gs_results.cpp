@@ -45,19 +45,42 @@ namespace golf_sim {
     }
 
     std::string GsResults::Format() const {
-        std::string s;
-        s =  "Shot No.:         " + std::to_string(shot_number_) + "\n";
-        s += "Speed (mph):      " + std::to_string(speed_mph_) + "\n";
-        s += "Launch Angle:     " + std::to_string(vla_deg_) + "\n";
-        s += "Side Angle:       " + std::to_string(hla_deg_) + "\n";
-        s += "Back Spin (rpm):  " + std::to_string(back_spin_rpm_) + "\n";
-        s += "Side Spin:        " + std::to_string(side_spin_rpm_) + "\n";
-        s += "Spin Axis (deg.): " + std::to_string(GetSpinAxis()) + "\n";
-        s += "Club Type: (1D 3P)" + std::to_string(club_type_) + "\n";
 
-        // TBD - Add internal carry value.
+        std::string buffer;
+        FormatInto(buffer);
+        return buffer;
+    }
+
+    void GsResults::FormatInto(std::string& buffer) const {
+
+        buffer.clear();
 
-        return s;
+        if (buffer.capacity() < 256) {
+            buffer.reserve(256);
+        }
+
+        // A single pass through the format library instead of a chain of
+        // std::to_string temporaries and string concatenations.  The {:f}
+        // conversions match std::to_string's six-digit output.
+        buffer += GS_FORMATLIB_FORMAT(
+            "Shot No.:         {}\n"
+            "Speed (mph):      {:f}\n"
+            "Launch Angle:     {:f}\n"
+            "Side Angle:       {:f}\n"
+            "Back Spin (rpm):  {}\n"
+            "Side Spin:        {}\n"
+            "Spin Axis (deg.): {:f}\n"
+            "Club Type: (1D 3P){}\n",
+            shot_number_,
+            speed_mph_,
+            vla_deg_,
+            hla_deg_,
+            back_spin_rpm_,
+            side_spin_rpm_,
+            GetSpinAxis(),
+            (int)club_type_);
+
+        // TBD - Add internal carry value.
     }
 
     std::string GsResults::FormatDoubleAsString(const double original_value) {
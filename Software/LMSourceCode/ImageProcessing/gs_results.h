@@ -26,6 +26,13 @@ namespace golf_sim {
         virtual ~GsResults();
         virtual std::string Format() const;
 
+        // Serializes into buffer, which is cleared first.  The base class
+        // produces the human-readable block that Format() returns; the
+        // sim-specific subclasses override this with their JSON wire formats.
+        // Callers that format on every shot (or every status update) should
+        // hold one buffer and reuse it across calls.
+        virtual void FormatInto(std::string& buffer) const;
+
         // Negative means tilted to the left when the ball is viewed from
         // behind looking down along the line of flight away from the golfer.
         // Negative means the ball will curve to the left.  Negative side spin
@@ -53,6 +60,11 @@ namespace golf_sim {
         // Some systems need a keep-alive
         bool result_message_is_keepalive_ = false;
 
+        // True when these results are the spin-bearing second phase of a
+        // progressively-delivered shot (same shot_number_ as the ballistics
+        // that went out earlier).  See GsSimInterface::kUseProgressiveResultDelivery.
+        bool result_is_spin_update_ = false;
+
     };
 
 }
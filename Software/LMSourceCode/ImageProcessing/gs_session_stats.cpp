@@ -0,0 +1,251 @@
+/*****************************************************************//**
+ * \file   gs_session_stats.cpp
+ * \brief  Incremental per-club session statistics over shot results.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <cmath>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "gs_session_stats.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+
+namespace golf_sim {
+
+    bool GsSessionStats::kEnableSessionStats = false;
+    std::string GsSessionStats::kSessionStatsFile = "/var/cache/pitrac/pitrac_session_stats.json";
+
+    namespace {
+
+        // One metric's Welford running state.  Folding in a sample is O(1)
+        // and numerically stable, and the variance falls straight out of m2.
+        struct RunningMetric {
+            double mean = 0.;
+            double m2 = 0.;
+
+            void Add(double sample, long count_after_add) {
+                double delta = sample - mean;
+                mean += delta / (double)count_after_add;
+                m2 += delta * (sample - mean);
+            }
+
+            double StdDev(long count) const {
+                return (count > 1) ? std::sqrt(m2 / (double)(count - 1)) : 0.;
+            }
+        };
+
+        struct ClubAggregates {
+            long shot_count = 0;
+            RunningMetric speed_mph;
+            RunningMetric vla_deg;
+            RunningMetric hla_deg;
+            RunningMetric back_spin_rpm;
+            RunningMetric side_spin_rpm;
+        };
+
+        // Keyed by GsClubType.  A session uses at most a handful of clubs.
+        std::map<int, ClubAggregates> club_aggregates_;
+
+        // RecordShot runs on the FSM thread; the stats request is handled
+        // there too, but the mutex keeps the store safe if that changes.
+        std::mutex stats_mutex_;
+
+        bool stats_save_failed_logged_ = false;
+
+        std::string ClubName(int club_type) {
+            switch (club_type) {
+                case GolfSimClubs::GsClubType::kDriver:  return "Driver";
+                case GolfSimClubs::GsClubType::kIron:    return "Iron";
+                case GolfSimClubs::GsClubType::kPutter:  return "Putter";
+                default:                                 return "Unspecified club";
+            }
+        }
+
+        void LoadAggregates() {
+
+            boost::property_tree::ptree file_tree;
+
+            try {
+                boost::property_tree::read_json(GsSessionStats::kSessionStatsFile, file_tree);
+            }
+            catch (std::exception&) {
+                // No file yet - the session starts empty
+                return;
+            }
+
+            for (const auto& club_entry : file_tree) {
+
+                int club_type = club_entry.second.get<int>("club_type", -1);
+                long shot_count = club_entry.second.get<long>("shot_count", 0);
+
+                if (club_type < 0 || shot_count <= 0) {
+                    continue;
+                }
+
+                ClubAggregates& aggregates = club_aggregates_[club_type];
+                aggregates.shot_count = shot_count;
+
+                auto load_metric = [&club_entry](const char* name, RunningMetric& metric) {
+                    metric.mean = club_entry.second.get<double>(std::string(name) + "_mean", 0.);
+                    metric.m2 = club_entry.second.get<double>(std::string(name) + "_m2", 0.);
+                };
+
+                load_metric("speed_mph", aggregates.speed_mph);
+                load_metric("vla_deg", aggregates.vla_deg);
+                load_metric("hla_deg", aggregates.hla_deg);
+                load_metric("back_spin_rpm", aggregates.back_spin_rpm);
+                load_metric("side_spin_rpm", aggregates.side_spin_rpm);
+            }
+
+            if (!club_aggregates_.empty()) {
+                GS_LOG_MSG(info, "GsSessionStats resumed session aggregates from " +
+                    GsSessionStats::kSessionStatsFile + ".");
+            }
+        }
+
+        // Rewrites the (small) stats file.  Called once per shot, right
+        // after the shot is journaled.
+        void SaveAggregates() {
+
+            boost::property_tree::ptree file_tree;
+
+            for (const auto& [club_type, aggregates] : club_aggregates_) {
+
+                boost::property_tree::ptree club_tree;
+
+                club_tree.put("club_type", club_type);
+                club_tree.put("shot_count", aggregates.shot_count);
+
+                auto save_metric = [&club_tree](const char* name, const RunningMetric& metric) {
+                    club_tree.put(std::string(name) + "_mean", metric.mean);
+                    club_tree.put(std::string(name) + "_m2", metric.m2);
+                };
+
+                save_metric("speed_mph", aggregates.speed_mph);
+                save_metric("vla_deg", aggregates.vla_deg);
+                save_metric("hla_deg", aggregates.hla_deg);
+                save_metric("back_spin_rpm", aggregates.back_spin_rpm);
+                save_metric("side_spin_rpm", aggregates.side_spin_rpm);
+
+                file_tree.push_back(std::make_pair("", club_tree));
+            }
+
+            try {
+                std::filesystem::path stats_path(GsSessionStats::kSessionStatsFile);
+
+                if (stats_path.has_parent_path()) {
+                    std::error_code ec;
+                    std::filesystem::create_directories(stats_path.parent_path(), ec);
+                }
+
+                boost::property_tree::write_json(GsSessionStats::kSessionStatsFile, file_tree);
+            }
+            catch (std::exception& e) {
+                if (!stats_save_failed_logged_) {
+                    LoggingTools::Warning("GsSessionStats could not save " +
+                        GsSessionStats::kSessionStatsFile + " (" + std::string(e.what()) +
+                        ").  Session statistics will not survive a restart.");
+                    stats_save_failed_logged_ = true;
+                }
+            }
+        }
+    }
+
+
+    void GsSessionStats::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.modes.kEnableSessionStats", kEnableSessionStats);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kSessionStatsFile", kSessionStatsFile);
+
+        if (!kEnableSessionStats) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        LoadAggregates();
+    }
+
+
+    void GsSessionStats::RecordShot(const GsResults& results) {
+
+        if (!kEnableSessionStats) {
+            return;
+        }
+
+        // A spin update re-delivers a shot whose ballistics were already
+        // counted; a keepalive is not a shot at all
+        if (results.result_message_is_keepalive_ || results.result_is_spin_update_) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+
+        ClubAggregates& aggregates = club_aggregates_[(int)results.club_type_];
+        aggregates.shot_count++;
+
+        aggregates.speed_mph.Add(results.speed_mph_, aggregates.shot_count);
+        aggregates.vla_deg.Add(results.vla_deg_, aggregates.shot_count);
+        aggregates.hla_deg.Add(results.hla_deg_, aggregates.shot_count);
+        aggregates.back_spin_rpm.Add(results.back_spin_rpm_, aggregates.shot_count);
+        aggregates.side_spin_rpm.Add(results.side_spin_rpm_, aggregates.shot_count);
+
+        SaveAggregates();
+    }
+
+
+    std::string GsSessionStats::FormatSessionStats() {
+
+        if (!kEnableSessionStats) {
+            return "";
+        }
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+
+        if (club_aggregates_.empty()) {
+            return "";
+        }
+
+        long total_shots = 0;
+        for (const auto& [club_type, aggregates] : club_aggregates_) {
+            total_shots += aggregates.shot_count;
+        }
+
+        std::stringstream s;
+        s.setf(std::ios::fixed);
+        s.precision(1);
+
+        s << "Session statistics (" << total_shots << " shots)";
+
+        for (const auto& [club_type, aggregates] : club_aggregates_) {
+
+            long n = aggregates.shot_count;
+
+            s << "\n" << ClubName(club_type) << ": " << n << " shots"
+              << ", speed " << aggregates.speed_mph.mean << " mph (sd " << aggregates.speed_mph.StdDev(n) << ")"
+              << ", VLA " << aggregates.vla_deg.mean << " deg (sd " << aggregates.vla_deg.StdDev(n) << ")"
+              << ", HLA " << aggregates.hla_deg.mean << " deg (sd " << aggregates.hla_deg.StdDev(n) << ")"
+              << ", back spin " << (long)std::lround(aggregates.back_spin_rpm.mean)
+              << " rpm (sd " << (long)std::lround(aggregates.back_spin_rpm.StdDev(n)) << ")"
+              << ", side spin " << (long)std::lround(aggregates.side_spin_rpm.mean)
+              << " rpm (sd " << (long)std::lround(aggregates.side_spin_rpm.StdDev(n)) << ")";
+        }
+
+        return s.str();
+    }
+
+}
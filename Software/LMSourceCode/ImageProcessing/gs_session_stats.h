@@ -0,0 +1,63 @@
+/*****************************************************************//**
+ * \file   gs_session_stats.h
+ * \brief  Incremental per-club session statistics over shot results.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "gs_results.h"
+
+namespace golf_sim {
+
+    // The GUI's stats view used to be fed by re-reading every shot of the
+    // session and recomputing averages and dispersion from scratch on each
+    // request - fine for ten shots, a multi-second stall (on the Pi that is
+    // also running the cameras) for a thousand-shot range session.
+    //
+    // This engine instead folds each shot into per-club running aggregates
+    // as the results go out - O(1) per shot via Welford's online
+    // mean/variance update, so a session never gets slower as it grows.
+    // The aggregates are persisted next to the shot journal on every shot
+    // and reloaded at startup, surviving a crash or warm restart the same
+    // way the journal does.  The GUI queries them with a
+    // kRequestSessionStats control message and gets the formatted summary
+    // back on the normal status-message path.  Deleting the stats file
+    // starts a fresh session.
+    //
+    // Off by default (gs_config.modes.kEnableSessionStats).
+
+    class GsSessionStats {
+
+    public:
+
+        static bool kEnableSessionStats;
+        static std::string kSessionStatsFile;
+
+        // Reads the configuration values above and loads any persisted
+        // aggregates.  Call once at startup, after the JSON configuration
+        // has been parsed.
+        static void Initialize();
+
+        // Folds one shot's results into the running per-club aggregates and
+        // persists them.  Called where the shot is journaled, so the two
+        // stores always agree.  Keepalives and progressive spin updates
+        // (re-sends of an already-counted shot) are ignored.
+        static void RecordShot(const GsResults& results);
+
+        // Formats the per-club aggregates (shot counts, means and standard
+        // deviations) for display.  Returns "" when disabled or when no
+        // shots have been recorded yet.
+        static std::string FormatSessionStats();
+    };
+
+}
@@ -0,0 +1,279 @@
+/*****************************************************************//**
+ * \file   gs_shot_journal.cpp
+ * \brief  Crash-safe append-only journal of per-shot results.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#ifdef __unix__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+#include "gs_shot_journal.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+#include "gs_shot_trace.h"
+
+namespace golf_sim {
+
+    bool GsShotJournal::kEnableShotJournal = false;
+    std::string GsShotJournal::kShotJournalFile = "/var/cache/pitrac/pitrac_shot_journal.bin";
+
+    namespace {
+
+        // Bump whenever the record layout changes.  An old-format journal is
+        // then simply ignored rather than misread.
+        const uint32_t kJournalFormatVersion = 1;
+        const char kJournalMagic[4] = { 'P', 'T', 'S', 'J' };
+
+        // Marks the start of each record so that a trailing record torn by a
+        // crash mid-write is recognizable and can be ignored on recovery.
+        const uint32_t kRecordMarker = 0x544F4853;  // "SHOT"
+
+        // The on-disk layouts.  Fixed sizes keep an append to a single
+        // write at the end of the file and let recovery seek by record.
+        struct DiskHeader {
+            char magic[4];
+            uint32_t format_version;
+            uint32_t record_size;
+        };
+
+        struct DiskRecord {
+            uint32_t marker;
+            uint32_t reserved;
+            int64_t time_ms;
+            int64_t shot_number;
+            float speed_mph;
+            float hla_deg;
+            float vla_deg;
+            int32_t back_spin_rpm;
+            int32_t side_spin_rpm;
+            int32_t club_type;
+            // The cross-Pi trace ID (see GsShotTrace), carved out of the
+            // spare space - journals written before the field existed read
+            // back as 0 here, which is the "no trace" value anyway.
+            int64_t shot_trace_id;
+            // Room for future fields without a format bump being forced by
+            // every addition - unused bytes are written as zero.
+            uint32_t spare[2];
+        };
+
+        static_assert(sizeof(DiskHeader) == 12, "Unexpected journal header size");
+        static_assert(sizeof(DiskRecord) == 64, "Unexpected journal record size");
+
+        std::mutex journal_mutex;
+
+#ifdef __unix__
+        int journal_fd = -1;
+#else
+        std::ofstream journal_stream;
+#endif
+        bool journal_open_failed_logged = false;
+
+        // Opens (creating if necessary) the journal for appending and writes
+        // the header when the file is fresh.  Returns false on failure,
+        // logging the problem only once so a read-only filesystem does not
+        // flood the log on every shot.
+        bool EnsureJournalOpen() {
+
+            std::error_code ec;
+            std::filesystem::path journal_path(GsShotJournal::kShotJournalFile);
+
+            if (journal_path.has_parent_path()) {
+                std::filesystem::create_directories(journal_path.parent_path(), ec);
+            }
+
+            uintmax_t existing_size = std::filesystem::file_size(journal_path, ec);
+            if (ec) {
+                existing_size = 0;
+            }
+
+#ifdef __unix__
+            if (journal_fd >= 0) {
+                return true;
+            }
+
+            journal_fd = ::open(GsShotJournal::kShotJournalFile.c_str(),
+                                O_CREAT | O_WRONLY | O_APPEND, 0644);
+
+            if (journal_fd < 0) {
+                if (!journal_open_failed_logged) {
+                    LoggingTools::Warning("GsShotJournal could not open " +
+                        GsShotJournal::kShotJournalFile + " for appending.  Shots will not be journalled.");
+                    journal_open_failed_logged = true;
+                }
+                return false;
+            }
+
+            if (existing_size < sizeof(DiskHeader)) {
+                DiskHeader header{};
+                std::memcpy(header.magic, kJournalMagic, sizeof(header.magic));
+                header.format_version = kJournalFormatVersion;
+                header.record_size = (uint32_t)sizeof(DiskRecord);
+
+                if (::write(journal_fd, &header, sizeof(header)) != (ssize_t)sizeof(header)) {
+                    LoggingTools::Warning("GsShotJournal failed to write the journal header.");
+                    ::close(journal_fd);
+                    journal_fd = -1;
+                    return false;
+                }
+            }
+
+            return true;
+#else
+            if (journal_stream.is_open()) {
+                return true;
+            }
+
+            journal_stream.open(GsShotJournal::kShotJournalFile,
+                                std::ios::binary | std::ios::app);
+
+            if (!journal_stream.is_open()) {
+                if (!journal_open_failed_logged) {
+                    LoggingTools::Warning("GsShotJournal could not open " +
+                        GsShotJournal::kShotJournalFile + " for appending.  Shots will not be journalled.");
+                    journal_open_failed_logged = true;
+                }
+                return false;
+            }
+
+            if (existing_size < sizeof(DiskHeader)) {
+                DiskHeader header{};
+                std::memcpy(header.magic, kJournalMagic, sizeof(header.magic));
+                header.format_version = kJournalFormatVersion;
+                header.record_size = (uint32_t)sizeof(DiskRecord);
+                journal_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            }
+
+            return true;
+#endif
+        }
+    }
+
+    void GsShotJournal::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.modes.kEnableShotJournal", kEnableShotJournal);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kShotJournalFile", kShotJournalFile);
+
+        if (!kEnableShotJournal) {
+            return;
+        }
+
+        std::vector<GsShotJournalRecord> prior_shots = ReadAll();
+
+        if (prior_shots.empty()) {
+            GS_LOG_TRACE_MSG(trace, "GsShotJournal enabled.  No prior shots in " + kShotJournalFile + ".");
+            return;
+        }
+
+        GS_LOG_MSG(info, "GsShotJournal recovered " + std::to_string(prior_shots.size()) +
+            " shot(s) from the prior session (last shot number " +
+            std::to_string(prior_shots.back().shot_number) + ") from " + kShotJournalFile + ".");
+    }
+
+    void GsShotJournal::Append(const GsResults& results) {
+
+        if (!kEnableShotJournal || results.result_message_is_keepalive_) {
+            return;
+        }
+
+        DiskRecord record{};
+        record.marker = kRecordMarker;
+        record.time_ms = (int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        record.shot_number = results.shot_number_;
+        record.speed_mph = results.speed_mph_;
+        record.hla_deg = results.hla_deg_;
+        record.vla_deg = results.vla_deg_;
+        record.back_spin_rpm = results.back_spin_rpm_;
+        record.side_spin_rpm = results.side_spin_rpm_;
+        record.club_type = (int32_t)results.club_type_;
+        record.shot_trace_id = (int64_t)GsShotTrace::Current();
+
+        std::lock_guard<std::mutex> lock(journal_mutex);
+
+        if (!EnsureJournalOpen()) {
+            return;
+        }
+
+#ifdef __unix__
+        if (::write(journal_fd, &record, sizeof(record)) != (ssize_t)sizeof(record)) {
+            LoggingTools::Warning("GsShotJournal failed to append shot " +
+                std::to_string(results.shot_number_) + " to " + kShotJournalFile + ".");
+            return;
+        }
+
+        // The sync is the point of the journal - without it a power loss can
+        // still take the shot with it.  One small synced write per shot is
+        // far below the noise floor of the result path.
+        if (::fdatasync(journal_fd) != 0) {
+            LoggingTools::Warning("GsShotJournal could not sync " + kShotJournalFile + " to disk.");
+        }
+#else
+        journal_stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+        journal_stream.flush();
+#endif
+    }
+
+    std::vector<GsShotJournalRecord> GsShotJournal::ReadAll() {
+
+        std::vector<GsShotJournalRecord> records;
+
+        std::ifstream file(kShotJournalFile, std::ios::binary);
+        if (!file.is_open()) {
+            return records;
+        }
+
+        DiskHeader header{};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (file.gcount() != sizeof(header) ||
+            std::memcmp(header.magic, kJournalMagic, sizeof(header.magic)) != 0 ||
+            header.format_version != kJournalFormatVersion ||
+            header.record_size != sizeof(DiskRecord)) {
+            LoggingTools::Warning("GsShotJournal found an unrecognized journal at " +
+                kShotJournalFile + ".  Ignoring it.");
+            return records;
+        }
+
+        for (;;) {
+            DiskRecord record{};
+            file.read(reinterpret_cast<char*>(&record), sizeof(record));
+
+            // A short or unmarked trailing record is a write that a crash
+            // interrupted - everything before it is still good.
+            if (file.gcount() != sizeof(record) || record.marker != kRecordMarker) {
+                break;
+            }
+
+            GsShotJournalRecord shot;
+            shot.time_ms = record.time_ms;
+            shot.shot_number = record.shot_number;
+            shot.speed_mph = record.speed_mph;
+            shot.hla_deg = record.hla_deg;
+            shot.vla_deg = record.vla_deg;
+            shot.back_spin_rpm = record.back_spin_rpm;
+            shot.side_spin_rpm = record.side_spin_rpm;
+            shot.club_type = record.club_type;
+            shot.shot_trace_id = record.shot_trace_id;
+            records.push_back(shot);
+        }
+
+        return records;
+    }
+
+}
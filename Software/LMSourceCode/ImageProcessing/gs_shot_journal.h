@@ -0,0 +1,79 @@
+/*****************************************************************//**
+ * \file   gs_shot_journal.h
+ * \brief  Crash-safe append-only journal of per-shot results.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "gs_results.h"
+
+namespace golf_sim {
+
+    // Shot results currently live only in memory and in whatever the web
+    // server happened to store, so a crash mid-session loses the session and
+    // reconstructing statistics means scraping logs.  This journal appends
+    // one fixed-size binary record per shot to a file and syncs it to disk
+    // before returning, so every completed shot survives a crash or power
+    // loss and the prior session can be read back instantly on restart.
+    //
+    // The file is a small header followed by fixed-size records, so an
+    // append is a single O(1) write at the end of the file and a partially
+    // written trailing record (torn by a crash mid-write) is detected by its
+    // per-record marker and ignored on recovery.
+    //
+    // Off by default (gs_config.modes.kEnableShotJournal).
+
+    // One journalled shot.  The fields mirror the GsResults members that a
+    // session summary needs; the timestamp is milliseconds since the epoch.
+    struct GsShotJournalRecord {
+        int64_t time_ms = 0;
+        int64_t shot_number = 0;
+        float speed_mph = 0.;
+        float hla_deg = 0.;
+        float vla_deg = 0.;
+        int32_t back_spin_rpm = 0;
+        int32_t side_spin_rpm = 0;
+        int32_t club_type = 0;
+        // The cross-Pi trace ID of the shot (see GsShotTrace), or 0 for
+        // records journalled before the ID existed.
+        int64_t shot_trace_id = 0;
+    };
+
+    class GsShotJournal {
+
+    public:
+
+        static bool kEnableShotJournal;
+
+        // Where the journal lives across restarts.  Appends are skipped
+        // (with a warning, once) if the location is not writable.
+        static std::string kShotJournalFile;
+
+        // Reads the configuration values above and, when enabled, scans any
+        // existing journal and logs how many shots it recovered.  Call once
+        // at startup, after the JSON configuration has been parsed.
+        static void Initialize();
+
+        // Appends one record for the results and syncs it to disk before
+        // returning.  Keep-alive results are not journalled.  Called on the
+        // result path, so failures are logged rather than thrown.
+        static void Append(const GsResults& results);
+
+        // Returns every valid record currently in the journal, oldest
+        // first.  Returns an empty vector if the journal is disabled,
+        // missing, or unreadable.
+        static std::vector<GsShotJournalRecord> ReadAll();
+    };
+
+}
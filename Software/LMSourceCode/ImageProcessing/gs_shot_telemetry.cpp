@@ -0,0 +1,166 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include <sys/resource.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "logging_tools.h"
+#include "gs_config.h"
+
+#include "gs_ipc_message_pool.h"
+#include "gs_mat_pool_allocator.h"
+
+#include "gs_shot_telemetry.h"
+
+
+namespace golf_sim {
+
+    bool GsShotTelemetry::kEnableShotTelemetry = false;
+
+    namespace {
+
+        // The BeginShot snapshot that FormatShotTelemetry deltas against.
+        struct MemorySnapshot {
+            long vm_rss_kb = 0;
+            long ru_maxrss_kb = 0;
+            long minor_faults = 0;
+            long major_faults = 0;
+            size_t malloc_in_use_bytes = 0;
+            uint64_t mat_pool_allocations = 0;
+            uint64_t mat_pool_hits = 0;
+            size_t mat_pool_retained_bytes = 0;
+            long ipc_pool_hits = 0;
+            long ipc_pool_overflows = 0;
+        };
+
+        std::mutex snapshot_mutex_;
+        MemorySnapshot shot_start_snapshot_;
+        bool snapshot_valid_ = false;
+
+        // Parses VmRSS from /proc/self/status.  Returns 0 if unavailable.
+        long ReadVmRssKb() {
+            std::ifstream status_file("/proc/self/status");
+            std::string line;
+
+            while (std::getline(status_file, line)) {
+                if (line.rfind("VmRSS:", 0) == 0) {
+                    return std::stol(line.substr(6));
+                }
+            }
+
+            return 0;
+        }
+
+        MemorySnapshot TakeSnapshot() {
+            MemorySnapshot snapshot;
+
+            snapshot.vm_rss_kb = ReadVmRssKb();
+
+            struct rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) == 0) {
+                snapshot.ru_maxrss_kb = usage.ru_maxrss;
+                snapshot.minor_faults = usage.ru_minflt;
+                snapshot.major_faults = usage.ru_majflt;
+            }
+
+#ifdef __GLIBC__
+            struct mallinfo2 malloc_info = mallinfo2();
+            snapshot.malloc_in_use_bytes = malloc_info.uordblks;
+#endif
+
+            GsMatPoolAllocator::GetStatistics(snapshot.mat_pool_allocations,
+                                              snapshot.mat_pool_hits,
+                                              snapshot.mat_pool_retained_bytes);
+            GsIPCMessagePool::GetStatistics(snapshot.ipc_pool_hits,
+                                            snapshot.ipc_pool_overflows);
+
+            return snapshot;
+        }
+    }
+
+
+    void GsShotTelemetry::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.modes.kEnableShotTelemetry", kEnableShotTelemetry);
+
+        if (kEnableShotTelemetry) {
+            GS_LOG_TRACE_MSG(trace, "GsShotTelemetry enabled - per-shot memory deltas will be sent with the shot results.");
+        }
+    }
+
+    void GsShotTelemetry::BeginShot() {
+
+        if (!kEnableShotTelemetry) {
+            return;
+        }
+
+        MemorySnapshot snapshot = TakeSnapshot();
+
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        shot_start_snapshot_ = snapshot;
+        snapshot_valid_ = true;
+    }
+
+    std::string GsShotTelemetry::FormatShotTelemetry() {
+
+        if (!kEnableShotTelemetry) {
+            return "";
+        }
+
+        MemorySnapshot start;
+        {
+            std::lock_guard<std::mutex> lock(snapshot_mutex_);
+
+            if (!snapshot_valid_) {
+                return "";
+            }
+
+            start = shot_start_snapshot_;
+
+            // One summary per shot - a re-sent results message (e.g., the
+            // later spin-rate update) should not report stale deltas.
+            snapshot_valid_ = false;
+        }
+
+        MemorySnapshot now = TakeSnapshot();
+
+        uint64_t mat_allocations = now.mat_pool_allocations - start.mat_pool_allocations;
+        uint64_t mat_hits = now.mat_pool_hits - start.mat_pool_hits;
+
+        std::stringstream s;
+        s << "Shot memory: rss " << now.vm_rss_kb << " kB ("
+          << std::showpos << (now.vm_rss_kb - start.vm_rss_kb) << std::noshowpos << " kB)"
+          << ", peak rss " << now.ru_maxrss_kb << " kB"
+          << ", faults " << (now.minor_faults - start.minor_faults) << " minor / "
+          << (now.major_faults - start.major_faults) << " major";
+
+#ifdef __GLIBC__
+        s << ", heap in use " << (now.malloc_in_use_bytes / 1024) << " kB ("
+          << std::showpos << (((long long)now.malloc_in_use_bytes - (long long)start.malloc_in_use_bytes) / 1024)
+          << std::noshowpos << " kB)";
+#endif
+
+        s << ", mat pool " << mat_hits << "/" << mat_allocations << " hits, "
+          << (now.mat_pool_retained_bytes / (1024 * 1024)) << " MB retained"
+          << ", ipc pool " << (now.ipc_pool_hits - start.ipc_pool_hits) << " hits, "
+          << (now.ipc_pool_overflows - start.ipc_pool_overflows) << " overflows";
+
+        return s.str();
+    }
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
@@ -0,0 +1,59 @@
+/*****************************************************************//**
+ * \file   gs_shot_telemetry.h
+ * \brief  Per-shot memory telemetry for the results diagnostics view.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#ifdef __unix__  // Ignore in Windows environment
+
+#include <string>
+
+namespace golf_sim {
+
+    // The logs give per-shot timing, but nothing shows per-shot memory
+    // behavior - how much the shot grew the process, how hard it churned
+    // the allocator, whether the Mat and IPC message pools actually
+    // absorbed the traffic.  On a 2GB Pi 4 the system runs a few hundred
+    // MB from the OOM cliff, and a change that quietly adds per-shot
+    // growth needs to be visible before the field finds it.
+    //
+    // This service snapshots getrusage, /proc/self/status, the glibc
+    // allocator and the pools' counters at the BallHit event, and when the
+    // shot's results go out it formats the deltas into one summary line
+    // that rides the results message's log messages to the GUI's
+    // diagnostics view - the same route the per-shot hardware performance
+    // counters take.
+    //
+    // Off by default (gs_config.modes.kEnableShotTelemetry).
+
+    class GsShotTelemetry {
+
+    public:
+
+        static bool kEnableShotTelemetry;
+
+        // Reads the configuration value above.  Call once at startup,
+        // after the JSON configuration has been parsed.
+        static void Initialize();
+
+        // Takes the start-of-shot snapshot.  Called at the BallHit event.
+        static void BeginShot();
+
+        // Formats the shot's memory deltas against the BeginShot snapshot.
+        // Returns "" when disabled or when no shot has been started, so
+        // callers can push the result unconditionally.
+        static std::string FormatShotTelemetry();
+    };
+
+}
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
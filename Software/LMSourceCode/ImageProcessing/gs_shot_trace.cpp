@@ -0,0 +1,81 @@
+/*****************************************************************//**
+ * \file   gs_shot_trace.cpp
+ * \brief  Per-shot trace ID correlating work across both Pis.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "gs_shot_trace.h"
+
+#include "logging_tools.h"
+
+namespace golf_sim {
+
+    namespace {
+
+        std::atomic<uint64_t> current_trace_id_{ 0 };
+
+        // The log formatter asks for the prefix on every record, so the
+        // formatted string is built once per shot and published behind an
+        // atomically-swapped pointer rather than re-formatted per line.
+        // The same pattern as GolfSimIpcSystem::StoreLastReceivedImage.
+        std::shared_ptr<const std::string> empty_prefix_ = std::make_shared<const std::string>("");
+        std::shared_ptr<const std::string> current_prefix_ = empty_prefix_;
+
+        void PublishTraceId(uint64_t id) {
+
+            current_trace_id_.store(id, std::memory_order_relaxed);
+
+            std::shared_ptr<const std::string> prefix =
+                std::make_shared<const std::string>("shot:" + std::to_string(id) + " ");
+
+            std::atomic_store(&current_prefix_, prefix);
+        }
+    }
+
+
+    void GsShotTrace::BeginShotTrace() {
+
+        // The system clock in microseconds - unique across restarts and
+        // across bays, and chronologically sortable.
+        uint64_t id = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+
+        PublishTraceId(id);
+
+        GS_LOG_TRACE_MSG(trace, "GsShotTrace::BeginShotTrace allocated trace ID " + std::to_string(id) + ".");
+    }
+
+
+    void GsShotTrace::AdoptShotTrace(uint64_t id) {
+
+        if (id == 0 || id == current_trace_id_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        PublishTraceId(id);
+
+        GS_LOG_TRACE_MSG(trace, "GsShotTrace::AdoptShotTrace adopted trace ID " + std::to_string(id) + ".");
+    }
+
+
+    uint64_t GsShotTrace::Current() {
+        return current_trace_id_.load(std::memory_order_relaxed);
+    }
+
+
+    std::string GsShotTrace::LogPrefix() {
+        return *std::atomic_load(&current_prefix_);
+    }
+
+}
@@ -0,0 +1,61 @@
+/*****************************************************************//**
+ * \file   gs_shot_trace.h
+ * \brief  Per-shot trace ID correlating work across both Pis.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace golf_sim {
+
+    // Profiling a shot across the two-Pi configuration means lining up log
+    // lines, FSM trace records and journal entries from two machines whose
+    // only common reference is the shot itself.  This service allocates one
+    // ID per shot at the BallHit event on the camera-1 system; the ID rides
+    // as a property on every outgoing GolfSimIPCMessage (and is adopted from
+    // every incoming one), is prefixed onto every log line from the hit
+    // onward, appears in the FSM shot summary, and is written into the
+    // shot journal record.  Grepping both machines' logs for "shot:<id>"
+    // then yields the complete, correlated story of a single shot.
+    //
+    // The ID is the camera-1 system clock in microseconds at the hit, so it
+    // is unique across restarts and across bays, and sorts chronologically.
+
+    class GsShotTrace {
+
+    public:
+
+        // Allocates and publishes a fresh trace ID for the shot that just
+        // began.  Called on the camera-1 system at the BallHit event.
+        static void BeginShotTrace();
+
+        // Takes on an ID allocated elsewhere.  Called by the IPC receive
+        // path so that the camera-2 system (and any other process on the
+        // bus) tags its work with the originating system's ID.  An id of 0
+        // is ignored - a message without the property never clears the
+        // current trace.
+        static void AdoptShotTrace(uint64_t id);
+
+        // The most recent shot's ID, or 0 if no shot has been traced yet.
+        // The ID deliberately persists until the next shot begins, so that
+        // post-dispatch work (simulator delivery retries, the progressive
+        // spin update) still logs under the shot it belongs to.
+        static uint64_t Current();
+
+        // "shot:<id> " once a shot has been traced, "" before the first
+        // one.  Called by the log formatter for every record, so it must
+        // stay cheap.
+        static std::string LogPrefix();
+    };
+
+}
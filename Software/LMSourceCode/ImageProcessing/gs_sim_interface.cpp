@@ -3,11 +3,19 @@
  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
  */
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "logging_tools.h"
 #include "cv_utils.h"
 #include "gs_options.h"
 #include "gs_config.h"
 
+#include "gs_shot_journal.h"
+#include "gs_session_stats.h"
 #include "gs_sim_interface.h"
 #include "gs_gspro_interface.h"
 #include "gs_e6_interface.h"
@@ -26,6 +34,137 @@ namespace golf_sim {
     // The first shot number the golf simulator receives should be 1, not 0, and
     // the system will increment the counter first before storing information
     long GsSimInterface::shot_counter_ = 0;
+    thread_local long GsSimInterface::pinned_shot_number_ = 0;
+
+    int GsSimInterface::kMaxSendRetries = 2;
+    int GsSimInterface::kSendRetryInitialDelayMs = 250;
+
+    bool GsSimInterface::kRetainArmedStateAcrossShots = false;
+    bool GsSimInterface::kUseProgressiveResultDelivery = false;
+
+    std::atomic<bool> GsSimInterface::all_armed_cache_{ false };
+    // The stamped generation starts out behind the current one so the first
+    // call always walks the interfaces.
+    std::atomic<std::uint64_t> GsSimInterface::armed_cache_generation_{ 1 };
+    std::atomic<std::uint64_t> GsSimInterface::armed_cache_stamped_generation_{ 0 };
+
+    namespace {
+
+        // Shot results come no faster than a golfer can swing, so the bound is
+        // just a backstop against a simulator that is down for a long time
+        const size_t kMaxPendingResults = 8;
+
+        // One delivery worker per attached simulator interface.  Each target
+        // has its own queue, thread and health counters, so a slow or
+        // unreachable simulator delays only its own deliveries - the other
+        // targets (and the FSM) never wait on it.
+        struct InterfaceSender {
+            GsSimInterface* sim_interface = nullptr;
+
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::deque<GsResults> pending;
+            bool exit_requested = false;
+
+            // Held as a pointer so that a process exit without a
+            // DeInitializeSims() call does not run the destructor of a
+            // still-joinable std::thread (which would terminate)
+            std::thread* thread = nullptr;
+
+            // Per-target delivery health, guarded by mutex
+            long shots_delivered = 0;
+            long shots_failed = 0;
+            long send_retries = 0;
+        };
+
+        // Guards the vector itself; each sender's own state rides its mutex
+        std::mutex senders_mutex_;
+        std::vector<InterfaceSender*> interface_senders_;
+
+        // True between a SendBallisticsToGolfSims and the matching
+        // SendResultsToGolfSims, i.e., while some interfaces have already
+        // received this shot's ballistics and are owed a spin update
+        std::atomic<bool> progressive_ballistics_outstanding_{ false };
+
+        // Queues one results record to a delivery worker, applying the
+        // too-many-pending backstop.  Takes the sender's own lock.
+        void QueueResultsToSender(InterfaceSender* sender, const GsResults& results) {
+            {
+                std::lock_guard<std::mutex> lock(sender->mutex);
+
+                if (sender->pending.size() >= kMaxPendingResults) {
+                    GS_LOG_MSG(warning, "GsSimInterface - too many unsent results queued at shot " +
+                        std::to_string(results.shot_number_) + ".  Dropping the oldest.");
+                    sender->pending.pop_front();
+                }
+
+                sender->pending.push_back(results);
+            }
+
+            sender->cv.notify_one();
+        }
+
+        void RunInterfaceSenderThread(InterfaceSender* sender) {
+
+            std::unique_lock<std::mutex> lock(sender->mutex);
+
+            while (true) {
+                if (sender->pending.empty()) {
+                    // Only exit once the queue has drained, so that a shutdown
+                    // flushes any still-pending results
+                    if (sender->exit_requested) {
+                        return;
+                    }
+                    sender->cv.wait(lock);
+                    continue;
+                }
+
+                GsResults results = sender->pending.front();
+                sender->pending.pop_front();
+
+                // Deliver without holding the lock so that queueing the next
+                // shot never waits on this target's socket
+                lock.unlock();
+
+                int retry_delay_ms = GsSimInterface::kSendRetryInitialDelayMs;
+                bool sent = false;
+                int retries_used = 0;
+
+                for (int attempt = 0; attempt <= GsSimInterface::kMaxSendRetries && !sent; attempt++) {
+
+                    if (attempt > 0) {
+                        GS_LOG_MSG(warning, "GsSimInterface sender - send failed for shot " +
+                            std::to_string(results.shot_number_) + ".  Retrying in " + std::to_string(retry_delay_ms) + " ms.");
+                        std::this_thread::sleep_for(std::chrono::milliseconds(retry_delay_ms));
+                        retry_delay_ms *= 2;
+                        retries_used++;
+                    }
+
+                    if (results.result_is_spin_update_) {
+                        sent = sender->sim_interface->SendSpinUpdate(results);
+                    }
+                    else {
+                        sent = sender->sim_interface->SendResults(results);
+                    }
+                }
+
+                if (!sent) {
+                    GS_LOG_MSG(error, "GsSimInterface sender - giving up sending shot " +
+                        std::to_string(results.shot_number_) + " after " + std::to_string(GsSimInterface::kMaxSendRetries + 1) + " attempts.");
+                }
+
+                lock.lock();
+
+                sender->send_retries += retries_used;
+                if (sent) {
+                    sender->shots_delivered++;
+                }
+                else {
+                    sender->shots_failed++;
+                }
+            }
+        }
+    }
 
 
     GsSimInterface::GsSimInterface() {
@@ -39,6 +178,11 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "GsSimInterface::InitializeSims()");
 
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.kMaxSendRetries", kMaxSendRetries);
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.kSendRetryInitialDelayMs", kSendRetryInitialDelayMs);
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.kRetainArmedStateAcrossShots", kRetainArmedStateAcrossShots);
+        GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.kUseProgressiveResultDelivery", kUseProgressiveResultDelivery);
+
         // Create and add an interface to the global vector of interfaces
         // for each configured sim
 
@@ -89,6 +233,9 @@ namespace golf_sim {
 
         sims_initialized_ = true;
 
+        // The set of interfaces just changed, so any cached armed answer is stale
+        InvalidateArmedStateCache();
+
         return true;
     }
 
@@ -120,6 +267,35 @@ namespace golf_sim {
 
         GS_LOG_TRACE_MSG(trace, "GsSimInterface::DeInitializeSims()");
 
+        // Flush and stop the per-target delivery workers before the
+        // interfaces go away.  Each worker drains its own queue first.
+        std::string sender_health = FormatResultsSenderHealth();
+        if (!sender_health.empty()) {
+            GS_LOG_MSG(info, "GsSimInterface::DeInitializeSims() - delivery health: " + sender_health);
+        }
+
+        std::vector<InterfaceSender*> senders_to_stop;
+
+        {
+            std::lock_guard<std::mutex> senders_lock(senders_mutex_);
+            senders_to_stop.swap(interface_senders_);
+        }
+
+        for (auto sender : senders_to_stop) {
+            {
+                std::lock_guard<std::mutex> lock(sender->mutex);
+                sender->exit_requested = true;
+            }
+            sender->cv.notify_one();
+        }
+
+        // Signal all before joining any, so the workers drain in parallel
+        for (auto sender : senders_to_stop) {
+            sender->thread->join();
+            delete sender->thread;
+            delete sender;
+        }
+
 #ifdef __unix__  // Ignore in Windows environment
 
         for (auto interface : interfaces_) {
@@ -131,8 +307,16 @@ namespace golf_sim {
             interface->DeInitialize();
             delete interface;
         }
+
+        interfaces_.clear();
+
+        // All the socket-based interfaces are gone, so their shared event
+        // loop can stop too
+        GsSimSocketInterface::StopSharedEventLoop();
 #endif
         sims_initialized_ = false;
+
+        InvalidateArmedStateCache();
     }
 
 
@@ -144,7 +328,9 @@ namespace golf_sim {
         GS_LOG_TRACE_MSG(trace, "GsSimInterface::SetSimSystemArmed called.");
 
         sim_system_is_armed_ = is_armed;
-    }    
+
+        InvalidateArmedStateCache();
+    }
 
     bool GsSimInterface::GetSimSystemArmed() {
         boost::lock_guard<boost::mutex> lock(sim_arming_mutex_);
@@ -170,32 +356,156 @@ namespace golf_sim {
 
         // Make a local copy of the results so that we can set the shot_counter
         GsResults results = input_results;
-        results.shot_number_ = shot_counter_;
+        results.shot_number_ = GetShotCounter();
 
         if (results.speed_mph_ > 200.0) {
             GS_LOG_MSG(warning, "GsSimInterface::SendResultsToGolfSim got out of bounds speed_mph.  Settting to 200.");
             results.speed_mph_ = 200.0;
         }
 
-        bool status = true;
+        // Journal the shot before queueing it for the sims, so that it
+        // survives a crash even if the send never happens
+        GsShotJournal::Append(results);
+
+        // Fold the shot into the running session aggregates (if configured)
+        GsSessionStats::RecordShot(results);
 
 #ifdef __unix__  // Ignore in Windows environment
 
-        // Loop through any interfaces that we are configured for and send the results
-        for (auto interface : interfaces_) {
-            if (interface == nullptr) {
-                GS_LOG_MSG(error, "GsSimInterface::DeInitializeSims() found a null interface");
-                continue;
+        // Fan the results out to one delivery worker per attached simulator.
+        // Each target queues and retries independently, so the slowest
+        // consumer sets only its own latency - not everyone's.
+        std::lock_guard<std::mutex> senders_lock(senders_mutex_);
+
+        if (interface_senders_.empty()) {
+            for (auto interface : interfaces_) {
+                if (interface == nullptr) {
+                    GS_LOG_MSG(error, "GsSimInterface::SendResultsToGolfSims found a null interface");
+                    continue;
+                }
+
+                InterfaceSender* sender = new InterfaceSender();
+                sender->sim_interface = interface;
+                sender->thread = new std::thread(RunInterfaceSenderThread, sender);
+                interface_senders_.push_back(sender);
+            }
+        }
+
+        // If this shot's ballistics already went out as the first phase of a
+        // progressive delivery, the supporting interfaces only need the spin
+        // update; everyone else still gets the single complete message.
+        const bool ballistics_already_sent =
+            progressive_ballistics_outstanding_.exchange(false, std::memory_order_acq_rel);
+
+        for (auto sender : interface_senders_) {
+            if (ballistics_already_sent && sender->sim_interface->SupportsProgressiveResults()) {
+                GsResults spin_update = results;
+                spin_update.result_is_spin_update_ = true;
+                QueueResultsToSender(sender, spin_update);
+            }
+            else {
+                QueueResultsToSender(sender, results);
             }
+        }
+#endif
 
-            interface->SendResults(results);
+        return true;
+    }
+
+    bool GsSimInterface::SendBallisticsToGolfSims(const GsResults& input_results) {
+
+        if (!kUseProgressiveResultDelivery) {
+            return true;
         }
 
+        GsResults results = input_results;
+        results.shot_number_ = GetShotCounter();
+
+        if (results.speed_mph_ > 200.0) {
+            GS_LOG_MSG(warning, "GsSimInterface::SendBallisticsToGolfSims got out of bounds speed_mph.  Settting to 200.");
+            results.speed_mph_ = 200.0;
+        }
+
+        bool queued_to_any = false;
+
+#ifdef __unix__  // Ignore in Windows environment
+
+        std::lock_guard<std::mutex> senders_lock(senders_mutex_);
+
+        if (interface_senders_.empty()) {
+            for (auto interface : interfaces_) {
+                if (interface == nullptr) {
+                    GS_LOG_MSG(error, "GsSimInterface::SendBallisticsToGolfSims found a null interface");
+                    continue;
+                }
+
+                InterfaceSender* sender = new InterfaceSender();
+                sender->sim_interface = interface;
+                sender->thread = new std::thread(RunInterfaceSenderThread, sender);
+                interface_senders_.push_back(sender);
+            }
+        }
+
+        for (auto sender : interface_senders_) {
+            // Only interfaces whose protocol accepts a later update for the
+            // same shot number can take a spin-less first phase
+            if (!sender->sim_interface->SupportsProgressiveResults()) {
+                continue;
+            }
+
+            QueueResultsToSender(sender, results);
+            queued_to_any = true;
+        }
 #endif
-        return status;
+
+        // Remember that the supporting interfaces are owed a spin update
+        progressive_ballistics_outstanding_.store(queued_to_any, std::memory_order_release);
+
+        return true;
+    }
+
+    bool GsSimInterface::SupportsProgressiveResults() {
+        return false;
+    }
+
+    bool GsSimInterface::SendSpinUpdate(const GsResults& results) {
+        GS_LOG_TRACE_MSG(trace, "GsSimInterface::SendSpinUpdate called for shot " +
+            std::to_string(results.shot_number_) + ".");
+        return true;
+    }
+
+
+    std::string GsSimInterface::FormatResultsSenderHealth() {
+
+        std::string summary;
+
+        std::lock_guard<std::mutex> senders_lock(senders_mutex_);
+
+        for (auto sender : interface_senders_) {
+            std::lock_guard<std::mutex> lock(sender->mutex);
+
+            if (!summary.empty()) {
+                summary += "  ";
+            }
+
+            summary += "Sim type " + std::to_string((int)sender->sim_interface->simulator_type_) +
+                ": " + std::to_string(sender->shots_delivered) + " delivered, " +
+                std::to_string(sender->shots_failed) + " failed, " +
+                std::to_string(sender->send_retries) + " retries, " +
+                std::to_string(sender->pending.size()) + " pending.";
+        }
+
+        return summary;
     }
 
     bool GsSimInterface::GetAllSystemsArmed() {
+
+        const std::uint64_t generation = armed_cache_generation_.load(std::memory_order_acquire);
+
+        if (armed_cache_stamped_generation_.load(std::memory_order_acquire) == generation) {
+            return all_armed_cache_.load(std::memory_order_relaxed);
+        }
+
         bool all_systems_armed = true;
 
         // Loop through any interfaces that we are configured for and send the results
@@ -211,9 +521,19 @@ namespace golf_sim {
             }
         }
 
+        // Stamp the answer with the generation the walk started from.  If an
+        // arming event bumped the generation mid-walk, the stamp is already
+        // behind and the next caller walks again.
+        all_armed_cache_.store(all_systems_armed, std::memory_order_relaxed);
+        armed_cache_stamped_generation_.store(generation, std::memory_order_release);
+
         return all_systems_armed;
     }
 
+    void GsSimInterface::InvalidateArmedStateCache() {
+        armed_cache_generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
 
     GsSimInterface* GsSimInterface::GetSimInterfaceByType(GolfSimulatorType sim_type) {
 
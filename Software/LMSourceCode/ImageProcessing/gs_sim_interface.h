@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 #include <boost/asio.hpp>
 #include <boost/thread/mutex.hpp>
 
@@ -39,9 +42,33 @@ namespace golf_sim {
         // Returns true if at least one golf sim is connected to the system.
         static bool SimIsConnected();
 
-        // To be called from the launch monitor
+        // To be called from the launch monitor.
+        // The results are handed to a background sender thread and this call
+        // returns immediately, so a slow or unreachable simulator PC cannot
+        // stall the FSM's return to ball-watching.  Returns true if the
+        // results were queued.
         static bool SendResultsToGolfSims(const GsResults& results);
 
+        // A failed send to a simulator is retried up to this many times by the
+        // background sender, with the delay doubling from
+        // kSendRetryInitialDelayMs on each attempt
+        static int kMaxSendRetries;
+        static int kSendRetryInitialDelayMs;
+
+        // If true, shot results are delivered in two phases:  the ballistics
+        // (speed and launch angles) go out the moment the kinematics are
+        // final, and the spin follows as an update once the (much slower)
+        // rotation measurement completes.  Only interfaces that report
+        // SupportsProgressiveResults() get the early phase; the rest receive
+        // the single complete message as before.
+        static bool kUseProgressiveResultDelivery;
+
+        // The early phase of a progressive delivery.  Queues the (spin-less)
+        // results to every interface that supports two-phase submission and
+        // returns immediately.  The later SendResultsToGolfSims call turns
+        // into a spin update for those interfaces.
+        static bool SendBallisticsToGolfSims(const GsResults& results);
+
         // If the interface is present (usually indicated in the config.json file),
         // this method returns true;
         static bool InterfaceIsPresent();
@@ -62,6 +89,15 @@ namespace golf_sim {
         // Base class behavior is to simply print out the JSON
         virtual bool SendResults(const GsResults& results);
 
+        // True if this sim's protocol accepts a later update for an
+        // already-submitted shot number, allowing two-phase delivery
+        virtual bool SupportsProgressiveResults();
+
+        // Delivers the spin-bearing second phase for the given shot.  The
+        // base class just logs - only interfaces that report
+        // SupportsProgressiveResults() will ever receive one.
+        virtual bool SendSpinUpdate(const GsResults& results);
+
         // Sends a string without any other side-effects
         // Returns the number of bytes written
         virtual int SendSimMessage(const std::string& message);
@@ -72,14 +108,44 @@ namespace golf_sim {
         virtual bool GetSimSystemArmed();
 
         // These static functions operate at the collection level for all interfaces
-        static long GetShotCounter() { return shot_counter_; };
+        // Returns the shot number pinned to the calling thread (see
+        // PinShotNumberForThread), or the live counter when none is pinned.
+        static long GetShotCounter() { return (pinned_shot_number_ > 0) ? pinned_shot_number_ : shot_counter_; };
+
+        // With overlapped shot processing, a re-teed ball advances the live
+        // counter while the previous shot's analysis is still running on a
+        // pool worker.  Pinning the captured shot number on that worker makes
+        // every shot-numbered artifact it produces (sim results, journal
+        // entry, CSV log lines) carry the number the shot was captured
+        // under.  Pin 0 to unpin when the analysis finishes.
+        static void PinShotNumberForThread(long shot_number) { pinned_shot_number_ = shot_number; };
 
         // Find the GSPro or E6 or whatever interface (if available) by type
         static GsSimInterface *GetSimInterfaceByType(GolfSimulatorType sim_type);
 
-        // Returns true only if each of the available interfaces is armed
+        // Returns true only if each of the available interfaces is armed.
+        // The answer is cached - the FSM polls this on every pass through its
+        // arming states, and walking the interfaces takes each one's arming
+        // mutex.  Any arming event (an arm/disarm message from a sim, a
+        // connection drop, an interface coming or going) invalidates the
+        // cache, so a fresh walk only happens after something changed.
         static bool GetAllSystemsArmed();
 
+        // Throws away the cached GetAllSystemsArmed answer.  Called from every
+        // SetSimSystemArmed and from the interface setup/teardown paths.
+        static void InvalidateArmedStateCache();
+
+        // If true, a successful shot send leaves the interface's armed state
+        // in place instead of forcing a fresh arming exchange, so the FSM
+        // goes straight back to WaitingForBall between consecutive shots.  A
+        // disarm message from the sim or a connection drop still clears it.
+        static bool kRetainArmedStateAcrossShots;
+
+        // A one-line per-target delivery health summary (shots sent, failed,
+        // retries) across the per-interface sender threads.  Empty when no
+        // results have been queued yet.
+        static std::string FormatResultsSenderHealth();
+
     protected:
 
         // Typical derived-class behavior will be to convert the results into a
@@ -100,6 +166,7 @@ namespace golf_sim {
         static bool sims_initialized_;
 
         static long shot_counter_;
+        static thread_local long pinned_shot_number_;
 
         // True if all THIS sim has been initialized
         bool initialized_;
@@ -112,6 +179,16 @@ namespace golf_sim {
         bool sim_system_is_armed_ = false;
 
         boost::mutex sim_arming_mutex_;
+
+        // The cached GetAllSystemsArmed answer.  Every arming event bumps the
+        // generation; a walk of the interfaces stamps its answer with the
+        // generation it started from, and the cache only counts as valid
+        // while the two match.  An event landing mid-walk therefore leaves
+        // the stamped generation behind the current one, and the next caller
+        // walks again - a stale answer can never be published as current.
+        static std::atomic<bool> all_armed_cache_;
+        static std::atomic<std::uint64_t> armed_cache_generation_;
+        static std::atomic<std::uint64_t> armed_cache_stamped_generation_;
     };
 
 }
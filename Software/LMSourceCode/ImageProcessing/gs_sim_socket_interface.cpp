@@ -3,7 +3,10 @@
  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
  */
 
+#include <chrono>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 #ifdef __unix__  // Ignore in Windows environment
 
@@ -28,6 +31,68 @@ using ip::tcp;
 
 namespace golf_sim {
 
+    namespace {
+
+        // One event-loop thread services every socket-based sim interface
+        // (GSPro, E6, ...).  That is cheaper on the Pi's few cores than the
+        // old blocking read thread per interface, and all read completions
+        // and cancellations are handled with the event loop's granularity.
+        std::mutex event_loop_mutex_;
+        boost::asio::io_context* shared_io_context_ = nullptr;
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type>* event_loop_work_ = nullptr;
+        std::thread* event_loop_thread_ = nullptr;
+    }
+
+
+    boost::asio::io_context& GsSimSocketInterface::SharedIoContext() {
+
+        std::lock_guard<std::mutex> lock(event_loop_mutex_);
+
+        if (shared_io_context_ == nullptr) {
+            shared_io_context_ = new boost::asio::io_context();
+
+            // The work guard keeps run() from returning while no reads are armed
+            event_loop_work_ = new boost::asio::executor_work_guard<boost::asio::io_context::executor_type>(
+                boost::asio::make_work_guard(*shared_io_context_));
+
+            event_loop_thread_ = new std::thread([]() { shared_io_context_->run(); });
+        }
+
+        return *shared_io_context_;
+    }
+
+
+    void GsSimSocketInterface::StopSharedEventLoop() {
+
+        std::thread* event_thread = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(event_loop_mutex_);
+
+            if (shared_io_context_ == nullptr) {
+                return;
+            }
+
+            delete event_loop_work_;
+            event_loop_work_ = nullptr;
+
+            shared_io_context_->stop();
+
+            event_thread = event_loop_thread_;
+            event_loop_thread_ = nullptr;
+        }
+
+        if (event_thread != nullptr) {
+            event_thread->join();
+            delete event_thread;
+        }
+
+        std::lock_guard<std::mutex> lock(event_loop_mutex_);
+        delete shared_io_context_;
+        shared_io_context_ = nullptr;
+    }
+
+
     GsSimSocketInterface::GsSimSocketInterface() {
     }
 
@@ -52,20 +117,15 @@ namespace golf_sim {
 
         try
         {
-            io_context_ = new boost::asio::io_context();
-
-            if (io_context_ == nullptr) {
-                GS_LOG_MSG(error, "GsSimSocketInterface could not create a new io_context.");
-                return false;
-            }
+            boost::asio::io_context& io_context = SharedIoContext();
 
-            tcp::resolver resolver(*io_context_);
+            tcp::resolver resolver(io_context);
             GS_LOG_TRACE_MSG(trace, "Connecting to SimSocketServer at address: " + socket_connect_address_ + ":" + socket_connect_port_);
             tcp::resolver::results_type endpoints = resolver.resolve(socket_connect_address_, socket_connect_port_);
 
             // Create the socket if we haven't done so already
             if (socket_ == nullptr) {
-                socket_ = new tcp::socket(*io_context_);
+                socket_ = new tcp::socket(io_context);
 
                 if (socket_ == nullptr) {
                     GS_LOG_MSG(error, "GsSimSocketInterface could not create a new socket.");
@@ -76,11 +136,8 @@ namespace golf_sim {
 
             boost::asio::connect(*socket_, endpoints);
 
-            receiver_thread_ = std::unique_ptr<std::thread>(new std::thread(&GsSimSocketInterface::ReceiveSocketData, this));
-
-            // GS_LOG_TRACE_MSG(trace, "Thread was created.  Thread id: " + std::string(receiver_thread_.get()->get_id()) );
-
-            // socket_->set_option(boost::asio::detail::socket_option::integer<SOL_SOCKET, SO_RCVTIMEO>{ 10 });
+            // Reads are serviced by the shared event loop - no thread per interface
+            StartAsyncReceive();
         }
         catch (std::exception& e)
         {
@@ -88,11 +145,6 @@ namespace golf_sim {
             return false;
         }
 
-#ifdef __unix__  // Ignore in Windows environment
-        // Give the new thread a moment to get running
-        usleep(500);
-#endif
-
         initialized_ = true;
 
         // Derived classes will need to deal with any initial messaging after the socket is established.
@@ -100,68 +152,60 @@ namespace golf_sim {
         return true;
     }
 
-    void GsSimSocketInterface::ReceiveSocketData() {
+    void GsSimSocketInterface::StartAsyncReceive() {
 
         receive_thread_exited_ = false;
+        receive_pending_ = true;
 
-        static std::array<char, 2000> buf;
-        boost::system::error_code error;
-        std::string received_data_string;
+        socket_->async_read_some(boost::asio::buffer(receive_buffer_),
+            [this](const boost::system::error_code& error, std::size_t len) {
+                HandleReceive(error, len);
+            });
+    }
 
-        while (GolfSimGlobals::golf_sim_running_)
-        {
-            // We don't want to re-enter this while we're processing
-            // a received message
-            // boost::lock_guard<boost::mutex> lock(sim_socket_receive_mutex_);
 
-            GS_LOG_TRACE_MSG(trace, "Waiting to receive data from SimSocketserver.");
+    void GsSimSocketInterface::HandleReceive(const boost::system::error_code& error, std::size_t len) {
 
-            size_t len = 0;
+        if (error == boost::asio::error::operation_aborted || !GolfSimGlobals::golf_sim_running_) {
+            // The read was cancelled (usually by DeInitialize closing the socket)
+            receive_pending_ = false;
+            return;
+        }
 
-            try {
-                // Read_some should be blocking, but if the socket has closed, it will return immediately
-                len = socket_->read_some(boost::asio::buffer(buf), error);
-            }
-            catch (std::exception& e)
-            {
-                GS_LOG_MSG(error, "GsSimSocketInterface::ReceiveSocketData failed to read from socket - Error was: " + std::string(e.what()));
-            }
+        if (error == boost::asio::error::eof || len == 0) {
+            // Connection closed by the peer.  The next send will notice and
+            // attempt to re-initialize.
+            GS_LOG_MSG(warning, "Received 0-length message from server. Will attempt to re-initialize");
+            receive_thread_exited_ = true;
+            receive_pending_ = false;
+            // A dropped connection disarms the sim - whatever armed state was
+            // cached must not carry a shot into a dead socket.
+            SetSimSystemArmed(false);
+            return;
+        }
 
-            if (len == 0) {
-                GS_LOG_MSG(warning, "Received 0-length message from server. Will attempt to re-initialize");
-                /// TBD - Are we sure we want to exit?
-                receive_thread_exited_ = true;
-                return; 
-            }
+        if (error) {
+            GS_LOG_MSG(error, "GsSimSocketInterface::HandleReceive failed to read from socket - Error was: " + error.message());
+            receive_thread_exited_ = true;
+            receive_pending_ = false;
+            SetSimSystemArmed(false);
+            return;
+        }
 
-            // Null-terminate the string
-            buf[len] = (char)0;
-            received_data_string = std::string(buf.data());
-            GS_LOG_TRACE_MSG(trace, "   Read some data (" + std::to_string(len) + " bytes) : " + received_data_string);
+        std::string received_data_string(receive_buffer_.data(), len);
+        GS_LOG_TRACE_MSG(trace, "   Read some data (" + std::to_string(len) + " bytes) : " + received_data_string);
 
-            if (error == boost::asio::error::eof) {
-                // Connection closed cleanly by peer.  
-                // In this case, we may want to de-initialize
-                GS_LOG_TRACE_MSG(trace, "GsSimSocketInterface::ReceiveSocketData Received EOF");
-                receive_thread_exited_ = true;
-                return;
-            }
-            else if (error) {
-                GS_LOG_TRACE_MSG(trace, "GsSimSocketInterface::ReceiveSocketData Received Error");
-                throw boost::system::system_error(error); // Some other error.
-            }
-            // Derived classes will, for example, parse the message and inject any
-            // relevant events into the FSM.
+        // Derived classes will, for example, parse the message and inject any
+        // relevant events into the FSM.
 
-            GS_LOG_TRACE_MSG(trace, "Received SimSocket message of: \n" + received_data_string);
+        GS_LOG_TRACE_MSG(trace, "Received SimSocket message of: \n" + received_data_string);
 
-            if (!ProcessReceivedData(received_data_string)) {
-                GS_LOG_MSG(error, "Failed GsSimSocketInterface::ReceiveSocketData - Could process data: " + received_data_string);
-                return;
-            }
+        if (!ProcessReceivedData(received_data_string)) {
+            GS_LOG_MSG(error, "Failed GsSimSocketInterface::HandleReceive - Could process data: " + received_data_string);
         }
 
-        GS_LOG_MSG(error, "GsSimSocketInterface::ReceiveSocketData Exiting");
+        // Arm the next read
+        StartAsyncReceive();
     }
 
     void GsSimSocketInterface::DeInitialize() {
@@ -169,26 +213,21 @@ namespace golf_sim {
         GS_LOG_TRACE_MSG(trace, "GsSimSocketInterface::DeInitialize() called.");
         try {
 
-            if (receiver_thread_ != nullptr) {
-                /***  TBD - Was locking up
-                GS_LOG_TRACE_MSG(trace, "Waiting for join of receiver_thread_.");
-                receiver_thread_->join();
-                receiver_thread_.release();
-                delete receiver_thread_.get();
-                */
-                GS_LOG_TRACE_MSG(trace, "GsSimSocketInterface::DeInitialize() killing receive thread.");
+            if (socket_ != nullptr) {
+                // Closing the socket cancels any read armed on the event loop
+                boost::system::error_code ignored;
+                socket_->close(ignored);
+            }
 
-#ifdef __unix__  // Ignore in Windows environment
-                pthread_cancel(receiver_thread_.get()->native_handle());
-#endif
-                receiver_thread_ = nullptr;
+            // Wait (briefly) for the event loop to run the cancelled read's
+            // completion handler so that it cannot touch this object after
+            // the socket is deleted
+            for (int i = 0; receive_pending_ && i < 100; i++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
             }
 
-            // TBD - not sure how to deinitialize the TCP socket stuff
             delete socket_;
             socket_ = nullptr;
-            delete io_context_;
-            io_context_ = nullptr;
 
             GS_LOG_TRACE_MSG(trace, "GsSimSocketInterface::DeInitialize() completed.");
         }
@@ -242,16 +281,14 @@ namespace golf_sim {
             }
         }
 
-        GS_LOG_TRACE_MSG(trace, "Sending GsSimSocketInterface::SendResult results input message:\n" + results.Format());
-
         size_t write_length = -1;
 
         try {
-            static std::array<char, 2000> buf;
-            boost::system::error_code error;
-
+            // Serialize once and reuse the bytes for both the log and the send
             std::string results_msg = GenerateResultsDataToSend(results);
 
+            GS_LOG_TRACE_MSG(trace, "Sending GsSimSocketInterface::SendResult results input message:\n" + results_msg);
+
             write_length = SendSimMessage(results_msg);
         }
         catch (std::exception& e)
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+
 #include <boost/asio.hpp>
 #include <boost/thread.hpp>
 
@@ -35,7 +38,13 @@ namespace golf_sim {
 
         virtual bool SendResults(const GsResults& results);
 
-        virtual void ReceiveSocketData();
+        // Arms the next asynchronous read on the shared event loop
+        virtual void StartAsyncReceive();
+
+        // Stops the event-loop thread that services all of the socket-based
+        // sim interfaces.  To be called once, after every interface has been
+        // de-initialized.
+        static void StopSharedEventLoop();
 
     public:
 
@@ -45,21 +54,32 @@ namespace golf_sim {
     protected:
 
         virtual std::string GenerateResultsDataToSend(const GsResults& results);
-        
+
         virtual bool ProcessReceivedData(const std::string received_data);
 
-        // Default behavior here is just to send the message to the socket and 
+        // Default behavior here is just to send the message to the socket and
         // return the number of bytes written
         virtual int SendSimMessage(const std::string& message);
 
+        // Lazily creates the io_context (and its single service thread) that
+        // is shared by every socket-based sim interface
+        static boost::asio::io_context& SharedIoContext();
+
+        // Completion handler for one asynchronous read
+        void HandleReceive(const boost::system::error_code& error, std::size_t len);
+
     protected:
 
         tcp::socket* socket_ = nullptr;
-        boost::asio::io_context* io_context_ = nullptr;
 
-        std::unique_ptr<std::thread> receiver_thread_ = nullptr;
+        std::array<char, 2000> receive_buffer_;
+
+        // True while a read is armed on the event loop.  DeInitialize waits
+        // for it to clear so that a cancelled read cannot touch a dead object.
+        std::atomic<bool> receive_pending_{ false };
 
-        // TBD - Is this thread safe?
+        // True once the connection has been lost.  Derived classes check this
+        // before a send and re-initialize the connection if needed.
         bool receive_thread_exited_ = false;
 
         boost::mutex sim_socket_receive_mutex_;
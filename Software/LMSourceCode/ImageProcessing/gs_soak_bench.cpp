@@ -0,0 +1,371 @@
+/*****************************************************************//**
+ * \file   gs_soak_bench.cpp
+ * \brief  Long-run soak test for latency and memory drift.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+ /* SPDX-License-Identifier: GPL-2.0-only */
+ /*
+  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+  */
+
+// Builds as the (optional) pitrac_soak_bench executable.  Where
+// pitrac_e2e_bench answers "how fast is one shot today", this harness answers
+// "does the ten-thousandth shot still look like the tenth".  It replays the
+// same recorded-shot corpus through GolfSimCamera::ProcessReceivedCam2Image
+// continuously for the requested number of shots (hours, at corpus rates),
+// sampling per-shot analysis latency, resident-set size and allocator
+// statistics as it goes.  The slow leaks and heap fragmentation that only
+// show up in the longest customer sessions - and that we currently find by
+// crashing - show up here as drift between the run's early and late windows,
+// and the harness exits nonzero when the drift exceeds the configured
+// thresholds so it can gate a nightly run.
+//
+// The corpus images are decoded once up front and replayed from memory, so
+// the loop exercises the analysis path (and its allocation behavior), not
+// the filesystem.
+//
+// Usage:
+//      pitrac_soak_bench <shot_corpus_file> <output_csv_file> [total_shots]
+//                        [max_latency_drift_pct] [max_rss_growth_mb] [config_file]
+//
+// The corpus file is the same format pitrac_e2e_bench reads: one shot per
+// line ("<teed_ball_image> <strobed_image>", '#' comments allowed), with
+// file names relative to the usual base image directory from the .json
+// configuration file.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "gs_config.h"
+#include "gs_options.h"
+#include "gs_globals.h"
+#include "logging_tools.h"
+#include "ball_image_proc.h"
+#include "gs_camera.h"
+#include "gs_automated_testing.h"
+#include "gs_mat_pool_allocator.h"
+#include "pulse_strobe.h"
+
+
+using namespace golf_sim;
+
+
+// Shots between samples of RSS/allocator state.  Frequent enough to see a
+// trend within an hour-long run, infrequent enough that the sampling itself
+// is not part of the workload.
+static const long kSampleIntervalShots = 50;
+
+// The first shots of the run warm caches, the Mat pool and the allocator's
+// arenas - drift is measured from after the warm-up, not from a cold start.
+static const long kWarmupShots = 100;
+
+// The early and late latency baselines are each the mean over this many
+// shots (the first ones after warm-up and the last ones of the run).
+static const long kDriftWindowShots = 200;
+
+
+struct SoakBenchShot {
+    std::string teed_ball_image_filename;
+
+    // Decoded once at startup; the soak loop replays from memory
+    cv::Mat teed_ball_ImgColor;
+    cv::Mat strobed_balls_ImgColor;
+};
+
+
+static bool ReadCorpusFile(const std::string& corpus_filename, std::vector<SoakBenchShot>& shots) {
+
+    std::ifstream file(corpus_filename);
+
+    if (!file.is_open()) {
+        std::cerr << "Could not open corpus file: " << corpus_filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        // Strip comments and skip blank lines
+        size_t comment_pos = line.find('#');
+        if (comment_pos != std::string::npos) {
+            line = line.substr(0, comment_pos);
+        }
+
+        std::istringstream line_stream(line);
+        std::string teed_ball_image_filename;
+        std::string strobed_image_filename;
+
+        if (!(line_stream >> teed_ball_image_filename >> strobed_image_filename)) {
+            continue;
+        }
+
+        cv::Mat teed_ball_ImgGray;
+        cv::Mat strobed_balls_ImgGray;
+
+        SoakBenchShot shot;
+        shot.teed_ball_image_filename = teed_ball_image_filename;
+
+        if (!GsAutomatedTesting::ReadTestImages(teed_ball_image_filename, strobed_image_filename,
+            teed_ball_ImgGray, strobed_balls_ImgGray, shot.teed_ball_ImgColor, shot.strobed_balls_ImgColor,
+            CameraHardware::PiGS, false /* No undistort */)) {
+            std::cerr << "Could not read images for shot: " << teed_ball_image_filename
+                << " / " << strobed_image_filename << std::endl;
+            return false;
+        }
+
+        shots.push_back(shot);
+    }
+
+    return !shots.empty();
+}
+
+
+// The process's resident-set size in kB, read the same way top does.
+// Returns 0 if /proc is not available.
+static long ReadVmRssKb() {
+
+    std::ifstream status_file("/proc/self/status");
+    std::string line;
+
+    while (std::getline(status_file, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            std::istringstream line_stream(line.substr(6));
+            long rss_kb = 0;
+            line_stream >> rss_kb;
+            return rss_kb;
+        }
+    }
+
+    return 0;
+}
+
+
+// Bytes the allocator is holding in-use and free-but-retained.  The
+// difference between in-use and RSS growth is fragmentation - memory the
+// process can neither use nor return.
+static void ReadAllocatorStats(long long& in_use_bytes, long long& free_bytes) {
+
+#ifdef __GLIBC__
+    struct mallinfo2 info = mallinfo2();
+    in_use_bytes = (long long)info.uordblks;
+    free_bytes = (long long)info.fordblks;
+#else
+    in_use_bytes = 0;
+    free_bytes = 0;
+#endif
+}
+
+
+static double MeanOf(const std::vector<double>& values, size_t first, size_t count) {
+
+    double sum = 0.;
+    for (size_t i = first; i < first + count; i++) {
+        sum += values[i];
+    }
+    return sum / (double)count;
+}
+
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 3) {
+            std::cerr << "Usage: pitrac_soak_bench <shot_corpus_file> <output_csv_file> [total_shots]"
+                << " [max_latency_drift_pct] [max_rss_growth_mb] [config_file]" << std::endl;
+            return 1;
+        }
+
+        std::string corpus_filename = argv[1];
+        std::string output_csv_filename = argv[2];
+        long total_shots = (argc > 3) ? std::stol(argv[3]) : 10000;
+        double max_latency_drift_pct = (argc > 4) ? std::stod(argv[4]) : 10.0;
+        double max_rss_growth_mb = (argc > 5) ? std::stod(argv[5]) : 64.0;
+        std::string config_file_name = (argc > 6) ? argv[6] : "golf_sim_config.json";
+
+        if (total_shots < kWarmupShots + 2 * kDriftWindowShots) {
+            std::cerr << "total_shots must be at least " << (kWarmupShots + 2 * kDriftWindowShots)
+                << " for the drift windows to be meaningful." << std::endl;
+            return 1;
+        }
+
+        LoggingTools::InitLogging();
+
+        if (!GolfSimConfiguration::Initialize(config_file_name)) {
+            std::cerr << "Could not initialize configuration module using config file: " << config_file_name << std::endl;
+            return 1;
+        }
+
+        GolfSimGlobals::golf_sim_running_ = true;
+
+        BallImageProc::LoadConfigurationValues();
+
+        // The pulse intervals must be set up so that the analysis can determine
+        // pulse-ratios for distance and time measurements
+        if (!PulseStrobe::InitGPIOSystem(nullptr /* Signal handler not needed here */)) {
+            std::cerr << "Failed to InitGPIOSystem." << std::endl;
+            return 1;
+        }
+
+        std::vector<SoakBenchShot> shots;
+        if (!ReadCorpusFile(corpus_filename, shots)) {
+            std::cerr << "No usable shots found in corpus file: " << corpus_filename << std::endl;
+            return 1;
+        }
+
+        std::ofstream csv_file(output_csv_filename, std::ios::trunc);
+        if (!csv_file) {
+            std::cerr << "Could not open output CSV file: " << output_csv_filename << std::endl;
+            return 1;
+        }
+
+        csv_file << "shot,elapsed_s,window_mean_ms,window_max_ms,vm_rss_kb,alloc_in_use_bytes,alloc_free_bytes" << std::endl;
+
+        std::cout << "pitrac_soak_bench - " << shots.size() << " corpus shot(s), "
+            << total_shots << " replay(s), thresholds: latency drift "
+            << max_latency_drift_pct << "%, RSS growth " << max_rss_growth_mb << " MB." << std::endl;
+
+        // Per-shot analysis latencies for the whole run; reserved up front so
+        // the bookkeeping itself never grows mid-run.
+        std::vector<double> latencies_ms;
+        latencies_ms.reserve((size_t)total_shots);
+
+        const auto run_start = std::chrono::steady_clock::now();
+
+        long baseline_rss_kb = 0;
+        double window_max_ms = 0.;
+        double window_sum_ms = 0.;
+        long window_count = 0;
+        long num_failed_shots = 0;
+
+        for (long shot_number = 0; shot_number < total_shots; shot_number++) {
+
+            const SoakBenchShot& shot = shots[(size_t)(shot_number % (long)shots.size())];
+
+            GolfBall result_ball;
+            cv::Vec3d rotation_results;
+            cv::Mat exposures_image;
+            cv::Mat dummy_pre_image;
+            std::vector<GolfBall> exposure_balls;
+
+            const auto analysis_start = std::chrono::steady_clock::now();
+
+            bool success = GolfSimCamera::ProcessReceivedCam2Image(shot.teed_ball_ImgColor,
+                                                                   shot.strobed_balls_ImgColor,
+                                                                   dummy_pre_image,
+                                                                   result_ball,
+                                                                   rotation_results,
+                                                                   exposures_image,
+                                                                   exposure_balls);
+
+            double analysis_ms = std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+                std::chrono::steady_clock::now() - analysis_start).count();
+
+            if (!success) {
+                num_failed_shots++;
+
+                if (shot_number < (long)shots.size()) {
+                    // A shot that fails on its very first replay will fail on
+                    // every later one too - a broken corpus, not drift
+                    std::cerr << "Shot could not be replayed: " << shot.teed_ball_image_filename << std::endl;
+                    return 1;
+                }
+            }
+
+            latencies_ms.push_back(analysis_ms);
+
+            window_sum_ms += analysis_ms;
+            window_max_ms = std::max(window_max_ms, analysis_ms);
+            window_count++;
+
+            if (shot_number == kWarmupShots) {
+                // Everything before this point was warming caches and arenas
+                baseline_rss_kb = ReadVmRssKb();
+            }
+
+            if (window_count == kSampleIntervalShots || shot_number == total_shots - 1) {
+
+                double elapsed_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                    std::chrono::steady_clock::now() - run_start).count();
+
+                long long alloc_in_use_bytes = 0;
+                long long alloc_free_bytes = 0;
+                ReadAllocatorStats(alloc_in_use_bytes, alloc_free_bytes);
+
+                long vm_rss_kb = ReadVmRssKb();
+
+                csv_file << shot_number << ","
+                    << std::fixed << std::setprecision(1) << elapsed_s << ","
+                    << std::setprecision(3) << (window_sum_ms / (double)window_count) << ","
+                    << window_max_ms << ","
+                    << vm_rss_kb << ","
+                    << alloc_in_use_bytes << ","
+                    << alloc_free_bytes << std::endl;
+
+                std::cout << "=== SOAK shot=" << shot_number
+                    << "  window_mean=" << std::fixed << std::setprecision(3)
+                    << (window_sum_ms / (double)window_count) << "ms"
+                    << "  rss=" << vm_rss_kb << "kB ===" << std::endl;
+
+                // The pool logs its hit/miss/outstanding counts, so pool
+                // growth is visible in the same log as the samples
+                GsMatPoolAllocator::LogStatistics();
+
+                window_sum_ms = 0.;
+                window_max_ms = 0.;
+                window_count = 0;
+            }
+        }
+
+        // The verdict: compare the run's early and late windows
+        double early_mean_ms = MeanOf(latencies_ms, (size_t)kWarmupShots, (size_t)kDriftWindowShots);
+        double late_mean_ms = MeanOf(latencies_ms, latencies_ms.size() - (size_t)kDriftWindowShots,
+                                     (size_t)kDriftWindowShots);
+
+        double latency_drift_pct = 100.0 * (late_mean_ms - early_mean_ms) / early_mean_ms;
+
+        long final_rss_kb = ReadVmRssKb();
+        double rss_growth_mb = (double)(final_rss_kb - baseline_rss_kb) / 1024.0;
+
+        std::cout << "pitrac_soak_bench - " << total_shots << " shots (" << num_failed_shots << " failed)." << std::endl;
+        std::cout << "  Latency: early window " << std::fixed << std::setprecision(3) << early_mean_ms
+            << " ms, late window " << late_mean_ms << " ms, drift "
+            << std::setprecision(1) << latency_drift_pct << "% (threshold "
+            << max_latency_drift_pct << "%)." << std::endl;
+        std::cout << "  RSS: post-warmup " << baseline_rss_kb << " kB, final " << final_rss_kb
+            << " kB, growth " << std::setprecision(1) << rss_growth_mb << " MB (threshold "
+            << max_rss_growth_mb << " MB)." << std::endl;
+        std::cout << "pitrac_soak_bench - wrote " << output_csv_filename << std::endl;
+
+        bool failed = false;
+
+        if (latency_drift_pct > max_latency_drift_pct) {
+            std::cerr << "FAILED - per-shot latency drifted " << std::fixed << std::setprecision(1)
+                << latency_drift_pct << "% over the run (threshold " << max_latency_drift_pct << "%)." << std::endl;
+            failed = true;
+        }
+
+        if (rss_growth_mb > max_rss_growth_mb) {
+            std::cerr << "FAILED - RSS grew " << std::fixed << std::setprecision(1)
+                << rss_growth_mb << " MB after warm-up (threshold " << max_rss_growth_mb << " MB)." << std::endl;
+            failed = true;
+        }
+
+        return failed ? 1 : 0;
+    }
+    catch (std::exception const& e) {
+        std::cerr << "pitrac_soak_bench ERROR: " << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,245 @@
+/*****************************************************************//**
+ * \file   gs_spin_bench.cpp
+ * \brief  Micro-benchmark driver for the ball spin analysis.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+ /* SPDX-License-Identifier: GPL-2.0-only */
+ /*
+  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+  */
+
+// Builds as the (optional) pitrac_spin_bench executable.  The benchmark loads a
+// corpus of recorded ball image pairs (the same kind of images used by
+// gs_automated_testing.cpp), runs BallImageProc::GetBallRotation over each pair a
+// configurable number of times, and reports wall-clock percentiles.  The spin
+// pipeline's own phase timers (projection, candidate generation, comparison) print
+// to stdout as each iteration runs, bracketed by the per-iteration markers below,
+// so per-phase regressions can be attributed from the same log.
+//
+// Usage:
+//      pitrac_spin_bench <image_pair_corpus_file> [iterations_per_pair] [config_file]
+//
+// The corpus file holds one image pair per line ("<base_image> <rotated_image>",
+// '#' comments allowed), with file names relative to the usual base image directory
+// from the .json configuration file.
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/timer/timer.hpp>
+
+#include "gs_config.h"
+#include "gs_options.h"
+#include "gs_globals.h"
+#include "logging_tools.h"
+#include "ball_image_proc.h"
+#include "gs_camera.h"
+#include "gs_automated_testing.h"
+
+
+using namespace golf_sim;
+
+std::string kBaseTestDir = "Will be set from the .json configuration file";
+
+
+struct SpinBenchPair {
+    std::string base_image_filename;
+    std::string rotated_image_filename;
+};
+
+
+static bool ReadCorpusFile(const std::string& corpus_filename, std::vector<SpinBenchPair>& pairs) {
+
+    std::ifstream file(corpus_filename);
+
+    if (!file.is_open()) {
+        std::cerr << "Could not open corpus file: " << corpus_filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        // Strip comments and skip blank lines
+        size_t comment_pos = line.find('#');
+        if (comment_pos != std::string::npos) {
+            line = line.substr(0, comment_pos);
+        }
+
+        std::istringstream line_stream(line);
+        SpinBenchPair pair;
+        if (line_stream >> pair.base_image_filename >> pair.rotated_image_filename) {
+            pairs.push_back(pair);
+        }
+    }
+
+    return !pairs.empty();
+}
+
+
+// Returns the p-th percentile (0-100) of the sample set using nearest-rank
+static double Percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    size_t rank = (size_t)std::ceil((p / 100.0) * (double)samples.size());
+    if (rank > 0) {
+        rank--;
+    }
+    return samples[rank];
+}
+
+
+static void ReportPercentiles(const std::string& label, const std::vector<double>& samples) {
+    std::cout << std::fixed << std::setprecision(4)
+        << label << ": n=" << samples.size()
+        << "  min=" << Percentile(samples, 0) << "s"
+        << "  p50=" << Percentile(samples, 50) << "s"
+        << "  p90=" << Percentile(samples, 90) << "s"
+        << "  p99=" << Percentile(samples, 99) << "s"
+        << "  max=" << Percentile(samples, 100) << "s" << std::endl;
+}
+
+
+// Runs the spin analysis for one image pair.  The ball identification /
+// calibration is performed once (it is not what is being measured here), and then
+// GetBallRotation is timed num_iterations times on the same inputs.
+static bool BenchmarkOnePair(const SpinBenchPair& pair, int num_iterations, std::vector<double>& all_samples) {
+
+    cv::Mat ball1ImgGray;
+    cv::Mat ball2ImgGray;
+    cv::Mat ball1ImgColor;
+    cv::Mat ball2ImgColor;
+
+    CameraHardware::CameraModel camera_model = GolfSimCamera::kSystemSlot1CameraType;
+    CameraHardware::LensType lens_type = GolfSimCamera::kSystemSlot1LensType;
+
+    if (!GsAutomatedTesting::ReadTestImages(pair.base_image_filename, pair.rotated_image_filename, ball1ImgGray, ball2ImgGray, ball1ImgColor, ball2ImgColor, camera_model, false /*No Undistort*/)) {
+        std::cerr << "Could not read image pair: " << pair.base_image_filename << " / " << pair.rotated_image_filename << std::endl;
+        return false;
+    }
+
+    GolfSimCamera c;
+    c.camera_hardware_.init_camera_parameters(GsCameraNumber::kGsCamera1, camera_model, lens_type);
+
+    GolfBall ball1, ball2;
+
+    c.camera_hardware_.firstCannedImageFileName = kBaseTestDir + pair.base_image_filename;
+    c.camera_hardware_.firstCannedImage = ball1ImgColor;
+
+    cv::Vec2i expectedBallCenter = cv::Vec2i(1456 / 3, 1088 / 2);
+
+    if (!c.GetCalibratedBall(c, ball1ImgColor, ball1, expectedBallCenter)) {
+        std::cerr << "Could not GetCalibratedBall for: " << pair.base_image_filename << std::endl;
+        return false;
+    }
+
+    c.camera_hardware_.secondCannedImageFileName = kBaseTestDir + pair.rotated_image_filename;
+    c.camera_hardware_.secondCannedImage = ball2ImgColor;
+
+    if (!c.GetCurrentBallLocation(c, ball2ImgColor, ball1, ball2)) {
+        std::cerr << "Could not find 2nd ball in: " << pair.rotated_image_filename << std::endl;
+        return false;
+    }
+
+    std::vector<double> pair_samples;
+
+    for (int i = 0; i < num_iterations; i++) {
+
+        std::cout << "=== SPIN_BENCH pair=" << pair.base_image_filename << " iteration=" << i << " begin ===" << std::endl;
+
+        boost::timer::cpu_timer timer1;
+
+        cv::Vec3d rotationResults = BallImageProc::GetBallRotation(ball1ImgGray, ball1, ball2ImgGray, ball2);
+
+        timer1.stop();
+        boost::timer::cpu_times times = timer1.elapsed();
+        double wall_seconds = times.wall / 1.0e9;
+
+        std::cout << "=== SPIN_BENCH pair=" << pair.base_image_filename << " iteration=" << i
+            << " end  wall=" << std::fixed << std::setprecision(8) << wall_seconds << "s"
+            << "  rotation=(" << rotationResults[0] << ", " << rotationResults[1] << ", " << rotationResults[2] << ") ===" << std::endl;
+
+        pair_samples.push_back(wall_seconds);
+        all_samples.push_back(wall_seconds);
+    }
+
+    ReportPercentiles("GetBallRotation [" + pair.base_image_filename + "]", pair_samples);
+
+    return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: pitrac_spin_bench <image_pair_corpus_file> [iterations_per_pair] [config_file]" << std::endl;
+            return 1;
+        }
+
+        std::string corpus_filename = argv[1];
+        int num_iterations = (argc > 2) ? std::stoi(argv[2]) : 5;
+        std::string config_file_name = (argc > 3) ? argv[3] : "golf_sim_config.json";
+
+        LoggingTools::InitLogging();
+
+        if (!GolfSimConfiguration::Initialize(config_file_name)) {
+            std::cerr << "Could not initialize configuration module using config file: " << config_file_name << std::endl;
+            return 1;
+        }
+
+#ifdef __unix__
+        GolfSimConfiguration::SetConstant("gs_config.logging.kLinuxBaseImageLoggingDir", kBaseTestDir);
+#else
+        GolfSimConfiguration::SetConstant("gs_config.logging.kPCBaseImageLoggingDir", kBaseTestDir);
+#endif
+        if (!kBaseTestDir.empty() && kBaseTestDir.back() != '/') {
+            kBaseTestDir += '/';
+        }
+
+        GolfSimGlobals::golf_sim_running_ = true;
+
+        BallImageProc::LoadConfigurationValues();
+
+        std::vector<SpinBenchPair> pairs;
+        if (!ReadCorpusFile(corpus_filename, pairs)) {
+            std::cerr << "No usable image pairs found in corpus file: " << corpus_filename << std::endl;
+            return 1;
+        }
+
+        std::cout << "pitrac_spin_bench - " << pairs.size() << " image pair(s), " << num_iterations << " iteration(s) per pair." << std::endl;
+
+        std::vector<double> all_samples;
+        int num_failed_pairs = 0;
+
+        for (const auto& pair : pairs) {
+            if (!BenchmarkOnePair(pair, num_iterations, all_samples)) {
+                num_failed_pairs++;
+            }
+        }
+
+        if (!all_samples.empty()) {
+            ReportPercentiles("GetBallRotation [ALL PAIRS]", all_samples);
+        }
+
+        if (num_failed_pairs > 0) {
+            std::cerr << num_failed_pairs << " image pair(s) could not be benchmarked." << std::endl;
+            return 1;
+        }
+
+        return 0;
+    }
+    catch (std::exception const& e) {
+        std::cerr << "pitrac_spin_bench ERROR: " << e.what() << std::endl;
+        return -1;
+    }
+}
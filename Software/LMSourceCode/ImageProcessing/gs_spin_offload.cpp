@@ -0,0 +1,280 @@
+/*****************************************************************//**
+ * \file   gs_spin_offload.cpp
+ * \brief  Offloads the spin-rotation search to the camera-2 Pi.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
+
+#include "gs_spin_offload.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+#include "gs_options.h"
+#include "ball_image_proc.h"
+
+#ifdef __unix__
+#include "gs_ipc_message.h"
+#include "gs_ipc_system.h"
+#endif
+
+namespace golf_sim {
+
+    bool GsSpinOffload::kEnableSpinOffload = false;
+    int GsSpinOffload::kSpinOffloadTimeoutMs = 1500;
+
+    namespace {
+
+        // Camera-1 side state: at most one offload is in flight at a time
+        // (the FSM analyzes one shot at a time), so a single response slot
+        // under one mutex is enough.
+        std::mutex offload_mutex;
+        std::condition_variable offload_cv;
+        bool response_pending = false;
+        bool response_received = false;
+        bool response_succeeded = false;
+        cv::Vec3d response_rotation;
+
+        long offloads_succeeded = 0;
+        long offloads_timed_out = 0;
+
+        // The geometry GetBallRotation reads from each ball, packed as a
+        // space-separated string: the crop-relative center and radius, the
+        // measured radius, and the camera-perspective angle offsets used for
+        // the de-rotation step.
+        std::string PackBallData(const GolfBall& ball) {
+            std::ostringstream s;
+            s << ball.ball_circle_[0] << " " << ball.ball_circle_[1] << " " << ball.ball_circle_[2] << " "
+              << ball.measured_radius_pixels_ << " "
+              << ball.angles_camera_ortho_perspective_[0] << " " << ball.angles_camera_ortho_perspective_[1];
+            return s.str();
+        }
+
+        bool UnpackBallData(const std::string& data, GolfBall& ball) {
+            std::istringstream s(data);
+
+            float x = 0.0F;
+            float y = 0.0F;
+            float radius = 0.0F;
+
+            s >> x >> y >> radius >> ball.measured_radius_pixels_
+              >> ball.angles_camera_ortho_perspective_[0] >> ball.angles_camera_ortho_perspective_[1];
+
+            if (s.fail()) {
+                return false;
+            }
+
+            ball.set_x(x);
+            ball.set_y(y);
+            ball.ball_circle_[2] = radius;
+
+            return true;
+        }
+    }
+
+
+    void GsSpinOffload::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kEnableSpinOffload", kEnableSpinOffload);
+        GolfSimConfiguration::SetConstant("gs_config.spin_analysis.kSpinOffloadTimeoutMs", kSpinOffloadTimeoutMs);
+
+        if (kEnableSpinOffload) {
+            GS_LOG_TRACE_MSG(trace, "GsSpinOffload enabled - timeout is " +
+                std::to_string(kSpinOffloadTimeoutMs) + "ms.");
+        }
+    }
+
+
+#ifdef __unix__
+
+    bool GsSpinOffload::TryRemoteBallRotation(const cv::Mat& full_gray_image1,
+                                              const GolfBall& ball1,
+                                              const cv::Mat& full_gray_image2,
+                                              const GolfBall& ball2,
+                                              cv::Vec3d& rotation_results) {
+
+        if (!kEnableSpinOffload) {
+            return false;
+        }
+
+        // Only the two-Pi camera-1 system has another Pi to offload to
+        if (GolfSimOptions::GetCommandLineOptions().system_mode_ != SystemMode::kCamera1) {
+            return false;
+        }
+
+        auto offload_start = std::chrono::steady_clock::now();
+
+        // Isolate the crops here so only the two small ball images go over
+        // the wire.  IsolateBall adjusts the ball coordinates to be relative
+        // to its crop, which is exactly what the remote side needs.
+        GolfBall local_ball1 = ball1;
+        GolfBall local_ball2 = ball2;
+
+        cv::Mat crop1 = BallImageProc::IsolateBall(full_gray_image1, local_ball1);
+        cv::Mat crop2 = BallImageProc::IsolateBall(full_gray_image2, local_ball2);
+
+        if (crop1.empty() || crop2.empty()) {
+            GS_LOG_MSG(warning, "GsSpinOffload - IsolateBall returned an empty crop.  Computing locally.");
+            return false;
+        }
+
+        // The de-rotation step uses the original balls' camera-perspective
+        // angles; IsolateBall does not touch them, but be explicit
+        local_ball1.angles_camera_ortho_perspective_ = ball1.angles_camera_ortho_perspective_;
+        local_ball2.angles_camera_ortho_perspective_ = ball2.angles_camera_ortho_perspective_;
+
+        // The two crops travel as one side-by-side image.  Pad the shorter
+        // crop at the bottom - GetBallRotation re-isolates each ball from
+        // its crop, so extra black border rows are ignored.
+        int rows = std::max(crop1.rows, crop2.rows);
+
+        if (crop1.rows < rows) {
+            cv::copyMakeBorder(crop1, crop1, 0, rows - crop1.rows, 0, 0, cv::BORDER_CONSTANT, cv::Scalar(0));
+        }
+        if (crop2.rows < rows) {
+            cv::copyMakeBorder(crop2, crop2, 0, rows - crop2.rows, 0, 0, cv::BORDER_CONSTANT, cv::Scalar(0));
+        }
+
+        cv::Mat combined;
+        cv::hconcat(crop1, crop2, combined);
+
+        {
+            std::lock_guard<std::mutex> lock(offload_mutex);
+            response_pending = true;
+            response_received = false;
+        }
+
+        GolfSimIPCMessage request(GolfSimIPCMessage::IPCMessageType::kSpinOffloadRequest);
+        request.SetImageMat(combined);
+        request.SetSpinOffloadRequestData(PackBallData(local_ball1), PackBallData(local_ball2), crop1.cols);
+
+        if (!GolfSimIpcSystem::SendIpcMessage(request)) {
+            GS_LOG_MSG(warning, "GsSpinOffload - failed to send the offload request.  Computing locally.");
+            std::lock_guard<std::mutex> lock(offload_mutex);
+            response_pending = false;
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(offload_mutex);
+
+        bool answered = offload_cv.wait_for(lock, std::chrono::milliseconds(kSpinOffloadTimeoutMs),
+                                            []() { return response_received; });
+
+        response_pending = false;
+
+        if (!answered || !response_succeeded) {
+            offloads_timed_out++;
+            GS_LOG_MSG(warning, "GsSpinOffload - no usable response from the camera-2 system within " +
+                std::to_string(kSpinOffloadTimeoutMs) + "ms (" + std::to_string(offloads_timed_out) +
+                " misses so far).  Computing locally.");
+            return false;
+        }
+
+        rotation_results = response_rotation;
+        offloads_succeeded++;
+
+        long long elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - offload_start).count();
+
+        GS_LOG_MSG(info, "GsSpinOffload - camera-2 system returned the rotation in " +
+            std::to_string(elapsed_ms) + "ms (" + std::to_string(offloads_succeeded) + " offloads so far).");
+
+        return true;
+    }
+
+
+    bool GsSpinOffload::HandleOffloadRequest(const GolfSimIPCMessage& message) {
+
+        GS_LOG_TRACE_MSG(trace, "GsSpinOffload::HandleOffloadRequest.");
+
+        cv::Mat combined = message.GetImageMat();
+        int split_col = message.GetSpinOffloadSplitCol();
+
+        GolfSimIPCMessage response(GolfSimIPCMessage::IPCMessageType::kSpinOffloadResponse);
+
+        GolfBall ball1;
+        GolfBall ball2;
+
+        if (combined.empty() || split_col <= 0 || split_col >= combined.cols ||
+            !UnpackBallData(message.GetSpinOffloadBall1Data(), ball1) ||
+            !UnpackBallData(message.GetSpinOffloadBall2Data(), ball2)) {
+
+            GS_LOG_MSG(warning, "GsSpinOffload::HandleOffloadRequest - malformed request.  Answering with a failure.");
+            response.SetSpinOffloadResult(0.0, 0.0, 0.0, false);
+            return GolfSimIpcSystem::SendIpcMessage(response);
+        }
+
+        // Clone so each crop is continuous - the Gabor filtering and rotation
+        // loops downstream assume ordinary row strides
+        cv::Mat crop1 = combined.colRange(0, split_col).clone();
+        cv::Mat crop2 = combined.colRange(split_col, combined.cols).clone();
+
+        auto search_start = std::chrono::steady_clock::now();
+
+        cv::Vec3d rotation = BallImageProc::GetBallRotation(crop1, ball1, crop2, ball2);
+
+        long long elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - search_start).count();
+
+        GS_LOG_MSG(info, "GsSpinOffload - computed the offloaded rotation in " +
+            std::to_string(elapsed_ms) + "ms.");
+
+        response.SetSpinOffloadResult(rotation[0], rotation[1], rotation[2], true);
+
+        return GolfSimIpcSystem::SendIpcMessage(response);
+    }
+
+
+    bool GsSpinOffload::HandleOffloadResponse(const GolfSimIPCMessage& message) {
+
+        GS_LOG_TRACE_MSG(trace, "GsSpinOffload::HandleOffloadResponse.");
+
+        std::lock_guard<std::mutex> lock(offload_mutex);
+
+        if (!response_pending) {
+            // A late answer to a request we already gave up on - the local
+            // computation is underway, so just drop it
+            GS_LOG_TRACE_MSG(trace, "GsSpinOffload - discarding a response with no request outstanding.");
+            return true;
+        }
+
+        response_rotation = cv::Vec3d(message.GetSpinOffloadRotationX(),
+                                      message.GetSpinOffloadRotationY(),
+                                      message.GetSpinOffloadRotationZ());
+        response_succeeded = message.GetSpinOffloadSucceeded();
+        response_received = true;
+
+        offload_cv.notify_one();
+
+        return true;
+    }
+
+#else
+
+    bool GsSpinOffload::TryRemoteBallRotation(const cv::Mat&, const GolfBall&,
+                                              const cv::Mat&, const GolfBall&, cv::Vec3d&) {
+        return false;
+    }
+
+    bool GsSpinOffload::HandleOffloadRequest(const GolfSimIPCMessage&) {
+        return true;
+    }
+
+    bool GsSpinOffload::HandleOffloadResponse(const GolfSimIPCMessage&) {
+        return true;
+    }
+
+#endif
+
+}
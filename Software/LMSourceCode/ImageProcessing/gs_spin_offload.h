@@ -0,0 +1,72 @@
+/*****************************************************************//**
+ * \file   gs_spin_offload.h
+ * \brief  Offloads the spin-rotation search to the camera-2 Pi.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include "golf_ball.h"
+
+namespace golf_sim {
+
+    class GolfSimIPCMessage;
+
+    // In the two-Pi setup, the camera-2 Pi goes idle the moment its strobed
+    // image has been shipped - exactly when the camera-1 Pi is busiest with
+    // ball detection and the spin-rotation candidate search.  When enabled,
+    // camera 1 isolates the two spin-ball crops (small, post-IsolateBall
+    // images), ships them over the broker, and the camera-2 Pi runs
+    // BallImageProc::GetBallRotation on its own four cores and returns the
+    // rotation vector.
+    //
+    // The offload is strictly opportunistic: if camera 2 does not answer
+    // within the timeout (not deployed with the feature enabled, still busy,
+    // broker hiccup), camera 1 computes the rotation locally as it always
+    // has.  The only cost of a miss is the timeout wait, so the timeout
+    // should stay well below the local computation time.
+    //
+    // Off by default (gs_config.spin_analysis.kEnableSpinOffload); both Pis
+    // must run builds that understand the exchange.
+
+    class GsSpinOffload {
+
+    public:
+
+        static bool kEnableSpinOffload;
+        static int kSpinOffloadTimeoutMs;
+
+        // Reads the configuration values above.  Call once at startup.
+        static void Initialize();
+
+        // Camera-1 side.  Attempts the remote computation and returns true
+        // with the rotation (in the same units as GetBallRotation) if
+        // camera 2 answered in time.  Returns false - and the caller should
+        // run GetBallRotation locally - when the offload is disabled, not in
+        // the two-Pi mode, or timed out.
+        static bool TryRemoteBallRotation(const cv::Mat& full_gray_image1,
+                                          const GolfBall& ball1,
+                                          const cv::Mat& full_gray_image2,
+                                          const GolfBall& ball2,
+                                          cv::Vec3d& rotation_results);
+
+        // Camera-2 side.  Runs the rotation search on the shipped crops and
+        // sends the kSpinOffloadResponse.  Called from the IPC dispatch (see
+        // GolfSimIpcSystem::DispatchSpinOffloadRequestMessage).
+        static bool HandleOffloadRequest(const GolfSimIPCMessage& message);
+
+        // Camera-1 side.  Delivers the rotation vector to the waiting
+        // TryRemoteBallRotation call.
+        static bool HandleOffloadResponse(const GolfSimIPCMessage& message);
+    };
+
+}
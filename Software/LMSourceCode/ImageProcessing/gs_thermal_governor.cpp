@@ -0,0 +1,316 @@
+/*****************************************************************//**
+ * \file   gs_thermal_governor.cpp
+ * \brief  Thermal-aware adaptive workload governor.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "gs_thermal_governor.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+#include "ball_image_proc.h"
+#include "gs_camera.h"
+#include "gs_ui_system.h"
+
+namespace golf_sim {
+
+    bool GsThermalGovernor::kEnableThermalGovernor = false;
+    int GsThermalGovernor::kThermalPollIntervalSecs = 5;
+    float GsThermalGovernor::kThermalSoftLimitC = 75.0F;
+    float GsThermalGovernor::kThermalHardLimitC = 80.0F;
+    float GsThermalGovernor::kThermalRecoveryHysteresisC = 4.0F;
+
+    namespace {
+
+        // Where the Pi exposes the SoC temperature (millidegrees C) and the
+        // firmware throttle bits.  Missing files simply disable that signal.
+        const char* kThermalZoneFile = "/sys/class/thermal/thermal_zone0/temp";
+        const char* kThrottledBitsFile = "/sys/devices/platform/soc/soc:firmware/get_throttled";
+
+        // get_throttled: bit 2 = actively throttled, bit 3 = soft
+        // temperature limit reached.  Either one means the firmware is
+        // already taking performance away from us.
+        const unsigned long kThrottledNowMask = 0xC;
+
+        std::atomic<int> current_level{ 0 };
+
+        // The last sensor reading, for the status suffix.  Negative until
+        // the first successful read.
+        std::atomic<float> last_temperature_c{ -1000.0F };
+
+        std::thread* governor_thread = nullptr;
+        std::mutex governor_mutex;
+        std::condition_variable governor_cv;
+        bool governor_exit = false;
+
+        // The configured (level 0) values of every knob the governor
+        // touches, captured before the first adjustment.
+        bool baselines_captured = false;
+        int baseline_coarse_x_increment = 0;
+        int baseline_coarse_y_increment = 0;
+        int baseline_coarse_z_increment = 0;
+        bool baseline_write_spin_csv = false;
+        bool baseline_log_spin_images = false;
+        bool baseline_log_exposure_images = false;
+        int baseline_web_jpeg_quality = 0;
+
+        bool ReadSocTemperatureC(float& temperature_c) {
+
+            std::ifstream file(kThermalZoneFile);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            long millidegrees = 0;
+            file >> millidegrees;
+            if (file.fail()) {
+                return false;
+            }
+
+            temperature_c = (float)millidegrees / 1000.0F;
+            return true;
+        }
+
+        bool ReadThrottledNow(bool& throttled_now) {
+
+            std::ifstream file(kThrottledBitsFile);
+            if (!file.is_open()) {
+                return false;
+            }
+
+            unsigned long bits = 0;
+            file >> std::hex >> bits;
+            if (file.fail()) {
+                return false;
+            }
+
+            throttled_now = (bits & kThrottledNowMask) != 0;
+            return true;
+        }
+
+        void CaptureBaselines() {
+
+            if (baselines_captured) {
+                return;
+            }
+
+            baseline_coarse_x_increment = BallImageProc::kCoarseXRotationDegreesIncrement;
+            baseline_coarse_y_increment = BallImageProc::kCoarseYRotationDegreesIncrement;
+            baseline_coarse_z_increment = BallImageProc::kCoarseZRotationDegreesIncrement;
+            baseline_write_spin_csv = BallImageProc::kWriteSpinAnalysisCsvFiles;
+            baseline_log_spin_images = BallImageProc::kLogIntermediateSpinImagesToFile;
+            baseline_log_exposure_images = GolfSimCamera::kLogIntermediateExposureImagesToFile;
+            baseline_web_jpeg_quality = GsUISystem::kWebServerJpegQuality;
+
+            baselines_captured = true;
+        }
+
+        std::string DescribeLevel(int level) {
+            switch (level) {
+                case 0:  return "full performance";
+                case 1:  return "diagnostics shed, coarser spin grid";
+                default: return "minimum workload";
+            }
+        }
+
+        // Sets every governed knob for the given level.  The adjustments
+        // deliberately shed optional quality and diagnostics rather than
+        // accuracy-critical work - a chosen, bounded degradation instead of
+        // the firmware's across-the-board clock cut.
+        void ApplyLevel(int level) {
+
+            CaptureBaselines();
+
+            if (level <= 0) {
+                BallImageProc::kCoarseXRotationDegreesIncrement = baseline_coarse_x_increment;
+                BallImageProc::kCoarseYRotationDegreesIncrement = baseline_coarse_y_increment;
+                BallImageProc::kCoarseZRotationDegreesIncrement = baseline_coarse_z_increment;
+                BallImageProc::kWriteSpinAnalysisCsvFiles = baseline_write_spin_csv;
+                BallImageProc::kLogIntermediateSpinImagesToFile = baseline_log_spin_images;
+                GolfSimCamera::kLogIntermediateExposureImagesToFile = baseline_log_exposure_images;
+                GsUISystem::kWebServerJpegQuality = baseline_web_jpeg_quality;
+                return;
+            }
+
+            // Both shedding levels drop the diagnostic output - CSVs and
+            // intermediate images are pure overhead during a hot session
+            BallImageProc::kWriteSpinAnalysisCsvFiles = false;
+            BallImageProc::kLogIntermediateSpinImagesToFile = false;
+            GolfSimCamera::kLogIntermediateExposureImagesToFile = false;
+
+            if (level == 1) {
+                // Roughly 1.5x coarser spin grid: the search cost falls by
+                // about 3x across the three axes
+                BallImageProc::kCoarseXRotationDegreesIncrement = (baseline_coarse_x_increment * 3 + 1) / 2;
+                BallImageProc::kCoarseYRotationDegreesIncrement = (baseline_coarse_y_increment * 3 + 1) / 2;
+                BallImageProc::kCoarseZRotationDegreesIncrement = (baseline_coarse_z_increment * 3 + 1) / 2;
+                GsUISystem::kWebServerJpegQuality = baseline_web_jpeg_quality;
+            }
+            else {
+                // 2x coarser grid (about 8x cheaper), plus a cheaper preview
+                // encode for the web GUI
+                BallImageProc::kCoarseXRotationDegreesIncrement = baseline_coarse_x_increment * 2;
+                BallImageProc::kCoarseYRotationDegreesIncrement = baseline_coarse_y_increment * 2;
+                BallImageProc::kCoarseZRotationDegreesIncrement = baseline_coarse_z_increment * 2;
+                GsUISystem::kWebServerJpegQuality = std::min(baseline_web_jpeg_quality, 70);
+            }
+        }
+
+        void RunGovernorThread() {
+
+            GS_LOG_TRACE_MSG(trace, "GsThermalGovernor polling thread starting.");
+
+            std::unique_lock<std::mutex> lock(governor_mutex);
+
+            while (!governor_exit) {
+
+                lock.unlock();
+
+                float temperature_c = 0.0F;
+                bool have_temperature = ReadSocTemperatureC(temperature_c);
+
+                bool throttled_now = false;
+                ReadThrottledNow(throttled_now);
+
+                if (have_temperature) {
+                    last_temperature_c.store(temperature_c);
+
+                    int level = current_level.load();
+                    int desired_level = level;
+
+                    if (temperature_c >= GsThermalGovernor::kThermalHardLimitC || throttled_now) {
+                        desired_level = 2;
+                    }
+                    else if (temperature_c >= GsThermalGovernor::kThermalSoftLimitC) {
+                        desired_level = (level < 1) ? 1 : level;
+                    }
+                    else if (temperature_c <= GsThermalGovernor::kThermalSoftLimitC -
+                                              GsThermalGovernor::kThermalRecoveryHysteresisC) {
+                        // Cool again - give back one level per poll so the
+                        // recovery is as deliberate as the shedding was
+                        desired_level = (level > 0) ? level - 1 : 0;
+                    }
+
+                    if (desired_level != level) {
+                        ApplyLevel(desired_level);
+                        current_level.store(desired_level);
+
+                        GS_LOG_MSG(warning, "GsThermalGovernor - SoC at " + std::to_string(temperature_c) +
+                            " C" + (throttled_now ? " (firmware throttling active)" : "") +
+                            ".  Moving from level " + std::to_string(level) + " to level " +
+                            std::to_string(desired_level) + " (" + DescribeLevel(desired_level) + ").");
+                    }
+                }
+
+                lock.lock();
+
+                governor_cv.wait_for(lock, std::chrono::seconds(GsThermalGovernor::kThermalPollIntervalSecs),
+                                     []() { return governor_exit; });
+            }
+
+            GS_LOG_TRACE_MSG(trace, "GsThermalGovernor polling thread exiting.");
+        }
+    }
+
+    void GsThermalGovernor::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.modes.kEnableThermalGovernor", kEnableThermalGovernor);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kThermalPollIntervalSecs", kThermalPollIntervalSecs);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kThermalSoftLimitC", kThermalSoftLimitC);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kThermalHardLimitC", kThermalHardLimitC);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kThermalRecoveryHysteresisC", kThermalRecoveryHysteresisC);
+
+        if (!kEnableThermalGovernor) {
+            return;
+        }
+
+        if (kThermalPollIntervalSecs < 1) {
+            LoggingTools::Warning("kThermalPollIntervalSecs must be at least 1.  Using 1.");
+            kThermalPollIntervalSecs = 1;
+        }
+
+        float probe_temperature_c = 0.0F;
+        if (!ReadSocTemperatureC(probe_temperature_c)) {
+            LoggingTools::Warning("GsThermalGovernor could not read " + std::string(kThermalZoneFile) +
+                ".  The thermal governor will not run.");
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(governor_mutex);
+
+        if (governor_thread != nullptr) {
+            return;
+        }
+
+        governor_exit = false;
+        governor_thread = new std::thread(RunGovernorThread);
+    }
+
+    void GsThermalGovernor::Shutdown() {
+
+        std::thread* thread_to_join = nullptr;
+
+        {
+            std::lock_guard<std::mutex> lock(governor_mutex);
+
+            if (governor_thread == nullptr) {
+                return;
+            }
+
+            governor_exit = true;
+            thread_to_join = governor_thread;
+            governor_thread = nullptr;
+        }
+
+        governor_cv.notify_one();
+        thread_to_join->join();
+        delete thread_to_join;
+
+        // Leave the knobs the way the configuration set them
+        if (current_level.load() != 0) {
+            ApplyLevel(0);
+            current_level.store(0);
+        }
+    }
+
+    int GsThermalGovernor::CurrentLevel() {
+        return current_level.load();
+    }
+
+    std::string GsThermalGovernor::StatusSuffix() {
+
+        if (!kEnableThermalGovernor) {
+            return "";
+        }
+
+        float temperature_c = last_temperature_c.load();
+        if (temperature_c < -100.0F) {
+            return "";
+        }
+
+        int level = current_level.load();
+
+        if (level == 0) {
+            return "  [SoC " + std::to_string((int)(temperature_c + 0.5F)) + " C]";
+        }
+
+        return "  [SoC " + std::to_string((int)(temperature_c + 0.5F)) + " C - thermal level " +
+            std::to_string(level) + ": " + DescribeLevel(level) + "]";
+    }
+
+}
@@ -0,0 +1,74 @@
+/*****************************************************************//**
+ * \file   gs_thermal_governor.h
+ * \brief  Thermal-aware adaptive workload governor.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace golf_sim {
+
+    // A Pi 4 in an enclosed bay heats up over a session until the firmware
+    // throttles the SoC, at which point every stage of the pipeline slows
+    // down at once and unpredictably - spin analysis suddenly taking twice
+    // as long, for example.  This governor watches the SoC temperature and
+    // throttle state and, as the soft limit is approached, sheds optional
+    // work in chosen steps (coarser spin search grid, no diagnostic CSV and
+    // intermediate-image writes, cheaper web-preview JPEG encoding) so the
+    // unit stays below the throttle point instead of falling off the cliff.
+    //
+    // Three levels: 0 is full performance, 1 sheds diagnostics and coarsens
+    // the spin grid moderately, 2 (at the hard limit, or whenever the
+    // firmware reports active throttling) coarsens further and reduces the
+    // preview encode quality.  Recovery steps back down only after the
+    // temperature has dropped a hysteresis margin below the soft limit, so
+    // the levels do not flap.  Every change is logged, and the current
+    // reading and level ride the outgoing GUI status messages.
+    //
+    // Off by default (gs_config.modes.kEnableThermalGovernor).
+
+    class GsThermalGovernor {
+
+    public:
+
+        static bool kEnableThermalGovernor;
+        static int kThermalPollIntervalSecs;
+
+        // Degrees Celsius.  The governor starts shedding work at the soft
+        // limit and reaches its minimum workload at the hard limit; the Pi 4
+        // firmware throttles at 80-85 C, so the defaults leave headroom.
+        static float kThermalSoftLimitC;
+        static float kThermalHardLimitC;
+
+        // How far below the soft limit the temperature must fall before a
+        // level is given back.
+        static float kThermalRecoveryHysteresisC;
+
+        // Reads the configuration values above and, when enabled, starts the
+        // polling thread.  Call once at startup, after the JSON
+        // configuration has been parsed (the baselines it restores on
+        // recovery are captured from the parsed values).
+        static void Initialize();
+
+        // Stops the polling thread and restores the baseline workload knobs.
+        static void Shutdown();
+
+        // The current governor level (0 = full performance).
+        static int CurrentLevel();
+
+        // A short summary (temperature, level) for the status messages, or
+        // an empty string when the governor is off or has not yet read the
+        // sensor.
+        static std::string StatusSuffix();
+    };
+
+}
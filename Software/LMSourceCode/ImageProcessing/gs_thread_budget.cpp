@@ -0,0 +1,149 @@
+/*****************************************************************//**
+ * \file   gs_thread_budget.cpp
+ * \brief  Central compute-thread budget for the shot-analysis phases.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include <opencv2/core.hpp>
+
+#include "gs_thread_budget.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+#include "ball_image_proc.h"
+
+namespace golf_sim {
+
+    bool GsThreadBudget::kUseThreadBudgetManager = false;
+    int GsThreadBudget::kTotalComputeThreads = 0;
+    int GsThreadBudget::kDetectionPhaseOpenCVThreads = 0;
+    int GsThreadBudget::kSpinPhaseOpenCVThreads = 0;
+
+    namespace {
+
+        // Phase changes happen on the analysis thread, but the FSM and the
+        // camera-2 receiver can race a startup re-initialization, so the
+        // current phase is kept behind a mutex.
+        std::mutex budget_mutex;
+        GsThreadBudget::Phase current_phase = GsThreadBudget::Phase::kDefault;
+
+        int TotalBudget() {
+            if (GsThreadBudget::kTotalComputeThreads > 0) {
+                return GsThreadBudget::kTotalComputeThreads;
+            }
+            const unsigned int hardware_threads = std::thread::hardware_concurrency();
+            return hardware_threads > 0 ? (int)hardware_threads : 4;
+        }
+
+        const char* PhaseName(GsThreadBudget::Phase phase) {
+            switch (phase) {
+                case GsThreadBudget::Phase::kDetection:    return "detection";
+                case GsThreadBudget::Phase::kSpinAnalysis: return "spin-analysis";
+                default:                                   return "default";
+            }
+        }
+
+    }
+
+
+    int GsThreadBudget::OpenCVThreadsForPhase(Phase phase) {
+
+        const int total = TotalBudget();
+
+        switch (phase) {
+
+            case Phase::kDetection: {
+                if (kDetectionPhaseOpenCVThreads > 0) {
+                    return kDetectionPhaseOpenCVThreads;
+                }
+                // ONNX Runtime's intra-op pool keeps its kONNXRuntimeThreads
+                // share for the whole run (it is fixed at session creation),
+                // so during detection OpenCV only gets what remains.
+                return std::max(1, total - BallImageProc::kONNXRuntimeThreads);
+            }
+
+            case Phase::kSpinAnalysis: {
+                if (kSpinPhaseOpenCVThreads > 0) {
+                    return kSpinPhaseOpenCVThreads;
+                }
+                return total;
+            }
+
+            default:
+                return total;
+        }
+    }
+
+    void GsThreadBudget::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.image_processing.kUseThreadBudgetManager", kUseThreadBudgetManager);
+        GolfSimConfiguration::SetConstant("gs_config.image_processing.kTotalComputeThreads", kTotalComputeThreads);
+        GolfSimConfiguration::SetConstant("gs_config.image_processing.kDetectionPhaseOpenCVThreads", kDetectionPhaseOpenCVThreads);
+        GolfSimConfiguration::SetConstant("gs_config.image_processing.kSpinPhaseOpenCVThreads", kSpinPhaseOpenCVThreads);
+
+        if (!kUseThreadBudgetManager) {
+            GS_LOG_TRACE_MSG(trace, "GsThreadBudget is disabled - thread pools keep their independent sizes.");
+            return;
+        }
+
+        GS_LOG_TRACE_MSG(trace, "GsThreadBudget::Initialize - budgeting " + std::to_string(TotalBudget()) +
+            " compute threads (detection-phase OpenCV share: " + std::to_string(OpenCVThreadsForPhase(Phase::kDetection)) +
+            ", spin-phase OpenCV share: " + std::to_string(OpenCVThreadsForPhase(Phase::kSpinAnalysis)) + ").");
+
+        EnterPhase(Phase::kDefault);
+    }
+
+    void GsThreadBudget::EnterPhase(Phase phase) {
+
+        if (!kUseThreadBudgetManager) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(budget_mutex);
+
+        const int opencv_threads = OpenCVThreadsForPhase(phase);
+
+        if (phase != current_phase) {
+            GS_LOG_TRACE_MSG(trace, "GsThreadBudget - entering " + std::string(PhaseName(phase)) +
+                " phase, cv::setNumThreads(" + std::to_string(opencv_threads) + ").");
+        }
+
+        cv::setNumThreads(opencv_threads);
+        current_phase = phase;
+    }
+
+
+    GsThreadBudget::ScopedPhase::ScopedPhase(Phase phase) {
+
+        if (!kUseThreadBudgetManager) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(budget_mutex);
+            previous_phase_ = current_phase;
+        }
+        active_ = true;
+
+        EnterPhase(phase);
+    }
+
+    GsThreadBudget::ScopedPhase::~ScopedPhase() {
+
+        if (active_) {
+            EnterPhase(previous_phase_);
+        }
+    }
+
+}
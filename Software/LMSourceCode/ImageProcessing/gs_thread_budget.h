@@ -0,0 +1,78 @@
+/*****************************************************************//**
+ * \file   gs_thread_budget.h
+ * \brief  Central compute-thread budget for the shot-analysis phases.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+namespace golf_sim {
+
+    // OpenCV's internal parallel_for, ONNX Runtime's intra-op pool, and the
+    // system's own worker threads are each sized independently, and during a
+    // shot they oversubscribe the Pi's four cores - context-switch storms in
+    // AnalyzeStrobedBalls were measured costing 15-20%.  This manager holds
+    // the one budget and re-partitions it at phase boundaries:  during
+    // detection, OpenCV is trimmed so that its pool plus ONNX Runtime's
+    // intra-op threads (kONNXRuntimeThreads, fixed at session creation - ORT
+    // cannot be re-threaded afterwards) fit the core count; during spin
+    // analysis, with no inference running, OpenCV gets the whole budget back.
+    //
+    // Off by default (gs_config.image_processing.kUseThreadBudgetManager), in
+    // which case EnterPhase and the scoped helper do nothing and every pool
+    // keeps its independently-configured size.
+
+    class GsThreadBudget {
+
+    public:
+
+        enum class Phase { kDefault = 0, kDetection, kSpinAnalysis };
+
+        static bool kUseThreadBudgetManager;
+
+        // Total cores to budget across the pools.  0 (the default) means use
+        // the hardware concurrency.
+        static int kTotalComputeThreads;
+
+        // OpenCV's share per phase.  0 means derive it:  for detection,
+        // total minus ONNX Runtime's intra-op share (minimum 1); for spin,
+        // the whole budget.
+        static int kDetectionPhaseOpenCVThreads;
+        static int kSpinPhaseOpenCVThreads;
+
+        // Reads the configuration and applies the default-phase partition.
+        // Call once at startup, after the JSON configuration is available.
+        static void Initialize();
+
+        // Re-partitions the pools for the given phase.  No-op when the
+        // manager is disabled.
+        static void EnterPhase(Phase phase);
+
+        // Enters a phase for the lifetime of a scope and restores the
+        // previous phase on exit, so nested stages compose correctly.
+        class ScopedPhase {
+        public:
+            explicit ScopedPhase(Phase phase);
+            ~ScopedPhase();
+
+            ScopedPhase(const ScopedPhase&) = delete;
+            ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+        private:
+            Phase previous_phase_;
+            bool active_ = false;
+        };
+
+    private:
+
+        static int OpenCVThreadsForPhase(Phase phase);
+    };
+
+}
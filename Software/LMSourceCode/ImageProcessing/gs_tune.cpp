@@ -0,0 +1,321 @@
+/*****************************************************************//**
+ * \file   gs_tune.cpp
+ * \brief  Hough parameter auto-tuning sweep over the test corpus.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+ /* SPDX-License-Identifier: GPL-2.0-only */
+ /*
+  * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+  */
+
+// Builds as the (optional) pitrac_tune executable.  This is the productized
+// descendant of Software/Playgrounds/HoughCirclePlayground - instead of a human
+// moving sliders, the tool sweeps a grid of the kStrobedBalls* Hough parameters
+// around their currently-configured values, scores each candidate against the
+// labeled automated-test corpus (the same expected-results CSV and images the
+// automated_testing mode uses), and reports the Pareto-optimal candidates on
+// the accuracy-versus-detection-time front.  The best candidate (highest
+// accuracy, ties broken by speed) is written out as a golf_sim_config.json
+// fragment that can be merged into a bay's configuration.
+//
+// The corpus cases for one candidate run in parallel across cores; candidates
+// themselves run one at a time, because the swept parameters are process-wide
+// statics on BallImageProc.
+//
+// Usage:
+//      pitrac_tune <output_json_fragment> [config_file]
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gs_config.h"
+#include "gs_options.h"
+#include "gs_globals.h"
+#include "logging_tools.h"
+#include "ball_image_proc.h"
+#include "gs_camera.h"
+#include "gs_automated_testing.h"
+#include "pulse_strobe.h"
+
+
+using namespace golf_sim;
+
+
+// One point in the swept parameter space.  The members mirror the
+// gs_config.ball_identification constants they are applied to.
+struct HoughParamCandidate {
+    double canny_lower = 0.0;
+    double canny_upper = 0.0;
+    int pre_hough_blur_size = 0;
+    double starting_param2 = 0.0;
+    double param1 = 0.0;
+
+    // Filled in by EvaluateCandidate
+    double accuracy = 0.0;              // Fraction of corpus cases that passed
+    double mean_detection_ms = 0.0;     // Mean strobed-ball detection time over the cases that ran
+
+    std::string Format() const {
+        return "CannyLower=" + std::to_string(canny_lower) +
+            " CannyUpper=" + std::to_string(canny_upper) +
+            " PreHoughBlurSize=" + std::to_string(pre_hough_blur_size) +
+            " StartingParam2=" + std::to_string(starting_param2) +
+            " Param1=" + std::to_string(param1);
+    }
+};
+
+
+// Applies the candidate to the process-wide Hough constants that
+// BallImageProc::GetBall reads
+static void ApplyCandidate(const HoughParamCandidate& candidate) {
+    BallImageProc::kStrobedBallsCannyLower = candidate.canny_lower;
+    BallImageProc::kStrobedBallsCannyUpper = candidate.canny_upper;
+    BallImageProc::kStrobedBallsPreHoughBlurSize = candidate.pre_hough_blur_size;
+    BallImageProc::kStrobedBallsStartingParam2 = candidate.starting_param2;
+    BallImageProc::kStrobedBallsCurrentParam1 = candidate.param1;
+}
+
+
+// Runs the whole corpus (across a worker pool) with the candidate's parameters
+// applied and fills in its accuracy and mean detection time
+static void EvaluateCandidate(HoughParamCandidate& candidate,
+                              const std::vector<GsAutomatedTesting::FinalResultsTestScenario>& tests,
+                              const GsResults& tolerances,
+                              int num_workers) {
+
+    ApplyCandidate(candidate);
+
+    std::vector<GsAutomatedTesting::FinalResultsTestOutcome> outcomes(tests.size());
+    std::atomic<size_t> next_test_index{ 0 };
+
+    auto test_worker = [&]() {
+        for (;;) {
+            size_t i = next_test_index.fetch_add(1);
+
+            if (i >= tests.size()) {
+                return;
+            }
+
+            if (tests[i].ignore_shot) {
+                continue;
+            }
+
+            outcomes[i] = GsAutomatedTesting::RunFinalShotResultTest(tests[i], tolerances);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < num_workers; i++) {
+        workers.emplace_back(test_worker);
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    int num_scored_cases = 0;
+    int num_passed_cases = 0;
+    int num_timed_cases = 0;
+    double total_detection_ms = 0.0;
+
+    for (size_t i = 0; i < tests.size(); i++) {
+        if (tests[i].ignore_shot) {
+            continue;
+        }
+
+        num_scored_cases++;
+
+        // A case whose analysis failed outright counts against accuracy, but
+        // contributes no timing - there is nothing comparable to time
+        if (outcomes[i].ran) {
+            num_timed_cases++;
+            total_detection_ms += outcomes[i].strobed_analysis_ms;
+
+            if (outcomes[i].passed) {
+                num_passed_cases++;
+            }
+        }
+    }
+
+    candidate.accuracy = (num_scored_cases > 0) ? (double)num_passed_cases / num_scored_cases : 0.0;
+    candidate.mean_detection_ms = (num_timed_cases > 0) ? total_detection_ms / num_timed_cases : 0.0;
+}
+
+
+// A candidate is Pareto-optimal if no other candidate is at least as accurate
+// AND at least as fast, with one of the two strictly better
+static bool IsDominated(const HoughParamCandidate& candidate, const std::vector<HoughParamCandidate>& all) {
+
+    for (const HoughParamCandidate& other : all) {
+        if (other.accuracy >= candidate.accuracy && other.mean_detection_ms <= candidate.mean_detection_ms &&
+            (other.accuracy > candidate.accuracy || other.mean_detection_ms < candidate.mean_detection_ms)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+static bool WriteConfigFragment(const std::string& output_filename, const HoughParamCandidate& best) {
+
+    std::ofstream fragment_file(output_filename, std::ios::trunc);
+
+    if (!fragment_file) {
+        std::cerr << "Could not open output file: " << output_filename << std::endl;
+        return false;
+    }
+
+    // The same string-valued format golf_sim_config.json uses, ready to merge
+    // into the ball_identification section
+    fragment_file << "{\n";
+    fragment_file << "    \"gs_config\": {\n";
+    fragment_file << "        \"ball_identification\": {\n";
+    fragment_file << "            \"kStrobedBallsCannyLower\": \"" << best.canny_lower << "\",\n";
+    fragment_file << "            \"kStrobedBallsCannyUpper\": \"" << best.canny_upper << "\",\n";
+    fragment_file << "            \"kStrobedBallsPreHoughBlurSize\": \"" << best.pre_hough_blur_size << "\",\n";
+    fragment_file << "            \"kStrobedBallsStartingParam2\": \"" << best.starting_param2 << "\",\n";
+    fragment_file << "            \"kStrobedBallsCurrentParam1\": \"" << best.param1 << "\"\n";
+    fragment_file << "        }\n";
+    fragment_file << "    }\n";
+    fragment_file << "}\n";
+
+    return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+    try {
+        if (argc < 2) {
+            std::cerr << "Usage: pitrac_tune <output_json_fragment> [config_file]" << std::endl;
+            return 1;
+        }
+
+        std::string output_filename = argv[1];
+        std::string config_file_name = (argc > 2) ? argv[2] : "golf_sim_config.json";
+
+        LoggingTools::InitLogging();
+
+        if (!GolfSimConfiguration::Initialize(config_file_name)) {
+            std::cerr << "Could not initialize configuration module using config file: " << config_file_name << std::endl;
+            return 1;
+        }
+
+        GolfSimGlobals::golf_sim_running_ = true;
+
+        BallImageProc::LoadConfigurationValues();
+
+        // The pulse intervals must be set up so that the analysis can determine
+        // pulse-ratios for distance and time measurements
+        if (!PulseStrobe::InitGPIOSystem(nullptr /* Signal handler not needed here */)) {
+            std::cerr << "Failed to InitGPIOSystem." << std::endl;
+            return 1;
+        }
+
+        std::string test_suite_directory;
+        std::vector<GsAutomatedTesting::FinalResultsTestScenario> tests;
+        GsResults tolerances;
+
+        if (!GsAutomatedTesting::LoadFinalResultsCorpus(test_suite_directory, tests, tolerances)) {
+            std::cerr << "Could not load the automated-test corpus (check gs_config.testing in the .json file)." << std::endl;
+            return 1;
+        }
+
+        int num_workers = std::max(1u, std::thread::hardware_concurrency());
+
+        // Build the candidate grid - relative steps around the currently-configured
+        // values, with the current configuration itself as the baseline candidate.
+        // The Canny thresholds move together (their ratio is what the playground
+        // sessions always ended up preserving), and the blur size stays odd, as
+        // cv::GaussianBlur requires.
+
+        const double scale_steps[] = { 0.75, 1.0, 1.25 };
+        const int blur_steps[] = { -2, 0, 2 };
+
+        const double base_canny_lower = BallImageProc::kStrobedBallsCannyLower;
+        const double base_canny_upper = BallImageProc::kStrobedBallsCannyUpper;
+        const int base_blur_size = BallImageProc::kStrobedBallsPreHoughBlurSize;
+        const double base_starting_param2 = BallImageProc::kStrobedBallsStartingParam2;
+        const double base_param1 = BallImageProc::kStrobedBallsCurrentParam1;
+
+        std::vector<HoughParamCandidate> candidates;
+
+        for (double canny_scale : scale_steps) {
+            for (int blur_step : blur_steps) {
+                for (double param2_scale : scale_steps) {
+                    for (double param1_scale : scale_steps) {
+                        HoughParamCandidate candidate;
+                        candidate.canny_lower = base_canny_lower * canny_scale;
+                        candidate.canny_upper = base_canny_upper * canny_scale;
+                        candidate.pre_hough_blur_size = std::max(3, base_blur_size + blur_step);
+                        candidate.starting_param2 = base_starting_param2 * param2_scale;
+                        candidate.param1 = base_param1 * param1_scale;
+                        candidates.push_back(candidate);
+                    }
+                }
+            }
+        }
+
+        std::cout << "pitrac_tune - " << candidates.size() << " candidate(s), " << tests.size()
+            << " corpus case(s), " << num_workers << " worker(s) per candidate." << std::endl;
+
+        for (size_t i = 0; i < candidates.size(); i++) {
+            EvaluateCandidate(candidates[i], tests, tolerances, num_workers);
+
+            std::cout << "Candidate " << std::setw(3) << i << "/" << candidates.size() << ":  accuracy="
+                << std::fixed << std::setprecision(3) << candidates[i].accuracy
+                << "  mean_detection=" << std::setprecision(1) << candidates[i].mean_detection_ms << "ms  ("
+                << candidates[i].Format() << ")" << std::endl;
+        }
+
+        // Report the Pareto front and pick the winner - most accurate, and
+        // fastest among the equally-accurate
+
+        std::cout << "\nPareto-optimal candidates (accuracy vs. mean detection time):" << std::endl;
+
+        const HoughParamCandidate* best = nullptr;
+
+        for (const HoughParamCandidate& candidate : candidates) {
+            if (IsDominated(candidate, candidates)) {
+                continue;
+            }
+
+            std::cout << "    accuracy=" << std::fixed << std::setprecision(3) << candidate.accuracy
+                << "  mean_detection=" << std::setprecision(1) << candidate.mean_detection_ms << "ms  ("
+                << candidate.Format() << ")" << std::endl;
+
+            if (best == nullptr || candidate.accuracy > best->accuracy ||
+                (candidate.accuracy == best->accuracy && candidate.mean_detection_ms < best->mean_detection_ms)) {
+                best = &candidate;
+            }
+        }
+
+        if (best == nullptr || best->accuracy <= 0.0) {
+            std::cerr << "No candidate passed any corpus case - not writing a config fragment." << std::endl;
+            return 1;
+        }
+
+        if (!WriteConfigFragment(output_filename, *best)) {
+            return 1;
+        }
+
+        std::cout << "\npitrac_tune - wrote the best parameter set (accuracy="
+            << std::fixed << std::setprecision(3) << best->accuracy
+            << ", mean_detection=" << std::setprecision(1) << best->mean_detection_ms << "ms) to: "
+            << output_filename << std::endl;
+
+        return 0;
+    }
+    catch (std::exception const& e) {
+        std::cerr << "pitrac_tune ERROR: " << e.what() << std::endl;
+        return -1;
+    }
+}
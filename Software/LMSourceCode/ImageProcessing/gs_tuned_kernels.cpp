@@ -0,0 +1,238 @@
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+// The hand-written hot kernels, compiled once per CPU tuning target.  The
+// build compiles this translation unit twice (see the static_library targets
+// in meson.build), defining GS_TUNING_NAMESPACE to tuned_a72 for the
+// -mcpu=cortex-a72 (Pi 4) build and to tuned_a76 for the -mcpu=cortex-a76
+// (Pi 5) build.  GsCpuDispatch picks the right namespace at runtime, so a
+// single shipped binary gets scheduling tuned for whichever core it lands on.
+
+#if defined(__aarch64__)
+
+#ifndef GS_TUNING_NAMESPACE
+#error "gs_tuned_kernels.cpp must be compiled with -DGS_TUNING_NAMESPACE=<tuned_a72|tuned_a76>"
+#endif
+
+#include <arm_neon.h>
+
+#include <cmath>
+
+#include "gs_tuned_kernels.h"
+
+namespace golf_sim {
+
+    namespace GS_TUNING_NAMESPACE {
+
+        // NEON pixel-comparison kernel.  Processes 16 pixels per iteration, comparing the
+        // 8-bit target image against the "value" (second) channel of the 2-channel 32-bit
+        // candidate image.  Matching and examined pixels are accumulated branchlessly in
+        // vector lanes, so this replaces roughly six scalar operations per pixel with a
+        // handful of instructions per 16-pixel group.
+        cv::Vec2i CompareRotationImageNEON(const cv::Mat& img1, const cv::Mat& img2, uchar pixel_ignore_value) {
+
+            const uint8x16_t ignore_value = vdupq_n_u8(pixel_ignore_value);
+            const uint8x16_t ones = vdupq_n_u8(1);
+
+            long score = 0;
+            long totalPixelsExamined = 0;
+
+            for (int row = 0; row < img1.rows; row++) {
+                const uchar* p1_row = img1.ptr<uchar>(row);
+                const int* p2_row = img2.ptr<int>(row);     // Two interleaved int32 channels per pixel
+
+                // Each vpadalq_u8 below adds at most 2 to a 16-bit lane, so these row-local
+                // accumulators cannot overflow for any realistic ball-image width
+                uint16x8_t row_match_accum = vdupq_n_u16(0);
+                uint16x8_t row_examined_accum = vdupq_n_u16(0);
+
+                int col = 0;
+                for (; col + 16 <= img1.cols; col += 16) {
+                    uint8x16_t p1 = vld1q_u8(p1_row + col);
+
+                    // De-interleave four groups of four (z, value) pixel pairs and narrow the
+                    // 32-bit value channel down to 8 bits (the stored values are 0-255)
+                    int32x4x2_t q0 = vld2q_s32(p2_row + 2 * col);
+                    int32x4x2_t q1 = vld2q_s32(p2_row + 2 * col + 8);
+                    int32x4x2_t q2 = vld2q_s32(p2_row + 2 * col + 16);
+                    int32x4x2_t q3 = vld2q_s32(p2_row + 2 * col + 24);
+
+                    uint16x8_t low16 = vcombine_u16(vmovn_u32(vreinterpretq_u32_s32(q0.val[1])),
+                                                    vmovn_u32(vreinterpretq_u32_s32(q1.val[1])));
+                    uint16x8_t high16 = vcombine_u16(vmovn_u32(vreinterpretq_u32_s32(q2.val[1])),
+                                                     vmovn_u32(vreinterpretq_u32_s32(q3.val[1])));
+                    uint8x16_t p2 = vcombine_u8(vmovn_u16(low16), vmovn_u16(high16));
+
+                    // A pixel may only be examined if neither input holds the "ignore" value
+                    uint8x16_t valid = vandq_u8(vmvnq_u8(vceqq_u8(p1, ignore_value)),
+                                                vmvnq_u8(vceqq_u8(p2, ignore_value)));
+                    uint8x16_t match = vandq_u8(valid, vceqq_u8(p1, p2));
+
+                    // The comparison lanes are 0xFF, so mask them down to 1 before accumulating
+                    row_examined_accum = vpadalq_u8(row_examined_accum, vandq_u8(valid, ones));
+                    row_match_accum = vpadalq_u8(row_match_accum, vandq_u8(match, ones));
+                }
+
+                score += (long)vaddlvq_u16(row_match_accum);
+                totalPixelsExamined += (long)vaddlvq_u16(row_examined_accum);
+
+                // Scalar tail for any columns that did not fill a full 16-pixel vector
+                for (; col < img1.cols; col++) {
+                    uchar p1 = p1_row[col];
+                    uchar p2 = (uchar)p2_row[2 * col + 1];
+
+                    if (p1 != pixel_ignore_value && p2 != pixel_ignore_value) {
+                        totalPixelsExamined++;
+                        if (p1 == p2) {
+                            score++;
+                        }
+                    }
+                }
+            }
+
+            return cv::Vec2i((int)score, (int)totalPixelsExamined);
+        }
+
+        // Scales one de-interleaved 8-bit channel by a Q8.8 fixed-point weight with
+        // round-to-nearest, saturating back to 8 bits.
+        static inline uint8x16_t WeightChannelQ8(uint8x16_t channel, uint16_t weight_q8) {
+
+            uint16x8_t low16 = vmovl_u8(vget_low_u8(channel));
+            uint16x8_t high16 = vmovl_u8(vget_high_u8(channel));
+
+            uint16x4_t w0 = vrshrn_n_u32(vmull_n_u16(vget_low_u16(low16), weight_q8), 8);
+            uint16x4_t w1 = vrshrn_n_u32(vmull_n_u16(vget_high_u16(low16), weight_q8), 8);
+            uint16x4_t w2 = vrshrn_n_u32(vmull_n_u16(vget_low_u16(high16), weight_q8), 8);
+            uint16x4_t w3 = vrshrn_n_u32(vmull_n_u16(vget_high_u16(high16), weight_q8), 8);
+
+            return vcombine_u8(vqmovn_u16(vcombine_u16(w0, w1)), vqmovn_u16(vcombine_u16(w2, w3)));
+        }
+
+        // Fused weighted pre-image subtraction:
+        //     result = saturate(strobed - saturate(pre * weight))   per channel.
+        // Replaces the split / three per-channel multiplies / merge / subtract
+        // sequence (five full-frame passes plus temporaries) with one interleaved
+        // BGR pass.  The weights are applied in Q8.8 fixed point, so results can
+        // differ from the OpenCV reference path by at most one grey level.
+        // result_image must be pre-allocated to the same 8UC3 geometry; it may
+        // alias strobed_image (each pixel is read before it is written).
+        void WeightedPreImageSubtractNEON(const cv::Mat& strobed_image, const cv::Mat& pre_image,
+                                          float weight_blue, float weight_green, float weight_red,
+                                          cv::Mat& result_image) {
+
+            auto to_q8 = [](float weight) {
+                float scaled = weight * 256.0f + 0.5f;
+                if (scaled < 0.0f)
+                    scaled = 0.0f;
+                if (scaled > 65535.0f)
+                    scaled = 65535.0f;
+                return (uint16_t)scaled;
+            };
+
+            const uint16_t weight_b_q8 = to_q8(weight_blue);
+            const uint16_t weight_g_q8 = to_q8(weight_green);
+            const uint16_t weight_r_q8 = to_q8(weight_red);
+
+            const int pixels_per_row = strobed_image.cols;
+
+            for (int row = 0; row < strobed_image.rows; row++) {
+                const uchar* strobed_row = strobed_image.ptr<uchar>(row);
+                const uchar* pre_row = pre_image.ptr<uchar>(row);
+                uchar* result_row = result_image.ptr<uchar>(row);
+
+                int col = 0;
+                for (; col + 16 <= pixels_per_row; col += 16) {
+                    // De-interleave 16 BGR pixels from each input
+                    uint8x16x3_t strobed_pixels = vld3q_u8(strobed_row + 3 * col);
+                    uint8x16x3_t pre_pixels = vld3q_u8(pre_row + 3 * col);
+
+                    uint8x16x3_t result_pixels;
+                    result_pixels.val[0] = vqsubq_u8(strobed_pixels.val[0], WeightChannelQ8(pre_pixels.val[0], weight_b_q8));
+                    result_pixels.val[1] = vqsubq_u8(strobed_pixels.val[1], WeightChannelQ8(pre_pixels.val[1], weight_g_q8));
+                    result_pixels.val[2] = vqsubq_u8(strobed_pixels.val[2], WeightChannelQ8(pre_pixels.val[2], weight_r_q8));
+
+                    vst3q_u8(result_row + 3 * col, result_pixels);
+                }
+
+                // Scalar tail for any pixels that did not fill a full 16-pixel vector
+                for (; col < pixels_per_row; col++) {
+                    for (int channel = 0; channel < 3; channel++) {
+                        uint16_t weight_q8 = (channel == 0) ? weight_b_q8 : (channel == 1) ? weight_g_q8 : weight_r_q8;
+                        uint32_t weighted = ((uint32_t)pre_row[3 * col + channel] * weight_q8 + 128) >> 8;
+                        if (weighted > 255)
+                            weighted = 255;
+                        int difference = (int)strobed_row[3 * col + channel] - (int)weighted;
+                        result_row[3 * col + channel] = (uchar)(difference < 0 ? 0 : difference);
+                    }
+                }
+            }
+        }
+
+        // Per-pixel stage of the integral-image local contrast normalization:
+        //     result = saturate(128 + gain * (x - mean) / (sigma + 1))
+        // where mean and sigma come from the box-filtered local mean and
+        // mean-of-squares images computed by the caller.  The +1 sigma floor
+        // keeps flat regions from exploding into noise.  Eight pixels per
+        // iteration; the two f32 half-vectors ride the A72/A76 dual FP pipes.
+        // image and result_image are 8UC1, local_mean and local_mean_sq are
+        // 32FC1 of the same geometry; result_image must be pre-allocated and
+        // may alias image (each pixel is read before it is written).
+        void LocalContrastNormalizeNEON(const cv::Mat& image, const cv::Mat& local_mean,
+                                        const cv::Mat& local_mean_sq, float gain, cv::Mat& result_image) {
+
+            const float32x4_t gain_v = vdupq_n_f32(gain);
+            const float32x4_t midpoint = vdupq_n_f32(128.0f);
+            const float32x4_t sigma_floor = vdupq_n_f32(1.0f);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+
+            for (int row = 0; row < image.rows; row++) {
+                const uchar* image_row = image.ptr<uchar>(row);
+                const float* mean_row = local_mean.ptr<float>(row);
+                const float* mean_sq_row = local_mean_sq.ptr<float>(row);
+                uchar* result_row = result_image.ptr<uchar>(row);
+
+                int col = 0;
+                for (; col + 8 <= image.cols; col += 8) {
+                    uint16x8_t pixels16 = vmovl_u8(vld1_u8(image_row + col));
+
+                    float32x4_t x0 = vcvtq_f32_u32(vmovl_u16(vget_low_u16(pixels16)));
+                    float32x4_t x1 = vcvtq_f32_u32(vmovl_u16(vget_high_u16(pixels16)));
+
+                    float32x4_t mean0 = vld1q_f32(mean_row + col);
+                    float32x4_t mean1 = vld1q_f32(mean_row + col + 4);
+                    float32x4_t mean_sq0 = vld1q_f32(mean_sq_row + col);
+                    float32x4_t mean_sq1 = vld1q_f32(mean_sq_row + col + 4);
+
+                    // variance = E[x^2] - E[x]^2, clamped - rounding can push it a hair negative
+                    float32x4_t var0 = vmaxq_f32(vsubq_f32(mean_sq0, vmulq_f32(mean0, mean0)), zero);
+                    float32x4_t var1 = vmaxq_f32(vsubq_f32(mean_sq1, vmulq_f32(mean1, mean1)), zero);
+                    float32x4_t sigma0 = vaddq_f32(vsqrtq_f32(var0), sigma_floor);
+                    float32x4_t sigma1 = vaddq_f32(vsqrtq_f32(var1), sigma_floor);
+
+                    float32x4_t out0 = vaddq_f32(midpoint, vdivq_f32(vmulq_f32(gain_v, vsubq_f32(x0, mean0)), sigma0));
+                    float32x4_t out1 = vaddq_f32(midpoint, vdivq_f32(vmulq_f32(gain_v, vsubq_f32(x1, mean1)), sigma1));
+
+                    // Round to nearest, then saturate down through u16 to u8
+                    uint16x4_t narrow0 = vqmovun_s32(vcvtnq_s32_f32(out0));
+                    uint16x4_t narrow1 = vqmovun_s32(vcvtnq_s32_f32(out1));
+                    vst1_u8(result_row + col, vqmovn_u16(vcombine_u16(narrow0, narrow1)));
+                }
+
+                // Scalar tail for any columns that did not fill a full 8-pixel vector
+                for (; col < image.cols; col++) {
+                    float mean = mean_row[col];
+                    float variance = mean_sq_row[col] - mean * mean;
+                    float sigma = std::sqrt(variance < 0.0f ? 0.0f : variance) + 1.0f;
+                    float value = 128.0f + gain * ((float)image_row[col] - mean) / sigma;
+                    result_row[col] = (uchar)(value < 0.0f ? 0 : (value > 255.0f ? 255 : (int)(value + 0.5f)));
+                }
+            }
+        }
+
+    }
+
+}
+
+#endif  // __aarch64__
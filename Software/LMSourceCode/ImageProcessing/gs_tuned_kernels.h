@@ -0,0 +1,49 @@
+/*****************************************************************//**
+ * \file   gs_tuned_kernels.h
+ * \brief  Entry points for the per-CPU-tuned builds of the hot kernels.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#if defined(__aarch64__)
+
+namespace golf_sim {
+
+    // gs_tuned_kernels.cpp is compiled twice by the build (see the
+    // static_library targets in meson.build) - once with -mcpu=cortex-a72 for
+    // the Pi 4 fleet and once with -mcpu=cortex-a76 for the Pi 5 - with
+    // GS_TUNING_NAMESPACE selecting which of these namespaces each build
+    // populates.  Call sites pick a variant at runtime via
+    // GsCpuDispatch::GetTuningTarget().
+
+    namespace tuned_a72 {
+        cv::Vec2i CompareRotationImageNEON(const cv::Mat& img1, const cv::Mat& img2, uchar pixel_ignore_value);
+        void WeightedPreImageSubtractNEON(const cv::Mat& strobed_image, const cv::Mat& pre_image,
+                                          float weight_blue, float weight_green, float weight_red,
+                                          cv::Mat& result_image);
+        void LocalContrastNormalizeNEON(const cv::Mat& image, const cv::Mat& local_mean,
+                                        const cv::Mat& local_mean_sq, float gain, cv::Mat& result_image);
+    }
+
+    namespace tuned_a76 {
+        cv::Vec2i CompareRotationImageNEON(const cv::Mat& img1, const cv::Mat& img2, uchar pixel_ignore_value);
+        void WeightedPreImageSubtractNEON(const cv::Mat& strobed_image, const cv::Mat& pre_image,
+                                          float weight_blue, float weight_green, float weight_red,
+                                          cv::Mat& result_image);
+        void LocalContrastNormalizeNEON(const cv::Mat& image, const cv::Mat& local_mean,
+                                        const cv::Mat& local_mean_sq, float gain, cv::Mat& result_image);
+    }
+
+}
+
+#endif  // __aarch64__
@@ -6,6 +6,15 @@
 
 #ifdef __unix__  // Ignore in Windows environment
 
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <unistd.h>
+
 #include "logging_tools.h"
 
 #include "gs_ipc_result.h"
@@ -14,6 +23,11 @@
 #include "gs_ui_system.h"
 #include "gs_sim_interface.h"
 #include "gs_camera.h"
+#include "gs_hw_jpeg_encoder.h"
+#include "gs_clock_sync.h"
+#include "gs_thermal_governor.h"
+#include "gs_perf_counters.h"
+#include "gs_shot_telemetry.h"
 
 namespace golf_sim {
 
@@ -24,6 +38,273 @@ namespace golf_sim {
     std::string GsUISystem::kWebServerResultBallRotatedByBestAngles;
     std::string GsUISystem::kWebServerErrorExposuresImage;
     std::string GsUISystem::kWebServerBallSearchAreaImage;
+    std::string GsUISystem::kWebServerShotSummaryFile = "gs_fsm_shot_summary.txt";
+    bool GsUISystem::kWebServerUseJpegImages = false;
+    int GsUISystem::kWebServerJpegQuality = 85;
+    int GsUISystem::kWebServerImageMaxWidth = 0;
+    bool GsUISystem::kWebServerUseOverlayMetadata = false;
+    bool GsUISystem::kWebServerUseAtomicImagePublish = false;
+    std::string GsUISystem::kWebServerImageStagingDirectory = "/dev/shm/pitrac_webserver_staging/";
+    int GsUISystem::kWebServerImageCacheMaxMb = 64;
+    int GsUISystem::kStatusMessageCoalesceWindowMs = 250;
+    double GsUISystem::kStatusMessageRateLimitPerSec = 10.0;
+    int GsUISystem::kStatusMessageRateLimitBurst = 5;
+
+    namespace {
+
+        // Coalescing and token-bucket state for SendIPCStatusMessage.  The FSM
+        // thread is the usual caller, but the mutex keeps the bookkeeping safe
+        // if a status message is ever sent from elsewhere.
+        std::mutex status_throttle_mutex;
+        GsIPCResultType last_status_type = GsIPCResultType::kUnknown;
+        std::string last_status_custom_message;
+        std::chrono::steady_clock::time_point last_status_time;
+        std::chrono::steady_clock::time_point last_token_refill_time;
+        double status_tokens = 0.0;
+        bool status_throttle_initialized = false;
+
+        // Hit, calibration and ball-placed messages drive the simulator
+        // hand-off and must never be coalesced or dropped.
+        bool IsShotCriticalStatusType(GsIPCResultType message_type) {
+            return message_type == GsIPCResultType::kHit ||
+                   message_type == GsIPCResultType::kCalibrationResults ||
+                   message_type == GsIPCResultType::kBallPlacedAndReadyForHit;
+        }
+
+        // Returns true if the status message should go out on the wire, and
+        // updates the coalescing/token-bucket state accordingly.
+        bool StatusMessageMayBeSent(GsIPCResultType message_type, const std::string& custom_message) {
+
+            if (IsShotCriticalStatusType(message_type)) {
+                return true;
+            }
+
+            std::lock_guard<std::mutex> lock(status_throttle_mutex);
+
+            auto now = std::chrono::steady_clock::now();
+
+            if (!status_throttle_initialized) {
+                status_tokens = (double)GsUISystem::kStatusMessageRateLimitBurst;
+                last_token_refill_time = now;
+                status_throttle_initialized = true;
+            }
+
+            // Coalesce - an identical status repeated within the window adds
+            // no information for the GUI, so merge it into the earlier send
+            if (GsUISystem::kStatusMessageCoalesceWindowMs > 0 &&
+                message_type == last_status_type &&
+                custom_message == last_status_custom_message &&
+                now - last_status_time < std::chrono::milliseconds(GsUISystem::kStatusMessageCoalesceWindowMs)) {
+                return false;
+            }
+
+            // Token bucket - bounds the overall status traffic even when the
+            // types keep changing
+            if (GsUISystem::kStatusMessageRateLimitPerSec > 0.0) {
+                std::chrono::duration<double> elapsed = now - last_token_refill_time;
+                status_tokens += elapsed.count() * GsUISystem::kStatusMessageRateLimitPerSec;
+                if (status_tokens > (double)GsUISystem::kStatusMessageRateLimitBurst) {
+                    status_tokens = (double)GsUISystem::kStatusMessageRateLimitBurst;
+                }
+                last_token_refill_time = now;
+
+                if (status_tokens < 1.0) {
+                    GS_LOG_TRACE_MSG(trace, "SendIPCStatusMessage - rate limit reached, dropping status type " + std::to_string((int)message_type));
+                    return false;
+                }
+
+                status_tokens -= 1.0;
+            }
+
+            last_status_type = message_type;
+            last_status_custom_message = custom_message;
+            last_status_time = now;
+
+            return true;
+        }
+
+        // Returns the path a webserver file should actually be written to.
+        // With atomic publishing enabled that is the (tmpfs) staging
+        // directory, created on first use; the caller must then hand the
+        // file to PublishStagedFile.  Otherwise it is just the final path,
+        // written in place as before.
+        std::string StagingPathFor(const std::string& final_path) {
+
+            if (!GsUISystem::kWebServerUseAtomicImagePublish ||
+                GsUISystem::kWebServerImageStagingDirectory.empty()) {
+                return final_path;
+            }
+
+            std::filesystem::path staging_dir(GsUISystem::kWebServerImageStagingDirectory);
+
+            std::error_code ec;
+            std::filesystem::create_directories(staging_dir, ec);
+
+            if (ec) {
+                GS_LOG_MSG(warning, "GsUISystem - could not create staging directory " +
+                    staging_dir.string() + " (" + ec.message() + ") - writing in place.");
+                return final_path;
+            }
+
+            return (staging_dir / std::filesystem::path(final_path).filename()).string();
+        }
+
+        // Moves a staged file to its published name.  A same-filesystem
+        // rename is atomic; across filesystems (tmpfs staging to SD share)
+        // the file is copied to a hidden dot-named temp file beside the
+        // destination and that is renamed, so readers still only ever see
+        // the old file or the complete new one.  No-op when the file was
+        // written in place.
+        bool PublishStagedFile(const std::string& staged_path, const std::string& final_path) {
+
+            if (staged_path == final_path) {
+                return true;
+            }
+
+            std::error_code ec;
+            std::filesystem::rename(staged_path, final_path, ec);
+
+            if (!ec) {
+                return true;
+            }
+
+            // Different filesystems - copy next to the destination first
+            std::filesystem::path final_fs_path(final_path);
+            std::filesystem::path temp_path = final_fs_path.parent_path() /
+                ("." + final_fs_path.filename().string() + ".tmp." + std::to_string(getpid()));
+
+            std::filesystem::copy_file(staged_path, temp_path,
+                std::filesystem::copy_options::overwrite_existing, ec);
+
+            if (!ec) {
+                std::filesystem::rename(temp_path, final_path, ec);
+            }
+
+            std::error_code cleanup_ec;
+            std::filesystem::remove(staged_path, cleanup_ec);
+
+            if (ec) {
+                GS_LOG_MSG(warning, "GsUISystem - could not publish " + final_path + " (" + ec.message() + ").");
+                std::filesystem::remove(temp_path, cleanup_ec);
+                return false;
+            }
+
+            return true;
+        }
+
+        // Deletes the oldest published images (and sidecars) until the share
+        // directory is back under kWebServerImageCacheMaxMb.  Hidden files
+        // (in-flight publishes) are left alone.
+        void EnforceImageCacheLimit() {
+
+            if (GsUISystem::kWebServerShareDirectory.empty() ||
+                GsUISystem::kWebServerImageCacheMaxMb <= 0) {
+                return;
+            }
+
+            struct CachedFile {
+                std::filesystem::path path;
+                std::filesystem::file_time_type last_write;
+                uintmax_t size;
+            };
+
+            std::vector<CachedFile> files;
+            uintmax_t total_bytes = 0;
+
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(GsUISystem::kWebServerShareDirectory, ec)) {
+
+                if (!entry.is_regular_file(ec)) {
+                    continue;
+                }
+
+                std::string name = entry.path().filename().string();
+
+                if (name.empty() || name[0] == '.') {
+                    continue;
+                }
+
+                if (name.find(".png") == std::string::npos &&
+                    name.find(".jpg") == std::string::npos &&
+                    name.find(".overlay.json") == std::string::npos) {
+                    continue;
+                }
+
+                CachedFile file{ entry.path(), entry.last_write_time(ec), entry.file_size(ec) };
+                total_bytes += file.size;
+                files.push_back(file);
+            }
+
+            uintmax_t limit_bytes = (uintmax_t)GsUISystem::kWebServerImageCacheMaxMb * 1024 * 1024;
+
+            if (total_bytes <= limit_bytes) {
+                return;
+            }
+
+            std::sort(files.begin(), files.end(),
+                [](const CachedFile& a, const CachedFile& b) { return a.last_write < b.last_write; });
+
+            for (const CachedFile& file : files) {
+
+                if (total_bytes <= limit_bytes) {
+                    break;
+                }
+
+                if (std::filesystem::remove(file.path, ec)) {
+                    GS_LOG_TRACE_MSG(trace, "GsUISystem - evicted " + file.path.string() + " from the webserver image cache.");
+                    total_bytes -= file.size;
+                }
+            }
+        }
+
+        // Writes the "<image>.overlay.json" sidecar describing the ball
+        // annotations for an image, for the GUI to render client-side.
+        // The coordinates are in the original image's pixels - the
+        // image_width/height fields let the GUI rescale the overlay to
+        // whatever size it actually displays the image at.
+        bool WriteBallOverlayMetadata(const std::string& image_file_name,
+                                      const cv::Mat& img,
+                                      const std::vector<GolfBall>& balls) {
+
+            if (GsUISystem::kWebServerShareDirectory.empty()) {
+                return false;
+            }
+
+            // The kWebServerShareDirectory is already setup to have a trailing "/"
+            std::string fname = GsUISystem::kWebServerShareDirectory + image_file_name + ".overlay.json";
+            std::string staged_fname = StagingPathFor(fname);
+
+            std::ofstream overlay_file(staged_fname, std::ios::trunc);
+
+            if (!overlay_file) {
+                GS_LOG_MSG(warning, "WriteBallOverlayMetadata - could not write to file name: " + staged_fname);
+                return false;
+            }
+
+            overlay_file << "{\n";
+            overlay_file << "    \"image\": \"" << image_file_name << "\",\n";
+            overlay_file << "    \"image_width\": " << img.cols << ",\n";
+            overlay_file << "    \"image_height\": " << img.rows << ",\n";
+            overlay_file << "    \"balls\": [";
+
+            for (size_t i = 0; i < balls.size(); i++) {
+                const GsCircle& c = balls[i].ball_circle_;
+
+                overlay_file << (i == 0 ? "\n" : ",\n");
+                overlay_file << "        { \"index\": " << i
+                    << ", \"x\": " << c[0]
+                    << ", \"y\": " << c[1]
+                    << ", \"radius\": " << c[2]
+                    << ", \"quality_ranking\": " << balls[i].quality_ranking << " }";
+            }
+
+            overlay_file << "\n    ]\n}\n";
+            overlay_file.close();
+
+            return PublishStagedFile(staged_fname, fname);
+        }
+
+    }
 
 
     void GsUISystem::SendIPCErrorStatusMessage(const std::string& error_message) {
@@ -53,6 +334,12 @@ namespace golf_sim {
 
     bool GsUISystem::SendIPCStatusMessage(const GsIPCResultType message_type, const std::string& custom_message) {
 
+        // The message was coalesced into (or rate-limited behind) an earlier,
+        // equivalent send - nothing more to do
+        if (!StatusMessageMayBeSent(message_type, custom_message)) {
+            return true;
+        }
+
         GolfSimIPCMessage ipc_message(GolfSimIPCMessage::IPCMessageType::kResults);
         GsIPCResult& results = ipc_message.GetResultsForModification();
         results.club_type_ = GolfSimClubs::GetCurrentClubType();
@@ -109,6 +396,14 @@ namespace golf_sim {
             results.message_ = custom_message;
         }
 
+        // When the cross-Pi clock sync is running, its health (offset,
+        // drift, round-trip) rides along so a broken exchange is visible
+        // from the GUI
+        results.message_ += GsClockSync::StatusSuffix();
+
+        // Likewise the SoC temperature and any thermal shedding level
+        results.message_ += GsThermalGovernor::StatusSuffix();
+
         GS_LOG_TRACE_MSG(trace, "FSM is sending an IPC Results Message: " + results.Format());
 
         GolfSimIpcSystem::SendIpcMessage(ipc_message);
@@ -133,9 +428,22 @@ namespace golf_sim {
 
 
         results.image_file_paths_.clear();
-        
-        results.image_file_paths_.push_back(kWebServerResultBallExposureCandidates + ".png");  // Shows ball trajectory
-        results.image_file_paths_.push_back(kWebServerResultBallRotatedByBestAngles + ".png");  // Rotation analysis result
+
+        results.image_file_paths_.push_back(kWebServerResultBallExposureCandidates + WebImageExtension());  // Shows ball trajectory
+        results.image_file_paths_.push_back(kWebServerResultBallRotatedByBestAngles + WebImageExtension());  // Rotation analysis result
+
+        // If the per-stage hardware performance counters are enabled, ride the
+        // shot's counter summary along to the GUI with the other log messages
+        std::string perf_counter_summary = GsPerfCounters::FormatShotCounters();
+        if (!perf_counter_summary.empty()) {
+            results.log_messages_.push_back(perf_counter_summary);
+        }
+
+        // Likewise for the per-shot memory deltas
+        std::string shot_telemetry_summary = GsShotTelemetry::FormatShotTelemetry();
+        if (!shot_telemetry_summary.empty()) {
+            results.log_messages_.push_back(shot_telemetry_summary);
+        }
 
         GS_LOG_MSG(info, "BALL_HIT_CSV, " + std::to_string(GsSimInterface::GetShotCounter()) + ", (carry - NA), (Total - NA), (Side Dest - NA), (Smash Factor - NA), (Club Speed - NA), "
             + std::to_string(CvUtils::MetersPerSecondToMPH(results.speed_mpers_)) + ", "
@@ -150,6 +458,34 @@ namespace golf_sim {
     }
 
 
+    void GsUISystem::SendFsmShotSummary(const std::string& summary_text) {
+
+        // The info-level log also lands in the recent-messages buffer that
+        // rides along on IPC results messages.
+        GS_LOG_MSG(info, summary_text);
+
+        if (kWebServerShareDirectory.empty()) {
+            return;
+        }
+
+        // The kWebServerShareDirectory is already setup to have a trailing "/"
+        std::string fname = kWebServerShareDirectory + kWebServerShotSummaryFile;
+        std::string staged_fname = StagingPathFor(fname);
+
+        std::ofstream summary_file(staged_fname, std::ios::trunc);
+
+        if (!summary_file) {
+            GS_LOG_MSG(warning, "GsUISystem::SendFsmShotSummary - could not write to file name: " + staged_fname);
+            return;
+        }
+
+        summary_file << summary_text << std::endl;
+        summary_file.close();
+
+        PublishStagedFile(staged_fname, fname);
+    }
+
+
     bool GsUISystem::SaveWebserverImage(const std::string& input_file_name,
                                         const cv::Mat& img,
                                         bool suppress_diagnostic_saving) {
@@ -176,24 +512,53 @@ namespace golf_sim {
             return true;
         }
 
-        if (file_name.find(".png") == std::string::npos) {
-            file_name += ".png";
+        if (file_name.find(".png") == std::string::npos &&
+            file_name.find(".jpg") == std::string::npos) {
+            file_name += WebImageExtension();
         }
 
 
         // The kWebServerShareDirectory is already setup to have a trailing "/"
         std::string fname = kWebServerShareDirectory + file_name;
 
+        // With atomic publishing, the encode below lands in the (tmpfs)
+        // staging file and only the completed file is renamed into the share
+        std::string staged_fname = StagingPathFor(fname);
+
+        // The GUI only ever shows these images scaled down, so (if configured)
+        // shrink them before paying for the encode of the full frame
+        cv::Mat img_to_write = img;
+
+        if (kWebServerImageMaxWidth > 0 && img.cols > kWebServerImageMaxWidth) {
+            double scale = (double)kWebServerImageMaxWidth / (double)img.cols;
+            cv::resize(img, img_to_write, cv::Size(), scale, scale, cv::INTER_AREA);
+        }
+
+        std::vector<int> write_params;
+
+        if (fname.find(".jpg") != std::string::npos) {
+
+            // Try the hardware codec first - the software fallback below costs
+            // hundreds of milliseconds for a full frame
+            if (GsHwJpegEncoder::EncodeToFile(img_to_write, staged_fname, kWebServerJpegQuality)) {
+                GS_LOG_TRACE_MSG(trace, "Logged image (hardware JPEG) to file: " + fname);
+                return PublishStagedFile(staged_fname, fname);
+            }
+
+            write_params = { cv::IMWRITE_JPEG_QUALITY, kWebServerJpegQuality };
+        }
+
         try {
-            if (cv::imwrite(fname, img)) {
+            if (cv::imwrite(staged_fname, img_to_write, write_params)) {
                 GS_LOG_TRACE_MSG(trace, "Logged image to file: " + fname);
+                PublishStagedFile(staged_fname, fname);
             }
             else {
-                GS_LOG_MSG(warning, "GsUISystem::SaveWebserverImage - could not save to file name: " + fname);
+                GS_LOG_MSG(warning, "GsUISystem::SaveWebserverImage - could not save to file name: " + staged_fname);
             }
         }
         catch (std::exception& ex) {
-            GS_LOG_TRACE_MSG(warning, "Exception! - failed to imwrite with fname = " + fname);
+            GS_LOG_TRACE_MSG(warning, "Exception! - failed to imwrite with fname = " + staged_fname);
         }
 
         return true;
@@ -209,6 +574,23 @@ namespace golf_sim {
             return true;
         }
 
+        if (kWebServerUseOverlayMetadata) {
+
+            // Figure out the final image file name so that the sidecar name
+            // matches it (the other overload appends the extension the same way)
+            std::string image_file_name(file_name);
+            if (image_file_name.find(".png") == std::string::npos &&
+                image_file_name.find(".jpg") == std::string::npos) {
+                image_file_name += WebImageExtension();
+            }
+
+            WriteBallOverlayMetadata(image_file_name, img, balls);
+
+            // Publish the clean image once - no clone and no rasterized
+            // circles.  The GUI draws the overlay client-side.
+            return SaveWebserverImage(file_name, img, suppress_diagnostic_saving);
+        }
+
         cv::Mat ball_image = img.clone();
 
         // Show the final candidates for 
@@ -223,9 +605,23 @@ namespace golf_sim {
         return SaveWebserverImage(file_name, ball_image, suppress_diagnostic_saving);
     }
 
+    std::string GsUISystem::WebImageExtension() {
+        return kWebServerUseJpegImages ? ".jpg" : ".png";
+    }
+
     void GsUISystem::ClearWebserverImages() {
+
+        if (kWebServerUseAtomicImagePublish) {
+            // Size-bounded eviction instead of wiping the share - the GUI
+            // keeps recent shots and the SD card is spared a full rewrite
+            // of the share directory on every shot
+            EnforceImageCacheLimit();
+            return;
+        }
+
         // The kWebServerShareDirectory is already setup to have a trailing "/"
-        std::string command = "rm -f " + kWebServerShareDirectory + "*.png";
+        std::string command = "rm -f " + kWebServerShareDirectory + "*.png " + kWebServerShareDirectory + "*.jpg " +
+            kWebServerShareDirectory + "*.overlay.json";
 
         int cmdResult = system(command.c_str());
 
@@ -31,7 +31,65 @@ namespace golf_sim {
         static std::string kWebServerResultBallRotatedByBestAngles;
         static std::string kWebServerErrorExposuresImage;
         static std::string kWebServerBallSearchAreaImage;
-        
+        static std::string kWebServerShotSummaryFile;
+
+        // When true, webserver images are written as .jpg instead of .png.
+        // The jpeg encode (libjpeg-turbo, SIMD) is several times cheaper than
+        // the .png deflate for the large result images published per shot.
+        static bool kWebServerUseJpegImages;
+        static int kWebServerJpegQuality;
+
+        // If non-zero, webserver images wider than this are downscaled to
+        // this width before being written.  The GUI displays them scaled
+        // down anyway, so there is no reason to encode and ship full
+        // 1456-wide frames.  0 leaves the images at full resolution.
+        static int kWebServerImageMaxWidth;
+
+        // When true, the balls overload of SaveWebserverImage publishes the
+        // clean image untouched plus a small "<image>.overlay.json" sidecar
+        // holding the ball centers, radii and quality rankings (in the
+        // original image's pixel coordinates), and the GUI draws the circles
+        // and labels client-side.  That avoids a full-frame clone and
+        // rasterization per annotated view here, and one clean image can
+        // serve any number of annotated views.  When false, the circles are
+        // drawn into a copy of the image on this side, as before.
+        static bool kWebServerUseOverlayMetadata;
+
+        // When true, webserver images (and their .overlay.json sidecars) are
+        // first written to kWebServerImageStagingDirectory - expected to be
+        // tmpfs, e.g. under /dev/shm - and then moved into the share with a
+        // rename.  The rename is atomic, so the web server can never read a
+        // half-written file, and the encoder output lands in RAM instead of
+        // stalling the shot path on the SD card.  If the staging directory
+        // is on a different filesystem than the share (the usual case), the
+        // move copies to a hidden temp file beside the destination and
+        // renames that, which is still atomic at the published name.
+        static bool kWebServerUseAtomicImagePublish;
+        static std::string kWebServerImageStagingDirectory;
+
+        // When atomic publishing is enabled, the per-shot bulk delete of the
+        // share directory is replaced by size-bounded eviction:  the oldest
+        // published images are removed only once the share holds more than
+        // this many megabytes.  Recent shots stay browsable in the GUI and
+        // the SD card stops absorbing a full rewrite of the share per shot.
+        static int kWebServerImageCacheMaxMb;
+
+        // Repeated status messages of the same type (and text) within this
+        // window are coalesced into the first one.  The FSM's tight watch
+        // loops can otherwise emit identical status updates in bursts that
+        // contend with the camera-2 image transfer for broker bandwidth.
+        // 0 disables coalescing.
+        static int kStatusMessageCoalesceWindowMs;
+
+        // Token-bucket rate limit on outgoing status messages.  Refills at
+        // kStatusMessageRateLimitPerSec up to a burst of
+        // kStatusMessageRateLimitBurst; status messages arriving with the
+        // bucket empty are dropped.  Shot-critical messages (hit and
+        // calibration results, ball-placed) bypass both the coalescing and
+        // the rate limit.  A rate of 0 disables the limit.
+        static double kStatusMessageRateLimitPerSec;
+        static int kStatusMessageRateLimitBurst;
+
 
         static void SendIPCErrorStatusMessage(const std::string& error_message);
 
@@ -39,6 +97,10 @@ namespace golf_sim {
 
         static void SendIPCHitMessage(const GolfBall& result_ball, const std::string& secondary_message = "");
 
+        // Logs the per-shot FSM timing summary and writes it into the shared
+        // web-server directory so that the GUI can display it.
+        static void SendFsmShotSummary(const std::string& summary_text);
+
         // Save the image into the shared web-server directory so that the web-based 
         // golf-sim user interface can access it.  
         // Also save a uniquely-named copy to the usual images directory unless suppressed.
@@ -46,7 +108,16 @@ namespace golf_sim {
         static bool SaveWebserverImage(const std::string& file_name, const cv::Mat& img, bool suppress_diagnostic_saving = false);
         static bool SaveWebserverImage(const std::string& file_name, const cv::Mat& img, const std::vector<GolfBall>& balls, bool suppress_diagnostic_saving = false);
 
+        // Removes stale images from the share directory between shots.  With
+        // atomic publishing enabled this evicts oldest-first down to the
+        // kWebServerImageCacheMaxMb bound; otherwise it is the original
+        // sweep of every image in the share.
         static void ClearWebserverImages();
+
+        // ".jpg" or ".png" depending on kWebServerUseJpegImages.  Used both
+        // when writing the images and when building the file paths sent to
+        // the GUI, so the two always agree.
+        static std::string WebImageExtension();
     };
 
 }
@@ -0,0 +1,246 @@
+/*****************************************************************//**
+ * \file   gs_warm_restart.cpp
+ * \brief  Derived-state snapshot adopted across clean restarts.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include "gs_warm_restart.h"
+
+#include "logging_tools.h"
+#include "gs_config.h"
+#include "gs_camera.h"
+
+namespace golf_sim {
+
+    bool GsWarmRestart::kEnableWarmRestartSnapshot = false;
+    std::string GsWarmRestart::kWarmRestartSnapshotFile = "/var/cache/pitrac/pitrac_warm_restart.bin";
+
+    namespace {
+
+        // Bump whenever the file layout or the meaning of a section changes.
+        // An old-format snapshot is then simply ignored.
+        const uint32_t kSnapshotFormatVersion = 1;
+        const char kSnapshotMagic[4] = { 'P', 'T', 'W', 'R' };
+
+        std::mutex snapshot_mutex;
+        std::map<std::string, std::string> adopted_sections;
+        std::map<std::string, std::string> recorded_sections;
+
+        // The inputs the recorded sections were derived from.  If any of
+        // them change between runs, every section is considered stale.
+        std::string SnapshotFingerprint() {
+
+            std::string config_file = GolfSimConfiguration::GetConfigurationFilename();
+
+            uintmax_t config_size = 0;
+            int64_t config_mtime = 0;
+
+            std::error_code ec;
+            config_size = std::filesystem::file_size(config_file, ec);
+            auto mtime = std::filesystem::last_write_time(config_file, ec);
+            if (!ec) {
+                config_mtime = (int64_t)mtime.time_since_epoch().count();
+            }
+
+            return config_file + "|" + std::to_string(config_size) +
+                "|" + std::to_string(config_mtime) +
+                "|" + std::to_string((int)GolfSimCamera::kSystemSlot1CameraType) +
+                "|" + std::to_string((int)GolfSimCamera::kSystemSlot2CameraType);
+        }
+
+        bool ReadExact(std::ifstream& file, char* data, std::streamsize bytes) {
+            file.read(data, bytes);
+            return file.gcount() == bytes;
+        }
+
+        bool ReadUint32(std::ifstream& file, uint32_t& value) {
+            return ReadExact(file, reinterpret_cast<char*>(&value), sizeof(value));
+        }
+
+        bool ReadString(std::ifstream& file, std::string& value) {
+            uint32_t length = 0;
+            if (!ReadUint32(file, length)) {
+                return false;
+            }
+            // A corrupt length shouldn't make us try to allocate gigabytes
+            if (length > (64u << 20)) {
+                return false;
+            }
+            value.resize(length);
+            return length == 0 || ReadExact(file, &value[0], (std::streamsize)length);
+        }
+
+        void WriteUint32(std::ofstream& file, uint32_t value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void WriteString(std::ofstream& file, const std::string& value) {
+            WriteUint32(file, (uint32_t)value.size());
+            file.write(value.data(), (std::streamsize)value.size());
+        }
+
+    }  // namespace
+
+
+    void GsWarmRestart::Initialize() {
+
+        GolfSimConfiguration::SetConstant("gs_config.modes.kEnableWarmRestartSnapshot", kEnableWarmRestartSnapshot);
+        GolfSimConfiguration::SetConstant("gs_config.modes.kWarmRestartSnapshotFile", kWarmRestartSnapshotFile);
+
+        if (!kEnableWarmRestartSnapshot) {
+            return;
+        }
+
+        std::ifstream file(kWarmRestartSnapshotFile, std::ios::binary);
+        if (!file) {
+            GS_LOG_TRACE_MSG(trace, "GsWarmRestart - no snapshot at " + kWarmRestartSnapshotFile +
+                ". Cold start.");
+            return;
+        }
+
+        char magic[4] = {};
+        uint32_t version = 0;
+        std::string fingerprint;
+
+        if (!ReadExact(file, magic, sizeof(magic)) ||
+            std::memcmp(magic, kSnapshotMagic, sizeof(magic)) != 0 ||
+            !ReadUint32(file, version) ||
+            version != kSnapshotFormatVersion ||
+            !ReadString(file, fingerprint)) {
+            GS_LOG_MSG(info, "GsWarmRestart - snapshot is unreadable or an old format. Cold start.");
+            return;
+        }
+
+        if (fingerprint != SnapshotFingerprint()) {
+            GS_LOG_MSG(info, "GsWarmRestart - configuration or cameras changed since the snapshot "
+                "was written. Re-deriving everything.");
+            return;
+        }
+
+        uint32_t section_count = 0;
+        if (!ReadUint32(file, section_count)) {
+            return;
+        }
+
+        std::map<std::string, std::string> sections;
+        for (uint32_t i = 0; i < section_count; i++) {
+            std::string name;
+            std::string blob;
+            if (!ReadString(file, name) || !ReadString(file, blob)) {
+                GS_LOG_MSG(warning, "GsWarmRestart - snapshot truncated. Ignoring it.");
+                return;
+            }
+            sections[name] = blob;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(snapshot_mutex);
+            adopted_sections = std::move(sections);
+        }
+
+        GS_LOG_MSG(info, "GsWarmRestart - adopted " + std::to_string(section_count) +
+            " snapshot section(s) from " + kWarmRestartSnapshotFile);
+    }
+
+    bool GsWarmRestart::AdoptedBlob(const std::string& section_name, std::string& blob) {
+
+        if (!kEnableWarmRestartSnapshot) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+
+        auto it = adopted_sections.find(section_name);
+        if (it == adopted_sections.end()) {
+            return false;
+        }
+
+        blob = it->second;
+        return true;
+    }
+
+    void GsWarmRestart::RecordBlob(const std::string& section_name, const std::string& blob) {
+
+        if (!kEnableWarmRestartSnapshot) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(snapshot_mutex);
+        recorded_sections[section_name] = blob;
+    }
+
+    bool GsWarmRestart::SaveSnapshot() {
+
+        if (!kEnableWarmRestartSnapshot) {
+            return true;
+        }
+
+        // Re-recorded sections win; adopted-but-untouched sections are
+        // carried forward so they survive runs that never consulted them
+        std::map<std::string, std::string> sections;
+        {
+            std::lock_guard<std::mutex> lock(snapshot_mutex);
+            sections = adopted_sections;
+            for (const auto& recorded : recorded_sections) {
+                sections[recorded.first] = recorded.second;
+            }
+        }
+
+        const std::string temp_file = kWarmRestartSnapshotFile + ".tmp";
+
+        try {
+            std::filesystem::path parent = std::filesystem::path(kWarmRestartSnapshotFile).parent_path();
+            if (!parent.empty()) {
+                std::filesystem::create_directories(parent);
+            }
+
+            std::ofstream file(temp_file, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                GS_LOG_MSG(warning, "GsWarmRestart - could not write snapshot to " + temp_file);
+                return false;
+            }
+
+            file.write(kSnapshotMagic, sizeof(kSnapshotMagic));
+            WriteUint32(file, kSnapshotFormatVersion);
+            WriteString(file, SnapshotFingerprint());
+            WriteUint32(file, (uint32_t)sections.size());
+
+            for (const auto& section : sections) {
+                WriteString(file, section.first);
+                WriteString(file, section.second);
+            }
+
+            file.close();
+            if (!file) {
+                GS_LOG_MSG(warning, "GsWarmRestart - snapshot write to " + temp_file + " failed.");
+                return false;
+            }
+
+            // Rename so the next start never sees a half-written snapshot
+            std::filesystem::rename(temp_file, kWarmRestartSnapshotFile);
+        }
+        catch (const std::exception& e) {
+            GS_LOG_MSG(warning, "GsWarmRestart - could not save snapshot: " + std::string(e.what()));
+            return false;
+        }
+
+        GS_LOG_TRACE_MSG(trace, "GsWarmRestart - saved " + std::to_string(sections.size()) +
+            " snapshot section(s) to " + kWarmRestartSnapshotFile);
+        return true;
+    }
+
+}
@@ -0,0 +1,67 @@
+/*****************************************************************//**
+ * \file   gs_warm_restart.h
+ * \brief  Derived-state snapshot adopted across clean restarts.
+ *
+ * \author PiTrac
+ * \date   August 2025
+ *********************************************************************/
+
+/* SPDX-License-Identifier: GPL-2.0-only */
+/*
+ * Copyright (C) 2022-2025, Verdant Consultants, LLC.
+ */
+
+#pragma once
+
+#include <string>
+
+namespace golf_sim {
+
+    // A restart today re-derives everything from scratch, even state whose
+    // inputs have not changed - the optimized-model cache key, for example,
+    // re-hashes the whole .onnx file on every start.  This facade lets
+    // subsystems record such derived values as named sections on clean
+    // shutdown (PerformSystemShutdownTasks) and adopt them on the next start.
+    //
+    // The snapshot is a flat, versioned binary file guarded by a fingerprint
+    // of the inputs the sections were derived from (the configuration file's
+    // path, size and modification time, plus the slot camera types).  When
+    // the fingerprint no longer matches, the whole snapshot is ignored and
+    // every subsystem re-derives as it does today - adopting stale state is
+    // strictly worse than a slow start.  Sections adopted but not re-recorded
+    // during a run are carried forward into the next snapshot.
+    //
+    // Off by default (gs_config.modes.kEnableWarmRestartSnapshot).
+
+    class GsWarmRestart {
+
+    public:
+
+        static bool kEnableWarmRestartSnapshot;
+
+        // Where the snapshot lives across restarts.  The save is skipped
+        // (with a warning) if the location is not writable.
+        static std::string kWarmRestartSnapshotFile;
+
+        // Reads the configuration values above and, when enabled, validates
+        // and adopts the previous run's snapshot.  Call once at startup,
+        // after the JSON configuration has been parsed.
+        static void Initialize();
+
+        // Retrieves the named section from the adopted snapshot.  Returns
+        // false (leaving blob untouched) if no valid snapshot was adopted or
+        // the section is not present - the caller then derives the value as
+        // usual and should RecordBlob() the result.
+        static bool AdoptedBlob(const std::string& section_name, std::string& blob);
+
+        // Registers (or replaces) a section for the next snapshot.  Cheap
+        // and thread-safe; nothing is written until SaveSnapshot().
+        static void RecordBlob(const std::string& section_name, const std::string& blob);
+
+        // Writes the recorded sections (plus any adopted sections that were
+        // not re-recorded) for the next start.  Called on clean shutdown;
+        // crashes and kills simply leave the previous snapshot in place.
+        static bool SaveSnapshot();
+    };
+
+}
@@ -5,110 +5,313 @@
 
 #include "gs_web_api.h"
 #include "logging_tools.h"
+
+#include <boost/asio.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <condition_variable>
 #include <cstdlib>
-#include <sstream>
+#include <deque>
 #include <iomanip>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifdef __unix__
+#include <sys/socket.h>
+#endif
 
 namespace golf_sim {
 
-bool WebApi::UpdateCalibration(const std::string& key, double value) {
-    std::string url = GetWebServerUrl() + "/api/config/" + key;
-    std::string payload = "{\"value\": " + FormatAsJson(value) + "}";
-    std::string response;
-    
-    bool success = ExecuteCurl(url, "PUT", payload, response);
-    
-    if (success) {
-        GS_LOG_MSG(info, "Successfully updated calibration: " + key + " = " + std::to_string(value));
-    } else {
-        GS_LOG_MSG(warning, "Failed to update calibration via web API: " + key + 
-                   ". Web server may not be running. Calibration saved locally to golf_sim_config.json");
-    }
-    
-    return success;
-}
+namespace {
 
-bool WebApi::UpdateCalibration(const std::string& key, const std::vector<double>& values) {
-    std::string url = GetWebServerUrl() + "/api/config/" + key;
-    std::string payload = "{\"value\": " + FormatAsJson(values) + "}";
-    std::string response;
-    
-    bool success = ExecuteCurl(url, "PUT", payload, response);
-    
-    if (success) {
-        GS_LOG_MSG(info, "Successfully updated calibration array: " + key);
-    } else {
-        GS_LOG_MSG(warning, "Failed to update calibration via web API: " + key + 
-                   ". Web server may not be running. Calibration saved locally to golf_sim_config.json");
-    }
-    
-    return success;
+// One queued request for the sender thread
+struct PendingWebRequest {
+    std::string server_url;
+    std::string method;
+    std::string target;
+    std::string payload;
+    std::string description;
+};
+
+std::mutex web_api_mutex_;
+std::condition_variable web_api_cv_;
+std::deque<PendingWebRequest> pending_requests_;
+
+// Held as a pointer so that a process exit without a Shutdown() call does not
+// run the destructor of a still-joinable std::thread (which would terminate)
+std::thread* sender_thread_ = nullptr;
+bool sender_exit_ = false;
+
+// The persistent, keep-alive connection to the web server.  Only ever
+// touched while web_api_mutex_ is held.
+boost::asio::io_context web_io_context_;
+std::unique_ptr<boost::asio::ip::tcp::socket> web_socket_;
+
+
+void CloseConnection() {
+    if (web_socket_) {
+        boost::system::error_code ignored;
+        web_socket_->close(ignored);
+        web_socket_.reset();
+    }
 }
 
-bool WebApi::IsWebServerAvailable() {
-    std::string url = GetWebServerUrl() + "/health";
-    std::string response;
-    
-    return ExecuteCurl(url, "GET", "", response);
+// Splits, e.g., "http://localhost:8080" into host and port
+void ParseServerUrl(const std::string& url, std::string& host, std::string& port) {
+    std::string rest = url;
+
+    const std::string scheme = "http://";
+    if (rest.rfind(scheme, 0) == 0) {
+        rest = rest.substr(scheme.size());
+    }
+
+    size_t slash = rest.find('/');
+    if (slash != std::string::npos) {
+        rest = rest.substr(0, slash);
+    }
+
+    size_t colon = rest.find(':');
+    if (colon != std::string::npos) {
+        host = rest.substr(0, colon);
+        port = rest.substr(colon + 1);
+    }
+    else {
+        host = rest;
+        port = "80";
+    }
 }
 
-std::string WebApi::GetWebServerUrl() {
-    const char* env_url = std::getenv("PITRAC_WEB_SERVER_URL");
-    if (env_url != nullptr) {
-        return std::string(env_url);
+bool EnsureConnected(const std::string& host, const std::string& port) {
+    if (web_socket_ && web_socket_->is_open()) {
+        return true;
     }
-    return kDefaultWebServerUrl;
+
+    try {
+        boost::asio::ip::tcp::resolver resolver(web_io_context_);
+        auto endpoints = resolver.resolve(host, port);
+
+        web_socket_ = std::make_unique<boost::asio::ip::tcp::socket>(web_io_context_);
+        boost::asio::connect(*web_socket_, endpoints);
+
+#ifdef __unix__
+        // The old curl invocation ran with a 2-second ceiling.  Keep the same
+        // bound so a wedged server cannot stall the sender thread forever.
+        timeval tv{ 2, 0 };
+        setsockopt(web_socket_->native_handle(), SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(web_socket_->native_handle(), SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+#endif
+    }
+    catch (std::exception&) {
+        CloseConnection();
+        return false;
+    }
+
+    return true;
 }
-std::string WebApi::ShellEscape(const std::string& input) {
-    std::stringstream escaped;
 
-    escaped << "'";
+// One HTTP/1.1 request/response exchange on the open connection.
+// web_api_mutex_ must be held by the caller.
+bool SendOverConnection(const std::string& host, const std::string& port,
+                        const std::string& method, const std::string& target,
+                        const std::string& payload, std::string& response) {
+    try {
+        std::stringstream request;
+        request << method << " " << target << " HTTP/1.1\r\n";
+        request << "Host: " << host << ":" << port << "\r\n";
+        request << "Connection: keep-alive\r\n";
+        if (!payload.empty()) {
+            request << "Content-Type: application/json\r\n";
+            request << "Content-Length: " << payload.size() << "\r\n";
+        }
+        request << "\r\n" << payload;
+
+        boost::asio::write(*web_socket_, boost::asio::buffer(request.str()));
 
-    for (char c : input) {
-        if (c == '\'') {
-            escaped << "'\\''";
-        } else {
-            escaped << c;
+        boost::asio::streambuf response_buf;
+        boost::asio::read_until(*web_socket_, response_buf, "\r\n\r\n");
+
+        std::istream response_stream(&response_buf);
+
+        std::string http_version;
+        unsigned int status_code = 0;
+        response_stream >> http_version >> status_code;
+
+        std::string header;
+        std::getline(response_stream, header);  // The rest of the status line
+
+        size_t content_length = 0;
+        bool server_closes = false;
+
+        while (std::getline(response_stream, header) && header != "\r") {
+            std::string lowered = header;
+            std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                           [](unsigned char c) { return (char)std::tolower(c); });
+
+            if (lowered.rfind("content-length:", 0) == 0) {
+                content_length = std::stoul(header.substr(15));
+            }
+            else if (lowered.rfind("connection:", 0) == 0 && lowered.find("close") != std::string::npos) {
+                server_closes = true;
+            }
+        }
+
+        // Whatever followed the headers in the buffer is the start of the body
+        response.clear();
+        if (response_buf.size() > 0) {
+            std::stringstream body;
+            body << &response_buf;
+            response = body.str();
         }
-    }
 
-    escaped << "'";
-    return escaped.str();
+        while (response.size() < content_length) {
+            char buffer[512];
+            size_t n = web_socket_->read_some(boost::asio::buffer(buffer));
+            response.append(buffer, n);
+        }
+
+        if (server_closes) {
+            CloseConnection();
+        }
+
+        return status_code >= 200 && status_code < 300;
+    }
+    catch (std::exception&) {
+        CloseConnection();
+        return false;
+    }
 }
 
-bool WebApi::ExecuteCurl(const std::string& url, const std::string& method,
-                         const std::string& payload, std::string& response) {
-    std::stringstream cmd;
+// A full request, reconnecting once if the server quietly dropped the idle
+// keep-alive connection.  web_api_mutex_ must be held by the caller.
+bool DoHttpRequest(const std::string& server_url,
+                   const std::string& method, const std::string& target,
+                   const std::string& payload, std::string& response) {
+    std::string host;
+    std::string port;
+    ParseServerUrl(server_url, host, port);
 
-    // Build curl command with timeout and silent mode
-    cmd << "curl -s -m 2 -X " << ShellEscape(method);
+    bool was_connected = (web_socket_ && web_socket_->is_open());
+
+    if (!EnsureConnected(host, port)) {
+        return false;
+    }
 
-    if (!payload.empty()) {
-        cmd << " -H 'Content-Type: application/json'";
-        cmd << " -d " << ShellEscape(payload);
-        
+    if (SendOverConnection(host, port, method, target, payload, response)) {
+        return true;
     }
-    cmd << " " << ShellEscape(url) << " 2>/dev/null";
 
-    // Execute curl command
-    FILE* pipe = popen(cmd.str().c_str(), "r");
-    if (!pipe) {
+    // A failure on a previously-idle connection usually just means the
+    // server timed it out - retry once on a fresh one
+    if (!was_connected || !EnsureConnected(host, port)) {
         return false;
     }
 
-    // Read response
-    char buffer[128];
-    response.clear();
-    while (!feof(pipe)) {
-        if (fgets(buffer, 128, pipe) != nullptr) {
-            response += buffer;
+    return SendOverConnection(host, port, method, target, payload, response);
+}
+
+void SenderThread() {
+    std::unique_lock<std::mutex> lock(web_api_mutex_);
+
+    while (true) {
+        if (pending_requests_.empty()) {
+            // Only exit once the queue has drained, so that a shutdown
+            // flushes any still-pending calibration writes
+            if (sender_exit_) {
+                return;
+            }
+            web_api_cv_.wait(lock);
+            continue;
+        }
+
+        PendingWebRequest request = std::move(pending_requests_.front());
+        pending_requests_.pop_front();
+
+        std::string response;
+        bool success = DoHttpRequest(request.server_url, request.method, request.target, request.payload, response);
+
+        if (success) {
+            GS_LOG_MSG(info, "Successfully updated calibration: " + request.description);
+        }
+        else {
+            GS_LOG_MSG(warning, "Failed to update calibration via web API: " + request.description +
+                       ". Web server may not be running. Calibration saved locally to golf_sim_config.json");
+        }
+    }
+}
+
+}  // namespace
+
+
+bool WebApi::UpdateCalibration(const std::string& key, double value) {
+    QueueRequest("PUT", "/api/config/" + key,
+                 "{\"value\": " + FormatAsJson(value) + "}",
+                 key + " = " + std::to_string(value));
+    return true;
+}
+
+bool WebApi::UpdateCalibration(const std::string& key, const std::vector<double>& values) {
+    QueueRequest("PUT", "/api/config/" + key,
+                 "{\"value\": " + FormatAsJson(values) + "}",
+                 key + " (array)");
+    return true;
+}
+
+bool WebApi::IsWebServerAvailable() {
+    std::string response;
+
+    std::lock_guard<std::mutex> lock(web_api_mutex_);
+    return DoHttpRequest(GetWebServerUrl(), "GET", "/health", "", response);
+}
+
+void WebApi::QueueRequest(const std::string& method, const std::string& target,
+                          const std::string& payload, const std::string& description) {
+    {
+        std::lock_guard<std::mutex> lock(web_api_mutex_);
+
+        if (sender_thread_ == nullptr) {
+            sender_exit_ = false;
+            sender_thread_ = new std::thread(SenderThread);
+        }
+
+        pending_requests_.push_back(PendingWebRequest{ GetWebServerUrl(), method, target, payload, description });
+    }
+
+    web_api_cv_.notify_one();
+}
+
+void WebApi::Shutdown() {
+    std::thread* sender = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(web_api_mutex_);
+
+        if (sender_thread_ == nullptr) {
+            return;
         }
+
+        sender_exit_ = true;
+        sender = sender_thread_;
+        sender_thread_ = nullptr;
     }
 
-    int exit_code = pclose(pipe);
+    web_api_cv_.notify_one();
+    sender->join();
+    delete sender;
+
+    std::lock_guard<std::mutex> lock(web_api_mutex_);
+    CloseConnection();
+}
 
-    // Check if curl succeeded (exit code 0)
-    return exit_code == 0 && !response.empty();
+std::string WebApi::GetWebServerUrl() {
+    const char* env_url = std::getenv("PITRAC_WEB_SERVER_URL");
+    if (env_url != nullptr) {
+        return std::string(env_url);
+    }
+    return kDefaultWebServerUrl;
 }
 
 std::string WebApi::FormatAsJson(double value) {
@@ -128,4 +331,4 @@ std::string WebApi::FormatAsJson(const std::vector<double>& values) {
     return ss.str();
 }
 
-} // namespace golf_sim
\ No newline at end of file
+} // namespace golf_sim
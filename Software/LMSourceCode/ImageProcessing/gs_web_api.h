@@ -12,30 +12,33 @@ namespace golf_sim {
 
 class WebApi {
 public:
-    // Send calibration update to web server
-    // Returns true if successful, false otherwise
+    // Send calibration update to web server.
+    // The update is queued for a background sender thread that holds a
+    // persistent keep-alive connection to the server, so the caller never
+    // waits on the network.  Returns true if the update was queued.
     static bool UpdateCalibration(const std::string& key, double value);
     static bool UpdateCalibration(const std::string& key, const std::vector<double>& values);
-    
-    // Check if web server is available
+
+    // Check if web server is available (synchronous)
     static bool IsWebServerAvailable();
-    
+
+    // Sends anything still queued and stops the background sender thread
+    static void Shutdown();
+
 private:
     // Get web server URL from environment or use default
     static std::string GetWebServerUrl();
-    
-    // Execute curl command and return response
-    static bool ExecuteCurl(const std::string& url, const std::string& method,
-                           const std::string& payload, std::string& response);
 
-    static std::string ShellEscape(const std::string& input);
+    // Queue one request for the background sender thread
+    static void QueueRequest(const std::string& method, const std::string& target,
+                             const std::string& payload, const std::string& description);
 
     // Format value as JSON
     static std::string FormatAsJson(double value);
     static std::string FormatAsJson(const std::vector<double>& values);
-    
+
     // Default web server URL
     static constexpr const char* kDefaultWebServerUrl = "http://localhost:8080";
 };
 
-} // namespace golf_sim
\ No newline at end of file
+} // namespace golf_sim
@@ -7,6 +7,8 @@
 
 #include <limits>
 #include <map>
+#include <mutex>
+#include <thread>
 
 #include <libcamera/control_ids.h>
 #include <libcamera/formats.h>
@@ -247,6 +249,45 @@ static void uncompress(uint8_t const *src, StreamInfo const &info, uint16_t *des
 	}
 }
 
+// Every row is independent in all four layouts above, so the unpack (the
+// CPU-bound part of the save) is simply cut into horizontal bands, one per
+// worker thread.
+static void unpack_parallel(uint8_t const *src, StreamInfo const &info, BayerFormat const &bayer_format,
+							uint16_t *dest, unsigned int dest_stride_pixels)
+{
+	auto unpack_band = [&](unsigned int y0, unsigned int rows) {
+		StreamInfo band = info;
+		band.height = rows;
+		uint8_t const *band_src = src + (size_t)y0 * info.stride;
+		uint16_t *band_dest = dest + (size_t)y0 * dest_stride_pixels;
+		if (bayer_format.compressed)
+			uncompress(band_src, band, band_dest);
+		else if (bayer_format.packed && bayer_format.bits == 10)
+			unpack_10bit(band_src, band, band_dest);
+		else if (bayer_format.packed && bayer_format.bits == 12)
+			unpack_12bit(band_src, band, band_dest);
+		else
+			unpack_16bit(band_src, band, band_dest);
+	};
+
+	unsigned int num_threads = std::max(1u, std::thread::hardware_concurrency());
+	// Don't bother spinning up threads for bands of just a few rows.
+	num_threads = std::min(num_threads, std::max(1u, info.height / 64));
+
+	if (num_threads <= 1)
+	{
+		unpack_band(0, info.height);
+		return;
+	}
+
+	unsigned int rows_per_band = (info.height + num_threads - 1) / num_threads;
+	std::vector<std::thread> workers;
+	for (unsigned int y0 = 0; y0 < info.height; y0 += rows_per_band)
+		workers.emplace_back(unpack_band, y0, std::min(rows_per_band, info.height - y0));
+	for (auto &worker : workers)
+		worker.join();
+}
+
 struct Matrix
 {
 Matrix(float m0, float m1, float m2,
@@ -312,24 +353,8 @@ void dng_save(std::vector<libcamera::Span<uint8_t>> const &mem, StreamInfo const
 	unsigned int buf_stride_pixels_padded = (buf_stride_pixels + 7) & ~7;
 	std::vector<uint16_t> buf(buf_stride_pixels_padded * info.height);
 	if (bayer_format.compressed)
-	{
-		uncompress(mem[0].data(), info, &buf[0]);
 		buf_stride_pixels = buf_stride_pixels_padded;
-	}
-	else if (bayer_format.packed)
-	{
-		switch (bayer_format.bits)
-		{
-		case 10:
-			unpack_10bit(mem[0].data(), info, &buf[0]);
-			break;
-		case 12:
-			unpack_12bit(mem[0].data(), info, &buf[0]);
-			break;
-		}
-	}
-	else
-		unpack_16bit(mem[0].data(), info, &buf[0]);
+	unpack_parallel(mem[0].data(), info, bayer_format, &buf[0], buf_stride_pixels);
 
 	// We need to fish out some metadata values for the DNG.
 	float black = 4096 * (1 << bayer_format.bits) / 65536.0;
@@ -476,10 +501,33 @@ void dng_save(std::vector<libcamera::Span<uint8_t>> const &mem, StreamInfo const
 		TIFFSetField(tif, TIFFTAG_BLACKLEVELREPEATDIM, &black_level_repeat_dim);
 		TIFFSetField(tif, TIFFTAG_BLACKLEVEL, 4, &black_levels);
 
-		for (unsigned int y = 0; y < info.height; y++)
+		// Write the image in multi-row strips rather than row-at-a-time
+		// scanlines - with no TIFF compression this turns the main image into
+		// a handful of large sequential writes.  The padded (PiSP-compressed)
+		// layout keeps the scanline path because its rows are not contiguous
+		// at the image width.
+		if (buf_stride_pixels == info.width)
+		{
+			unsigned int rows_per_strip = std::max(1u, (1u << 20) / (info.width * 2));
+			rows_per_strip = std::min(rows_per_strip, info.height);
+			TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, rows_per_strip);
+
+			tstrip_t strip = 0;
+			for (unsigned int y = 0; y < info.height; y += rows_per_strip, strip++)
+			{
+				unsigned int rows = std::min(rows_per_strip, info.height - y);
+				tmsize_t strip_bytes = (tmsize_t)rows * info.width * 2;
+				if (TIFFWriteEncodedStrip(tif, strip, &buf[(size_t)buf_stride_pixels * y], strip_bytes) != strip_bytes)
+					throw std::runtime_error("error writing DNG image data");
+			}
+		}
+		else
 		{
-			if (TIFFWriteScanline(tif, &buf[buf_stride_pixels * y], y, 0) != 1)
-				throw std::runtime_error("error writing DNG image data");
+			for (unsigned int y = 0; y < info.height; y++)
+			{
+				if (TIFFWriteScanline(tif, &buf[buf_stride_pixels * y], y, 0) != 1)
+					throw std::runtime_error("error writing DNG image data");
+			}
 		}
 
 		// We have to checkpoint before the directory offset is valid.
@@ -535,3 +583,49 @@ void dng_save(std::vector<libcamera::Span<uint8_t>> const &mem, StreamInfo const
 		throw;
 	}
 }
+
+// At most one asynchronous save is in flight at a time; a second call waits
+// for the first to finish before snapshotting.  The worker is joined at exit
+// so a save already under way completes.
+struct DngAsyncState
+{
+	std::mutex mutex;
+	std::thread worker;
+
+	~DngAsyncState()
+	{
+		if (worker.joinable())
+			worker.join();
+	}
+};
+
+static DngAsyncState dng_async_state;
+
+void dng_save_async(std::vector<libcamera::Span<uint8_t>> const &mem, StreamInfo const &info,
+					ControlList const &metadata, std::string const &filename, std::string const &cam_model,
+					StillOptions const *options)
+{
+	// Snapshot the source buffer and metadata so the capture path can reuse
+	// them as soon as we return.
+	std::vector<uint8_t> snapshot(mem[0].data(), mem[0].data() + mem[0].size());
+	ControlList metadata_copy = metadata;
+
+	std::lock_guard<std::mutex> lock(dng_async_state.mutex);
+	if (dng_async_state.worker.joinable())
+		dng_async_state.worker.join();
+
+	dng_async_state.worker = std::thread(
+		[snapshot = std::move(snapshot), info, metadata_copy = std::move(metadata_copy), filename, cam_model,
+		 options]() mutable {
+			try
+			{
+				std::vector<libcamera::Span<uint8_t>> mem_copy { libcamera::Span<uint8_t>(snapshot.data(),
+																						  snapshot.size()) };
+				dng_save(mem_copy, info, metadata_copy, filename, cam_model, options);
+			}
+			catch (std::exception const &e)
+			{
+				LOG_ERROR("dng_save_async: failed to save " << filename << ": " << e.what());
+			}
+		});
+}
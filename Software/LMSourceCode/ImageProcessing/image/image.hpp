@@ -31,6 +31,14 @@ void dng_save(std::vector<libcamera::Span<uint8_t>> const &mem, StreamInfo const
 			  libcamera::ControlList const &metadata, std::string const &filename, std::string const &cam_model,
 			  StillOptions const *options);
 
+// Asynchronous variant of dng_save - snapshots the source buffer and metadata
+// and performs the save on a background thread, so the caller can reuse the
+// buffer as soon as this returns.  At most one save is in flight at a time.
+// The options pointer must stay valid until the save completes.
+void dng_save_async(std::vector<libcamera::Span<uint8_t>> const &mem, StreamInfo const &info,
+					libcamera::ControlList const &metadata, std::string const &filename, std::string const &cam_model,
+					StillOptions const *options);
+
 // In png.cpp:
 void png_save(std::vector<libcamera::Span<uint8_t>> const &mem, StreamInfo const &info,
 			  std::string const &filename, StillOptions const *options);
@@ -14,8 +14,10 @@
 
 #ifdef __unix__  // Ignore in Windows environment
 
+#include <algorithm>
 #include <chrono>
-
+#include <mutex>
+#include <vector>
 
 #include <opencv2/calib3d/calib3d.hpp>
 
@@ -37,6 +39,7 @@
 #include "camera_hardware.h"
 #include "gs_options.h"
 #include "gs_config.h"
+#include "gs_capture_profiles.h"
 #include "logging_tools.h"
 
 #include <libcamera/logging.h>
@@ -68,6 +71,18 @@ namespace golf_sim {
     long LibCameraInterface::kCamera1StillShutterTimeuS = 15000;
     long LibCameraInterface::kCamera2StillShutterTimeuS = 15000;
 
+    bool LibCameraInterface::kUsePlacedBallFrameCache = false;
+    double LibCameraInterface::kPlacedBallFrameCacheEpsilon = 2.0;
+
+    bool LibCameraInterface::kUseLowResWatchStream = false;
+    uint LibCameraInterface::kLowResWatchWidth = 160;
+    uint LibCameraInterface::kLowResWatchHeight = 120;
+
+    bool LibCameraInterface::kUseDynamicWatchCrop = false;
+    uint LibCameraInterface::kDynamicCropPadPixels = 8;
+    uint LibCameraInterface::kMinDynamicCropWidth = 98;
+    uint LibCameraInterface::kMinDynamicCropHeight = 88;
+
     // Default values are based on empirical measurements using a 6mm lens
     int kCroppedImagePixelOffsetLeft = -5;
     int kCroppedImagePixelOffsetUp = -13;
@@ -128,11 +143,13 @@ namespace golf_sim {
             return false;
         }
 
-        // We have access to the set of frames before and after the hit, so process
-        // club data here
+        // We have access to the set of frames before and after the hit.  Hand
+        // them off (moved, not copied) to the deferred club-data worker - the
+        // image writes and the ffmpeg run must not delay the shot result, which
+        // still has to be computed and dispatched to the simulator.
 
-        if (!GolfSimClubData::ProcessClubStrikeData(RecentFrames)) {
-            GS_LOG_MSG(warning, "Failed to GolfSimClubData::ProcessClubStrikeData(RecentFrames().");
+        if (!GolfSimClubData::ProcessClubStrikeDataAsync(RecentFrames)) {
+            GS_LOG_MSG(warning, "Failed to GolfSimClubData::ProcessClubStrikeDataAsync(RecentFrames).");
             // TBD - Ignore for now
             // return false;
         }
@@ -199,6 +216,17 @@ namespace golf_sim {
             return false;
         }
 
+        // Collect the frames that the motion-detect stage retained.  The stage
+        // pushes into a lock-free ring on the capture path; move them into the
+        // RecentFrames buffer that the club-data processing works from.
+        RecentFrames.clear();
+        RecentFrameRingBuffer.Drain(RecentFrames);
+
+        // If the frames in the RecentFrames buffer are zero-copy views of the
+        // camera's buffers, they must be deep-copied before the app (and its
+        // buffer mappings) goes away at the end of this function.
+        GolfSimClubData::MaterializeZeroCopyFrames(RecentFrames);
+
         uint frameIndex = 0;
         unsigned int numFramesToShow = 10;
 
@@ -208,10 +236,26 @@ namespace golf_sim {
             float slowest_frame_rate = 10000.0;
             float fastest_frame_rate = -10000.0;
 
+            // Newest frame first, so each frame's hardware interval is taken
+            // against the (older) frame that follows it in the iteration
+            uint64_t newer_sensor_timestamp_ns = 0;
+
             for (auto& it : boost::adaptors::reverse(RecentFrames)) {
                 cv::Mat& mostRecentFrameMat = it.mat;
 
-                frame_information += "Frame " + std::to_string(frameIndex) + ": Framerate = " + std::to_string(it.frameRate) + "\n";
+                frame_information += "Frame " + std::to_string(frameIndex) + ": Framerate = " + std::to_string(it.frameRate);
+
+                // The sensor-stamped capture times are jitter-free, so their
+                // deltas are the real inter-exposure intervals - the
+                // software-derived frame rates above are only approximations
+                if (newer_sensor_timestamp_ns != 0 && it.sensorTimestampNs != 0 &&
+                    newer_sensor_timestamp_ns > it.sensorTimestampNs) {
+                    frame_information += "  (hardware interval to next frame = " +
+                        std::to_string((newer_sensor_timestamp_ns - it.sensorTimestampNs) / 1000) + " uS)";
+                }
+                newer_sensor_timestamp_ns = it.sensorTimestampNs;
+
+                frame_information += "\n";
                 average_frame_rate += it.frameRate;
 
                 if (it.frameRate < slowest_frame_rate) {
@@ -231,6 +275,9 @@ namespace golf_sim {
             }
 
             average_frame_rate /= RecentFrames.size();
+
+            GS_LOG_TRACE_MSG(trace, "Retained watcher frames (newest first):\n" + frame_information +
+                "Average (software-derived) frame rate = " + std::to_string(average_frame_rate));
         }
 
         return true;
@@ -272,6 +319,30 @@ namespace golf_sim {
         // Reduce the size of the inscribed square a little bit to ensure the motion detection ROI will be within the ball
         largest_inscribed_square_side_length_of_ball *= 0.9;
 
+        // Close the loop on the located ball rather than relying only on the
+        // hand-tuned kMaxWatchingCrop* values.  The crop needs to cover no
+        // more than the motion-watch ROI plus a little padding for residual
+        // position error, and a smaller sensor readout means a higher FPS.
+        // Club-strike imaging keeps its deliberately large window.
+        if (LibCameraInterface::kUseDynamicWatchCrop && !GolfSimClubData::kGatherClubData) {
+
+            float tight_crop_side = (float)largest_inscribed_square_side_length_of_ball +
+                2.0F * LibCameraInterface::kDynamicCropPadPixels;
+
+            // Never smaller than the sensor's minimum crop, and never larger
+            // than the configured watching crop
+            float dynamic_crop_width = std::clamp(tight_crop_side, (float)LibCameraInterface::kMinDynamicCropWidth, watching_crop_width);
+            float dynamic_crop_height = std::clamp(tight_crop_side, (float)LibCameraInterface::kMinDynamicCropHeight, watching_crop_height);
+
+            GS_LOG_TRACE_MSG(trace, "Dynamic watch crop of " + std::to_string((int)dynamic_crop_width) + "x" +
+                std::to_string((int)dynamic_crop_height) + " (was " + std::to_string((int)watching_crop_width) + "x" +
+                std::to_string((int)watching_crop_height) + ") for ball radius of " +
+                std::to_string(CvUtils::CircleRadius(ball.ball_circle_)) + " pixels.");
+
+            watching_crop_width = dynamic_crop_width;
+            watching_crop_height = dynamic_crop_height;
+        }
+
 #ifdef NOT_DOING_THIS_NOW
 
         uint largest_inscribed_square_side_length_of_ball = (double)(CvUtils::CircleRadius(ball.ball_circle_)) * sqrt(2);
@@ -729,7 +800,10 @@ bool ConfigureLibCameraOptions(RPiCamEncoder& app, const cv::Vec2i& cropping_win
         shutter_speed_string = std::to_string((int)(GolfSimClubData::kClubImageShutterSpeedMultiplier * (1. / cropped_frame_rate_fps * 1000000.))) + "us";   // TBD - should be 1,000,000 for uS setting
     }
     else {
-        camera_gain = LibCameraInterface::kCamera1HighFPSGain;
+        // The per-bay capture profile (when enabled) supplies the
+        // calibrated gain so the first watch-mode frame is already
+        // correctly exposed
+        camera_gain = (float)GsCaptureProfiles::WatchModeGain(LibCameraInterface::kCamera1HighFPSGain);
         shutter_speed_string = std::to_string((int)(1. / cropped_frame_rate_fps * 1000000.)) + "us";   // TBD - should be 1,000,000 for uS setting
     }
 
@@ -749,8 +823,29 @@ bool ConfigureLibCameraOptions(RPiCamEncoder& app, const cv::Vec2i& cropping_win
         GS_LOG_TRACE_MSG(trace, "Camera denoise option set to: " + options->denoise);
     options->framerate = cropped_frame_rate_fps;
     options->nopreview = true;
-    options->lores_width = 0;
-    options->lores_height = 0;
+
+    // Let the club-data side size its pre-trigger window in seconds of
+    // frames at this rate (see GolfSimClubData::kPreTriggerWindowSecs)
+    GolfSimClubData::SetExpectedFrameRateFps(cropped_frame_rate_fps);
+
+    // Optionally configure a second, ISP-downscaled stream for the motion
+    // analysis.  Only worthwhile when the cropping window is larger than the
+    // lores size (such as in club-strike image mode) - otherwise the main
+    // stream is already as small as the camera will deliver.
+    if (LibCameraInterface::kUseLowResWatchStream &&
+        cropping_window_size[0] > (int)LibCameraInterface::kLowResWatchWidth &&
+        cropping_window_size[1] > (int)LibCameraInterface::kLowResWatchHeight) {
+        options->lores_width = LibCameraInterface::kLowResWatchWidth;
+        options->lores_height = LibCameraInterface::kLowResWatchHeight;
+        options->lores_par = false;
+        GS_LOG_TRACE_MSG(trace, "Configuring low-res watch stream of " + std::to_string(options->lores_width) +
+            "x" + std::to_string(options->lores_height) + " within cropped window of " +
+            std::to_string(cropping_window_size[0]) + "x" + std::to_string(cropping_window_size[1]) + ".");
+    }
+    else {
+        options->lores_width = 0;
+        options->lores_height = 0;
+    }
     options->viewfinder_width = 0;
     options->viewfinder_height = 0;
     options->info_text = "";
@@ -888,6 +983,28 @@ bool RetrieveCameraInfo(const GsCameraNumber camera_number, cv::Vec2i& resolutio
 
 
 
+namespace {
+
+    // The undistortion remap tables depend only on the camera's calibration
+    // values and the image geometry, and building them costs far more than
+    // the remap that uses them.  They are therefore computed once per camera
+    // slot (and image size, since the cameras deliver both cropped and
+    // full-resolution frames) and reused for every later frame.  The
+    // calibration values are fixed for the life of the process - a
+    // re-calibration is done in a separate run - so no invalidation is needed.
+    struct UndistortMapCacheEntry {
+        GsCameraNumber camera_number = GsCameraNumber::kGsCamera1;
+        int cols = 0;
+        int rows = 0;
+        cv::Mat map1;
+        cv::Mat map2;
+    };
+
+    std::mutex undistort_map_mutex_;
+    std::vector<UndistortMapCacheEntry> undistort_map_cache_;
+}
+
+
 cv::Mat LibCameraInterface::undistort_camera_image(const cv::Mat& img, const GolfSimCamera& camera) {
 
     if (!camera.camera_hardware_.use_calibration_matrix_) {
@@ -896,24 +1013,51 @@ cv::Mat LibCameraInterface::undistort_camera_image(const cv::Mat& img, const Gol
     }
 
     GsCameraNumber camera_number = camera.camera_hardware_.camera_number_;
-    CameraHardware::CameraModel camera_model = camera.camera_hardware_.camera_model_;
 
-    // Get the calibration values from the camera
+    // cv::Mat copies are shallow, so holding the cached maps outside the lock
+    // is cheap and safe even if another thread grows the cache meanwhile
+    cv::Mat undist_map1, undist_map2;
 
-    cv::Mat cameracalibrationMatrix_ = camera.camera_hardware_.calibrationMatrix_;
-    cv::Mat cameraDistortionVector_ = camera.camera_hardware_.cameraDistortionVector_;
+    {
+        std::lock_guard<std::mutex> lock(undistort_map_mutex_);
 
-    cv::Mat unDistortedBall1Img;
-    cv::Mat m_undistMap1, m_undistMap2;
+        for (const UndistortMapCacheEntry& entry : undistort_map_cache_) {
+            if (entry.camera_number == camera_number && entry.cols == img.cols && entry.rows == img.rows) {
+                undist_map1 = entry.map1;
+                undist_map2 = entry.map2;
+                break;
+            }
+        }
 
-    if (camera.camera_hardware_.camera_is_mono()) {
-        cv::initUndistortRectifyMap(cameracalibrationMatrix_, cameraDistortionVector_, cv::Mat(), cameracalibrationMatrix_, cv::Size(img.cols, img.rows), CV_8UC1, m_undistMap1, m_undistMap2);
-    }
-    else {
-        cv::initUndistortRectifyMap(cameracalibrationMatrix_, cameraDistortionVector_, cv::Mat(), cameracalibrationMatrix_, cv::Size(img.cols, img.rows), CV_32FC1, m_undistMap1, m_undistMap2);
+        if (undist_map1.empty()) {
+            // First frame with this geometry - build and cache the maps
+
+            // Get the calibration values from the camera
+            cv::Mat cameracalibrationMatrix_ = camera.camera_hardware_.calibrationMatrix_;
+            cv::Mat cameraDistortionVector_ = camera.camera_hardware_.cameraDistortionVector_;
+
+            UndistortMapCacheEntry entry;
+            entry.camera_number = camera_number;
+            entry.cols = img.cols;
+            entry.rows = img.rows;
+
+            if (camera.camera_hardware_.camera_is_mono()) {
+                cv::initUndistortRectifyMap(cameracalibrationMatrix_, cameraDistortionVector_, cv::Mat(), cameracalibrationMatrix_, cv::Size(img.cols, img.rows), CV_8UC1, entry.map1, entry.map2);
+            }
+            else {
+                cv::initUndistortRectifyMap(cameracalibrationMatrix_, cameraDistortionVector_, cv::Mat(), cameracalibrationMatrix_, cv::Size(img.cols, img.rows), CV_32FC1, entry.map1, entry.map2);
+            }
+
+            undistort_map_cache_.push_back(entry);
+
+            undist_map1 = entry.map1;
+            undist_map2 = entry.map2;
+        }
     }
 
-    cv::remap(img, unDistortedBall1Img, m_undistMap1, m_undistMap2, cv::INTER_LINEAR);
+    cv::Mat unDistortedBall1Img;
+
+    cv::remap(img, unDistortedBall1Img, undist_map1, undist_map2, cv::INTER_LINEAR);
 
     return unDistortedBall1Img;
 }
@@ -1003,7 +1147,7 @@ LibcameraJpegApp* ConfigureForLibcameraStill(const GolfSimCamera& camera) {
 
     LibcameraJpegApp* app = lci::libcamera_app_[hardware_camera_index];
 
-    if (app != nullptr || lci::libcamera_configuration_[hardware_camera_index] == lci::CameraConfiguration::kStillPicture) {
+    if (app != nullptr && lci::libcamera_configuration_[hardware_camera_index] == lci::CameraConfiguration::kStillPicture) {
         return lci::libcamera_app_[camera_number];
     }
 
@@ -1049,7 +1193,9 @@ LibcameraJpegApp* ConfigureForLibcameraStill(const GolfSimCamera& camera) {
         long still_shutter_time_uS = 10000;
 
         if (GolfSimOptions::GetCommandLineOptions().GetCameraNumber() == GsCameraNumber::kGsCamera1) {
-            camera_gain = LibCameraInterface::kCamera1Gain;
+            // The per-bay capture profile (when enabled) supplies the
+            // calibrated gain for the idle ball-search stills
+            camera_gain = GsCaptureProfiles::StillGain(LibCameraInterface::kCamera1Gain);
             camera_contrast = LibCameraInterface::kCamera1Contrast;
             still_shutter_time_uS = LibCameraInterface::kCamera1StillShutterTimeuS;
         }
@@ -1226,26 +1372,69 @@ bool TakeRawPicture(const GolfSimCamera& camera, cv::Mat& img) {
     return true;
 }
 
+// Cached result of the last placed-ball detection, together with a downsampled
+// grey signature of the frame it was computed from.  Only touched from the FSM
+// event loop, so no locking is needed.
+static cv::Mat last_placed_ball_frame_signature;
+static GolfBall last_placed_ball_result;
+static bool last_placed_ball_found = false;
+static bool placed_ball_cache_valid = false;
+
+// Downsample far enough that the signature comparison is effectively free
+// compared to a detection pass
+static const cv::Size kPlacedBallSignatureSize(32, 32);
+
 // Enhanced ball detection using YOLO when configured
 bool CheckForBallEnhanced(GolfBall& ball, cv::Mat& img) {
     bool use_yolo = (golf_sim::BallImageProc::kBallPlacementDetectionMethod == "experimental");
-    
+
     GsCameraNumber camera_number = GolfSimOptions::GetCommandLineOptions().GetCameraNumber();
-    const CameraHardware::CameraModel camera_model = (camera_number == GsCameraNumber::kGsCamera1) ? 
+    const CameraHardware::CameraModel camera_model = (camera_number == GsCameraNumber::kGsCamera1) ?
         GolfSimCamera::kSystemSlot1CameraType : GolfSimCamera::kSystemSlot2CameraType;
-    const CameraHardware::LensType camera_lens_type = (camera_number == GsCameraNumber::kGsCamera1) ? 
+    const CameraHardware::LensType camera_lens_type = (camera_number == GsCameraNumber::kGsCamera1) ?
         GolfSimCamera::kSystemSlot1LensType : GolfSimCamera::kSystemSlot2LensType;
-    
+
     GolfSimCamera camera;
     camera.camera_hardware_.init_camera_parameters(camera_number, camera_model, camera_lens_type);
-    
+
     if (!TakeRawPicture(camera, img)) {
         GS_LOG_MSG(error, "Failed to TakeRawPicture.");
         return false;
     }
-    
+
+    // The idle ball search is also the capture-profile recalibration's
+    // light meter - rate-limited internally, so this is nearly free
+    GsCaptureProfiles::ObserveIdleStillFrame(img);
+
     cv::Vec2i search_center = camera.GetExpectedBallCenter();
-    
+
+    // If the scene is essentially unchanged from the last check, reuse the
+    // previous result instead of re-running full detection.  The FSM polls
+    // this function continuously while waiting for a ball, so this is what
+    // keeps idle CPU use near zero
+    cv::Mat frame_signature;
+    if (LibCameraInterface::kUsePlacedBallFrameCache && !img.empty()) {
+        cv::Mat grey_image;
+        cv::cvtColor(img, grey_image, cv::COLOR_BGR2GRAY);
+        cv::resize(grey_image, frame_signature, kPlacedBallSignatureSize, 0, 0, cv::INTER_AREA);
+
+        if (placed_ball_cache_valid &&
+            frame_signature.size() == last_placed_ball_frame_signature.size()) {
+
+            double mean_abs_diff = cv::norm(frame_signature, last_placed_ball_frame_signature,
+                                            cv::NORM_L1) / (double)frame_signature.total();
+
+            if (mean_abs_diff <= LibCameraInterface::kPlacedBallFrameCacheEpsilon) {
+                GS_LOG_TRACE_MSG(trace, "CheckForBallEnhanced - scene unchanged (mean pixel diff " +
+                                 std::to_string(mean_abs_diff) + "), reusing previous detection result.");
+                ball = last_placed_ball_result;
+                return last_placed_ball_found;
+            }
+        }
+    }
+
+    bool found = false;
+
     if (use_yolo) {
         if (!golf_sim::BallImageProc::PreloadYOLOModel()) {
             GS_LOG_MSG(warning, "YOLO model not available, using legacy detection");
@@ -1276,14 +1465,26 @@ bool CheckForBallEnhanced(GolfBall& ball, cv::Mat& img) {
                     ball.search_area_center_ = search_center;
                     ball.search_area_radius_ = 200;
 
-                    return true;
+                    found = true;
                 }
             }
         }
     }
 
-    bool expectBall = false;
-    return camera.GetCalibratedBall(camera, img, ball, search_center, expectBall);
+    if (!found) {
+        bool expectBall = false;
+        found = camera.GetCalibratedBall(camera, img, ball, search_center, expectBall);
+    }
+
+    // Remember this frame's signature and result for the next poll
+    if (LibCameraInterface::kUsePlacedBallFrameCache && !frame_signature.empty()) {
+        last_placed_ball_frame_signature = frame_signature;
+        last_placed_ball_result = ball;
+        last_placed_ball_found = found;
+        placed_ball_cache_valid = true;
+    }
+
+    return found;
 }
 
 // TBD - This really seems like it should exist in the gs_camera module?
@@ -1326,7 +1527,6 @@ bool CheckForBallLegacy(GolfBall& ball, cv::Mat& img) {
 
 // The following code is only relevant to the camera 2 system
 bool WaitForCam2Trigger(cv::Mat& return_image) {
-    LibcameraJpegApp app;
 
     cv::Mat raw_image;
 
@@ -1336,19 +1536,48 @@ bool WaitForCam2Trigger(cv::Mat& return_image) {
     GolfSimCamera c;
     c.camera_hardware_.init_camera_parameters(GsCameraNumber::kGsCamera2, camera_model, camera_lens_type);
 
+    // The strobed-capture camera configuration never changes from shot to shot, so
+    // the app (and with it the negotiated libcamera configuration and allocated
+    // buffers) is kept between shots.  Only the first shot after startup pays for
+    // the open/configure; later shots go straight to StartCamera, which is where
+    // the per-shot settings (gain, contrast, shutter) are applied.
+    const GsCameraNumber camera_number = GsCameraNumber::kGsCamera2;
+
+    bool camera_already_configured =
+        lci::libcamera_app_[camera_number] != nullptr &&
+        lci::libcamera_configuration_[camera_number] == lci::CameraConfiguration::kExternallyStrobed;
+
+    if (!camera_already_configured && lci::libcamera_app_[camera_number] != nullptr) {
+        // The camera is open, but configured for some other purpose (e.g., a still
+        // calibration picture).  Tear that down before re-configuring for strobing.
+        if (!DeConfigureForLibcameraStill(camera_number)) {
+            GS_LOG_TRACE_MSG(error, "failed to DeConfigureForLibcameraStill.");
+            return false;
+        }
+    }
+
+    if (lci::libcamera_app_[camera_number] == nullptr) {
+        lci::libcamera_app_[camera_number] = new LibcameraJpegApp;
+    }
+
+    LibcameraJpegApp& app = *lci::libcamera_app_[camera_number];
+
     try
     {
         StillOptions* options = app.GetOptions();
 
-        char dummy_arguments[] = "DummyExecutableName";
-        char* argv[] = { dummy_arguments, NULL };
+        if (!camera_already_configured) {
 
-        if (!options->Parse(1, argv))
-        {
-            return -1;
-        }
+            char dummy_arguments[] = "DummyExecutableName";
+            char* argv[] = { dummy_arguments, NULL };
 
-        SetLibCameraLoggingOff();
+            if (!options->Parse(1, argv))
+            {
+                return -1;
+            }
+
+            SetLibCameraLoggingOff();
+        }
 
         // On a two-Pi system, each Pi has just one camera, and that camera will be in slot 0
         // On a single-pi system the one Pi 5 has both cameras.  And Camera 2 will be in slot 1
@@ -1372,7 +1601,9 @@ bool WaitForCam2Trigger(cv::Mat& return_image) {
         }
         else {
             if (!GolfSimOptions::GetCommandLineOptions().lm_comparison_mode_) {
-                options->gain = LibCameraInterface::kCamera2Gain;
+                // The per-bay capture profile (when enabled) supplies the
+                // calibrated strobed-mode gain
+                options->gain = (float)GsCaptureProfiles::StrobedGain(LibCameraInterface::kCamera2Gain);
             }
             else {
                 options->gain = LibCameraInterface::kCamera2ComparisonGain;
@@ -1410,7 +1641,10 @@ bool WaitForCam2Trigger(cv::Mat& return_image) {
             options->Print();
 
         // This will block until the loop ends
-        ball_flight_camera_event_loop(app, raw_image);
+        ball_flight_camera_event_loop(app, raw_image, camera_already_configured);
+
+        // The camera stays open and configured for the next shot
+        lci::libcamera_configuration_[camera_number] = lci::CameraConfiguration::kExternallyStrobed;
     }
     catch (std::exception const& e)
     {
@@ -1418,9 +1652,10 @@ bool WaitForCam2Trigger(cv::Mat& return_image) {
         return false;
     }
 
-    // GS_LOG_TRACE_MSG(trace, "Tearing down initial camera.");
-    app.StopCamera();  // TBD - Need?
-    app.Teardown();  // TBD - Need?
+    // Make sure the camera is quiet between shots, but do NOT tear down the
+    // configuration - re-using it is what keeps the next shot's
+    // trigger-to-capture latency free of the libcamera reconfiguration cost.
+    app.StopCamera();
 
     // LoggingTools::LogImage("", raw_image, std::vector < cv::Point >{}, true, "InitialRawImageCam2.png");
 
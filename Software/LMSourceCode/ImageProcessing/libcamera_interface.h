@@ -66,6 +66,38 @@ namespace golf_sim {
 		static long kCamera1StillShutterTimeuS;
 		static long kCamera2StillShutterTimeuS;
 
+		// While waiting for a ball to be placed, skip the (expensive) ball
+		// detection when the new frame is virtually identical to the last one.
+		// The epsilon is the maximum mean per-pixel absolute difference
+		// (0 - 255 grey levels, computed on a downsampled frame) that still
+		// counts as "unchanged".
+		static bool kUsePlacedBallFrameCache;
+		static double kPlacedBallFrameCacheEpsilon;
+
+		// If true, a second, smaller "lores" stream is configured alongside the
+		// main (cropped) stream while watching for a hit, and the motion-detect
+		// stage analyzes that stream instead.  The main stream still feeds the
+		// encoder and the saved club-strike frames at full cropped resolution.
+		// Only takes effect when the cropping window is larger than the lores
+		// dimensions (e.g., in club-strike image mode) - otherwise the main
+		// stream is already as small as the camera will deliver.
+		static bool kUseLowResWatchStream;
+		static uint kLowResWatchWidth;
+		static uint kLowResWatchHeight;
+
+		// If true, the high-FPS watching crop is sized dynamically around the
+		// ball located by the earlier still-image search, instead of always
+		// using the hand-tuned kMaxWatchingCrop* values.  The crop is kept
+		// just large enough to cover the motion-watch ROI (the square
+		// inscribed in the ball) plus kDynamicCropPadPixels on each side, and
+		// never smaller than kMinDynamicCrop* - the IMX296 will not crop
+		// below roughly 98x88.  A smaller sensor readout raises the FPS the
+		// camera can deliver.
+		static bool kUseDynamicWatchCrop;
+		static uint kDynamicCropPadPixels;
+		static uint kMinDynamicCropWidth;
+		static uint kMinDynamicCropHeight;
+
 		// Once the cropped rectange is determined (usually around the center of the ball)
 		// These offsets can further move that cropping area
 		static int kCroppedImagePixelOffsetLeft;
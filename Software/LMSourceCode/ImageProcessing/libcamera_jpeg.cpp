@@ -85,7 +85,7 @@ void SetExternalTrigger(bool& flag) {
 
 // The main event loop for the the externally-triggered camera.
 
-bool ball_flight_camera_event_loop(LibcameraJpegApp& app, cv::Mat& returnImg)
+bool ball_flight_camera_event_loop(LibcameraJpegApp& app, cv::Mat& returnImg, bool camera_already_configured)
 {
 	GS_LOG_TRACE_MSG(trace, "ball_flight_camera_event_loop started.  Waiting for external trigger....");
 
@@ -98,16 +98,21 @@ bool ball_flight_camera_event_loop(LibcameraJpegApp& app, cv::Mat& returnImg)
 		return false;
 	}
 
-	GS_LOG_TRACE_MSG(trace, "ball_flight_camera_event_loop started.  Opening Camera at slot: " + std::to_string(options->camera));
+	if (!camera_already_configured) {
 
+		GS_LOG_TRACE_MSG(trace, "ball_flight_camera_event_loop started.  Opening Camera at slot: " + std::to_string(options->camera));
 
-	app.OpenCamera();
+		app.OpenCamera();
 
-	GS_LOG_TRACE_MSG(trace, "ball_flight_camera_event_loop started.  Opened Camera....");
+		GS_LOG_TRACE_MSG(trace, "ball_flight_camera_event_loop started.  Opened Camera....");
 
-	// The RGB flag still works for grayscale mono images
-	uint flags = RPiCamApp::FLAG_STILL_RGB;
-	app.ConfigureViewfinder(flags);
+		// The RGB flag still works for grayscale mono images
+		uint flags = RPiCamApp::FLAG_STILL_RGB;
+		app.ConfigureViewfinder(flags);
+	}
+	else {
+		GS_LOG_TRACE_MSG(trace, "ball_flight_camera_event_loop started.  Re-using already-configured camera.");
+	}
 
 	app.StartCamera();
 
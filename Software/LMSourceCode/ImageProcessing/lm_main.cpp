@@ -15,6 +15,8 @@
 #include <filesystem>
 #include <signal.h>
 #include <atomic>
+#include <chrono>
+#include <thread>
 
 #include "gs_globals.h"
 #include "golf_ball.h"
@@ -22,6 +24,20 @@
 #include "gs_gspro_results.h"
 #include "gs_ui_system.h"
 #include "gs_config.h"
+#include "gs_mat_pool_allocator.h"
+#include "gs_perf_counters.h"
+#include "gs_thread_budget.h"
+#include "gs_core_affinity.h"
+#include "gs_image_io.h"
+#include "gs_warm_restart.h"
+#include "gs_shot_journal.h"
+#include "gs_clock_sync.h"
+#include "gs_thermal_governor.h"
+#include "gs_spin_offload.h"
+#include "gs_cam2_predetect.h"
+#include "gs_capture_profiles.h"
+#include "gs_shot_telemetry.h"
+#include "gs_session_stats.h"
 #include "gs_results.h"
 #include "gs_camera.h"
 
@@ -108,7 +124,7 @@ void test_image(std::string_view subdir, std::string_view filename) {
 
     BallImageProc *ip = get_image_processor();
 
-    cv::Mat img = cv::imread(fname, cv::IMREAD_COLOR);
+    cv::Mat img = GsImageIo::ReadImage(fname, cv::IMREAD_COLOR);
     ip->image_name_ = fname;
 
     cv::Rect nullROI;
@@ -195,7 +211,7 @@ void test_all_test_files() {
 
 void test_calibrated_location(std::string twoFootImgName, std::string threeFootImgName, std::string fourFootImgName) {
 
-    cv::Mat img = cv::imread(twoFootImgName);
+    cv::Mat img = GsImageIo::ReadImage(twoFootImgName);
     LoggingTools::ShowImage(twoFootImgName, img);
 
     // Test of the GetCalibratedBall function
@@ -214,7 +230,7 @@ void test_calibrated_location(std::string twoFootImgName, std::string threeFootI
         // This original HSV masking range from the calibration is not working well.Try a lower H ?
         // b.ball_hsv_range_ = [(0, 0, 175), (175, 102, 255)]
         GS_LOG_TRACE_MSG(trace, "GET BALL LOCATION FOR 3 FEET");
-        img = cv::imread(threeFootImgName);
+        img = GsImageIo::ReadImage(threeFootImgName);
 
         // TBD - Consider the fact that the ball should be no larger than the radius of the last found
         // ball, and should have that ball"s average color
@@ -224,7 +240,7 @@ void test_calibrated_location(std::string twoFootImgName, std::string threeFootI
 
     if (!fourFootImgName.empty()) {
         GS_LOG_TRACE_MSG(trace, "GET BALL LOCATION FOR 4 FEET");
-        img = cv::imread(fourFootImgName);
+        img = GsImageIo::ReadImage(fourFootImgName);
         success = c.GetCurrentBallLocation(c, img, b, newBall);
     }
 }
@@ -257,8 +273,8 @@ bool testProjection() {
     const std::string k0_DegreeBallFileName_00 = kBaseTestDir + "test_ball_masked_0_deg_dulled.png";
     const std::string k45_DegreeBallFileName_00 = kBaseTestDir + "test_ball_masked_45_deg_dulled.png";
 
-    ball1Img = cv::imread(k0_DegreeBallFileName_00, cv::IMREAD_COLOR);
-    ball2Img = cv::imread(k45_DegreeBallFileName_00, cv::IMREAD_COLOR);
+    ball1Img = GsImageIo::ReadImage(k0_DegreeBallFileName_00, cv::IMREAD_COLOR);
+    ball2Img = GsImageIo::ReadImage(k45_DegreeBallFileName_00, cv::IMREAD_COLOR);
 
     /*
     gfilters = create_gaborfilter()
@@ -493,7 +509,7 @@ bool testAnalyzeStrobedBalls() {
 
     GS_LOG_TRACE_MSG(trace, "Pre Image1: " + preImageFileName);
 
-    camera2_pre_image_color = cv::imread(preImageFileName, cv::IMREAD_COLOR);
+    camera2_pre_image_color = GsImageIo::ReadImage(preImageFileName, cv::IMREAD_COLOR);
 
     if (camera2_pre_image_color.empty()) {
         return false;
@@ -631,8 +647,8 @@ bool test_hit_trigger() {
     const std::string kPreHitCloseBallFileName_00 = kBaseTestDir + "move_test_ball_and_club_present_2592w_00.png";
     const std::string kPostHitBallGoneFileName_00 = kBaseTestDir + "move_test_no_ball_present_2592w_00.png";
 
-    ball1ImgColor = cv::imread(kStationaryBallFileName_00, cv::IMREAD_COLOR);
-    ball2ImgColor = cv::imread(kStationaryBallFileName_01, cv::IMREAD_COLOR);
+    ball1ImgColor = GsImageIo::ReadImage(kStationaryBallFileName_00, cv::IMREAD_COLOR);
+    ball2ImgColor = GsImageIo::ReadImage(kStationaryBallFileName_01, cv::IMREAD_COLOR);
 
     cv::Mat ball1Img;
     cv::Mat ball2Img;
@@ -787,6 +803,54 @@ bool TestExternalSimMessage() {
         GS_LOG_MSG(error, "Failed to WaitAndSendShotToSim (the Golf Simulator Interface).");
 
     }
+
+    // Optional load generation - push shots at a steady, configurable rate
+    // to soak-test the sender stack (fan-out workers, retries, reconnects)
+    // against, e.g., the GSPro test server's scripted latencies/disconnects.
+    // Off unless both values are set.
+    int kLoadTestShotsPerMinute = 0;
+    int kLoadTestShotCount = 0;
+    GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.kLoadTestShotsPerMinute", kLoadTestShotsPerMinute);
+    GolfSimConfiguration::SetConstant("gs_config.golf_simulator_interfaces.kLoadTestShotCount", kLoadTestShotCount);
+
+    if (kLoadTestShotsPerMinute > 0 && kLoadTestShotCount > 0) {
+
+        GS_LOG_MSG(info, "Load test - sending " + std::to_string(kLoadTestShotCount) + " shots at " +
+            std::to_string(kLoadTestShotsPerMinute) + " shots/minute.");
+
+        long injection_period_ms = 60000L / kLoadTestShotsPerMinute;
+        auto load_test_start_time = std::chrono::steady_clock::now();
+
+        for (int shot = 0; shot < kLoadTestShotCount; shot++) {
+
+            // Vary the shot so each message is distinguishable in captures
+            test_result.speed_mph_ = 40.0F + (float)(shot % 80);
+            test_result.vla_deg_ = 8.0F + (float)(shot % 20);
+            test_result.hla_deg_ = -5.0F + (float)(shot % 11);
+            test_result.back_spin_rpm_ = 2000 + 50 * (shot % 40);
+            test_result.side_spin_rpm_ = -500 + 25 * (shot % 41);
+
+            GsSimInterface::IncrementShotCounter();
+
+            if (!WaitAndSendShotToSim(GsSimInterface::GetShotCounter(), test_result)) {
+                GS_LOG_MSG(error, "Load test - failed to send shot " + std::to_string(shot + 1) + ".");
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(injection_period_ms));
+        }
+
+        double elapsed_secs = std::chrono::duration_cast<std::chrono::duration<double>>(
+            std::chrono::steady_clock::now() - load_test_start_time).count();
+
+        GS_LOG_MSG(info, "Load test - queued " + std::to_string(kLoadTestShotCount) + " shots in " +
+            std::to_string(elapsed_secs) + " seconds (" +
+            std::to_string((double)kLoadTestShotCount / elapsed_secs * 60.0) + " shots/minute).");
+        GS_LOG_MSG(info, "Load test - delivery health: " + GsSimInterface::FormatResultsSenderHealth());
+
+        // Let the per-target sender queues drain before tearing down
+        GsSimInterface::DeInitializeSims();
+    }
+
     return true;
 
     GS_LOG_TRACE_MSG(trace, "De-initializing GSPro interface.");
@@ -959,6 +1023,55 @@ void run_main(int argc, char* argv[])
     GS_LOG_TRACE_MSG(trace, "Running on " + GolfSimPlatform);  //  platform.platform());
     GS_LOG_TRACE_MSG(trace, "OpenCV Version " + std::string(CV_VERSION));
 
+    // Install the pooled cv::Mat allocator (if configured) before anything
+    // starts allocating images
+    GsMatPoolAllocator::Install();
+
+    // Sets up the (default-off) per-stage hardware performance counters
+    GsPerfCounters::Initialize();
+
+    // Partitions the compute threads across OpenCV, ONNX Runtime and the
+    // system's own workers (if configured)
+    GsThreadBudget::Initialize();
+
+    // Steers the noisy device IRQs onto the housekeeping core and logs the
+    // thread-to-core map the budgeting above depends on (if configured)
+    GsCoreAffinity::Initialize();
+
+    // Enables the decoded-image LRU cache on the replay paths (if configured)
+    GsImageIo::Initialize();
+
+    // Validates and adopts the previous clean shutdown's derived-state
+    // snapshot (if configured)
+    GsWarmRestart::Initialize();
+
+    // Recovers the prior session's shot journal (if configured)
+    GsShotJournal::Initialize();
+
+    // Reads the cross-Pi clock-sync settings; the exchange itself starts
+    // once the IPC system is up (if configured)
+    GsClockSync::Initialize();
+
+    // Starts watching the SoC temperature so the workload can be trimmed
+    // before the firmware throttles (if configured)
+    GsThermalGovernor::Initialize();
+
+    // Reads the camera-2 spin-offload settings (if configured)
+    GsSpinOffload::Initialize();
+
+    // Reads the camera-2 pre-detection / ROI shipment settings (if configured)
+    GsCam2PreDetect::Initialize();
+
+    // Loads this bay's calibrated capture profile so the fixed camera
+    // controls are right from the first frame of each mode (if configured)
+    GsCaptureProfiles::Initialize();
+
+    // Per-shot memory telemetry for the GUI's diagnostics view (if configured)
+    GsShotTelemetry::Initialize();
+
+    // Resumes the running per-club session aggregates (if configured)
+    GsSessionStats::Initialize();
+
     bool kStartInPuttingMode = false;
     GolfSimConfiguration::SetConstant("gs_config.modes.kStartInPuttingMode", kStartInPuttingMode);
 
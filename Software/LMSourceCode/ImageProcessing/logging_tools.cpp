@@ -4,12 +4,28 @@
  */
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#ifdef __unix__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include "gs_format_lib.h"
 #include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
 #include <boost/log/sinks/basic_sink_backend.hpp>
 #include <boost/log/core/record_view.hpp>
+#include <atomic>
+#include <boost/log/attributes/function.hpp>
 #include "gs_options.h"
 #include "cv_utils.h"
+#include "gs_hw_jpeg_encoder.h"
+#include "gs_shot_trace.h"
 
 #include "logging_tools.h"
 
@@ -61,6 +77,43 @@ namespace golf_sim {
 
 
 
+    namespace {
+
+        // Number of log records the asynchronous file sink will hold before
+        // it starts dropping.  Generously larger than anything trace-level
+        // logging produces between sink-thread writes.
+        constexpr std::size_t kAsyncLogQueueSize = 2048;
+
+        std::atomic<unsigned long> dropped_log_records(0);
+
+        // Overflow policy for the async sink's bounded record queue - same
+        // shape as boost's drop_on_overflow, but counts what was dropped so
+        // that the per-shot flush barrier can report the loss instead of it
+        // passing silently.
+        struct CountingDropOnOverflow
+        {
+            template <typename LockT>
+            bool on_overflow(const boost::log::record_view&, LockT&)
+            {
+                dropped_log_records.fetch_add(1, std::memory_order_relaxed);
+
+                // Do not block the logging thread - just drop the record
+                return false;
+            }
+
+            void on_queue_space_available() {}
+
+            void interrupt() {}
+        };
+
+        typedef boost::log::sinks::asynchronous_sink<
+            boost::log::sinks::text_file_backend,
+            boost::log::sinks::bounded_fifo_queue<kAsyncLogQueueSize, CountingDropOnOverflow> > AsyncFileSink;
+
+        boost::shared_ptr<AsyncFileSink> async_file_sink;
+    }
+
+
     bool LoggingTools::logging_is_initialized_ = false;
     std::string LoggingTools::current_error_root_cause_;
 
@@ -69,6 +122,8 @@ namespace golf_sim {
 
     boost::circular_buffer<std::string> LoggingTools::RecentLogMessages(20);
 
+    bool LoggingTools::kLogImagesAsynchronously = false;
+
 #ifdef __unix__
     std::string LoggingTools::kBaseImageLoggingDir = "VALUE_NOT_SET";
 #else
@@ -82,6 +137,12 @@ namespace golf_sim {
         boost::log::add_common_attributes();
         boost::log::core::get()->add_global_attribute("Scope", boost::log::attributes::named_scope());
 
+        // The shot trace ID, evaluated per record so that every log line
+        // from the BallHit onward carries the "shot:<id> " prefix that
+        // correlates it with the other Pi's lines (see GsShotTrace)
+        boost::log::core::get()->add_global_attribute("ShotTrace",
+            boost::log::attributes::make_function(&GsShotTrace::LogPrefix));
+
         if (!GolfSimOptions::GetCommandLineOptions().base_image_logging_dir_.empty()) {
             kBaseImageLoggingDir = GolfSimOptions::GetCommandLineOptions().base_image_logging_dir_;
         }
@@ -146,14 +207,18 @@ namespace golf_sim {
             boost::log::keywords::iteration = boost::log::expressions::reverse,
             boost::log::keywords::depth = 2);
 
+        // The shot trace prefix is "" until the first shot, so the format
+        // is unchanged for anyone not correlating across machines
+        auto fmtShotTrace = boost::log::expressions::attr<std::string>("ShotTrace");
+
         boost::log::formatter logFmt =
-            boost::log::expressions::format("[%1%] (%2%) [%3%] %4%")
-            % fmtTimeStamp % fmtThreadId % fmtSeverity
+            boost::log::expressions::format("[%1%] (%2%) [%3%] %4%%5%")
+            % fmtTimeStamp % fmtThreadId % fmtSeverity % fmtShotTrace
             % boost::log::expressions::smessage;
 
         boost::log::formatter logFmtWithLineNumbers =
-            boost::log::expressions::format("[%1%] (%2%) [%3%] [%4%] %5%")
-            % fmtTimeStamp % fmtThreadId % fmtSeverity % fmtScope
+            boost::log::expressions::format("[%1%] (%2%) [%3%] [%4%] %5%%6%")
+            % fmtTimeStamp % fmtThreadId % fmtSeverity % fmtScope % fmtShotTrace
             % boost::log::expressions::smessage;
 
         auto consoleSink = boost::log::add_console_log(std::clog);
@@ -169,15 +234,30 @@ namespace golf_sim {
             log_dir = "/tmp/pitrac/logs/";
         }
         
-        auto fsSink = boost::log::add_file_log(
+        // The file sink runs behind an asynchronous frontend: a logging call
+        // only pushes the record onto a bounded queue, and the file I/O
+        // happens on the sink's dedicated thread.  That makes trace-level
+        // logging safe to enable in the field - the watcher loop and the
+        // shot pipeline never wait on the filesystem, so heavy logging does
+        // not distort the very timings being debugged.  If the queue fills,
+        // records are dropped and counted (see FlushLogSink) rather than
+        // ever blocking the logging thread.
+        auto file_backend = boost::make_shared<boost::log::sinks::text_file_backend>(
             boost::log::keywords::file_name = log_dir + "test_%Y-%m-%d_%H-%M-%S.%N.log",
             boost::log::keywords::rotation_size = 10 * 1024 * 1024,
             boost::log::keywords::min_free_space = 30 * 1024 * 1024,
             boost::log::keywords::open_mode = std::ios_base::app);
 
-        // This is pretty verbose! fsSink->set_formatter(logFmtWithLineNumbers);
-        fsSink->set_formatter(logFmt);
-        fsSink->locked_backend()->auto_flush(true);
+        // The flush only costs the sink thread now, and keeps the file
+        // current for anyone tailing it
+        file_backend->auto_flush(true);
+
+        async_file_sink = boost::make_shared<AsyncFileSink>(file_backend);
+
+        // This is pretty verbose! async_file_sink->set_formatter(logFmtWithLineNumbers);
+        async_file_sink->set_formatter(logFmt);
+
+        boost::log::core::get()->add_sink(async_file_sink);
 
         // Add our custom recent-messages sink to the logger.
         /*** TBD - Not Completed yet
@@ -200,6 +280,39 @@ namespace golf_sim {
     }
 
 
+    void LoggingTools::FlushLogSink() {
+
+        if (async_file_sink == nullptr) {
+            return;
+        }
+
+        // Blocks until the sink thread has written everything queued so far
+        async_file_sink->flush();
+
+        unsigned long dropped = dropped_log_records.exchange(0);
+
+        if (dropped > 0) {
+            GS_LOG_MSG(warning, "Asynchronous log queue overflowed - dropped " + std::to_string(dropped) +
+                " log records since the last flush.  Earlier messages may be missing from the log file.");
+        }
+    }
+
+
+    void LoggingTools::ShutdownAsyncTextLogging() {
+
+        if (async_file_sink == nullptr) {
+            return;
+        }
+
+        FlushLogSink();
+
+        boost::log::core::get()->remove_sink(async_file_sink);
+        async_file_sink->stop();
+        async_file_sink->flush();
+        async_file_sink.reset();
+    }
+
+
     void LoggingTools::InternalLog(boost::log::trivial::severity_level log_level, const std::string& msg) {
 
         switch(log_level) {
@@ -476,6 +589,118 @@ namespace golf_sim {
 
     const std::string kLogImagePrefix = "gs_log_img__";
 
+
+    // State for the background image-writer thread used when
+    // kLogImagesAsynchronously is set
+    namespace {
+
+        struct PendingImageWrite {
+            std::string fname;
+            // A shallow, refcounted reference to the frame - no pixel copy
+            cv::Mat img;
+        };
+
+        // Under pressure, the oldest (least interesting) pending diagnostic
+        // image is dropped rather than stalling the caller
+        const size_t kMaxPendingImageWrites = 8;
+
+        std::deque<PendingImageWrite> pending_image_writes_;
+        std::mutex image_writer_mutex_;
+        std::condition_variable image_writer_cv_;
+        std::thread image_writer_thread_;
+        bool image_writer_running_ = false;
+        bool image_writer_exit_ = false;
+
+
+        void ImageWriterThread() {
+
+#ifdef __unix__
+            // The encodes are pure background work - they should lose the
+            // CPU to anything else that wants it
+            sched_param sp{};
+            pthread_setschedparam(pthread_self(), SCHED_IDLE, &sp);
+#endif
+
+            std::unique_lock<std::mutex> lock(image_writer_mutex_);
+
+            while (true) {
+
+                if (pending_image_writes_.empty()) {
+                    // Only exit once the queue has been drained so that a
+                    // shutdown flushes any still-pending images
+                    if (image_writer_exit_) {
+                        return;
+                    }
+                    image_writer_cv_.wait(lock);
+                    continue;
+                }
+
+                PendingImageWrite work = std::move(pending_image_writes_.front());
+                pending_image_writes_.pop_front();
+
+                lock.unlock();
+
+                try {
+                    // JPEG targets can use the hardware codec; everything else
+                    // (and any codec failure) goes through cv::imwrite
+                    if (!GsHwJpegEncoder::EncodeToFile(work.img, work.fname)) {
+                        cv::imwrite(work.fname, work.img);
+                    }
+                    LoggingTools::InternalLog(trace, "Logged image (async) to file: " + work.fname);
+                }
+                catch (std::exception& ex) {
+                    LoggingTools::InternalLog(warning, "ImageWriterThread - failed to imwrite with fname = " + work.fname + " - " + ex.what());
+                }
+
+                lock.lock();
+            }
+        }
+
+
+        void QueueImageWrite(const std::string& fname, const cv::Mat& img) {
+
+            {
+                std::lock_guard<std::mutex> lock(image_writer_mutex_);
+
+                if (!image_writer_running_) {
+                    image_writer_thread_ = std::thread(ImageWriterThread);
+                    image_writer_running_ = true;
+                }
+
+                if (pending_image_writes_.size() >= kMaxPendingImageWrites) {
+                    pending_image_writes_.pop_front();
+                    LoggingTools::InternalLog(warning, "QueueImageWrite - image-writer queue full.  Dropped oldest pending image.");
+                }
+
+                pending_image_writes_.push_back(PendingImageWrite{ fname, img });
+            }
+
+            image_writer_cv_.notify_one();
+        }
+    }
+
+
+    void LoggingTools::ShutdownAsyncImageLogging() {
+
+        std::thread writer;
+
+        {
+            std::lock_guard<std::mutex> lock(image_writer_mutex_);
+
+            if (!image_writer_running_) {
+                return;
+            }
+
+            image_writer_exit_ = true;
+            image_writer_running_ = false;
+            writer = std::move(image_writer_thread_);
+        }
+
+        image_writer_cv_.notify_one();
+        writer.join();
+    }
+
+
     // Save the image (possibly with some pointFeatures) to a timestamped file whose name
     // will include the fileNameTag.  Example, with fileNameTag = "last_hit":
     //      "gs_log_img__last_hit__2023-11-13_12-52-47.0.png"
@@ -507,17 +732,33 @@ namespace golf_sim {
             fname = kBaseImageLoggingDir + kLogImagePrefix + fileNameTag + dateTimeStr + ".png";
         }
 
-        cv::Mat imgToLog = img.clone();
+        cv::Mat imgToLog;
 
-        for (auto& point : pointFeatures)
-        {
-            cv::circle(imgToLog, point, 2, cv::Scalar{ 0, 0, 0 }, 24);  // Nominal width was 24
+        if (pointFeatures.empty()) {
+            // No drawing on the image, so a shallow (refcounted) reference
+            // to the caller's pixels is all that is needed
+            imgToLog = img;
+        }
+        else {
+            imgToLog = img.clone();
+
+            for (auto& point : pointFeatures)
+            {
+                cv::circle(imgToLog, point, 2, cv::Scalar{ 0, 0, 0 }, 24);  // Nominal width was 24
+            }
         }
 
         if (fname.find(".png") == std::string::npos) {
             fname += ".png";
         }
 
+        if (kLogImagesAsynchronously) {
+            // The (slow) .png encode and file write happen on the background
+            // writer thread - this caller only pays for the queue push
+            QueueImageWrite(fname, imgToLog);
+            return true;
+        }
+
         try {
             cv::imwrite(fname, imgToLog);
         }
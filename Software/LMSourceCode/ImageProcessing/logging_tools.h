@@ -46,8 +46,28 @@ struct LoggingTools
 
 	static std::string kBaseImageLoggingDir;
 
+	// When true, LogImage queues the image for a background, low-priority
+	// writer thread instead of encoding and writing the .png on the calling
+	// thread.  A single full-frame encode can take hundreds of milliseconds
+	// on a Pi, so diagnostic logging from the shot pipeline should only ever
+	// cost the caller a queue push.
+	static bool kLogImagesAsynchronously;
+
 	static void InitLogging();
 
+	// Flushes any queued images and stops the background writer thread
+	// (a no-op if the writer was never started)
+	static void ShutdownAsyncImageLogging();
+
+	// Blocks until every log record queued so far has been written out by
+	// the asynchronous file-sink thread - the per-shot flush barrier.  Also
+	// reports (and resets) the count of records dropped on queue overflow.
+	static void FlushLogSink();
+
+	// Flushes and stops the asynchronous file-sink thread.  Log records
+	// written after this point go nowhere, so call it last on shutdown.
+	static void ShutdownAsyncTextLogging();
+
 	// Lowest-level logging function to allow for additional filtering, sinking, etc.
 	static void InternalLog(boost::log::trivial::severity_level level, const std::string& msg);
 
@@ -143,11 +163,26 @@ protected:
 	static boost::circular_buffer<std::string> RecentLogMessages;
 };
 
-// Used as a define so that we can get file/line-numbers in our tracing if we want
-#define GS_LOG_MSG(LEVEL, MSG) BOOST_LOG_FUNCTION();  BOOST_LOG_TRIVIAL(LEVEL) << MSG
-
-// Trace logging is everywhere, so this macro allows just that macro to be undefined
-// in order to increase performance
-#define GS_LOG_TRACE_MSG(LEVEL, MSG) BOOST_LOG_FUNCTION();  BOOST_LOG_TRIVIAL(LEVEL) << MSG
+// Used as a define so that we can get file/line-numbers in our tracing if we want.
+// Note that BOOST_LOG_TRIVIAL only evaluates the (possibly expensive) message
+// expression if the record passes the severity filter, so MSG stays lazy here.
+#define GS_LOG_MSG(LEVEL, MSG) do { BOOST_LOG_FUNCTION();  BOOST_LOG_TRIVIAL(LEVEL) << MSG; } while (0)
+
+// Trace logging is everywhere, so this macro allows just that macro to be
+// neutered in order to increase performance.  When GS_STRIP_TRACE_LOGS is
+// defined (see the strip_trace_logging meson option), any site that comes
+// through this macro at below-info severity compiles down to nothing - the
+// scope bookkeeping and the message-building expression both fold away.
+// Warning-and-above sites that happen to use this macro are kept.
+#ifdef GS_STRIP_TRACE_LOGS
+#define GS_LOG_TRACE_MSG(LEVEL, MSG) \
+	do { \
+		if constexpr (boost::log::trivial::LEVEL >= boost::log::trivial::info) { \
+			BOOST_LOG_FUNCTION();  BOOST_LOG_TRIVIAL(LEVEL) << MSG; \
+		} \
+	} while (0)
+#else
+#define GS_LOG_TRACE_MSG(LEVEL, MSG) do { BOOST_LOG_FUNCTION();  BOOST_LOG_TRIVIAL(LEVEL) << MSG; } while (0)
+#endif
 
 }
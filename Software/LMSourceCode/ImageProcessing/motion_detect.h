@@ -31,6 +31,14 @@ public:
 
 	bool Process(CompletedRequestPtr& completed_request) override;
 
+	// Load-shedding support for the frame-budget watchdog in the watcher loop.
+	// Level 0 is full processing.  Level 1 skips the diagnostic overlays drawn
+	// on the saved frames.  Level 2 additionally examines only every other ROI
+	// row (the detection itself is already restricted to the ROI at every
+	// level).  Values outside the range are clamped.
+	static const int kMaxLoadShedLevel = 2;
+	void SetLoadShedLevel(int level);
+
 
 	// In the Config, dimensions are given as fractions of the image size.
 	struct Config
@@ -59,11 +67,23 @@ public:
 	static Config incoming_configuration;
 
 private:
+	// The stream whose frames are analyzed for motion.  This is the optional
+	// low-resolution stream when one was configured (see
+	// LibCameraInterface::kUseLowResWatchStream), and otherwise the main stream.
 	Stream* stream_;
+	// The main (full cropped resolution) stream.  The frames saved for
+	// club-strike processing always come from here, even when the motion
+	// analysis runs on the low-resolution stream.
+	Stream* main_stream_;
 	// Here we convert the dimensions to pixel locations in the image, as if subsampled
 	// by hskip and vskip.
 	uint roi_x_, roi_y_;
 	uint roi_width_, roi_height_;
+	// The ROI in main-stream pixel coordinates, used for drawing the ROI
+	// rectangle on the saved frames (which may be a different resolution
+	// than the analyzed ones).
+	uint roi_draw_x_, roi_draw_y_;
+	uint roi_draw_width_, roi_draw_height_;
 	uint region_threshold_;
 	uint max_region_threshold_;
 	std::vector<uint8_t> previous_frame_;
@@ -76,6 +96,9 @@ private:
 	// frames.  This accommodates post-club-strike image processing.
 	bool detectionPaused_;
 
+	// Current load-shedding level - see SetLoadShedLevel, above.
+	int load_shed_level_ = 0;
+
 	// If true, the processing will save the first image received to the 
 	// base_image_logging_dir_ set from the command line.  After logging the
 	// image, the flag will be set back to false.
@@ -5,9 +5,15 @@
 
 #include "onnx_runtime_detector.hpp"
 #include "logging_tools.h"
+#include "gs_image_io.h"
+#include "gs_warm_restart.h"
+#include "gs_core_affinity.h"
 #include <algorithm>
 #include <numeric>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <pthread.h>
 #include <sched.h>
 #include <stdexcept>
@@ -30,9 +36,10 @@ ONNXRuntimeDetector::~ONNXRuntimeDetector() {
 }
 
 bool ONNXRuntimeDetector::Initialize() {
-    // Check if model file exists
-    if (!std::filesystem::exists(config_.model_path)) {
-        GS_LOG_MSG(error, "ONNX model file not found: " + config_.model_path);
+    // Pick the INT8-quantized model when requested (and available), otherwise
+    // the FP32 model.  Also checks that the chosen file exists.
+    std::string model_path = ResolveModelPath();
+    if (model_path.empty()) {
         return false;
     }
 
@@ -44,16 +51,69 @@ bool ONNXRuntimeDetector::Initialize() {
 
         ConfigureSessionOptions();
 
+        // Use the serialized optimized-model cache when enabled - rebuilding
+        // the session from the raw model re-runs graph optimization every
+        // startup, which costs seconds on a Pi 4.
+        std::string cache_path = ResolveOptimizedModelCachePath(model_path);
+
+        if (!cache_path.empty() && std::filesystem::exists(cache_path)) {
+            // Cache hit - the cached graph was optimized by this same ORT
+            // version for this same model file (both are part of the cache
+            // file name), so load it directly and skip the heavy
+            // optimization passes.
+            GS_LOG_MSG(info, "Loading optimized ONNX model from cache: " + cache_path);
+            session_options_->SetGraphOptimizationLevel(
+                GraphOptimizationLevel::ORT_ENABLE_BASIC);
+            model_path = cache_path;
+        }
+        else if (!cache_path.empty()) {
+            // Cache miss - have this session creation serialize the
+            // optimized graph so the next startup can skip the work
+            GS_LOG_MSG(info, "Writing optimized ONNX model cache: " + cache_path);
+            session_options_->SetOptimizedModelFilePath(cache_path.c_str());
+        }
+
+        memory_info_ = std::make_unique<Ort::MemoryInfo>(
+            Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault)
+        );
+
+        if (config_.use_memory_pool) {
+            // Register a shared CPU arena of the configured size with the
+            // environment before the session exists.  Together with the
+            // session.use_env_allocators entry (see ConfigureSessionOptions),
+            // the session then draws its activation/workspace allocations
+            // from this one up-front arena instead of growing its own
+            // allocator run by run - the growth pauses are the per-inference
+            // jitter this pool exists to remove.
+            try {
+                size_t arena_bytes = config_.memory_pool_size_mb * 1024 * 1024;
+
+                // One chunk of the full configured size, allocated now;
+                // anything beyond it extends by exactly what is requested.
+                Ort::ArenaCfg arena_cfg(arena_bytes,
+                                        /* arena_extend_strategy = kSameAsRequested */ 1,
+                                        (int)arena_bytes,
+                                        /* max_dead_bytes_per_chunk (default) */ -1);
+
+                env_->CreateAndRegisterAllocator(*memory_info_, arena_cfg);
+                arena_registered_ = true;
+
+                GS_LOG_MSG(info, "Registered a preallocated " +
+                    std::to_string(config_.memory_pool_size_mb) + " MB ORT arena.");
+            }
+            catch (const Ort::Exception& e) {
+                GS_LOG_MSG(warning, "Could not register the preallocated ORT arena: " +
+                    std::string(e.what()) + ".  Continuing with per-session allocation.");
+            }
+        }
+
         session_ = std::make_unique<Ort::Session>(
             *env_,
-            config_.model_path.c_str(),
+            model_path.c_str(),
             *session_options_
         );
 
         allocator_ = std::make_unique<Ort::AllocatorWithDefaultOptions>();
-        memory_info_ = std::make_unique<Ort::MemoryInfo>(
-            Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault)
-        );
 
         CacheModelInfo();
 
@@ -65,6 +125,19 @@ bool ONNXRuntimeDetector::Initialize() {
 
         WarmUp(5);
 
+        // If INT8 was requested but no quantized model exists yet, capture the
+        // activation ranges from the recorded calibration images now so that
+        // the offline quantization step can produce one.
+        if (config_.use_int8_quantization && !int8_model_active_ &&
+            !config_.calibration_image_dir.empty()) {
+            std::string table_path = config_.calibration_table_path;
+            if (table_path.empty()) {
+                table_path = (std::filesystem::path(config_.calibration_image_dir) /
+                              "calibration_ranges.json").string();
+            }
+            CalibrateFromDirectory(config_.calibration_image_dir, table_path);
+        }
+
         GS_LOG_MSG(info, "ONNX Runtime detector initialized successfully");
         return true;
 
@@ -80,6 +153,142 @@ bool ONNXRuntimeDetector::Initialize() {
     }
 }
 
+std::string ONNXRuntimeDetector::ResolveModelPath() {
+    if (config_.use_int8_quantization) {
+        std::string int8_path = config_.int8_model_path;
+        if (int8_path.empty() && !config_.model_path.empty()) {
+            // By convention, the offline quantizer writes the quantized model
+            // next to the FP32 one with an "_int8" suffix
+            std::filesystem::path fp32_path(config_.model_path);
+            int8_path = (fp32_path.parent_path() /
+                         (fp32_path.stem().string() + "_int8" + fp32_path.extension().string())).string();
+        }
+
+        if (!int8_path.empty() && std::filesystem::exists(int8_path)) {
+            GS_LOG_MSG(info, "Using INT8-quantized ONNX model: " + int8_path);
+            int8_model_active_ = true;
+            return int8_path;
+        }
+
+        GS_LOG_MSG(warning, "INT8 quantization requested, but no quantized model was found at: " +
+                   int8_path + ".  Falling back to the FP32 model.");
+    }
+
+    if (config_.use_fp16) {
+        std::string fp16_path = config_.fp16_model_path;
+        if (fp16_path.empty() && !config_.model_path.empty()) {
+            // By convention, the offline converter writes the half-precision
+            // model next to the FP32 one with an "_fp16" suffix
+            std::filesystem::path fp32_path(config_.model_path);
+            fp16_path = (fp32_path.parent_path() /
+                         (fp32_path.stem().string() + "_fp16" + fp32_path.extension().string())).string();
+        }
+
+        if (!fp16_path.empty() && std::filesystem::exists(fp16_path)) {
+            GS_LOG_MSG(info, "Using FP16-converted ONNX model: " + fp16_path);
+            fp16_model_active_ = true;
+            return fp16_path;
+        }
+
+        GS_LOG_MSG(warning, "FP16 inference requested, but no converted model was found at: " +
+                   fp16_path + ".  Falling back to the FP32 model.");
+    }
+
+    if (!std::filesystem::exists(config_.model_path)) {
+        GS_LOG_MSG(error, "ONNX model file not found: " + config_.model_path);
+        return std::string();
+    }
+
+    return config_.model_path;
+}
+
+std::string ONNXRuntimeDetector::ResolveOptimizedModelCachePath(const std::string& model_path) {
+    if (!config_.use_optimized_model_cache) {
+        return std::string();
+    }
+
+    try {
+        // The hash key below is derived purely from the model bytes, so when
+        // the file's size and mtime match what the last clean shutdown
+        // recorded, the warm-restart snapshot supplies the key and the
+        // full-file read is skipped.
+        std::string stat_prefix;
+        {
+            std::error_code ec;
+            uintmax_t model_size = std::filesystem::file_size(model_path, ec);
+            int64_t model_mtime = 0;
+            auto mtime = std::filesystem::last_write_time(model_path, ec);
+            if (!ec) {
+                model_mtime = (int64_t)mtime.time_since_epoch().count();
+            }
+            stat_prefix = std::to_string(model_size) + "|" + std::to_string(model_mtime) + "|";
+        }
+
+        const std::string snapshot_section = "onnx_model_hash|" + model_path;
+        std::string hash_hex_str;
+
+        std::string prior;
+        if (GsWarmRestart::AdoptedBlob(snapshot_section, prior) &&
+            prior.size() > stat_prefix.size() &&
+            prior.compare(0, stat_prefix.size(), stat_prefix) == 0) {
+            hash_hex_str = prior.substr(stat_prefix.size());
+            GS_LOG_TRACE_MSG(trace, "Adopted optimized-model cache key from the warm-restart snapshot");
+        }
+        else {
+            // FNV-1a over the model bytes.  Cheap relative to what it saves,
+            // and it guarantees a retrained/replaced model never picks up the
+            // old model's optimized graph.
+            std::ifstream model_file(model_path, std::ios::binary);
+            if (!model_file) {
+                GS_LOG_MSG(warning, "Could not read model file to key the optimized-model cache: " + model_path);
+                return std::string();
+            }
+
+            uint64_t hash = 14695981039346656037ULL;
+            char buffer[65536];
+
+            while (model_file.read(buffer, sizeof(buffer)) || model_file.gcount() > 0) {
+                std::streamsize bytes_read = model_file.gcount();
+                for (std::streamsize i = 0; i < bytes_read; i++) {
+                    hash ^= (uint64_t)(uint8_t)buffer[i];
+                    hash *= 1099511628211ULL;
+                }
+            }
+
+            char hash_hex[17];
+            std::snprintf(hash_hex, sizeof(hash_hex), "%016llx", (unsigned long long)hash);
+            hash_hex_str = hash_hex;
+        }
+
+        GsWarmRestart::RecordBlob(snapshot_section, stat_prefix + hash_hex_str);
+
+        // The ORT version is part of the key too - a cached graph is only
+        // valid for the exact runtime that serialized it
+        std::string ort_version = OrtGetApiBase()->GetVersionString();
+
+        std::filesystem::path model(model_path);
+        std::string cache_prefix = model.stem().string() + ".opt-";
+        std::string cache_name = cache_prefix + hash_hex_str +
+                                 "-ort" + ort_version + model.extension().string();
+
+        // Drop any caches keyed to an older model or runtime so they do not
+        // accumulate next to the model
+        for (const auto& entry : std::filesystem::directory_iterator(model.parent_path())) {
+            std::string entry_name = entry.path().filename().string();
+            if (entry_name.rfind(cache_prefix, 0) == 0 && entry_name != cache_name) {
+                GS_LOG_MSG(info, "Removing stale optimized-model cache: " + entry.path().string());
+                std::filesystem::remove(entry.path());
+            }
+        }
+
+        return (model.parent_path() / cache_name).string();
+
+    } catch (const std::exception& e) {
+        GS_LOG_MSG(warning, "Could not set up the optimized-model cache: " + std::string(e.what()));
+        return std::string();
+    }
+}
+
 void ONNXRuntimeDetector::ConfigureSessionOptions() {
     session_options_ = std::make_unique<Ort::SessionOptions>();
 
@@ -150,6 +359,13 @@ void ONNXRuntimeDetector::CacheModelInfo() {
         auto type_info = session_->GetInputTypeInfo(i);
         auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
         input_shapes_.push_back(tensor_info.GetShape());
+
+        if (i == 0) {
+            // The FP16-converted model declares a float16 input - the
+            // preprocessed blob gets narrowed to half before each Run
+            input_is_fp16_ = (tensor_info.GetElementType() ==
+                              ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16);
+        }
     }
 
     size_t num_outputs = session_->GetOutputCount();
@@ -209,6 +425,142 @@ void ONNXRuntimeDetector::InitializeMemoryPool() {
     size_t preproc_size = config_.input_width * config_.input_height * 3;
 
     memory_pool_->Reserve(input_size, output_size, preproc_size);
+
+    SetupIoBinding();
+}
+
+// Creates the input/output tensors once over the pool's buffers and
+// pre-binds them to the session, so steady-state Detect() runs perform no
+// per-inference tensor creation and no output allocation.  Only possible
+// when the model's shapes are fully static FP32 and match the configured
+// input geometry - dynamic-shape and half-precision models keep the
+// per-run tensor path.
+void ONNXRuntimeDetector::SetupIoBinding() {
+
+    if (input_is_fp16_ || input_shapes_.size() != 1 || output_shapes_.size() != 1) {
+        return;
+    }
+
+    auto all_static = [](const std::vector<int64_t>& shape) {
+        if (shape.empty()) {
+            return false;
+        }
+        for (int64_t dim : shape) {
+            if (dim <= 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    if (!all_static(input_shapes_[0]) || !all_static(output_shapes_[0])) {
+        GS_LOG_TRACE_MSG(trace, "ONNXRuntimeDetector - model has dynamic shapes.  Keeping the per-run tensor path.");
+        return;
+    }
+
+    if (session_->GetOutputTypeInfo(0).GetTensorTypeAndShapeInfo().GetElementType() !=
+        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+        return;
+    }
+
+    size_t input_count = (size_t)std::accumulate(
+        input_shapes_[0].begin(), input_shapes_[0].end(), (int64_t)1, std::multiplies<int64_t>());
+    size_t output_count = (size_t)std::accumulate(
+        output_shapes_[0].begin(), output_shapes_[0].end(), (int64_t)1, std::multiplies<int64_t>());
+
+    // Detect() preprocesses into a buffer of exactly this many elements -
+    // a model whose static geometry disagrees with the config cannot share it
+    if (input_count != (size_t)(3 * config_.input_width * config_.input_height)) {
+        GS_LOG_MSG(warning, "ONNXRuntimeDetector - model input geometry does not match the configured "
+            "input size.  Keeping the per-run tensor path.");
+        return;
+    }
+
+    try {
+        // The bound tensors wrap the pool's buffers directly, so the vectors
+        // must reach their final size (and a stable data pointer) now
+        {
+            std::lock_guard<std::mutex> lock(memory_pool_->mutex);
+            memory_pool_->input_buffer.resize(input_count);
+            memory_pool_->output_buffer.resize(output_count);
+        }
+
+        bound_input_data_ = memory_pool_->input_buffer.data();
+        bound_output_data_ = memory_pool_->output_buffer.data();
+        bound_output_element_count_ = output_count;
+
+        bound_input_tensor_ = Ort::Value::CreateTensor<float>(
+            *memory_info_, bound_input_data_, input_count,
+            input_shapes_[0].data(), input_shapes_[0].size());
+
+        bound_output_tensor_ = Ort::Value::CreateTensor<float>(
+            *memory_info_, bound_output_data_, output_count,
+            output_shapes_[0].data(), output_shapes_[0].size());
+
+        io_binding_ = std::make_unique<Ort::IoBinding>(*session_);
+        io_binding_->BindInput(input_names_[0], bound_input_tensor_);
+        io_binding_->BindOutput(output_names_[0], bound_output_tensor_);
+
+        GS_LOG_MSG(info, "ONNXRuntimeDetector - pre-bound pooled input/output tensors (" +
+            std::to_string(input_count) + " / " + std::to_string(output_count) +
+            " elements) for reuse across runs.");
+    }
+    catch (const Ort::Exception& e) {
+        GS_LOG_MSG(warning, "ONNXRuntimeDetector - could not set up the IO binding: " +
+            std::string(e.what()) + ".  Keeping the per-run tensor path.");
+        io_binding_.reset();
+        bound_input_data_ = nullptr;
+        bound_output_data_ = nullptr;
+    }
+}
+
+Ort::Value ONNXRuntimeDetector::CreateInputTensor(float* input_data,
+                                                  size_t element_count,
+                                                  const std::vector<int64_t>& input_shape) {
+    if (!input_is_fp16_) {
+        return Ort::Value::CreateTensor<float>(
+            *memory_info_,
+            input_data,
+            element_count,
+            input_shape.data(),
+            input_shape.size()
+        );
+    }
+
+    // The model takes float16 - narrow the preprocessed FP32 blob into the
+    // reused staging buffer.  cv::Mat::convertTo goes through OpenCV's HAL,
+    // which uses the NEON FP16 conversion instructions on ARM.
+    fp16_input_buffer_.resize(element_count);
+
+    cv::Mat fp32_view(1, (int)element_count, CV_32F, input_data);
+    cv::Mat fp16_view(1, (int)element_count, CV_16F, fp16_input_buffer_.data());
+    fp32_view.convertTo(fp16_view, CV_16F);
+
+    return Ort::Value::CreateTensor(
+        *memory_info_,
+        fp16_input_buffer_.data(),
+        element_count * sizeof(uint16_t),
+        input_shape.data(),
+        input_shape.size(),
+        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16
+    );
+}
+
+const float* ONNXRuntimeDetector::OutputTensorAsFloat(Ort::Value& tensor,
+                                                      int64_t element_count) {
+    if (tensor.GetTensorTypeAndShapeInfo().GetElementType() !=
+        ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) {
+        return tensor.GetTensorMutableData<float>();
+    }
+
+    // Widen the float16 output for the FP32 postprocessing
+    fp16_output_buffer_.resize((size_t)element_count);
+
+    cv::Mat fp16_view(1, (int)element_count, CV_16F, tensor.GetTensorMutableData<uint16_t>());
+    cv::Mat fp32_view(1, (int)element_count, CV_32F, fp16_output_buffer_.data());
+    fp16_view.convertTo(fp32_view, CV_32F);
+
+    return fp16_output_buffer_.data();
 }
 
 std::vector<ONNXRuntimeDetector::Detection> ONNXRuntimeDetector::Detect(
@@ -250,54 +602,79 @@ std::vector<ONNXRuntimeDetector::Detection> ONNXRuntimeDetector::Detect(
 
     auto end_preproc = std::chrono::high_resolution_clock::now();
 
-    std::vector<int64_t> input_shape = {1, 3, config_.input_height, config_.input_width};
-    auto input_tensor = Ort::Value::CreateTensor<float>(
-        *memory_info_,
-        input_data,
-        1 * 3 * config_.input_width * config_.input_height,
-        input_shape.data(),
-        input_shape.size()
-    );
+    // The pre-bound tensors are only usable while they still wrap the
+    // pool's current buffers - a pool reallocation (e.g., for a larger
+    // DetectBatch blob) invalidates them, and the per-run path takes over.
+    bool use_bound_run = io_binding_ != nullptr && memory_pool_ != nullptr &&
+                         input_data == bound_input_data_ &&
+                         memory_pool_->input_buffer.data() == bound_input_data_ &&
+                         memory_pool_->output_buffer.data() == bound_output_data_;
+
+    // Keeps an unbound run's outputs alive through postprocessing
+    std::vector<Ort::Value> output_tensors;
+    Ort::Value input_tensor{nullptr};
+
+    if (!use_bound_run) {
+        std::vector<int64_t> input_shape = {1, 3, config_.input_height, config_.input_width};
+        input_tensor = CreateInputTensor(input_data, input_buffer_size, input_shape);
+    }
 
     auto start_inference = std::chrono::high_resolution_clock::now();
 
-    auto output_tensors = session_->Run(
-        Ort::RunOptions{nullptr},
-        input_names_.data(),
-        &input_tensor,
-        1,
-        output_names_.data(),
-        output_names_.size()
-    );
+    if (use_bound_run) {
+        // The blob was preprocessed straight into the bound input tensor's
+        // buffer, and the output lands in the bound output tensor's - no
+        // per-run tensor creation, no output allocation
+        session_->Run(Ort::RunOptions{nullptr}, *io_binding_);
+    }
+    else {
+        output_tensors = session_->Run(
+            Ort::RunOptions{nullptr},
+            input_names_.data(),
+            &input_tensor,
+            1,
+            output_names_.data(),
+            output_names_.size()
+        );
+    }
 
     auto end_inference = std::chrono::high_resolution_clock::now();
 
     auto start_postproc = std::chrono::high_resolution_clock::now();
 
-    if (output_tensors.empty()) {
-        GS_LOG_MSG(error, "No output tensors returned from inference");
-        return {};
-    }
+    const float* output_data = nullptr;
+    int64_t output_size = 0;
 
-    float* output_data = output_tensors[0].GetTensorMutableData<float>();
-    if (!output_data) {
-        GS_LOG_MSG(error, "Output tensor data is null");
-        return {};
+    if (use_bound_run) {
+        output_data = bound_output_data_;
+        output_size = (int64_t)bound_output_element_count_;
     }
+    else {
+        if (output_tensors.empty()) {
+            GS_LOG_MSG(error, "No output tensors returned from inference");
+            return {};
+        }
 
-    auto output_shape = output_tensors[0].GetTensorTypeAndShapeInfo().GetShape();
-    if (output_shape.empty()) {
-        GS_LOG_MSG(error, "Output tensor shape is empty");
-        return {};
-    }
+        auto output_shape = output_tensors[0].GetTensorTypeAndShapeInfo().GetShape();
+        if (output_shape.empty()) {
+            GS_LOG_MSG(error, "Output tensor shape is empty");
+            return {};
+        }
 
-    int64_t output_size = std::accumulate(
-        output_shape.begin(), output_shape.end(), 1, std::multiplies<int64_t>()
-    );
+        output_size = std::accumulate(
+            output_shape.begin(), output_shape.end(), 1, std::multiplies<int64_t>()
+        );
 
-    if (output_size <= 0) {
-        GS_LOG_MSG(error, "Invalid output tensor size: " + std::to_string(output_size));
-        return {};
+        if (output_size <= 0) {
+            GS_LOG_MSG(error, "Invalid output tensor size: " + std::to_string(output_size));
+            return {};
+        }
+
+        output_data = OutputTensorAsFloat(output_tensors[0], output_size);
+        if (!output_data) {
+            GS_LOG_MSG(error, "Output tensor data is null");
+            return {};
+        }
     }
 
     auto detections = PostprocessYOLO(output_data, output_size, letterbox_params_);
@@ -525,24 +902,16 @@ void ONNXRuntimeDetector::SetThreadAffinity() {
 #ifdef __linux__
     if (!config_.use_thread_affinity || config_.cpu_cores.empty()) return;
 
-    pthread_t thread = pthread_self();
-    cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-
-    for (int core : config_.cpu_cores) {
-        CPU_SET(core, &cpuset);
-    }
-
-    pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuset);
+    // The verified call warns if the kernel trimmed the request, instead of
+    // quietly leaving the detector on whatever cores the scheduler chose
+    GsCoreAffinity::ApplyAndVerify(pthread_self(), config_.cpu_cores, "ONNX detector");
 #endif
 }
 
 void ONNXRuntimeDetector::PinThreadToCore(int core_id) {
 #ifdef __linux__
-    cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-    CPU_SET(core_id, &cpuset);
-    sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+    GsCoreAffinity::ApplyAndVerify(pthread_self(), {core_id},
+                                   "ONNX worker (core " + std::to_string(core_id) + ")");
 #endif
 }
 
@@ -590,29 +959,294 @@ void ONNXRuntimeDetector::ReleaseBuffers() {
 }
 
 size_t ONNXRuntimeDetector::GetMemoryUsage() const {
+    size_t usage = 0;
+
+    // The registered arena holds its full configured reservation for the
+    // lifetime of the detector, so report it at face value
+    if (arena_registered_) {
+        usage += (size_t)config_.memory_pool_size_mb * 1024 * 1024;
+    }
+
     if (memory_pool_) {
-        return memory_pool_->input_buffer.capacity() * sizeof(float) +
-               memory_pool_->output_buffer.capacity() * sizeof(float) +
-               memory_pool_->preprocessing_buffer.capacity();
+        std::lock_guard<std::mutex> lock(memory_pool_->mutex);
+        usage += memory_pool_->input_buffer.capacity() * sizeof(float) +
+                 memory_pool_->output_buffer.capacity() * sizeof(float) +
+                 memory_pool_->preprocessing_buffer.capacity();
     }
-    return 0;
+
+    return usage;
 }
 
 std::vector<std::vector<ONNXRuntimeDetector::Detection>> ONNXRuntimeDetector::DetectBatch(
-    const std::vector<cv::Mat>& images) {
+    const std::vector<cv::Mat>& images,
+    PerformanceMetrics* metrics) {
 
     std::vector<std::vector<Detection>> results;
     results.reserve(images.size());
 
-    // For now, process sequentially
-    // TODO: Implement true batch processing if model supports it
-    for (const auto& image : images) {
-        results.push_back(Detect(image));
+    if (images.empty()) {
+        return results;
+    }
+
+    const int batch_size = (int)images.size();
+
+    // A single-image batch (or a model exported with a fixed batch dimension
+    // of 1) cannot use the batched tensor, so process sequentially
+    int64_t model_batch_dim = input_shapes_.empty() || input_shapes_[0].empty() ?
+                              -1 : input_shapes_[0][0];
+    bool model_supports_batch = (model_batch_dim < 0 || model_batch_dim == batch_size);
+
+    if (batch_size == 1 || !model_supports_batch || !session_) {
+        if (!model_supports_batch && batch_size > 1) {
+            GS_LOG_TRACE_MSG(trace, "DetectBatch - model has a fixed batch dimension of " +
+                       std::to_string(model_batch_dim) + ", processing " +
+                       std::to_string(batch_size) + " images sequentially");
+        }
+        for (const auto& image : images) {
+            results.push_back(Detect(image, metrics));
+        }
+        return results;
+    }
+
+    auto start_total = std::chrono::high_resolution_clock::now();
+
+    auto start_preproc = std::chrono::high_resolution_clock::now();
+
+    const size_t image_tensor_size = (size_t)3 * config_.input_width * config_.input_height;
+    const size_t input_buffer_size = (size_t)batch_size * image_tensor_size;
+
+    float* input_data = GetInputBuffer(input_buffer_size);
+    if (!input_data) {
+        GS_LOG_MSG(error, "DetectBatch - failed to allocate input buffer of size: " +
+                   std::to_string(input_buffer_size));
+        return results;
+    }
+
+    // Letterbox each ROI into its slice of the batched tensor, keeping the
+    // per-image letterbox parameters for the coordinate back-conversion.
+    // (PreprocessImage stores them in letterbox_params_ as a side effect.)
+    std::vector<LetterboxParams> per_image_letterbox(batch_size);
+    for (int i = 0; i < batch_size; i++) {
+        PreprocessImage(images[i], input_data + (size_t)i * image_tensor_size);
+        per_image_letterbox[i] = letterbox_params_;
+    }
+
+    auto end_preproc = std::chrono::high_resolution_clock::now();
+
+    std::vector<int64_t> input_shape = {batch_size, 3, config_.input_height, config_.input_width};
+    auto input_tensor = CreateInputTensor(input_data, input_buffer_size, input_shape);
+
+    auto start_inference = std::chrono::high_resolution_clock::now();
+
+    std::vector<Ort::Value> output_tensors;
+    try {
+        output_tensors = session_->Run(
+            Ort::RunOptions{nullptr},
+            input_names_.data(),
+            &input_tensor,
+            1,
+            output_names_.data(),
+            output_names_.size()
+        );
+    } catch (const Ort::Exception& e) {
+        // Some exports reject batched shapes at Run() time even with a
+        // symbolic batch dimension - fall back to sequential inference
+        ReleaseBuffers();
+        GS_LOG_MSG(warning, "DetectBatch - batched Run failed (" + std::string(e.what()) +
+                   "), falling back to sequential inference");
+        for (const auto& image : images) {
+            results.push_back(Detect(image, metrics));
+        }
+        return results;
+    }
+
+    auto end_inference = std::chrono::high_resolution_clock::now();
+
+    auto start_postproc = std::chrono::high_resolution_clock::now();
+
+    if (output_tensors.empty()) {
+        GS_LOG_MSG(error, "DetectBatch - no output tensors returned from inference");
+        ReleaseBuffers();
+        return results;
+    }
+
+    auto output_shape = output_tensors[0].GetTensorTypeAndShapeInfo().GetShape();
+
+    int64_t total_output_size = std::accumulate(
+        output_shape.begin(), output_shape.end(), (int64_t)1, std::multiplies<int64_t>()
+    );
+
+    const float* output_data = total_output_size > 0 ?
+        OutputTensorAsFloat(output_tensors[0], total_output_size) : nullptr;
+
+    if (!output_data || total_output_size <= 0 || total_output_size % batch_size != 0) {
+        GS_LOG_MSG(error, "DetectBatch - unexpected output tensor size: " +
+                   std::to_string(total_output_size));
+        ReleaseBuffers();
+        return results;
+    }
+
+    const int64_t per_image_output_size = total_output_size / batch_size;
+
+    for (int i = 0; i < batch_size; i++) {
+        results.push_back(PostprocessYOLO(output_data + (size_t)i * per_image_output_size,
+                                          (int)per_image_output_size,
+                                          per_image_letterbox[i]));
+    }
+
+    auto end_postproc = std::chrono::high_resolution_clock::now();
+
+    ReleaseBuffers();
+
+    if (metrics) {
+        auto duration = [](auto start, auto end) {
+            return std::chrono::duration<float, std::milli>(end - start).count();
+        };
+
+        metrics->preprocessing_ms = duration(start_preproc, end_preproc);
+        metrics->inference_ms = duration(start_inference, end_inference);
+        metrics->postprocessing_ms = duration(start_postproc, end_postproc);
+        metrics->total_ms = duration(start_total, std::chrono::high_resolution_clock::now());
+        metrics->memory_usage_bytes = GetMemoryUsage();
     }
 
     return results;
 }
 
+bool ONNXRuntimeDetector::CalibrateFromDirectory(const std::string& image_dir,
+                                                 const std::string& output_table_path) {
+    if (!session_) {
+        GS_LOG_MSG(error, "CalibrateFromDirectory - session not initialized");
+        return false;
+    }
+
+    if (input_is_fp16_) {
+        GS_LOG_MSG(error, "CalibrateFromDirectory - the FP16 model is loaded, but "
+                   "calibration ranges must be captured from the FP32 session");
+        return false;
+    }
+
+    if (!std::filesystem::is_directory(image_dir)) {
+        GS_LOG_MSG(error, "CalibrateFromDirectory - not a directory: " + image_dir);
+        return false;
+    }
+
+    // Per-tensor running min/max.  Index 0 is the input tensor, followed by
+    // each model output in output_names_ order.
+    struct TensorRange {
+        std::string name;
+        float min_value = std::numeric_limits<float>::max();
+        float max_value = std::numeric_limits<float>::lowest();
+
+        void Update(const float* data, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                min_value = std::min(min_value, data[i]);
+                max_value = std::max(max_value, data[i]);
+            }
+        }
+    };
+
+    std::vector<TensorRange> ranges(1 + output_names_.size());
+    ranges[0].name = input_names_.empty() ? "input" : input_names_[0];
+    for (size_t i = 0; i < output_names_.size(); i++) {
+        ranges[1 + i].name = output_names_[i];
+    }
+
+    // Process the images in a deterministic order so that repeated calibration
+    // runs over the same corpus produce identical tables
+    std::vector<std::filesystem::path> image_paths;
+    for (const auto& entry : std::filesystem::directory_iterator(image_dir)) {
+        if (!entry.is_regular_file()) continue;
+        std::string extension = entry.path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp") {
+            image_paths.push_back(entry.path());
+        }
+    }
+    std::sort(image_paths.begin(), image_paths.end());
+
+    if (image_paths.empty()) {
+        GS_LOG_MSG(error, "CalibrateFromDirectory - no calibration images found in: " + image_dir);
+        return false;
+    }
+
+    GS_LOG_MSG(info, "Calibrating activation ranges over " + std::to_string(image_paths.size()) +
+               " images from: " + image_dir);
+
+    const size_t input_buffer_size = (size_t)1 * 3 * config_.input_width * config_.input_height;
+    int images_used = 0;
+
+    for (const auto& path : image_paths) {
+        cv::Mat image = GsImageIo::ReadImage(path.string(), cv::IMREAD_COLOR);
+        if (image.empty()) {
+            GS_LOG_MSG(warning, "CalibrateFromDirectory - could not read image: " + path.string());
+            continue;
+        }
+
+        try {
+            float* input_data = GetInputBuffer(input_buffer_size);
+            PreprocessImage(image, input_data);
+
+            ranges[0].Update(input_data, input_buffer_size);
+
+            std::vector<int64_t> input_shape = {1, 3, config_.input_height, config_.input_width};
+            auto input_tensor = Ort::Value::CreateTensor<float>(
+                *memory_info_, input_data, input_buffer_size,
+                input_shape.data(), input_shape.size());
+
+            auto output_tensors = session_->Run(
+                Ort::RunOptions{nullptr},
+                input_names_.data(), &input_tensor, 1,
+                output_names_.data(), output_names_.size());
+
+            for (size_t i = 0; i < output_tensors.size() && i < output_names_.size(); i++) {
+                auto shape = output_tensors[i].GetTensorTypeAndShapeInfo().GetShape();
+                int64_t count = std::accumulate(shape.begin(), shape.end(),
+                                                (int64_t)1, std::multiplies<int64_t>());
+                if (count > 0) {
+                    ranges[1 + i].Update(output_tensors[i].GetTensorMutableData<float>(), (size_t)count);
+                }
+            }
+
+            ReleaseBuffers();
+            images_used++;
+        } catch (const std::exception& e) {
+            ReleaseBuffers();
+            GS_LOG_MSG(warning, "CalibrateFromDirectory - inference failed for " +
+                       path.string() + ": " + std::string(e.what()));
+        }
+    }
+
+    if (images_used == 0) {
+        GS_LOG_MSG(error, "CalibrateFromDirectory - no calibration images could be processed");
+        return false;
+    }
+
+    std::ofstream table_file(output_table_path);
+    if (!table_file.is_open()) {
+        GS_LOG_MSG(error, "CalibrateFromDirectory - could not write table to: " + output_table_path);
+        return false;
+    }
+
+    table_file << "{\n";
+    table_file << "    \"model\": \"" << config_.model_path << "\",\n";
+    table_file << "    \"num_calibration_images\": " << images_used << ",\n";
+    table_file << "    \"tensor_ranges\": {\n";
+    for (size_t i = 0; i < ranges.size(); i++) {
+        table_file << "        \"" << ranges[i].name << "\": { \"min\": " << ranges[i].min_value
+                   << ", \"max\": " << ranges[i].max_value << " }"
+                   << (i + 1 < ranges.size() ? "," : "") << "\n";
+    }
+    table_file << "    }\n";
+    table_file << "}\n";
+    table_file.close();
+
+    GS_LOG_MSG(info, "Wrote calibration table for " + std::to_string(images_used) +
+               " images to: " + output_table_path +
+               ".  Feed this table to the offline static-quantization step to produce the INT8 model.");
+    return true;
+}
+
 namespace neon {
 
 #ifdef __ARM_NEON
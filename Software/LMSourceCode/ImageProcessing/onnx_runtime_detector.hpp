@@ -55,9 +55,38 @@ public:
 
         bool use_arm_compute_library = false; // ACL doesn't build properly
         bool use_xnnpack = true;  // XNNPACK is our primary provider
+
+        // FP16 support.  When set, the FP16-converted model is loaded (the
+        // conversion itself happens offline, like the INT8 one) and the
+        // input/output tensors are staged as half precision.  XNNPACK picks
+        // its FP16 NEON kernels from the model's element types, which is
+        // close to 2x FP32 throughput on Cortex-A76.  INT8, if also enabled
+        // and available, takes precedence.
         bool use_fp16 = false;
+        std::string fp16_model_path;  // Optional explicit path to the converted model.
+                                      // If empty, "<model>_fp16.onnx" is tried.
+
         bool use_int8_quantization = false;
 
+        // INT8 (QDQ) support.  XNNPACK executes a statically-quantized model's
+        // INT8 kernels directly, roughly doubling YOLO throughput on Pi-class
+        // CPUs.  The quantized model itself is produced offline from the FP32
+        // model plus the activation ranges captured by CalibrateFromDirectory().
+        std::string int8_model_path;        // Optional explicit path to the quantized model.
+                                            // If empty, "<model>_int8.onnx" is tried.
+        std::string calibration_image_dir;  // Directory of recorded strobed images used to
+                                            // capture activation ranges when no quantized
+                                            // model exists yet.
+        std::string calibration_table_path; // Where the captured ranges are written.  If
+                                            // empty, "calibration_ranges.json" is written
+                                            // next to the calibration images.
+
+        // Serialized optimized-model cache.  The first run writes the
+        // graph-optimized model next to model_path (keyed by a hash of the
+        // model file and the ORT version); later runs load that file
+        // directly and skip re-running graph optimization at startup.
+        bool use_optimized_model_cache = true;
+
         int num_threads = 3;  // Leave 1 core for system/camera on Pi
         bool use_thread_affinity = true;
         std::vector<int> cpu_cores = {1, 2, 3}; // Avoid core 0 (handles interrupts)
@@ -80,11 +109,32 @@ public:
     std::vector<Detection> Detect(const cv::Mat& image,
                                   PerformanceMetrics* metrics = nullptr);
 
+    // Runs detection over all images in a single session Run with a batched
+    // [N, 3, H, W] input tensor when the model's batch dimension allows it
+    // (dynamic, or matching N), avoiding N sequential inference calls.  Falls
+    // back to per-image inference for fixed batch-1 models.  When metrics is
+    // provided it reports the whole batch's preprocessing/inference/
+    // postprocessing timings.
     std::vector<std::vector<Detection>> DetectBatch(
-        const std::vector<cv::Mat>& images);
+        const std::vector<cv::Mat>& images,
+        PerformanceMetrics* metrics = nullptr);
 
     void WarmUp(int iterations = 10);
 
+    // Runs the (FP32) session over every image in image_dir and writes the
+    // per-tensor activation min/max ranges to output_table_path.  The table is
+    // the input to the offline static-quantization step that produces the
+    // INT8 QDQ model loaded when Config::use_int8_quantization is set.
+    bool CalibrateFromDirectory(const std::string& image_dir,
+                                const std::string& output_table_path);
+
+    // True when Initialize() loaded the INT8-quantized model rather than the
+    // FP32 one.
+    bool UsingInt8Model() const { return int8_model_active_; }
+
+    // True when Initialize() loaded the FP16-converted model.
+    bool UsingFp16Model() const { return fp16_model_active_; }
+
     size_t GetMemoryUsage() const;
 
     void SetThreadAffinity();
@@ -92,6 +142,15 @@ public:
 private:
     Config config_;
     LetterboxParams letterbox_params_;  // Store letterbox parameters for coordinate conversion
+    bool int8_model_active_ = false;
+    bool fp16_model_active_ = false;
+    bool input_is_fp16_ = false;        // The loaded model's input tensor is float16
+
+    // Reused staging buffers for the FP16 path - the preprocessed FP32 blob
+    // is converted into fp16_input_buffer_ before Run, and a float16 output
+    // is widened into fp16_output_buffer_ for postprocessing
+    std::vector<uint16_t> fp16_input_buffer_;
+    std::vector<float> fp16_output_buffer_;
 
     std::unique_ptr<Ort::Env> env_;
     std::unique_ptr<Ort::SessionOptions> session_options_;
@@ -99,6 +158,26 @@ private:
     std::unique_ptr<Ort::AllocatorWithDefaultOptions> allocator_;
     std::unique_ptr<Ort::MemoryInfo> memory_info_;
 
+    // When the memory pool is enabled and the model's input/output shapes
+    // are fully static FP32, the input and output tensors are created once
+    // over the pool's buffers and pre-bound to the session (see
+    // SetupIoBinding).  Steady-state Detect() calls then run with no
+    // per-inference tensor creation and no output allocation at all.  The
+    // raw pointers record which buffers the bound tensors wrap, so the
+    // bound run is skipped if the pool ever reallocates (e.g., for a
+    // larger DetectBatch blob).
+    std::unique_ptr<Ort::IoBinding> io_binding_;
+    Ort::Value bound_input_tensor_{nullptr};
+    Ort::Value bound_output_tensor_{nullptr};
+    float* bound_input_data_ = nullptr;
+    float* bound_output_data_ = nullptr;
+    size_t bound_output_element_count_ = 0;
+
+    // True once a shared CPU arena of Config::memory_pool_size_mb has been
+    // registered with the ORT environment (see Initialize) - the session
+    // then draws its internal allocations from that one up-front arena.
+    bool arena_registered_ = false;
+
     std::vector<std::unique_ptr<char[]>> input_names_storage_;
     std::vector<std::unique_ptr<char[]>> output_names_storage_;
     std::vector<const char*> input_names_;
@@ -153,10 +232,22 @@ private:
     std::atomic<float> avg_inference_time_ms_{0};
 
     void InitializeSession();
+    std::string ResolveModelPath();
+    std::string ResolveOptimizedModelCachePath(const std::string& model_path);
     void ConfigureSessionOptions();
     void SetupExecutionProviders();
     void CacheModelInfo();
     void InitializeMemoryPool();
+    void SetupIoBinding();
+
+    // Wraps the preprocessed FP32 blob as the session's input tensor,
+    // converting to half precision first when the model takes float16
+    Ort::Value CreateInputTensor(float* input_data, size_t element_count,
+                                 const std::vector<int64_t>& input_shape);
+
+    // Returns the output tensor's data as FP32, widening a float16 output
+    // into fp16_output_buffer_ when necessary
+    const float* OutputTensorAsFloat(Ort::Value& tensor, int64_t element_count);
 
     void PreprocessImage(const cv::Mat& image, float* output_tensor);
     void PreprocessImageNEON(const cv::Mat& image, float* output_tensor);
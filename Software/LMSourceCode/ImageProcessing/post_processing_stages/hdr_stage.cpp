@@ -264,11 +264,26 @@ HdrImage HdrImage::LpFilter(LpFilterConfig const &config) const
 
 Histogram HdrImage::CalculateHistogram() const
 {
-	std::vector<uint32_t> bins(dynamic_range);
+	// Four separate copies of the bins, merged at the end. Neighbouring pixels
+	// frequently land in the same bin, and with a single copy each increment
+	// then has to wait for the previous store to that bin; spreading them
+	// across four arrays breaks the dependency chain.
+	std::vector<uint32_t> bins(dynamic_range * 4);
 	std::fill(bins.begin(), bins.end(), 0);
-	for (int i = 0; i < width * height; i++)
-		bins[P(i)]++;
-	return Histogram(&bins[0], dynamic_range);
+	uint32_t *b0 = &bins[0], *b1 = b0 + dynamic_range, *b2 = b1 + dynamic_range, *b3 = b2 + dynamic_range;
+	int num = width * height, i = 0;
+	for (; i + 4 <= num; i += 4)
+	{
+		b0[P(i)]++;
+		b1[P(i + 1)]++;
+		b2[P(i + 2)]++;
+		b3[P(i + 3)]++;
+	}
+	for (; i < num; i++)
+		b0[P(i)]++;
+	for (int b = 0; b < dynamic_range; b++)
+		b0[b] += b1[b] + b2[b] + b3[b];
+	return Histogram(b0, dynamic_range);
 }
 
 // This creates the tone curve that we apply to the low pass image using the list of
@@ -21,6 +21,8 @@
 
 
 
+#include <cstring>
+
 #include <opencv2/core.hpp>
 #include <opencv2/photo.hpp>
 #include <opencv2/core/cvdef.h>
@@ -42,11 +44,60 @@
 
 
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace gs = golf_sim;
 using Stream = libcamera::Stream;
 
 #define NAME "motion_detect"
 
+#if defined(__aarch64__)
+// Counts the lanes of one 8-pixel group whose absolute difference exceeds the
+// per-pixel threshold (difference_m * old + difference_c).  The threshold is
+// evaluated in float32 with a separate multiply and add, mirroring the scalar
+// expression in the frame-differencing loop below.
+static inline unsigned int CountChangedPixels8(uint16x8_t diff, uint16x8_t old_px,
+											   float32x4_t difference_m, float32x4_t difference_c)
+{
+	float32x4_t old_lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(old_px)));
+	float32x4_t old_hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(old_px)));
+
+	float32x4_t threshold_lo = vaddq_f32(vmulq_f32(difference_m, old_lo), difference_c);
+	float32x4_t threshold_hi = vaddq_f32(vmulq_f32(difference_m, old_hi), difference_c);
+
+	float32x4_t diff_lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(diff)));
+	float32x4_t diff_hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(diff)));
+
+	uint32x4_t exceeded_lo = vcgtq_f32(diff_lo, threshold_lo);
+	uint32x4_t exceeded_hi = vcgtq_f32(diff_hi, threshold_hi);
+
+	// Exceeded lanes are all-ones; mask each down to 1 and sum across lanes.
+	uint32x4_t ones = vdupq_n_u32(1);
+	return vaddvq_u32(vaddq_u32(vandq_u32(exceeded_lo, ones), vandq_u32(exceeded_hi, ones)));
+}
+
+// Diffs 16 new pixels against 16 contiguous previous-frame pixels, updates the
+// previous-frame buffer, and returns how many of them changed by more than the
+// per-pixel threshold.
+static inline unsigned int DiffAndUpdate16(uint8x16_t new_px, uint8_t *old_value_ptr,
+										   float32x4_t difference_m, float32x4_t difference_c)
+{
+	uint8x16_t old_px = vld1q_u8(old_value_ptr);
+
+	// Update the previous-frame buffer, just as the scalar loop does
+	vst1q_u8(old_value_ptr, new_px);
+
+	uint8x16_t diff = vabdq_u8(new_px, old_px);
+
+	return CountChangedPixels8(vmovl_u8(vget_low_u8(diff)), vmovl_u8(vget_low_u8(old_px)),
+							   difference_m, difference_c) +
+		   CountChangedPixels8(vmovl_u8(vget_high_u8(diff)), vmovl_u8(vget_high_u8(old_px)),
+							   difference_m, difference_c);
+}
+#endif
+
 
 MotionDetectStage::Config MotionDetectStage::incoming_configuration;
 
@@ -102,24 +153,68 @@ void MotionDetectStage::Configure()
 {
 	GS_LOG_MSG(trace, "MotionDetectStage::Configure");
 
-	// Use the kNumberFramesToSaveBeforeHit to size the circular buffer.
+	// Size the circular buffer from the pre-hit window (a frame count, or
+	// kPreTriggerWindowSecs' worth of frames at the configured rate) plus
+	// the post-hit frames.
 	if (gs::GolfSimClubData::kGatherClubData) {
-		int final_frame_buffer_size = 1 + gs::GolfSimClubData::kNumberFramesToSaveBeforeHit + 
+		int final_frame_buffer_size = 1 + gs::GolfSimClubData::GetPreTriggerFrameCount() +
 			gs::GolfSimClubData::kNumberFramesToSaveAfterHit;
 		golf_sim::RecentFrames.resize(final_frame_buffer_size);
 
 		GS_LOG_MSG(trace, "Circular frame buffer size re-set to: " + std::to_string(final_frame_buffer_size));
 	}
 
-	// Let's process the main stream!
-	// stream_ = app_->LoresStream(&info);
-	stream_ = app_->GetMainStream();
-	
-	if (!stream_)
+	// The handoff ring the capture path pushes into is preallocated here,
+	// before the loop starts, so that Push() never has to allocate.
+	golf_sim::RecentFrameRingBuffer.Resize(golf_sim::RecentFrames.capacity());
+
+	main_stream_ = app_->GetMainStream();
+
+	if (!main_stream_)
 		return;
 
+	// Analyze the low-resolution stream when one was configured (see
+	// LibCameraInterface::kUseLowResWatchStream).  Otherwise analyze the main
+	// stream as before.  Either way, the club-strike frames saved in Process()
+	// always come from the main stream at the full cropped resolution.
+	stream_ = app_->LoresStream();
+	if (!stream_) {
+		stream_ = main_stream_;
+	}
+
 	StreamInfo info = app_->GetStreamInfo(stream_);
 
+	// Remember the ROI in main-stream pixels for drawing on the saved frames,
+	// which may be a different resolution than the analyzed ones.
+	roi_draw_x_ = (uint)config_.roi_x;
+	roi_draw_y_ = (uint)config_.roi_y;
+	roi_draw_width_ = (uint)config_.roi_width;
+	roi_draw_height_ = (uint)config_.roi_height;
+
+	// The incoming ROI is specified in main-stream pixels.  If we are analyzing
+	// the low-resolution stream, scale it into that frame before the
+	// skip-factor math below.  Note that config_ itself is left untouched, as
+	// Configure() can be called again on a camera re-configuration.
+	float scaled_roi_x = config_.roi_x;
+	float scaled_roi_y = config_.roi_y;
+	float scaled_roi_width = config_.roi_width;
+	float scaled_roi_height = config_.roi_height;
+
+	if (stream_ != main_stream_) {
+		StreamInfo main_info = app_->GetStreamInfo(main_stream_);
+
+		float x_scale = (float)info.width / (float)main_info.width;
+		float y_scale = (float)info.height / (float)main_info.height;
+
+		scaled_roi_x *= x_scale;
+		scaled_roi_y *= y_scale;
+		scaled_roi_width *= x_scale;
+		scaled_roi_height *= y_scale;
+
+		GS_LOG_MSG(trace, "Analyzing low-res stream of " + std::to_string(info.width) + "x" + std::to_string(info.height) +
+			" instead of main stream of " + std::to_string(main_info.width) + "x" + std::to_string(main_info.height) + ".");
+	}
+
 	config_.hskip = std::max(config_.hskip, 1);
 	config_.vskip = std::max(config_.vskip, 1);
 
@@ -127,14 +222,14 @@ void MotionDetectStage::Configure()
 	info.height /= config_.vskip;
 
 	// Store ROI values as if in an image subsampled by hskip and vskip.
-	roi_x_ = config_.roi_x / config_.hskip;
-	roi_y_ = config_.roi_y / config_.vskip;
+	roi_x_ = scaled_roi_x / config_.hskip;
+	roi_y_ = scaled_roi_y / config_.vskip;
 
-	GS_LOG_MSG(trace, "After decimating, config_.roi_x = " + std::to_string(config_.roi_x) + ", config_.roi_y = " + std::to_string(config_.roi_y));
+	GS_LOG_MSG(trace, "After decimating, scaled_roi_x = " + std::to_string(scaled_roi_x) + ", scaled_roi_y = " + std::to_string(scaled_roi_y));
 	GS_LOG_MSG(trace, "roi_x_ = " + std::to_string(roi_x_) + ", roi_y_ = " + std::to_string(roi_y_));
 
-	roi_width_ = config_.roi_width / config_.hskip;
-	roi_height_ = config_.roi_height / config_.vskip;
+	roi_width_ = scaled_roi_width / config_.hskip;
+	roi_height_ = scaled_roi_height / config_.vskip;
 
 	// config_.region_threshold is a % of pixels that have changed
 	// scale it down based on the fraction the ROI is of the whole
@@ -177,6 +272,25 @@ void MotionDetectStage::Configure()
 	}
 }
 
+void MotionDetectStage::SetLoadShedLevel(int level)
+{
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	level = std::clamp(level, 0, kMaxLoadShedLevel);
+	if (level == load_shed_level_)
+		return;
+
+	// Dropping back below the row-subsampled level leaves the skipped rows of
+	// previous_frame_ stale, so re-seed the comparison frame to avoid a burst
+	// of phantom differences (and a false trigger) on the next frame.
+	if (load_shed_level_ >= 2 && level < 2) {
+		first_time_ = true;
+	}
+
+	GS_LOG_MSG(trace, "MotionDetectStage::SetLoadShedLevel - level now " + std::to_string(level));
+	load_shed_level_ = level;
+}
+
 bool MotionDetectStage::Process(CompletedRequestPtr& completed_request)
 {
 	if (!stream_) {
@@ -184,6 +298,16 @@ bool MotionDetectStage::Process(CompletedRequestPtr& completed_request)
 		return false;
 	}
 
+	// The post-processing framework owns this thread, so promote it (once per thread) to the
+	// latency-critical scheduling class.  This is the thread that detects the hit and calls
+	// SendExternalTrigger, and any preemption between those two points adds jitter to the
+	// strobe timing that the downstream ball-speed math assumes is exact.
+	static thread_local bool realtime_scheduling_applied = false;
+	if (!realtime_scheduling_applied) {
+		gs::PulseStrobe::ApplyRealtimeTriggerScheduling();
+		realtime_scheduling_applied = true;
+	}
+
 	completed_request->post_process_metadata.Set("motion_detect.result", false);
 
 	if (detectionPaused_ && postMotionFramesToCapture_ <= 0) {
@@ -223,6 +347,12 @@ bool MotionDetectStage::Process(CompletedRequestPtr& completed_request)
 			uint8_t *new_value_ptr = image + ((roi_y_ + y) * sampledFrameStride) + (roi_x_ * config_.hskip);
 			uint8_t *old_value_ptr = &previous_frame_[0] + y * roi_width_;
 
+			// With contiguous pixels the row can be seeded in a single copy
+			if (config_.hskip == 1) {
+				memcpy(old_value_ptr, new_value_ptr, roi_width_);
+				continue;
+			}
+
 			// Now traverse across the incoming frame in the x direction for this row
 			for (unsigned int x = 0; x < roi_width_; x++, new_value_ptr += config_.hskip) {
 				*(old_value_ptr++) = *new_value_ptr;
@@ -245,28 +375,71 @@ bool MotionDetectStage::Process(CompletedRequestPtr& completed_request)
 
 	unsigned int regions = 0;
 
+	// At load-shedding level 2 only every other ROI row is examined, and the
+	// changed-pixel threshold scales down with the rows actually visited.
+	unsigned int row_step = (load_shed_level_ >= 2) ? 2 : 1;
+	unsigned int region_threshold = region_threshold_ / row_step;
+
 	// Count the  pixels where the difference between the new and previous values
 	// exceeds the threshold. At the same time, update the previous image buffer.
-	for (unsigned int y = 0; !local_motion_detected && y < roi_height_; y++)
+	for (unsigned int y = 0; !local_motion_detected && y < roi_height_; y += row_step)
 	{
 		uint8_t* new_value_ptr = image + ((roi_y_ + y) * sampledFrameStride) + (roi_x_ * config_.hskip);
 		uint8_t* old_value_ptr = &previous_frame_[0] + y * roi_width_;
-		for (unsigned int x = 0; x < roi_width_; x++, new_value_ptr += config_.hskip)
-		{
-			int new_value = *new_value_ptr;
-			int old_value = *old_value_ptr;
 
-			// TBD - Remove
-			// LOG(1, "sampledFrameStride: " << sampledFrameStride << ". old= " << old_value << " new= " << new_value << " .New_ptr: " << (long)new_value_ptr << ".Old_ptr : " << (long)old_value_ptr << ".");
+		unsigned int x = 0;
+
+#if defined(__aarch64__)
+		// Vectorized absolute-difference and threshold count, 16 pixels per
+		// iteration.  Covers the contiguous case (hskip of 1) and the usual
+		// subsampled case (hskip of 2), where a de-interleaving load picks up
+		// just the even-numbered pixels.  Bails out of the row as soon as the
+		// changed-pixel count crosses the hit threshold - the scalar loop below
+		// would keep counting to the end of the row, but the count is only ever
+		// compared against the threshold, and once motion is flagged the rest
+		// of the previous-frame update no longer matters.
+		if (config_.hskip == 1) {
+			float32x4_t difference_m = vdupq_n_f32(config_.difference_m);
+			float32x4_t difference_c = vdupq_n_f32((float)config_.difference_c);
+
+			for (; x + 16 <= roi_width_ && regions < region_threshold;
+				 x += 16, new_value_ptr += 16, old_value_ptr += 16)
+			{
+				regions += DiffAndUpdate16(vld1q_u8(new_value_ptr), old_value_ptr,
+										   difference_m, difference_c);
+			}
+		}
+		else if (config_.hskip == 2) {
+			float32x4_t difference_m = vdupq_n_f32(config_.difference_m);
+			float32x4_t difference_c = vdupq_n_f32((float)config_.difference_c);
+
+			for (; x + 16 <= roi_width_ && regions < region_threshold;
+				 x += 16, new_value_ptr += 32, old_value_ptr += 16)
+			{
+				regions += DiffAndUpdate16(vld2q_u8(new_value_ptr).val[0], old_value_ptr,
+										   difference_m, difference_c);
+			}
+		}
+#endif
+
+		if (regions < region_threshold) {
+			for (; x < roi_width_; x++, new_value_ptr += config_.hskip)
+			{
+				int new_value = *new_value_ptr;
+				int old_value = *old_value_ptr;
 
+				// TBD - Remove
+				// LOG(1, "sampledFrameStride: " << sampledFrameStride << ". old= " << old_value << " new= " << new_value << " .New_ptr: " << (long)new_value_ptr << ".Old_ptr : " << (long)old_value_ptr << ".");
 
-			*(old_value_ptr++) = new_value;
-			if (std::abs(new_value - old_value) > (config_.difference_m * (float)old_value + config_.difference_c)) {
-				regions++;
+
+				*(old_value_ptr++) = new_value;
+				if (std::abs(new_value - old_value) > (config_.difference_m * (float)old_value + config_.difference_c)) {
+					regions++;
+				}
 			}
 		}
 
-		local_motion_detected = (regions >= region_threshold_);
+		local_motion_detected = (regions >= region_threshold);
 
 		// Break out early if we've already figured out there's motion
 		if (local_motion_detected) {
@@ -296,7 +469,12 @@ bool MotionDetectStage::Process(CompletedRequestPtr& completed_request)
 		if (config_.verbose)
 			LOG(1, "Saving Image x,y: " << info.width << ", " << info.height << " .");
 
-		// For now, as soon as we detect motion (except for a few frames) we stop recording.  This 
+		// Keep the frames around the hit at full resolution - from here on,
+		// nothing already inside the full-resolution window gets demoted to
+		// a thumbnail, and the post-hit frames are pushed full-size.
+		golf_sim::RecentFrameRingBuffer.SuspendDemotion();
+
+		// For now, as soon as we detect motion (except for a few frames) we stop recording.  This
 		// and reduces unnecessary processing overhead.
 		detectionPaused_ = true;
 		if (gs::GolfSimClubData::kGatherClubData ) {
@@ -336,13 +514,31 @@ bool MotionDetectStage::Process(CompletedRequestPtr& completed_request)
 		frameInfo.requestSequence = completed_request->sequence;
 		frameInfo.frameRate = completed_request->framerate;
 
+		// Carry the hardware capture time along with the frame - downstream
+		// timing should prefer it over anything observed in software.
+		auto sensor_timestamp = completed_request->metadata.get(libcamera::controls::SensorTimestamp);
+		frameInfo.sensorTimestampNs = sensor_timestamp ? (uint64_t)*sensor_timestamp : 0;
+
 		// If we haven't started taking any post-motion frames yet, then this is the frame
 		// during which the movement was first detected.
 		frameInfo.isballHitFrame = (postMotionFramesToCapture_ == gs::GolfSimClubData::kNumberFramesToSaveAfterHit);
 
-		cv::Mat mat = cv::Mat(info.height, info.width, CV_8U, image, info.stride);
+		// The saved frames always come from the main (full cropped resolution)
+		// stream, which is not necessarily the stream that was just analyzed.
+		libcamera::FrameBuffer *save_buffer = completed_request->buffers[main_stream_];
+
+		BufferReadSync save_r(app_, save_buffer);
+
+		const std::vector<libcamera::Span<uint8_t>> save_mem = save_r.Get();
+
+		StreamInfo save_info = app_->GetStreamInfo(main_stream_);
+
+		cv::Mat mat = cv::Mat(save_info.height, save_info.width, CV_8U, (uint8_t *)save_mem[0].data(), save_info.stride);
 
-		if (config_.showroi) {
+		// At load-shedding level 1+ the diagnostic overlays (ROI rectangle and
+		// frame numbering) are skipped - they cost a rectangle and a text
+		// render on every saved frame.
+		if (config_.showroi && load_shed_level_ < 1) {
 			cv::Scalar c_black{ 0, 0, 0 }; // black
 			cv::Scalar c_green{ 170, 255, 0 }; // bright green
 
@@ -351,35 +547,51 @@ bool MotionDetectStage::Process(CompletedRequestPtr& completed_request)
 
 			cv::Scalar rectangle_color = frameInfo.isballHitFrame ? c_green : c_black;
 
-			cv::Point startPoint = cv::Point(roi_x_ * config_.hskip, roi_y_ * config_.vskip);
+			cv::Point startPoint = cv::Point(roi_draw_x_, roi_draw_y_);
 
-			cv::Point endPoint = cv::Point((roi_x_ + roi_width_) * config_.hskip, (roi_y_ + roi_height_) * config_.vskip);
+			cv::Point endPoint = cv::Point(roi_draw_x_ + roi_draw_width_, roi_draw_y_ + roi_draw_height_);
 
 			cv::rectangle(mat, startPoint, endPoint, rectangle_color, rectWidth);
 		}
 
-		// Number the frame 
-		cv::Scalar c_label{ 170, 255, 0 }; // bright green
-		std::string frame_label = std::to_string(completed_request->sequence);
-		int text_x = info.width - 60;
-		int text_y = 25;
+		if (load_shed_level_ < 1) {
+			// Number the frame
+			cv::Scalar c_label{ 170, 255, 0 }; // bright green
+			std::string frame_label = std::to_string(completed_request->sequence);
+			int text_x = save_info.width - 60;
+			int text_y = 25;
 
-		cv::putText(mat, frame_label, cv::Point(text_x, text_y), cv::FONT_HERSHEY_SIMPLEX, 0.8, c_label, 2, cv::LINE_AA);
+			cv::putText(mat, frame_label, cv::Point(text_x, text_y), cv::FONT_HERSHEY_SIMPLEX, 0.8, c_label, 2, cv::LINE_AA);
+		}
 
 		// TBD - Too Much Logging - GS_LOG_MSG(trace, "Pushing Post-Motion Frame No. " + std::to_string(postMotionFramesToCapture_) + " - Seq. No. " + std::to_string(completed_request->sequence));
 
-		golf_sim::RecentFrames.push_back(frameInfo);
-
-		golf_sim::RecentFrameInfo& enqueuedFrameInfo = golf_sim::RecentFrames.back();
-
-		// Make sure that the enqueued frame info has its own Mat, as the push_back
-		// might only do a shallow copy. TBD - figure this out!
-		enqueuedFrameInfo.mat = mat.clone();
+		if (gs::GolfSimClubData::kRetainZeroCopyFrames) {
+			// Zero-copy path - enqueue the Mat as a direct view of the mmap'd
+			// frame buffer and hold onto the completed request as a fence.  The
+			// request keeps the buffer mapped and out of the camera's re-queue
+			// until this ring entry is overwritten or drained, at which point
+			// the shared_ptr releases it.  At the 200+fps rates the ball
+			// watcher runs at, this avoids a ~1.5MB memcpy on every frame, but
+			// it does withhold a buffer from the camera for each entry, so the
+			// buffer count must cover the ring depth.
+			frameInfo.mat = mat;
+			frameInfo.bufferFence = completed_request;
+		}
+		else {
+			// The enqueued frame info needs its own Mat, as the camera will
+			// overwrite the underlying buffer on a later frame.
+			frameInfo.mat = mat.clone();
+		}
 
-		if (enqueuedFrameInfo.mat.empty()) {
+		if (frameInfo.mat.empty()) {
 			GS_LOG_MSG(error, "Enqueued a null club data image");
 		}
 
+		// Hand the frame to the analysis side without taking any lock - the
+		// capture path must never block here.
+		golf_sim::RecentFrameRingBuffer.Push(std::move(frameInfo));
+
 		if (need_to_log_first_image_) {
 			gs::LoggingTools::LogImage("", mat, std::vector < cv::Point >{}, true, "gs_log_first_cropped_image_of_teed_ball.png");
 			need_to_log_first_image_ = false;  // Don't save again
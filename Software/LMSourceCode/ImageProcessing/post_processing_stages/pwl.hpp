@@ -76,13 +76,31 @@ public:
 	// Make "this" match (at least) the given domain. Any extension my be
 	// clipped or linear.
 	void MatchDomain(Interval const &domain, bool clip = true, const double eps = 1e-6);
-	// Generate a LUT for this funciton.
+	// Generate a LUT for this function. Rather than calling Eval() for every
+	// entry (which repeats the span search and interpolation arithmetic each
+	// time), walk the spans once and step the value by the span's slope. The
+	// value is recomputed exactly on every span change so no error accumulates
+	// beyond a span.
 	template <typename T> std::vector<T> GenerateLut() const
 	{
 		int end = Domain().end + 1, span = 0;
+		int last_span = points_.size() - 2;
 		std::vector<T> lut(end);
+		double slope = (points_[1].y - points_[0].y) / (points_[1].x - points_[0].x);
+		double span_end = points_[1].x;
+		double y = points_[0].y - points_[0].x * slope;
 		for (int x = 0; x < end; x++)
-			lut[x] = Eval(x, &span);
+		{
+			while (span < last_span && x >= span_end)
+			{
+				span++;
+				span_end = points_[span + 1].x;
+				slope = (points_[span + 1].y - points_[span].y) / (points_[span + 1].x - points_[span].x);
+				y = points_[span].y + (x - points_[span].x) * slope;
+			}
+			lut[x] = y;
+			y += slope;
+		}
 		return lut;
 	}
 	Pwl &operator*=(double d);
@@ -20,6 +20,8 @@
 #include <sys/time.h>
 #include <signal.h>
 #include <sys/signalfd.h>
+#include <pthread.h>
+#include <sched.h>
 
 #else
 #define NOMINMAX  // Get rid of a std::min/max compile issue
@@ -67,6 +69,18 @@ namespace golf_sim {
 	long PulseStrobe::kPauseBeforeReadyForTriggerMicroSeconds = 100;
 	int PulseStrobe::kPauseToSetUpInnoMakerExternalTriggerMilliseconds = 1000;
 	int PulseStrobe::kPauseBeforeReadyForFinalPrimingPulseMs = 100;
+	long PulseStrobe::kPauseBeforeSendingImageFlushMs = 0;
+
+	bool PulseStrobe::kUseRealtimeTriggerThread = false;
+	int PulseStrobe::kRealtimeTriggerPriority = 50;
+	int PulseStrobe::kRealtimeTriggerCpuCore = 3;
+
+	bool PulseStrobe::kUseAsyncStrobeSend = false;
+	std::thread* PulseStrobe::strobe_send_thread_ = nullptr;
+	std::mutex PulseStrobe::strobe_send_mutex_;
+	std::condition_variable PulseStrobe::strobe_send_cv_;
+	bool PulseStrobe::strobe_send_requested_ = false;
+	bool PulseStrobe::strobe_send_shutdown_ = false;
 
 
 	int PulseStrobe::kLastPulsePutterRepeats = 5;
@@ -442,6 +456,11 @@ namespace golf_sim {
 		GolfSimConfiguration::SetConstant("gs_config.strobing.kPauseBeforeReadyForTriggerMicroSeconds", kPauseBeforeReadyForTriggerMicroSeconds);
 		GolfSimConfiguration::SetConstant("gs_config.strobing.kPauseToSetUpInnoMakerExternalTriggerMilliseconds", kPauseToSetUpInnoMakerExternalTriggerMilliseconds);
 		GolfSimConfiguration::SetConstant("gs_config.strobing.kPauseBeforeReadyForFinalPrimingPulseMs", kPauseBeforeReadyForFinalPrimingPulseMs);
+		GolfSimConfiguration::SetConstant("gs_config.strobing.kPauseBeforeSendingImageFlushMs", kPauseBeforeSendingImageFlushMs);
+		GolfSimConfiguration::SetConstant("gs_config.strobing.kUseRealtimeTriggerThread", kUseRealtimeTriggerThread);
+		GolfSimConfiguration::SetConstant("gs_config.strobing.kRealtimeTriggerPriority", kRealtimeTriggerPriority);
+		GolfSimConfiguration::SetConstant("gs_config.strobing.kRealtimeTriggerCpuCore", kRealtimeTriggerCpuCore);
+		GolfSimConfiguration::SetConstant("gs_config.strobing.kUseAsyncStrobeSend", kUseAsyncStrobeSend);
 
 		gpio_system_initialized_ = true;
 
@@ -517,6 +536,46 @@ namespace golf_sim {
 		}
 
 #endif // #ifdef __unix__  // Ignore in Windows environment
+
+		if (!BuildCachedPulseTrains()) {
+			return false;
+		}
+
+#ifdef __unix__  // Ignore in Windows environment
+		if (kUseAsyncStrobeSend && strobe_send_thread_ == nullptr) {
+			GS_LOG_TRACE_MSG(trace, "PulseStrobe::InitGPIOSystem - starting asynchronous strobe-send thread.");
+			strobe_send_requested_ = false;
+			strobe_send_shutdown_ = false;
+			strobe_send_thread_ = new std::thread(StrobeSendThreadLoop);
+		}
+#endif // #ifdef __unix__  // Ignore in Windows environment
+
+		return true;
+	}
+
+	void PulseStrobe::StrobeSendThreadLoop() {
+
+		// This worker is the thread that actually fires the strobes, so it takes on the
+		// latency-critical scheduling mode if one is configured.
+		ApplyRealtimeTriggerScheduling();
+
+		for (;;) {
+			std::unique_lock<std::mutex> lock(strobe_send_mutex_);
+			strobe_send_cv_.wait(lock, []() { return strobe_send_requested_ || strobe_send_shutdown_; });
+
+			if (strobe_send_shutdown_) {
+				break;
+			}
+
+			strobe_send_requested_ = false;
+			lock.unlock();
+
+			SendExternalTriggerSynchronously();
+		}
+	}
+
+	bool PulseStrobe::BuildCachedPulseTrains() {
+
 		// Pull the pulse intervals and strobe-on times from the JSON file each time to allow changes on the fly
 		GolfSimConfiguration::SetConstant("gs_config.strobing.kStrobePulseVectorDriver", pulse_intervals_fast_ms_);
 		GolfSimConfiguration::SetConstant("gs_config.strobing.kStrobePulseVectorPutter", pulse_intervals_slow_ms_);
@@ -537,6 +596,14 @@ namespace golf_sim {
 		GolfSimConfiguration::SetConstant("gs_config.strobing.kBaudRateForFastPulses", kBaudRateForFastPulses);
 		GolfSimConfiguration::SetConstant("gs_config.strobing.kBaudRateForSlowPulses", kBaudRateForSlowPulses);
 
+		// Release any previously-cached sequences before rebuilding them
+		delete[] camera_fast_pulse_sequence_;
+		camera_fast_pulse_sequence_ = nullptr;
+		delete[] camera_slow_pulse_sequence_;
+		camera_slow_pulse_sequence_ = nullptr;
+		delete[] tail_repeat_pulse_sequence_;
+		tail_repeat_pulse_sequence_ = nullptr;
+
 		// Pre-compute the pulse sequences to save time later
 		GS_LOG_TRACE_MSG(trace, "Building Fast pulse sequence.");
 		camera_fast_pulse_sequence_ = PulseStrobe::BuildPulseTrain((unsigned long)kBaudRateForFastPulses, pulse_intervals_fast_ms_, number_bits_for_fast_on_pulse_,
@@ -556,10 +623,62 @@ namespace golf_sim {
 		return true;
 	}
 
+	bool PulseStrobe::ApplyRealtimeTriggerScheduling() {
+
+		if (!kUseRealtimeTriggerThread) {
+			return true;
+		}
+
+#ifdef __unix__  // Ignore in Windows environment
+
+		struct sched_param param = {};
+
+		// Keep the configured priority within whatever range this kernel supports
+		int priority = std::min(std::max(kRealtimeTriggerPriority, sched_get_priority_min(SCHED_FIFO)),
+								sched_get_priority_max(SCHED_FIFO));
+		param.sched_priority = priority;
+
+		if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+			GS_LOG_MSG(warning, "PulseStrobe::ApplyRealtimeTriggerScheduling could not set SCHED_FIFO priority " +
+				std::to_string(priority) + ". The process likely lacks CAP_SYS_NICE (try running as root or setting a rtprio limit). " +
+				"Continuing under the default scheduler.");
+			return false;
+		}
+
+		if (kRealtimeTriggerCpuCore >= 0) {
+			cpu_set_t cpuset;
+			CPU_ZERO(&cpuset);
+			CPU_SET(kRealtimeTriggerCpuCore, &cpuset);
+
+			if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0) {
+				GS_LOG_MSG(warning, "PulseStrobe::ApplyRealtimeTriggerScheduling could not pin the trigger thread to core " +
+					std::to_string(kRealtimeTriggerCpuCore) + ".");
+			}
+		}
+
+		GS_LOG_MSG(info, "Trigger thread is now running SCHED_FIFO at priority " + std::to_string(priority) +
+			" on core " + std::to_string(kRealtimeTriggerCpuCore) + ".");
+
+#endif // #ifdef __unix__  // Ignore in Windows environment
+
+		return true;
+	}
+
 	bool PulseStrobe::DeinitGPIOSystem() {
 #ifdef __unix__  // Ignore in Windows environment
 		GS_LOG_TRACE_MSG(trace, "PulseStrobe::DeinitGPIOSystem.");
 
+		if (strobe_send_thread_ != nullptr) {
+			{
+				std::lock_guard<std::mutex> lock(strobe_send_mutex_);
+				strobe_send_shutdown_ = true;
+			}
+			strobe_send_cv_.notify_one();
+			strobe_send_thread_->join();
+			delete strobe_send_thread_;
+			strobe_send_thread_ = nullptr;
+		}
+
 		if (spiOpen_) {
 			lgSpiClose(spiHandle_);
 			spiHandle_ = -1;
@@ -598,6 +717,14 @@ namespace golf_sim {
 		// Re-establish putting delay each time to make it easier to adjust on the fly
 		GolfSimConfiguration::SetConstant("gs_config.strobing.kPuttingStrobeDelayMs", kPuttingStrobeDelayMs);
 
+		// Likewise, rebuild the cached pulse sequences now, while we are still safely ahead of
+		// the shot.  Any .json strobing changes take effect here, and the later trigger path
+		// only ever hands a ready buffer to the SPI driver.
+		if (!BuildCachedPulseTrains()) {
+			GS_LOG_MSG(error, "Could not BuildCachedPulseTrains.");
+			return false;
+		}
+
 		// Make sure we are sending pulses at a known speed.  In this case, in the "fast" setting
 		unsigned int baud_rate = 0;
 
@@ -673,8 +800,6 @@ namespace golf_sim {
 			SendCameraStrobeTriggerAndShutter(lggpio_chip_handle_);
 			GS_LOG_TRACE_MSG(trace, "Sent pre-image trigger.");
 
-			long kPauseBeforeSendingImageFlushMs = 0;
-			GolfSimConfiguration::SetConstant("gs_config.strobing.kPauseBeforeSendingImageFlushMs", kPauseBeforeSendingImageFlushMs);
 			usleep(kPauseBeforeSendingImageFlushMs * 1000);
 
 			// This acts as a flush, and it forces the actual image to be received and processed
@@ -713,6 +838,26 @@ namespace golf_sim {
 
 	bool PulseStrobe::SendExternalTrigger() {
 
+#ifdef __unix__  // Ignore in Windows environment
+
+		// Queue the (blocking) SPI write on the strobe-send worker so that this thread -
+		// typically the ball-watcher - can immediately resume capturing frames instead of
+		// stalling for the full pulse-train duration.
+		if (kUseAsyncStrobeSend && strobe_send_thread_ != nullptr) {
+			{
+				std::lock_guard<std::mutex> lock(strobe_send_mutex_);
+				strobe_send_requested_ = true;
+			}
+			strobe_send_cv_.notify_one();
+			return true;
+		}
+#endif // #ifdef __unix__  // Ignore in Windows environment
+
+		return SendExternalTriggerSynchronously();
+	}
+
+	bool PulseStrobe::SendExternalTriggerSynchronously() {
+
 #ifdef __unix__  // Ignore in Windows environment
 
 		// GS_LOG_TRACE_MSG(trace, "Sent final camera trigger(s) and strobe pulses.");
@@ -722,8 +867,7 @@ namespace golf_sim {
 
 			GS_LOG_TRACE_MSG(trace, "Waiting a moment to send flush trigger.");
 
-			long kPauseBeforeSendingImageFlushMs = 0;
-			GolfSimConfiguration::SetConstant("gs_config.strobing.kPauseBeforeSendingImageFlushMs", kPauseBeforeSendingImageFlushMs);
+			// The pause constant is cached at init time - no config-tree lookups on the trigger path
 			usleep(kPauseBeforeSendingImageFlushMs * 1000);
 
 
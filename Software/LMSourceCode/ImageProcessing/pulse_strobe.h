@@ -9,6 +9,9 @@
 #pragma once
 
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "logging_tools.h"
@@ -32,10 +35,40 @@ namespace golf_sim {
 		static long kPauseBeforeReadyForTriggerMicroSeconds;
 		static int kPauseToSetUpInnoMakerExternalTriggerMilliseconds;
 		static int kPauseBeforeReadyForFinalPrimingPulseMs;
+		static long kPauseBeforeSendingImageFlushMs;
+
+		// Latency-critical execution mode for the ball-watcher/trigger thread.  When enabled,
+		// the thread that detects the hit and fires the strobes is moved to the SCHED_FIFO
+		// real-time class and pinned to its own core so that it does not compete with the
+		// ONNX inference threads or the IPC thread.  Requires CAP_SYS_NICE (or root); if the
+		// scheduler calls fail, the system logs a warning and continues under SCHED_OTHER.
+		static bool kUseRealtimeTriggerThread;
+		static int kRealtimeTriggerPriority;
+		static int kRealtimeTriggerCpuCore;
+
+		// When enabled, SendExternalTrigger only queues the strobe send on a dedicated worker
+		// thread and returns immediately, so that the ball-watcher thread can resume frame
+		// processing instead of blocking for the full duration of the SPI pulse train.  The
+		// follow-on flush pulse (kCameraRequiresFlushPulse) runs on the worker after the main
+		// send completes, preserving its ordering.
+		static bool kUseAsyncStrobeSend;
 
 		static bool InitGPIOSystem(GsSignalCallback callback_function = nullptr);
 		static bool DeinitGPIOSystem();
 
+		// (Re-)reads the pulse interval vectors, on-pulse bit counts and baud rates from the
+		// configuration and (re-)builds the cached fast/slow/tail-repeat pulse sequences.
+		// Called at startup and again each time the system is armed, so that .json changes
+		// take effect on the next shot and NO pulse-train construction ever happens between
+		// hit detection and strobe fire (any work there adds jitter to the inter-exposure
+		// timing that the ball-speed calculations assume is exact).
+		static bool BuildCachedPulseTrains();
+
+		// Applies the real-time scheduling policy and core affinity described above to the
+		// CALLING thread.  A no-op (returning true) if kUseRealtimeTriggerThread is off or
+		// on non-Linux platforms.  Safe to call more than once.
+		static bool ApplyRealtimeTriggerScheduling();
+
 		// Example output:
 		//	    pulse sequence:  { 3,      5,       11,      15,       20,   0 }
 		//      ratio sequence:  {    1.67,    2.2       2.5      1.33         }
@@ -120,6 +153,21 @@ namespace golf_sim {
 		static int kLastPulsePutterRepeats;
 		static unsigned long last_pulse_off_time;
 
+		// Worker thread that performs the (blocking) SPI pulse-train write when
+		// kUseAsyncStrobeSend is enabled.  Started in InitGPIOSystem and stopped in
+		// DeinitGPIOSystem.
+		static std::thread* strobe_send_thread_;
+		static std::mutex strobe_send_mutex_;
+		static std::condition_variable strobe_send_cv_;
+		static bool strobe_send_requested_;
+		static bool strobe_send_shutdown_;
+
+		static void StrobeSendThreadLoop();
+
+		// The original, blocking trigger path.  Used directly when kUseAsyncStrobeSend is
+		// off, and by the worker thread when it is on.
+		static bool SendExternalTriggerSynchronously();
+
 		static int AlignLengthToWordSize(int initialBufferLength, int wordSizeBits);
 	};
 
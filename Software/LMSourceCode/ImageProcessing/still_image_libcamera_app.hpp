@@ -41,6 +41,10 @@ public:
 // The main event loops for the camera 1 and 2 systems
 bool still_image_event_loop(LibcameraJpegApp& app, cv::Mat& returnImg);
 
-bool ball_flight_camera_event_loop(LibcameraJpegApp& app, cv::Mat& returnImg);
+// When camera_already_configured is true, the (persistent) app already has the
+// camera open and the viewfinder stream configured from an earlier shot, so the
+// loop skips straight to StartCamera and avoids the multi-hundred-millisecond
+// libcamera reconfiguration on the trigger-to-capture path.
+bool ball_flight_camera_event_loop(LibcameraJpegApp& app, cv::Mat& returnImg, bool camera_already_configured = false);
 
 #endif // #ifdef __unix__  // Ignore in Windows environment
@@ -6,6 +6,8 @@
 #include "worker_thread.h"
 #include <iostream>
 #include <algorithm>
+#include <deque>
+#include <map>
 
 #include "logging_tools.h"
 #include "gs_globals.h"
@@ -13,11 +15,6 @@
 namespace golf_sim {
 
 
-#define MSG_EXIT_THREAD			1
-#define MSG_POST_USER_DATA		2
-#define MSG_TIMER				3
-
-
 namespace gs = golf_sim;
 
 
@@ -86,183 +83,492 @@ namespace gs = golf_sim;
 	{
 	}
 
+	bool TimedCallbackThread::CreateThread()
+	{
+		// No thread of our own - the callback runs as a delayed task on the
+		// shared GsTaskPool (GsThread::m_thread_ stays null, so the base
+		// class ExitThread has nothing to join).
+		ScheduleCallback();
+		return true;
+	}
+
 	void TimedCallbackThread::ExitThread()
 	{
-		// TBD - Do whatever we need to make sure the timer is not still being waited on.
 		repeat_timer_ = false;
 		exit_timer_ = true;
 
+		GsTaskPool::CancelDelayedTask(pending_task_id_);
+
 		GsThread::ExitThread();
 	}
 
-	void TimedCallbackThread::Process()
+	void TimedCallbackThread::ScheduleCallback()
 	{
-		GS_LOG_TRACE_MSG(trace, "TimedCallbackThread::Process() called.");
+		pending_task_id_ = GsTaskPool::PostDelayedTask(thread_name_,
+			[this]() {
+				if (exit_timer_) {
+					return;
+				}
 
-		long kSleepIncrementMs = 500;
+				callback_function_();
+
+				if (repeat_timer_ && !exit_timer_ && GolfSimGlobals::golf_sim_running_) {
+					ScheduleCallback();
+				}
+			},
+			wait_time_ms_);
+	}
 
-		do {
-			long remaining_time_ms = wait_time_ms_;
 
-			// Don't go to sleep too long without checking back in
-			while (!exit_timer_ && remaining_time_ms > 0) {
 
-				long sleep_time = std::min((long)500, remaining_time_ms);
 
-				// Sleep for a bit
-				std::this_thread::sleep_for(std::chrono::milliseconds(sleep_time));
 
-				remaining_time_ms = (std::max((long)0, remaining_time_ms - kSleepIncrementMs));
-			}
+	TimerWheelThread::TimerWheelThread(const std::string& thread_name) : GsThread(thread_name)
+	{
+	}
 
-			callback_function_();
+	TimerWheelThread::~TimerWheelThread()
+	{
+	}
 
-		} while (repeat_timer_ && GolfSimGlobals::golf_sim_running_);
+	long TimerWheelThread::ScheduleTimer(long delay_ms, void (*callback_function)())
+	{
+		long timer_id;
 
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
 
-		GS_LOG_TRACE_MSG(trace, "TimedCallbackThread::Process() exiting.");
-	}
+			timer_id = next_timer_id_++;
 
+			PendingTimer timer;
+			timer.id = timer_id;
+			timer.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms);
+			timer.callback_function_ = callback_function;
 
+			pending_timers_.push_back(timer);
+		}
 
+		// The new deadline may be earlier than whatever the service thread is
+		// currently sleeping toward.
+		timers_changed_.notify_one();
 
+		CreateThread();
 
-	struct ThreadMsg
+		return timer_id;
+	}
+
+	bool TimerWheelThread::CancelTimer(long timer_id)
 	{
-		ThreadMsg(int i, std::shared_ptr<void> m) { id = i; msg = m; }
-		int id;
-		std::shared_ptr<void> msg;
-	};
+		std::lock_guard<std::mutex> lock(mutex_);
 
+		for (auto it = pending_timers_.begin(); it != pending_timers_.end(); ++it) {
+			if (it->id == timer_id) {
+				pending_timers_.erase(it);
+				return true;
+			}
+		}
 
-	// WorkerThread
+		return false;
+	}
 
-	WorkerThread::WorkerThread(const std::string& thread_name) : GsThread(thread_name)
+	void TimerWheelThread::ExitThread()
 	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			exit_thread_ = true;
+			pending_timers_.clear();
+		}
+		timers_changed_.notify_one();
+
+		GsThread::ExitThread();
 	}
 
+	void TimerWheelThread::Process()
+	{
+		GS_LOG_TRACE_MSG(trace, "TimerWheelThread::Process() called.");
 
-	// ~WorkerThread
+		std::unique_lock<std::mutex> lock(mutex_);
 
-	WorkerThread::~WorkerThread()
-	{
-		// Base class will ExitThread();
+		while (!exit_thread_) {
+
+			if (pending_timers_.empty()) {
+				// Nothing scheduled - sleep until something changes.
+				timers_changed_.wait(lock);
+				continue;
+			}
+
+			// Find the earliest pending deadline
+			auto earliest = pending_timers_.begin();
+			for (auto it = pending_timers_.begin(); it != pending_timers_.end(); ++it) {
+				if (it->deadline < earliest->deadline) {
+					earliest = it;
+				}
+			}
+
+			if (earliest->deadline > std::chrono::steady_clock::now()) {
+				// Sleep exactly until the deadline (or until a schedule or
+				// cancel changes the picture), then re-evaluate.
+				timers_changed_.wait_until(lock, earliest->deadline);
+				continue;
+			}
+
+			// The timer is due - take it off the list and fire the callback
+			// without holding the lock, so the callback can schedule or
+			// cancel timers itself.
+			void (*callback_function)() = earliest->callback_function_;
+			pending_timers_.erase(earliest);
+
+			lock.unlock();
+			callback_function();
+			lock.lock();
+		}
+
+		GS_LOG_TRACE_MSG(trace, "TimerWheelThread::Process() exiting.");
 	}
 
 
+	// GsTaskPool
 
-	// ExitThread
+	namespace {
 
-	void WorkerThread::ExitThread()
-	{
-		if (!m_thread_) {
-			return;
+		struct PoolTask
+		{
+			std::string client_name;
+			std::function<void()> task;
+		};
+
+		struct DelayedPoolTask
+		{
+			long id;
+			std::chrono::steady_clock::time_point deadline;
+			GsTaskPriority priority;
+			PoolTask task;
+		};
+
+		struct ClientTally
+		{
+			long tasks_posted = 0;
+			long tasks_run = 0;
+		};
+
+		constexpr int kNumTaskPriorities = 3;
+
+		// All of the pool's state, created on first use and deliberately
+		// never destroyed - tasks can be in flight until the very end of
+		// the process.
+		struct PoolState
+		{
+			std::mutex mutex;
+			std::condition_variable work_changed;
+
+			// One FIFO queue per priority - a worker always drains the
+			// lowest-numbered non-empty queue first.
+			std::deque<PoolTask> queues[kNumTaskPriorities];
+
+			// Delayed tasks wait here until their deadline, then move into
+			// their priority queue.  Few enough are ever outstanding that a
+			// flat list beats anything fancier (same call as
+			// TimerWheelThread::pending_timers_).
+			std::vector<DelayedPoolTask> delayed_tasks;
+			long next_delayed_task_id = 1;
+
+			// Instrumentation for FormatInventory
+			long tasks_run_per_priority[kNumTaskPriorities] = { 0, 0, 0 };
+			int peak_queue_depth = 0;
+			int busy_workers = 0;
+			std::map<std::string, ClientTally> client_tallies;
+
+			bool shutting_down = false;
+			std::vector<std::thread> workers;
+		};
+
+		std::atomic<bool> task_pool_started = false;
+
+		void TaskPoolWorker(PoolState* state);
+
+		// Built (and its workers started) on first use, thread-safely per
+		// C++11 static initialization.  The workers take the state pointer
+		// directly so they cannot re-enter this initialization.
+		PoolState& TaskPoolState()
+		{
+			static PoolState* state = []() {
+				auto* new_state = new PoolState();
+
+				for (int i = 0; i < GsTaskPool::kWorkerCount; i++) {
+					new_state->workers.emplace_back(TaskPoolWorker, new_state);
+				}
+
+				task_pool_started = true;
+				return new_state;
+			}();
+
+			return *state;
 		}
 
-		// Create a new ThreadMsg
-		std::shared_ptr<ThreadMsg> threadMsg(new ThreadMsg(MSG_EXIT_THREAD, 0));
+		int CurrentQueueDepth(const PoolState& state)
+		{
+			int depth = 0;
+			for (int priority = 0; priority < kNumTaskPriorities; priority++) {
+				depth += (int)state.queues[priority].size();
+			}
+			return depth;
+		}
 
-		// Put exit thread message into the queue
+		void TaskPoolWorker(PoolState* state)
 		{
-			std::lock_guard<std::mutex> lock(m_mutex);
-			m_queue.push(threadMsg);
-			m_cv.notify_one();
+			std::unique_lock<std::mutex> lock(state->mutex);
+
+			for (;;) {
+
+				// Release any delayed tasks whose deadline has arrived into
+				// their priority queue
+				std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+				for (auto it = state->delayed_tasks.begin(); it != state->delayed_tasks.end(); ) {
+					if (it->deadline <= now) {
+						state->queues[(int)it->priority].push_back(std::move(it->task));
+						it = state->delayed_tasks.erase(it);
+					}
+					else {
+						++it;
+					}
+				}
+
+				state->peak_queue_depth = std::max(state->peak_queue_depth, CurrentQueueDepth(*state));
+
+				// Take the highest-priority ready task, if there is one
+				int ready_priority = -1;
+				for (int priority = 0; priority < kNumTaskPriorities; priority++) {
+					if (!state->queues[priority].empty()) {
+						ready_priority = priority;
+						break;
+					}
+				}
+
+				if (ready_priority >= 0) {
+					PoolTask pool_task = std::move(state->queues[ready_priority].front());
+					state->queues[ready_priority].pop_front();
+
+					state->busy_workers++;
+
+					// Run the task without holding the lock so that it can
+					// post (or cancel) pool tasks itself
+					lock.unlock();
+					pool_task.task();
+					lock.lock();
+
+					state->busy_workers--;
+					state->tasks_run_per_priority[ready_priority]++;
+					state->client_tallies[pool_task.client_name].tasks_run++;
+					continue;
+				}
+
+				// The queues only drain like this after Shutdown stops new
+				// submissions, so exiting here cannot strand a task
+				if (state->shutting_down) {
+					return;
+				}
+
+				// Nothing ready - sleep until the earliest delayed-task
+				// deadline (or until a post or cancel changes the picture)
+				if (state->delayed_tasks.empty()) {
+					state->work_changed.wait(lock);
+					continue;
+				}
+
+				auto earliest = state->delayed_tasks.begin();
+				for (auto it = state->delayed_tasks.begin(); it != state->delayed_tasks.end(); ++it) {
+					if (it->deadline < earliest->deadline) {
+						earliest = it;
+					}
+				}
+
+				state->work_changed.wait_until(lock, earliest->deadline);
+			}
 		}
 
-		m_thread_->join();
-		m_thread_ = nullptr;
 	}
 
+	void GsTaskPool::PostTask(const std::string& client_name,
+							  std::function<void()> task,
+							  GsTaskPriority priority)
+	{
+		PoolState& state = TaskPoolState();
 
-	// PostMsg
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
 
-	void WorkerThread::PostMsg(std::shared_ptr<UserData> data)
+			if (state.shutting_down) {
+				GS_LOG_TRACE_MSG(trace, "GsTaskPool::PostTask dropping task from " + client_name + " - pool is shutting down.");
+				return;
+			}
+
+			state.queues[(int)priority].push_back(PoolTask{ client_name, std::move(task) });
+			state.client_tallies[client_name].tasks_posted++;
+			state.peak_queue_depth = std::max(state.peak_queue_depth, CurrentQueueDepth(state));
+		}
+
+		state.work_changed.notify_one();
+	}
+
+	long GsTaskPool::PostDelayedTask(const std::string& client_name,
+									 std::function<void()> task,
+									 long delay_ms,
+									 GsTaskPriority priority)
 	{
-		if (!m_thread_) {
-			GS_LOG_MSG(error, "WorkerThread::PostMsg has null m_thread_");
+		PoolState& state = TaskPoolState();
+		long task_id;
+
+		{
+			std::lock_guard<std::mutex> lock(state.mutex);
+
+			if (state.shutting_down) {
+				GS_LOG_TRACE_MSG(trace, "GsTaskPool::PostDelayedTask dropping task from " + client_name + " - pool is shutting down.");
+				return 0;
+			}
+
+			task_id = state.next_delayed_task_id++;
+
+			DelayedPoolTask delayed_task;
+			delayed_task.id = task_id;
+			delayed_task.deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms);
+			delayed_task.priority = priority;
+			delayed_task.task = PoolTask{ client_name, std::move(task) };
+
+			state.delayed_tasks.push_back(std::move(delayed_task));
+			state.client_tallies[client_name].tasks_posted++;
 		}
 
-		// Create a new ThreadMsg
-		std::shared_ptr<ThreadMsg> threadMsg(new ThreadMsg(MSG_POST_USER_DATA, data));
+		// The new deadline may be earlier than whatever the workers are
+		// currently sleeping toward
+		state.work_changed.notify_one();
 
-		// Add user data msg to queue and notify worker thread
-		std::unique_lock<std::mutex> lk(m_mutex);
-		m_queue.push(threadMsg);
-		m_cv.notify_one();
+		return task_id;
 	}
 
+	bool GsTaskPool::CancelDelayedTask(long task_id)
+	{
+		if (!task_pool_started || task_id == 0) {
+			return false;
+		}
 
-	// TimerThread
+		PoolState& state = TaskPoolState();
 
-	void WorkerThread::TimerThread()
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		for (auto it = state.delayed_tasks.begin(); it != state.delayed_tasks.end(); ++it) {
+			if (it->id == task_id) {
+				state.delayed_tasks.erase(it);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	std::string GsTaskPool::FormatInventory()
 	{
-		while (!m_timerExit && GolfSimGlobals::golf_sim_running_)
-		{
-			// Sleep for 250mS then put a MSG_TIMER into the message queue
-			std::this_thread::sleep_for(std::chrono::milliseconds(250));
+		if (!task_pool_started) {
+			return "GsTaskPool was never used.";
+		}
+
+		PoolState& state = TaskPoolState();
+
+		std::lock_guard<std::mutex> lock(state.mutex);
+
+		std::string inventory = "GsTaskPool inventory (" + std::to_string(kWorkerCount) + " workers, " +
+			std::to_string(state.busy_workers) + " busy):\n";
 
-			std::shared_ptr<ThreadMsg> threadMsg(new ThreadMsg(MSG_TIMER, 0));
+		inventory += "    Tasks run (shot-critical/normal/housekeeping): " +
+			std::to_string(state.tasks_run_per_priority[0]) + "/" +
+			std::to_string(state.tasks_run_per_priority[1]) + "/" +
+			std::to_string(state.tasks_run_per_priority[2]) + "\n";
 
-			// Add timer msg to queue and notify worker thread
-			std::unique_lock<std::mutex> lk(m_mutex);
-			m_queue.push(threadMsg);
-			m_cv.notify_one();
+		inventory += "    Queue depth: " + std::to_string(CurrentQueueDepth(state)) +
+			" now, " + std::to_string(state.peak_queue_depth) + " peak.  Pending delayed tasks: " +
+			std::to_string(state.delayed_tasks.size()) + "\n";
+
+		for (auto& tally : state.client_tallies) {
+			inventory += "    Client \"" + tally.first + "\": " + std::to_string(tally.second.tasks_posted) +
+				" posted, " + std::to_string(tally.second.tasks_run) + " run\n";
 		}
+
+		return inventory;
 	}
 
+	void GsTaskPool::Shutdown()
+	{
+		if (!task_pool_started) {
+			return;
+		}
 
-	// Process
+		PoolState& state = TaskPoolState();
 
-	void WorkerThread::Process()
-	{
-		m_timerExit = false;
-		std::thread timerThread(&WorkerThread::TimerThread, this);
+		GS_LOG_MSG(info, FormatInventory());
 
-		while (GolfSimGlobals::golf_sim_running_)
 		{
-			std::shared_ptr<ThreadMsg> msg;
-			{
-				// Wait for a message to be added to the queue
-				std::unique_lock<std::mutex> lk(m_mutex);
-				while (m_queue.empty())
-					m_cv.wait(lk);
-
-				if (m_queue.empty())
-					continue;
+			std::lock_guard<std::mutex> lock(state.mutex);
+			state.shutting_down = true;
+			// Per the contract, pending delayed tasks are dropped (the queued
+			// ready tasks still drain)
+			state.delayed_tasks.clear();
+		}
+		state.work_changed.notify_all();
 
-				msg = m_queue.front();
-				m_queue.pop();
+		for (auto& worker : state.workers) {
+			if (worker.joinable()) {
+				worker.join();
 			}
+		}
+		state.workers.clear();
 
-			switch (msg->id)
-			{
-			case MSG_POST_USER_DATA:
-			{
-				if (msg->msg == nullptr) {
-					GS_LOG_MSG(error, "WorkerThread::Process found null msg pointer.");
-				}
+		GS_LOG_TRACE_MSG(trace, "GsTaskPool::Shutdown completed.");
+	}
 
-				auto userData = std::static_pointer_cast<UserData>(msg->msg);
-				std::cout << userData->msg.c_str() << " " << userData->year << " on " << thread_name_ << std::endl;
 
-				break;
-			}
+	// WorkerThread
+
+	WorkerThread::WorkerThread(const std::string& thread_name) : GsThread(thread_name)
+	{
+	}
 
-			case MSG_TIMER:
-				std::cout << "Timer expired on " << thread_name_ << std::endl;
-				break;
 
-			case MSG_EXIT_THREAD:
-			{
-				m_timerExit = true;
-				timerThread.join();
+	// ~WorkerThread
+
+	WorkerThread::~WorkerThread()
+	{
+		// Base class will ExitThread();
+	}
+
+
+	// CreateThread
+
+	bool WorkerThread::CreateThread()
+	{
+		// Nothing to create - the posted messages run on the shared
+		// GsTaskPool (GsThread::m_thread_ stays null, so the base class
+		// ExitThread has nothing to join)
+		return true;
+	}
+
+
+	// PostMsg
+
+	void WorkerThread::PostMsg(std::shared_ptr<UserData> data)
+	{
+		// The worker name is captured by value - the task may outlive this
+		// WorkerThread object
+		std::string worker_name = thread_name_;
+
+		GsTaskPool::PostTask(thread_name_, [data, worker_name]() {
+
+			if (data == nullptr) {
+				GS_LOG_MSG(error, "WorkerThread::PostMsg task found null msg pointer.");
 				return;
 			}
 
-			default:
-				GS_LOG_MSG(error, "WorkerThread::Process received unknown message.");
-			}
-		}
+			std::cout << data->msg.c_str() << " " << data->year << " on " << worker_name << std::endl;
+		});
 	}
 
 }
\ No newline at end of file
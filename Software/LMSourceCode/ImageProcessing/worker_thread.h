@@ -13,7 +13,10 @@
 #include <queue>
 #include <mutex>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
+#include <vector>
 
 namespace golf_sim {
 
@@ -57,6 +60,12 @@ namespace golf_sim {
 
 
 
+    // Calls the callback function after the specified wait (repeatedly, if
+    // requested).  Despite the name, no longer a thread of its own - the
+    // callbacks run as housekeeping-priority delayed tasks on the shared
+    // GsTaskPool, so each timer costs a pool entry instead of a dedicated
+    // thread with a polling sleep loop.  The object must outlive its timer
+    // (call ExitThread before destroying it, as before).
     class TimedCallbackThread : public GsThread
     {
     public:
@@ -64,32 +73,142 @@ namespace golf_sim {
 
         ~TimedCallbackThread();
 
-        // Shuts down the timer thread
-        void ExitThread() override;
+        // Schedules the (first) callback on the GsTaskPool
+        bool CreateThread() override;
 
-        // Waits for the specified time and then calls the call back function
-        void Process() override;
+        // Stops the timer - cancels any pending callback
+        void ExitThread() override;
 
     private:
 
+        // Schedules the next callback firing on the pool
+        void ScheduleCallback();
+
         long wait_time_ms_ = 0;
         void (*callback_function_)();
-        // If true then after the timer expires and the callback is called, the 
-        // timer thread resets and starts waiting again
+        // If true then after the timer expires and the callback is called, the
+        // timer resets and starts waiting again
         bool repeat_timer_ = false;
 
         // When true, stop the timer ASAP
-        bool exit_timer_ = false;
+        std::atomic<bool> exit_timer_ = false;
+
+        // The pool id of the pending delayed task, for cancellation
+        long pending_task_id_ = 0;
+    };
+
+    // Runs any number of one-shot deadline timers on a single service thread.
+    // Unlike TimedCallbackThread, scheduling a timer does not spawn a thread,
+    // the service sleeps exactly until the earliest pending deadline (no
+    // periodic wakeups), and a pending timer can be cancelled before it fires.
+    class TimerWheelThread : public GsThread
+    {
+    public:
+        TimerWheelThread(const std::string& threadName);
+
+        ~TimerWheelThread();
+
+        // Schedules callback_function to be called (on the service thread)
+        // once, delay_ms from now.  Returns an id that can be passed to
+        // CancelTimer.  Starts the service thread on first use.
+        long ScheduleTimer(long delay_ms, void (*callback_function)());
+
+        // Returns true if the timer was still pending and is now cancelled.
+        // Returns false if it already fired (or was never scheduled).
+        bool CancelTimer(long timer_id);
+
+        // Shuts down the service thread.  Any pending timers are dropped.
+        void ExitThread() override;
+
+        // Entry point for the service thread
+        void Process() override;
+
+    private:
+
+        struct PendingTimer
+        {
+            long id;
+            std::chrono::steady_clock::time_point deadline;
+            void (*callback_function_)();
+        };
+
+        // Few enough timers are ever outstanding that a flat list beats a
+        // bucketed wheel - the scan to find the earliest deadline is trivial.
+        std::vector<PendingTimer> pending_timers_;
+
+        std::mutex mutex_;
+        std::condition_variable timers_changed_;
+
+        long next_timer_id_ = 1;
+        bool exit_thread_ = false;
     };
 
+
+    // Priority of a task submitted to the GsTaskPool.  Lower values run
+    // first - a worker always drains the shot-critical queue before it
+    // looks at the others.
+    enum class GsTaskPriority {
+        kShotCritical = 0,
+        kNormal = 1,
+        kHousekeeping = 2
+    };
+
+    // A small, shared pool of worker threads for the odd jobs that would
+    // otherwise each spawn a dedicated thread (WorkerThread messages,
+    // TimedCallbackThread timers, and the like).  The dedicated-thread
+    // pattern adds up on a 4-core Pi - together with the camera, IPC,
+    // ONNX and OpenCV threads it oversubscribes the cores right when a
+    // shot is in flight.  Tasks carry a priority, delayed tasks carry a
+    // deadline (served with the same sleep-until-earliest-deadline logic
+    // as TimerWheelThread), and every submission is tallied per client so
+    // the pool's usage can be inventoried.
+    class GsTaskPool
+    {
+    public:
+        // Deliberately few workers - the priority ordering (not more
+        // threads) is what keeps the shot-critical work from being
+        // preempted by housekeeping.
+        static constexpr int kWorkerCount = 2;
+
+        // Runs the task on a pool worker as soon as priority order allows.
+        // The client_name only feeds the usage inventory.  The workers are
+        // started lazily on the first post.
+        static void PostTask(const std::string& client_name,
+                             std::function<void()> task,
+                             GsTaskPriority priority = GsTaskPriority::kNormal);
+
+        // Runs the task delay_ms from now at the given priority.  Returns
+        // an id that can be passed to CancelDelayedTask.
+        static long PostDelayedTask(const std::string& client_name,
+                                    std::function<void()> task,
+                                    long delay_ms,
+                                    GsTaskPriority priority = GsTaskPriority::kHousekeeping);
+
+        // Returns true if the delayed task was still pending and is now
+        // cancelled.  Returns false if it was already released to run.
+        static bool CancelDelayedTask(long task_id);
+
+        // Multi-line summary of the pool's usage - queue depths, tasks run
+        // per priority, and per-client tallies.
+        static std::string FormatInventory();
+
+        // Logs the inventory and stops the workers once the queued tasks
+        // have drained.  Any still-pending delayed tasks are dropped.
+        static void Shutdown();
+    };
+
+
 struct UserData
 {
     std::string msg;
     int year;
 };
 
-struct ThreadMsg;
-
+// Preserves the original message-queue API, but the posted messages now run
+// on the shared GsTaskPool instead of a dedicated thread (the old
+// implementation also ran a 250 ms periodic timer loop per instance, so
+// each WorkerThread cost two threads).  Messages posted to one instance
+// keep their submission order within the pool's normal-priority queue.
 class WorkerThread : public GsThread
 {
 public:
@@ -97,24 +216,12 @@ public:
 
     ~WorkerThread();
 
-    // Shuts down the timer thread
-    void ExitThread() override;
+    // No dedicated thread to create - kept so existing call sites work
+    bool CreateThread() override;
 
-    // Add a message to the thread queue
+    // Add a message for processing on the shared pool
     // @param[in] data - thread specific message information
     void PostMsg(std::shared_ptr<UserData> msg);
-
-    // Entry point for the worker thread
-    void Process() override;
-
-private:
-    // Entry point for timer thread
-    void TimerThread();
-
-    std::queue<std::shared_ptr<ThreadMsg>> m_queue;
-    std::mutex m_mutex;
-    std::condition_variable m_cv;
-    std::atomic<bool> m_timerExit;
 };
 
 }
\ No newline at end of file
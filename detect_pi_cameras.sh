@@ -80,6 +80,7 @@ INNOMAKER_TRIGGER="/usr/lib/pitrac/ImageProcessing/CameraTools/imx296_trigger"
 
 VERBOSE=0
 QUIET=0
+USE_CACHE=1
 
 parse_args() {
     while [[ $# -gt 0 ]]; do
@@ -93,6 +94,9 @@ parse_args() {
             --no-color)
                 export NO_COLOR=1
                 ;;
+            --no-cache)
+                USE_CACHE=0
+                ;;
             -h|--help)
                 show_help
                 exit 0
@@ -117,6 +121,7 @@ Options:
   -v, --verbose  Show detailed detection methods and diagnostics
   -q, --quiet    Show minimal summary only
   --no-color     Disable colored output
+  --no-cache     Ignore the cached topology and re-probe the cameras
   -h, --help     Show this help message
 
 This tool detects Raspberry Pi cameras and provides PiTrac configuration values.
@@ -346,6 +351,145 @@ declare -A CAMERA_DT_PATH=()
 declare -A CAMERA_PORT=()
 declare -A CAMERA_STATUS=()
 
+# ============================================================================
+# Topology Cache
+# ============================================================================
+#
+# Probing the cameras through libcamera (and walking the device tree for the
+# CSI ports) is one of the longer serial segments of a cold start, but the
+# answer only changes when a camera is re-cabled or an overlay changes.  The
+# discovered topology is kept in a small state file keyed by a cheap
+# sysfs/device-tree fingerprint; the full probe only runs when the
+# fingerprint no longer matches (or with --no-cache).
+
+CACHE_VERSION=1
+
+cache_file_path() {
+    if [ -n "${PITRAC_CAMERA_CACHE_FILE:-}" ]; then
+        echo "$PITRAC_CAMERA_CACHE_FILE"
+    elif [ -d /var/cache/pitrac ] && [ -w /var/cache/pitrac ]; then
+        echo "/var/cache/pitrac/camera_topology.cache"
+    else
+        echo "${HOME}/.cache/pitrac/camera_topology.cache"
+    fi
+}
+
+# A stable digest of what the kernel already knows about the attached
+# cameras - the video4linux and I2C device names plus the Pi model.  This
+# reads a handful of sysfs files and never touches libcamera, so it is
+# orders of magnitude cheaper than the probe it guards.
+topology_fingerprint() {
+    {
+        local dev
+        for dev in /sys/class/video4linux/*; do
+            [ -e "$dev" ] || continue
+            printf '%s %s\n' "$dev" "$(tr -d '\0' < "$dev/name" 2>/dev/null || true)"
+        done
+        for dev in /sys/bus/i2c/devices/*; do
+            [ -f "$dev/name" ] || continue
+            printf '%s %s\n' "$dev" "$(tr -d '\0' < "$dev/name" 2>/dev/null || true)"
+        done
+        local root
+        for root in "$DT_ROOT" "$DT_ROOT_ALT"; do
+            if [ -r "$root/model" ]; then
+                tr -d '\0' < "$root/model"
+                echo
+                break
+            fi
+        done
+    } | cksum
+}
+
+# Populate the CAMERA_* tables from the cache file.  Returns non-zero (and
+# leaves the tables empty) unless the file exists, is the current version,
+# and its fingerprint matches the live topology.
+load_camera_cache() {
+    [ $USE_CACHE -eq 1 ] || return 1
+
+    local file
+    file=$(cache_file_path)
+    [ -r "$file" ] || return 1
+
+    local live_fingerprint
+    live_fingerprint=$(topology_fingerprint)
+
+    # The file is KEY=VALUE lines written by save_camera_cache.  Parse it
+    # rather than sourcing it, so a corrupt file cannot execute anything.
+    local version="" cached_fingerprint="" count=""
+    local line key value idx field
+
+    while IFS= read -r line; do
+        key="${line%%=*}"
+        value="${line#*=}"
+
+        case "$key" in
+            CACHE_VERSION) version="$value" ;;
+            FINGERPRINT)   cached_fingerprint="$value" ;;
+            CAMERA_COUNT)  count="$value" ;;
+            CAM*)
+                if [[ "$key" =~ ^CAM([0-9]+)_([A-Z_]+)$ ]]; then
+                    idx="${BASH_REMATCH[1]}"
+                    field="${BASH_REMATCH[2]}"
+                    case "$field" in
+                        INFO)        CAMERA_INDEXES+=("$idx"); CAMERA_INFO["$idx"]="$value" ;;
+                        SENSOR)      CAMERA_SENSOR["$idx"]="$value" ;;
+                        MODEL)       CAMERA_MODEL_NAME["$idx"]="$value" ;;
+                        CFA)         CAMERA_CFA["$idx"]="$value" ;;
+                        PITRAC_TYPE) CAMERA_PITRAC_TYPE["$idx"]="$value" ;;
+                        DESCRIPTION) CAMERA_DESCRIPTION["$idx"]="$value" ;;
+                        DT_PATH)     CAMERA_DT_PATH["$idx"]="$value" ;;
+                        PORT)        CAMERA_PORT["$idx"]="$value" ;;
+                        STATUS)      CAMERA_STATUS["$idx"]="$value" ;;
+                    esac
+                fi
+                ;;
+        esac
+    done < "$file"
+
+    if [ "$version" != "$CACHE_VERSION" ] || \
+       [ "$cached_fingerprint" != "$live_fingerprint" ] || \
+       [ "${count:-0}" != "${#CAMERA_INDEXES[@]}" ] || \
+       [ ${#CAMERA_INDEXES[@]} -eq 0 ]; then
+        CAMERA_INDEXES=()
+        CAMERA_INFO=(); CAMERA_SENSOR=(); CAMERA_MODEL_NAME=(); CAMERA_CFA=()
+        CAMERA_PITRAC_TYPE=(); CAMERA_DESCRIPTION=(); CAMERA_DT_PATH=()
+        CAMERA_PORT=(); CAMERA_STATUS=()
+        return 1
+    fi
+
+    return 0
+}
+
+# Write the CAMERA_* tables out, atomically, for the next run.  Failures
+# are silent - the cache is purely an optimization.
+save_camera_cache() {
+    [ $USE_CACHE -eq 1 ] || return 0
+    [ ${#CAMERA_INDEXES[@]} -gt 0 ] || return 0
+
+    local file tmp
+    file=$(cache_file_path)
+    mkdir -p "$(dirname "$file")" 2>/dev/null || return 0
+    tmp="${file}.tmp.$$"
+
+    {
+        echo "CACHE_VERSION=$CACHE_VERSION"
+        echo "FINGERPRINT=$(topology_fingerprint)"
+        echo "CAMERA_COUNT=${#CAMERA_INDEXES[@]}"
+        local idx
+        for idx in "${CAMERA_INDEXES[@]}"; do
+            echo "CAM${idx}_INFO=${CAMERA_INFO[$idx]}"
+            echo "CAM${idx}_SENSOR=${CAMERA_SENSOR[$idx]}"
+            echo "CAM${idx}_MODEL=${CAMERA_MODEL_NAME[$idx]}"
+            echo "CAM${idx}_CFA=${CAMERA_CFA[$idx]}"
+            echo "CAM${idx}_PITRAC_TYPE=${CAMERA_PITRAC_TYPE[$idx]}"
+            echo "CAM${idx}_DESCRIPTION=${CAMERA_DESCRIPTION[$idx]}"
+            echo "CAM${idx}_DT_PATH=${CAMERA_DT_PATH[$idx]}"
+            echo "CAM${idx}_PORT=${CAMERA_PORT[$idx]}"
+            echo "CAM${idx}_STATUS=${CAMERA_STATUS[$idx]}"
+        done
+    } > "$tmp" 2>/dev/null && mv -f "$tmp" "$file" 2>/dev/null || rm -f "$tmp" 2>/dev/null || true
+}
+
 detect_cameras() {
     local camera_cmd
     camera_cmd=$(get_camera_cmd)
@@ -644,13 +788,21 @@ main() {
     fi
     
     check_dependencies
-    
+
     if [ $QUIET -eq 0 ]; then
         print_system_info
     fi
-    
-    detect_cameras
-    
+
+    if load_camera_cache; then
+        if [ $QUIET -eq 0 ]; then
+            echo -e "${BLUE}Using cached camera topology from $(cache_file_path) (--no-cache re-probes)${NC}"
+            echo
+        fi
+    else
+        detect_cameras
+        save_camera_cache
+    fi
+
     print_summary
     print_configuration
     print_verbose_info